@@ -6,6 +6,34 @@ dnl Function to detect if libluksde dependencies are available
 AC_DEFUN([AX_LIBLUKSDE_CHECK_LOCAL],
   [dnl Check for internationalization functions in libluksde/libluksde_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
+
+  dnl Headers and functions included in libluksde/libluksde_file_mapping.c
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno],
+    [AC_CHECK_HEADERS([errno.h fcntl.h sys/mman.h unistd.h])
+
+    AC_CHECK_FUNCS([madvise mmap munmap])
+  ])
+
+  dnl Headers and functions included in libluksde/libluksde_direct_io_handle.c
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno],
+    [AC_CHECK_HEADERS([linux/fs.h sys/ioctl.h sys/stat.h])
+
+    AC_CHECK_FUNCS([posix_memalign pread])
+  ])
+
+  dnl Headers included in libluksde/libluksde_io_uring.c
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno],
+    [AC_CHECK_HEADERS([linux/io_uring.h sys/syscall.h sys/uio.h])
+  ])
+
+  dnl Headers included in libluksde/libluksde_spill_cache.c
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno],
+    [AC_CHECK_HEADERS([fcntl.h sys/stat.h unistd.h])
+  ])
 ])
 
 dnl Function to detect if luksdetools dependencies are available
@@ -32,6 +60,14 @@ AC_DEFUN([AX_LUKSDETOOLS_CHECK_LOCAL],
   dnl Headers included in luksdetools/luksdemount.c
   AC_CHECK_HEADERS([errno.h sys/time.h])
 
+  dnl Headers and functions included in luksdetools/mount_handle.c
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno],
+    [AC_CHECK_HEADERS([fcntl.h sys/stat.h])
+
+    AC_CHECK_FUNCS([fchmod fstat])
+  ])
+
   dnl Functions included in luksdetools/mount_file_system.c and luksdetools/mount_file_entry.c
   AS_IF(
     [test "x$ac_cv_enable_winapi" = xno],
@@ -0,0 +1,968 @@
+/*
+ * Allocation map functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+/* Required for SEEK_DATA and SEEK_HOLE
+ */
+#define _GNU_SOURCE
+#endif
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libluksde_allocation_map.h"
+#include "libluksde_libcdata.h"
+#include "libluksde_libcerror.h"
+
+#if defined( HAVE_SYS_STAT_H ) && defined( HAVE_UNISTD_H ) && defined( SEEK_DATA ) && defined( SEEK_HOLE )
+#define LIBLUKSDE_HAVE_SEEK_DATA	1
+#endif
+
+/* Creates an allocation map entry
+ * Make sure the value allocation_map_entry is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_allocation_map_entry_initialize(
+     libluksde_allocation_map_entry_t **allocation_map_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_allocation_map_entry_initialize";
+
+	if( allocation_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation map entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *allocation_map_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid allocation map entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*allocation_map_entry = memory_allocate_structure(
+	                         libluksde_allocation_map_entry_t );
+
+	if( *allocation_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create allocation map entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *allocation_map_entry,
+	     0,
+	     sizeof( libluksde_allocation_map_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear allocation map entry.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *allocation_map_entry != NULL )
+	{
+		memory_free(
+		 *allocation_map_entry );
+
+		*allocation_map_entry = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an allocation map entry
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_allocation_map_entry_free(
+     libluksde_allocation_map_entry_t **allocation_map_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_allocation_map_entry_free";
+
+	if( allocation_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation map entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *allocation_map_entry != NULL )
+	{
+		memory_free(
+		 *allocation_map_entry );
+
+		*allocation_map_entry = NULL;
+	}
+	return( 1 );
+}
+
+/* Creates an allocation map
+ * Make sure the value allocation_map is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_allocation_map_initialize(
+     libluksde_allocation_map_t **allocation_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_allocation_map_initialize";
+
+	if( allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *allocation_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid allocation map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*allocation_map = memory_allocate_structure(
+	                   libluksde_allocation_map_t );
+
+	if( *allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create allocation map.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *allocation_map,
+	     0,
+	     sizeof( libluksde_allocation_map_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear allocation map.",
+		 function );
+
+		memory_free(
+		 *allocation_map );
+
+		*allocation_map = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *allocation_map )->entries_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create entries array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *allocation_map != NULL )
+	{
+		memory_free(
+		 *allocation_map );
+
+		*allocation_map = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an allocation map
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_allocation_map_free(
+     libluksde_allocation_map_t **allocation_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_allocation_map_free";
+	int result            = 1;
+
+	if( allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *allocation_map != NULL )
+	{
+		if( libcdata_array_free(
+		     &( ( *allocation_map )->entries_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libluksde_allocation_map_entry_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free entries array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *allocation_map );
+
+		*allocation_map = NULL;
+	}
+	return( result );
+}
+
+/* Appends an allocated range to the allocation map
+ * The range must not start before the last range, a range that overlaps with
+ * or directly follows the last range is merged with it
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_allocation_map_append_range(
+     libluksde_allocation_map_t *allocation_map,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libluksde_allocation_map_entry_t *allocation_map_entry = NULL;
+	static char *function                                  = "libluksde_allocation_map_append_range";
+	off64_t last_range_end_offset                          = 0;
+	off64_t range_end_offset                               = 0;
+	int entry_index                                        = 0;
+	int number_of_entries                                  = 0;
+
+	if( allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation map.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size64_t) ( INT64_MAX - offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == 0 )
+	{
+		return( 1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     allocation_map->entries_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries > 0 )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     allocation_map->entries_array,
+		     number_of_entries - 1,
+		     (intptr_t **) &allocation_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d.",
+			 function,
+			 number_of_entries - 1 );
+
+			return( -1 );
+		}
+		if( allocation_map_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing entry: %d.",
+			 function,
+			 number_of_entries - 1 );
+
+			return( -1 );
+		}
+		if( offset < allocation_map_entry->offset )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		last_range_end_offset = allocation_map_entry->offset + (off64_t) allocation_map_entry->size;
+
+		if( offset <= last_range_end_offset )
+		{
+			range_end_offset = offset + (off64_t) size;
+
+			if( range_end_offset > last_range_end_offset )
+			{
+				allocation_map_entry->size = (size64_t) ( range_end_offset - allocation_map_entry->offset );
+			}
+			return( 1 );
+		}
+		allocation_map_entry = NULL;
+	}
+	if( libluksde_allocation_map_entry_initialize(
+	     &allocation_map_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create allocation map entry.",
+		 function );
+
+		goto on_error;
+	}
+	allocation_map_entry->offset = offset;
+	allocation_map_entry->size   = size;
+
+	if( libcdata_array_append_entry(
+	     allocation_map->entries_array,
+	     &entry_index,
+	     (intptr_t *) allocation_map_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append allocation map entry to array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( allocation_map_entry != NULL )
+	{
+		libluksde_allocation_map_entry_free(
+		 &allocation_map_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the allocated ranges of a file using SEEK_DATA and SEEK_HOLE
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int libluksde_allocation_map_read_file_descriptor(
+     libluksde_allocation_map_t *allocation_map,
+     int file_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_allocation_map_read_file_descriptor";
+
+#if defined( LIBLUKSDE_HAVE_SEEK_DATA )
+	struct stat file_statistics;
+
+	off64_t data_offset   = 0;
+	off64_t file_size     = 0;
+	off64_t hole_offset   = 0;
+	int number_of_entries = 0;
+#endif
+
+	if( allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation map.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBLUKSDE_HAVE_SEEK_DATA )
+	if( libcdata_array_get_number_of_entries(
+	     allocation_map->entries_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid allocation map - entries already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( fstat(
+	     file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		return( -1 );
+	}
+	/* Only regular files can be sparse
+	 */
+	if( !S_ISREG( file_statistics.st_mode ) )
+	{
+		return( 0 );
+	}
+	file_size = (off64_t) file_statistics.st_size;
+
+	while( hole_offset < file_size )
+	{
+		data_offset = lseek(
+		               file_descriptor,
+		               (off_t) hole_offset,
+		               SEEK_DATA );
+
+		if( data_offset == -1 )
+		{
+			/* The remainder of the file is a hole
+			 */
+			if( errno == ENXIO )
+			{
+				break;
+			}
+			/* The file system does not support SEEK_DATA
+			 */
+			if( errno == EINVAL )
+			{
+				libcdata_array_empty(
+				 allocation_map->entries_array,
+				 (int (*)(intptr_t **, libcerror_error_t **)) &libluksde_allocation_map_entry_free,
+				 NULL );
+
+				return( 0 );
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 errno,
+			 "%s: unable to seek data from offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 hole_offset,
+			 hole_offset );
+
+			goto on_error;
+		}
+		hole_offset = lseek(
+		               file_descriptor,
+		               (off_t) data_offset,
+		               SEEK_HOLE );
+
+		if( hole_offset == -1 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 errno,
+			 "%s: unable to seek hole from offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 data_offset,
+			 data_offset );
+
+			goto on_error;
+		}
+		/* The file can be modified while it is read
+		 */
+		if( hole_offset > file_size )
+		{
+			hole_offset = file_size;
+		}
+		if( hole_offset <= data_offset )
+		{
+			break;
+		}
+		if( libluksde_allocation_map_append_range(
+		     allocation_map,
+		     data_offset,
+		     (size64_t) ( hole_offset - data_offset ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append allocated range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 data_offset,
+			 data_offset );
+
+			goto on_error;
+		}
+	}
+	allocation_map->size = (size64_t) file_size;
+
+	return( 1 );
+
+on_error:
+	libcdata_array_empty(
+	 allocation_map->entries_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libluksde_allocation_map_entry_free,
+	 NULL );
+
+	return( -1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Reads the allocated ranges of a file by name
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int libluksde_allocation_map_read_file_by_name(
+     libluksde_allocation_map_t *allocation_map,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_allocation_map_read_file_by_name";
+	int result            = 0;
+
+#if defined( LIBLUKSDE_HAVE_SEEK_DATA )
+	int file_descriptor   = -1;
+#endif
+
+	if( allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation map.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBLUKSDE_HAVE_SEEK_DATA )
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	result = libluksde_allocation_map_read_file_descriptor(
+	          allocation_map,
+	          file_descriptor,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read allocated ranges of file: %s.",
+		 function,
+		 filename );
+	}
+	close(
+	 file_descriptor );
+#endif
+	return( result );
+}
+
+/* Retrieves the number of allocated ranges
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_allocation_map_get_number_of_ranges(
+     libluksde_allocation_map_t *allocation_map,
+     int *number_of_ranges,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_allocation_map_get_number_of_ranges";
+
+	if( allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation map.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     allocation_map->entries_array,
+	     number_of_ranges,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific allocated range
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_allocation_map_get_range_by_index(
+     libluksde_allocation_map_t *allocation_map,
+     int range_index,
+     off64_t *offset,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libluksde_allocation_map_entry_t *allocation_map_entry = NULL;
+	static char *function                                  = "libluksde_allocation_map_get_range_by_index";
+
+	if( allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation map.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     allocation_map->entries_array,
+	     range_index,
+	     (intptr_t **) &allocation_map_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry: %d.",
+		 function,
+		 range_index );
+
+		return( -1 );
+	}
+	if( allocation_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing entry: %d.",
+		 function,
+		 range_index );
+
+		return( -1 );
+	}
+	*offset = allocation_map_entry->offset;
+	*size   = allocation_map_entry->size;
+
+	return( 1 );
+}
+
+/* Retrieves the extent that contains a specific offset
+ * The extent size contains the number of bytes from the offset up to where the allocation changes,
+ * the data after the last allocated range is considered unallocated
+ * The entries are ordered by offset and do not overlap, hence a binary search is used
+ * Returns 1 if the offset is allocated, 0 if not or -1 on error
+ */
+int libluksde_allocation_map_get_extent_at_offset(
+     libluksde_allocation_map_t *allocation_map,
+     off64_t offset,
+     size64_t *extent_size,
+     libcerror_error_t **error )
+{
+	libluksde_allocation_map_entry_t *allocation_map_entry = NULL;
+	static char *function                                  = "libluksde_allocation_map_get_extent_at_offset";
+	off64_t next_range_offset                              = INT64_MAX;
+	int entry_index                                        = 0;
+	int lower_entry_index                                  = 0;
+	int number_of_entries                                  = 0;
+	int upper_entry_index                                  = 0;
+
+	if( allocation_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation map.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     allocation_map->entries_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	upper_entry_index = number_of_entries;
+
+	while( lower_entry_index < upper_entry_index )
+	{
+		entry_index = lower_entry_index + ( ( upper_entry_index - lower_entry_index ) / 2 );
+
+		if( libcdata_array_get_entry_by_index(
+		     allocation_map->entries_array,
+		     entry_index,
+		     (intptr_t **) &allocation_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( allocation_map_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( offset < allocation_map_entry->offset )
+		{
+			next_range_offset = allocation_map_entry->offset;
+			upper_entry_index = entry_index;
+		}
+		else if( (size64_t) ( offset - allocation_map_entry->offset ) >= allocation_map_entry->size )
+		{
+			lower_entry_index = entry_index + 1;
+		}
+		else
+		{
+			*extent_size = allocation_map_entry->size - (size64_t) ( offset - allocation_map_entry->offset );
+
+			return( 1 );
+		}
+	}
+	*extent_size = (size64_t) ( next_range_offset - offset );
+
+	return( 0 );
+}
+
@@ -0,0 +1,118 @@
+/*
+ * Allocation map functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_ALLOCATION_MAP_H )
+#define _LIBLUKSDE_ALLOCATION_MAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libcdata.h"
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libluksde_allocation_map_entry libluksde_allocation_map_entry_t;
+
+struct libluksde_allocation_map_entry
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size64_t size;
+};
+
+typedef struct libluksde_allocation_map libluksde_allocation_map_t;
+
+struct libluksde_allocation_map
+{
+	/* The entries array
+	 * Contains the allocated ranges in order of their offset
+	 */
+	libcdata_array_t *entries_array;
+
+	/* The size
+	 * Contains the size of the data the allocated ranges are part of
+	 */
+	size64_t size;
+};
+
+int libluksde_allocation_map_entry_initialize(
+     libluksde_allocation_map_entry_t **allocation_map_entry,
+     libcerror_error_t **error );
+
+int libluksde_allocation_map_entry_free(
+     libluksde_allocation_map_entry_t **allocation_map_entry,
+     libcerror_error_t **error );
+
+int libluksde_allocation_map_initialize(
+     libluksde_allocation_map_t **allocation_map,
+     libcerror_error_t **error );
+
+int libluksde_allocation_map_free(
+     libluksde_allocation_map_t **allocation_map,
+     libcerror_error_t **error );
+
+int libluksde_allocation_map_append_range(
+     libluksde_allocation_map_t *allocation_map,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libluksde_allocation_map_read_file_descriptor(
+     libluksde_allocation_map_t *allocation_map,
+     int file_descriptor,
+     libcerror_error_t **error );
+
+int libluksde_allocation_map_read_file_by_name(
+     libluksde_allocation_map_t *allocation_map,
+     const char *filename,
+     libcerror_error_t **error );
+
+int libluksde_allocation_map_get_number_of_ranges(
+     libluksde_allocation_map_t *allocation_map,
+     int *number_of_ranges,
+     libcerror_error_t **error );
+
+int libluksde_allocation_map_get_range_by_index(
+     libluksde_allocation_map_t *allocation_map,
+     int range_index,
+     off64_t *offset,
+     size64_t *size,
+     libcerror_error_t **error );
+
+int libluksde_allocation_map_get_extent_at_offset(
+     libluksde_allocation_map_t *allocation_map,
+     off64_t offset,
+     size64_t *extent_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_ALLOCATION_MAP_H ) */
+
@@ -0,0 +1,1348 @@
+/*
+ * Argon2 functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_argon2.h"
+#include "libluksde_blake2b.h"
+#include "libluksde_definitions.h"
+#include "libluksde_keyfile.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_libcthreads.h"
+
+/* The Argon2 version (1.3)
+ */
+#define LIBLUKSDE_ARGON2_VERSION			0x13
+
+/* The BlaMka multiplication-hardened addition
+ */
+#define libluksde_argon2_blamka( value_a, value_b ) \
+	( ( value_a ) + ( value_b ) + ( 2 * ( ( value_a ) & 0xffffffffUL ) * ( ( value_b ) & 0xffffffffUL ) ) )
+
+#define libluksde_argon2_rotate_right( value, number_of_bits ) \
+	( ( ( value ) >> ( number_of_bits ) ) | ( ( value ) << ( 64 - ( number_of_bits ) ) ) )
+
+#define libluksde_argon2_mix( value_a, value_b, value_c, value_d ) \
+	value_a = libluksde_argon2_blamka( value_a, value_b ); \
+	value_d = libluksde_argon2_rotate_right( value_d ^ value_a, 32 ); \
+	value_c = libluksde_argon2_blamka( value_c, value_d ); \
+	value_b = libluksde_argon2_rotate_right( value_b ^ value_c, 24 ); \
+	value_a = libluksde_argon2_blamka( value_a, value_b ); \
+	value_d = libluksde_argon2_rotate_right( value_d ^ value_a, 16 ); \
+	value_c = libluksde_argon2_blamka( value_c, value_d ); \
+	value_b = libluksde_argon2_rotate_right( value_b ^ value_c, 63 );
+
+/* The BLAKE2b round based permutation of 16 values
+ */
+#define libluksde_argon2_permute( values, index0, index1, index2, index3, index4, index5, index6, index7, index8, index9, index10, index11, index12, index13, index14, index15 ) \
+	libluksde_argon2_mix( values[ index0 ], values[ index4 ], values[ index8 ], values[ index12 ] ); \
+	libluksde_argon2_mix( values[ index1 ], values[ index5 ], values[ index9 ], values[ index13 ] ); \
+	libluksde_argon2_mix( values[ index2 ], values[ index6 ], values[ index10 ], values[ index14 ] ); \
+	libluksde_argon2_mix( values[ index3 ], values[ index7 ], values[ index11 ], values[ index15 ] ); \
+	libluksde_argon2_mix( values[ index0 ], values[ index5 ], values[ index10 ], values[ index15 ] ); \
+	libluksde_argon2_mix( values[ index1 ], values[ index6 ], values[ index11 ], values[ index12 ] ); \
+	libluksde_argon2_mix( values[ index2 ], values[ index7 ], values[ index8 ], values[ index13 ] ); \
+	libluksde_argon2_mix( values[ index3 ], values[ index4 ], values[ index9 ], values[ index14 ] );
+
+/* Calculates the Argon2 variable-length hash function H'
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_argon2_calculate_variable_length_hash(
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	uint8_t hash_size_data[ 4 ];
+	uint8_t intermediate_hash[ LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE ];
+
+	libluksde_blake2b_context_t blake2b_context;
+
+	static char *function = "libluksde_argon2_calculate_variable_length_hash";
+	size_t hash_offset    = 0;
+	size_t last_hash_size = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+#if SIZEOF_SIZE_T <= 4
+	if( ( hash_size == 0 )
+	 || ( hash_size > (size_t) SSIZE_MAX ) )
+#else
+	if( ( hash_size == 0 )
+	 || ( hash_size > (size_t) UINT32_MAX ) )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 hash_size_data,
+	 (uint32_t) hash_size );
+
+	if( hash_size <= LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE )
+	{
+		last_hash_size = hash_size;
+	}
+	else
+	{
+		last_hash_size = LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE;
+	}
+	if( libluksde_blake2b_initialize(
+	     &blake2b_context,
+	     last_hash_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize BLAKE2b context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_blake2b_update(
+	     &blake2b_context,
+	     hash_size_data,
+	     4,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update BLAKE2b context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_blake2b_update(
+	     &blake2b_context,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update BLAKE2b context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_blake2b_finalize(
+	     &blake2b_context,
+	     intermediate_hash,
+	     last_hash_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize BLAKE2b context.",
+		 function );
+
+		goto on_error;
+	}
+	/* Larger hashes consist of the first 32 bytes of a chain of 64-byte hashes
+	 * followed by a final hash of the remaining size
+	 */
+	while( ( hash_size - hash_offset ) > LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE )
+	{
+		if( memory_copy(
+		     &( hash[ hash_offset ] ),
+		     intermediate_hash,
+		     32 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy intermediate hash.",
+			 function );
+
+			goto on_error;
+		}
+		hash_offset += 32;
+
+		last_hash_size = hash_size - hash_offset;
+
+		if( last_hash_size > LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE )
+		{
+			last_hash_size = LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE;
+		}
+		if( libluksde_blake2b_calculate(
+		     intermediate_hash,
+		     LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE,
+		     intermediate_hash,
+		     last_hash_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to calculate intermediate hash.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( memory_copy(
+	     &( hash[ hash_offset ] ),
+	     intermediate_hash,
+	     last_hash_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy intermediate hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     intermediate_hash,
+	     0,
+	     LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear intermediate hash.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	memory_set(
+	 intermediate_hash,
+	 0,
+	 LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE );
+
+	memory_set(
+	 &blake2b_context,
+	 0,
+	 sizeof( libluksde_blake2b_context_t ) );
+
+	return( -1 );
+}
+
+/* Compresses the previous and reference block into the output block (G)
+ * If xor_with_output_block is set the result is combined with the existing
+ * output block, as required for passes after the first
+ */
+void libluksde_argon2_compress_block(
+      const uint64_t *previous_block,
+      const uint64_t *reference_block,
+      uint64_t *output_block,
+      uint8_t xor_with_output_block )
+{
+	uint64_t block_r[ LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES ];
+	uint64_t block_z[ LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES ];
+
+	int index = 0;
+
+	for( index = 0;
+	     index < LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES;
+	     index++ )
+	{
+		block_r[ index ] = previous_block[ index ] ^ reference_block[ index ];
+		block_z[ index ] = block_r[ index ];
+	}
+	/* Apply the permutation to the 8 rows of 16 values
+	 */
+	for( index = 0;
+	     index < 128;
+	     index += 16 )
+	{
+		libluksde_argon2_permute(
+		 block_z,
+		 index, index + 1, index + 2, index + 3,
+		 index + 4, index + 5, index + 6, index + 7,
+		 index + 8, index + 9, index + 10, index + 11,
+		 index + 12, index + 13, index + 14, index + 15 );
+	}
+	/* Apply the permutation to the 8 columns of 16 values
+	 */
+	for( index = 0;
+	     index < 16;
+	     index += 2 )
+	{
+		libluksde_argon2_permute(
+		 block_z,
+		 index, index + 1, index + 16, index + 17,
+		 index + 32, index + 33, index + 48, index + 49,
+		 index + 64, index + 65, index + 80, index + 81,
+		 index + 96, index + 97, index + 112, index + 113 );
+	}
+	if( xor_with_output_block != 0 )
+	{
+		for( index = 0;
+		     index < LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES;
+		     index++ )
+		{
+			output_block[ index ] ^= block_r[ index ] ^ block_z[ index ];
+		}
+	}
+	else
+	{
+		for( index = 0;
+		     index < LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES;
+		     index++ )
+		{
+			output_block[ index ] = block_r[ index ] ^ block_z[ index ];
+		}
+	}
+}
+
+/* Fills a segment of a lane
+ * Argon2i and the first half of the first pass of Argon2id use
+ * data-independent addressing, the rest uses data-dependent addressing
+ */
+void libluksde_argon2_fill_segment(
+      libluksde_argon2_context_t *context,
+      uint32_t pass_index,
+      uint32_t slice_index,
+      uint32_t lane_index )
+{
+	uint64_t address_block[ LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES ];
+	uint64_t input_block[ LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES ];
+	uint64_t zero_block[ LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES ];
+
+	uint64_t *current_block        = NULL;
+	uint64_t *previous_block       = NULL;
+	uint64_t pseudo_random_value   = 0;
+	uint64_t relative_position     = 0;
+	uint32_t block_index           = 0;
+	uint32_t first_block_index     = 0;
+	uint32_t lane_block_index      = 0;
+	uint32_t reference_area_size   = 0;
+	uint32_t reference_block_index = 0;
+	uint32_t reference_lane_index  = 0;
+	uint32_t start_block_index     = 0;
+	uint8_t data_independent       = 0;
+	int value_index                = 0;
+
+	if( ( context->type == 1 )
+	 || ( ( pass_index == 0 )
+	  &&  ( slice_index < ( LIBLUKSDE_ARGON2_NUMBER_OF_SLICES / 2 ) ) ) )
+	{
+		data_independent = 1;
+	}
+	if( data_independent != 0 )
+	{
+		for( value_index = 0;
+		     value_index < LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES;
+		     value_index++ )
+		{
+			input_block[ value_index ] = 0;
+			zero_block[ value_index ]  = 0;
+		}
+		input_block[ 0 ] = pass_index;
+		input_block[ 1 ] = lane_index;
+		input_block[ 2 ] = slice_index;
+		input_block[ 3 ] = context->number_of_blocks;
+		input_block[ 4 ] = context->time_cost;
+		input_block[ 5 ] = context->type;
+	}
+	/* The first 2 blocks of each lane are filled during initialization
+	 */
+	if( ( pass_index == 0 )
+	 && ( slice_index == 0 ) )
+	{
+		first_block_index = 2;
+	}
+	for( block_index = first_block_index;
+	     block_index < context->segment_size;
+	     block_index++ )
+	{
+		lane_block_index = ( slice_index * context->segment_size ) + block_index;
+
+		current_block = &( context->blocks[ ( ( (size_t) lane_index * context->lane_size ) + lane_block_index ) * LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES ] );
+
+		if( lane_block_index == 0 )
+		{
+			previous_block = current_block + ( (size_t) ( context->lane_size - 1 ) * LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES );
+		}
+		else
+		{
+			previous_block = current_block - LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES;
+		}
+		if( data_independent != 0 )
+		{
+			if( ( block_index == first_block_index )
+			 || ( ( block_index % LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES ) == 0 ) )
+			{
+				input_block[ 6 ] += 1;
+
+				libluksde_argon2_compress_block(
+				 zero_block,
+				 input_block,
+				 address_block,
+				 0 );
+
+				libluksde_argon2_compress_block(
+				 zero_block,
+				 address_block,
+				 address_block,
+				 0 );
+			}
+			pseudo_random_value = address_block[ block_index % LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES ];
+		}
+		else
+		{
+			pseudo_random_value = previous_block[ 0 ];
+		}
+		if( ( pass_index == 0 )
+		 && ( slice_index == 0 ) )
+		{
+			reference_lane_index = lane_index;
+		}
+		else
+		{
+			reference_lane_index = (uint32_t) ( ( pseudo_random_value >> 32 ) % context->number_of_lanes );
+		}
+		/* Determine the number of blocks that can be referenced, which are
+		 * all blocks of completed segments and for the current lane also
+		 * the preceding blocks of the current segment
+		 */
+		if( pass_index == 0 )
+		{
+			reference_area_size = slice_index * context->segment_size;
+			start_block_index   = 0;
+		}
+		else
+		{
+			reference_area_size = context->lane_size - context->segment_size;
+			start_block_index   = ( ( slice_index + 1 ) * context->segment_size ) % context->lane_size;
+		}
+		if( reference_lane_index == lane_index )
+		{
+			reference_area_size += block_index - 1;
+		}
+		else if( block_index == 0 )
+		{
+			reference_area_size -= 1;
+		}
+		relative_position = pseudo_random_value & 0xffffffffUL;
+		relative_position = ( relative_position * relative_position ) >> 32;
+		relative_position = reference_area_size - 1 - ( ( reference_area_size * relative_position ) >> 32 );
+
+		reference_block_index = (uint32_t) ( ( start_block_index + relative_position ) % context->lane_size );
+
+		libluksde_argon2_compress_block(
+		 previous_block,
+		 &( context->blocks[ ( ( (size_t) reference_lane_index * context->lane_size ) + reference_block_index ) * LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES ] ),
+		 current_block,
+		 (uint8_t) ( pass_index != 0 ) );
+	}
+}
+
+/* Fills the segments of the lanes assigned to a thread
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_argon2_fill_segments_callback(
+     libluksde_argon2_thread_context_t *thread_context )
+{
+	uint32_t lane_index = 0;
+
+	if( thread_context == NULL )
+	{
+		return( -1 );
+	}
+	for( lane_index = thread_context->first_lane_index;
+	     lane_index < thread_context->context->number_of_lanes;
+	     lane_index += thread_context->lane_index_increment )
+	{
+		libluksde_argon2_fill_segment(
+		 thread_context->context,
+		 thread_context->pass_index,
+		 thread_context->slice_index,
+		 lane_index );
+	}
+	return( 1 );
+}
+
+/* Fills the memory blocks for all passes
+ * The segments of a slice are independent of each other and are filled
+ * by multiple threads if multi-threading is supported
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_argon2_fill_memory(
+     libluksde_argon2_context_t *context,
+     libcerror_error_t **error )
+{
+	libluksde_argon2_thread_context_t thread_contexts[ LIBLUKSDE_ARGON2_MAXIMUM_NUMBER_OF_THREADS ];
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_t *threads[ LIBLUKSDE_ARGON2_MAXIMUM_NUMBER_OF_THREADS ];
+
+	uint32_t number_of_started_threads = 0;
+	int result                         = 1;
+#endif
+	static char *function              = "libluksde_argon2_fill_memory";
+	uint32_t number_of_threads         = 1;
+	uint32_t pass_index                = 0;
+	uint32_t slice_index               = 0;
+	uint32_t thread_index              = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid context - missing blocks.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	number_of_threads = context->number_of_lanes;
+
+	if( number_of_threads > LIBLUKSDE_ARGON2_MAXIMUM_NUMBER_OF_THREADS )
+	{
+		number_of_threads = LIBLUKSDE_ARGON2_MAXIMUM_NUMBER_OF_THREADS;
+	}
+#endif
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		thread_contexts[ thread_index ].context              = context;
+		thread_contexts[ thread_index ].first_lane_index     = thread_index;
+		thread_contexts[ thread_index ].lane_index_increment = number_of_threads;
+	}
+	for( pass_index = 0;
+	     pass_index < context->time_cost;
+	     pass_index++ )
+	{
+		for( slice_index = 0;
+		     slice_index < LIBLUKSDE_ARGON2_NUMBER_OF_SLICES;
+		     slice_index++ )
+		{
+			for( thread_index = 0;
+			     thread_index < number_of_threads;
+			     thread_index++ )
+			{
+				thread_contexts[ thread_index ].pass_index  = pass_index;
+				thread_contexts[ thread_index ].slice_index = slice_index;
+			}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+			if( number_of_threads > 1 )
+			{
+				/* The first set of lanes is filled by the calling thread
+				 */
+				for( number_of_started_threads = 0;
+				     ( number_of_started_threads + 1 ) < number_of_threads;
+				     number_of_started_threads++ )
+				{
+					threads[ number_of_started_threads ] = NULL;
+
+					if( libcthreads_thread_create(
+					     &( threads[ number_of_started_threads ] ),
+					     NULL,
+					     (int (*)(void *)) &libluksde_argon2_fill_segments_callback,
+					     (void *) &( thread_contexts[ number_of_started_threads + 1 ] ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+						 "%s: unable to create thread: %" PRIu32 ".",
+						 function,
+						 number_of_started_threads + 1 );
+
+						result = -1;
+
+						break;
+					}
+				}
+				if( result == 1 )
+				{
+					libluksde_argon2_fill_segments_callback(
+					 &( thread_contexts[ 0 ] ) );
+				}
+				for( thread_index = 0;
+				     thread_index < number_of_started_threads;
+				     thread_index++ )
+				{
+					if( libcthreads_thread_join(
+					     &( threads[ thread_index ] ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to join thread: %" PRIu32 ".",
+						 function,
+						 thread_index + 1 );
+
+						result = -1;
+					}
+				}
+				if( result != 1 )
+				{
+					return( -1 );
+				}
+				continue;
+			}
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+
+			libluksde_argon2_fill_segments_callback(
+			 &( thread_contexts[ 0 ] ) );
+		}
+	}
+	return( 1 );
+}
+
+/* Initializes the first 2 blocks of a lane from the initial hash H0
+ * Returns 1 if successful or -1 on error
+ */
+static int libluksde_argon2_initialize_lane(
+            libluksde_argon2_context_t *context,
+            uint8_t *initial_hash,
+            uint32_t lane_index,
+            libcerror_error_t **error )
+{
+	uint8_t block_data[ LIBLUKSDE_ARGON2_BLOCK_SIZE ];
+
+	static char *function = "libluksde_argon2_initialize_lane";
+	uint64_t *block       = NULL;
+	uint32_t block_index  = 0;
+	int value_index       = 0;
+
+	/* The initial hash buffer contains H0 followed by room for the block and lane index
+	 */
+	byte_stream_copy_from_uint32_little_endian(
+	 &( initial_hash[ LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE + 4 ] ),
+	 lane_index );
+
+	for( block_index = 0;
+	     block_index < 2;
+	     block_index++ )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( initial_hash[ LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE ] ),
+		 block_index );
+
+		if( libluksde_argon2_calculate_variable_length_hash(
+		     initial_hash,
+		     LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE + 8,
+		     block_data,
+		     LIBLUKSDE_ARGON2_BLOCK_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to calculate block: %" PRIu32 " of lane: %" PRIu32 ".",
+			 function,
+			 block_index,
+			 lane_index );
+
+			goto on_error;
+		}
+		block = &( context->blocks[ ( ( (size_t) lane_index * context->lane_size ) + block_index ) * LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES ] );
+
+		for( value_index = 0;
+		     value_index < LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES;
+		     value_index++ )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 &( block_data[ value_index * 8 ] ),
+			 block[ value_index ] );
+		}
+	}
+	if( memory_set(
+	     block_data,
+	     0,
+	     LIBLUKSDE_ARGON2_BLOCK_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	memory_set(
+	 block_data,
+	 0,
+	 LIBLUKSDE_ARGON2_BLOCK_SIZE );
+
+	return( -1 );
+}
+
+/* Updates a BLAKE2b context with a 32-bit little-endian length followed by the data
+ * Returns 1 if successful or -1 on error
+ */
+static int libluksde_argon2_update_with_length_prefixed_data(
+            libluksde_blake2b_context_t *blake2b_context,
+            const uint8_t *data,
+            size_t data_size,
+            libcerror_error_t **error )
+{
+	uint8_t data_size_data[ 4 ];
+
+	static char *function = "libluksde_argon2_update_with_length_prefixed_data";
+
+#if SIZEOF_SIZE_T <= 4
+	if( data_size > (size_t) SSIZE_MAX )
+#else
+	if( data_size > (size_t) UINT32_MAX )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 data_size_data,
+	 (uint32_t) data_size );
+
+	if( libluksde_blake2b_update(
+	     blake2b_context,
+	     data_size_data,
+	     4,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update BLAKE2b context.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( libluksde_blake2b_update(
+		     blake2b_context,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update BLAKE2b context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Compute an Argon2-derived key from the given input
+ * The password is read from the keyfile when the keyfile is set
+ * The secret and associated data are optional and not used by LUKS2
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_argon2_derive_key(
+     int key_derivation_function,
+     const uint8_t *password,
+     size_t password_length,
+     libluksde_keyfile_t *keyfile,
+     const uint8_t *salt,
+     size_t salt_size,
+     const uint8_t *secret,
+     size_t secret_size,
+     const uint8_t *associated_data,
+     size_t associated_data_size,
+     uint32_t time_cost,
+     uint32_t memory_cost,
+     uint32_t parallelism,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	uint8_t final_block_data[ LIBLUKSDE_ARGON2_BLOCK_SIZE ];
+	uint8_t initial_hash[ LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE + 8 ];
+	uint8_t keyfile_size_data[ 4 ];
+	uint8_t parameters_data[ 24 ];
+
+	libluksde_argon2_context_t context;
+	libluksde_blake2b_context_t blake2b_context;
+
+	static char *function = "libluksde_argon2_derive_key";
+	uint64_t *last_block  = NULL;
+	uint64_t final_value  = 0;
+	size_t blocks_size    = 0;
+	uint32_t lane_index   = 0;
+	int value_index       = 0;
+
+	if( memory_set(
+	     &context,
+	     0,
+	     sizeof( libluksde_argon2_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		return( -1 );
+	}
+	switch( key_derivation_function )
+	{
+		case LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2I:
+			context.type = 1;
+			break;
+
+		case LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID:
+			context.type = 2;
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported key derivation function.",
+			 function );
+
+			return( -1 );
+	}
+	if( ( password == NULL )
+	 && ( keyfile == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( secret == NULL )
+	 && ( secret_size != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid secret.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( associated_data == NULL )
+	 && ( associated_data_size != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid associated data.",
+		 function );
+
+		return( -1 );
+	}
+	if( time_cost == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid time cost value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( parallelism == 0 )
+	 || ( parallelism > 0x00ffffffUL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid parallelism value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( memory_cost < ( 8 * parallelism ) )
+	 || ( memory_cost > LIBLUKSDE_ARGON2_MAXIMUM_MEMORY_COST ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid memory cost value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size < 4 )
+	 || ( output_data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	context.time_cost        = time_cost;
+	context.number_of_lanes  = parallelism;
+	context.segment_size     = memory_cost / ( LIBLUKSDE_ARGON2_NUMBER_OF_SLICES * parallelism );
+	context.lane_size        = context.segment_size * LIBLUKSDE_ARGON2_NUMBER_OF_SLICES;
+	context.number_of_blocks = context.lane_size * parallelism;
+
+#if SIZEOF_SIZE_T <= 4
+	if( context.number_of_blocks > (uint32_t) ( SSIZE_MAX / LIBLUKSDE_ARGON2_BLOCK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of blocks value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	blocks_size = (size_t) context.number_of_blocks * LIBLUKSDE_ARGON2_BLOCK_SIZE;
+
+	/* The blocks are allocated once for all passes and lanes
+	 */
+	context.blocks = (uint64_t *) memory_allocate(
+	                               blocks_size );
+
+	if( context.blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create blocks.",
+		 function );
+
+		goto on_error;
+	}
+	/* Calculate the initial hash H0
+	 */
+	byte_stream_copy_from_uint32_little_endian(
+	 &( parameters_data[ 0 ] ),
+	 parallelism );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( parameters_data[ 4 ] ),
+	 (uint32_t) output_data_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( parameters_data[ 8 ] ),
+	 memory_cost );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( parameters_data[ 12 ] ),
+	 time_cost );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( parameters_data[ 16 ] ),
+	 LIBLUKSDE_ARGON2_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( parameters_data[ 20 ] ),
+	 context.type );
+
+	if( libluksde_blake2b_initialize(
+	     &blake2b_context,
+	     LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize BLAKE2b context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_blake2b_update(
+	     &blake2b_context,
+	     parameters_data,
+	     24,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update BLAKE2b context.",
+		 function );
+
+		goto on_error;
+	}
+	if( keyfile != NULL )
+	{
+		/* The key data of the keyfile is streamed into the hash instead of being copied
+		 */
+		byte_stream_copy_from_uint32_little_endian(
+		 keyfile_size_data,
+		 (uint32_t) keyfile->size );
+
+		if( libluksde_blake2b_update(
+		     &blake2b_context,
+		     keyfile_size_data,
+		     4,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update BLAKE2b context with keyfile size.",
+			 function );
+
+			goto on_error;
+		}
+		if( libluksde_keyfile_update_blake2b_context(
+		     keyfile,
+		     &blake2b_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update BLAKE2b context with keyfile.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else if( libluksde_argon2_update_with_length_prefixed_data(
+	          &blake2b_context,
+	          password,
+	          password_length,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update BLAKE2b context with password.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_argon2_update_with_length_prefixed_data(
+	     &blake2b_context,
+	     salt,
+	     salt_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update BLAKE2b context with salt.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_argon2_update_with_length_prefixed_data(
+	     &blake2b_context,
+	     secret,
+	     secret_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update BLAKE2b context with secret.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_argon2_update_with_length_prefixed_data(
+	     &blake2b_context,
+	     associated_data,
+	     associated_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update BLAKE2b context with associated data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_blake2b_finalize(
+	     &blake2b_context,
+	     initial_hash,
+	     LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize BLAKE2b context.",
+		 function );
+
+		goto on_error;
+	}
+	for( lane_index = 0;
+	     lane_index < parallelism;
+	     lane_index++ )
+	{
+		if( libluksde_argon2_initialize_lane(
+		     &context,
+		     initial_hash,
+		     lane_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize lane: %" PRIu32 ".",
+			 function,
+			 lane_index );
+
+			goto on_error;
+		}
+	}
+	if( libluksde_argon2_fill_memory(
+	     &context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to fill memory.",
+		 function );
+
+		goto on_error;
+	}
+	/* The final block is the XOR of the last block of each lane
+	 */
+	for( value_index = 0;
+	     value_index < LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES;
+	     value_index++ )
+	{
+		final_value = 0;
+
+		for( lane_index = 0;
+		     lane_index < parallelism;
+		     lane_index++ )
+		{
+			last_block = &( context.blocks[ ( ( (size_t) lane_index * context.lane_size ) + context.lane_size - 1 ) * LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES ] );
+
+			final_value ^= last_block[ value_index ];
+		}
+		byte_stream_copy_from_uint64_little_endian(
+		 &( final_block_data[ value_index * 8 ] ),
+		 final_value );
+	}
+	if( libluksde_argon2_calculate_variable_length_hash(
+	     final_block_data,
+	     LIBLUKSDE_ARGON2_BLOCK_SIZE,
+	     output_data,
+	     output_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate output data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     context.blocks,
+	     0,
+	     blocks_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear blocks.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 context.blocks );
+
+	context.blocks = NULL;
+
+	if( memory_set(
+	     initial_hash,
+	     0,
+	     LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE + 8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear initial hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     final_block_data,
+	     0,
+	     LIBLUKSDE_ARGON2_BLOCK_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear final block data.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( context.blocks != NULL )
+	{
+		memory_set(
+		 context.blocks,
+		 0,
+		 blocks_size );
+
+		memory_free(
+		 context.blocks );
+	}
+	memory_set(
+	 initial_hash,
+	 0,
+	 LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE + 8 );
+
+	memory_set(
+	 final_block_data,
+	 0,
+	 LIBLUKSDE_ARGON2_BLOCK_SIZE );
+
+	memory_set(
+	 &blake2b_context,
+	 0,
+	 sizeof( libluksde_blake2b_context_t ) );
+
+	return( -1 );
+}
+
@@ -0,0 +1,164 @@
+/*
+ * Argon2 functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_ARGON2_H )
+#define _LIBLUKSDE_ARGON2_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_keyfile.h"
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The Argon2 block size
+ */
+#define LIBLUKSDE_ARGON2_BLOCK_SIZE			1024
+
+/* The number of 64-bit values in an Argon2 block
+ */
+#define LIBLUKSDE_ARGON2_NUMBER_OF_BLOCK_VALUES		128
+
+/* The number of slices (synchronization points) per pass
+ */
+#define LIBLUKSDE_ARGON2_NUMBER_OF_SLICES		4
+
+/* The largest supported memory cost in KiB, which matches the maximum
+ * cryptsetup allows for LUKS2 key slots (4 GiB)
+ */
+#define LIBLUKSDE_ARGON2_MAXIMUM_MEMORY_COST		4194304
+
+/* The maximum number of threads used to fill the lanes
+ */
+#define LIBLUKSDE_ARGON2_MAXIMUM_NUMBER_OF_THREADS	16
+
+typedef struct libluksde_argon2_context libluksde_argon2_context_t;
+
+struct libluksde_argon2_context
+{
+	/* The Argon2 type value
+	 * 1 for Argon2i and 2 for Argon2id
+	 */
+	uint32_t type;
+
+	/* The time cost (number of passes)
+	 */
+	uint32_t time_cost;
+
+	/* The number of lanes
+	 */
+	uint32_t number_of_lanes;
+
+	/* The number of blocks per lane
+	 */
+	uint32_t lane_size;
+
+	/* The number of blocks per segment
+	 */
+	uint32_t segment_size;
+
+	/* The total number of blocks
+	 */
+	uint32_t number_of_blocks;
+
+	/* The blocks
+	 */
+	uint64_t *blocks;
+};
+
+typedef struct libluksde_argon2_thread_context libluksde_argon2_thread_context_t;
+
+struct libluksde_argon2_thread_context
+{
+	/* The Argon2 context
+	 */
+	libluksde_argon2_context_t *context;
+
+	/* The pass index
+	 */
+	uint32_t pass_index;
+
+	/* The slice index
+	 */
+	uint32_t slice_index;
+
+	/* The index of the first lane filled by the thread
+	 */
+	uint32_t first_lane_index;
+
+	/* The lane index increment, which equals the number of threads
+	 */
+	uint32_t lane_index_increment;
+};
+
+int libluksde_argon2_calculate_variable_length_hash(
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+void libluksde_argon2_compress_block(
+      const uint64_t *previous_block,
+      const uint64_t *reference_block,
+      uint64_t *output_block,
+      uint8_t xor_with_output_block );
+
+void libluksde_argon2_fill_segment(
+      libluksde_argon2_context_t *context,
+      uint32_t pass_index,
+      uint32_t slice_index,
+      uint32_t lane_index );
+
+int libluksde_argon2_fill_segments_callback(
+     libluksde_argon2_thread_context_t *thread_context );
+
+int libluksde_argon2_fill_memory(
+     libluksde_argon2_context_t *context,
+     libcerror_error_t **error );
+
+int libluksde_argon2_derive_key(
+     int key_derivation_function,
+     const uint8_t *password,
+     size_t password_length,
+     libluksde_keyfile_t *keyfile,
+     const uint8_t *salt,
+     size_t salt_size,
+     const uint8_t *secret,
+     size_t secret_size,
+     const uint8_t *associated_data,
+     size_t associated_data_size,
+     uint32_t time_cost,
+     uint32_t memory_cost,
+     uint32_t parallelism,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_ARGON2_H ) */
+
@@ -0,0 +1,505 @@
+/*
+ * Benchmark functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_argon2.h"
+#include "libluksde_benchmark.h"
+#include "libluksde_definitions.h"
+#include "libluksde_diffuser.h"
+#include "libluksde_encryption_context.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_password.h"
+
+/* Derives a key from a fixed password and salt using PBKDF2
+ * This function does not measure time, the caller is expected to time the call
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_benchmark_pbkdf2(
+     int hashing_method,
+     uint32_t number_of_iterations,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	uint8_t key[ 64 ];
+	uint8_t salt[ 32 ];
+
+	static char *function = "libluksde_benchmark_pbkdf2";
+
+	if( ( key_size == 0 )
+	 || ( key_size > 64 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     salt,
+	     0x5a,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to set salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_password_pbkdf2(
+	     (uint8_t *) "password",
+	     8,
+	     hashing_method,
+	     salt,
+	     32,
+	     number_of_iterations,
+	     key,
+	     key_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to derive key.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Derives a key from a fixed password and salt using Argon2
+ * This function does not measure time, the caller is expected to time the call
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_benchmark_argon2(
+     int key_derivation_function,
+     uint32_t time_cost,
+     uint32_t memory_cost,
+     uint32_t parallelism,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	uint8_t key[ 64 ];
+	uint8_t salt[ 32 ];
+
+	static char *function = "libluksde_benchmark_argon2";
+
+	if( ( key_derivation_function != LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2I )
+	 && ( key_derivation_function != LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported key derivation function.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_size == 0 )
+	 || ( key_size > 64 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     salt,
+	     0x5a,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to set salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_argon2_derive_key(
+	     key_derivation_function,
+	     (uint8_t *) "password",
+	     8,
+	     NULL,
+	     salt,
+	     32,
+	     NULL,
+	     0,
+	     NULL,
+	     0,
+	     time_cost,
+	     memory_cost,
+	     parallelism,
+	     key,
+	     key_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to derive key.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Merges anti-forensic split data of the size of a key slot key material
+ * This function does not measure time, the caller is expected to time the call
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_benchmark_diffuser_merge(
+     int hashing_method,
+     uint32_t number_of_stripes,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	uint8_t key[ 64 ];
+
+	uint8_t *split_data    = NULL;
+	static char *function  = "libluksde_benchmark_diffuser_merge";
+	size_t split_data_size = 0;
+
+	if( number_of_stripes == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of stripes value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_size == 0 )
+	 || ( key_size > 64 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) number_of_stripes > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / key_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of stripes value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	split_data_size = key_size * number_of_stripes;
+
+	split_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * split_data_size );
+
+	if( split_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create split data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     split_data,
+	     0x5a,
+	     split_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to set split data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_diffuser_merge(
+	     split_data,
+	     split_data_size,
+	     key,
+	     key_size,
+	     number_of_stripes,
+	     hashing_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to merge split data.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 split_data );
+
+	return( 1 );
+
+on_error:
+	if( split_data != NULL )
+	{
+		memory_free(
+		 split_data );
+	}
+	return( -1 );
+}
+
+/* Decrypts data sector-by-sector in 512-byte sectors
+ * The ESSIV hashing method is SHA-256 when the initialization vector mode is ESSIV
+ * This function does not measure time, the caller is expected to time the call
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_benchmark_decrypt(
+     int encryption_method,
+     int encryption_chaining_mode,
+     int initialization_vector_mode,
+     size_t key_size,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t key[ 64 ];
+
+	libluksde_encryption_context_t *encryption_context = NULL;
+	uint8_t *data                                      = NULL;
+	uint8_t *encrypted_data                            = NULL;
+	static char *function                              = "libluksde_benchmark_decrypt";
+	size_t data_offset                                 = 0;
+	uint64_t sector_number                             = 0;
+	int essiv_hashing_method                           = 0;
+
+	if( ( key_size == 0 )
+	 || ( key_size > 64 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	 || ( ( data_size % 512 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vector_mode == LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV )
+	{
+		essiv_hashing_method = LIBLUKSDE_HASHING_METHOD_SHA256;
+	}
+	if( memory_set(
+	     key,
+	     0x5a,
+	     64 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to set key.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_encryption_context_initialize(
+	     &encryption_context,
+	     encryption_method,
+	     encryption_chaining_mode,
+	     initialization_vector_mode,
+	     essiv_hashing_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_encryption_context_set_key(
+	     encryption_context,
+	     key,
+	     key_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key in encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	encrypted_data = (uint8_t *) memory_allocate(
+	                              sizeof( uint8_t ) * data_size );
+
+	if( encrypted_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create encrypted data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     encrypted_data,
+	     0x5a,
+	     data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to set encrypted data.",
+		 function );
+
+		goto on_error;
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset += 512 )
+	{
+		if( libluksde_encryption_context_crypt(
+		     encryption_context,
+		     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		     &( encrypted_data[ data_offset ] ),
+		     512,
+		     &( data[ data_offset ] ),
+		     512,
+		     sector_number,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+			 "%s: unable to decrypt sector: %" PRIu64 ".",
+			 function,
+			 sector_number );
+
+			goto on_error;
+		}
+		sector_number++;
+	}
+	memory_free(
+	 data );
+
+	data = NULL;
+
+	memory_free(
+	 encrypted_data );
+
+	encrypted_data = NULL;
+
+	if( libluksde_encryption_context_free(
+	     &encryption_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( encrypted_data != NULL )
+	{
+		memory_free(
+		 encrypted_data );
+	}
+	if( encryption_context != NULL )
+	{
+		libluksde_encryption_context_free(
+		 &encryption_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
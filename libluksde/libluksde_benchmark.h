@@ -0,0 +1,72 @@
+/*
+ * Benchmark functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_BENCHMARK_H )
+#define _LIBLUKSDE_BENCHMARK_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_extern.h"
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+LIBLUKSDE_EXTERN \
+int libluksde_benchmark_pbkdf2(
+     int hashing_method,
+     uint32_t number_of_iterations,
+     size_t key_size,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_benchmark_argon2(
+     int key_derivation_function,
+     uint32_t time_cost,
+     uint32_t memory_cost,
+     uint32_t parallelism,
+     size_t key_size,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_benchmark_diffuser_merge(
+     int hashing_method,
+     uint32_t number_of_stripes,
+     size_t key_size,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_benchmark_decrypt(
+     int encryption_method,
+     int encryption_chaining_mode,
+     int initialization_vector_mode,
+     size_t key_size,
+     size_t data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_BENCHMARK_H ) */
+
@@ -0,0 +1,493 @@
+/*
+ * BLAKE2b functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_blake2b.h"
+#include "libluksde_libcerror.h"
+
+/* The BLAKE2b initialization vector
+ */
+static const uint64_t libluksde_blake2b_initialization_vector[ 8 ] = {
+	0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+	0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL };
+
+/* The BLAKE2b message word permutations per round
+ */
+static const uint8_t libluksde_blake2b_sigma[ 12 ][ 16 ] = {
+	{  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+	{ 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+	{ 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+	{  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+	{  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+	{  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+	{ 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+	{ 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+	{  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+	{ 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 },
+	{  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+	{ 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 } };
+
+#define libluksde_blake2b_rotate_right( value, number_of_bits ) \
+	( ( ( value ) >> ( number_of_bits ) ) | ( ( value ) << ( 64 - ( number_of_bits ) ) ) )
+
+#define libluksde_blake2b_mix( values, index_a, index_b, index_c, index_d, value_x, value_y ) \
+	values[ index_a ] = values[ index_a ] + values[ index_b ] + value_x; \
+	values[ index_d ] = libluksde_blake2b_rotate_right( values[ index_d ] ^ values[ index_a ], 32 ); \
+	values[ index_c ] = values[ index_c ] + values[ index_d ]; \
+	values[ index_b ] = libluksde_blake2b_rotate_right( values[ index_b ] ^ values[ index_c ], 24 ); \
+	values[ index_a ] = values[ index_a ] + values[ index_b ] + value_y; \
+	values[ index_d ] = libluksde_blake2b_rotate_right( values[ index_d ] ^ values[ index_a ], 16 ); \
+	values[ index_c ] = values[ index_c ] + values[ index_d ]; \
+	values[ index_b ] = libluksde_blake2b_rotate_right( values[ index_b ] ^ values[ index_c ], 63 );
+
+/* Compresses a single block into the hash values
+ */
+static void libluksde_blake2b_compress(
+             libluksde_blake2b_context_t *context,
+             const uint8_t *block_data,
+             uint8_t is_last_block )
+{
+	uint64_t message_values[ 16 ];
+	uint64_t values[ 16 ];
+
+	const uint8_t *sigma = NULL;
+	size_t value_index   = 0;
+	int round_index      = 0;
+
+	for( value_index = 0;
+	     value_index < 16;
+	     value_index++ )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 &( block_data[ value_index * 8 ] ),
+		 message_values[ value_index ] );
+	}
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		values[ value_index ]     = context->hash_values[ value_index ];
+		values[ value_index + 8 ] = libluksde_blake2b_initialization_vector[ value_index ];
+	}
+	values[ 12 ] ^= context->number_of_bytes[ 0 ];
+	values[ 13 ] ^= context->number_of_bytes[ 1 ];
+
+	if( is_last_block != 0 )
+	{
+		values[ 14 ] = ~( values[ 14 ] );
+	}
+	for( round_index = 0;
+	     round_index < 12;
+	     round_index++ )
+	{
+		sigma = libluksde_blake2b_sigma[ round_index ];
+
+		libluksde_blake2b_mix( values, 0, 4,  8, 12, message_values[ sigma[ 0 ] ], message_values[ sigma[ 1 ] ] );
+		libluksde_blake2b_mix( values, 1, 5,  9, 13, message_values[ sigma[ 2 ] ], message_values[ sigma[ 3 ] ] );
+		libluksde_blake2b_mix( values, 2, 6, 10, 14, message_values[ sigma[ 4 ] ], message_values[ sigma[ 5 ] ] );
+		libluksde_blake2b_mix( values, 3, 7, 11, 15, message_values[ sigma[ 6 ] ], message_values[ sigma[ 7 ] ] );
+		libluksde_blake2b_mix( values, 0, 5, 10, 15, message_values[ sigma[ 8 ] ], message_values[ sigma[ 9 ] ] );
+		libluksde_blake2b_mix( values, 1, 6, 11, 12, message_values[ sigma[ 10 ] ], message_values[ sigma[ 11 ] ] );
+		libluksde_blake2b_mix( values, 2, 7,  8, 13, message_values[ sigma[ 12 ] ], message_values[ sigma[ 13 ] ] );
+		libluksde_blake2b_mix( values, 3, 4,  9, 14, message_values[ sigma[ 14 ] ], message_values[ sigma[ 15 ] ] );
+	}
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		context->hash_values[ value_index ] ^= values[ value_index ] ^ values[ value_index + 8 ];
+	}
+}
+
+/* Adds a number of bytes to the processed bytes counter
+ */
+static void libluksde_blake2b_increment_counter(
+             libluksde_blake2b_context_t *context,
+             uint64_t number_of_bytes )
+{
+	context->number_of_bytes[ 0 ] += number_of_bytes;
+
+	if( context->number_of_bytes[ 0 ] < number_of_bytes )
+	{
+		context->number_of_bytes[ 1 ] += 1;
+	}
+}
+
+/* Initializes a BLAKE2b context for an unkeyed hash
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_blake2b_initialize(
+     libluksde_blake2b_context_t *context,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_blake2b_initialize";
+	size_t value_index    = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( hash_size == 0 )
+	 || ( hash_size > LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     context,
+	     0,
+	     sizeof( libluksde_blake2b_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		return( -1 );
+	}
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		context->hash_values[ value_index ] = libluksde_blake2b_initialization_vector[ value_index ];
+	}
+	/* The parameter block of an unkeyed sequential hash only contains
+	 * the hash size, a key size of 0, a fanout of 1 and a depth of 1
+	 */
+	context->hash_values[ 0 ] ^= 0x01010000UL | (uint64_t) hash_size;
+
+	context->hash_size = hash_size;
+
+	return( 1 );
+}
+
+/* Updates a BLAKE2b context
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_blake2b_update(
+     libluksde_blake2b_context_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_blake2b_update";
+	size_t buffer_offset  = 0;
+	size_t copy_size      = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer == NULL )
+	 && ( size != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* The last block is compressed by finalize, hence a full block is only
+	 * compressed when more data follows
+	 */
+	while( buffer_offset < size )
+	{
+		if( context->block_data_size == LIBLUKSDE_BLAKE2B_BLOCK_SIZE )
+		{
+			libluksde_blake2b_increment_counter(
+			 context,
+			 LIBLUKSDE_BLAKE2B_BLOCK_SIZE );
+
+			libluksde_blake2b_compress(
+			 context,
+			 context->block_data,
+			 0 );
+
+			context->block_data_size = 0;
+		}
+		copy_size = LIBLUKSDE_BLAKE2B_BLOCK_SIZE - context->block_data_size;
+
+		if( copy_size > ( size - buffer_offset ) )
+		{
+			copy_size = size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( context->block_data[ context->block_data_size ] ),
+		     &( buffer[ buffer_offset ] ),
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to block data.",
+			 function );
+
+			return( -1 );
+		}
+		context->block_data_size += copy_size;
+		buffer_offset            += copy_size;
+	}
+	return( 1 );
+}
+
+/* Finalizes a BLAKE2b context
+ * The hash size must match the size the context was initialized with
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_blake2b_finalize(
+     libluksde_blake2b_context_t *context,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	uint8_t hash_data[ LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE ];
+
+	static char *function = "libluksde_blake2b_finalize";
+	size_t value_index    = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_size != context->hash_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &( context->block_data[ context->block_data_size ] ),
+	     0,
+	     LIBLUKSDE_BLAKE2B_BLOCK_SIZE - context->block_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block data.",
+		 function );
+
+		return( -1 );
+	}
+	libluksde_blake2b_increment_counter(
+	 context,
+	 (uint64_t) context->block_data_size );
+
+	libluksde_blake2b_compress(
+	 context,
+	 context->block_data,
+	 1 );
+
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 &( hash_data[ value_index * 8 ] ),
+		 context->hash_values[ value_index ] );
+	}
+	if( memory_copy(
+	     hash,
+	     hash_data,
+	     hash_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     hash_data,
+	     0,
+	     LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     context,
+	     0,
+	     sizeof( libluksde_blake2b_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	memory_set(
+	 hash_data,
+	 0,
+	 LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE );
+
+	return( -1 );
+}
+
+/* Calculates a BLAKE2b hash of the buffer in a single call
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_blake2b_calculate(
+     const uint8_t *buffer,
+     size_t size,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	libluksde_blake2b_context_t context;
+
+	static char *function = "libluksde_blake2b_calculate";
+
+	if( libluksde_blake2b_initialize(
+	     &context,
+	     hash_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize context.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_blake2b_update(
+	     &context,
+	     buffer,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_blake2b_finalize(
+	     &context,
+	     hash,
+	     hash_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	memory_set(
+	 &context,
+	 0,
+	 sizeof( libluksde_blake2b_context_t ) );
+
+	return( -1 );
+}
+
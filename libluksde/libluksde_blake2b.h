@@ -0,0 +1,96 @@
+/*
+ * BLAKE2b functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_BLAKE2B_H )
+#define _LIBLUKSDE_BLAKE2B_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The BLAKE2b block size
+ */
+#define LIBLUKSDE_BLAKE2B_BLOCK_SIZE			128
+
+/* The largest BLAKE2b hash size
+ */
+#define LIBLUKSDE_BLAKE2B_MAXIMUM_HASH_SIZE		64
+
+typedef struct libluksde_blake2b_context libluksde_blake2b_context_t;
+
+struct libluksde_blake2b_context
+{
+	/* The hash values
+	 */
+	uint64_t hash_values[ 8 ];
+
+	/* The number of bytes processed
+	 */
+	uint64_t number_of_bytes[ 2 ];
+
+	/* The block data
+	 */
+	uint8_t block_data[ LIBLUKSDE_BLAKE2B_BLOCK_SIZE ];
+
+	/* The block data size
+	 */
+	size_t block_data_size;
+
+	/* The hash size
+	 */
+	size_t hash_size;
+};
+
+int libluksde_blake2b_initialize(
+     libluksde_blake2b_context_t *context,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+int libluksde_blake2b_update(
+     libluksde_blake2b_context_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int libluksde_blake2b_finalize(
+     libluksde_blake2b_context_t *context,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+int libluksde_blake2b_calculate(
+     const uint8_t *buffer,
+     size_t size,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_BLAKE2B_H ) */
+
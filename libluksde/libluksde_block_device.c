@@ -0,0 +1,299 @@
+/*
+ * Block device functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_IOCTL_H )
+#include <sys/ioctl.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_LINUX_FS_H )
+#include <linux/fs.h>
+#endif
+
+#include "libluksde_block_device.h"
+#include "libluksde_libcerror.h"
+
+#if defined( HAVE_SYS_IOCTL_H ) && defined( HAVE_SYS_STAT_H ) && defined( BLKGETSIZE64 ) && defined( BLKSSZGET )
+#define LIBLUKSDE_HAVE_BLOCK_DEVICE_IOCTL	1
+#endif
+
+/* Retrieves the size and I/O values of a block device
+ * The minimum and optimal I/O sizes are 0 if the device does not provide them
+ * Returns 1 if successful, 0 if the file descriptor does not refer to a block device or -1 on error
+ */
+int libluksde_block_device_get_io_values(
+     int file_descriptor,
+     size64_t *size,
+     uint32_t *logical_block_size,
+     uint32_t *minimum_io_size,
+     uint32_t *optimal_io_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_block_device_get_io_values";
+
+#if defined( LIBLUKSDE_HAVE_BLOCK_DEVICE_IOCTL )
+	struct stat file_statistics;
+
+	uint64_t device_size       = 0;
+	unsigned int minimum_size  = 0;
+	unsigned int optimal_size  = 0;
+	int sector_size            = 0;
+#endif
+
+	if( file_descriptor < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( logical_block_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical block size.",
+		 function );
+
+		return( -1 );
+	}
+	if( minimum_io_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid minimum I/O size.",
+		 function );
+
+		return( -1 );
+	}
+	if( optimal_io_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid optimal I/O size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBLUKSDE_HAVE_BLOCK_DEVICE_IOCTL )
+	if( fstat(
+	     file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( !S_ISBLK( file_statistics.st_mode ) )
+	{
+		return( 0 );
+	}
+	if( ioctl(
+	     file_descriptor,
+	     BLKGETSIZE64,
+	     &device_size ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_IOCTL_FAILED,
+		 errno,
+		 "%s: unable to query device for: BLKGETSIZE64.",
+		 function );
+
+		return( -1 );
+	}
+	if( ioctl(
+	     file_descriptor,
+	     BLKSSZGET,
+	     &sector_size ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_IOCTL_FAILED,
+		 errno,
+		 "%s: unable to query device for: BLKSSZGET.",
+		 function );
+
+		return( -1 );
+	}
+	/* Older kernels do not support the I/O size queries
+	 */
+#if defined( BLKIOMIN )
+	if( ioctl(
+	     file_descriptor,
+	     BLKIOMIN,
+	     &minimum_size ) != 0 )
+	{
+		minimum_size = 0;
+	}
+#endif
+#if defined( BLKIOOPT )
+	if( ioctl(
+	     file_descriptor,
+	     BLKIOOPT,
+	     &optimal_size ) != 0 )
+	{
+		optimal_size = 0;
+	}
+#endif
+	*size               = (size64_t) device_size;
+	*logical_block_size = (uint32_t) sector_size;
+	*minimum_io_size    = (uint32_t) minimum_size;
+	*optimal_io_size    = (uint32_t) optimal_size;
+
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Retrieves the size and I/O values of a block device by name
+ * Returns 1 if successful, 0 if the file is not a block device or -1 on error
+ */
+int libluksde_block_device_get_io_values_by_name(
+     const char *filename,
+     size64_t *size,
+     uint32_t *logical_block_size,
+     uint32_t *minimum_io_size,
+     uint32_t *optimal_io_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_block_device_get_io_values_by_name";
+	int result            = 0;
+
+#if defined( LIBLUKSDE_HAVE_BLOCK_DEVICE_IOCTL )
+	int file_descriptor   = -1;
+#endif
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBLUKSDE_HAVE_BLOCK_DEVICE_IOCTL )
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	result = libluksde_block_device_get_io_values(
+	          file_descriptor,
+	          size,
+	          logical_block_size,
+	          minimum_io_size,
+	          optimal_io_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block device I/O values of file: %s.",
+		 function,
+		 filename );
+	}
+	close(
+	 file_descriptor );
+#else
+	if( ( size == NULL )
+	 || ( logical_block_size == NULL )
+	 || ( minimum_io_size == NULL )
+	 || ( optimal_io_size == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid I/O values.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
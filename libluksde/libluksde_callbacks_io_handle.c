@@ -0,0 +1,662 @@
+/*
+ * Callbacks I/O handle functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_callbacks_io_handle.h"
+#include "libluksde_io_callbacks.h"
+#include "libluksde_libbfio.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_types.h"
+#include "libluksde_unused.h"
+
+/* Creates a callbacks I/O handle
+ * Make sure the value callbacks_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_callbacks_io_handle_initialize(
+     libluksde_callbacks_io_handle_t **callbacks_io_handle,
+     const libluksde_io_callbacks_t *io_callbacks,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_callbacks_io_handle_initialize";
+
+	if( callbacks_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callbacks I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *callbacks_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid callbacks I/O handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_callbacks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid I/O callbacks.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_callbacks->read_at_offset == NULL )
+	 || ( io_callbacks->get_size == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid I/O callbacks - missing function.",
+		 function );
+
+		return( -1 );
+	}
+	*callbacks_io_handle = memory_allocate_structure(
+	                        libluksde_callbacks_io_handle_t );
+
+	if( *callbacks_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create callbacks I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *callbacks_io_handle,
+	     0,
+	     sizeof( libluksde_callbacks_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear callbacks I/O handle.",
+		 function );
+
+		memory_free(
+		 *callbacks_io_handle );
+
+		*callbacks_io_handle = NULL;
+
+		return( -1 );
+	}
+	( *callbacks_io_handle )->io_callbacks.read_at_offset = io_callbacks->read_at_offset;
+	( *callbacks_io_handle )->io_callbacks.get_size       = io_callbacks->get_size;
+	( *callbacks_io_handle )->io_callbacks.user_data      = io_callbacks->user_data;
+
+	return( 1 );
+}
+
+/* Creates a Basic File IO (bfio) handle that reads using I/O callbacks
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_callbacks_file_initialize(
+     libbfio_handle_t **handle,
+     const libluksde_io_callbacks_t *io_callbacks,
+     libcerror_error_t **error )
+{
+	libluksde_callbacks_io_handle_t *callbacks_io_handle = NULL;
+	static char *function                                = "libluksde_callbacks_file_initialize";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_callbacks_io_handle_initialize(
+	     &callbacks_io_handle,
+	     io_callbacks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create callbacks I/O handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     handle,
+	     (intptr_t *) callbacks_io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libluksde_callbacks_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libluksde_callbacks_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libluksde_callbacks_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libluksde_callbacks_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libluksde_callbacks_io_handle_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libluksde_callbacks_io_handle_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libluksde_callbacks_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libluksde_callbacks_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libluksde_callbacks_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libluksde_callbacks_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( callbacks_io_handle != NULL )
+	{
+		libluksde_callbacks_io_handle_free(
+		 &callbacks_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a callbacks I/O handle
+ * The user data of the I/O callbacks is not freed
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_callbacks_io_handle_free(
+     libluksde_callbacks_io_handle_t **callbacks_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_callbacks_io_handle_free";
+
+	if( callbacks_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callbacks I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *callbacks_io_handle != NULL )
+	{
+		memory_free(
+		 *callbacks_io_handle );
+
+		*callbacks_io_handle = NULL;
+	}
+	return( 1 );
+}
+
+/* Clones (duplicates) the callbacks I/O handle
+ * The clone is not opened and shares the user data of the I/O callbacks
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_callbacks_io_handle_clone(
+     libluksde_callbacks_io_handle_t **destination_callbacks_io_handle,
+     libluksde_callbacks_io_handle_t *source_callbacks_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_callbacks_io_handle_clone";
+
+	if( destination_callbacks_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination callbacks I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_callbacks_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination callbacks I/O handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_callbacks_io_handle == NULL )
+	{
+		*destination_callbacks_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libluksde_callbacks_io_handle_initialize(
+	     destination_callbacks_io_handle,
+	     &( source_callbacks_io_handle->io_callbacks ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination callbacks I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens the callbacks I/O handle
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_callbacks_io_handle_open(
+     libluksde_callbacks_io_handle_t *callbacks_io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_callbacks_io_handle_open";
+	size64_t size         = 0;
+
+	if( callbacks_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callbacks I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( callbacks_io_handle->is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid callbacks I/O handle - already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( access_flags & LIBBFIO_ACCESS_FLAG_READ ) == 0 )
+	 || ( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_io_callbacks_get_size(
+	     &( callbacks_io_handle->io_callbacks ),
+	     &size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size.",
+		 function );
+
+		return( -1 );
+	}
+	callbacks_io_handle->current_offset = 0;
+	callbacks_io_handle->size           = size;
+	callbacks_io_handle->is_open        = 1;
+
+	return( 1 );
+}
+
+/* Closes the callbacks I/O handle
+ * Returns 0 if successful or -1 on error
+ */
+int libluksde_callbacks_io_handle_close(
+     libluksde_callbacks_io_handle_t *callbacks_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_callbacks_io_handle_close";
+
+	if( callbacks_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callbacks I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( callbacks_io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid callbacks I/O handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	callbacks_io_handle->current_offset = 0;
+	callbacks_io_handle->size           = 0;
+	callbacks_io_handle->is_open        = 0;
+
+	return( 0 );
+}
+
+/* Reads a buffer from the callbacks I/O handle
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libluksde_callbacks_io_handle_read(
+         libluksde_callbacks_io_handle_t *callbacks_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libluksde_callbacks_io_handle_read";
+	ssize_t read_count    = 0;
+
+	if( callbacks_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callbacks I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( callbacks_io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid callbacks I/O handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) callbacks_io_handle->current_offset >= callbacks_io_handle->size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) size > ( callbacks_io_handle->size - callbacks_io_handle->current_offset ) )
+	{
+		size = (size_t) ( callbacks_io_handle->size - callbacks_io_handle->current_offset );
+	}
+	read_count = libluksde_io_callbacks_read_buffer_at_offset(
+	              &( callbacks_io_handle->io_callbacks ),
+	              buffer,
+	              size,
+	              callbacks_io_handle->current_offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 callbacks_io_handle->current_offset,
+		 callbacks_io_handle->current_offset );
+
+		return( -1 );
+	}
+	callbacks_io_handle->current_offset += read_count;
+
+	return( read_count );
+}
+
+/* Writes a buffer to the callbacks I/O handle
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libluksde_callbacks_io_handle_write(
+         libluksde_callbacks_io_handle_t *callbacks_io_handle,
+         const uint8_t *buffer LIBLUKSDE_ATTRIBUTE_UNUSED,
+         size_t size LIBLUKSDE_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error )
+{
+	static char *function = "libluksde_callbacks_io_handle_write";
+
+	LIBLUKSDE_UNREFERENCED_PARAMETER( buffer )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( size )
+
+	if( callbacks_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callbacks I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: write access currently not supported.",
+	 function );
+
+	return( -1 );
+}
+
+/* Seeks a certain offset within the callbacks I/O handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libluksde_callbacks_io_handle_seek_offset(
+         libluksde_callbacks_io_handle_t *callbacks_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libluksde_callbacks_io_handle_seek_offset";
+
+	if( callbacks_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callbacks I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += callbacks_io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) callbacks_io_handle->size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	callbacks_io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if the data of the I/O callbacks exists
+ * Returns 1 if the data exists, 0 if not or -1 on error
+ */
+int libluksde_callbacks_io_handle_exists(
+     libluksde_callbacks_io_handle_t *callbacks_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_callbacks_io_handle_exists";
+
+	if( callbacks_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callbacks I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Check if the callbacks I/O handle is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libluksde_callbacks_io_handle_is_open(
+     libluksde_callbacks_io_handle_t *callbacks_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_callbacks_io_handle_is_open";
+
+	if( callbacks_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callbacks I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( callbacks_io_handle->is_open == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the size
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_callbacks_io_handle_get_size(
+     libluksde_callbacks_io_handle_t *callbacks_io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_callbacks_io_handle_get_size";
+
+	if( callbacks_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callbacks I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( callbacks_io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid callbacks I/O handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	*size = callbacks_io_handle->size;
+
+	return( 1 );
+}
+
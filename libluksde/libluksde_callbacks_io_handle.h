@@ -0,0 +1,121 @@
+/*
+ * Callbacks I/O handle functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_CALLBACKS_IO_HANDLE_H )
+#define _LIBLUKSDE_CALLBACKS_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libbfio.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libluksde_callbacks_io_handle libluksde_callbacks_io_handle_t;
+
+struct libluksde_callbacks_io_handle
+{
+	/* The I/O callbacks
+	 */
+	libluksde_io_callbacks_t io_callbacks;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* Value to indicate the callbacks I/O handle is open
+	 */
+	uint8_t is_open;
+};
+
+int libluksde_callbacks_io_handle_initialize(
+     libluksde_callbacks_io_handle_t **callbacks_io_handle,
+     const libluksde_io_callbacks_t *io_callbacks,
+     libcerror_error_t **error );
+
+int libluksde_callbacks_file_initialize(
+     libbfio_handle_t **handle,
+     const libluksde_io_callbacks_t *io_callbacks,
+     libcerror_error_t **error );
+
+int libluksde_callbacks_io_handle_free(
+     libluksde_callbacks_io_handle_t **callbacks_io_handle,
+     libcerror_error_t **error );
+
+int libluksde_callbacks_io_handle_clone(
+     libluksde_callbacks_io_handle_t **destination_callbacks_io_handle,
+     libluksde_callbacks_io_handle_t *source_callbacks_io_handle,
+     libcerror_error_t **error );
+
+int libluksde_callbacks_io_handle_open(
+     libluksde_callbacks_io_handle_t *callbacks_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libluksde_callbacks_io_handle_close(
+     libluksde_callbacks_io_handle_t *callbacks_io_handle,
+     libcerror_error_t **error );
+
+ssize_t libluksde_callbacks_io_handle_read(
+         libluksde_callbacks_io_handle_t *callbacks_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libluksde_callbacks_io_handle_write(
+         libluksde_callbacks_io_handle_t *callbacks_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libluksde_callbacks_io_handle_seek_offset(
+         libluksde_callbacks_io_handle_t *callbacks_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libluksde_callbacks_io_handle_exists(
+     libluksde_callbacks_io_handle_t *callbacks_io_handle,
+     libcerror_error_t **error );
+
+int libluksde_callbacks_io_handle_is_open(
+     libluksde_callbacks_io_handle_t *callbacks_io_handle,
+     libcerror_error_t **error );
+
+int libluksde_callbacks_io_handle_get_size(
+     libluksde_callbacks_io_handle_t *callbacks_io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_CALLBACKS_IO_HANDLE_H ) */
+
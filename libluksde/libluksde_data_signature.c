@@ -0,0 +1,144 @@
+/*
+ * Data signature functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_data_signature.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_libcnotify.h"
+
+typedef struct libluksde_data_signature libluksde_data_signature_t;
+
+struct libluksde_data_signature
+{
+	/* The offset of the signature relative to the start of the data
+	 */
+	size_t offset;
+
+	/* The signature
+	 */
+	const uint8_t *signature;
+
+	/* The signature size
+	 */
+	size_t signature_size;
+
+	/* The description
+	 */
+	const char *description;
+};
+
+/* The known signatures of the first data of a decrypted volume
+ */
+static const libluksde_data_signature_t libluksde_data_signatures[] = {
+	{ 0,    (const uint8_t *) "LUKS\xba\xbe", 6, "LUKS (nested)" },
+	{ 0,    (const uint8_t *) "XFSB", 4, "XFS" },
+	{ 0,    (const uint8_t *) "hsqs", 4, "squashfs" },
+	{ 3,    (const uint8_t *) "NTFS    ", 8, "NTFS" },
+	{ 3,    (const uint8_t *) "EXFAT   ", 8, "exFAT" },
+	{ 32,   (const uint8_t *) "NXSB", 4, "APFS" },
+	{ 54,   (const uint8_t *) "FAT", 3, "FAT12/16" },
+	{ 82,   (const uint8_t *) "FAT", 3, "FAT32" },
+	{ 510,  (const uint8_t *) "\x55\xaa", 2, "boot sector" },
+	{ 512,  (const uint8_t *) "EFI PART", 8, "GPT" },
+	{ 512,  (const uint8_t *) "LABELONE", 8, "LVM2" },
+	{ 1024, (const uint8_t *) "LABELONE", 8, "LVM2" },
+	{ 1024, (const uint8_t *) "\x10\x20\xf5\xf2", 4, "F2FS" },
+	{ 1024, (const uint8_t *) "H+", 2, "HFS+" },
+	{ 1024, (const uint8_t *) "HX", 2, "HFSX" },
+	{ 1080, (const uint8_t *) "\x53\xef", 2, "ext2/3/4" },
+	{ 1536, (const uint8_t *) "LABELONE", 8, "LVM2" },
+	{ 4086, (const uint8_t *) "SWAPSPACE2", 10, "Linux swap" },
+	{ 4086, (const uint8_t *) "SWAP-SPACE", 10, "Linux swap" },
+	{ 0, NULL, 0, NULL } };
+
+/* Checks if the data contains a known file system, volume system or partition table signature
+ * Signatures that lie beyond the end of the data are not checked
+ * Returns 1 if a signature was found, 0 if not or -1 on error
+ */
+int libluksde_data_signature_check(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	const libluksde_data_signature_t *data_signature = NULL;
+	static char *function                            = "libluksde_data_signature_check";
+	int signature_index                              = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	for( signature_index = 0;
+	     libluksde_data_signatures[ signature_index ].signature != NULL;
+	     signature_index++ )
+	{
+		data_signature = &( libluksde_data_signatures[ signature_index ] );
+
+		if( data_signature->signature_size > data_size )
+		{
+			continue;
+		}
+		if( data_signature->offset > ( data_size - data_signature->signature_size ) )
+		{
+			continue;
+		}
+		if( memory_compare(
+		     &( data[ data_signature->offset ] ),
+		     data_signature->signature,
+		     data_signature->signature_size ) == 0 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: found %s signature at offset: %" PRIzd ".\n",
+				 function,
+				 data_signature->description,
+				 data_signature->offset );
+			}
+#endif
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
@@ -29,52 +29,37 @@
 #include "libluksde_libcerror.h"
 #include "libluksde_libcnotify.h"
 #include "libluksde_libhmac.h"
+#include "libluksde_sha.h"
 
-/* Diffuses data
+/* Retrieves the hash function and hash size of a hashing method
  * Returns 1 if successful or -1 on error
  */
-int libluksde_diffuser_diffuse(
-     uint8_t *data,
-     size_t data_size,
+int libluksde_diffuser_get_hash_function(
      int hashing_method,
+     libluksde_diffuser_hash_function_t *hash_function,
+     size_t *hash_size,
      libcerror_error_t **error )
 {
-	uint8_t block_index_buffer[ 4 ];
-	uint8_t hash_buffer[ 64 ];
-
-	libhmac_sha1_context_t *sha1_context     = NULL;
-	libhmac_sha224_context_t *sha224_context = NULL;
-	libhmac_sha256_context_t *sha256_context = NULL;
-	libhmac_sha512_context_t *sha512_context = NULL;
-	static char *function                    = "libluksde_diffuser_diffuse";
-	size_t data_offset                       = 0;
-	size_t hash_size                         = 0;
-	size_t read_size                         = 0;
-	uint32_t block_index                     = 0;
-	int result                               = 0;
+	static char *function = "libluksde_diffuser_get_hash_function";
 
-	if( data == NULL )
+	if( hash_function == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data.",
+		 "%s: invalid hash function.",
 		 function );
 
 		return( -1 );
 	}
-#if SIZEOF_SIZE_T <= 4
-	if( data_size > (size_t) SSIZE_MAX )
-#else
-	if( data_size > (size_t) UINT32_MAX )
-#endif
+	if( hash_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid data size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash size.",
 		 function );
 
 		return( -1 );
@@ -82,19 +67,23 @@ int libluksde_diffuser_diffuse(
 	switch( hashing_method )
 	{
 		case LIBLUKSDE_HASHING_METHOD_SHA1:
-			hash_size = LIBHMAC_SHA1_HASH_SIZE;
+			*hash_function = &libhmac_sha1_calculate;
+			*hash_size     = LIBHMAC_SHA1_HASH_SIZE;
 			break;
 
 		case LIBLUKSDE_HASHING_METHOD_SHA224:
-			hash_size = LIBHMAC_SHA224_HASH_SIZE;
+			*hash_function = &libhmac_sha224_calculate;
+			*hash_size     = LIBHMAC_SHA224_HASH_SIZE;
 			break;
 
 		case LIBLUKSDE_HASHING_METHOD_SHA256:
-			hash_size = LIBHMAC_SHA256_HASH_SIZE;
+			*hash_function = &libhmac_sha256_calculate;
+			*hash_size     = LIBHMAC_SHA256_HASH_SIZE;
 			break;
 
 		case LIBLUKSDE_HASHING_METHOD_SHA512:
-			hash_size = LIBHMAC_SHA512_HASH_SIZE;
+			*hash_function = &libhmac_sha512_calculate;
+			*hash_size     = LIBHMAC_SHA512_HASH_SIZE;
 			break;
 
 		default:
@@ -107,296 +96,322 @@ int libluksde_diffuser_diffuse(
 
 			return( -1 );
 	}
+	return( 1 );
+}
+
+/* Diffuses data
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_diffuser_diffuse(
+     uint8_t *data,
+     size_t data_size,
+     int hashing_method,
+     libcerror_error_t **error )
+{
+	libluksde_sha_context_t initial_context;
+
+	static char *function = "libluksde_diffuser_diffuse";
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+#if SIZEOF_SIZE_T <= 4
+	if( data_size > (size_t) SSIZE_MAX )
+#else
+	if( data_size > (size_t) UINT32_MAX )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_sha_initialize(
+	     &initial_context,
+	     hashing_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize hash context.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_diffuser_diffuse_with_context(
+	     data,
+	     data_size,
+	     &initial_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to diffuse data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Diffuses data using an initialized hash context
+ * Every hash sized block is replaced by the hash of the 32-bit big-endian
+ * block index followed by the block data. Every block is hashed with a copy
+ * of the initial context on the stack, so no hash context is allocated
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_diffuser_diffuse_with_context(
+     uint8_t *data,
+     size_t data_size,
+     const libluksde_sha_context_t *initial_context,
+     libcerror_error_t **error )
+{
+	libluksde_sha_context_t context;
+
+	uint8_t block_index_data[ 4 ];
+	uint8_t hash_buffer[ LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE ];
+
+	static char *function = "libluksde_diffuser_diffuse_with_context";
+	size_t data_offset    = 0;
+	size_t hash_size      = 0;
+	size_t read_size      = 0;
+	uint32_t block_index  = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+#if SIZEOF_SIZE_T <= 4
+	if( data_size > (size_t) SSIZE_MAX )
+#else
+	if( data_size > (size_t) UINT32_MAX )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( initial_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid initial context.",
+		 function );
+
+		return( -1 );
+	}
+	hash_size = initial_context->hash_size;
+
+	if( ( hash_size == 0 )
+	 || ( hash_size > LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid initial context - hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 	while( data_size > 0 )
 	{
-		switch( hashing_method )
+		read_size = hash_size;
+
+		if( read_size > data_size )
 		{
-			case LIBLUKSDE_HASHING_METHOD_SHA1:
-				result = libhmac_sha1_initialize(
-					  &sha1_context,
-					  error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA224:
-				result = libhmac_sha224_initialize(
-					  &sha224_context,
-					  error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA256:
-				result = libhmac_sha256_initialize(
-					  &sha256_context,
-					  error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA512:
-				result = libhmac_sha512_initialize(
-					  &sha512_context,
-					  error );
-				break;
-
-			default:
-				result = 0;
-				break;
+			read_size = data_size;
 		}
-		if( result != 1 )
+		if( memory_copy(
+		     &context,
+		     initial_context,
+		     sizeof( libluksde_sha_context_t ) ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize context.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy initial context.",
 			 function );
 
 			goto on_error;
 		}
 		byte_stream_copy_from_uint32_big_endian(
-		 block_index_buffer,
+		 block_index_data,
 		 block_index );
 
-		switch( hashing_method )
-		{
-			case LIBLUKSDE_HASHING_METHOD_SHA1:
-				result = libhmac_sha1_update(
-				          sha1_context,
-				          block_index_buffer,
-				          4,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA224:
-				result = libhmac_sha224_update(
-				          sha224_context,
-				          block_index_buffer,
-				          4,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA256:
-				result = libhmac_sha256_update(
-				          sha256_context,
-				          block_index_buffer,
-				          4,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA512:
-				result = libhmac_sha512_update(
-				          sha512_context,
-				          block_index_buffer,
-				          4,
-				          error );
-				break;
-
-			default:
-				result = 0;
-				break;
-		}
-		if( result != 1 )
+		if( libluksde_sha_update(
+		     &context,
+		     block_index_data,
+		     4,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update context.",
-			 function );
+			 "%s: unable to update context with block index: %" PRIu32 ".",
+			 function,
+			 block_index );
 
 			goto on_error;
 		}
-		if( data_size < hash_size )
-		{
-			read_size = data_size;
-		}
-		else
-		{
-			read_size = hash_size;
-		}
-		switch( hashing_method )
-		{
-			case LIBLUKSDE_HASHING_METHOD_SHA1:
-				result = libhmac_sha1_update(
-				          sha1_context,
-				          &( data[ data_offset ] ),
-				          read_size,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA224:
-				result = libhmac_sha224_update(
-				          sha224_context,
-				          &( data[ data_offset ] ),
-				          read_size,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA256:
-				result = libhmac_sha256_update(
-				          sha256_context,
-				          &( data[ data_offset ] ),
-				          read_size,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA512:
-				result = libhmac_sha512_update(
-				          sha512_context,
-				          &( data[ data_offset ] ),
-				          read_size,
-				          error );
-				break;
-
-			default:
-				result = 0;
-				break;
-		}
-		if( result != 1 )
+		if( libluksde_sha_update(
+		     &context,
+		     &( data[ data_offset ] ),
+		     read_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update context.",
-			 function );
+			 "%s: unable to update context with block: %" PRIu32 ".",
+			 function,
+			 block_index );
 
 			goto on_error;
 		}
-		switch( hashing_method )
+		if( read_size == hash_size )
 		{
-			case LIBLUKSDE_HASHING_METHOD_SHA1:
-				result = libhmac_sha1_finalize(
-				          sha1_context,
-				          hash_buffer,
-				          hash_size,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA224:
-				result = libhmac_sha224_finalize(
-				          sha224_context,
-				          hash_buffer,
-				          hash_size,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA256:
-				result = libhmac_sha256_finalize(
-				          sha256_context,
-				          hash_buffer,
-				          hash_size,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA512:
-				result = libhmac_sha512_finalize(
-				          sha512_context,
-				          hash_buffer,
-				          hash_size,
-				          error );
-				break;
-
-			default:
-				result = 0;
-				break;
+			/* A full block is hashed directly into the data
+			 */
+			if( libluksde_sha_finalize(
+			     &context,
+			     &( data[ data_offset ] ),
+			     hash_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to finalize context of block: %" PRIu32 ".",
+				 function,
+				 block_index );
+
+				goto on_error;
+			}
 		}
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize context.",
-			 function );
-
-			goto on_error;
-		}
-		switch( hashing_method )
+		else
 		{
-			case LIBLUKSDE_HASHING_METHOD_SHA1:
-				result = libhmac_sha1_free(
-				          &sha1_context,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA224:
-				result = libhmac_sha224_free(
-				          &sha224_context,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA256:
-				result = libhmac_sha256_free(
-				          &sha256_context,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA512:
-				result = libhmac_sha512_free(
-				          &sha512_context,
-				          error );
-				break;
-
-			default:
-				result = 0;
-				break;
-		}
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free context.",
-			 function );
-
-			goto on_error;
-		}
-		if( memory_copy(
-		     &( data[ data_offset ] ),
-		     hash_buffer,
-		     read_size ) == NULL)
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy hash to data.",
-			 function );
-
-			goto on_error;
+			if( libluksde_sha_finalize(
+			     &context,
+			     hash_buffer,
+			     hash_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to finalize context of block: %" PRIu32 ".",
+				 function,
+				 block_index );
+
+				goto on_error;
+			}
+			if( memory_copy(
+			     &( data[ data_offset ] ),
+			     hash_buffer,
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy hash to data.",
+				 function );
+
+				goto on_error;
+			}
 		}
 		data_offset += read_size;
 		data_size   -= read_size;
 
 		block_index++;
 	}
+	memory_set(
+	 hash_buffer,
+	 0,
+	 LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE );
+
 	return( 1 );
 
 on_error:
-	if( sha512_context != NULL )
-	{
-		libhmac_sha512_free(
-		 &sha512_context,
-		 NULL );
-	}
-	if( sha256_context != NULL )
-	{
-		libhmac_sha256_free(
-		 &sha256_context,
-		 NULL );
-	}
-	if( sha224_context != NULL )
+	memory_set(
+	 &context,
+	 0,
+	 sizeof( libluksde_sha_context_t ) );
+
+	memory_set(
+	 hash_buffer,
+	 0,
+	 LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE );
+
+	return( -1 );
+}
+
+/* XORs the stripe data into the data
+ * The loop is unrolled to process 8 bytes at a time so that compilers
+ * can map it onto the widest available vector registers
+ */
+void libluksde_diffuser_xor_stripe(
+      uint8_t *data,
+      const uint8_t *stripe_data,
+      size_t data_size )
+{
+	size_t data_offset = 0;
+
+	while( ( data_offset + 8 ) <= data_size )
 	{
-		libhmac_sha224_free(
-		 &sha224_context,
-		 NULL );
+		data[ data_offset ]     ^= stripe_data[ data_offset ];
+		data[ data_offset + 1 ] ^= stripe_data[ data_offset + 1 ];
+		data[ data_offset + 2 ] ^= stripe_data[ data_offset + 2 ];
+		data[ data_offset + 3 ] ^= stripe_data[ data_offset + 3 ];
+		data[ data_offset + 4 ] ^= stripe_data[ data_offset + 4 ];
+		data[ data_offset + 5 ] ^= stripe_data[ data_offset + 5 ];
+		data[ data_offset + 6 ] ^= stripe_data[ data_offset + 6 ];
+		data[ data_offset + 7 ] ^= stripe_data[ data_offset + 7 ];
+
+		data_offset += 8;
 	}
-	if( sha1_context != NULL )
+	while( data_offset < data_size )
 	{
-		libhmac_sha1_free(
-		 &sha1_context,
-		 NULL );
+		data[ data_offset ] ^= stripe_data[ data_offset ];
+
+		data_offset++;
 	}
-	return( -1 );
 }
 
 /* Merges the split data using the diffuser
@@ -411,10 +426,52 @@ int libluksde_diffuser_merge(
      int hashing_method,
      libcerror_error_t **error )
 {
-	static char *function    = "libluksde_diffuser_merge";
-	size_t data_offset       = 0;
+	static char *function = "libluksde_diffuser_merge";
+
+	if( libluksde_diffuser_merge_stripes(
+	     split_data,
+	     split_data_size,
+	     data,
+	     data_size,
+	     0,
+	     number_of_stripes,
+	     hashing_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to merge stripes.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Merges a consecutive range of stripes of the split data using the diffuser
+ * The split data contains the stripes starting with the stripe at the first stripe index.
+ * The data contains the intermediate result of the stripes merged previously,
+ * which allows the split data to be merged in multiple parts
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_diffuser_merge_stripes(
+     const uint8_t *split_data,
+     size_t split_data_size,
+     uint8_t *data,
+     size_t data_size,
+     uint32_t first_stripe_index,
+     uint32_t number_of_stripes,
+     int hashing_method,
+     libcerror_error_t **error )
+{
+	libluksde_sha_context_t initial_context;
+
+	static char *function    = "libluksde_diffuser_merge_stripes";
 	size_t split_data_offset = 0;
 	uint32_t stripe_iterator = 0;
+	uint32_t stripe_index    = 0;
 
 	if( split_data == NULL )
 	{
@@ -463,7 +520,8 @@ int libluksde_diffuser_merge(
 		return( -1 );
 	}
 	if( ( number_of_stripes < 1 )
-	 || ( number_of_stripes > ( split_data_size / data_size ) ) )
+	 || ( number_of_stripes > ( split_data_size / data_size ) )
+	 || ( first_stripe_index > ( UINT32_MAX - number_of_stripes ) ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -474,57 +532,77 @@ int libluksde_diffuser_merge(
 
 		return( -1 );
 	}
-	if( memory_set(
-	     data,
-	     0,
-	     data_size ) == NULL )
+	/* The hash context is initialized once and copied for every block
+	 */
+	if( libluksde_sha_initialize(
+	     &initial_context,
+	     hashing_method,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear data.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize hash context.",
 		 function );
 
 		return( -1 );
 	}
+	stripe_index = first_stripe_index;
+
 	for( stripe_iterator = 0;
-	     stripe_iterator < ( number_of_stripes - 1 );
+	     stripe_iterator < number_of_stripes;
 	     stripe_iterator++ )
 	{
-		for( data_offset = 0;
-		     data_offset < data_size;
-		     data_offset++ )
+		if( stripe_index == 0 )
 		{
-			data[ data_offset ] ^= split_data[ split_data_offset ];
-
-			split_data_offset++;
+			/* Since the merged data starts zeroed the first stripe
+			 * can be copied instead of XOR-ed
+			 */
+			if( memory_copy(
+			     data,
+			     split_data,
+			     data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy first stripe to data.",
+				 function );
+
+				return( -1 );
+			}
 		}
-		if( libluksde_diffuser_diffuse(
-		     data,
-		     data_size,
-		     hashing_method,
-		     error ) != 1 )
+		else
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to diffuse stripe: %" PRIu32 ".",
-			 function,
-			 stripe_iterator );
-
-			return( -1 );
+			/* Every stripe except the last one is diffused after it was XOR-ed,
+			 * which is done here before the next stripe is XOR-ed
+			 */
+			if( libluksde_diffuser_diffuse_with_context(
+			     data,
+			     data_size,
+			     &initial_context,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to diffuse stripe: %" PRIu32 ".",
+				 function,
+				 stripe_index - 1 );
+
+				return( -1 );
+			}
+			libluksde_diffuser_xor_stripe(
+			 data,
+			 &( split_data[ split_data_offset ] ),
+			 data_size );
 		}
-	}
-	for( data_offset = 0;
-	     data_offset < data_size;
-	     data_offset++ )
-	{
-		data[ data_offset ] ^= split_data[ split_data_offset ];
+		split_data_offset += data_size;
 
-		split_data_offset++;
+		stripe_index++;
 	}
 	return( 1 );
 }
-
@@ -26,17 +26,48 @@
 #include <types.h>
 
 #include "libluksde_libcerror.h"
+#include "libluksde_sha.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The largest supported hash size (SHA-512)
+ */
+#define LIBLUKSDE_DIFFUSER_MAXIMUM_HASH_SIZE		64
+
+/* Callback function to calculate a hash in a single call
+ */
+typedef int (*libluksde_diffuser_hash_function_t)(
+             const uint8_t *buffer,
+             size_t size,
+             uint8_t *hash,
+             size_t hash_size,
+             libcerror_error_t **error );
+
+int libluksde_diffuser_get_hash_function(
+     int hashing_method,
+     libluksde_diffuser_hash_function_t *hash_function,
+     size_t *hash_size,
+     libcerror_error_t **error );
+
 int libluksde_diffuser_diffuse(
      uint8_t *data,
      size_t data_size,
      int hashing_method,
      libcerror_error_t **error );
 
+int libluksde_diffuser_diffuse_with_context(
+     uint8_t *data,
+     size_t data_size,
+     const libluksde_sha_context_t *initial_context,
+     libcerror_error_t **error );
+
+void libluksde_diffuser_xor_stripe(
+      uint8_t *data,
+      const uint8_t *stripe_data,
+      size_t data_size );
+
 int libluksde_diffuser_merge(
      const uint8_t *split_data,
      size_t split_data_size,
@@ -46,6 +77,16 @@ int libluksde_diffuser_merge(
      int hashing_method,
      libcerror_error_t **error );
 
+int libluksde_diffuser_merge_stripes(
+     const uint8_t *split_data,
+     size_t split_data_size,
+     uint8_t *data,
+     size_t data_size,
+     uint32_t first_stripe_index,
+     uint32_t number_of_stripes,
+     int hashing_method,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,613 @@
+/*
+ * Digest functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_definitions.h"
+#include "libluksde_digest.h"
+#include "libluksde_json_tokenizer.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_libcnotify.h"
+#include "libluksde_password.h"
+#include "libluksde_volume_header.h"
+
+/* Creates a digest
+ * Make sure the value digest is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_digest_initialize(
+     libluksde_digest_t **digest,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_digest_initialize";
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*digest = memory_allocate_structure(
+	             libluksde_digest_t );
+
+	if( *digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *digest,
+	     0,
+	     sizeof( libluksde_digest_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digest.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *digest != NULL )
+	{
+		memory_free(
+		 *digest );
+
+		*digest = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a digest
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_digest_free(
+     libluksde_digest_t **digest,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_digest_free";
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest != NULL )
+	{
+		memory_free(
+		 *digest );
+
+		*digest = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads a JSON array of identifiers into a bitmap
+ * The tokenizer must be positioned after the start of the array
+ * Identifiers of 32 or more are not supported
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_digest_read_json_identifiers_array(
+     libluksde_json_tokenizer_t *tokenizer,
+     uint32_t *identifiers_bitmap,
+     libcerror_error_t **error )
+{
+	libluksde_json_token_t token;
+
+	static char *function = "libluksde_digest_read_json_identifiers_array";
+	uint64_t identifier   = 0;
+	uint32_t safe_bitmap  = 0;
+
+	if( identifiers_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid identifiers bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		if( libluksde_json_tokenizer_get_next_token(
+		     tokenizer,
+		     &token,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next token.",
+			 function );
+
+			return( -1 );
+		}
+		if( token.type == LIBLUKSDE_JSON_TOKEN_TYPE_ARRAY_END )
+		{
+			break;
+		}
+		if( libluksde_json_token_get_integer_value(
+		     &token,
+		     &identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve identifier.",
+			 function );
+
+			return( -1 );
+		}
+		if( identifier >= 32 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid identifier value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		safe_bitmap |= (uint32_t) 1 << identifier;
+	}
+	while( token.type != LIBLUKSDE_JSON_TOKEN_TYPE_ARRAY_END );
+
+	*identifiers_bitmap = safe_bitmap;
+
+	return( 1 );
+}
+
+/* Reads a digest from a JSON object
+ * The tokenizer must be positioned after the start of the digest object
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_digest_read_json_object(
+     libluksde_digest_t *digest,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error )
+{
+	uint8_t hashing_method_string[ 32 ];
+
+	libluksde_json_token_t key_token;
+	libluksde_json_token_t value_token;
+
+	static char *function = "libluksde_digest_read_json_object";
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		result = libluksde_json_tokenizer_get_next_member(
+		          tokenizer,
+		          &key_token,
+		          &value_token,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve digest member.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libluksde_json_token_compare_string(
+		     &key_token,
+		     "type",
+		     4,
+		     error ) == 1 )
+		{
+			if( libluksde_json_token_compare_string(
+			     &value_token,
+			     "pbkdf2",
+			     6,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported digest type.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( ( value_token.type == LIBLUKSDE_JSON_TOKEN_TYPE_ARRAY_START )
+		      && ( libluksde_json_token_compare_string(
+		            &key_token,
+		            "keyslots",
+		            8,
+		            error ) == 1 ) )
+		{
+			if( libluksde_digest_read_json_identifiers_array(
+			     tokenizer,
+			     &( digest->key_slots_bitmap ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read key slots array.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( ( value_token.type == LIBLUKSDE_JSON_TOKEN_TYPE_ARRAY_START )
+		      && ( libluksde_json_token_compare_string(
+		            &key_token,
+		            "segments",
+		            8,
+		            error ) == 1 ) )
+		{
+			if( libluksde_digest_read_json_identifiers_array(
+			     tokenizer,
+			     &( digest->segments_bitmap ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read segments array.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "hash",
+		          4,
+		          error ) == 1 )
+		{
+			if( libluksde_json_token_copy_string(
+			     &value_token,
+			     hashing_method_string,
+			     32,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+				 "%s: unable to copy hashing method string.",
+				 function );
+
+				return( -1 );
+			}
+			if( libluksde_volume_parse_hashing_method(
+			     hashing_method_string,
+			     &( digest->hashing_method ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to parse hashing method.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "iterations",
+		          10,
+		          error ) == 1 )
+		{
+			if( libluksde_json_token_get_integer_value(
+			     &value_token,
+			     &value_64bit,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of iterations.",
+				 function );
+
+				return( -1 );
+			}
+			if( value_64bit > (uint64_t) UINT32_MAX )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid number of iterations value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			digest->number_of_iterations = (uint32_t) value_64bit;
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "salt",
+		          4,
+		          error ) == 1 )
+		{
+			if( libluksde_json_token_get_base64_value(
+			     &value_token,
+			     digest->salt,
+			     64,
+			     &( digest->salt_size ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve salt.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "digest",
+		          6,
+		          error ) == 1 )
+		{
+			if( libluksde_json_token_get_base64_value(
+			     &value_token,
+			     digest->digest,
+			     64,
+			     &( digest->digest_size ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve digest.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_tokenizer_skip_value(
+		          tokenizer,
+		          &value_token,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to skip value.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( result != 0 );
+
+	if( ( digest->digest_size == 0 )
+	 || ( digest->number_of_iterations == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing digest values.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: key slots bitmap\t\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 digest->key_slots_bitmap );
+
+		libcnotify_printf(
+		 "%s: segments bitmap\t\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 digest->segments_bitmap );
+
+		libcnotify_printf(
+		 "%s: number of iterations\t\t\t: %" PRIu32 "\n",
+		 function,
+		 digest->number_of_iterations );
+
+		libcnotify_printf(
+		 "%s: salt:\n",
+		 function );
+		libcnotify_print_data(
+		 digest->salt,
+		 digest->salt_size,
+		 0 );
+
+		libcnotify_printf(
+		 "%s: digest:\n",
+		 function );
+		libcnotify_print_data(
+		 digest->digest,
+		 digest->digest_size,
+		 0 );
+	}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+	return( 1 );
+}
+
+/* Checks if a key matches the digest
+ * Returns 1 if the key matches, 0 if not or -1 on error
+ */
+int libluksde_digest_check_key(
+     libluksde_digest_t *digest,
+     const uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	uint8_t key_digest[ 64 ];
+
+	static char *function = "libluksde_digest_check_key";
+	int result            = 0;
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( digest->digest_size == 0 )
+	 || ( digest->digest_size > 64 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid digest - digest size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_size == 0 )
+	 || ( key_size > 64 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_password_pbkdf2(
+	     key,
+	     key_size,
+	     digest->hashing_method,
+	     digest->salt,
+	     digest->salt_size,
+	     digest->number_of_iterations,
+	     key_digest,
+	     digest->digest_size,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine key digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     key_digest,
+	     digest->digest,
+	     digest->digest_size ) == 0 )
+	{
+		result = 1;
+	}
+	memory_set(
+	 key_digest,
+	 0,
+	 64 );
+
+	return( result );
+}
+
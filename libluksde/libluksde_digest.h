@@ -0,0 +1,105 @@
+/*
+ * Digest functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_DIGEST_H )
+#define _LIBLUKSDE_DIGEST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_json_tokenizer.h"
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libluksde_digest libluksde_digest_t;
+
+struct libluksde_digest
+{
+	/* The identifier
+	 */
+	int identifier;
+
+	/* The hashing method
+	 */
+	int hashing_method;
+
+	/* The number of iterations
+	 */
+	uint32_t number_of_iterations;
+
+	/* The salt
+	 */
+	uint8_t salt[ 64 ];
+
+	/* The salt size
+	 */
+	size_t salt_size;
+
+	/* The digest
+	 */
+	uint8_t digest[ 64 ];
+
+	/* The digest size
+	 */
+	size_t digest_size;
+
+	/* The bitmap of the identifiers of the key slots the digest applies to
+	 */
+	uint32_t key_slots_bitmap;
+
+	/* The bitmap of the identifiers of the segments the digest applies to
+	 */
+	uint32_t segments_bitmap;
+};
+
+int libluksde_digest_initialize(
+     libluksde_digest_t **digest,
+     libcerror_error_t **error );
+
+int libluksde_digest_free(
+     libluksde_digest_t **digest,
+     libcerror_error_t **error );
+
+int libluksde_digest_read_json_identifiers_array(
+     libluksde_json_tokenizer_t *tokenizer,
+     uint32_t *identifiers_bitmap,
+     libcerror_error_t **error );
+
+int libluksde_digest_read_json_object(
+     libluksde_digest_t *digest,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error );
+
+int libluksde_digest_check_key(
+     libluksde_digest_t *digest,
+     const uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_DIGEST_H ) */
+
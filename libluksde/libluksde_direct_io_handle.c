@@ -0,0 +1,1097 @@
+/*
+ * Direct I/O handle functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+/* Required for O_DIRECT
+ */
+#define _GNU_SOURCE
+#endif
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_STDLIB_H )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libluksde_block_device.h"
+#include "libluksde_definitions.h"
+#include "libluksde_direct_io_handle.h"
+#include "libluksde_libbfio.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_unused.h"
+
+#if defined( O_DIRECT ) && defined( HAVE_PREAD ) && defined( HAVE_POSIX_MEMALIGN )
+#define LIBLUKSDE_HAVE_DIRECT_IO	1
+#endif
+
+/* Creates a direct I/O handle
+ * Make sure the value direct_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_direct_io_handle_initialize(
+     libluksde_direct_io_handle_t **direct_io_handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_direct_io_handle_initialize";
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *direct_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid direct I/O handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_length == 0 )
+	 || ( name_length > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*direct_io_handle = memory_allocate_structure(
+	                     libluksde_direct_io_handle_t );
+
+	if( *direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create direct I/O handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *direct_io_handle,
+	     0,
+	     sizeof( libluksde_direct_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear direct I/O handle.",
+		 function );
+
+		memory_free(
+		 *direct_io_handle );
+
+		*direct_io_handle = NULL;
+
+		return( -1 );
+	}
+	( *direct_io_handle )->file_descriptor = -1;
+
+	( *direct_io_handle )->name = narrow_string_allocate(
+	                               name_length + 1 );
+
+	if( ( *direct_io_handle )->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name.",
+		 function );
+
+		goto on_error;
+	}
+	if( narrow_string_copy(
+	     ( *direct_io_handle )->name,
+	     name,
+	     name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		goto on_error;
+	}
+	( *direct_io_handle )->name[ name_length ] = 0;
+
+	( *direct_io_handle )->name_size = name_length + 1;
+
+	return( 1 );
+
+on_error:
+	if( *direct_io_handle != NULL )
+	{
+		if( ( *direct_io_handle )->name != NULL )
+		{
+			memory_free(
+			 ( *direct_io_handle )->name );
+		}
+		memory_free(
+		 *direct_io_handle );
+
+		*direct_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Creates a Basic File IO (bfio) handle that reads a file using direct I/O
+ * Direct I/O bypasses the operating system page cache
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_direct_file_initialize(
+     libbfio_handle_t **handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	libluksde_direct_io_handle_t *direct_io_handle = NULL;
+	static char *function                          = "libluksde_direct_file_initialize";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( LIBLUKSDE_HAVE_DIRECT_IO )
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: direct I/O is not supported.",
+	 function );
+
+	return( -1 );
+#else
+	if( libluksde_direct_io_handle_initialize(
+	     &direct_io_handle,
+	     name,
+	     name_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create direct I/O handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     handle,
+	     (intptr_t *) direct_io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libluksde_direct_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libluksde_direct_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libluksde_direct_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libluksde_direct_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libluksde_direct_io_handle_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libluksde_direct_io_handle_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libluksde_direct_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libluksde_direct_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libluksde_direct_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libluksde_direct_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( direct_io_handle != NULL )
+	{
+		libluksde_direct_io_handle_free(
+		 &direct_io_handle,
+		 NULL );
+	}
+	return( -1 );
+#endif /* !defined( LIBLUKSDE_HAVE_DIRECT_IO ) */
+}
+
+/* Frees a direct I/O handle
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_direct_io_handle_free(
+     libluksde_direct_io_handle_t **direct_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_direct_io_handle_free";
+	int result            = 1;
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *direct_io_handle != NULL )
+	{
+		if( ( *direct_io_handle )->file_descriptor != -1 )
+		{
+			if( libluksde_direct_io_handle_close(
+			     *direct_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close direct I/O handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *direct_io_handle )->aligned_buffer != NULL )
+		{
+			/* The aligned buffer is allocated by posix_memalign
+			 */
+			free(
+			 ( *direct_io_handle )->aligned_buffer );
+		}
+		if( ( *direct_io_handle )->name != NULL )
+		{
+			memory_free(
+			 ( *direct_io_handle )->name );
+		}
+		memory_free(
+		 *direct_io_handle );
+
+		*direct_io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the direct I/O handle
+ * The clone is not opened and has its own aligned buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_direct_io_handle_clone(
+     libluksde_direct_io_handle_t **destination_direct_io_handle,
+     libluksde_direct_io_handle_t *source_direct_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_direct_io_handle_clone";
+
+	if( destination_direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination direct I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_direct_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination direct I/O handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_direct_io_handle == NULL )
+	{
+		*destination_direct_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libluksde_direct_io_handle_initialize(
+	     destination_direct_io_handle,
+	     source_direct_io_handle->name,
+	     source_direct_io_handle->name_size - 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination direct I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	( *destination_direct_io_handle )->access_flags = source_direct_io_handle->access_flags;
+
+	return( 1 );
+}
+
+/* Opens the direct I/O handle
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_direct_io_handle_open(
+     libluksde_direct_io_handle_t *direct_io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_direct_io_handle_open";
+
+#if defined( LIBLUKSDE_HAVE_DIRECT_IO )
+	struct stat file_statistics;
+
+	void *aligned_buffer        = NULL;
+	off_t file_size             = 0;
+	size64_t device_size        = 0;
+	size_t block_size           = 0;
+	uint32_t logical_block_size = 0;
+	uint32_t minimum_io_size    = 0;
+	uint32_t optimal_io_size    = 0;
+	int file_descriptor         = -1;
+	int result                  = 0;
+#endif
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct I/O handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid direct I/O handle - file descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( access_flags & LIBBFIO_ACCESS_FLAG_READ ) == 0 )
+	 || ( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBLUKSDE_HAVE_DIRECT_IO )
+	file_descriptor = open(
+	                   direct_io_handle->name,
+	                   O_RDONLY | O_DIRECT );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s with direct I/O.",
+		 function,
+		 direct_io_handle->name );
+
+		goto on_error;
+	}
+	if( fstat(
+	     file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		goto on_error;
+	}
+	/* The reads must be aligned to the logical block size of the device,
+	 * for a regular file the file system block size is a multiple of it
+	 */
+	block_size = (size_t) file_statistics.st_blksize;
+
+	result = libluksde_block_device_get_io_values(
+	          file_descriptor,
+	          &device_size,
+	          &logical_block_size,
+	          &minimum_io_size,
+	          &optimal_io_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block device I/O values.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		block_size = (size_t) logical_block_size;
+	}
+	if( ( block_size < 512 )
+	 || ( block_size > LIBLUKSDE_DIRECT_IO_BUFFER_SIZE )
+	 || ( ( block_size & ( block_size - 1 ) ) != 0 ) )
+	{
+		block_size = 4096;
+	}
+	/* Use the end of file offset since stat does not provide the size of a device
+	 */
+	file_size = lseek(
+	             file_descriptor,
+	             0,
+	             SEEK_END );
+
+	if( file_size == (off_t) -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 errno,
+		 "%s: unable to determine size of file: %s.",
+		 function,
+		 direct_io_handle->name );
+
+		goto on_error;
+	}
+	if( direct_io_handle->aligned_buffer == NULL )
+	{
+		result = posix_memalign(
+		          &aligned_buffer,
+		          block_size,
+		          LIBLUKSDE_DIRECT_IO_BUFFER_SIZE );
+
+		if( result != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 result,
+			 "%s: unable to create aligned buffer.",
+			 function );
+
+			goto on_error;
+		}
+		direct_io_handle->aligned_buffer = (uint8_t *) aligned_buffer;
+	}
+	direct_io_handle->file_descriptor = file_descriptor;
+	direct_io_handle->access_flags    = access_flags;
+	direct_io_handle->current_offset  = 0;
+	direct_io_handle->size            = (size64_t) file_size;
+	direct_io_handle->block_size      = block_size;
+
+	return( 1 );
+
+on_error:
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	return( -1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: direct I/O is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( LIBLUKSDE_HAVE_DIRECT_IO ) */
+}
+
+/* Closes the direct I/O handle
+ * Returns 0 if successful or -1 on error
+ */
+int libluksde_direct_io_handle_close(
+     libluksde_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_direct_io_handle_close";
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct I/O handle - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBLUKSDE_HAVE_DIRECT_IO )
+	if( close(
+	     direct_io_handle->file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file.",
+		 function );
+
+		direct_io_handle->file_descriptor = -1;
+
+		return( -1 );
+	}
+#endif
+	direct_io_handle->file_descriptor = -1;
+	direct_io_handle->access_flags    = 0;
+	direct_io_handle->current_offset  = 0;
+	direct_io_handle->size            = 0;
+
+	return( 0 );
+}
+
+/* Reads a buffer from the direct I/O handle
+ * Reads that are not aligned to the block size are read into the aligned buffer first
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libluksde_direct_io_handle_read(
+         libluksde_direct_io_handle_t *direct_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libluksde_direct_io_handle_read";
+
+#if defined( LIBLUKSDE_HAVE_DIRECT_IO )
+	size_t aligned_size   = 0;
+	size_t buffer_offset  = 0;
+	size_t copy_size      = 0;
+	size_t data_offset    = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	off64_t aligned_offset = 0;
+#endif
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct I/O handle - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBLUKSDE_HAVE_DIRECT_IO )
+	if( (size64_t) direct_io_handle->current_offset >= direct_io_handle->size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) size > ( direct_io_handle->size - direct_io_handle->current_offset ) )
+	{
+		size = (size_t) ( direct_io_handle->size - direct_io_handle->current_offset );
+	}
+	while( buffer_offset < size )
+	{
+		aligned_offset = direct_io_handle->current_offset - ( direct_io_handle->current_offset % direct_io_handle->block_size );
+		data_offset    = (size_t) ( direct_io_handle->current_offset - aligned_offset );
+		read_size      = size - buffer_offset;
+
+		if( ( data_offset == 0 )
+		 && ( read_size >= direct_io_handle->block_size )
+		 && ( ( (intptr_t) &( buffer[ buffer_offset ] ) % direct_io_handle->block_size ) == 0 ) )
+		{
+			/* Read the aligned blocks directly into the buffer
+			 */
+			read_size -= read_size % direct_io_handle->block_size;
+
+			read_count = pread(
+			              direct_io_handle->file_descriptor,
+			              &( buffer[ buffer_offset ] ),
+			              read_size,
+			              (off_t) aligned_offset );
+
+			if( read_count < 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 errno,
+				 "%s: unable to read from file at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 aligned_offset,
+				 aligned_offset );
+
+				return( -1 );
+			}
+			copy_size = (size_t) read_count;
+		}
+		else
+		{
+			aligned_size = data_offset + read_size;
+
+			if( ( aligned_size % direct_io_handle->block_size ) != 0 )
+			{
+				aligned_size += direct_io_handle->block_size - ( aligned_size % direct_io_handle->block_size );
+			}
+			if( aligned_size > LIBLUKSDE_DIRECT_IO_BUFFER_SIZE )
+			{
+				aligned_size = LIBLUKSDE_DIRECT_IO_BUFFER_SIZE;
+			}
+			read_count = pread(
+			              direct_io_handle->file_descriptor,
+			              direct_io_handle->aligned_buffer,
+			              aligned_size,
+			              (off_t) aligned_offset );
+
+			if( read_count < 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 errno,
+				 "%s: unable to read from file at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 aligned_offset,
+				 aligned_offset );
+
+				return( -1 );
+			}
+			if( (size_t) read_count <= data_offset )
+			{
+				break;
+			}
+			copy_size = (size_t) read_count - data_offset;
+
+			if( copy_size > read_size )
+			{
+				copy_size = read_size;
+			}
+			if( memory_copy(
+			     &( buffer[ buffer_offset ] ),
+			     &( direct_io_handle->aligned_buffer[ data_offset ] ),
+			     copy_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy data to buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( copy_size == 0 )
+		{
+			break;
+		}
+		buffer_offset                    += copy_size;
+		direct_io_handle->current_offset += (off64_t) copy_size;
+	}
+	return( (ssize_t) buffer_offset );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: direct I/O is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( LIBLUKSDE_HAVE_DIRECT_IO ) */
+}
+
+/* Writes a buffer to the direct I/O handle
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libluksde_direct_io_handle_write(
+         libluksde_direct_io_handle_t *direct_io_handle,
+         const uint8_t *buffer LIBLUKSDE_ATTRIBUTE_UNUSED,
+         size_t size LIBLUKSDE_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error )
+{
+	static char *function = "libluksde_direct_io_handle_write";
+
+	LIBLUKSDE_UNREFERENCED_PARAMETER( buffer )
+	LIBLUKSDE_UNREFERENCED_PARAMETER( size )
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: write access currently not supported.",
+	 function );
+
+	return( -1 );
+}
+
+/* Seeks a certain offset within the direct I/O handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libluksde_direct_io_handle_seek_offset(
+         libluksde_direct_io_handle_t *direct_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libluksde_direct_io_handle_seek_offset";
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += direct_io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) direct_io_handle->size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	direct_io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if a file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libluksde_direct_io_handle_exists(
+     libluksde_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_direct_io_handle_exists";
+
+#if defined( LIBLUKSDE_HAVE_DIRECT_IO )
+	struct stat file_statistics;
+#endif
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct I/O handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBLUKSDE_HAVE_DIRECT_IO )
+	if( stat(
+	     direct_io_handle->name,
+	     &file_statistics ) != 0 )
+	{
+		if( errno == ENOENT )
+		{
+			return( 0 );
+		}
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Check if the direct I/O handle is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libluksde_direct_io_handle_is_open(
+     libluksde_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_direct_io_handle_is_open";
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor == -1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the file size
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_direct_io_handle_get_size(
+     libluksde_direct_io_handle_t *direct_io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_direct_io_handle_get_size";
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct I/O handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct I/O handle - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	*size = direct_io_handle->size;
+
+	return( 1 );
+}
+
@@ -0,0 +1,140 @@
+/*
+ * Direct I/O handle functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_DIRECT_IO_HANDLE_H )
+#define _LIBLUKSDE_DIRECT_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libbfio.h"
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libluksde_direct_io_handle libluksde_direct_io_handle_t;
+
+struct libluksde_direct_io_handle
+{
+	/* The name
+	 */
+	char *name;
+
+	/* The name size
+	 */
+	size_t name_size;
+
+	/* The file descriptor
+	 */
+	int file_descriptor;
+
+	/* The access flags
+	 */
+	int access_flags;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The block size
+	 * Contains the alignment of the offsets, sizes and buffers required by direct I/O
+	 */
+	size_t block_size;
+
+	/* The aligned buffer
+	 * Used for reads that are not aligned to the block size
+	 */
+	uint8_t *aligned_buffer;
+};
+
+int libluksde_direct_io_handle_initialize(
+     libluksde_direct_io_handle_t **direct_io_handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+int libluksde_direct_file_initialize(
+     libbfio_handle_t **handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+int libluksde_direct_io_handle_free(
+     libluksde_direct_io_handle_t **direct_io_handle,
+     libcerror_error_t **error );
+
+int libluksde_direct_io_handle_clone(
+     libluksde_direct_io_handle_t **destination_direct_io_handle,
+     libluksde_direct_io_handle_t *source_direct_io_handle,
+     libcerror_error_t **error );
+
+int libluksde_direct_io_handle_open(
+     libluksde_direct_io_handle_t *direct_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libluksde_direct_io_handle_close(
+     libluksde_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error );
+
+ssize_t libluksde_direct_io_handle_read(
+         libluksde_direct_io_handle_t *direct_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libluksde_direct_io_handle_write(
+         libluksde_direct_io_handle_t *direct_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libluksde_direct_io_handle_seek_offset(
+         libluksde_direct_io_handle_t *direct_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libluksde_direct_io_handle_exists(
+     libluksde_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error );
+
+int libluksde_direct_io_handle_is_open(
+     libluksde_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error );
+
+int libluksde_direct_io_handle_get_size(
+     libluksde_direct_io_handle_t *direct_io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_DIRECT_IO_HANDLE_H ) */
+
@@ -0,0 +1,481 @@
+/*
+ * File IO handle pool functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_file_io_handle_pool.h"
+#include "libluksde_libbfio.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_libcnotify.h"
+#include "libluksde_libcthreads.h"
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+
+/* Creates a file IO handle pool
+ * Make sure the value file_io_handle_pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_file_io_handle_pool_initialize(
+     libluksde_file_io_handle_pool_t **file_io_handle_pool,
+     libbfio_handle_t *source_file_io_handle,
+     int maximum_number_of_file_io_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_file_io_handle_pool_initialize";
+
+	if( file_io_handle_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_file_io_handles <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of file IO handles value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*file_io_handle_pool = memory_allocate_structure(
+	                        libluksde_file_io_handle_pool_t );
+
+	if( *file_io_handle_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file IO handle pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_io_handle_pool,
+	     0,
+	     sizeof( libluksde_file_io_handle_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file IO handle pool.",
+		 function );
+
+		memory_free(
+		 *file_io_handle_pool );
+
+		*file_io_handle_pool = NULL;
+
+		return( -1 );
+	}
+	( *file_io_handle_pool )->file_io_handles = (libbfio_handle_t **) memory_allocate(
+	                                                                   sizeof( libbfio_handle_t * ) * maximum_number_of_file_io_handles );
+
+	if( ( *file_io_handle_pool )->file_io_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file IO handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *file_io_handle_pool )->file_io_handles,
+	     0,
+	     sizeof( libbfio_handle_t * ) * maximum_number_of_file_io_handles ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file IO handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *file_io_handle_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	( *file_io_handle_pool )->source_file_io_handle             = source_file_io_handle;
+	( *file_io_handle_pool )->maximum_number_of_file_io_handles = maximum_number_of_file_io_handles;
+
+	return( 1 );
+
+on_error:
+	if( *file_io_handle_pool != NULL )
+	{
+		if( ( *file_io_handle_pool )->file_io_handles != NULL )
+		{
+			memory_free(
+			 ( *file_io_handle_pool )->file_io_handles );
+		}
+		memory_free(
+		 *file_io_handle_pool );
+
+		*file_io_handle_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a file IO handle pool
+ * The cloned file IO handles are closed and freed, the source file IO handle is not
+ * Make sure none of the cloned file IO handles are in use
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_file_io_handle_pool_free(
+     libluksde_file_io_handle_pool_t **file_io_handle_pool,
+     libcerror_error_t **error )
+{
+	static char *function    = "libluksde_file_io_handle_pool_free";
+	int file_io_handle_index = 0;
+	int result               = 1;
+
+	if( file_io_handle_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle_pool != NULL )
+	{
+		for( file_io_handle_index = 0;
+		     file_io_handle_index < ( *file_io_handle_pool )->number_of_file_io_handles;
+		     file_io_handle_index++ )
+		{
+			if( libbfio_handle_close(
+			     ( *file_io_handle_pool )->file_io_handles[ file_io_handle_index ],
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle: %d.",
+				 function,
+				 file_io_handle_index );
+
+				result = -1;
+			}
+			if( libbfio_handle_free(
+			     &( ( *file_io_handle_pool )->file_io_handles[ file_io_handle_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle: %d.",
+				 function,
+				 file_io_handle_index );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *file_io_handle_pool )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *file_io_handle_pool )->file_io_handles );
+
+		memory_free(
+		 *file_io_handle_pool );
+
+		*file_io_handle_pool = NULL;
+	}
+	return( result );
+}
+
+/* Grabs a file IO handle from the pool
+ * A file IO handle that is not in use is reused, otherwise the source file IO handle is cloned
+ * until the maximum number of file IO handles is reached
+ * The source file IO handle should not be used by another thread while it is cloned
+ * Returns 1 if successful, 0 if no file IO handle is available or -1 on error
+ */
+int libluksde_file_io_handle_pool_grab_file_io_handle(
+     libluksde_file_io_handle_pool_t *file_io_handle_pool,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *cloned_file_io_handle = NULL;
+	static char *function                   = "libluksde_file_io_handle_pool_grab_file_io_handle";
+	int result                              = 0;
+
+	if( file_io_handle_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     file_io_handle_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle_pool->number_of_file_io_handles > 0 )
+	{
+		file_io_handle_pool->number_of_file_io_handles -= 1;
+
+		*file_io_handle = file_io_handle_pool->file_io_handles[ file_io_handle_pool->number_of_file_io_handles ];
+
+		file_io_handle_pool->file_io_handles[ file_io_handle_pool->number_of_file_io_handles ] = NULL;
+
+		result = 1;
+	}
+	else if( ( file_io_handle_pool->clone_failed == 0 )
+	      && ( file_io_handle_pool->number_of_cloned_file_io_handles < file_io_handle_pool->maximum_number_of_file_io_handles ) )
+	{
+		/* Not every type of file IO handle can be cloned, in which case
+		 * the caller falls back to reading with the source file IO handle
+		 */
+		if( libbfio_handle_clone(
+		     &cloned_file_io_handle,
+		     file_io_handle_pool->source_file_io_handle,
+		     error ) == 1 )
+		{
+			result = libbfio_handle_is_open(
+			          cloned_file_io_handle,
+			          error );
+
+			if( result == 0 )
+			{
+				result = libbfio_handle_open(
+				          cloned_file_io_handle,
+				          LIBBFIO_OPEN_READ,
+				          error );
+			}
+		}
+		else
+		{
+			result = -1;
+		}
+		if( result != 1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to clone source file IO handle.\n",
+				 function );
+			}
+#endif
+			if( cloned_file_io_handle != NULL )
+			{
+				libbfio_handle_free(
+				 &cloned_file_io_handle,
+				 NULL );
+			}
+			libcerror_error_free(
+			 error );
+
+			file_io_handle_pool->clone_failed = 1;
+
+			result = 0;
+		}
+		else
+		{
+			file_io_handle_pool->number_of_cloned_file_io_handles += 1;
+
+			*file_io_handle = cloned_file_io_handle;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     file_io_handle_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Releases a file IO handle that was grabbed from the pool
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_file_io_handle_pool_release_file_io_handle(
+     libluksde_file_io_handle_pool_t *file_io_handle_pool,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_file_io_handle_pool_release_file_io_handle";
+	int result            = 1;
+
+	if( file_io_handle_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     file_io_handle_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle_pool->number_of_file_io_handles >= file_io_handle_pool->number_of_cloned_file_io_handles )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO handle pool - number of file IO handles value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		file_io_handle_pool->file_io_handles[ file_io_handle_pool->number_of_file_io_handles ] = file_io_handle;
+
+		file_io_handle_pool->number_of_file_io_handles += 1;
+	}
+	if( libcthreads_mutex_release(
+	     file_io_handle_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+
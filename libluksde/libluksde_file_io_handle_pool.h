@@ -0,0 +1,100 @@
+/*
+ * File IO handle pool functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_FILE_IO_HANDLE_POOL_H )
+#define _LIBLUKSDE_FILE_IO_HANDLE_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libbfio.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+
+typedef struct libluksde_file_io_handle_pool libluksde_file_io_handle_pool_t;
+
+struct libluksde_file_io_handle_pool
+{
+	/* The source file IO handle
+	 * The file IO handles in the pool are cloned from this handle
+	 */
+	libbfio_handle_t *source_file_io_handle;
+
+	/* The file IO handles that are not in use
+	 */
+	libbfio_handle_t **file_io_handles;
+
+	/* The number of file IO handles that are not in use
+	 */
+	int number_of_file_io_handles;
+
+	/* The number of file IO handles that were cloned
+	 */
+	int number_of_cloned_file_io_handles;
+
+	/* The maximum number of file IO handles
+	 */
+	int maximum_number_of_file_io_handles;
+
+	/* Value to indicate the source file IO handle could not be cloned
+	 */
+	uint8_t clone_failed;
+
+	/* The mutex
+	 * Protects the file IO handles that are not in use and the counters
+	 */
+	libcthreads_mutex_t *mutex;
+};
+
+int libluksde_file_io_handle_pool_initialize(
+     libluksde_file_io_handle_pool_t **file_io_handle_pool,
+     libbfio_handle_t *source_file_io_handle,
+     int maximum_number_of_file_io_handles,
+     libcerror_error_t **error );
+
+int libluksde_file_io_handle_pool_free(
+     libluksde_file_io_handle_pool_t **file_io_handle_pool,
+     libcerror_error_t **error );
+
+int libluksde_file_io_handle_pool_grab_file_io_handle(
+     libluksde_file_io_handle_pool_t *file_io_handle_pool,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int libluksde_file_io_handle_pool_release_file_io_handle(
+     libluksde_file_io_handle_pool_t *file_io_handle_pool,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_FILE_IO_HANDLE_POOL_H ) */
+
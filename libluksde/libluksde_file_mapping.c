@@ -0,0 +1,478 @@
+/*
+ * File mapping functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libluksde_definitions.h"
+#include "libluksde_file_mapping.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_unused.h"
+
+#if defined( HAVE_SYS_MMAN_H ) && defined( HAVE_MMAP ) && defined( HAVE_MUNMAP )
+#define LIBLUKSDE_HAVE_FILE_MAPPING	1
+#endif
+
+/* Creates a file mapping
+ * Make sure the value file_mapping is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_file_mapping_initialize(
+     libluksde_file_mapping_t **file_mapping,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_file_mapping_initialize";
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_mapping != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file mapping value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*file_mapping = memory_allocate_structure(
+	                 libluksde_file_mapping_t );
+
+	if( *file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file mapping.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_mapping,
+	     0,
+	     sizeof( libluksde_file_mapping_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file mapping.",
+		 function );
+
+		goto on_error;
+	}
+	( *file_mapping )->file_descriptor = -1;
+
+	return( 1 );
+
+on_error:
+	if( *file_mapping != NULL )
+	{
+		memory_free(
+		 *file_mapping );
+
+		*file_mapping = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a file mapping
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_file_mapping_free(
+     libluksde_file_mapping_t **file_mapping,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_file_mapping_free";
+	int result            = 1;
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_mapping != NULL )
+	{
+		if( ( *file_mapping )->file_descriptor != -1 )
+		{
+			if( libluksde_file_mapping_close(
+			     *file_mapping,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file mapping.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *file_mapping );
+
+		*file_mapping = NULL;
+	}
+	return( result );
+}
+
+/* Opens a file mapping
+ * The file is mapped read-only in its entirety. The access flags determine
+ * if the mapping is hinted for sequential or random access
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_file_mapping_open(
+     libluksde_file_mapping_t *file_mapping,
+     const char *filename,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_file_mapping_open";
+
+#if defined( LIBLUKSDE_HAVE_FILE_MAPPING )
+	void *data            = NULL;
+	off_t file_size       = 0;
+	int file_descriptor   = -1;
+#if defined( HAVE_MADVISE )
+	int advice            = 0;
+#endif
+#endif
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_mapping->file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file mapping - file descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBLUKSDE_HAVE_FILE_MAPPING )
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	/* Use the end of file offset since stat does not provide the size of a device
+	 */
+	file_size = lseek(
+	             file_descriptor,
+	             0,
+	             SEEK_END );
+
+	if( file_size == (off_t) -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 errno,
+		 "%s: unable to determine size of file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( ( file_size == 0 )
+	 || ( (uint64_t) file_size > (uint64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	data = mmap(
+	        NULL,
+	        (size_t) file_size,
+	        PROT_READ,
+	        MAP_SHARED,
+	        file_descriptor,
+	        0 );
+
+	if( data == MAP_FAILED )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to map file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+#if defined( HAVE_MADVISE )
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_RANDOM_ACCESS ) != 0 )
+	{
+		advice = MADV_RANDOM;
+	}
+	else
+	{
+		advice = MADV_SEQUENTIAL;
+	}
+	/* The advice is only a hint, hence failure is not considered an error
+	 */
+	madvise(
+	 data,
+	 (size_t) file_size,
+	 advice );
+#endif
+	file_mapping->file_descriptor = file_descriptor;
+	file_mapping->data            = (uint8_t *) data;
+	file_mapping->data_size       = (size_t) file_size;
+
+	return( 1 );
+
+on_error:
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	return( -1 );
+#else
+	LIBLUKSDE_UNREFERENCED_PARAMETER( access_flags )
+
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: memory mapped files are not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( LIBLUKSDE_HAVE_FILE_MAPPING ) */
+}
+
+/* Closes a file mapping
+ * Returns 0 if successful or -1 on error
+ */
+int libluksde_file_mapping_close(
+     libluksde_file_mapping_t *file_mapping,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_file_mapping_close";
+	int result            = 0;
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBLUKSDE_HAVE_FILE_MAPPING )
+	if( file_mapping->data != NULL )
+	{
+		if( munmap(
+		     file_mapping->data,
+		     file_mapping->data_size ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to unmap file.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( file_mapping->file_descriptor != -1 )
+	{
+		if( close(
+		     file_mapping->file_descriptor ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to close file.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif /* defined( LIBLUKSDE_HAVE_FILE_MAPPING ) */
+
+	file_mapping->file_descriptor = -1;
+	file_mapping->data            = NULL;
+	file_mapping->data_size       = 0;
+
+	return( result );
+}
+
+/* Retrieves the mapped data at a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_file_mapping_get_data_at_offset(
+     libluksde_file_mapping_t *file_mapping,
+     off64_t offset,
+     size_t size,
+     const uint8_t **data,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_file_mapping_get_data_at_offset";
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_mapping->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file mapping - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset > (size64_t) file_mapping->data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > ( file_mapping->data_size - (size_t) offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	*data = &( file_mapping->data[ offset ] );
+
+	return( 1 );
+}
+
@@ -0,0 +1,81 @@
+/*
+ * File mapping functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_FILE_MAPPING_H )
+#define _LIBLUKSDE_FILE_MAPPING_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libluksde_file_mapping libluksde_file_mapping_t;
+
+struct libluksde_file_mapping
+{
+	/* The file descriptor
+	 */
+	int file_descriptor;
+
+	/* The mapped data
+	 */
+	uint8_t *data;
+
+	/* The mapped data size
+	 */
+	size_t data_size;
+};
+
+int libluksde_file_mapping_initialize(
+     libluksde_file_mapping_t **file_mapping,
+     libcerror_error_t **error );
+
+int libluksde_file_mapping_free(
+     libluksde_file_mapping_t **file_mapping,
+     libcerror_error_t **error );
+
+int libluksde_file_mapping_open(
+     libluksde_file_mapping_t *file_mapping,
+     const char *filename,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libluksde_file_mapping_close(
+     libluksde_file_mapping_t *file_mapping,
+     libcerror_error_t **error );
+
+int libluksde_file_mapping_get_data_at_offset(
+     libluksde_file_mapping_t *file_mapping,
+     off64_t offset,
+     size_t size,
+     const uint8_t **data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_FILE_MAPPING_H ) */
+
@@ -0,0 +1,188 @@
+/*
+ * I/O callbacks functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_io_callbacks.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_types.h"
+
+/* Reads a buffer at a specific offset using the I/O callbacks
+ * The read function is called until the buffer is filled or the end of the data is reached
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libluksde_io_callbacks_read_buffer_at_offset(
+         const libluksde_io_callbacks_t *io_callbacks,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libluksde_io_callbacks_read_buffer_at_offset";
+	size_t buffer_offset  = 0;
+	ssize_t read_count    = 0;
+
+	if( io_callbacks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid I/O callbacks.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_callbacks->read_at_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid I/O callbacks - missing read at offset function.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		read_count = io_callbacks->read_at_offset(
+		              io_callbacks->user_data,
+		              &( buffer[ buffer_offset ] ),
+		              size - buffer_offset,
+		              offset + (off64_t) buffer_offset );
+
+		if( ( read_count < 0 )
+		 || ( (size_t) read_count > ( size - buffer_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset + (off64_t) buffer_offset,
+			 offset + (off64_t) buffer_offset );
+
+			return( -1 );
+		}
+		if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_offset += (size_t) read_count;
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Retrieves the size of the data using the I/O callbacks
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_io_callbacks_get_size(
+     const libluksde_io_callbacks_t *io_callbacks,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_io_callbacks_get_size";
+
+	if( io_callbacks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid I/O callbacks.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_callbacks->get_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid I/O callbacks - missing get size function.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_callbacks->get_size(
+	     io_callbacks->user_data,
+	     size ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
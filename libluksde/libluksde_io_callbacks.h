@@ -0,0 +1,52 @@
+/*
+ * I/O callbacks functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_IO_CALLBACKS_H )
+#define _LIBLUKSDE_IO_CALLBACKS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+#include "libluksde_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+ssize_t libluksde_io_callbacks_read_buffer_at_offset(
+         const libluksde_io_callbacks_t *io_callbacks,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int libluksde_io_callbacks_get_size(
+     const libluksde_io_callbacks_t *io_callbacks,
+     size64_t *size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_IO_CALLBACKS_H ) */
+
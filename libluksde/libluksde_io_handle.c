@@ -23,6 +23,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libluksde_definitions.h"
 #include "libluksde_io_handle.h"
 #include "libluksde_libcerror.h"
 
@@ -88,7 +89,9 @@ int libluksde_io_handle_initialize(
 
 		goto on_error;
 	}
-	( *io_handle )->bytes_per_sector = 512;
+	( *io_handle )->bytes_per_sector          = 512;
+	( *io_handle )->sector_size               = 512;
+	( *io_handle )->maximum_sectors_read_size = LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE;
 
 	return( 1 );
 
@@ -167,8 +170,137 @@ int libluksde_io_handle_clear(
 
 		return( -1 );
 	}
-	io_handle->bytes_per_sector = 512;
+	io_handle->bytes_per_sector          = 512;
+	io_handle->sector_size               = 512;
+	io_handle->read_alignment_size       = 0;
+	io_handle->maximum_sectors_read_size = LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE;
 
 	return( 1 );
 }
 
+/* Sets the I/O values of the device
+ * The read alignment size is the optimal I/O size of the device, or the minimum I/O size
+ * if the device does not provide an optimal I/O size
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_io_handle_set_device_io_values(
+     libluksde_io_handle_t *io_handle,
+     uint32_t minimum_io_size,
+     uint32_t optimal_io_size,
+     libcerror_error_t **error )
+{
+	static char *function        = "libluksde_io_handle_set_device_io_values";
+	uint32_t read_alignment_size = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( optimal_io_size >= 512 )
+	 && ( optimal_io_size <= (uint32_t) LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE )
+	 && ( ( optimal_io_size % 512 ) == 0 ) )
+	{
+		read_alignment_size = optimal_io_size;
+	}
+	else if( ( minimum_io_size >= 512 )
+	      && ( minimum_io_size <= (uint32_t) LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE )
+	      && ( ( minimum_io_size % 512 ) == 0 ) )
+	{
+		read_alignment_size = minimum_io_size;
+	}
+	io_handle->read_alignment_size       = read_alignment_size;
+	io_handle->maximum_sectors_read_size = LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE;
+
+	if( read_alignment_size != 0 )
+	{
+		io_handle->maximum_sectors_read_size -= LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE % read_alignment_size;
+	}
+	return( 1 );
+}
+
+/* Determines the size of a read of consecutive sectors
+ * The read size is limited to the maximum sectors read size. When the read is split
+ * the end of the read is aligned to the read alignment size, so that the reads
+ * of the remaining sectors start aligned
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_io_handle_get_sectors_read_size(
+     libluksde_io_handle_t *io_handle,
+     off64_t file_offset,
+     uint32_t sector_size,
+     size_t *read_size,
+     libcerror_error_t **error )
+{
+	static char *function         = "libluksde_io_handle_get_sectors_read_size";
+	size_t alignment_padding_size = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid sector size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read size.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_size <= io_handle->maximum_sectors_read_size )
+	{
+		return( 1 );
+	}
+	*read_size = io_handle->maximum_sectors_read_size - ( io_handle->maximum_sectors_read_size % sector_size );
+
+	if( io_handle->read_alignment_size != 0 )
+	{
+		alignment_padding_size = (size_t) ( ( file_offset + (off64_t) *read_size ) % io_handle->read_alignment_size );
+
+		if( ( alignment_padding_size < *read_size )
+		 && ( ( alignment_padding_size % sector_size ) == 0 ) )
+		{
+			*read_size -= alignment_padding_size;
+		}
+	}
+	return( 1 );
+}
+
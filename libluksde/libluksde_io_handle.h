@@ -42,18 +42,35 @@ struct libluksde_io_handle
 	 */
 	uint16_t bytes_per_sector;
 
+	/* The encrypted sector size
+	 * Contains the size of the data that is encrypted with a single initialization vector
+	 */
+	uint32_t sector_size;
+
 	/* The volume size
 	 */
 	size64_t volume_size;
 
 	/* The encrypted volume offset
+	 * Contains the offset of the first crypt segment
 	 */
 	off64_t encrypted_volume_offset;
 
 	/* The encrypted volume size
+	 * Contains the size of the data of all the mapped segments
 	 */
 	size64_t encrypted_volume_size;
 
+	/* The read alignment size
+	 * Contains the optimal I/O size of the device or 0 if not known
+	 */
+	uint32_t read_alignment_size;
+
+	/* The maximum size of the consecutive sectors that are read at once
+	 * Contains a multiple of the read alignment size if known
+	 */
+	size_t maximum_sectors_read_size;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -71,6 +88,19 @@ int libluksde_io_handle_clear(
      libluksde_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+int libluksde_io_handle_set_device_io_values(
+     libluksde_io_handle_t *io_handle,
+     uint32_t minimum_io_size,
+     uint32_t optimal_io_size,
+     libcerror_error_t **error );
+
+int libluksde_io_handle_get_sectors_read_size(
+     libluksde_io_handle_t *io_handle,
+     off64_t file_offset,
+     uint32_t sector_size,
+     size_t *read_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,1092 @@
+/*
+ * io_uring functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_LINUX_IO_URING_H )
+#include <linux/io_uring.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#if defined( HAVE_SYS_SYSCALL_H )
+#include <sys/syscall.h>
+#endif
+
+#if defined( HAVE_SYS_UIO_H )
+#include <sys/uio.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libluksde_definitions.h"
+#include "libluksde_io_uring.h"
+#include "libluksde_libcerror.h"
+
+/* The ring is accessed without liburing using the system calls directly,
+ * which requires the atomic built-in functions for the memory ordering
+ */
+#if defined( HAVE_LINUX_IO_URING_H ) && defined( HAVE_SYS_MMAN_H ) && defined( HAVE_SYS_SYSCALL_H ) && defined( HAVE_SYS_UIO_H ) && defined( __NR_io_uring_setup ) && defined( __NR_io_uring_enter ) && defined( __NR_io_uring_register ) && defined( __GNUC__ )
+#define LIBLUKSDE_HAVE_IO_URING	1
+#endif
+
+#if defined( LIBLUKSDE_HAVE_IO_URING )
+
+#define libluksde_io_uring_load_acquire( value ) \
+	__atomic_load_n( value, __ATOMIC_ACQUIRE )
+
+#define libluksde_io_uring_store_release( value, new_value ) \
+	__atomic_store_n( value, new_value, __ATOMIC_RELEASE )
+
+/* Calls the io_uring_enter system call
+ * Returns the number of submitted entries or -1 on error with errno set
+ */
+static int libluksde_io_uring_enter(
+            int ring_file_descriptor,
+            uint32_t number_of_entries_to_submit,
+            uint32_t minimum_number_of_completions,
+            uint32_t flags )
+{
+	return( (int) syscall(
+	               __NR_io_uring_enter,
+	               ring_file_descriptor,
+	               number_of_entries_to_submit,
+	               minimum_number_of_completions,
+	               flags,
+	               NULL,
+	               0 ) );
+}
+
+#endif /* defined( LIBLUKSDE_HAVE_IO_URING ) */
+
+/* Creates an io_uring
+ * Make sure the value io_uring is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_io_uring_initialize(
+     libluksde_io_uring_t **io_uring,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_io_uring_initialize";
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_uring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid io_uring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*io_uring = memory_allocate_structure(
+	             libluksde_io_uring_t );
+
+	if( *io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create io_uring.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *io_uring,
+	     0,
+	     sizeof( libluksde_io_uring_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear io_uring.",
+		 function );
+
+		goto on_error;
+	}
+	( *io_uring )->file_descriptor      = -1;
+	( *io_uring )->ring_file_descriptor = -1;
+
+	return( 1 );
+
+on_error:
+	if( *io_uring != NULL )
+	{
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an io_uring
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_io_uring_free(
+     libluksde_io_uring_t **io_uring,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_io_uring_free";
+	int result            = 1;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_uring != NULL )
+	{
+		if( ( *io_uring )->ring_file_descriptor != -1 )
+		{
+			if( libluksde_io_uring_close(
+			     *io_uring,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close io_uring.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+	}
+	return( result );
+}
+
+/* Opens an io_uring to read a file
+ * The file is registered with the ring and the fixed buffers are allocated and registered
+ * Returns 1 if successful, 0 if io_uring is not supported or -1 on error
+ */
+int libluksde_io_uring_open(
+     libluksde_io_uring_t *io_uring,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	static char *function                           = "libluksde_io_uring_open";
+
+#if defined( LIBLUKSDE_HAVE_IO_URING )
+	struct io_uring_params parameters;
+	struct iovec buffer_vectors[ LIBLUKSDE_IO_URING_NUMBER_OF_BUFFERS ];
+
+	void *mapped_data                               = NULL;
+	size_t buffers_size                             = 0;
+	int buffer_index                                = 0;
+	int result                                      = 0;
+#endif
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_uring->ring_file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid io_uring - ring file descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBLUKSDE_HAVE_IO_URING )
+	io_uring->file_descriptor = open(
+	                             filename,
+	                             O_RDONLY );
+
+	if( io_uring->file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     &parameters,
+	     0,
+	     sizeof( struct io_uring_params ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear parameters.",
+		 function );
+
+		goto on_error;
+	}
+	io_uring->ring_file_descriptor = (int) syscall(
+	                                        __NR_io_uring_setup,
+	                                        LIBLUKSDE_IO_URING_NUMBER_OF_BUFFERS,
+	                                        &parameters );
+
+	if( io_uring->ring_file_descriptor == -1 )
+	{
+		/* The kernel does not support io_uring or it was disabled, for example by seccomp
+		 */
+		if( ( errno == ENOSYS )
+		 || ( errno == EPERM )
+		 || ( errno == EACCES ) )
+		{
+			goto on_not_supported;
+		}
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to set up ring.",
+		 function );
+
+		goto on_error;
+	}
+	io_uring->submission_queue_ring_size = parameters.sq_off.array + ( parameters.sq_entries * sizeof( uint32_t ) );
+
+	mapped_data = mmap(
+	               NULL,
+	               io_uring->submission_queue_ring_size,
+	               PROT_READ | PROT_WRITE,
+	               MAP_SHARED | MAP_POPULATE,
+	               io_uring->ring_file_descriptor,
+	               IORING_OFF_SQ_RING );
+
+	if( mapped_data == MAP_FAILED )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to map submission queue ring.",
+		 function );
+
+		goto on_error;
+	}
+	io_uring->submission_queue_ring = (uint8_t *) mapped_data;
+
+	io_uring->submission_queue_entries_size = parameters.sq_entries * sizeof( struct io_uring_sqe );
+
+	mapped_data = mmap(
+	               NULL,
+	               io_uring->submission_queue_entries_size,
+	               PROT_READ | PROT_WRITE,
+	               MAP_SHARED | MAP_POPULATE,
+	               io_uring->ring_file_descriptor,
+	               IORING_OFF_SQES );
+
+	if( mapped_data == MAP_FAILED )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to map submission queue entries.",
+		 function );
+
+		goto on_error;
+	}
+	io_uring->submission_queue_entries = (uint8_t *) mapped_data;
+
+	io_uring->completion_queue_ring_size = parameters.cq_off.cqes + ( parameters.cq_entries * sizeof( struct io_uring_cqe ) );
+
+	mapped_data = mmap(
+	               NULL,
+	               io_uring->completion_queue_ring_size,
+	               PROT_READ | PROT_WRITE,
+	               MAP_SHARED | MAP_POPULATE,
+	               io_uring->ring_file_descriptor,
+	               IORING_OFF_CQ_RING );
+
+	if( mapped_data == MAP_FAILED )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to map completion queue ring.",
+		 function );
+
+		goto on_error;
+	}
+	io_uring->completion_queue_ring = (uint8_t *) mapped_data;
+
+	io_uring->submission_queue_head      = (uint32_t *) &( io_uring->submission_queue_ring[ parameters.sq_off.head ] );
+	io_uring->submission_queue_tail      = (uint32_t *) &( io_uring->submission_queue_ring[ parameters.sq_off.tail ] );
+	io_uring->submission_queue_ring_mask = (uint32_t *) &( io_uring->submission_queue_ring[ parameters.sq_off.ring_mask ] );
+	io_uring->submission_queue_array     = (uint32_t *) &( io_uring->submission_queue_ring[ parameters.sq_off.array ] );
+	io_uring->completion_queue_head      = (uint32_t *) &( io_uring->completion_queue_ring[ parameters.cq_off.head ] );
+	io_uring->completion_queue_tail      = (uint32_t *) &( io_uring->completion_queue_ring[ parameters.cq_off.tail ] );
+	io_uring->completion_queue_ring_mask = (uint32_t *) &( io_uring->completion_queue_ring[ parameters.cq_off.ring_mask ] );
+	io_uring->completion_queue_entries   = &( io_uring->completion_queue_ring[ parameters.cq_off.cqes ] );
+
+	/* The fixed buffers are page aligned since they are mapped
+	 */
+	buffers_size = LIBLUKSDE_IO_URING_NUMBER_OF_BUFFERS * LIBLUKSDE_IO_URING_BUFFER_SIZE;
+
+	mapped_data = mmap(
+	               NULL,
+	               buffers_size,
+	               PROT_READ | PROT_WRITE,
+	               MAP_PRIVATE | MAP_ANONYMOUS,
+	               -1,
+	               0 );
+
+	if( mapped_data == MAP_FAILED )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 errno,
+		 "%s: unable to create buffers.",
+		 function );
+
+		goto on_error;
+	}
+	io_uring->buffers           = (uint8_t *) mapped_data;
+	io_uring->buffer_size       = LIBLUKSDE_IO_URING_BUFFER_SIZE;
+	io_uring->number_of_buffers = LIBLUKSDE_IO_URING_NUMBER_OF_BUFFERS;
+
+	for( buffer_index = 0;
+	     buffer_index < LIBLUKSDE_IO_URING_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		buffer_vectors[ buffer_index ].iov_base = &( io_uring->buffers[ buffer_index * LIBLUKSDE_IO_URING_BUFFER_SIZE ] );
+		buffer_vectors[ buffer_index ].iov_len  = LIBLUKSDE_IO_URING_BUFFER_SIZE;
+	}
+	/* The registration can fail if the buffers exceed the locked memory limit
+	 */
+	result = (int) syscall(
+	                __NR_io_uring_register,
+	                io_uring->ring_file_descriptor,
+	                IORING_REGISTER_BUFFERS,
+	                buffer_vectors,
+	                LIBLUKSDE_IO_URING_NUMBER_OF_BUFFERS );
+
+	if( result != 0 )
+	{
+		goto on_not_supported;
+	}
+	result = (int) syscall(
+	                __NR_io_uring_register,
+	                io_uring->ring_file_descriptor,
+	                IORING_REGISTER_FILES,
+	                &( io_uring->file_descriptor ),
+	                1 );
+
+	if( result != 0 )
+	{
+		goto on_not_supported;
+	}
+	io_uring->number_of_queued_reads  = 0;
+	io_uring->number_of_pending_reads = 0;
+
+	return( 1 );
+
+on_not_supported:
+	libluksde_io_uring_close(
+	 io_uring,
+	 NULL );
+
+	return( 0 );
+
+on_error:
+	libluksde_io_uring_close(
+	 io_uring,
+	 NULL );
+
+	return( -1 );
+#else
+	return( 0 );
+#endif /* defined( LIBLUKSDE_HAVE_IO_URING ) */
+}
+
+/* Closes an io_uring
+ * Returns 0 if successful or -1 on error
+ */
+int libluksde_io_uring_close(
+     libluksde_io_uring_t *io_uring,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_io_uring_close";
+	int result            = 0;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBLUKSDE_HAVE_IO_URING )
+	/* The fixed buffers cannot be released while the kernel can still write to them
+	 */
+	if( io_uring->number_of_pending_reads > 0 )
+	{
+		if( libluksde_io_uring_wait_for_pending_reads(
+		     io_uring,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for pending reads.",
+			 function );
+
+			result = -1;
+		}
+	}
+	/* Closing the ring file descriptor also unregisters the buffers and file
+	 */
+	if( io_uring->ring_file_descriptor != -1 )
+	{
+		if( close(
+		     io_uring->ring_file_descriptor ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to close ring.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( io_uring->completion_queue_ring != NULL )
+	{
+		munmap(
+		 io_uring->completion_queue_ring,
+		 io_uring->completion_queue_ring_size );
+	}
+	if( io_uring->submission_queue_entries != NULL )
+	{
+		munmap(
+		 io_uring->submission_queue_entries,
+		 io_uring->submission_queue_entries_size );
+	}
+	if( io_uring->submission_queue_ring != NULL )
+	{
+		munmap(
+		 io_uring->submission_queue_ring,
+		 io_uring->submission_queue_ring_size );
+	}
+	if( io_uring->buffers != NULL )
+	{
+		munmap(
+		 io_uring->buffers,
+		 (size_t) io_uring->number_of_buffers * io_uring->buffer_size );
+	}
+	if( io_uring->file_descriptor != -1 )
+	{
+		if( close(
+		     io_uring->file_descriptor ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to close file.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif /* defined( LIBLUKSDE_HAVE_IO_URING ) */
+
+	if( memory_set(
+	     io_uring,
+	     0,
+	     sizeof( libluksde_io_uring_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear io_uring.",
+		 function );
+
+		result = -1;
+	}
+	io_uring->file_descriptor      = -1;
+	io_uring->ring_file_descriptor = -1;
+
+	return( result );
+}
+
+/* Retrieves a fixed buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_io_uring_get_buffer(
+     libluksde_io_uring_t *io_uring,
+     int buffer_index,
+     uint8_t **buffer,
+     size_t *buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_io_uring_get_buffer";
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_uring->buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid io_uring - missing buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_index < 0 )
+	 || ( buffer_index >= io_uring->number_of_buffers ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	*buffer      = &( io_uring->buffers[ (size_t) buffer_index * io_uring->buffer_size ] );
+	*buffer_size = io_uring->buffer_size;
+
+	return( 1 );
+}
+
+/* Queues a read of the file into a fixed buffer
+ * The read is not submitted until libluksde_io_uring_submit is called
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_io_uring_queue_read(
+     libluksde_io_uring_t *io_uring,
+     int buffer_index,
+     size_t buffer_offset,
+     off64_t file_offset,
+     size_t read_size,
+     libcerror_error_t **error )
+{
+	static char *function                       = "libluksde_io_uring_queue_read";
+
+#if defined( LIBLUKSDE_HAVE_IO_URING )
+	struct io_uring_sqe *submission_queue_entry = NULL;
+	uint32_t submission_queue_head              = 0;
+	uint32_t submission_queue_index             = 0;
+	uint32_t submission_queue_tail              = 0;
+#endif
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_uring->buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid io_uring - missing buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_index < 0 )
+	 || ( buffer_index >= io_uring->number_of_buffers ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_offset >= io_uring->buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_size == 0 )
+	 || ( read_size > ( io_uring->buffer_size - buffer_offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBLUKSDE_HAVE_IO_URING )
+	/* The submission queue head is updated by the kernel
+	 */
+	submission_queue_head = libluksde_io_uring_load_acquire(
+	                         io_uring->submission_queue_head );
+	submission_queue_tail = *( io_uring->submission_queue_tail ) + io_uring->number_of_queued_reads;
+
+	if( ( submission_queue_tail - submission_queue_head ) > *( io_uring->submission_queue_ring_mask ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid io_uring - submission queue is full.",
+		 function );
+
+		return( -1 );
+	}
+	submission_queue_index = submission_queue_tail & *( io_uring->submission_queue_ring_mask );
+
+	submission_queue_entry = &( ( (struct io_uring_sqe *) io_uring->submission_queue_entries )[ submission_queue_index ] );
+
+	if( memory_set(
+	     submission_queue_entry,
+	     0,
+	     sizeof( struct io_uring_sqe ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear submission queue entry.",
+		 function );
+
+		return( -1 );
+	}
+	/* The file is referenced by its index in the registered files
+	 */
+	submission_queue_entry->opcode    = IORING_OP_READ_FIXED;
+	submission_queue_entry->flags     = IOSQE_FIXED_FILE;
+	submission_queue_entry->fd        = 0;
+	submission_queue_entry->addr      = (uint64_t) (intptr_t) &( io_uring->buffers[ ( (size_t) buffer_index * io_uring->buffer_size ) + buffer_offset ] );
+	submission_queue_entry->len       = (uint32_t) read_size;
+	submission_queue_entry->off       = (uint64_t) file_offset;
+	submission_queue_entry->buf_index = (uint16_t) buffer_index;
+	submission_queue_entry->user_data = (uint64_t) buffer_index;
+
+	io_uring->submission_queue_array[ submission_queue_index ] = submission_queue_index;
+
+	io_uring->number_of_queued_reads += 1;
+
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: io_uring is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( LIBLUKSDE_HAVE_IO_URING ) */
+}
+
+/* Submits the queued reads
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_io_uring_submit(
+     libluksde_io_uring_t *io_uring,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_io_uring_submit";
+
+#if defined( LIBLUKSDE_HAVE_IO_URING )
+	int number_of_entries = 0;
+#endif
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_uring->ring_file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid io_uring - missing ring file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBLUKSDE_HAVE_IO_URING )
+	if( io_uring->number_of_queued_reads == 0 )
+	{
+		return( 1 );
+	}
+	/* Publish the queued entries to the kernel before entering
+	 */
+	libluksde_io_uring_store_release(
+	 io_uring->submission_queue_tail,
+	 *( io_uring->submission_queue_tail ) + io_uring->number_of_queued_reads );
+
+	while( io_uring->number_of_queued_reads > 0 )
+	{
+		number_of_entries = libluksde_io_uring_enter(
+		                     io_uring->ring_file_descriptor,
+		                     io_uring->number_of_queued_reads,
+		                     0,
+		                     0 );
+
+		if( number_of_entries == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to submit reads.",
+			 function );
+
+			return( -1 );
+		}
+		io_uring->number_of_queued_reads  -= (uint32_t) number_of_entries;
+		io_uring->number_of_pending_reads += number_of_entries;
+	}
+	return( 1 );
+#else
+	return( -1 );
+#endif /* defined( LIBLUKSDE_HAVE_IO_URING ) */
+}
+
+/* Retrieves the next completed read
+ * The completion queue is polled and the kernel is only entered to wait
+ * if no read has completed yet
+ * The read count contains the number of bytes read or a negative error number
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_io_uring_get_completion(
+     libluksde_io_uring_t *io_uring,
+     int *buffer_index,
+     ssize_t *read_count,
+     libcerror_error_t **error )
+{
+	static char *function                       = "libluksde_io_uring_get_completion";
+
+#if defined( LIBLUKSDE_HAVE_IO_URING )
+	struct io_uring_cqe *completion_queue_entry = NULL;
+	uint32_t completion_queue_head              = 0;
+	uint32_t completion_queue_tail              = 0;
+#endif
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_uring->number_of_pending_reads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid io_uring - missing pending reads.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer index.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_count == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read count.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBLUKSDE_HAVE_IO_URING )
+	completion_queue_head = *( io_uring->completion_queue_head );
+
+	/* The completion queue tail is updated by the kernel
+	 */
+	completion_queue_tail = libluksde_io_uring_load_acquire(
+	                         io_uring->completion_queue_tail );
+
+	while( completion_queue_head == completion_queue_tail )
+	{
+		if( libluksde_io_uring_enter(
+		     io_uring->ring_file_descriptor,
+		     0,
+		     1,
+		     IORING_ENTER_GETEVENTS ) == -1 )
+		{
+			if( errno != EINTR )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 errno,
+				 "%s: unable to wait for completion.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		completion_queue_tail = libluksde_io_uring_load_acquire(
+		                         io_uring->completion_queue_tail );
+	}
+	completion_queue_entry = &( ( (struct io_uring_cqe *) io_uring->completion_queue_entries )[ completion_queue_head & *( io_uring->completion_queue_ring_mask ) ] );
+
+	*buffer_index = (int) completion_queue_entry->user_data;
+	*read_count   = (ssize_t) completion_queue_entry->res;
+
+	/* Release the completion queue entry to the kernel
+	 */
+	libluksde_io_uring_store_release(
+	 io_uring->completion_queue_head,
+	 completion_queue_head + 1 );
+
+	io_uring->number_of_pending_reads -= 1;
+
+	return( 1 );
+#else
+	return( -1 );
+#endif /* defined( LIBLUKSDE_HAVE_IO_URING ) */
+}
+
+/* Waits for the pending reads to complete and discards their results
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_io_uring_wait_for_pending_reads(
+     libluksde_io_uring_t *io_uring,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_io_uring_wait_for_pending_reads";
+	ssize_t read_count    = 0;
+	int buffer_index      = 0;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	/* Reads that were queued but not submitted are submitted to keep the rings consistent
+	 */
+	if( io_uring->number_of_queued_reads > 0 )
+	{
+		if( libluksde_io_uring_submit(
+		     io_uring,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to submit queued reads.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( io_uring->number_of_pending_reads > 0 )
+	{
+		if( libluksde_io_uring_get_completion(
+		     io_uring,
+		     &buffer_index,
+		     &read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to retrieve completion.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,161 @@
+/*
+ * io_uring functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_IO_URING_H )
+#define _LIBLUKSDE_IO_URING_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libluksde_io_uring libluksde_io_uring_t;
+
+struct libluksde_io_uring
+{
+	/* The file descriptor of the file that is read
+	 * The file is registered with the ring as fixed file 0
+	 */
+	int file_descriptor;
+
+	/* The file descriptor of the ring
+	 */
+	int ring_file_descriptor;
+
+	/* The mapped submission queue ring
+	 */
+	uint8_t *submission_queue_ring;
+
+	/* The mapped submission queue ring size
+	 */
+	size_t submission_queue_ring_size;
+
+	/* The mapped submission queue entries
+	 */
+	uint8_t *submission_queue_entries;
+
+	/* The mapped submission queue entries size
+	 */
+	size_t submission_queue_entries_size;
+
+	/* The mapped completion queue ring
+	 */
+	uint8_t *completion_queue_ring;
+
+	/* The mapped completion queue ring size
+	 */
+	size_t completion_queue_ring_size;
+
+	/* The submission queue head, tail, ring mask and array
+	 */
+	uint32_t *submission_queue_head;
+	uint32_t *submission_queue_tail;
+	uint32_t *submission_queue_ring_mask;
+	uint32_t *submission_queue_array;
+
+	/* The completion queue head, tail and ring mask
+	 */
+	uint32_t *completion_queue_head;
+	uint32_t *completion_queue_tail;
+	uint32_t *completion_queue_ring_mask;
+
+	/* The completion queue entries
+	 */
+	uint8_t *completion_queue_entries;
+
+	/* The fixed buffers
+	 * The buffers are registered with the ring and are contiguous in memory
+	 */
+	uint8_t *buffers;
+
+	/* The size of a fixed buffer
+	 */
+	size_t buffer_size;
+
+	/* The number of fixed buffers
+	 */
+	int number_of_buffers;
+
+	/* The number of reads that were queued but not yet submitted
+	 */
+	uint32_t number_of_queued_reads;
+
+	/* The number of reads that were submitted but not yet completed
+	 */
+	int number_of_pending_reads;
+};
+
+int libluksde_io_uring_initialize(
+     libluksde_io_uring_t **io_uring,
+     libcerror_error_t **error );
+
+int libluksde_io_uring_free(
+     libluksde_io_uring_t **io_uring,
+     libcerror_error_t **error );
+
+int libluksde_io_uring_open(
+     libluksde_io_uring_t *io_uring,
+     const char *filename,
+     libcerror_error_t **error );
+
+int libluksde_io_uring_close(
+     libluksde_io_uring_t *io_uring,
+     libcerror_error_t **error );
+
+int libluksde_io_uring_get_buffer(
+     libluksde_io_uring_t *io_uring,
+     int buffer_index,
+     uint8_t **buffer,
+     size_t *buffer_size,
+     libcerror_error_t **error );
+
+int libluksde_io_uring_queue_read(
+     libluksde_io_uring_t *io_uring,
+     int buffer_index,
+     size_t buffer_offset,
+     off64_t file_offset,
+     size_t read_size,
+     libcerror_error_t **error );
+
+int libluksde_io_uring_submit(
+     libluksde_io_uring_t *io_uring,
+     libcerror_error_t **error );
+
+int libluksde_io_uring_get_completion(
+     libluksde_io_uring_t *io_uring,
+     int *buffer_index,
+     ssize_t *read_count,
+     libcerror_error_t **error );
+
+int libluksde_io_uring_wait_for_pending_reads(
+     libluksde_io_uring_t *io_uring,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_IO_URING_H ) */
+
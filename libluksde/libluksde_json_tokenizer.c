@@ -0,0 +1,1141 @@
+/*
+ * JSON tokenizer functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_definitions.h"
+#include "libluksde_json_tokenizer.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_libuna.h"
+
+/* The tokenizer states
+ */
+enum LIBLUKSDE_JSON_TOKENIZER_STATES
+{
+	LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_VALUE,
+	LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_VALUE_OR_ARRAY_END,
+	LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_KEY,
+	LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_KEY_OR_OBJECT_END,
+	LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_NAME_SEPARATOR,
+	LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_VALUE_SEPARATOR_OR_END,
+	LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_END_OF_DATA
+};
+
+/* The maximum size of a base64 encoded JSON string value
+ */
+#define LIBLUKSDE_JSON_MAXIMUM_BASE64_STRING_SIZE	256
+
+/* Sets the data of a JSON tokenizer
+ * The tokenizer does not allocate memory and references the data without copying it
+ * hence the data must remain available as long as the tokenizer is used
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_json_tokenizer_set_data(
+     libluksde_json_tokenizer_t *tokenizer,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_json_tokenizer_set_data";
+
+	if( tokenizer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tokenizer.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	tokenizer->data            = data;
+	tokenizer->data_size       = data_size;
+	tokenizer->data_offset     = 0;
+	tokenizer->depth           = 0;
+	tokenizer->container_types = 0;
+	tokenizer->state           = LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_VALUE;
+
+	return( 1 );
+}
+
+/* Scans a string value
+ * The data offset must point to the opening quote
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_json_tokenizer_scan_string(
+     libluksde_json_tokenizer_t *tokenizer,
+     libluksde_json_token_t *token,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_json_tokenizer_scan_string";
+	size_t data_offset    = 0;
+	uint8_t byte_value    = 0;
+	int hexadecimal_index = 0;
+
+	data_offset = tokenizer->data_offset + 1;
+
+	token->type = LIBLUKSDE_JSON_TOKEN_TYPE_STRING;
+	token->data = &( tokenizer->data[ data_offset ] );
+
+	while( data_offset < tokenizer->data_size )
+	{
+		byte_value = tokenizer->data[ data_offset ];
+
+		if( byte_value == (uint8_t) '"' )
+		{
+			token->data_size = data_offset - ( tokenizer->data_offset + 1 );
+
+			tokenizer->data_offset = data_offset + 1;
+
+			return( 1 );
+		}
+		if( byte_value < 0x20 )
+		{
+			break;
+		}
+		if( byte_value == (uint8_t) '\\' )
+		{
+			data_offset++;
+
+			if( data_offset >= tokenizer->data_size )
+			{
+				break;
+			}
+			byte_value = tokenizer->data[ data_offset ];
+
+			if( byte_value == (uint8_t) 'u' )
+			{
+				if( ( tokenizer->data_size - data_offset ) <= 4 )
+				{
+					break;
+				}
+				for( hexadecimal_index = 1;
+				     hexadecimal_index <= 4;
+				     hexadecimal_index++ )
+				{
+					byte_value = tokenizer->data[ data_offset + hexadecimal_index ];
+
+					if( ( ( byte_value < (uint8_t) '0' )
+					  ||  ( byte_value > (uint8_t) '9' ) )
+					 && ( ( byte_value < (uint8_t) 'a' )
+					  ||  ( byte_value > (uint8_t) 'f' ) )
+					 && ( ( byte_value < (uint8_t) 'A' )
+					  ||  ( byte_value > (uint8_t) 'F' ) ) )
+					{
+						break;
+					}
+				}
+				if( hexadecimal_index <= 4 )
+				{
+					break;
+				}
+				data_offset += 4;
+			}
+			else if( ( byte_value != (uint8_t) '"' )
+			      && ( byte_value != (uint8_t) '\\' )
+			      && ( byte_value != (uint8_t) '/' )
+			      && ( byte_value != (uint8_t) 'b' )
+			      && ( byte_value != (uint8_t) 'f' )
+			      && ( byte_value != (uint8_t) 'n' )
+			      && ( byte_value != (uint8_t) 'r' )
+			      && ( byte_value != (uint8_t) 't' ) )
+			{
+				break;
+			}
+		}
+		data_offset++;
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: invalid string at offset: %" PRIzd ".",
+	 function,
+	 tokenizer->data_offset );
+
+	return( -1 );
+}
+
+/* Scans a number value
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_json_tokenizer_scan_number(
+     libluksde_json_tokenizer_t *tokenizer,
+     libluksde_json_token_t *token,
+     libcerror_error_t **error )
+{
+	static char *function   = "libluksde_json_tokenizer_scan_number";
+	size_t data_offset      = 0;
+	size_t number_of_digits = 0;
+
+	data_offset = tokenizer->data_offset;
+
+	if( tokenizer->data[ data_offset ] == (uint8_t) '-' )
+	{
+		data_offset++;
+	}
+	while( ( data_offset < tokenizer->data_size )
+	    && ( tokenizer->data[ data_offset ] >= (uint8_t) '0' )
+	    && ( tokenizer->data[ data_offset ] <= (uint8_t) '9' ) )
+	{
+		data_offset++;
+		number_of_digits++;
+	}
+	if( number_of_digits == 0 )
+	{
+		goto on_error;
+	}
+	if( ( data_offset < tokenizer->data_size )
+	 && ( tokenizer->data[ data_offset ] == (uint8_t) '.' ) )
+	{
+		data_offset++;
+
+		number_of_digits = 0;
+
+		while( ( data_offset < tokenizer->data_size )
+		    && ( tokenizer->data[ data_offset ] >= (uint8_t) '0' )
+		    && ( tokenizer->data[ data_offset ] <= (uint8_t) '9' ) )
+		{
+			data_offset++;
+			number_of_digits++;
+		}
+		if( number_of_digits == 0 )
+		{
+			goto on_error;
+		}
+	}
+	if( ( data_offset < tokenizer->data_size )
+	 && ( ( tokenizer->data[ data_offset ] == (uint8_t) 'e' )
+	  ||  ( tokenizer->data[ data_offset ] == (uint8_t) 'E' ) ) )
+	{
+		data_offset++;
+
+		if( ( data_offset < tokenizer->data_size )
+		 && ( ( tokenizer->data[ data_offset ] == (uint8_t) '+' )
+		  ||  ( tokenizer->data[ data_offset ] == (uint8_t) '-' ) ) )
+		{
+			data_offset++;
+		}
+		number_of_digits = 0;
+
+		while( ( data_offset < tokenizer->data_size )
+		    && ( tokenizer->data[ data_offset ] >= (uint8_t) '0' )
+		    && ( tokenizer->data[ data_offset ] <= (uint8_t) '9' ) )
+		{
+			data_offset++;
+			number_of_digits++;
+		}
+		if( number_of_digits == 0 )
+		{
+			goto on_error;
+		}
+	}
+	token->type      = LIBLUKSDE_JSON_TOKEN_TYPE_NUMBER;
+	token->data      = &( tokenizer->data[ tokenizer->data_offset ] );
+	token->data_size = data_offset - tokenizer->data_offset;
+
+	tokenizer->data_offset = data_offset;
+
+	return( 1 );
+
+on_error:
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: invalid number at offset: %" PRIzd ".",
+	 function,
+	 tokenizer->data_offset );
+
+	return( -1 );
+}
+
+/* Scans a literal value: true, false or null
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_json_tokenizer_scan_literal(
+     libluksde_json_tokenizer_t *tokenizer,
+     libluksde_json_token_t *token,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_json_tokenizer_scan_literal";
+	const char *literal   = NULL;
+	size_t literal_length = 0;
+	uint8_t token_type    = 0;
+
+	switch( tokenizer->data[ tokenizer->data_offset ] )
+	{
+		case (uint8_t) 'f':
+			literal        = "false";
+			literal_length = 5;
+			token_type     = LIBLUKSDE_JSON_TOKEN_TYPE_FALSE;
+			break;
+
+		case (uint8_t) 'n':
+			literal        = "null";
+			literal_length = 4;
+			token_type     = LIBLUKSDE_JSON_TOKEN_TYPE_NULL;
+			break;
+
+		case (uint8_t) 't':
+			literal        = "true";
+			literal_length = 4;
+			token_type     = LIBLUKSDE_JSON_TOKEN_TYPE_TRUE;
+			break;
+
+		default:
+			break;
+	}
+	if( ( literal == NULL )
+	 || ( literal_length > ( tokenizer->data_size - tokenizer->data_offset ) )
+	 || ( memory_compare(
+	       &( tokenizer->data[ tokenizer->data_offset ] ),
+	       literal,
+	       literal_length ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid value at offset: %" PRIzd ".",
+		 function,
+		 tokenizer->data_offset );
+
+		return( -1 );
+	}
+	token->type      = token_type;
+	token->data      = &( tokenizer->data[ tokenizer->data_offset ] );
+	token->data_size = literal_length;
+
+	tokenizer->data_offset += literal_length;
+
+	return( 1 );
+}
+
+/* Retrieves the next token
+ * The tokens are validated against the JSON grammar while they are read.
+ * Separators are consumed by the tokenizer and not returned as tokens.
+ * Data after the top-level value can be padded with 0-byte values.
+ * Returns 1 if successful, 0 if no more tokens are available or -1 on error
+ */
+int libluksde_json_tokenizer_get_next_token(
+     libluksde_json_tokenizer_t *tokenizer,
+     libluksde_json_token_t *token,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_json_tokenizer_get_next_token";
+	uint64_t depth_bit    = 0;
+	uint8_t byte_value    = 0;
+	uint8_t is_object     = 0;
+	int result            = 0;
+
+	if( tokenizer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tokenizer.",
+		 function );
+
+		return( -1 );
+	}
+	if( tokenizer->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid tokenizer - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( token == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid token.",
+		 function );
+
+		return( -1 );
+	}
+	token->type      = LIBLUKSDE_JSON_TOKEN_TYPE_UNDEFINED;
+	token->is_key    = 0;
+	token->depth     = tokenizer->depth;
+	token->data      = NULL;
+	token->data_size = 0;
+
+	while( tokenizer->data_offset < tokenizer->data_size )
+	{
+		byte_value = tokenizer->data[ tokenizer->data_offset ];
+
+		if( ( byte_value == (uint8_t) ' ' )
+		 || ( byte_value == (uint8_t) '\t' )
+		 || ( byte_value == (uint8_t) '\n' )
+		 || ( byte_value == (uint8_t) '\r' ) )
+		{
+			tokenizer->data_offset++;
+
+			continue;
+		}
+		if( byte_value == 0 )
+		{
+			break;
+		}
+		if( tokenizer->depth > 0 )
+		{
+			depth_bit = (uint64_t) 1 << ( tokenizer->depth - 1 );
+			is_object = (uint8_t) ( ( tokenizer->container_types & depth_bit ) != 0 );
+		}
+		switch( tokenizer->state )
+		{
+			case LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_NAME_SEPARATOR:
+				if( byte_value != (uint8_t) ':' )
+				{
+					goto on_unexpected_character;
+				}
+				tokenizer->data_offset++;
+
+				tokenizer->state = LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_VALUE;
+
+				continue;
+
+			case LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_VALUE_SEPARATOR_OR_END:
+				if( byte_value == (uint8_t) ',' )
+				{
+					tokenizer->data_offset++;
+
+					if( is_object != 0 )
+					{
+						tokenizer->state = LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_KEY;
+					}
+					else
+					{
+						tokenizer->state = LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_VALUE;
+					}
+					continue;
+				}
+				if( ( ( is_object != 0 )
+				  &&  ( byte_value == (uint8_t) '}' ) )
+				 || ( ( is_object == 0 )
+				  &&  ( byte_value == (uint8_t) ']' ) ) )
+				{
+					break;
+				}
+				goto on_unexpected_character;
+
+			case LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_KEY_OR_OBJECT_END:
+				if( byte_value == (uint8_t) '}' )
+				{
+					break;
+				}
+				if( byte_value != (uint8_t) '"' )
+				{
+					goto on_unexpected_character;
+				}
+				break;
+
+			case LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_KEY:
+				if( byte_value != (uint8_t) '"' )
+				{
+					goto on_unexpected_character;
+				}
+				break;
+
+			case LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_VALUE_OR_ARRAY_END:
+			case LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_VALUE:
+				if( ( byte_value == (uint8_t) ']' )
+				 && ( tokenizer->state != LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_VALUE_OR_ARRAY_END ) )
+				{
+					goto on_unexpected_character;
+				}
+				if( byte_value == (uint8_t) '}' )
+				{
+					goto on_unexpected_character;
+				}
+				break;
+
+			default:
+				goto on_unexpected_character;
+		}
+		/* Handle the end of an object or array
+		 */
+		if( ( byte_value == (uint8_t) '}' )
+		 || ( byte_value == (uint8_t) ']' ) )
+		{
+			tokenizer->container_types &= ~depth_bit;
+			tokenizer->depth           -= 1;
+			tokenizer->data_offset     += 1;
+
+			if( byte_value == (uint8_t) '}' )
+			{
+				token->type = LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_END;
+			}
+			else
+			{
+				token->type = LIBLUKSDE_JSON_TOKEN_TYPE_ARRAY_END;
+			}
+			token->depth = tokenizer->depth;
+		}
+		/* Handle the key of an object member
+		 */
+		else if( ( tokenizer->state == LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_KEY )
+		      || ( tokenizer->state == LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_KEY_OR_OBJECT_END ) )
+		{
+			if( libluksde_json_tokenizer_scan_string(
+			     tokenizer,
+			     token,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to scan key.",
+				 function );
+
+				return( -1 );
+			}
+			token->is_key = 1;
+
+			tokenizer->state = LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_NAME_SEPARATOR;
+
+			return( 1 );
+		}
+		/* Handle the start of an object or array
+		 */
+		else if( ( byte_value == (uint8_t) '{' )
+		      || ( byte_value == (uint8_t) '[' ) )
+		{
+			if( tokenizer->depth >= LIBLUKSDE_JSON_TOKENIZER_MAXIMUM_DEPTH )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid nesting depth value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			depth_bit = (uint64_t) 1 << tokenizer->depth;
+
+			tokenizer->depth       += 1;
+			tokenizer->data_offset += 1;
+
+			if( byte_value == (uint8_t) '{' )
+			{
+				tokenizer->container_types |= depth_bit;
+				tokenizer->state            = LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_KEY_OR_OBJECT_END;
+
+				token->type = LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_START;
+			}
+			else
+			{
+				tokenizer->container_types &= ~depth_bit;
+				tokenizer->state            = LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_VALUE_OR_ARRAY_END;
+
+				token->type = LIBLUKSDE_JSON_TOKEN_TYPE_ARRAY_START;
+			}
+			return( 1 );
+		}
+		/* Handle a scalar value
+		 */
+		else
+		{
+			if( byte_value == (uint8_t) '"' )
+			{
+				result = libluksde_json_tokenizer_scan_string(
+				          tokenizer,
+				          token,
+				          error );
+			}
+			else if( ( byte_value == (uint8_t) '-' )
+			      || ( ( byte_value >= (uint8_t) '0' )
+			       &&  ( byte_value <= (uint8_t) '9' ) ) )
+			{
+				result = libluksde_json_tokenizer_scan_number(
+				          tokenizer,
+				          token,
+				          error );
+			}
+			else
+			{
+				result = libluksde_json_tokenizer_scan_literal(
+				          tokenizer,
+				          token,
+				          error );
+			}
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to scan value.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		/* The value or container that was read is followed by a separator,
+		 * the end of the parent container or the end of the data
+		 */
+		if( tokenizer->depth == 0 )
+		{
+			tokenizer->state = LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_END_OF_DATA;
+		}
+		else
+		{
+			tokenizer->state = LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_VALUE_SEPARATOR_OR_END;
+		}
+		return( 1 );
+	}
+	if( tokenizer->state != LIBLUKSDE_JSON_TOKENIZER_STATE_EXPECT_END_OF_DATA )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: unexpected end of data at offset: %" PRIzd ".",
+		 function,
+		 tokenizer->data_offset );
+
+		return( -1 );
+	}
+	return( 0 );
+
+on_unexpected_character:
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: unexpected character: 0x%02" PRIx8 " at offset: %" PRIzd ".",
+	 function,
+	 byte_value,
+	 tokenizer->data_offset );
+
+	return( -1 );
+}
+
+/* Skips the value of a token
+ * If the token is the start of an object or array the tokens up to and
+ * including the corresponding end token are skipped
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_json_tokenizer_skip_value(
+     libluksde_json_tokenizer_t *tokenizer,
+     const libluksde_json_token_t *token,
+     libcerror_error_t **error )
+{
+	libluksde_json_token_t skip_token;
+
+	static char *function = "libluksde_json_tokenizer_skip_value";
+	int result            = 0;
+
+	if( token == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid token.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( token->type != LIBLUKSDE_JSON_TOKEN_TYPE_ARRAY_START )
+	 && ( token->type != LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_START ) )
+	{
+		return( 1 );
+	}
+	do
+	{
+		result = libluksde_json_tokenizer_get_next_token(
+		          tokenizer,
+		          &skip_token,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next token.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( ( skip_token.depth != token->depth )
+	    || ( ( skip_token.type != LIBLUKSDE_JSON_TOKEN_TYPE_ARRAY_END )
+	     &&  ( skip_token.type != LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_END ) ) );
+
+	return( 1 );
+}
+
+/* Retrieves the key and value tokens of the next member of an object
+ * The tokenizer must be positioned inside the object
+ * If the value of the member is an object or array the value token refers to its start
+ * Returns 1 if successful, 0 if the end of the object was reached or -1 on error
+ */
+int libluksde_json_tokenizer_get_next_member(
+     libluksde_json_tokenizer_t *tokenizer,
+     libluksde_json_token_t *key_token,
+     libluksde_json_token_t *value_token,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_json_tokenizer_get_next_member";
+
+	if( libluksde_json_tokenizer_get_next_token(
+	     tokenizer,
+	     key_token,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve key token.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_token->type == LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_END )
+	{
+		return( 0 );
+	}
+	if( key_token->is_key == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported token - not an object member.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_json_tokenizer_get_next_token(
+	     tokenizer,
+	     value_token,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value token.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Compares the (unescaped) data of a string token with a string
+ * Returns 1 if equal, 0 if not or -1 on error
+ */
+int libluksde_json_token_compare_string(
+     const libluksde_json_token_t *token,
+     const char *string,
+     size_t string_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_json_token_compare_string";
+
+	if( token == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid token.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( token->type != LIBLUKSDE_JSON_TOKEN_TYPE_STRING )
+	 || ( token->data_size != string_length ) )
+	{
+		return( 0 );
+	}
+	if( memory_compare(
+	     token->data,
+	     string,
+	     string_length ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Copies the data of a string token to a string
+ * The escape sequences \", \\ and \/ are unescaped, other escape sequences are not supported
+ * The string is terminated by an end-of-string character
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_json_token_copy_string(
+     const libluksde_json_token_t *token,
+     uint8_t *string,
+     size_t string_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_json_token_copy_string";
+	size_t data_offset    = 0;
+	size_t string_index   = 0;
+	uint8_t byte_value    = 0;
+
+	if( token == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid token.",
+		 function );
+
+		return( -1 );
+	}
+	if( token->type != LIBLUKSDE_JSON_TOKEN_TYPE_STRING )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported token type.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( string_size == 0 )
+	 || ( string_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid string size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < token->data_size )
+	{
+		byte_value = token->data[ data_offset++ ];
+
+		if( byte_value == (uint8_t) '\\' )
+		{
+			if( data_offset >= token->data_size )
+			{
+				break;
+			}
+			byte_value = token->data[ data_offset++ ];
+
+			if( ( byte_value != (uint8_t) '"' )
+			 && ( byte_value != (uint8_t) '\\' )
+			 && ( byte_value != (uint8_t) '/' ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported escape sequence.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( string_index >= ( string_size - 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+			 "%s: invalid string value too small.",
+			 function );
+
+			return( -1 );
+		}
+		string[ string_index++ ] = byte_value;
+	}
+	string[ string_index ] = 0;
+
+	return( 1 );
+}
+
+/* Retrieves the integer value of a number token or of a string token that contains a decimal number
+ * LUKS2 stores 64-bit values as strings since JSON numbers are not guaranteed to be 64-bit
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_json_token_get_integer_value(
+     const libluksde_json_token_t *token,
+     uint64_t *integer_value,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_json_token_get_integer_value";
+	size_t data_offset    = 0;
+	uint64_t safe_value   = 0;
+	uint8_t digit         = 0;
+
+	if( token == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid token.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( token->type != LIBLUKSDE_JSON_TOKEN_TYPE_NUMBER )
+	 && ( token->type != LIBLUKSDE_JSON_TOKEN_TYPE_STRING ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported token type.",
+		 function );
+
+		return( -1 );
+	}
+	if( integer_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integer value.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( token->data_size == 0 )
+	 || ( token->data_size > 20 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid token - data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( data_offset = 0;
+	     data_offset < token->data_size;
+	     data_offset++ )
+	{
+		if( ( token->data[ data_offset ] < (uint8_t) '0' )
+		 || ( token->data[ data_offset ] > (uint8_t) '9' ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported integer value.",
+			 function );
+
+			return( -1 );
+		}
+		digit = token->data[ data_offset ] - (uint8_t) '0';
+
+		if( safe_value > ( ( UINT64_MAX - digit ) / 10 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid integer value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		safe_value = ( safe_value * 10 ) + digit;
+	}
+	*integer_value = safe_value;
+
+	return( 1 );
+}
+
+/* Retrieves the decoded value of a base64 encoded string token
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_json_token_get_base64_value(
+     const libluksde_json_token_t *token,
+     uint8_t *data,
+     size_t data_size,
+     size_t *value_size,
+     libcerror_error_t **error )
+{
+	uint8_t base64_string[ LIBLUKSDE_JSON_MAXIMUM_BASE64_STRING_SIZE ];
+
+	static char *function     = "libluksde_json_token_get_base64_value";
+	size_t base64_string_size = 0;
+	size_t safe_value_size    = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value size.",
+		 function );
+
+		return( -1 );
+	}
+	/* The string is copied to remove escaped forward slashes
+	 */
+	if( libluksde_json_token_copy_string(
+	     token,
+	     base64_string,
+	     LIBLUKSDE_JSON_MAXIMUM_BASE64_STRING_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy base64 string.",
+		 function );
+
+		return( -1 );
+	}
+	while( base64_string[ base64_string_size ] != 0 )
+	{
+		base64_string_size++;
+	}
+	if( libuna_base64_stream_size_to_byte_stream(
+	     base64_string,
+	     base64_string_size,
+	     &safe_value_size,
+	     LIBUNA_BASE64_VARIANT_RFC4648,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine size of base64 decoded value.",
+		 function );
+
+		return( -1 );
+	}
+	if( safe_value_size > data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid data value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( libuna_base64_stream_copy_to_byte_stream(
+	     base64_string,
+	     base64_string_size,
+	     data,
+	     safe_value_size,
+	     LIBUNA_BASE64_VARIANT_RFC4648,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy base64 decoded value.",
+		 function );
+
+		return( -1 );
+	}
+	*value_size = safe_value_size;
+
+	return( 1 );
+}
+
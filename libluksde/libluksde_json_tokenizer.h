@@ -0,0 +1,142 @@
+/*
+ * JSON tokenizer functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_JSON_TOKENIZER_H )
+#define _LIBLUKSDE_JSON_TOKENIZER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libluksde_json_token libluksde_json_token_t;
+
+struct libluksde_json_token
+{
+	/* The type
+	 */
+	uint8_t type;
+
+	/* Value to indicate the token is the key of an object member
+	 */
+	uint8_t is_key;
+
+	/* The nesting depth
+	 */
+	int depth;
+
+	/* The data
+	 * For a string this is the (escaped) data between the quotes
+	 * The data references the tokenizer data and is not copied
+	 */
+	const uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+};
+
+typedef struct libluksde_json_tokenizer libluksde_json_tokenizer_t;
+
+struct libluksde_json_tokenizer
+{
+	/* The data
+	 */
+	const uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The current data offset
+	 */
+	size_t data_offset;
+
+	/* The current nesting depth
+	 */
+	int depth;
+
+	/* The container types per nesting depth
+	 * A bit is set if the container is an object and unset if it is an array
+	 */
+	uint64_t container_types;
+
+	/* The parser state
+	 */
+	uint8_t state;
+};
+
+int libluksde_json_tokenizer_set_data(
+     libluksde_json_tokenizer_t *tokenizer,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libluksde_json_tokenizer_get_next_token(
+     libluksde_json_tokenizer_t *tokenizer,
+     libluksde_json_token_t *token,
+     libcerror_error_t **error );
+
+int libluksde_json_tokenizer_get_next_member(
+     libluksde_json_tokenizer_t *tokenizer,
+     libluksde_json_token_t *key_token,
+     libluksde_json_token_t *value_token,
+     libcerror_error_t **error );
+
+int libluksde_json_tokenizer_skip_value(
+     libluksde_json_tokenizer_t *tokenizer,
+     const libluksde_json_token_t *token,
+     libcerror_error_t **error );
+
+int libluksde_json_token_compare_string(
+     const libluksde_json_token_t *token,
+     const char *string,
+     size_t string_length,
+     libcerror_error_t **error );
+
+int libluksde_json_token_copy_string(
+     const libluksde_json_token_t *token,
+     uint8_t *string,
+     size_t string_size,
+     libcerror_error_t **error );
+
+int libluksde_json_token_get_integer_value(
+     const libluksde_json_token_t *token,
+     uint64_t *integer_value,
+     libcerror_error_t **error );
+
+int libluksde_json_token_get_base64_value(
+     const libluksde_json_token_t *token,
+     uint8_t *data,
+     size_t data_size,
+     size_t *value_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_JSON_TOKENIZER_H ) */
+
@@ -25,9 +25,11 @@
 #include <types.h>
 
 #include "libluksde_definitions.h"
+#include "libluksde_json_tokenizer.h"
 #include "libluksde_key_slot.h"
 #include "libluksde_libcerror.h"
 #include "libluksde_libcnotify.h"
+#include "libluksde_volume_header.h"
 
 #include "luksde_keyslot.h"
 
@@ -91,6 +93,8 @@ int libluksde_key_slot_initialize(
 
 		goto on_error;
 	}
+	( *key_slot )->priority = LIBLUKSDE_KEY_SLOT_PRIORITY_NORMAL;
+
 	return( 1 );
 
 on_error:
@@ -213,6 +217,9 @@ int libluksde_key_slot_read_data(
 
 		return( -1 );
 	}
+	key_slot->salt_size               = 32;
+	key_slot->key_derivation_function = LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_PBKDF2;
+
 	byte_stream_copy_to_uint32_big_endian(
 	 ( (luksde_volume_keyslot_t *) data )->start_sector,
 	 key_slot->key_material_offset );
@@ -224,6 +231,11 @@ int libluksde_key_slot_read_data(
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
+		libcnotify_printf(
+		 "%s: type\t\t\t\t\t: %d\n",
+		 function,
+		 key_slot->type );
+
 		libcnotify_printf(
 		 "%s: state\t\t\t\t\t: 0x%08" PRIx32 "\n",
 		 function,
@@ -260,3 +272,1041 @@ int libluksde_key_slot_read_data(
 	return( 1 );
 }
 
+/* Retrieves a 32-bit integer value of a JSON token
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_key_slot_get_json_32bit_integer_value(
+     const libluksde_json_token_t *token,
+     uint32_t *value_32bit,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_key_slot_get_json_32bit_integer_value";
+	uint64_t value_64bit  = 0;
+
+	if( value_32bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 32-bit.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_json_token_get_integer_value(
+	     token,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve integer value.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > (uint64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid integer value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*value_32bit = (uint32_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Retrieves the hashing method of a JSON string token
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_key_slot_get_json_hashing_method(
+     const libluksde_json_token_t *token,
+     int *hashing_method,
+     libcerror_error_t **error )
+{
+	uint8_t hashing_method_string[ 32 ];
+
+	static char *function = "libluksde_key_slot_get_json_hashing_method";
+
+	if( libluksde_json_token_copy_string(
+	     token,
+	     hashing_method_string,
+	     32,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy hashing method string.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_volume_parse_hashing_method(
+	     hashing_method_string,
+	     hashing_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to parse hashing method.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the anti-forensic (af) JSON object of a key slot
+ * The tokenizer must be positioned after the start of the object
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_key_slot_read_json_af_object(
+     libluksde_key_slot_t *key_slot,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error )
+{
+	libluksde_json_token_t key_token;
+	libluksde_json_token_t value_token;
+
+	static char *function = "libluksde_key_slot_read_json_af_object";
+	int result            = 0;
+
+	if( key_slot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key slot.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		result = libluksde_json_tokenizer_get_next_member(
+		          tokenizer,
+		          &key_token,
+		          &value_token,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve af member.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libluksde_json_token_compare_string(
+		     &key_token,
+		     "type",
+		     4,
+		     error ) == 1 )
+		{
+			if( libluksde_json_token_compare_string(
+			     &value_token,
+			     "luks1",
+			     5,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported af type.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "stripes",
+		          7,
+		          error ) == 1 )
+		{
+			if( libluksde_key_slot_get_json_32bit_integer_value(
+			     &value_token,
+			     &( key_slot->number_of_stripes ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of stripes.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "hash",
+		          4,
+		          error ) == 1 )
+		{
+			if( libluksde_key_slot_get_json_hashing_method(
+			     &value_token,
+			     &( key_slot->diffuser_hashing_method ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve af hashing method.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_tokenizer_skip_value(
+		          tokenizer,
+		          &value_token,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to skip value.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( result != 0 );
+
+	return( 1 );
+}
+
+/* Reads the area JSON object of a key slot
+ * The tokenizer must be positioned after the start of the object
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_key_slot_read_json_area_object(
+     libluksde_key_slot_t *key_slot,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error )
+{
+	libluksde_json_token_t key_token;
+	libluksde_json_token_t value_token;
+
+	static char *function = "libluksde_key_slot_read_json_area_object";
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( key_slot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key slot.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		result = libluksde_json_tokenizer_get_next_member(
+		          tokenizer,
+		          &key_token,
+		          &value_token,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve area member.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libluksde_json_token_compare_string(
+		     &key_token,
+		     "offset",
+		     6,
+		     error ) == 1 )
+		{
+			if( libluksde_json_token_get_integer_value(
+			     &value_token,
+			     &value_64bit,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve area offset.",
+				 function );
+
+				return( -1 );
+			}
+			if( ( ( value_64bit % 512 ) != 0 )
+			 || ( value_64bit > (uint64_t) INT64_MAX ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid area offset value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			key_slot->key_material_offset = (off64_t) ( value_64bit / 512 );
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "size",
+		          4,
+		          error ) == 1 )
+		{
+			if( libluksde_json_token_get_integer_value(
+			     &value_token,
+			     &( key_slot->key_material_size ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve area size.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "encryption",
+		          10,
+		          error ) == 1 )
+		{
+			if( value_token.type != LIBLUKSDE_JSON_TOKEN_TYPE_STRING )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported area encryption value type.",
+				 function );
+
+				return( -1 );
+			}
+			if( libluksde_volume_parse_encryption_specification(
+			     value_token.data,
+			     value_token.data_size,
+			     &( key_slot->encryption_method ),
+			     &( key_slot->encryption_chaining_mode ),
+			     &( key_slot->initialization_vector_mode ),
+			     &( key_slot->essiv_hashing_method ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to parse area encryption.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "key_size",
+		          8,
+		          error ) == 1 )
+		{
+			if( libluksde_key_slot_get_json_32bit_integer_value(
+			     &value_token,
+			     &( key_slot->encryption_key_size ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve area key size.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_tokenizer_skip_value(
+		          tokenizer,
+		          &value_token,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to skip value.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( result != 0 );
+
+	return( 1 );
+}
+
+/* Reads the key derivation function (kdf) JSON object of a key slot
+ * The tokenizer must be positioned after the start of the object
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_key_slot_read_json_kdf_object(
+     libluksde_key_slot_t *key_slot,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error )
+{
+	libluksde_json_token_t key_token;
+	libluksde_json_token_t value_token;
+
+	static char *function = "libluksde_key_slot_read_json_kdf_object";
+	int result            = 0;
+
+	if( key_slot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key slot.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		result = libluksde_json_tokenizer_get_next_member(
+		          tokenizer,
+		          &key_token,
+		          &value_token,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve kdf member.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libluksde_json_token_compare_string(
+		     &key_token,
+		     "type",
+		     4,
+		     error ) == 1 )
+		{
+			if( libluksde_json_token_compare_string(
+			     &value_token,
+			     "pbkdf2",
+			     6,
+			     error ) == 1 )
+			{
+				key_slot->key_derivation_function = LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_PBKDF2;
+			}
+			else if( libluksde_json_token_compare_string(
+			          &value_token,
+			          "argon2i",
+			          7,
+			          error ) == 1 )
+			{
+				key_slot->key_derivation_function = LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2I;
+			}
+			else if( libluksde_json_token_compare_string(
+			          &value_token,
+			          "argon2id",
+			          8,
+			          error ) == 1 )
+			{
+				key_slot->key_derivation_function = LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID;
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "hash",
+		          4,
+		          error ) == 1 )
+		{
+			if( libluksde_key_slot_get_json_hashing_method(
+			     &value_token,
+			     &( key_slot->hashing_method ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve kdf hashing method.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "iterations",
+		          10,
+		          error ) == 1 )
+		{
+			if( libluksde_key_slot_get_json_32bit_integer_value(
+			     &value_token,
+			     &( key_slot->number_of_iterations ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of iterations.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "time",
+		          4,
+		          error ) == 1 )
+		{
+			if( libluksde_key_slot_get_json_32bit_integer_value(
+			     &value_token,
+			     &( key_slot->time_cost ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve time cost.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "memory",
+		          6,
+		          error ) == 1 )
+		{
+			if( libluksde_key_slot_get_json_32bit_integer_value(
+			     &value_token,
+			     &( key_slot->memory_cost ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve memory cost.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "cpus",
+		          4,
+		          error ) == 1 )
+		{
+			if( libluksde_key_slot_get_json_32bit_integer_value(
+			     &value_token,
+			     &( key_slot->parallelism ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve parallelism.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "salt",
+		          4,
+		          error ) == 1 )
+		{
+			if( libluksde_json_token_get_base64_value(
+			     &value_token,
+			     key_slot->salt,
+			     64,
+			     &( key_slot->salt_size ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve salt.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_tokenizer_skip_value(
+		          tokenizer,
+		          &value_token,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to skip value.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( result != 0 );
+
+	return( 1 );
+}
+
+/* Reads a LUKS2 key slot from a JSON object
+ * The tokenizer must be positioned after the start of the key slot object
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_key_slot_read_json_object(
+     libluksde_key_slot_t *key_slot,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error )
+{
+	libluksde_json_token_t key_token;
+	libluksde_json_token_t value_token;
+
+	static char *function = "libluksde_key_slot_read_json_object";
+	uint32_t value_32bit  = 0;
+	int result            = 0;
+
+	if( key_slot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key slot.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		result = libluksde_json_tokenizer_get_next_member(
+		          tokenizer,
+		          &key_token,
+		          &value_token,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve key slot member.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libluksde_json_token_compare_string(
+		     &key_token,
+		     "type",
+		     4,
+		     error ) == 1 )
+		{
+			/* Only "luks2" key slots contain a key, other types such as "reencrypt"
+			 * are kept as inactive key slots
+			 */
+			if( libluksde_json_token_compare_string(
+			     &value_token,
+			     "luks2",
+			     5,
+			     error ) == 1 )
+			{
+				key_slot->type  = LIBLUKSDE_KEY_SLOT_TYPE_LUKS2;
+				key_slot->state = LIBLUKSDE_KEY_SLOT_STATE_ACTIVE;
+			}
+			else if( libluksde_json_token_compare_string(
+			          &value_token,
+			          "reencrypt",
+			          9,
+			          error ) == 1 )
+			{
+				key_slot->type = LIBLUKSDE_KEY_SLOT_TYPE_REENCRYPT;
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "mode",
+		          4,
+		          error ) == 1 )
+		{
+			if( libluksde_json_token_compare_string(
+			     &value_token,
+			     "reencrypt",
+			     9,
+			     error ) == 1 )
+			{
+				key_slot->reencryption_mode = LIBLUKSDE_REENCRYPTION_MODE_REENCRYPT;
+			}
+			else if( libluksde_json_token_compare_string(
+			          &value_token,
+			          "encrypt",
+			          7,
+			          error ) == 1 )
+			{
+				key_slot->reencryption_mode = LIBLUKSDE_REENCRYPTION_MODE_ENCRYPT;
+			}
+			else if( libluksde_json_token_compare_string(
+			          &value_token,
+			          "decrypt",
+			          7,
+			          error ) == 1 )
+			{
+				key_slot->reencryption_mode = LIBLUKSDE_REENCRYPTION_MODE_DECRYPT;
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "direction",
+		          9,
+		          error ) == 1 )
+		{
+			if( libluksde_json_token_compare_string(
+			     &value_token,
+			     "forward",
+			     7,
+			     error ) == 1 )
+			{
+				key_slot->reencryption_direction = LIBLUKSDE_REENCRYPTION_DIRECTION_FORWARD;
+			}
+			else if( libluksde_json_token_compare_string(
+			          &value_token,
+			          "backward",
+			          8,
+			          error ) == 1 )
+			{
+				key_slot->reencryption_direction = LIBLUKSDE_REENCRYPTION_DIRECTION_BACKWARD;
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "key_size",
+		          8,
+		          error ) == 1 )
+		{
+			if( libluksde_key_slot_get_json_32bit_integer_value(
+			     &value_token,
+			     &( key_slot->key_size ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve key size.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "priority",
+		          8,
+		          error ) == 1 )
+		{
+			if( libluksde_key_slot_get_json_32bit_integer_value(
+			     &value_token,
+			     &value_32bit,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve priority.",
+				 function );
+
+				return( -1 );
+			}
+			if( value_32bit > LIBLUKSDE_KEY_SLOT_PRIORITY_PREFER )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported priority: %" PRIu32 ".",
+				 function,
+				 value_32bit );
+
+				return( -1 );
+			}
+			key_slot->priority = (int) value_32bit;
+		}
+		else if( ( value_token.type == LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_START )
+		      && ( libluksde_json_token_compare_string(
+		            &key_token,
+		            "af",
+		            2,
+		            error ) == 1 ) )
+		{
+			if( libluksde_key_slot_read_json_af_object(
+			     key_slot,
+			     tokenizer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read af object.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( ( value_token.type == LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_START )
+		      && ( libluksde_json_token_compare_string(
+		            &key_token,
+		            "area",
+		            4,
+		            error ) == 1 ) )
+		{
+			if( libluksde_key_slot_read_json_area_object(
+			     key_slot,
+			     tokenizer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read area object.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( ( value_token.type == LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_START )
+		      && ( libluksde_json_token_compare_string(
+		            &key_token,
+		            "kdf",
+		            3,
+		            error ) == 1 ) )
+		{
+			if( libluksde_key_slot_read_json_kdf_object(
+			     key_slot,
+			     tokenizer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read kdf object.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_tokenizer_skip_value(
+		          tokenizer,
+		          &value_token,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to skip value.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( result != 0 );
+
+	if( key_slot->state == LIBLUKSDE_KEY_SLOT_STATE_ACTIVE )
+	{
+		if( ( key_slot->key_size == 0 )
+		 || ( key_slot->key_size > 64 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid key size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( key_slot->encryption_key_size == 0 )
+		 || ( key_slot->encryption_key_size > 64 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid area key size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( key_slot->key_material_size < ( (uint64_t) key_slot->key_size * key_slot->number_of_stripes ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid area size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: identifier\t\t\t\t: %d\n",
+		 function,
+		 key_slot->identifier );
+
+		libcnotify_printf(
+		 "%s: state\t\t\t\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 key_slot->state );
+
+		libcnotify_printf(
+		 "%s: priority\t\t\t\t: %d\n",
+		 function,
+		 key_slot->priority );
+
+		if( key_slot->type == LIBLUKSDE_KEY_SLOT_TYPE_REENCRYPT )
+		{
+			libcnotify_printf(
+			 "%s: reencryption mode\t\t\t: %d\n",
+			 function,
+			 key_slot->reencryption_mode );
+
+			libcnotify_printf(
+			 "%s: reencryption direction\t\t: %d\n",
+			 function,
+			 key_slot->reencryption_direction );
+		}
+
+		libcnotify_printf(
+		 "%s: key size\t\t\t\t: %" PRIu32 "\n",
+		 function,
+		 key_slot->key_size );
+
+		libcnotify_printf(
+		 "%s: key derivation function\t\t: %d\n",
+		 function,
+		 key_slot->key_derivation_function );
+
+		libcnotify_printf(
+		 "%s: salt:\n",
+		 function );
+		libcnotify_print_data(
+		 key_slot->salt,
+		 key_slot->salt_size,
+		 0 );
+
+		libcnotify_printf(
+		 "%s: number of iterations\t\t\t: %" PRIu32 "\n",
+		 function,
+		 key_slot->number_of_iterations );
+
+		libcnotify_printf(
+		 "%s: time cost\t\t\t\t: %" PRIu32 "\n",
+		 function,
+		 key_slot->time_cost );
+
+		libcnotify_printf(
+		 "%s: memory cost\t\t\t\t: %" PRIu32 " KiB\n",
+		 function,
+		 key_slot->memory_cost );
+
+		libcnotify_printf(
+		 "%s: parallelism\t\t\t\t: %" PRIu32 "\n",
+		 function,
+		 key_slot->parallelism );
+
+		libcnotify_printf(
+		 "%s: number of stripes\t\t\t\t: %" PRIu32 "\n",
+		 function,
+		 key_slot->number_of_stripes );
+
+		libcnotify_printf(
+		 "%s: key material offset\t\t\t: %" PRIi64 " sectors\n",
+		 function,
+		 key_slot->key_material_offset );
+
+		libcnotify_printf(
+		 "%s: key material size\t\t\t: %" PRIu64 "\n",
+		 function,
+		 key_slot->key_material_size );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+	return( 1 );
+}
+
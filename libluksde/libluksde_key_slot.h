@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libluksde_json_tokenizer.h"
 #include "libluksde_libcerror.h"
 
 #if defined( __cplusplus )
@@ -35,25 +36,110 @@ typedef struct libluksde_key_slot libluksde_key_slot_t;
 
 struct libluksde_key_slot
 {
+	/* The identifier
+	 */
+	int identifier;
+
+	/* The type
+	 */
+	int type;
+
 	/* The state
 	 */
 	uint32_t state;
 
-	/* The key material offset
+	/* The priority
 	 */
-	off64_t key_material_offset;
+	int priority;
+
+	/* The reencryption mode
+	 * Used by the reencrypt key slot
+	 */
+	int reencryption_mode;
+
+	/* The reencryption direction
+	 * Used by the reencrypt key slot
+	 */
+	int reencryption_direction;
+
+	/* The key size
+	 * Contains the size of the (master) key stored in the key slot
+	 */
+	uint32_t key_size;
+
+	/* The key derivation function
+	 */
+	int key_derivation_function;
+
+	/* The key derivation hashing method
+	 */
+	int hashing_method;
 
 	/* The salt
 	 */
-	uint8_t salt[ 32 ];
+	uint8_t salt[ 64 ];
+
+	/* The salt size
+	 */
+	size_t salt_size;
 
 	/* The number of iterations
+	 * Used by PBKDF2
 	 */
 	uint32_t number_of_iterations;
 
+	/* The time cost
+	 * Used by Argon2
+	 */
+	uint32_t time_cost;
+
+	/* The memory cost in KiB
+	 * Used by Argon2
+	 */
+	uint32_t memory_cost;
+
+	/* The parallelism
+	 * Used by Argon2
+	 */
+	uint32_t parallelism;
+
 	/* The number of stripes
 	 */
 	uint32_t number_of_stripes;
+
+	/* The anti-forensic (diffuser) hashing method
+	 */
+	int diffuser_hashing_method;
+
+	/* The key material offset
+	 * Contains the number of 512-byte sectors
+	 */
+	off64_t key_material_offset;
+
+	/* The key material size
+	 * Contains 0 if the size is determined by the number of stripes
+	 */
+	uint64_t key_material_size;
+
+	/* The key material encryption method
+	 */
+	int encryption_method;
+
+	/* The key material encryption chaining mode
+	 */
+	int encryption_chaining_mode;
+
+	/* The key material initialization vector mode
+	 */
+	int initialization_vector_mode;
+
+	/* The key material ESSIV hashing method
+	 */
+	int essiv_hashing_method;
+
+	/* The key material encryption key size
+	 */
+	uint32_t encryption_key_size;
 };
 
 int libluksde_key_slot_initialize(
@@ -70,6 +156,36 @@ int libluksde_key_slot_read_data(
      size_t data_size,
      libcerror_error_t **error );
 
+int libluksde_key_slot_get_json_32bit_integer_value(
+     const libluksde_json_token_t *token,
+     uint32_t *value_32bit,
+     libcerror_error_t **error );
+
+int libluksde_key_slot_get_json_hashing_method(
+     const libluksde_json_token_t *token,
+     int *hashing_method,
+     libcerror_error_t **error );
+
+int libluksde_key_slot_read_json_af_object(
+     libluksde_key_slot_t *key_slot,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error );
+
+int libluksde_key_slot_read_json_area_object(
+     libluksde_key_slot_t *key_slot,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error );
+
+int libluksde_key_slot_read_json_kdf_object(
+     libluksde_key_slot_t *key_slot,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error );
+
+int libluksde_key_slot_read_json_object(
+     libluksde_key_slot_t *key_slot,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
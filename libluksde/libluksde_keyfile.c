@@ -0,0 +1,1139 @@
+/*
+ * Keyfile functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#include "libluksde_blake2b.h"
+#include "libluksde_definitions.h"
+#include "libluksde_diffuser.h"
+#include "libluksde_keyfile.h"
+#include "libluksde_libbfio.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_libhmac.h"
+#include "libluksde_password.h"
+
+/* Creates a keyfile
+ * Make sure the value keyfile is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_keyfile_initialize(
+     libluksde_keyfile_t **keyfile,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_keyfile_initialize";
+
+	if( keyfile == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyfile.",
+		 function );
+
+		return( -1 );
+	}
+	if( *keyfile != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid keyfile value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*keyfile = memory_allocate_structure(
+	            libluksde_keyfile_t );
+
+	if( *keyfile == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create keyfile.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *keyfile,
+	     0,
+	     sizeof( libluksde_keyfile_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear keyfile.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *keyfile != NULL )
+	{
+		memory_free(
+		 *keyfile );
+
+		*keyfile = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a keyfile
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_keyfile_free(
+     libluksde_keyfile_t **keyfile,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_keyfile_free";
+	int result            = 1;
+
+	if( keyfile == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyfile.",
+		 function );
+
+		return( -1 );
+	}
+	if( *keyfile != NULL )
+	{
+		if( ( *keyfile )->file_io_handle != NULL )
+		{
+			if( libluksde_keyfile_close(
+			     *keyfile,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close keyfile.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *keyfile );
+
+		*keyfile = NULL;
+	}
+	return( result );
+}
+
+/* Opens a keyfile
+ * A size of 0 represents the remainder of the file after the offset
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_keyfile_open(
+     libluksde_keyfile_t *keyfile,
+     const char *filename,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libluksde_keyfile_open";
+	size_t filename_length           = 0;
+
+	if( keyfile == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyfile.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_keyfile_open_file_io_handle(
+	     keyfile,
+	     file_io_handle,
+	     offset,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open keyfile: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	keyfile->file_io_handle_created_in_library = 1;
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Opens a keyfile
+ * A size of 0 represents the remainder of the file after the offset
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_keyfile_open_wide(
+     libluksde_keyfile_t *keyfile,
+     const wchar_t *filename,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libluksde_keyfile_open_wide";
+	size_t filename_length           = 0;
+
+	if( keyfile == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyfile.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = wide_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_keyfile_open_file_io_handle(
+	     keyfile,
+	     file_io_handle,
+	     offset,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open keyfile: %ls.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	keyfile->file_io_handle_created_in_library = 1;
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Opens a keyfile using a Basic File IO (bfio) handle
+ * A size of 0 represents the remainder of the file after the offset
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_keyfile_open_file_io_handle(
+     libluksde_keyfile_t *keyfile,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	static char *function                    = "libluksde_keyfile_open_file_io_handle";
+	size64_t file_size                       = 0;
+	uint8_t file_io_handle_opened_in_library = 0;
+	int file_io_handle_is_open               = 0;
+
+	if( keyfile == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyfile.",
+		 function );
+
+		return( -1 );
+	}
+	if( keyfile->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid keyfile - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		goto on_error;
+	}
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_ACCESS_FLAG_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		file_io_handle_opened_in_library = 1;
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( (size64_t) offset >= file_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( size == 0 )
+	{
+		size = file_size - (size64_t) offset;
+	}
+	/* The key data is passed to Argon2 with a 32-bit size
+	 */
+	if( ( size > ( file_size - (size64_t) offset ) )
+	 || ( size > (size64_t) UINT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	keyfile->file_io_handle                   = file_io_handle;
+	keyfile->file_io_handle_opened_in_library = file_io_handle_opened_in_library;
+	keyfile->offset                           = offset;
+	keyfile->size                             = size;
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle_opened_in_library != 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes a keyfile
+ * Returns 0 if successful or -1 on error
+ */
+int libluksde_keyfile_close(
+     libluksde_keyfile_t *keyfile,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_keyfile_close";
+	int result            = 0;
+
+	if( keyfile == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyfile.",
+		 function );
+
+		return( -1 );
+	}
+	if( keyfile->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid keyfile - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( keyfile->file_io_handle_opened_in_library != 0 )
+	{
+		if( libbfio_handle_close(
+		     keyfile->file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		keyfile->file_io_handle_opened_in_library = 0;
+	}
+	if( keyfile->file_io_handle_created_in_library != 0 )
+	{
+		if( libbfio_handle_free(
+		     &( keyfile->file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		keyfile->file_io_handle_created_in_library = 0;
+	}
+	keyfile->file_io_handle = NULL;
+	keyfile->offset         = 0;
+	keyfile->size           = 0;
+
+	return( result );
+}
+
+/* Reads the key data of a keyfile
+ * The data size must match the size of the key data
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_keyfile_read_data(
+     libluksde_keyfile_t *keyfile,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_keyfile_read_data";
+	ssize_t read_count    = 0;
+
+	if( keyfile == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyfile.",
+		 function );
+
+		return( -1 );
+	}
+	if( keyfile->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid keyfile - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size > (size_t) SSIZE_MAX )
+	 || ( (size64_t) data_size != keyfile->size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              keyfile->file_io_handle,
+	              data,
+	              data_size,
+	              keyfile->offset,
+	              error );
+
+	if( read_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read key data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 keyfile->offset,
+		 keyfile->offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Calculates the hash of the key data of a keyfile
+ * The key data is read in chunks so it does not need to be stored in memory
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_keyfile_calculate_hash(
+     libluksde_keyfile_t *keyfile,
+     int hashing_method,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	uint8_t chunk_data[ LIBLUKSDE_KEYFILE_CHUNK_SIZE ];
+
+	int (*initialize_function)( intptr_t **context, libcerror_error_t **error )                               = NULL;
+	int (*free_function)( intptr_t **context, libcerror_error_t **error )                                     = NULL;
+	int (*update_function)( intptr_t *context, const uint8_t *buffer, size_t size, libcerror_error_t **error ) = NULL;
+	int (*finalize_function)( intptr_t *context, uint8_t *hash, size_t hash_size, libcerror_error_t **error ) = NULL;
+
+	intptr_t *context     = NULL;
+	static char *function = "libluksde_keyfile_calculate_hash";
+	size64_t data_offset  = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+
+	if( keyfile == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyfile.",
+		 function );
+
+		return( -1 );
+	}
+	if( keyfile->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid keyfile - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	switch( hashing_method )
+	{
+		case LIBLUKSDE_HASHING_METHOD_SHA1:
+			initialize_function = (int (*)( intptr_t **, libcerror_error_t ** )) &libhmac_sha1_initialize;
+			free_function       = (int (*)( intptr_t **, libcerror_error_t ** )) &libhmac_sha1_free;
+			update_function     = (int (*)( intptr_t *, const uint8_t *, size_t, libcerror_error_t ** )) &libhmac_sha1_update;
+			finalize_function   = (int (*)( intptr_t *, uint8_t *, size_t, libcerror_error_t ** )) &libhmac_sha1_finalize;
+			break;
+
+		case LIBLUKSDE_HASHING_METHOD_SHA224:
+			initialize_function = (int (*)( intptr_t **, libcerror_error_t ** )) &libhmac_sha224_initialize;
+			free_function       = (int (*)( intptr_t **, libcerror_error_t ** )) &libhmac_sha224_free;
+			update_function     = (int (*)( intptr_t *, const uint8_t *, size_t, libcerror_error_t ** )) &libhmac_sha224_update;
+			finalize_function   = (int (*)( intptr_t *, uint8_t *, size_t, libcerror_error_t ** )) &libhmac_sha224_finalize;
+			break;
+
+		case LIBLUKSDE_HASHING_METHOD_SHA256:
+			initialize_function = (int (*)( intptr_t **, libcerror_error_t ** )) &libhmac_sha256_initialize;
+			free_function       = (int (*)( intptr_t **, libcerror_error_t ** )) &libhmac_sha256_free;
+			update_function     = (int (*)( intptr_t *, const uint8_t *, size_t, libcerror_error_t ** )) &libhmac_sha256_update;
+			finalize_function   = (int (*)( intptr_t *, uint8_t *, size_t, libcerror_error_t ** )) &libhmac_sha256_finalize;
+			break;
+
+		case LIBLUKSDE_HASHING_METHOD_SHA512:
+			initialize_function = (int (*)( intptr_t **, libcerror_error_t ** )) &libhmac_sha512_initialize;
+			free_function       = (int (*)( intptr_t **, libcerror_error_t ** )) &libhmac_sha512_free;
+			update_function     = (int (*)( intptr_t *, const uint8_t *, size_t, libcerror_error_t ** )) &libhmac_sha512_update;
+			finalize_function   = (int (*)( intptr_t *, uint8_t *, size_t, libcerror_error_t ** )) &libhmac_sha512_finalize;
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported hashing method.",
+			 function );
+
+			return( -1 );
+	}
+	if( initialize_function(
+	     &context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize hash context.",
+		 function );
+
+		goto on_error;
+	}
+	while( data_offset < keyfile->size )
+	{
+		read_size = LIBLUKSDE_KEYFILE_CHUNK_SIZE;
+
+		if( read_size > ( keyfile->size - data_offset ) )
+		{
+			read_size = (size_t) ( keyfile->size - data_offset );
+		}
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              keyfile->file_io_handle,
+		              chunk_data,
+		              read_size,
+		              keyfile->offset + (off64_t) data_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read key data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 keyfile->offset + (off64_t) data_offset,
+			 keyfile->offset + (off64_t) data_offset );
+
+			goto on_error;
+		}
+		if( update_function(
+		     context,
+		     chunk_data,
+		     read_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update hash context.",
+			 function );
+
+			goto on_error;
+		}
+		data_offset += read_size;
+	}
+	if( finalize_function(
+	     context,
+	     hash,
+	     hash_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize hash context.",
+		 function );
+
+		goto on_error;
+	}
+	if( free_function(
+	     &context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free hash context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     chunk_data,
+	     0,
+	     LIBLUKSDE_KEYFILE_CHUNK_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( context != NULL )
+	{
+		free_function(
+		 &context,
+		 NULL );
+	}
+	memory_set(
+	 chunk_data,
+	 0,
+	 LIBLUKSDE_KEYFILE_CHUNK_SIZE );
+
+	return( -1 );
+}
+
+/* Retrieves the HMAC key of the key data of a keyfile
+ * HMAC uses the hash of a key that is larger than the hash block size instead of the key itself,
+ * hence a large keyfile is reduced to its hash without reading all the key data into memory
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_keyfile_get_hmac_key(
+     libluksde_keyfile_t *keyfile,
+     int hashing_method,
+     uint8_t *key,
+     size_t key_size,
+     size_t *key_length,
+     libcerror_error_t **error )
+{
+	libluksde_diffuser_hash_function_t hash_function = NULL;
+	static char *function                            = "libluksde_keyfile_get_hmac_key";
+	size_t block_size                                = 0;
+	size_t hash_size                                 = 0;
+
+	if( keyfile == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyfile.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_size < LIBLUKSDE_PASSWORD_MAXIMUM_BLOCK_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid key size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_length == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key length.",
+		 function );
+
+		return( -1 );
+	}
+	switch( hashing_method )
+	{
+		case LIBLUKSDE_HASHING_METHOD_SHA1:
+		case LIBLUKSDE_HASHING_METHOD_SHA224:
+		case LIBLUKSDE_HASHING_METHOD_SHA256:
+			block_size = 64;
+			break;
+
+		case LIBLUKSDE_HASHING_METHOD_SHA512:
+			block_size = 128;
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported hashing method.",
+			 function );
+
+			return( -1 );
+	}
+	if( keyfile->size <= (size64_t) block_size )
+	{
+		if( libluksde_keyfile_read_data(
+		     keyfile,
+		     key,
+		     (size_t) keyfile->size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read key data.",
+			 function );
+
+			return( -1 );
+		}
+		*key_length = (size_t) keyfile->size;
+
+		return( 1 );
+	}
+	if( libluksde_diffuser_get_hash_function(
+	     hashing_method,
+	     &hash_function,
+	     &hash_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve hash function.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_keyfile_calculate_hash(
+	     keyfile,
+	     hashing_method,
+	     key,
+	     hash_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate key data hash.",
+		 function );
+
+		return( -1 );
+	}
+	*key_length = hash_size;
+
+	return( 1 );
+}
+
+/* Updates a BLAKE2b context with the key data of a keyfile
+ * The key data is read in chunks so it does not need to be stored in memory
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_keyfile_update_blake2b_context(
+     libluksde_keyfile_t *keyfile,
+     libluksde_blake2b_context_t *blake2b_context,
+     libcerror_error_t **error )
+{
+	uint8_t chunk_data[ LIBLUKSDE_KEYFILE_CHUNK_SIZE ];
+
+	static char *function = "libluksde_keyfile_update_blake2b_context";
+	size64_t data_offset  = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+
+	if( keyfile == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyfile.",
+		 function );
+
+		return( -1 );
+	}
+	if( keyfile->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid keyfile - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < keyfile->size )
+	{
+		read_size = LIBLUKSDE_KEYFILE_CHUNK_SIZE;
+
+		if( read_size > ( keyfile->size - data_offset ) )
+		{
+			read_size = (size_t) ( keyfile->size - data_offset );
+		}
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              keyfile->file_io_handle,
+		              chunk_data,
+		              read_size,
+		              keyfile->offset + (off64_t) data_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read key data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 keyfile->offset + (off64_t) data_offset,
+			 keyfile->offset + (off64_t) data_offset );
+
+			goto on_error;
+		}
+		if( libluksde_blake2b_update(
+		     blake2b_context,
+		     chunk_data,
+		     read_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update BLAKE2b context.",
+			 function );
+
+			goto on_error;
+		}
+		data_offset += read_size;
+	}
+	if( memory_set(
+	     chunk_data,
+	     0,
+	     LIBLUKSDE_KEYFILE_CHUNK_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	memory_set(
+	 chunk_data,
+	 0,
+	 LIBLUKSDE_KEYFILE_CHUNK_SIZE );
+
+	return( -1 );
+}
+
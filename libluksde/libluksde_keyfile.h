@@ -0,0 +1,129 @@
+/*
+ * Keyfile functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_KEYFILE_H )
+#define _LIBLUKSDE_KEYFILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_blake2b.h"
+#include "libluksde_libbfio.h"
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libluksde_keyfile libluksde_keyfile_t;
+
+struct libluksde_keyfile
+{
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* Value to indicate if the file IO handle was created inside the library
+	 */
+	uint8_t file_io_handle_created_in_library;
+
+	/* Value to indicate if the file IO handle was opened inside the library
+	 */
+	uint8_t file_io_handle_opened_in_library;
+
+	/* The offset of the key data in the file
+	 */
+	off64_t offset;
+
+	/* The size of the key data
+	 */
+	size64_t size;
+};
+
+int libluksde_keyfile_initialize(
+     libluksde_keyfile_t **keyfile,
+     libcerror_error_t **error );
+
+int libluksde_keyfile_free(
+     libluksde_keyfile_t **keyfile,
+     libcerror_error_t **error );
+
+int libluksde_keyfile_open(
+     libluksde_keyfile_t *keyfile,
+     const char *filename,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+int libluksde_keyfile_open_wide(
+     libluksde_keyfile_t *keyfile,
+     const wchar_t *filename,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libluksde_keyfile_open_file_io_handle(
+     libluksde_keyfile_t *keyfile,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libluksde_keyfile_close(
+     libluksde_keyfile_t *keyfile,
+     libcerror_error_t **error );
+
+int libluksde_keyfile_read_data(
+     libluksde_keyfile_t *keyfile,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libluksde_keyfile_calculate_hash(
+     libluksde_keyfile_t *keyfile,
+     int hashing_method,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+int libluksde_keyfile_get_hmac_key(
+     libluksde_keyfile_t *keyfile,
+     int hashing_method,
+     uint8_t *key,
+     size_t key_size,
+     size_t *key_length,
+     libcerror_error_t **error );
+
+int libluksde_keyfile_update_blake2b_context(
+     libluksde_keyfile_t *keyfile,
+     libluksde_blake2b_context_t *blake2b_context,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_KEYFILE_H ) */
+
@@ -0,0 +1,522 @@
+/*
+ * Master key cache functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+#include "libluksde_libcnotify.h"
+#include "libluksde_libhmac.h"
+#include "libluksde_master_key_cache.h"
+
+#include "luksde_master_key_cache.h"
+
+const uint8_t luksde_master_key_cache_signature[ 8 ] = { 'L', 'U', 'K', 'S', 'D', 'E', 'M', 'K' };
+
+/* Creates a master key cache
+ * Make sure the value master_key_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_master_key_cache_initialize(
+     libluksde_master_key_cache_t **master_key_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_master_key_cache_initialize";
+
+	if( master_key_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid master key cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *master_key_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid master key cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*master_key_cache = memory_allocate_structure(
+	                     libluksde_master_key_cache_t );
+
+	if( *master_key_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create master key cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *master_key_cache,
+	     0,
+	     sizeof( libluksde_master_key_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear master key cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *master_key_cache != NULL )
+	{
+		memory_free(
+		 *master_key_cache );
+
+		*master_key_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a master key cache
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_master_key_cache_free(
+     libluksde_master_key_cache_t **master_key_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_master_key_cache_free";
+	int result            = 1;
+
+	if( master_key_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid master key cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *master_key_cache != NULL )
+	{
+		if( memory_set(
+		     ( *master_key_cache )->master_key,
+		     0,
+		     64 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear master key.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *master_key_cache );
+
+		*master_key_cache = NULL;
+	}
+	return( result );
+}
+
+/* Reads a master key cache
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_master_key_cache_read_data(
+     libluksde_master_key_cache_t *master_key_cache,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t checksum[ 32 ];
+
+	static char *function    = "libluksde_master_key_cache_read_data";
+	uint32_t format_version  = 0;
+	uint32_t master_key_size = 0;
+
+	if( master_key_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid master key cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( luksde_master_key_cache_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     ( (luksde_master_key_cache_t *) data )->signature,
+	     luksde_master_key_cache_signature,
+	     8 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (luksde_master_key_cache_t *) data )->format_version,
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (luksde_master_key_cache_t *) data )->master_key_size,
+	 master_key_size );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: format version\t\t\t: %" PRIu32 "\n",
+		 function,
+		 format_version );
+
+		libcnotify_printf(
+		 "%s: master key size\t\t\t: %" PRIu32 "\n",
+		 function,
+		 master_key_size );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	if( format_version != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version: %" PRIu32 ".",
+		 function,
+		 format_version );
+
+		goto on_error;
+	}
+	if( ( master_key_size != 16 )
+	 && ( master_key_size != 32 )
+	 && ( master_key_size != 64 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported master key size: %" PRIu32 ".",
+		 function,
+		 master_key_size );
+
+		goto on_error;
+	}
+	if( libhmac_sha256_calculate(
+	     data,
+	     sizeof( luksde_master_key_cache_t ) - 32,
+	     checksum,
+	     32,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     checksum,
+	     ( (luksde_master_key_cache_t *) data )->checksum,
+	     32 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+		 "%s: mismatch in checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     master_key_cache->volume_identifier,
+	     ( (luksde_master_key_cache_t *) data )->volume_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy volume identifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     master_key_cache->header_digest,
+	     ( (luksde_master_key_cache_t *) data )->header_digest,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy header digest.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     master_key_cache->master_key,
+	     ( (luksde_master_key_cache_t *) data )->master_key,
+	     64 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy master key.",
+		 function );
+
+		goto on_error;
+	}
+	master_key_cache->master_key_size = master_key_size;
+
+	memory_set(
+	 checksum,
+	 0,
+	 32 );
+
+	return( 1 );
+
+on_error:
+	memory_set(
+	 master_key_cache->master_key,
+	 0,
+	 64 );
+
+	master_key_cache->master_key_size = 0;
+
+	return( -1 );
+}
+
+/* Writes a master key cache
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_master_key_cache_write_data(
+     libluksde_master_key_cache_t *master_key_cache,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_master_key_cache_write_data";
+
+	if( master_key_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid master key cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( master_key_cache->master_key_size != 16 )
+	 && ( master_key_cache->master_key_size != 32 )
+	 && ( master_key_cache->master_key_size != 64 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid master key cache - unsupported master key size.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( luksde_master_key_cache_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     sizeof( luksde_master_key_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     ( (luksde_master_key_cache_t *) data )->signature,
+	     luksde_master_key_cache_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (luksde_master_key_cache_t *) data )->format_version,
+	 1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (luksde_master_key_cache_t *) data )->master_key_size,
+	 master_key_cache->master_key_size );
+
+	if( memory_copy(
+	     ( (luksde_master_key_cache_t *) data )->volume_identifier,
+	     master_key_cache->volume_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy volume identifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     ( (luksde_master_key_cache_t *) data )->header_digest,
+	     master_key_cache->header_digest,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy header digest.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     ( (luksde_master_key_cache_t *) data )->master_key,
+	     master_key_cache->master_key,
+	     (size_t) master_key_cache->master_key_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy master key.",
+		 function );
+
+		goto on_error;
+	}
+	if( libhmac_sha256_calculate(
+	     data,
+	     sizeof( luksde_master_key_cache_t ) - 32,
+	     ( (luksde_master_key_cache_t *) data )->checksum,
+	     32,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	memory_set(
+	 data,
+	 0,
+	 sizeof( luksde_master_key_cache_t ) );
+
+	return( -1 );
+}
+
@@ -0,0 +1,80 @@
+/*
+ * Master key cache functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_MASTER_KEY_CACHE_H )
+#define _LIBLUKSDE_MASTER_KEY_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libluksde_master_key_cache libluksde_master_key_cache_t;
+
+struct libluksde_master_key_cache
+{
+	/* The volume identifier
+	 */
+	uint8_t volume_identifier[ 16 ];
+
+	/* The header digest
+	 */
+	uint8_t header_digest[ 32 ];
+
+	/* The master key
+	 */
+	uint8_t master_key[ 64 ];
+
+	/* The master key size
+	 */
+	uint32_t master_key_size;
+};
+
+int libluksde_master_key_cache_initialize(
+     libluksde_master_key_cache_t **master_key_cache,
+     libcerror_error_t **error );
+
+int libluksde_master_key_cache_free(
+     libluksde_master_key_cache_t **master_key_cache,
+     libcerror_error_t **error );
+
+int libluksde_master_key_cache_read_data(
+     libluksde_master_key_cache_t *master_key_cache,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libluksde_master_key_cache_write_data(
+     libluksde_master_key_cache_t *master_key_cache,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_MASTER_KEY_CACHE_H ) */
+
@@ -27,10 +27,202 @@
 #include "libluksde_definitions.h"
 #include "libluksde_libcerror.h"
 #include "libluksde_libcnotify.h"
-#include "libluksde_libhmac.h"
 #include "libluksde_password.h"
+#include "libluksde_sha.h"
+
+/* Calculates a HMAC using precomputed inner and outer hash contexts
+ * The inner and outer contexts contain the hash state after the inner and
+ * outer padded key blocks were hashed. They are copied, hence they can be
+ * reused for every HMAC calculated with the same key
+ * The HMAC can be stored in the message buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_password_calculate_hmac(
+     const libluksde_sha_context_t *inner_context,
+     const libluksde_sha_context_t *outer_context,
+     const uint8_t *message,
+     size_t message_size,
+     uint8_t *hmac,
+     size_t hmac_size,
+     libcerror_error_t **error )
+{
+	libluksde_sha_context_t context;
+
+	uint8_t inner_hash[ LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE ];
+
+	static char *function = "libluksde_password_calculate_hmac";
+
+	if( inner_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid inner context.",
+		 function );
+
+		return( -1 );
+	}
+	if( outer_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid outer context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( inner_context->hash_size == 0 )
+	 || ( inner_context->hash_size > LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE )
+	 || ( inner_context->hash_size != outer_context->hash_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid inner context - hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( hmac == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid HMAC.",
+		 function );
+
+		return( -1 );
+	}
+	if( hmac_size != inner_context->hash_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid HMAC size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     &context,
+	     inner_context,
+	     sizeof( libluksde_sha_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy inner context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_sha_update(
+	     &context,
+	     message,
+	     message_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update inner context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_sha_finalize(
+	     &context,
+	     inner_hash,
+	     hmac_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize inner context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     &context,
+	     outer_context,
+	     sizeof( libluksde_sha_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy outer context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_sha_update(
+	     &context,
+	     inner_hash,
+	     hmac_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update outer context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_sha_finalize(
+	     &context,
+	     hmac,
+	     hmac_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize outer context.",
+		 function );
+
+		goto on_error;
+	}
+	memory_set(
+	 inner_hash,
+	 0,
+	 LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE );
+
+	return( 1 );
+
+on_error:
+	memory_set(
+	 &context,
+	 0,
+	 sizeof( libluksde_sha_context_t ) );
+
+	memory_set(
+	 inner_hash,
+	 0,
+	 LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE );
+
+	return( -1 );
+}
 
 /* Compute a PBKDF2-derived key from the given input.
+ * The inner and outer padded key blocks are hashed once, after which every
+ * iteration continues from copies of these hash states. An iteration therefore
+ * only hashes the previous iteration hash and the inner hash, which halves the
+ * number of compressed blocks compared to hashing the padded key blocks every time
  * Returns 1 if successful or -1 on error
  */
 int libluksde_password_pbkdf2(
@@ -44,20 +236,27 @@ int libluksde_password_pbkdf2(
      size_t output_data_size,
      libcerror_error_t **error )
 {
-	uint8_t block_buffer[ 64 ];
-	uint8_t hash_buffer[ 64 ];
+	libluksde_sha_context_t inner_context;
+	libluksde_sha_context_t outer_context;
+	libluksde_sha_context_t salted_inner_context;
+
+	uint8_t block_buffer[ LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE ];
+	uint8_t block_index_data[ 4 ];
+	uint8_t iteration_hash[ LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE ];
+	uint8_t key_hash[ LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE ];
+	uint8_t padded_key_block[ LIBLUKSDE_SHA_MAXIMUM_BLOCK_SIZE ];
 
-	uint8_t *data_buffer       = NULL;
+	const uint8_t *key         = NULL;
 	static char *function      = "libluksde_password_pbkdf2";
-	size_t data_buffer_size    = 0;
+	size_t block_size          = 0;
 	size_t hash_size           = 0;
+	size_t key_size            = 0;
 	size_t output_data_offset  = 0;
 	size_t remaining_data_size = 0;
 	uint32_t block_index       = 0;
 	uint32_t byte_index        = 0;
 	uint32_t number_of_blocks  = 0;
 	uint32_t password_iterator = 0;
-	int result                 = 0;
 
 	if( password == NULL )
 	{
@@ -81,33 +280,19 @@ int libluksde_password_pbkdf2(
 
 		return( -1 );
 	}
-	switch( password_hashing_method )
+	if( ( password_hashing_method != LIBLUKSDE_HASHING_METHOD_SHA1 )
+	 && ( password_hashing_method != LIBLUKSDE_HASHING_METHOD_SHA224 )
+	 && ( password_hashing_method != LIBLUKSDE_HASHING_METHOD_SHA256 )
+	 && ( password_hashing_method != LIBLUKSDE_HASHING_METHOD_SHA512 ) )
 	{
-		case LIBLUKSDE_HASHING_METHOD_SHA1:
-			hash_size = LIBHMAC_SHA1_HASH_SIZE;
-			break;
-
-		case LIBLUKSDE_HASHING_METHOD_SHA224:
-			hash_size = LIBHMAC_SHA224_HASH_SIZE;
-			break;
-
-		case LIBLUKSDE_HASHING_METHOD_SHA256:
-			hash_size = LIBHMAC_SHA256_HASH_SIZE;
-			break;
-
-		case LIBLUKSDE_HASHING_METHOD_SHA512:
-			hash_size = LIBHMAC_SHA512_HASH_SIZE;
-			break;
-
-		default:
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported password hashing method.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported password hashing method.",
+		 function );
 
-			return( -1 );
+		return( -1 );
 	}
 	if( salt == NULL )
 	{
@@ -167,45 +352,62 @@ int libluksde_password_pbkdf2(
 	if( memory_set(
 	     block_buffer,
 	     0,
-	     64 ) == NULL )
+	     LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to clear hash buffer.",
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block buffer.",
 		 function );
 
 		goto on_error;
 	}
 	if( memory_set(
-	     hash_buffer,
+	     output_data,
 	     0,
-	     64 ) == NULL )
+	     output_data_size ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to clear hash buffer.",
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear output data.",
 		 function );
 
 		goto on_error;
 	}
-	if( memory_set(
-	     output_data,
-	     0,
-	     output_data_size ) == NULL )
+	if( libluksde_sha_initialize(
+	     &inner_context,
+	     password_hashing_method,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to clear output data.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize inner context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_sha_initialize(
+	     &outer_context,
+	     password_hashing_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize outer context.",
 		 function );
 
 		goto on_error;
 	}
+	block_size = inner_context.block_size;
+	hash_size  = inner_context.hash_size;
+
 /* TODO add bounds check */
 	number_of_blocks    = output_data_size / hash_size;
 	remaining_data_size = output_data_size % hash_size;
@@ -214,51 +416,115 @@ int libluksde_password_pbkdf2(
 	{
 		number_of_blocks += 1;
 	}
-	data_buffer_size = salt_size + 4;
+	/* Keys larger than the block size are replaced by their hash
+	 */
+	if( password_length > block_size )
+	{
+		if( libluksde_sha_calculate(
+		     password_hashing_method,
+		     password,
+		     password_length,
+		     key_hash,
+		     hash_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to calculate key hash.",
+			 function );
 
-	if( data_buffer_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+			goto on_error;
+		}
+		key      = key_hash;
+		key_size = hash_size;
+	}
+	else
+	{
+		key      = password;
+		key_size = password_length;
+	}
+	for( byte_index = 0;
+	     byte_index < block_size;
+	     byte_index++ )
+	{
+		if( byte_index < key_size )
+		{
+			padded_key_block[ byte_index ] = key[ byte_index ] ^ 0x36;
+		}
+		else
+		{
+			padded_key_block[ byte_index ] = 0x36;
+		}
+	}
+	if( libluksde_sha_update(
+	     &inner_context,
+	     padded_key_block,
+	     block_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid data buffer size value exceeds maximum allocation size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update inner context with padded key block.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	data_buffer = (uint8_t *) memory_allocate(
-	                           sizeof( uint8_t ) * data_buffer_size );
-
-	if( data_buffer == NULL )
+	for( byte_index = 0;
+	     byte_index < block_size;
+	     byte_index++ )
+	{
+		padded_key_block[ byte_index ] ^= 0x36 ^ 0x5c;
+	}
+	if( libluksde_sha_update(
+	     &outer_context,
+	     padded_key_block,
+	     block_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create data buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update outer context with padded key block.",
 		 function );
 
 		goto on_error;
 	}
+	/* The salt is the same for every block and is therefore hashed once
+	 */
 	if( memory_copy(
-	     data_buffer,
-	     salt,
-	     salt_size ) == NULL )
+	     &salted_inner_context,
+	     &inner_context,
+	     sizeof( libluksde_sha_context_t ) ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_MEMORY,
 		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy salt into data buffer.",
+		 "%s: unable to copy inner context.",
 		 function );
 
 		goto on_error;
 	}
-	byte_stream_copy_from_uint32_big_endian(
-	 &( data_buffer[ salt_size ] ),
-	 0 );
+	if( libluksde_sha_update(
+	     &salted_inner_context,
+	     salt,
+	     salt_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update inner context with salt.",
+		 function );
 
+		goto on_error;
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -271,11 +537,11 @@ int libluksde_password_pbkdf2(
 		 0 );
 
 		libcnotify_printf(
-		 "%s: data buffer:\n",
+		 "%s: salt:\n",
 		 function );
 		libcnotify_print_data(
-		 data_buffer,
-		 data_buffer_size,
+		 salt,
+		 salt_size,
 		 0 );
 
 		libcnotify_printf(
@@ -283,6 +549,11 @@ int libluksde_password_pbkdf2(
 		 function,
 		 hash_size );
 
+		libcnotify_printf(
+		 "%s: block size\t\t\t\t\t: %" PRIzd "\n",
+		 function,
+		 block_size );
+
 		libcnotify_printf(
 		 "%s: number of iterations\t\t\t\t: %" PRIu32 "\n",
 		 function,
@@ -308,60 +579,17 @@ int libluksde_password_pbkdf2(
 	     block_index++ )
 	{
 		byte_stream_copy_from_uint32_big_endian(
-		 &( data_buffer[ salt_size ] ),
+		 block_index_data,
 		 block_index );
 
-		switch( password_hashing_method )
-		{
-			case LIBLUKSDE_HASHING_METHOD_SHA1:
-	                	result = libhmac_sha1_calculate_hmac(
-				          password,
-				          password_length,
-				          data_buffer,
-				          data_buffer_size,
-				          hash_buffer,
-				          hash_size,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA224:
-	                	result = libhmac_sha224_calculate_hmac(
-				          password,
-				          password_length,
-				          data_buffer,
-				          data_buffer_size,
-				          hash_buffer,
-				          hash_size,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA256:
-	                	result = libhmac_sha256_calculate_hmac(
-				          password,
-				          password_length,
-				          data_buffer,
-				          data_buffer_size,
-				          hash_buffer,
-				          hash_size,
-				          error );
-				break;
-
-			case LIBLUKSDE_HASHING_METHOD_SHA512:
-	                	result = libhmac_sha512_calculate_hmac(
-				          password,
-				          password_length,
-				          data_buffer,
-				          data_buffer_size,
-				          hash_buffer,
-				          hash_size,
-				          error );
-				break;
-
-			default:
-				result = 0;
-				break;
-		}
-		if( result != 1 )
+		if( libluksde_password_calculate_hmac(
+		     &salted_inner_context,
+		     &outer_context,
+		     block_index_data,
+		     4,
+		     iteration_hash,
+		     hash_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -375,14 +603,14 @@ int libluksde_password_pbkdf2(
 		}
 		if( memory_copy(
 		     block_buffer,
-		     hash_buffer,
+		     iteration_hash,
 		     hash_size ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_MEMORY,
 			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy hash buffer into block buffer.",
+			 "%s: unable to copy initial hmac into block buffer.",
 			 function );
 
 			goto on_error;
@@ -391,63 +619,22 @@ int libluksde_password_pbkdf2(
 		     password_iterator < number_of_iterations;
 		     password_iterator++ )
 		{
-			switch( password_hashing_method )
-			{
-				case LIBLUKSDE_HASHING_METHOD_SHA1:
-					result = libhmac_sha1_calculate_hmac(
-					          password,
-					          password_length,
-					          hash_buffer,
-					          hash_size,
-					          hash_buffer,
-					          hash_size,
-					          error );
-					break;
-
-				case LIBLUKSDE_HASHING_METHOD_SHA224:
-					result = libhmac_sha224_calculate_hmac(
-					          password,
-					          password_length,
-					          hash_buffer,
-					          hash_size,
-					          hash_buffer,
-					          hash_size,
-					          error );
-					break;
-
-				case LIBLUKSDE_HASHING_METHOD_SHA256:
-					result = libhmac_sha256_calculate_hmac(
-					          password,
-					          password_length,
-					          hash_buffer,
-					          hash_size,
-					          hash_buffer,
-					          hash_size,
-					          error );
-					break;
-
-				case LIBLUKSDE_HASHING_METHOD_SHA512:
-					result = libhmac_sha512_calculate_hmac(
-					          password,
-					          password_length,
-					          hash_buffer,
-					          hash_size,
-					          hash_buffer,
-					          hash_size,
-					          error );
-					break;
-
-				default:
-					result = 0;
-					break;
-			}
-			if( result != 1 )
+			/* The previous iteration hash is replaced by its HMAC
+			 */
+			if( libluksde_password_calculate_hmac(
+			     &inner_context,
+			     &outer_context,
+			     iteration_hash,
+			     hash_size,
+			     iteration_hash,
+			     hash_size,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to compute initial hmac for block %d.",
+				 "%s: unable to compute hmac for block %d.",
 				 function,
 				 block_index );
 
@@ -457,7 +644,7 @@ int libluksde_password_pbkdf2(
 			     byte_index < hash_size;
 			     byte_index++ )
 			{
-				block_buffer[ byte_index ] ^= hash_buffer[ byte_index ];
+				block_buffer[ byte_index ] ^= iteration_hash[ byte_index ];
 			}
 		}
 		if( hash_size > output_data_size )
@@ -481,19 +668,80 @@ int libluksde_password_pbkdf2(
 		output_data_offset += hash_size;
 		output_data_size   -= hash_size;
 	}
-	if( data_buffer != NULL )
-	{
-		memory_free(
-		 data_buffer );
-	}
+	/* Clear the key derived data
+	 */
+	memory_set(
+	 &inner_context,
+	 0,
+	 sizeof( libluksde_sha_context_t ) );
+
+	memory_set(
+	 &outer_context,
+	 0,
+	 sizeof( libluksde_sha_context_t ) );
+
+	memory_set(
+	 &salted_inner_context,
+	 0,
+	 sizeof( libluksde_sha_context_t ) );
+
+	memory_set(
+	 padded_key_block,
+	 0,
+	 LIBLUKSDE_SHA_MAXIMUM_BLOCK_SIZE );
+
+	memory_set(
+	 key_hash,
+	 0,
+	 LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE );
+
+	memory_set(
+	 iteration_hash,
+	 0,
+	 LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE );
+
+	memory_set(
+	 block_buffer,
+	 0,
+	 LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE );
+
 	return( 1 );
 
 on_error:
-	if( data_buffer != NULL )
-	{
-		memory_free(
-		 data_buffer );
-	}
+	memory_set(
+	 &inner_context,
+	 0,
+	 sizeof( libluksde_sha_context_t ) );
+
+	memory_set(
+	 &outer_context,
+	 0,
+	 sizeof( libluksde_sha_context_t ) );
+
+	memory_set(
+	 &salted_inner_context,
+	 0,
+	 sizeof( libluksde_sha_context_t ) );
+
+	memory_set(
+	 padded_key_block,
+	 0,
+	 LIBLUKSDE_SHA_MAXIMUM_BLOCK_SIZE );
+
+	memory_set(
+	 key_hash,
+	 0,
+	 LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE );
+
+	memory_set(
+	 iteration_hash,
+	 0,
+	 LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE );
+
+	memory_set(
+	 block_buffer,
+	 0,
+	 LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE );
+
 	return( -1 );
 }
-
@@ -26,11 +26,25 @@
 #include <types.h>
 
 #include "libluksde_libcerror.h"
+#include "libluksde_sha.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The largest supported hash block size (SHA-512)
+ */
+#define LIBLUKSDE_PASSWORD_MAXIMUM_BLOCK_SIZE		128
+
+int libluksde_password_calculate_hmac(
+     const libluksde_sha_context_t *inner_context,
+     const libluksde_sha_context_t *outer_context,
+     const uint8_t *message,
+     size_t message_size,
+     uint8_t *hmac,
+     size_t hmac_size,
+     libcerror_error_t **error );
+
 int libluksde_password_pbkdf2(
      const uint8_t *password,
      size_t password_length,
@@ -0,0 +1,696 @@
+/*
+ * Read queue functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+#include "libluksde_libcnotify.h"
+#include "libluksde_libcthreads.h"
+#include "libluksde_read_queue.h"
+#include "libluksde_read_request.h"
+#include "libluksde_types.h"
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+
+/* Creates a read queue
+ * Make sure the value read_queue is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_read_queue_initialize(
+     libluksde_read_queue_t **read_queue,
+     libluksde_volume_t *volume,
+     int (*read_function)(
+            libluksde_volume_t *volume,
+            libluksde_read_request_t *read_request,
+            libcerror_error_t **error ),
+     int number_of_threads,
+     int maximum_number_of_read_requests,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_read_queue_initialize";
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_queue != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read queue value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read function.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of threads value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_read_requests <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of read requests value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*read_queue = memory_allocate_structure(
+	               libluksde_read_queue_t );
+
+	if( *read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_queue,
+	     0,
+	     sizeof( libluksde_read_queue_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read queue.",
+		 function );
+
+		memory_free(
+		 *read_queue );
+
+		*read_queue = NULL;
+
+		return( -1 );
+	}
+	( *read_queue )->volume        = volume;
+	( *read_queue )->read_function = read_function;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_queue )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *read_queue )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	/* The thread pool push blocks when the maximum number of read requests are queued
+	 */
+	if( libcthreads_thread_pool_create(
+	     &( ( *read_queue )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     maximum_number_of_read_requests,
+	     (int (*)(intptr_t *, void *)) &libluksde_read_queue_process_read_request,
+	     (void *) *read_queue,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *read_queue != NULL )
+	{
+		if( ( *read_queue )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *read_queue )->condition ),
+			 NULL );
+		}
+		if( ( *read_queue )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *read_queue )->mutex ),
+			 NULL );
+		}
+		memory_free(
+		 *read_queue );
+
+		*read_queue = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read queue
+ * Waits for the queued read requests to be processed and delivered
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_read_queue_free(
+     libluksde_read_queue_t **read_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_read_queue_free";
+	int result            = 1;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_queue != NULL )
+	{
+		if( ( *read_queue )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *read_queue )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *read_queue )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *read_queue )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *read_queue );
+
+		*read_queue = NULL;
+	}
+	return( result );
+}
+
+/* Pushes a read request onto the read queue
+ * The read queue takes over management of the read request
+ * This function blocks when the maximum number of read requests are queued
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_read_queue_push_read_request(
+     libluksde_read_queue_t *read_queue,
+     libluksde_read_request_t *read_request,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_read_queue_push_read_request";
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	read_queue->number_of_pending_read_requests += 1;
+
+	if( libcthreads_mutex_release(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_pool_push(
+	     read_queue->thread_pool,
+	     (intptr_t *) read_request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push read request onto thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( libcthreads_mutex_grab(
+	     read_queue->mutex,
+	     NULL ) == 1 )
+	{
+		read_queue->number_of_pending_read_requests -= 1;
+
+		libcthreads_mutex_release(
+		 read_queue->mutex,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Waits until all pushed read requests have been delivered
+ * This function must not be called from a read request callback function
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_read_queue_wait(
+     libluksde_read_queue_t *read_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_read_queue_wait";
+	int result            = 1;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( read_queue->number_of_pending_read_requests > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     read_queue->condition,
+		     read_queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Processes a read request
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_read_queue_process_read_request(
+     libluksde_read_request_t *read_request,
+     libluksde_read_queue_t *read_queue )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libluksde_read_queue_process_read_request";
+
+	if( read_request == NULL )
+	{
+		return( -1 );
+	}
+	if( read_queue == NULL )
+	{
+		libluksde_read_request_free(
+		 &read_request,
+		 NULL );
+
+		return( -1 );
+	}
+	if( read_queue->read_function(
+	     read_queue->volume,
+	     read_request,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 read_request->offset,
+		 read_request->offset );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		read_request->read_count = -1;
+	}
+	if( libluksde_read_queue_complete_read_request(
+	     read_queue,
+	     read_request,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to complete read request.",
+		 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Completes a read request
+ * The completed read requests are delivered in batches by a single thread at a time,
+ * hence the callback functions are never called concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_read_queue_complete_read_request(
+     libluksde_read_queue_t *read_queue,
+     libluksde_read_request_t *read_request,
+     libcerror_error_t **error )
+{
+	libluksde_read_request_t *completed_read_request = NULL;
+	libluksde_read_request_t *next_read_request      = NULL;
+	static char *function                            = "libluksde_read_queue_complete_read_request";
+	int number_of_delivered_read_requests            = 0;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	read_request->next_read_request = NULL;
+
+	if( read_queue->last_completed_read_request == NULL )
+	{
+		read_queue->first_completed_read_request = read_request;
+	}
+	else
+	{
+		read_queue->last_completed_read_request->next_read_request = read_request;
+	}
+	read_queue->last_completed_read_request = read_request;
+
+	/* Another thread is delivering and will pick up the read request
+	 */
+	if( read_queue->is_delivering != 0 )
+	{
+		if( libcthreads_mutex_release(
+		     read_queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	read_queue->is_delivering = 1;
+
+	while( read_queue->is_delivering != 0 )
+	{
+		completed_read_request = read_queue->first_completed_read_request;
+
+		read_queue->first_completed_read_request = NULL;
+		read_queue->last_completed_read_request  = NULL;
+
+		if( completed_read_request == NULL )
+		{
+			read_queue->is_delivering = 0;
+		}
+		if( libcthreads_mutex_release(
+		     read_queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( completed_read_request == NULL )
+		{
+			break;
+		}
+		number_of_delivered_read_requests = 0;
+
+		while( completed_read_request != NULL )
+		{
+			next_read_request = completed_read_request->next_read_request;
+
+			completed_read_request->callback_function(
+			 read_queue->volume,
+			 completed_read_request->buffer,
+			 completed_read_request->read_count,
+			 completed_read_request->user_data );
+
+			libluksde_read_request_free(
+			 &completed_read_request,
+			 NULL );
+
+			completed_read_request = next_read_request;
+
+			number_of_delivered_read_requests++;
+		}
+		if( libcthreads_mutex_grab(
+		     read_queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		read_queue->number_of_pending_read_requests -= number_of_delivered_read_requests;
+
+		if( libcthreads_condition_broadcast(
+		     read_queue->condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			read_queue->is_delivering = 0;
+
+			libcthreads_mutex_release(
+			 read_queue->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,125 @@
+/*
+ * Read queue functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_READ_QUEUE_H )
+#define _LIBLUKSDE_READ_QUEUE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+#include "libluksde_libcthreads.h"
+#include "libluksde_read_request.h"
+#include "libluksde_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+
+typedef struct libluksde_read_queue libluksde_read_queue_t;
+
+struct libluksde_read_queue
+{
+	/* The volume
+	 */
+	libluksde_volume_t *volume;
+
+	/* The function that reads the data of a read request
+	 */
+	int (*read_function)(
+	       libluksde_volume_t *volume,
+	       libluksde_read_request_t *read_request,
+	       libcerror_error_t **error );
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex
+	 * Protects the completed read requests and the number of pending read requests
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition
+	 * Signalled when completed read requests have been delivered
+	 */
+	libcthreads_condition_t *condition;
+
+	/* The first completed read request
+	 */
+	libluksde_read_request_t *first_completed_read_request;
+
+	/* The last completed read request
+	 */
+	libluksde_read_request_t *last_completed_read_request;
+
+	/* The number of read requests that were pushed but not yet delivered
+	 */
+	int number_of_pending_read_requests;
+
+	/* Value to indicate a thread is delivering the completed read requests
+	 */
+	uint8_t is_delivering;
+};
+
+int libluksde_read_queue_initialize(
+     libluksde_read_queue_t **read_queue,
+     libluksde_volume_t *volume,
+     int (*read_function)(
+            libluksde_volume_t *volume,
+            libluksde_read_request_t *read_request,
+            libcerror_error_t **error ),
+     int number_of_threads,
+     int maximum_number_of_read_requests,
+     libcerror_error_t **error );
+
+int libluksde_read_queue_free(
+     libluksde_read_queue_t **read_queue,
+     libcerror_error_t **error );
+
+int libluksde_read_queue_push_read_request(
+     libluksde_read_queue_t *read_queue,
+     libluksde_read_request_t *read_request,
+     libcerror_error_t **error );
+
+int libluksde_read_queue_wait(
+     libluksde_read_queue_t *read_queue,
+     libcerror_error_t **error );
+
+int libluksde_read_queue_process_read_request(
+     libluksde_read_request_t *read_request,
+     libluksde_read_queue_t *read_queue );
+
+int libluksde_read_queue_complete_read_request(
+     libluksde_read_queue_t *read_queue,
+     libluksde_read_request_t *read_request,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_READ_QUEUE_H ) */
+
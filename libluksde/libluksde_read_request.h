@@ -0,0 +1,96 @@
+/*
+ * Read request functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_READ_REQUEST_H )
+#define _LIBLUKSDE_READ_REQUEST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+#include "libluksde_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libluksde_read_request libluksde_read_request_t;
+
+struct libluksde_read_request
+{
+	/* The buffer
+	 */
+	void *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The number of bytes read
+	 * Contains -1 if the read failed
+	 */
+	ssize_t read_count;
+
+	/* The callback function that is called when the read has completed
+	 */
+	void (*callback_function)(
+	       libluksde_volume_t *volume,
+	       void *buffer,
+	       ssize_t read_count,
+	       void *user_data );
+
+	/* The user data that is passed to the callback function
+	 */
+	void *user_data;
+
+	/* The next read request
+	 * Used to link the completed read requests
+	 */
+	libluksde_read_request_t *next_read_request;
+};
+
+int libluksde_read_request_initialize(
+     libluksde_read_request_t **read_request,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+            libluksde_volume_t *volume,
+            void *buffer,
+            ssize_t read_count,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error );
+
+int libluksde_read_request_free(
+     libluksde_read_request_t **read_request,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_READ_REQUEST_H ) */
+
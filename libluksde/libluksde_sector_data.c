@@ -26,10 +26,12 @@
 
 #include "libluksde_definitions.h"
 #include "libluksde_encryption_context.h"
+#include "libluksde_io_callbacks.h"
 #include "libluksde_libbfio.h"
 #include "libluksde_libcerror.h"
 #include "libluksde_libcnotify.h"
 #include "libluksde_sector_data.h"
+#include "libluksde_types.h"
 
 /* Creates sector data
  * Make sure the value sector_data is referencing, is set to NULL
@@ -187,11 +189,14 @@ int libluksde_sector_data_free(
 }
 
 /* Reads sector data
+ * The data is not decrypted if no encryption context is provided
+ * The data is read using the I/O callbacks if provided, otherwise using the file IO handle
  * Returns 1 if successful or -1 on error
  */
 int libluksde_sector_data_read_file_io_handle(
      libluksde_sector_data_t *sector_data,
      libbfio_handle_t *file_io_handle,
+     const libluksde_io_callbacks_t *io_callbacks,
      off64_t file_offset,
      libluksde_encryption_context_t *encryption_context,
      uint64_t sector_number,
@@ -223,6 +228,43 @@ int libluksde_sector_data_read_file_io_handle(
 
 		return( -1 );
 	}
+	if( encryption_context == NULL )
+	{
+		if( io_callbacks != NULL )
+		{
+			read_count = libluksde_io_callbacks_read_buffer_at_offset(
+			              io_callbacks,
+			              sector_data->data,
+			              sector_data->data_size,
+			              file_offset,
+			              error );
+		}
+		else
+		{
+			read_count = libbfio_handle_read_buffer_at_offset(
+			              file_io_handle,
+			              sector_data->data,
+			              sector_data->data_size,
+			              file_offset,
+			              error );
+		}
+
+		if( read_count != (ssize_t) sector_data->data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sector: %" PRIu64 " data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 sector_number,
+			 file_offset,
+			 file_offset );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
 	encrypted_data = (uint8_t *) memory_allocate(
 	                              sizeof( uint8_t ) * sector_data->data_size );
 
@@ -248,12 +290,24 @@ int libluksde_sector_data_read_file_io_handle(
 		 file_offset );
 	}
 #endif
-	read_count = libbfio_handle_read_buffer_at_offset(
-	              file_io_handle,
-	              encrypted_data,
-	              sector_data->data_size,
-	              file_offset,
-	              error );
+	if( io_callbacks != NULL )
+	{
+		read_count = libluksde_io_callbacks_read_buffer_at_offset(
+		              io_callbacks,
+		              encrypted_data,
+		              sector_data->data_size,
+		              file_offset,
+		              error );
+	}
+	else
+	{
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              encrypted_data,
+		              sector_data->data_size,
+		              file_offset,
+		              error );
+	}
 
 	if( read_count != (ssize_t) sector_data->data_size )
 	{
@@ -28,6 +28,7 @@
 #include "libluksde_encryption_context.h"
 #include "libluksde_libbfio.h"
 #include "libluksde_libcerror.h"
+#include "libluksde_types.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -58,6 +59,7 @@ int libluksde_sector_data_free(
 int libluksde_sector_data_read_file_io_handle(
      libluksde_sector_data_t *sector_data,
      libbfio_handle_t *file_io_handle,
+     const libluksde_io_callbacks_t *io_callbacks,
      off64_t file_offset,
      libluksde_encryption_context_t *encryption_context,
      uint64_t sector_number,
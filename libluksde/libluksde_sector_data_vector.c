@@ -25,12 +25,15 @@
 
 #include "libluksde_definitions.h"
 #include "libluksde_encryption_context.h"
+#include "libluksde_io_callbacks.h"
+#include "libluksde_io_uring.h"
 #include "libluksde_libbfio.h"
 #include "libluksde_libcerror.h"
 #include "libluksde_libcnotify.h"
 #include "libluksde_libfcache.h"
 #include "libluksde_sector_data.h"
 #include "libluksde_sector_data_vector.h"
+#include "libluksde_types.h"
 
 /* Creates a sector data vector
  * Make sure the value sector data vector is referencing, is set to NULL
@@ -38,9 +41,10 @@
  */
 int libluksde_sector_data_vector_initialize(
      libluksde_sector_data_vector_t **sector_data_vector,
-     uint16_t bytes_per_sector,
+     uint32_t bytes_per_sector,
      off64_t data_offset,
      size64_t data_size,
+     uint64_t initialization_vector_tweak,
      libcerror_error_t **error )
 {
 	static char *function = "libluksde_sector_data_vector_initialize";
@@ -78,7 +82,9 @@ int libluksde_sector_data_vector_initialize(
 
 		return( -1 );
 	}
-	if( bytes_per_sector == 0 )
+	if( ( bytes_per_sector < 512 )
+	 || ( bytes_per_sector > 4096 )
+	 || ( ( bytes_per_sector & ( bytes_per_sector - 1 ) ) != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -144,9 +150,10 @@ int libluksde_sector_data_vector_initialize(
 
 		goto on_error;
 	}
-	( *sector_data_vector )->bytes_per_sector = bytes_per_sector;
-	( *sector_data_vector )->data_offset      = data_offset;
-	( *sector_data_vector )->data_size        = data_size;
+	( *sector_data_vector )->bytes_per_sector            = bytes_per_sector;
+	( *sector_data_vector )->data_offset                 = data_offset;
+	( *sector_data_vector )->data_size                   = data_size;
+	( *sector_data_vector )->initialization_vector_tweak = initialization_vector_tweak;
 
 	return( 1 );
 
@@ -206,11 +213,13 @@ int libluksde_sector_data_vector_free(
 }
 
 /* Reads sector data at a specific offset
+ * The sector data is read using the I/O callbacks if provided, otherwise using the file IO handle
  * Returns 1 if successful or -1 on error
  */
 int libluksde_sector_data_vector_get_sector_data_at_offset(
      libluksde_sector_data_vector_t *sector_data_vector,
      libbfio_handle_t *file_io_handle,
+     const libluksde_io_callbacks_t *io_callbacks,
      libluksde_encryption_context_t *encryption_context,
      off64_t offset,
      libluksde_sector_data_t **sector_data,
@@ -310,12 +319,16 @@ int libluksde_sector_data_vector_get_sector_data_at_offset(
 
 			goto on_error;
 		}
+		/* The initialization vector is based on the sector number in 512-byte units
+		 * regardless of the sector size, as dm-crypt does for LUKS2
+		 */
 		sector_data_offset = sector_data_vector->data_offset + offset;
-		sector_number      = (uint64_t) offset / sector_data_vector->bytes_per_sector;
+		sector_number      = sector_data_vector->initialization_vector_tweak + ( (uint64_t) offset / 512 );
 
 		if( libluksde_sector_data_read_file_io_handle(
 		     safe_sector_data,
 		     file_io_handle,
+		     io_callbacks,
 		     sector_data_offset,
 		     encryption_context,
 		     sector_number,
@@ -367,3 +380,795 @@ on_error:
 	return( -1 );
 }
 
+/* Reads consecutive sectors at a specific offset into a buffer
+ * The sectors are read from the file IO handle at once and decrypted into the buffer,
+ * they are not stored in the cache
+ * The sectors are read using the I/O callbacks if provided, otherwise using the io_uring
+ * if provided, otherwise using the file IO handle
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libluksde_sector_data_vector_read_sectors_at_offset(
+         libluksde_sector_data_vector_t *sector_data_vector,
+         libbfio_handle_t *file_io_handle,
+         const libluksde_io_callbacks_t *io_callbacks,
+         libluksde_io_uring_t *io_uring,
+         libluksde_encryption_context_t *encryption_context,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	uint8_t *encrypted_data = NULL;
+	static char *function   = "libluksde_sector_data_vector_read_sectors_at_offset";
+	ssize_t read_count      = 0;
+
+	if( ( io_callbacks == NULL )
+	 && ( io_uring != NULL ) )
+	{
+		read_count = libluksde_sector_data_vector_read_sectors_with_io_uring(
+		              sector_data_vector,
+		              io_uring,
+		              encryption_context,
+		              offset,
+		              buffer,
+		              buffer_size,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sectors data using io_uring.",
+			 function );
+
+			return( -1 );
+		}
+		return( read_count );
+	}
+	if( encryption_context == NULL )
+	{
+		read_count = libluksde_sector_data_vector_read_encrypted_sectors_at_offset(
+		              sector_data_vector,
+		              file_io_handle,
+		              io_callbacks,
+		              offset,
+		              buffer,
+		              buffer_size,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sectors data.",
+			 function );
+
+			return( -1 );
+		}
+		return( read_count );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	encrypted_data = (uint8_t *) memory_allocate(
+	                              sizeof( uint8_t ) * buffer_size );
+
+	if( encrypted_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create encrypted data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libluksde_sector_data_vector_read_encrypted_sectors_at_offset(
+	              sector_data_vector,
+	              file_io_handle,
+	              io_callbacks,
+	              offset,
+	              encrypted_data,
+	              buffer_size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read encrypted sectors data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_sector_data_vector_decrypt_sectors_at_offset(
+	     sector_data_vector,
+	     encryption_context,
+	     offset,
+	     encrypted_data,
+	     buffer_size,
+	     buffer,
+	     buffer_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to decrypt sectors data.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 encrypted_data );
+
+	return( (ssize_t) buffer_size );
+
+on_error:
+	if( encrypted_data != NULL )
+	{
+		memory_free(
+		 encrypted_data );
+	}
+	return( -1 );
+}
+
+/* Reads consecutive sectors at a specific offset into a buffer using io_uring
+ * The sectors are read in chunks of the size of the io_uring fixed buffers,
+ * all the chunks are read concurrently and every chunk is decrypted into
+ * the buffer as soon as it has been read, while the reads of the other
+ * chunks are still outstanding
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libluksde_sector_data_vector_read_sectors_with_io_uring(
+         libluksde_sector_data_vector_t *sector_data_vector,
+         libluksde_io_uring_t *io_uring,
+         libluksde_encryption_context_t *encryption_context,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	size_t chunk_buffer_offsets[ LIBLUKSDE_IO_URING_NUMBER_OF_BUFFERS ];
+	size_t chunk_read_sizes[ LIBLUKSDE_IO_URING_NUMBER_OF_BUFFERS ];
+	size_t chunk_sizes[ LIBLUKSDE_IO_URING_NUMBER_OF_BUFFERS ];
+
+	uint8_t *chunk_data        = NULL;
+	static char *function      = "libluksde_sector_data_vector_read_sectors_with_io_uring";
+	size_t buffer_offset       = 0;
+	size_t chunk_data_size     = 0;
+	size_t chunk_size          = 0;
+	ssize_t read_count         = 0;
+	off64_t sector_data_offset = 0;
+	int buffer_index           = 0;
+	int number_of_buffers      = 0;
+
+	if( sector_data_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_data_vector->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sector data vector - bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_uring->number_of_buffers <= 0 )
+	 || ( io_uring->number_of_buffers > LIBLUKSDE_IO_URING_NUMBER_OF_BUFFERS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid io_uring - number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_uring->buffer_size == 0 )
+	 || ( ( io_uring->buffer_size % sector_data_vector->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid io_uring - buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= sector_data_vector->data_size )
+	 || ( ( offset % sector_data_vector->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE )
+	 || ( ( buffer_size % sector_data_vector->bytes_per_sector ) != 0 )
+	 || ( (size64_t) buffer_size > ( sector_data_vector->data_size - offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	sector_data_offset = sector_data_vector->data_offset + offset;
+	number_of_buffers  = io_uring->number_of_buffers;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading %" PRIzd " bytes of sectors data at offset: %" PRIi64 " (0x%08" PRIx64 ") using io_uring\n",
+		 function,
+		 buffer_size,
+		 sector_data_offset,
+		 sector_data_offset );
+	}
+#endif
+	/* Fill every fixed buffer with a read of the next chunk
+	 */
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( buffer_offset >= buffer_size )
+		{
+			break;
+		}
+		chunk_size = buffer_size - buffer_offset;
+
+		if( chunk_size > io_uring->buffer_size )
+		{
+			chunk_size = io_uring->buffer_size;
+		}
+		if( libluksde_io_uring_queue_read(
+		     io_uring,
+		     buffer_index,
+		     0,
+		     sector_data_offset + (off64_t) buffer_offset,
+		     chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to queue read of chunk at offset: %" PRIzd ".",
+			 function,
+			 buffer_offset );
+
+			goto on_error;
+		}
+		chunk_buffer_offsets[ buffer_index ] = buffer_offset;
+		chunk_read_sizes[ buffer_index ]     = 0;
+		chunk_sizes[ buffer_index ]          = chunk_size;
+
+		buffer_offset += chunk_size;
+	}
+	if( libluksde_io_uring_submit(
+	     io_uring,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to submit reads.",
+		 function );
+
+		goto on_error;
+	}
+	while( io_uring->number_of_pending_reads > 0 )
+	{
+		if( libluksde_io_uring_get_completion(
+		     io_uring,
+		     &buffer_index,
+		     &read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to retrieve completed read.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( buffer_index < 0 )
+		 || ( buffer_index >= number_of_buffers ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid buffer index value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		/* A read that returns 0 bytes indicates the file is smaller than the sectors data
+		 */
+		if( ( read_count <= 0 )
+		 || ( (size_t) read_count > ( chunk_sizes[ buffer_index ] - chunk_read_sizes[ buffer_index ] ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sectors data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 sector_data_offset + (off64_t) chunk_buffer_offsets[ buffer_index ],
+			 sector_data_offset + (off64_t) chunk_buffer_offsets[ buffer_index ] );
+
+			goto on_error;
+		}
+		chunk_read_sizes[ buffer_index ] += (size_t) read_count;
+
+		if( chunk_read_sizes[ buffer_index ] < chunk_sizes[ buffer_index ] )
+		{
+			/* Read the remainder of a short read into the same buffer
+			 */
+			if( libluksde_io_uring_queue_read(
+			     io_uring,
+			     buffer_index,
+			     chunk_read_sizes[ buffer_index ],
+			     sector_data_offset + (off64_t) ( chunk_buffer_offsets[ buffer_index ] + chunk_read_sizes[ buffer_index ] ),
+			     chunk_sizes[ buffer_index ] - chunk_read_sizes[ buffer_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to queue read of remainder of chunk at offset: %" PRIzd ".",
+				 function,
+				 chunk_buffer_offsets[ buffer_index ] );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			if( libluksde_io_uring_get_buffer(
+			     io_uring,
+			     buffer_index,
+			     &chunk_data,
+			     &chunk_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve buffer: %d.",
+				 function,
+				 buffer_index );
+
+				goto on_error;
+			}
+			/* The chunk is decrypted while the reads of the other chunks are outstanding
+			 */
+			if( libluksde_sector_data_vector_decrypt_sectors_at_offset(
+			     sector_data_vector,
+			     encryption_context,
+			     offset + (off64_t) chunk_buffer_offsets[ buffer_index ],
+			     chunk_data,
+			     chunk_sizes[ buffer_index ],
+			     &( buffer[ chunk_buffer_offsets[ buffer_index ] ] ),
+			     chunk_sizes[ buffer_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to decrypt chunk at offset: %" PRIzd ".",
+				 function,
+				 chunk_buffer_offsets[ buffer_index ] );
+
+				goto on_error;
+			}
+			if( buffer_offset >= buffer_size )
+			{
+				continue;
+			}
+			/* Reuse the buffer for a read of the next chunk
+			 */
+			chunk_size = buffer_size - buffer_offset;
+
+			if( chunk_size > io_uring->buffer_size )
+			{
+				chunk_size = io_uring->buffer_size;
+			}
+			if( libluksde_io_uring_queue_read(
+			     io_uring,
+			     buffer_index,
+			     0,
+			     sector_data_offset + (off64_t) buffer_offset,
+			     chunk_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to queue read of chunk at offset: %" PRIzd ".",
+				 function,
+				 buffer_offset );
+
+				goto on_error;
+			}
+			chunk_buffer_offsets[ buffer_index ] = buffer_offset;
+			chunk_read_sizes[ buffer_index ]     = 0;
+			chunk_sizes[ buffer_index ]          = chunk_size;
+
+			buffer_offset += chunk_size;
+		}
+		if( libluksde_io_uring_submit(
+		     io_uring,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to submit reads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( (ssize_t) buffer_size );
+
+on_error:
+	/* The fixed buffers cannot be reused while reads into them are outstanding
+	 */
+	libluksde_io_uring_wait_for_pending_reads(
+	 io_uring,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Reads the encrypted data of consecutive sectors at a specific offset
+ * The sectors are read using the I/O callbacks if provided, otherwise using the file IO handle
+ * This function does not use the cache or the encryption context and can be called
+ * concurrently as long as every thread uses its own file IO handle
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libluksde_sector_data_vector_read_encrypted_sectors_at_offset(
+         libluksde_sector_data_vector_t *sector_data_vector,
+         libbfio_handle_t *file_io_handle,
+         const libluksde_io_callbacks_t *io_callbacks,
+         off64_t offset,
+         uint8_t *encrypted_data,
+         size_t encrypted_data_size,
+         libcerror_error_t **error )
+{
+	static char *function      = "libluksde_sector_data_vector_read_encrypted_sectors_at_offset";
+	ssize_t read_count         = 0;
+	off64_t sector_data_offset = 0;
+
+	if( sector_data_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_data_vector->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sector data vector - bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= sector_data_vector->data_size )
+	 || ( ( offset % sector_data_vector->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( encrypted_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encrypted data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( encrypted_data_size == 0 )
+	 || ( encrypted_data_size > (size_t) LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE )
+	 || ( ( encrypted_data_size % sector_data_vector->bytes_per_sector ) != 0 )
+	 || ( (size64_t) encrypted_data_size > ( sector_data_vector->data_size - offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid encrypted data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	sector_data_offset = sector_data_vector->data_offset + offset;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading %" PRIzd " bytes of sectors data at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 encrypted_data_size,
+		 sector_data_offset,
+		 sector_data_offset );
+	}
+#endif
+	if( io_callbacks != NULL )
+	{
+		read_count = libluksde_io_callbacks_read_buffer_at_offset(
+		              io_callbacks,
+		              encrypted_data,
+		              encrypted_data_size,
+		              sector_data_offset,
+		              error );
+	}
+	else
+	{
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              encrypted_data,
+		              encrypted_data_size,
+		              sector_data_offset,
+		              error );
+	}
+	if( read_count != (ssize_t) encrypted_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sectors data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 sector_data_offset,
+		 sector_data_offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Decrypts the encrypted data of consecutive sectors at a specific offset into a buffer
+ * The data is copied as-is if no encryption context is provided
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_sector_data_vector_decrypt_sectors_at_offset(
+     libluksde_sector_data_vector_t *sector_data_vector,
+     libluksde_encryption_context_t *encryption_context,
+     off64_t offset,
+     const uint8_t *encrypted_data,
+     size_t encrypted_data_size,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function  = "libluksde_sector_data_vector_decrypt_sectors_at_offset";
+	size_t buffer_offset   = 0;
+	uint64_t sector_number = 0;
+
+	if( sector_data_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_data_vector->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sector data vector - bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= sector_data_vector->data_size )
+	 || ( ( offset % sector_data_vector->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( encrypted_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encrypted data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( encrypted_data_size == 0 )
+	 || ( encrypted_data_size > (size_t) LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE )
+	 || ( ( encrypted_data_size % sector_data_vector->bytes_per_sector ) != 0 )
+	 || ( (size64_t) encrypted_data_size > ( sector_data_vector->data_size - offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid encrypted data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size != encrypted_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( encryption_context == NULL )
+	{
+		if( memory_copy(
+		     buffer,
+		     encrypted_data,
+		     buffer_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy sectors data to buffer.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	/* The initialization vector is based on the sector number in 512-byte units
+	 * regardless of the sector size, as dm-crypt does for LUKS2
+	 */
+	sector_number = sector_data_vector->initialization_vector_tweak + ( (uint64_t) offset / 512 );
+
+	while( buffer_offset < buffer_size )
+	{
+		if( libluksde_encryption_context_crypt(
+		     encryption_context,
+		     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		     &( encrypted_data[ buffer_offset ] ),
+		     (size_t) sector_data_vector->bytes_per_sector,
+		     &( buffer[ buffer_offset ] ),
+		     (size_t) sector_data_vector->bytes_per_sector,
+		     sector_number,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to decrypt sector: %" PRIu64 " data.",
+			 function,
+			 sector_number );
+
+			return( -1 );
+		}
+		buffer_offset += sector_data_vector->bytes_per_sector;
+		sector_number += sector_data_vector->bytes_per_sector / 512;
+	}
+	return( 1 );
+}
+
@@ -26,10 +26,12 @@
 #include <types.h>
 
 #include "libluksde_encryption_context.h"
+#include "libluksde_io_uring.h"
 #include "libluksde_libcerror.h"
 #include "libluksde_libbfio.h"
 #include "libluksde_libfcache.h"
 #include "libluksde_sector_data.h"
+#include "libluksde_types.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -49,7 +51,7 @@ struct libluksde_sector_data_vector
 
 	/* The number of bytes per sector
 	 */
-	uint16_t bytes_per_sector;
+	uint32_t bytes_per_sector;
 
 	/* The data offset
 	 */
@@ -58,13 +60,19 @@ struct libluksde_sector_data_vector
 	/* The data size
 	 */
 	size64_t data_size;
+
+	/* The initialization vector tweak
+	 * Contains the sector number, in 512-byte units, of the first sector of the data
+	 */
+	uint64_t initialization_vector_tweak;
 };
 
 int libluksde_sector_data_vector_initialize(
      libluksde_sector_data_vector_t **sector_data_vector,
-     uint16_t bytes_per_sector,
+     uint32_t bytes_per_sector,
      off64_t data_offset,
      size64_t data_size,
+     uint64_t initialization_vector_tweak,
      libcerror_error_t **error );
 
 int libluksde_sector_data_vector_free(
@@ -74,11 +82,51 @@ int libluksde_sector_data_vector_free(
 int libluksde_sector_data_vector_get_sector_data_at_offset(
      libluksde_sector_data_vector_t *sector_data_vector,
      libbfio_handle_t *file_io_handle,
+     const libluksde_io_callbacks_t *io_callbacks,
      libluksde_encryption_context_t *encryption_context,
      off64_t offset,
      libluksde_sector_data_t **sector_data,
      libcerror_error_t **error );
 
+ssize_t libluksde_sector_data_vector_read_sectors_at_offset(
+         libluksde_sector_data_vector_t *sector_data_vector,
+         libbfio_handle_t *file_io_handle,
+         const libluksde_io_callbacks_t *io_callbacks,
+         libluksde_io_uring_t *io_uring,
+         libluksde_encryption_context_t *encryption_context,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+ssize_t libluksde_sector_data_vector_read_sectors_with_io_uring(
+         libluksde_sector_data_vector_t *sector_data_vector,
+         libluksde_io_uring_t *io_uring,
+         libluksde_encryption_context_t *encryption_context,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+ssize_t libluksde_sector_data_vector_read_encrypted_sectors_at_offset(
+         libluksde_sector_data_vector_t *sector_data_vector,
+         libbfio_handle_t *file_io_handle,
+         const libluksde_io_callbacks_t *io_callbacks,
+         off64_t offset,
+         uint8_t *encrypted_data,
+         size_t encrypted_data_size,
+         libcerror_error_t **error );
+
+int libluksde_sector_data_vector_decrypt_sectors_at_offset(
+     libluksde_sector_data_vector_t *sector_data_vector,
+     libluksde_encryption_context_t *encryption_context,
+     off64_t offset,
+     const uint8_t *encrypted_data,
+     size_t encrypted_data_size,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,582 @@
+/*
+ * Segment functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_definitions.h"
+#include "libluksde_json_tokenizer.h"
+#include "libluksde_libcdata.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_libcnotify.h"
+#include "libluksde_segment.h"
+#include "libluksde_volume_header.h"
+
+/* Creates a segment
+ * Make sure the value segment is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_segment_initialize(
+     libluksde_segment_t **segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_segment_initialize";
+
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*segment = memory_allocate_structure(
+	             libluksde_segment_t );
+
+	if( *segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment,
+	     0,
+	     sizeof( libluksde_segment_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *segment != NULL )
+	{
+		memory_free(
+		 *segment );
+
+		*segment = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segment
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_segment_free(
+     libluksde_segment_t **segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_segment_free";
+
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment != NULL )
+	{
+		memory_free(
+		 *segment );
+
+		*segment = NULL;
+	}
+	return( 1 );
+}
+
+/* Compares 2 segments by their identifier
+ * Returns LIBCDATA_COMPARE_LESS, LIBCDATA_COMPARE_EQUAL, LIBCDATA_COMPARE_GREATER if successful or -1 on error
+ */
+int libluksde_segment_compare_by_identifier(
+     libluksde_segment_t *first_segment,
+     libluksde_segment_t *second_segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_segment_compare_by_identifier";
+
+	if( first_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( second_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid second segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_segment->identifier < second_segment->identifier )
+	{
+		return( LIBCDATA_COMPARE_LESS );
+	}
+	else if( first_segment->identifier > second_segment->identifier )
+	{
+		return( LIBCDATA_COMPARE_GREATER );
+	}
+	return( LIBCDATA_COMPARE_EQUAL );
+}
+
+/* Reads the flags JSON array of a segment
+ * The tokenizer must be positioned after the start of the array
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_segment_read_json_flags_array(
+     libluksde_segment_t *segment,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error )
+{
+	libluksde_json_token_t token;
+
+	static char *function = "libluksde_segment_read_json_flags_array";
+
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		if( libluksde_json_tokenizer_get_next_token(
+		     tokenizer,
+		     &token,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next token.",
+			 function );
+
+			return( -1 );
+		}
+		if( token.type == LIBLUKSDE_JSON_TOKEN_TYPE_ARRAY_END )
+		{
+			break;
+		}
+		/* Reencryption marks the segments it keeps for recovery with
+		 * flags such as "backup-previous", "backup-final" and "backup-moved-segment"
+		 */
+		if( ( token.type == LIBLUKSDE_JSON_TOKEN_TYPE_STRING )
+		 && ( token.data_size >= 7 )
+		 && ( memory_compare(
+		       token.data,
+		       "backup-",
+		       7 ) == 0 ) )
+		{
+			segment->is_backup = 1;
+		}
+		else if( libluksde_json_tokenizer_skip_value(
+		          tokenizer,
+		          &token,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to skip value.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( token.type != LIBLUKSDE_JSON_TOKEN_TYPE_ARRAY_END );
+
+	return( 1 );
+}
+
+/* Reads a segment from a JSON object
+ * The tokenizer must be positioned after the start of the segment object
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_segment_read_json_object(
+     libluksde_segment_t *segment,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error )
+{
+	libluksde_json_token_t key_token;
+	libluksde_json_token_t value_token;
+
+	static char *function = "libluksde_segment_read_json_object";
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		result = libluksde_json_tokenizer_get_next_member(
+		          tokenizer,
+		          &key_token,
+		          &value_token,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment member.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libluksde_json_token_compare_string(
+		     &key_token,
+		     "type",
+		     4,
+		     error ) == 1 )
+		{
+			if( libluksde_json_token_compare_string(
+			     &value_token,
+			     "crypt",
+			     5,
+			     error ) == 1 )
+			{
+				segment->type = LIBLUKSDE_SEGMENT_TYPE_CRYPT;
+			}
+			else if( libluksde_json_token_compare_string(
+			          &value_token,
+			          "linear",
+			          6,
+			          error ) == 1 )
+			{
+				segment->type = LIBLUKSDE_SEGMENT_TYPE_LINEAR;
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "offset",
+		          6,
+		          error ) == 1 )
+		{
+			if( libluksde_json_token_get_integer_value(
+			     &value_token,
+			     &( segment->offset ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve offset.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "size",
+		          4,
+		          error ) == 1 )
+		{
+			if( libluksde_json_token_compare_string(
+			     &value_token,
+			     "dynamic",
+			     7,
+			     error ) == 1 )
+			{
+				segment->is_dynamic = 1;
+			}
+			else if( libluksde_json_token_get_integer_value(
+			          &value_token,
+			          &( segment->size ),
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve size.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( ( value_token.type == LIBLUKSDE_JSON_TOKEN_TYPE_ARRAY_START )
+		      && ( libluksde_json_token_compare_string(
+		            &key_token,
+		            "flags",
+		            5,
+		            error ) == 1 ) )
+		{
+			if( libluksde_segment_read_json_flags_array(
+			     segment,
+			     tokenizer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read flags array.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "iv_tweak",
+		          8,
+		          error ) == 1 )
+		{
+			if( libluksde_json_token_get_integer_value(
+			     &value_token,
+			     &( segment->initialization_vector_tweak ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve initialization vector tweak.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "encryption",
+		          10,
+		          error ) == 1 )
+		{
+			if( value_token.type != LIBLUKSDE_JSON_TOKEN_TYPE_STRING )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported encryption value type.",
+				 function );
+
+				return( -1 );
+			}
+			if( libluksde_volume_parse_encryption_specification(
+			     value_token.data,
+			     value_token.data_size,
+			     &( segment->encryption_method ),
+			     &( segment->encryption_chaining_mode ),
+			     &( segment->initialization_vector_mode ),
+			     &( segment->essiv_hashing_method ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to parse encryption.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "sector_size",
+		          11,
+		          error ) == 1 )
+		{
+			if( libluksde_json_token_get_integer_value(
+			     &value_token,
+			     &value_64bit,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve sector size.",
+				 function );
+
+				return( -1 );
+			}
+			if( ( value_64bit < 512 )
+			 || ( value_64bit > 4096 )
+			 || ( ( value_64bit & ( value_64bit - 1 ) ) != 0 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported sector size: %" PRIu64 ".",
+				 function,
+				 value_64bit );
+
+				return( -1 );
+			}
+			segment->sector_size = (uint32_t) value_64bit;
+		}
+		else if( libluksde_json_tokenizer_skip_value(
+		          tokenizer,
+		          &value_token,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to skip value.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( result != 0 );
+
+	if( segment->type == LIBLUKSDE_SEGMENT_TYPE_UNKNOWN )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported segment type.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment->type == LIBLUKSDE_SEGMENT_TYPE_CRYPT )
+	 && ( segment->sector_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing sector size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: type\t\t\t\t\t: %d\n",
+		 function,
+		 segment->type );
+
+		libcnotify_printf(
+		 "%s: offset\t\t\t\t: %" PRIu64 "\n",
+		 function,
+		 segment->offset );
+
+		if( segment->is_dynamic != 0 )
+		{
+			libcnotify_printf(
+			 "%s: size\t\t\t\t\t: dynamic\n",
+			 function );
+		}
+		else
+		{
+			libcnotify_printf(
+			 "%s: size\t\t\t\t\t: %" PRIu64 "\n",
+			 function,
+			 segment->size );
+		}
+		libcnotify_printf(
+		 "%s: initialization vector tweak\t\t: %" PRIu64 "\n",
+		 function,
+		 segment->initialization_vector_tweak );
+
+		libcnotify_printf(
+		 "%s: sector size\t\t\t\t: %" PRIu32 "\n",
+		 function,
+		 segment->sector_size );
+
+		libcnotify_printf(
+		 "%s: is backup\t\t\t\t: %" PRIu8 "\n",
+		 function,
+		 segment->is_backup );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+	return( 1 );
+}
+
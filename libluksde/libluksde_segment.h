@@ -0,0 +1,119 @@
+/*
+ * Segment functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_SEGMENT_H )
+#define _LIBLUKSDE_SEGMENT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_json_tokenizer.h"
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libluksde_segment libluksde_segment_t;
+
+struct libluksde_segment
+{
+	/* The identifier
+	 */
+	int identifier;
+
+	/* The type
+	 */
+	int type;
+
+	/* The offset
+	 */
+	uint64_t offset;
+
+	/* The size
+	 */
+	uint64_t size;
+
+	/* Value to indicate the size is dynamic
+	 * A dynamic segment extends to the end of the volume
+	 */
+	uint8_t is_dynamic;
+
+	/* Value to indicate the segment is a backup segment
+	 * A backup segment is used by reencryption and is not part of the volume data
+	 */
+	uint8_t is_backup;
+
+	/* The initialization vector tweak
+	 * Contains the sector number of the first sector of the segment
+	 */
+	uint64_t initialization_vector_tweak;
+
+	/* The encryption method
+	 */
+	int encryption_method;
+
+	/* The encryption chaining mode
+	 */
+	int encryption_chaining_mode;
+
+	/* The initialization vector mode
+	 */
+	int initialization_vector_mode;
+
+	/* The ESSIV hashing method
+	 */
+	int essiv_hashing_method;
+
+	/* The sector size
+	 */
+	uint32_t sector_size;
+};
+
+int libluksde_segment_initialize(
+     libluksde_segment_t **segment,
+     libcerror_error_t **error );
+
+int libluksde_segment_free(
+     libluksde_segment_t **segment,
+     libcerror_error_t **error );
+
+int libluksde_segment_compare_by_identifier(
+     libluksde_segment_t *first_segment,
+     libluksde_segment_t *second_segment,
+     libcerror_error_t **error );
+
+int libluksde_segment_read_json_flags_array(
+     libluksde_segment_t *segment,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error );
+
+int libluksde_segment_read_json_object(
+     libluksde_segment_t *segment,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_SEGMENT_H ) */
+
@@ -0,0 +1,1146 @@
+/*
+ * Segment map functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_definitions.h"
+#include "libluksde_encryption_context.h"
+#include "libluksde_libcdata.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_libcnotify.h"
+#include "libluksde_sector_data_vector.h"
+#include "libluksde_segment.h"
+#include "libluksde_segment_map.h"
+#include "libluksde_volume_header.h"
+
+/* Creates a segment map entry
+ * Make sure the value segment_map_entry is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_segment_map_entry_initialize(
+     libluksde_segment_map_entry_t **segment_map_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_segment_map_entry_initialize";
+
+	if( segment_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment map entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_map_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment map entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*segment_map_entry = memory_allocate_structure(
+	                      libluksde_segment_map_entry_t );
+
+	if( *segment_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment map entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment_map_entry,
+	     0,
+	     sizeof( libluksde_segment_map_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment map entry.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *segment_map_entry != NULL )
+	{
+		memory_free(
+		 *segment_map_entry );
+
+		*segment_map_entry = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segment map entry
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_segment_map_entry_free(
+     libluksde_segment_map_entry_t **segment_map_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_segment_map_entry_free";
+	int result            = 1;
+
+	if( segment_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment map entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_map_entry != NULL )
+	{
+		if( ( *segment_map_entry )->sector_data_vector != NULL )
+		{
+			if( libluksde_sector_data_vector_free(
+			     &( ( *segment_map_entry )->sector_data_vector ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sector data vector.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *segment_map_entry )->encryption_context != NULL )
+		{
+			if( libluksde_encryption_context_free(
+			     &( ( *segment_map_entry )->encryption_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free encryption context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *segment_map_entry );
+
+		*segment_map_entry = NULL;
+	}
+	return( result );
+}
+
+/* Sets the key of a segment map entry
+ * This creates the encryption context of a crypt segment, other segments are left unchanged
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_segment_map_entry_set_key(
+     libluksde_segment_map_entry_t *segment_map_entry,
+     const uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	libluksde_encryption_context_t *encryption_context = NULL;
+	static char *function                              = "libluksde_segment_map_entry_set_key";
+
+	if( segment_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment map entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_map_entry->type != LIBLUKSDE_SEGMENT_TYPE_CRYPT )
+	{
+		return( 1 );
+	}
+	if( libluksde_encryption_context_initialize(
+	     &encryption_context,
+	     segment_map_entry->encryption_method,
+	     segment_map_entry->encryption_chaining_mode,
+	     segment_map_entry->initialization_vector_mode,
+	     segment_map_entry->essiv_hashing_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_encryption_context_set_key(
+	     encryption_context,
+	     key,
+	     key_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key in encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	if( segment_map_entry->encryption_context != NULL )
+	{
+		if( libluksde_encryption_context_free(
+		     &( segment_map_entry->encryption_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free encryption context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	segment_map_entry->encryption_context = encryption_context;
+
+	return( 1 );
+
+on_error:
+	if( encryption_context != NULL )
+	{
+		libluksde_encryption_context_free(
+		 &encryption_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Creates a segment map
+ * Make sure the value segment_map is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_segment_map_initialize(
+     libluksde_segment_map_t **segment_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_segment_map_initialize";
+
+	if( segment_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*segment_map = memory_allocate_structure(
+	                libluksde_segment_map_t );
+
+	if( *segment_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment map.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment_map,
+	     0,
+	     sizeof( libluksde_segment_map_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment map.",
+		 function );
+
+		memory_free(
+		 *segment_map );
+
+		*segment_map = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *segment_map )->entries_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create entries array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *segment_map != NULL )
+	{
+		memory_free(
+		 *segment_map );
+
+		*segment_map = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segment map
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_segment_map_free(
+     libluksde_segment_map_t **segment_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_segment_map_free";
+	int result            = 1;
+
+	if( segment_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_map != NULL )
+	{
+		if( libcdata_array_free(
+		     &( ( *segment_map )->entries_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libluksde_segment_map_entry_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free entries array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *segment_map );
+
+		*segment_map = NULL;
+	}
+	return( result );
+}
+
+/* Appends an entry to the segment map
+ * The entry is mapped directly after the previous entry and the segment map takes over its management
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_segment_map_append_entry(
+     libluksde_segment_map_t *segment_map,
+     libluksde_segment_map_entry_t *segment_map_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_segment_map_append_entry";
+	int entry_index       = 0;
+
+	if( segment_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment map.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment map entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_map_entry->sector_data_vector != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment map entry - sector data vector value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_map_entry->type != LIBLUKSDE_SEGMENT_TYPE_CRYPT )
+	 && ( segment_map_entry->type != LIBLUKSDE_SEGMENT_TYPE_LINEAR ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported segment map entry type.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_map_entry->file_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment map entry - file offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_map_entry->sector_size < 512 )
+	 || ( segment_map_entry->sector_size > 4096 )
+	 || ( ( segment_map_entry->sector_size & ( segment_map_entry->sector_size - 1 ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment map entry - sector size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* A sector cannot span multiple entries, otherwise it could not be decrypted
+	 */
+	if( ( segment_map_entry->size == 0 )
+	 || ( ( segment_map_entry->size % segment_map_entry->sector_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment map entry - size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_map_entry->size > (size64_t) ( INT64_MAX - segment_map->size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment map entry - size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_sector_data_vector_initialize(
+	     &( segment_map_entry->sector_data_vector ),
+	     segment_map_entry->sector_size,
+	     segment_map_entry->file_offset,
+	     segment_map_entry->size,
+	     segment_map_entry->initialization_vector_tweak,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sector data vector.",
+		 function );
+
+		return( -1 );
+	}
+	segment_map_entry->volume_offset = (off64_t) segment_map->size;
+
+	if( libcdata_array_append_entry(
+	     segment_map->entries_array,
+	     &entry_index,
+	     (intptr_t *) segment_map_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append entry to entries array.",
+		 function );
+
+		libluksde_sector_data_vector_free(
+		 &( segment_map_entry->sector_data_vector ),
+		 NULL );
+
+		return( -1 );
+	}
+	segment_map->size += segment_map_entry->size;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: entry: %d type: %d volume offset: 0x%08" PRIx64 ", file offset: 0x%08" PRIx64 ", size: %" PRIu64 ", sector size: %" PRIu32 ", IV tweak: %" PRIu64 "\n",
+		 function,
+		 entry_index,
+		 segment_map_entry->type,
+		 segment_map_entry->volume_offset,
+		 segment_map_entry->file_offset,
+		 segment_map_entry->size,
+		 segment_map_entry->sector_size,
+		 segment_map_entry->initialization_vector_tweak );
+	}
+#endif
+	return( 1 );
+}
+
+/* Reads the segment map from the volume header
+ * LUKS1 has a single encrypted segment that extends to the end of the file,
+ * for LUKS2 the segments that are not backup segments are mapped in order of their identifier
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_segment_map_read_volume_header(
+     libluksde_segment_map_t *segment_map,
+     libluksde_volume_header_t *volume_header,
+     size64_t file_size,
+     libcerror_error_t **error )
+{
+	libluksde_segment_t *segment                     = NULL;
+	libluksde_segment_map_entry_t *segment_map_entry = NULL;
+	static char *function                            = "libluksde_segment_map_read_volume_header";
+	size64_t available_size                          = 0;
+	int number_of_segments                           = 0;
+	int segment_index                                = 0;
+
+	if( segment_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment map.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_map->size != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment map - entries already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_header->format_version == 1 )
+	{
+		if( libluksde_segment_map_entry_initialize(
+		     &segment_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment map entry.",
+			 function );
+
+			goto on_error;
+		}
+		segment_map_entry->type                       = LIBLUKSDE_SEGMENT_TYPE_CRYPT;
+		segment_map_entry->file_offset                = (off64_t) ( volume_header->encrypted_volume_start_sector * 512 );
+		segment_map_entry->sector_size                = 512;
+		segment_map_entry->encryption_method          = volume_header->encryption_method;
+		segment_map_entry->encryption_chaining_mode   = volume_header->encryption_chaining_mode;
+		segment_map_entry->initialization_vector_mode = volume_header->initialization_vector_mode;
+		segment_map_entry->essiv_hashing_method       = volume_header->essiv_hashing_method;
+
+		if( (size64_t) segment_map_entry->file_offset >= file_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid encrypted volume start sector value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		segment_map_entry->size  = file_size - segment_map_entry->file_offset;
+		segment_map_entry->size -= segment_map_entry->size % 512;
+
+		if( libluksde_segment_map_append_entry(
+		     segment_map,
+		     segment_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment map entry.",
+			 function );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     volume_header->segments_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     volume_header->segments_array,
+		     segment_index,
+		     (intptr_t **) &segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( segment == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( segment->is_backup != 0 )
+		{
+			continue;
+		}
+		if( segment->offset >= (uint64_t) file_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment: %d offset value out of bounds.",
+			 function,
+			 segment->identifier );
+
+			goto on_error;
+		}
+		available_size = file_size - segment->offset;
+
+		if( libluksde_segment_map_entry_initialize(
+		     &segment_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment map entry.",
+			 function );
+
+			goto on_error;
+		}
+		segment_map_entry->segment_identifier          = segment->identifier;
+		segment_map_entry->type                        = segment->type;
+		segment_map_entry->file_offset                 = (off64_t) segment->offset;
+		segment_map_entry->initialization_vector_tweak = segment->initialization_vector_tweak;
+
+		if( segment->type == LIBLUKSDE_SEGMENT_TYPE_CRYPT )
+		{
+			segment_map_entry->sector_size                = segment->sector_size;
+			segment_map_entry->encryption_method          = segment->encryption_method;
+			segment_map_entry->encryption_chaining_mode   = segment->encryption_chaining_mode;
+			segment_map_entry->initialization_vector_mode = segment->initialization_vector_mode;
+			segment_map_entry->essiv_hashing_method       = segment->essiv_hashing_method;
+		}
+		else
+		{
+			segment_map_entry->sector_size = 512;
+		}
+		if( segment->is_dynamic != 0 )
+		{
+			segment_map_entry->size = available_size;
+		}
+		else if( segment->size <= available_size )
+		{
+			segment_map_entry->size = segment->size;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment: %d size value out of bounds.",
+			 function,
+			 segment->identifier );
+
+			goto on_error;
+		}
+		/* A trailing partial sector cannot be decrypted
+		 */
+		segment_map_entry->size -= segment_map_entry->size % segment_map_entry->sector_size;
+
+		if( segment_map_entry->size == 0 )
+		{
+			libluksde_segment_map_entry_free(
+			 &segment_map_entry,
+			 NULL );
+
+			continue;
+		}
+		if( libluksde_segment_map_append_entry(
+		     segment_map,
+		     segment_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment map entry.",
+			 function );
+
+			goto on_error;
+		}
+		segment_map_entry = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( segment_map_entry != NULL )
+	{
+		libluksde_segment_map_entry_free(
+		 &segment_map_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the key of all the crypt segments in the segment map
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_segment_map_set_key(
+     libluksde_segment_map_t *segment_map,
+     const uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	libluksde_segment_map_entry_t *segment_map_entry = NULL;
+	static char *function                            = "libluksde_segment_map_set_key";
+	int entry_index                                  = 0;
+	int number_of_entries                            = 0;
+
+	if( segment_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment map.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     segment_map->entries_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     segment_map->entries_array,
+		     entry_index,
+		     (intptr_t **) &segment_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( libluksde_segment_map_entry_set_key(
+		     segment_map_entry,
+		     key,
+		     key_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set key of entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the key of the crypt segments in the segment map that are in the segments bitmap
+ * This is used during reencryption where the segments are encrypted with different keys
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_segment_map_set_segments_key(
+     libluksde_segment_map_t *segment_map,
+     uint32_t segments_bitmap,
+     const uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	libluksde_segment_map_entry_t *segment_map_entry = NULL;
+	static char *function                            = "libluksde_segment_map_set_segments_key";
+	int entry_index                                  = 0;
+	int number_of_entries                            = 0;
+
+	if( segment_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment map.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     segment_map->entries_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     segment_map->entries_array,
+		     entry_index,
+		     (intptr_t **) &segment_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( segment_map_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( ( segment_map_entry->segment_identifier < 0 )
+		 || ( segment_map_entry->segment_identifier >= 32 )
+		 || ( ( segments_bitmap & ( (uint32_t) 1 << segment_map_entry->segment_identifier ) ) == 0 ) )
+		{
+			continue;
+		}
+		if( libluksde_segment_map_entry_set_key(
+		     segment_map_entry,
+		     key,
+		     key_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set key of entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of entries
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_segment_map_get_number_of_entries(
+     libluksde_segment_map_t *segment_map,
+     int *number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_segment_map_get_number_of_entries";
+
+	if( segment_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment map.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     segment_map->entries_array,
+	     number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the entry that contains a specific (decrypted) volume offset
+ * The entries are ordered by volume offset and do not overlap, hence a binary search is used
+ * Returns 1 if successful, 0 if no such entry or -1 on error
+ */
+int libluksde_segment_map_get_entry_at_offset(
+     libluksde_segment_map_t *segment_map,
+     off64_t offset,
+     libluksde_segment_map_entry_t **segment_map_entry,
+     libcerror_error_t **error )
+{
+	libluksde_segment_map_entry_t *safe_segment_map_entry = NULL;
+	static char *function                                 = "libluksde_segment_map_get_entry_at_offset";
+	int entry_index                                       = 0;
+	int lower_entry_index                                 = 0;
+	int number_of_entries                                 = 0;
+	int upper_entry_index                                 = 0;
+
+	if( segment_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment map.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment map entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= segment_map->size ) )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     segment_map->entries_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	upper_entry_index = number_of_entries;
+
+	while( lower_entry_index < upper_entry_index )
+	{
+		entry_index = lower_entry_index + ( ( upper_entry_index - lower_entry_index ) / 2 );
+
+		if( libcdata_array_get_entry_by_index(
+		     segment_map->entries_array,
+		     entry_index,
+		     (intptr_t **) &safe_segment_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( safe_segment_map_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( offset < safe_segment_map_entry->volume_offset )
+		{
+			upper_entry_index = entry_index;
+		}
+		else if( (size64_t) ( offset - safe_segment_map_entry->volume_offset ) >= safe_segment_map_entry->size )
+		{
+			lower_entry_index = entry_index + 1;
+		}
+		else
+		{
+			*segment_map_entry = safe_segment_map_entry;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
@@ -0,0 +1,173 @@
+/*
+ * Segment map functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_SEGMENT_MAP_H )
+#define _LIBLUKSDE_SEGMENT_MAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_encryption_context.h"
+#include "libluksde_libcdata.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_sector_data_vector.h"
+#include "libluksde_volume_header.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libluksde_segment_map_entry libluksde_segment_map_entry_t;
+
+struct libluksde_segment_map_entry
+{
+	/* The segment identifier
+	 */
+	int segment_identifier;
+
+	/* The segment type
+	 */
+	int type;
+
+	/* The (decrypted) volume offset
+	 */
+	off64_t volume_offset;
+
+	/* The file offset
+	 */
+	off64_t file_offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The initialization vector tweak
+	 */
+	uint64_t initialization_vector_tweak;
+
+	/* The encrypted sector size
+	 */
+	uint32_t sector_size;
+
+	/* The encryption method
+	 */
+	int encryption_method;
+
+	/* The encryption chaining mode
+	 */
+	int encryption_chaining_mode;
+
+	/* The initialization vector mode
+	 */
+	int initialization_vector_mode;
+
+	/* The ESSIV hashing method
+	 */
+	int essiv_hashing_method;
+
+	/* The encryption context
+	 * Only set for a crypt segment when the key is known
+	 */
+	libluksde_encryption_context_t *encryption_context;
+
+	/* The sector data vector
+	 */
+	libluksde_sector_data_vector_t *sector_data_vector;
+};
+
+typedef struct libluksde_segment_map libluksde_segment_map_t;
+
+struct libluksde_segment_map
+{
+	/* The entries array
+	 * Contains the entries in order of their volume offset
+	 */
+	libcdata_array_t *entries_array;
+
+	/* The size
+	 * Contains the size of the data of all the entries
+	 */
+	size64_t size;
+};
+
+int libluksde_segment_map_entry_initialize(
+     libluksde_segment_map_entry_t **segment_map_entry,
+     libcerror_error_t **error );
+
+int libluksde_segment_map_entry_free(
+     libluksde_segment_map_entry_t **segment_map_entry,
+     libcerror_error_t **error );
+
+int libluksde_segment_map_entry_set_key(
+     libluksde_segment_map_entry_t *segment_map_entry,
+     const uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error );
+
+int libluksde_segment_map_initialize(
+     libluksde_segment_map_t **segment_map,
+     libcerror_error_t **error );
+
+int libluksde_segment_map_free(
+     libluksde_segment_map_t **segment_map,
+     libcerror_error_t **error );
+
+int libluksde_segment_map_append_entry(
+     libluksde_segment_map_t *segment_map,
+     libluksde_segment_map_entry_t *segment_map_entry,
+     libcerror_error_t **error );
+
+int libluksde_segment_map_read_volume_header(
+     libluksde_segment_map_t *segment_map,
+     libluksde_volume_header_t *volume_header,
+     size64_t file_size,
+     libcerror_error_t **error );
+
+int libluksde_segment_map_set_key(
+     libluksde_segment_map_t *segment_map,
+     const uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error );
+
+int libluksde_segment_map_set_segments_key(
+     libluksde_segment_map_t *segment_map,
+     uint32_t segments_bitmap,
+     const uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error );
+
+int libluksde_segment_map_get_number_of_entries(
+     libluksde_segment_map_t *segment_map,
+     int *number_of_entries,
+     libcerror_error_t **error );
+
+int libluksde_segment_map_get_entry_at_offset(
+     libluksde_segment_map_t *segment_map,
+     off64_t offset,
+     libluksde_segment_map_entry_t **segment_map_entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_SEGMENT_MAP_H ) */
+
@@ -0,0 +1,882 @@
+/*
+ * SHA-1, SHA-224, SHA-256 and SHA-512 functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libluksde_definitions.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_sha.h"
+
+/* The SHA-1 initial hash values
+ */
+static const uint32_t libluksde_sha1_initial_hash_values[ 5 ] = {
+	0x67452301UL, 0xefcdab89UL, 0x98badcfeUL, 0x10325476UL, 0xc3d2e1f0UL };
+
+/* The SHA-224 initial hash values
+ */
+static const uint32_t libluksde_sha224_initial_hash_values[ 8 ] = {
+	0xc1059ed8UL, 0x367cd507UL, 0x3070dd17UL, 0xf70e5939UL,
+	0xffc00b31UL, 0x68581511UL, 0x64f98fa7UL, 0xbefa4fa4UL };
+
+/* The SHA-256 initial hash values
+ */
+static const uint32_t libluksde_sha256_initial_hash_values[ 8 ] = {
+	0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL,
+	0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL };
+
+/* The SHA-224 and SHA-256 round constants
+ */
+static const uint32_t libluksde_sha256_round_constants[ 64 ] = {
+	0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+	0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+	0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+	0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+	0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+	0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+	0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+	0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL };
+
+/* The SHA-512 initial hash values
+ */
+static const uint64_t libluksde_sha512_initial_hash_values[ 8 ] = {
+	0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+	0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL };
+
+/* The SHA-512 round constants
+ */
+static const uint64_t libluksde_sha512_round_constants[ 80 ] = {
+	0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+	0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+	0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+	0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+	0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+	0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+	0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+	0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+	0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+	0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+	0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+	0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+	0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+	0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+	0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+	0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+	0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+	0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+	0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+	0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL };
+
+#define libluksde_sha_rotate_left32( value, number_of_bits ) \
+	( ( ( value ) << ( number_of_bits ) ) | ( ( value ) >> ( 32 - ( number_of_bits ) ) ) )
+
+#define libluksde_sha_rotate_right32( value, number_of_bits ) \
+	( ( ( value ) >> ( number_of_bits ) ) | ( ( value ) << ( 32 - ( number_of_bits ) ) ) )
+
+#define libluksde_sha_rotate_right64( value, number_of_bits ) \
+	( ( ( value ) >> ( number_of_bits ) ) | ( ( value ) << ( 64 - ( number_of_bits ) ) ) )
+
+#define libluksde_sha1_round( value_a, value_b, value_c, value_d, value_e, round_function, round_constant ) \
+	value_e += libluksde_sha_rotate_left32( value_a, 5 ) + round_function( value_b, value_c, value_d ) + round_constant + schedule[ value_index ]; \
+	value_b  = libluksde_sha_rotate_left32( value_b, 30 ); \
+	value_index++;
+
+#define libluksde_sha1_choose( value_b, value_c, value_d ) \
+	( value_d ^ ( value_b & ( value_c ^ value_d ) ) )
+
+#define libluksde_sha1_parity( value_b, value_c, value_d ) \
+	( value_b ^ value_c ^ value_d )
+
+#define libluksde_sha1_majority( value_b, value_c, value_d ) \
+	( ( value_b & value_c ) | ( value_d & ( value_b | value_c ) ) )
+
+/* Compresses a single 64-byte block into the SHA-1 hash values
+ */
+static void libluksde_sha1_compress(
+             uint32_t *hash_values,
+             const uint8_t *block_data )
+{
+	uint32_t schedule[ 80 ];
+
+	uint32_t round_value = 0;
+	uint32_t value_a     = 0;
+	uint32_t value_b     = 0;
+	uint32_t value_c     = 0;
+	uint32_t value_d     = 0;
+	uint32_t value_e     = 0;
+	int round_iterator   = 0;
+	int value_index      = 0;
+
+	for( value_index = 0;
+	     value_index < 16;
+	     value_index++ )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 &( block_data[ value_index * 4 ] ),
+		 schedule[ value_index ] );
+	}
+	for( value_index = 16;
+	     value_index < 80;
+	     value_index++ )
+	{
+		round_value = schedule[ value_index - 3 ] ^ schedule[ value_index - 8 ]
+		            ^ schedule[ value_index - 14 ] ^ schedule[ value_index - 16 ];
+
+		schedule[ value_index ] = libluksde_sha_rotate_left32( round_value, 1 );
+	}
+	value_a = hash_values[ 0 ];
+	value_b = hash_values[ 1 ];
+	value_c = hash_values[ 2 ];
+	value_d = hash_values[ 3 ];
+	value_e = hash_values[ 4 ];
+
+	/* Every round function is used for 20 rounds. The rounds are unrolled
+	 * 5 times so that the working values rotate by renaming instead of by copying
+	 */
+	value_index = 0;
+
+	for( round_iterator = 0;
+	     round_iterator < 4;
+	     round_iterator++ )
+	{
+		libluksde_sha1_round( value_a, value_b, value_c, value_d, value_e, libluksde_sha1_choose, 0x5a827999UL )
+		libluksde_sha1_round( value_e, value_a, value_b, value_c, value_d, libluksde_sha1_choose, 0x5a827999UL )
+		libluksde_sha1_round( value_d, value_e, value_a, value_b, value_c, libluksde_sha1_choose, 0x5a827999UL )
+		libluksde_sha1_round( value_c, value_d, value_e, value_a, value_b, libluksde_sha1_choose, 0x5a827999UL )
+		libluksde_sha1_round( value_b, value_c, value_d, value_e, value_a, libluksde_sha1_choose, 0x5a827999UL )
+	}
+	for( round_iterator = 0;
+	     round_iterator < 4;
+	     round_iterator++ )
+	{
+		libluksde_sha1_round( value_a, value_b, value_c, value_d, value_e, libluksde_sha1_parity, 0x6ed9eba1UL )
+		libluksde_sha1_round( value_e, value_a, value_b, value_c, value_d, libluksde_sha1_parity, 0x6ed9eba1UL )
+		libluksde_sha1_round( value_d, value_e, value_a, value_b, value_c, libluksde_sha1_parity, 0x6ed9eba1UL )
+		libluksde_sha1_round( value_c, value_d, value_e, value_a, value_b, libluksde_sha1_parity, 0x6ed9eba1UL )
+		libluksde_sha1_round( value_b, value_c, value_d, value_e, value_a, libluksde_sha1_parity, 0x6ed9eba1UL )
+	}
+	for( round_iterator = 0;
+	     round_iterator < 4;
+	     round_iterator++ )
+	{
+		libluksde_sha1_round( value_a, value_b, value_c, value_d, value_e, libluksde_sha1_majority, 0x8f1bbcdcUL )
+		libluksde_sha1_round( value_e, value_a, value_b, value_c, value_d, libluksde_sha1_majority, 0x8f1bbcdcUL )
+		libluksde_sha1_round( value_d, value_e, value_a, value_b, value_c, libluksde_sha1_majority, 0x8f1bbcdcUL )
+		libluksde_sha1_round( value_c, value_d, value_e, value_a, value_b, libluksde_sha1_majority, 0x8f1bbcdcUL )
+		libluksde_sha1_round( value_b, value_c, value_d, value_e, value_a, libluksde_sha1_majority, 0x8f1bbcdcUL )
+	}
+	for( round_iterator = 0;
+	     round_iterator < 4;
+	     round_iterator++ )
+	{
+		libluksde_sha1_round( value_a, value_b, value_c, value_d, value_e, libluksde_sha1_parity, 0xca62c1d6UL )
+		libluksde_sha1_round( value_e, value_a, value_b, value_c, value_d, libluksde_sha1_parity, 0xca62c1d6UL )
+		libluksde_sha1_round( value_d, value_e, value_a, value_b, value_c, libluksde_sha1_parity, 0xca62c1d6UL )
+		libluksde_sha1_round( value_c, value_d, value_e, value_a, value_b, libluksde_sha1_parity, 0xca62c1d6UL )
+		libluksde_sha1_round( value_b, value_c, value_d, value_e, value_a, libluksde_sha1_parity, 0xca62c1d6UL )
+	}
+	hash_values[ 0 ] += value_a;
+	hash_values[ 1 ] += value_b;
+	hash_values[ 2 ] += value_c;
+	hash_values[ 3 ] += value_d;
+	hash_values[ 4 ] += value_e;
+}
+
+#define libluksde_sha256_round( value_a, value_b, value_c, value_d, value_e, value_f, value_g, value_h, round_index ) \
+	round_value = value_h \
+	            + ( libluksde_sha_rotate_right32( value_e, 6 ) ^ libluksde_sha_rotate_right32( value_e, 11 ) ^ libluksde_sha_rotate_right32( value_e, 25 ) ) \
+	            + ( value_g ^ ( value_e & ( value_f ^ value_g ) ) ) \
+	            + libluksde_sha256_round_constants[ round_index ] + schedule[ round_index ]; \
+	value_d    += round_value; \
+	value_h     = round_value \
+	            + ( libluksde_sha_rotate_right32( value_a, 2 ) ^ libluksde_sha_rotate_right32( value_a, 13 ) ^ libluksde_sha_rotate_right32( value_a, 22 ) ) \
+	            + ( ( value_a & value_b ) | ( value_c & ( value_a | value_b ) ) );
+
+/* Compresses a single 64-byte block into the SHA-224 or SHA-256 hash values
+ */
+static void libluksde_sha256_compress(
+             uint32_t *hash_values,
+             const uint8_t *block_data )
+{
+	uint32_t schedule[ 64 ];
+
+	uint32_t round_value = 0;
+	uint32_t sigma0      = 0;
+	uint32_t sigma1      = 0;
+	uint32_t value_a     = 0;
+	uint32_t value_b     = 0;
+	uint32_t value_c     = 0;
+	uint32_t value_d     = 0;
+	uint32_t value_e     = 0;
+	uint32_t value_f     = 0;
+	uint32_t value_g     = 0;
+	uint32_t value_h     = 0;
+	int value_index      = 0;
+
+	for( value_index = 0;
+	     value_index < 16;
+	     value_index++ )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 &( block_data[ value_index * 4 ] ),
+		 schedule[ value_index ] );
+	}
+	for( value_index = 16;
+	     value_index < 64;
+	     value_index++ )
+	{
+		sigma0 = libluksde_sha_rotate_right32( schedule[ value_index - 15 ], 7 )
+		       ^ libluksde_sha_rotate_right32( schedule[ value_index - 15 ], 18 )
+		       ^ ( schedule[ value_index - 15 ] >> 3 );
+
+		sigma1 = libluksde_sha_rotate_right32( schedule[ value_index - 2 ], 17 )
+		       ^ libluksde_sha_rotate_right32( schedule[ value_index - 2 ], 19 )
+		       ^ ( schedule[ value_index - 2 ] >> 10 );
+
+		schedule[ value_index ] = schedule[ value_index - 16 ] + sigma0 + schedule[ value_index - 7 ] + sigma1;
+	}
+	value_a = hash_values[ 0 ];
+	value_b = hash_values[ 1 ];
+	value_c = hash_values[ 2 ];
+	value_d = hash_values[ 3 ];
+	value_e = hash_values[ 4 ];
+	value_f = hash_values[ 5 ];
+	value_g = hash_values[ 6 ];
+	value_h = hash_values[ 7 ];
+
+	/* The rounds are unrolled 8 times so that the working values
+	 * rotate by renaming instead of by copying
+	 */
+	for( value_index = 0;
+	     value_index < 64;
+	     value_index += 8 )
+	{
+		libluksde_sha256_round( value_a, value_b, value_c, value_d, value_e, value_f, value_g, value_h, value_index )
+		libluksde_sha256_round( value_h, value_a, value_b, value_c, value_d, value_e, value_f, value_g, value_index + 1 )
+		libluksde_sha256_round( value_g, value_h, value_a, value_b, value_c, value_d, value_e, value_f, value_index + 2 )
+		libluksde_sha256_round( value_f, value_g, value_h, value_a, value_b, value_c, value_d, value_e, value_index + 3 )
+		libluksde_sha256_round( value_e, value_f, value_g, value_h, value_a, value_b, value_c, value_d, value_index + 4 )
+		libluksde_sha256_round( value_d, value_e, value_f, value_g, value_h, value_a, value_b, value_c, value_index + 5 )
+		libluksde_sha256_round( value_c, value_d, value_e, value_f, value_g, value_h, value_a, value_b, value_index + 6 )
+		libluksde_sha256_round( value_b, value_c, value_d, value_e, value_f, value_g, value_h, value_a, value_index + 7 )
+	}
+	hash_values[ 0 ] += value_a;
+	hash_values[ 1 ] += value_b;
+	hash_values[ 2 ] += value_c;
+	hash_values[ 3 ] += value_d;
+	hash_values[ 4 ] += value_e;
+	hash_values[ 5 ] += value_f;
+	hash_values[ 6 ] += value_g;
+	hash_values[ 7 ] += value_h;
+}
+
+#define libluksde_sha512_round( value_a, value_b, value_c, value_d, value_e, value_f, value_g, value_h, round_index ) \
+	round_value = value_h \
+	            + ( libluksde_sha_rotate_right64( value_e, 14 ) ^ libluksde_sha_rotate_right64( value_e, 18 ) ^ libluksde_sha_rotate_right64( value_e, 41 ) ) \
+	            + ( value_g ^ ( value_e & ( value_f ^ value_g ) ) ) \
+	            + libluksde_sha512_round_constants[ round_index ] + schedule[ round_index ]; \
+	value_d    += round_value; \
+	value_h     = round_value \
+	            + ( libluksde_sha_rotate_right64( value_a, 28 ) ^ libluksde_sha_rotate_right64( value_a, 34 ) ^ libluksde_sha_rotate_right64( value_a, 39 ) ) \
+	            + ( ( value_a & value_b ) | ( value_c & ( value_a | value_b ) ) );
+
+/* Compresses a single 128-byte block into the SHA-512 hash values
+ */
+static void libluksde_sha512_compress(
+             uint64_t *hash_values,
+             const uint8_t *block_data )
+{
+	uint64_t schedule[ 80 ];
+
+	uint64_t round_value = 0;
+	uint64_t sigma0      = 0;
+	uint64_t sigma1      = 0;
+	uint64_t value_a     = 0;
+	uint64_t value_b     = 0;
+	uint64_t value_c     = 0;
+	uint64_t value_d     = 0;
+	uint64_t value_e     = 0;
+	uint64_t value_f     = 0;
+	uint64_t value_g     = 0;
+	uint64_t value_h     = 0;
+	int value_index      = 0;
+
+	for( value_index = 0;
+	     value_index < 16;
+	     value_index++ )
+	{
+		byte_stream_copy_to_uint64_big_endian(
+		 &( block_data[ value_index * 8 ] ),
+		 schedule[ value_index ] );
+	}
+	for( value_index = 16;
+	     value_index < 80;
+	     value_index++ )
+	{
+		sigma0 = libluksde_sha_rotate_right64( schedule[ value_index - 15 ], 1 )
+		       ^ libluksde_sha_rotate_right64( schedule[ value_index - 15 ], 8 )
+		       ^ ( schedule[ value_index - 15 ] >> 7 );
+
+		sigma1 = libluksde_sha_rotate_right64( schedule[ value_index - 2 ], 19 )
+		       ^ libluksde_sha_rotate_right64( schedule[ value_index - 2 ], 61 )
+		       ^ ( schedule[ value_index - 2 ] >> 6 );
+
+		schedule[ value_index ] = schedule[ value_index - 16 ] + sigma0 + schedule[ value_index - 7 ] + sigma1;
+	}
+	value_a = hash_values[ 0 ];
+	value_b = hash_values[ 1 ];
+	value_c = hash_values[ 2 ];
+	value_d = hash_values[ 3 ];
+	value_e = hash_values[ 4 ];
+	value_f = hash_values[ 5 ];
+	value_g = hash_values[ 6 ];
+	value_h = hash_values[ 7 ];
+
+	/* The rounds are unrolled 8 times so that the working values
+	 * rotate by renaming instead of by copying
+	 */
+	for( value_index = 0;
+	     value_index < 80;
+	     value_index += 8 )
+	{
+		libluksde_sha512_round( value_a, value_b, value_c, value_d, value_e, value_f, value_g, value_h, value_index )
+		libluksde_sha512_round( value_h, value_a, value_b, value_c, value_d, value_e, value_f, value_g, value_index + 1 )
+		libluksde_sha512_round( value_g, value_h, value_a, value_b, value_c, value_d, value_e, value_f, value_index + 2 )
+		libluksde_sha512_round( value_f, value_g, value_h, value_a, value_b, value_c, value_d, value_e, value_index + 3 )
+		libluksde_sha512_round( value_e, value_f, value_g, value_h, value_a, value_b, value_c, value_d, value_index + 4 )
+		libluksde_sha512_round( value_d, value_e, value_f, value_g, value_h, value_a, value_b, value_c, value_index + 5 )
+		libluksde_sha512_round( value_c, value_d, value_e, value_f, value_g, value_h, value_a, value_b, value_index + 6 )
+		libluksde_sha512_round( value_b, value_c, value_d, value_e, value_f, value_g, value_h, value_a, value_index + 7 )
+	}
+	hash_values[ 0 ] += value_a;
+	hash_values[ 1 ] += value_b;
+	hash_values[ 2 ] += value_c;
+	hash_values[ 3 ] += value_d;
+	hash_values[ 4 ] += value_e;
+	hash_values[ 5 ] += value_f;
+	hash_values[ 6 ] += value_g;
+	hash_values[ 7 ] += value_h;
+}
+
+/* Compresses a single block into the hash values of the context
+ */
+static void libluksde_sha_compress(
+             libluksde_sha_context_t *context,
+             const uint8_t *block_data )
+{
+	if( context->hashing_method == LIBLUKSDE_HASHING_METHOD_SHA1 )
+	{
+		libluksde_sha1_compress(
+		 context->hash_values32,
+		 block_data );
+	}
+	else if( context->hashing_method == LIBLUKSDE_HASHING_METHOD_SHA512 )
+	{
+		libluksde_sha512_compress(
+		 context->hash_values64,
+		 block_data );
+	}
+	else
+	{
+		libluksde_sha256_compress(
+		 context->hash_values32,
+		 block_data );
+	}
+}
+
+/* Initializes a SHA context
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_sha_initialize(
+     libluksde_sha_context_t *context,
+     int hashing_method,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_sha_initialize";
+	size_t value_index    = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( hashing_method != LIBLUKSDE_HASHING_METHOD_SHA1 )
+	 && ( hashing_method != LIBLUKSDE_HASHING_METHOD_SHA224 )
+	 && ( hashing_method != LIBLUKSDE_HASHING_METHOD_SHA256 )
+	 && ( hashing_method != LIBLUKSDE_HASHING_METHOD_SHA512 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported hashing method.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     context,
+	     0,
+	     sizeof( libluksde_sha_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		return( -1 );
+	}
+	switch( hashing_method )
+	{
+		case LIBLUKSDE_HASHING_METHOD_SHA1:
+			for( value_index = 0;
+			     value_index < 5;
+			     value_index++ )
+			{
+				context->hash_values32[ value_index ] = libluksde_sha1_initial_hash_values[ value_index ];
+			}
+			context->hash_size  = 20;
+			context->block_size = 64;
+			break;
+
+		case LIBLUKSDE_HASHING_METHOD_SHA224:
+			for( value_index = 0;
+			     value_index < 8;
+			     value_index++ )
+			{
+				context->hash_values32[ value_index ] = libluksde_sha224_initial_hash_values[ value_index ];
+			}
+			context->hash_size  = 28;
+			context->block_size = 64;
+			break;
+
+		case LIBLUKSDE_HASHING_METHOD_SHA256:
+			for( value_index = 0;
+			     value_index < 8;
+			     value_index++ )
+			{
+				context->hash_values32[ value_index ] = libluksde_sha256_initial_hash_values[ value_index ];
+			}
+			context->hash_size  = 32;
+			context->block_size = 64;
+			break;
+
+		case LIBLUKSDE_HASHING_METHOD_SHA512:
+			for( value_index = 0;
+			     value_index < 8;
+			     value_index++ )
+			{
+				context->hash_values64[ value_index ] = libluksde_sha512_initial_hash_values[ value_index ];
+			}
+			context->hash_size  = 64;
+			context->block_size = 128;
+			break;
+	}
+	context->hashing_method = hashing_method;
+
+	return( 1 );
+}
+
+/* Updates a SHA context
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_sha_update(
+     libluksde_sha_context_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_sha_update";
+	size_t buffer_offset  = 0;
+	size_t copy_size      = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( context->block_size == 0 )
+	 || ( context->block_size > LIBLUKSDE_SHA_MAXIMUM_BLOCK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid context - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer == NULL )
+	 && ( size != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	context->number_of_bytes += size;
+
+	while( buffer_offset < size )
+	{
+		/* Full blocks are compressed directly from the buffer
+		 */
+		if( ( context->block_data_size == 0 )
+		 && ( ( size - buffer_offset ) >= context->block_size ) )
+		{
+			libluksde_sha_compress(
+			 context,
+			 &( buffer[ buffer_offset ] ) );
+
+			buffer_offset += context->block_size;
+
+			continue;
+		}
+		copy_size = context->block_size - context->block_data_size;
+
+		if( copy_size > ( size - buffer_offset ) )
+		{
+			copy_size = size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( context->block_data[ context->block_data_size ] ),
+		     &( buffer[ buffer_offset ] ),
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to block data.",
+			 function );
+
+			return( -1 );
+		}
+		context->block_data_size += copy_size;
+		buffer_offset            += copy_size;
+
+		if( context->block_data_size == context->block_size )
+		{
+			libluksde_sha_compress(
+			 context,
+			 context->block_data );
+
+			context->block_data_size = 0;
+		}
+	}
+	return( 1 );
+}
+
+/* Finalizes a SHA context
+ * The hash size must match the hash size of the hashing method
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_sha_finalize(
+     libluksde_sha_context_t *context,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	uint8_t hash_data[ LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE ];
+
+	static char *function   = "libluksde_sha_finalize";
+	size_t length_data_size = 0;
+	size_t value_index      = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( context->block_size == 0 )
+	 || ( context->block_size > LIBLUKSDE_SHA_MAXIMUM_BLOCK_SIZE )
+	 || ( context->block_data_size >= context->block_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid context - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_size != context->hash_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* SHA-512 stores the number of bits as a 128-bit value
+	 * the other hashing methods as a 64-bit value
+	 */
+	length_data_size = context->block_size / 8;
+
+	context->block_data[ context->block_data_size++ ] = 0x80;
+
+	if( context->block_data_size > ( context->block_size - length_data_size ) )
+	{
+		if( memory_set(
+		     &( context->block_data[ context->block_data_size ] ),
+		     0,
+		     context->block_size - context->block_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear block data.",
+			 function );
+
+			return( -1 );
+		}
+		libluksde_sha_compress(
+		 context,
+		 context->block_data );
+
+		context->block_data_size = 0;
+	}
+	if( memory_set(
+	     &( context->block_data[ context->block_data_size ] ),
+	     0,
+	     context->block_size - context->block_data_size - 8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block data.",
+		 function );
+
+		return( -1 );
+	}
+	if( length_data_size == 16 )
+	{
+		byte_stream_copy_from_uint64_big_endian(
+		 &( context->block_data[ context->block_size - 16 ] ),
+		 context->number_of_bytes >> 61 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( context->block_data[ context->block_size - 8 ] ),
+	 context->number_of_bytes << 3 );
+
+	libluksde_sha_compress(
+	 context,
+	 context->block_data );
+
+	if( context->hashing_method == LIBLUKSDE_HASHING_METHOD_SHA512 )
+	{
+		for( value_index = 0;
+		     value_index < 8;
+		     value_index++ )
+		{
+			byte_stream_copy_from_uint64_big_endian(
+			 &( hash_data[ value_index * 8 ] ),
+			 context->hash_values64[ value_index ] );
+		}
+	}
+	else
+	{
+		for( value_index = 0;
+		     value_index < 8;
+		     value_index++ )
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( hash_data[ value_index * 4 ] ),
+			 context->hash_values32[ value_index ] );
+		}
+	}
+	if( memory_copy(
+	     hash,
+	     hash_data,
+	     hash_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     hash_data,
+	     0,
+	     LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     context,
+	     0,
+	     sizeof( libluksde_sha_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	memory_set(
+	 hash_data,
+	 0,
+	 LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE );
+
+	return( -1 );
+}
+
+/* Calculates a SHA hash of the buffer in a single call
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_sha_calculate(
+     int hashing_method,
+     const uint8_t *buffer,
+     size_t size,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	libluksde_sha_context_t context;
+
+	static char *function = "libluksde_sha_calculate";
+
+	if( libluksde_sha_initialize(
+	     &context,
+	     hashing_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize context.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_sha_update(
+	     &context,
+	     buffer,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_sha_finalize(
+	     &context,
+	     hash,
+	     hash_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	memory_set(
+	 &context,
+	 0,
+	 sizeof( libluksde_sha_context_t ) );
+
+	return( -1 );
+}
+
@@ -0,0 +1,112 @@
+/*
+ * SHA-1, SHA-224, SHA-256 and SHA-512 functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_SHA_H )
+#define _LIBLUKSDE_SHA_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The largest SHA block size (SHA-512)
+ */
+#define LIBLUKSDE_SHA_MAXIMUM_BLOCK_SIZE		128
+
+/* The largest SHA hash size (SHA-512)
+ */
+#define LIBLUKSDE_SHA_MAXIMUM_HASH_SIZE			64
+
+typedef struct libluksde_sha_context libluksde_sha_context_t;
+
+/* The context does not contain pointers, hence it can be copied
+ * to continue hashing from an intermediate state
+ */
+struct libluksde_sha_context
+{
+	/* The hashing method
+	 */
+	int hashing_method;
+
+	/* The hash size
+	 */
+	size_t hash_size;
+
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The 32-bit hash values, used by SHA-1, SHA-224 and SHA-256
+	 */
+	uint32_t hash_values32[ 8 ];
+
+	/* The 64-bit hash values, used by SHA-512
+	 */
+	uint64_t hash_values64[ 8 ];
+
+	/* The number of bytes processed
+	 */
+	uint64_t number_of_bytes;
+
+	/* The block data
+	 */
+	uint8_t block_data[ LIBLUKSDE_SHA_MAXIMUM_BLOCK_SIZE ];
+
+	/* The block data size
+	 */
+	size_t block_data_size;
+};
+
+int libluksde_sha_initialize(
+     libluksde_sha_context_t *context,
+     int hashing_method,
+     libcerror_error_t **error );
+
+int libluksde_sha_update(
+     libluksde_sha_context_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int libluksde_sha_finalize(
+     libluksde_sha_context_t *context,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+int libluksde_sha_calculate(
+     int hashing_method,
+     const uint8_t *buffer,
+     size_t size,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_SHA_H ) */
+
@@ -0,0 +1,1587 @@
+/*
+ * Spill cache functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libluksde_libbfio.h"
+#include "libluksde_libcerror.h"
+#include "libluksde_libcnotify.h"
+#include "libluksde_spill_cache.h"
+
+#if defined( HAVE_FCNTL_H ) && defined( HAVE_SYS_STAT_H ) && defined( HAVE_UNISTD_H ) && !defined( WINAPI )
+#define LIBLUKSDE_SPILL_CACHE_HAVE_POSIX_FILE_MODE
+#endif
+
+/* Creates a spill cache
+ * Make sure the value spill_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_spill_cache_initialize(
+     libluksde_spill_cache_t **spill_cache,
+     size64_t maximum_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_spill_cache_initialize";
+
+	if( spill_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid spill cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *spill_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid spill cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*spill_cache = memory_allocate_structure(
+	                libluksde_spill_cache_t );
+
+	if( *spill_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create spill cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *spill_cache,
+	     0,
+	     sizeof( libluksde_spill_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear spill cache.",
+		 function );
+
+		goto on_error;
+	}
+	( *spill_cache )->maximum_size             = maximum_size;
+	( *spill_cache )->most_recently_used_slot  = -1;
+	( *spill_cache )->least_recently_used_slot = -1;
+	( *spill_cache )->free_slot                = -1;
+
+	return( 1 );
+
+on_error:
+	if( *spill_cache != NULL )
+	{
+		memory_free(
+		 *spill_cache );
+
+		*spill_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a spill cache
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_spill_cache_free(
+     libluksde_spill_cache_t **spill_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_spill_cache_free";
+	int result            = 1;
+
+	if( spill_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid spill cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *spill_cache != NULL )
+	{
+		if( ( *spill_cache )->is_open != 0 )
+		{
+			if( libluksde_spill_cache_close(
+			     *spill_cache,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close spill cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *spill_cache )->file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( ( *spill_cache )->file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *spill_cache );
+
+		*spill_cache = NULL;
+	}
+	return( result );
+}
+
+/* Sets the name of the spill file
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_spill_cache_set_name(
+     libluksde_spill_cache_t *spill_cache,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_spill_cache_set_name";
+
+	if( spill_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid spill cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( spill_cache->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid spill cache - file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &( spill_cache->file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     spill_cache->file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( spill_cache->file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &( spill_cache->file_io_handle ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the name of the spill file
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_spill_cache_set_name_wide(
+     libluksde_spill_cache_t *spill_cache,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_spill_cache_set_name_wide";
+
+	if( spill_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid spill cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( spill_cache->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid spill cache - file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &( spill_cache->file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name_wide(
+	     spill_cache->file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( spill_cache->file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &( spill_cache->file_io_handle ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Retrieves the name of the spill file
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_spill_cache_get_name(
+     libluksde_spill_cache_t *spill_cache,
+     char **filename,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_spill_cache_get_name";
+	size_t filename_size  = 0;
+
+	if( spill_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid spill cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( *filename != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid filename value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_get_name_size(
+	     spill_cache->file_io_handle,
+	     &filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( filename_size == 0 )
+	 || ( filename_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	*filename = (char *) memory_allocate(
+	                      sizeof( char ) * filename_size );
+
+	if( *filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_get_name(
+	     spill_cache->file_io_handle,
+	     *filename,
+	     filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *filename != NULL )
+	{
+		memory_free(
+		 *filename );
+
+		*filename = NULL;
+	}
+	return( -1 );
+}
+
+#if defined( LIBLUKSDE_SPILL_CACHE_HAVE_POSIX_FILE_MODE )
+
+/* Creates the spill file
+ * The spill file is created only accessible by the owner and must not exist
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_spill_cache_create_file(
+     libluksde_spill_cache_t *spill_cache,
+     libcerror_error_t **error )
+{
+	char *filename        = NULL;
+	static char *function = "libluksde_spill_cache_create_file";
+	int file_descriptor   = -1;
+
+	if( libluksde_spill_cache_get_name(
+	     spill_cache,
+	     &filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename.",
+		 function );
+
+		goto on_error;
+	}
+	file_descriptor = open(
+	                   filename,
+	                   O_RDWR | O_CREAT | O_EXCL,
+	                   S_IRUSR | S_IWUSR );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to create spill file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close spill file.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 filename );
+
+	return( 1 );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	return( -1 );
+}
+
+#endif /* defined( LIBLUKSDE_SPILL_CACHE_HAVE_POSIX_FILE_MODE ) */
+
+/* Removes the spill file
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_spill_cache_remove_file(
+     libluksde_spill_cache_t *spill_cache,
+     libcerror_error_t **error )
+{
+	char *filename        = NULL;
+	static char *function = "libluksde_spill_cache_remove_file";
+
+	if( libluksde_spill_cache_get_name(
+	     spill_cache,
+	     &filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( remove(
+	     filename ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+		 "%s: unable to remove spill file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	memory_free(
+	 filename );
+
+	return( 1 );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	return( -1 );
+}
+
+/* Opens the spill cache
+ * The spill file contains decrypted volume data hence on POSIX platforms
+ * it is created only accessible by the owner, it must not exist and it is
+ * removed directly after it was opened. On other platforms the spill file
+ * is created, or truncated if it already exists, and removed on close
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_spill_cache_open(
+     libluksde_spill_cache_t *spill_cache,
+     size_t chunk_size,
+     size64_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function            = "libluksde_spill_cache_open";
+	size64_t maximum_number_of_slots = 0;
+	size_t chunk_bitmap_size         = 0;
+	int file_io_handle_is_open       = 0;
+	int hash_table_index             = 0;
+	int open_flags                   = 0;
+	int slot_index                   = 0;
+
+	if( spill_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid spill cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( spill_cache->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid spill cache - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( spill_cache->is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid spill cache - already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_slots = spill_cache->maximum_size / chunk_size;
+
+	if( maximum_number_of_slots == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid spill cache - maximum size value smaller than chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	spill_cache->chunk_size       = chunk_size;
+	spill_cache->number_of_chunks = data_size / chunk_size;
+
+	/* Only complete chunks are stored hence no more slots are needed than there are chunks
+	 */
+	if( maximum_number_of_slots > spill_cache->number_of_chunks )
+	{
+		maximum_number_of_slots = spill_cache->number_of_chunks;
+	}
+	/* The slot index hash table contains at least twice the number of slots
+	 */
+	if( maximum_number_of_slots > (size64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / ( 2 * sizeof( int ) ) ) )
+	{
+		maximum_number_of_slots = (size64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / ( 2 * sizeof( int ) ) );
+	}
+	if( maximum_number_of_slots == 0 )
+	{
+		maximum_number_of_slots = 1;
+	}
+	spill_cache->maximum_number_of_slots = (int) maximum_number_of_slots;
+
+	if( spill_cache->number_of_chunks > (uint64_t) ( ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 1 ) * 8 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of chunks value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_bitmap_size = (size_t) ( spill_cache->number_of_chunks / 8 ) + 1;
+
+	spill_cache->chunk_bitmap = (uint8_t *) memory_allocate(
+	                                         sizeof( uint8_t ) * chunk_bitmap_size );
+
+	if( spill_cache->chunk_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     spill_cache->chunk_bitmap,
+	     0,
+	     sizeof( uint8_t ) * chunk_bitmap_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	spill_cache->chunk_data = (uint8_t *) memory_allocate(
+	                                       sizeof( uint8_t ) * chunk_size );
+
+	if( spill_cache->chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	spill_cache->slot_chunk_numbers = (uint64_t *) memory_allocate(
+	                                                sizeof( uint64_t ) * spill_cache->maximum_number_of_slots );
+
+	if( spill_cache->slot_chunk_numbers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create slot chunk numbers.",
+		 function );
+
+		goto on_error;
+	}
+	spill_cache->previous_slots = (int *) memory_allocate(
+	                                       sizeof( int ) * spill_cache->maximum_number_of_slots );
+
+	if( spill_cache->previous_slots == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create previous slots.",
+		 function );
+
+		goto on_error;
+	}
+	spill_cache->next_slots = (int *) memory_allocate(
+	                                   sizeof( int ) * spill_cache->maximum_number_of_slots );
+
+	if( spill_cache->next_slots == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create next slots.",
+		 function );
+
+		goto on_error;
+	}
+	spill_cache->slot_index_hash_table_size = 1;
+
+	while( spill_cache->slot_index_hash_table_size < ( 2 * spill_cache->maximum_number_of_slots ) )
+	{
+		spill_cache->slot_index_hash_table_size *= 2;
+	}
+	spill_cache->slot_index_hash_table = (int *) memory_allocate(
+	                                              sizeof( int ) * spill_cache->slot_index_hash_table_size );
+
+	if( spill_cache->slot_index_hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create slot index hash table.",
+		 function );
+
+		goto on_error;
+	}
+	for( hash_table_index = 0;
+	     hash_table_index < spill_cache->slot_index_hash_table_size;
+	     hash_table_index++ )
+	{
+		spill_cache->slot_index_hash_table[ hash_table_index ] = -1;
+	}
+	for( slot_index = 0;
+	     slot_index < spill_cache->maximum_number_of_slots;
+	     slot_index++ )
+	{
+		spill_cache->previous_slots[ slot_index ] = -1;
+		spill_cache->next_slots[ slot_index ]     = -1;
+	}
+	spill_cache->number_of_slots          = 0;
+	spill_cache->most_recently_used_slot  = -1;
+	spill_cache->least_recently_used_slot = -1;
+	spill_cache->free_slot                = -1;
+
+#if defined( LIBLUKSDE_SPILL_CACHE_HAVE_POSIX_FILE_MODE )
+	if( libluksde_spill_cache_create_file(
+	     spill_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to create spill file.",
+		 function );
+
+		goto on_error;
+	}
+	open_flags = LIBBFIO_OPEN_READ_WRITE;
+#else
+	open_flags = LIBBFIO_OPEN_READ_WRITE_TRUNCATE;
+#endif
+	if( libbfio_handle_open(
+	     spill_cache->file_io_handle,
+	     open_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open spill file.",
+		 function );
+
+#if defined( LIBLUKSDE_SPILL_CACHE_HAVE_POSIX_FILE_MODE )
+		libluksde_spill_cache_remove_file(
+		 spill_cache,
+		 NULL );
+#endif
+		goto on_error;
+	}
+	file_io_handle_is_open = 1;
+
+#if defined( LIBLUKSDE_SPILL_CACHE_HAVE_POSIX_FILE_MODE )
+	/* Remove the spill file while it is open so that its data is not left
+	 * behind once the file is closed, or when the process is terminated
+	 */
+	if( libluksde_spill_cache_remove_file(
+	     spill_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+		 "%s: unable to remove spill file.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: spill cache of %d chunks of %" PRIzd " bytes for %" PRIu64 " chunks.\n",
+		 function,
+		 spill_cache->maximum_number_of_slots,
+		 chunk_size,
+		 spill_cache->number_of_chunks );
+	}
+#endif
+	spill_cache->is_open = 1;
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle_is_open != 0 )
+	{
+		libbfio_handle_close(
+		 spill_cache->file_io_handle,
+		 NULL );
+
+#if !defined( LIBLUKSDE_SPILL_CACHE_HAVE_POSIX_FILE_MODE )
+		libluksde_spill_cache_remove_file(
+		 spill_cache,
+		 NULL );
+#endif
+	}
+	if( spill_cache->slot_index_hash_table != NULL )
+	{
+		memory_free(
+		 spill_cache->slot_index_hash_table );
+
+		spill_cache->slot_index_hash_table = NULL;
+	}
+	if( spill_cache->next_slots != NULL )
+	{
+		memory_free(
+		 spill_cache->next_slots );
+
+		spill_cache->next_slots = NULL;
+	}
+	if( spill_cache->previous_slots != NULL )
+	{
+		memory_free(
+		 spill_cache->previous_slots );
+
+		spill_cache->previous_slots = NULL;
+	}
+	if( spill_cache->slot_chunk_numbers != NULL )
+	{
+		memory_free(
+		 spill_cache->slot_chunk_numbers );
+
+		spill_cache->slot_chunk_numbers = NULL;
+	}
+	if( spill_cache->chunk_data != NULL )
+	{
+		memory_free(
+		 spill_cache->chunk_data );
+
+		spill_cache->chunk_data = NULL;
+	}
+	if( spill_cache->chunk_bitmap != NULL )
+	{
+		memory_free(
+		 spill_cache->chunk_bitmap );
+
+		spill_cache->chunk_bitmap = NULL;
+	}
+	return( -1 );
+}
+
+/* Closes the spill cache
+ * On platforms where the spill file is not removed on open it is removed on close
+ * Returns 0 if successful or -1 on error
+ */
+int libluksde_spill_cache_close(
+     libluksde_spill_cache_t *spill_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_spill_cache_close";
+	int result            = 0;
+
+	if( spill_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid spill cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( spill_cache->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid spill cache - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_close(
+	     spill_cache->file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close spill file.",
+		 function );
+
+		result = -1;
+	}
+#if !defined( LIBLUKSDE_SPILL_CACHE_HAVE_POSIX_FILE_MODE )
+	else if( libluksde_spill_cache_remove_file(
+	          spill_cache,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+		 "%s: unable to remove spill file.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	memory_free(
+	 spill_cache->slot_index_hash_table );
+
+	spill_cache->slot_index_hash_table = NULL;
+
+	memory_free(
+	 spill_cache->next_slots );
+
+	spill_cache->next_slots = NULL;
+
+	memory_free(
+	 spill_cache->previous_slots );
+
+	spill_cache->previous_slots = NULL;
+
+	memory_free(
+	 spill_cache->slot_chunk_numbers );
+
+	spill_cache->slot_chunk_numbers = NULL;
+
+	memory_free(
+	 spill_cache->chunk_data );
+
+	spill_cache->chunk_data = NULL;
+
+	memory_free(
+	 spill_cache->chunk_bitmap );
+
+	spill_cache->chunk_bitmap = NULL;
+
+	spill_cache->number_of_chunks         = 0;
+	spill_cache->number_of_slots          = 0;
+	spill_cache->most_recently_used_slot  = -1;
+	spill_cache->least_recently_used_slot = -1;
+	spill_cache->free_slot                = -1;
+	spill_cache->is_open                  = 0;
+
+	return( result );
+}
+
+/* Retrieves the slot index hash of a chunk number
+ * Returns the index in the slot index hash table
+ */
+int libluksde_spill_cache_get_hash_table_index(
+     libluksde_spill_cache_t *spill_cache,
+     uint64_t chunk_number )
+{
+	uint64_t hash_value = 0;
+
+	/* Fibonacci hashing spreads consecutive chunk numbers over the hash table
+	 */
+	hash_value = chunk_number * 0x9e3779b97f4a7c15ULL;
+
+	return( (int) ( ( hash_value >> 32 ) & (uint64_t) ( spill_cache->slot_index_hash_table_size - 1 ) ) );
+}
+
+/* Retrieves the slot of a specific chunk number
+ * Returns 1 if successful, 0 if the chunk is not stored in the spill file or -1 on error
+ */
+int libluksde_spill_cache_get_slot_by_chunk_number(
+     libluksde_spill_cache_t *spill_cache,
+     uint64_t chunk_number,
+     int *slot_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_spill_cache_get_slot_by_chunk_number";
+	int hash_table_index  = 0;
+	int safe_slot_index   = 0;
+
+	if( spill_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid spill cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( spill_cache->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid spill cache - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_number >= spill_cache->number_of_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( slot_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid slot index.",
+		 function );
+
+		return( -1 );
+	}
+	/* The chunk bitmap is checked first so that a miss does not require a hash table lookup
+	 */
+	if( ( spill_cache->chunk_bitmap[ chunk_number / 8 ] & ( 1 << ( chunk_number % 8 ) ) ) == 0 )
+	{
+		return( 0 );
+	}
+	hash_table_index = libluksde_spill_cache_get_hash_table_index(
+	                    spill_cache,
+	                    chunk_number );
+
+	for( safe_slot_index = spill_cache->slot_index_hash_table[ hash_table_index ];
+	     safe_slot_index != -1;
+	     safe_slot_index = spill_cache->slot_index_hash_table[ hash_table_index ] )
+	{
+		if( spill_cache->slot_chunk_numbers[ safe_slot_index ] == chunk_number )
+		{
+			*slot_index = safe_slot_index;
+
+			return( 1 );
+		}
+		hash_table_index = ( hash_table_index + 1 ) & ( spill_cache->slot_index_hash_table_size - 1 );
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+	 "%s: missing slot of chunk: %" PRIu64 ".",
+	 function,
+	 chunk_number );
+
+	return( -1 );
+}
+
+/* Removes the slot of a chunk number from the slot index hash table
+ * The entries that follow in the same cluster are moved back to keep the linear probing intact
+ */
+void libluksde_spill_cache_remove_slot_index(
+      libluksde_spill_cache_t *spill_cache,
+      uint64_t chunk_number )
+{
+	int hash_table_index = 0;
+	int home_index       = 0;
+	int next_index       = 0;
+
+	hash_table_index = libluksde_spill_cache_get_hash_table_index(
+	                    spill_cache,
+	                    chunk_number );
+
+	while( spill_cache->slot_index_hash_table[ hash_table_index ] != -1 )
+	{
+		if( spill_cache->slot_chunk_numbers[ spill_cache->slot_index_hash_table[ hash_table_index ] ] == chunk_number )
+		{
+			break;
+		}
+		hash_table_index = ( hash_table_index + 1 ) & ( spill_cache->slot_index_hash_table_size - 1 );
+	}
+	if( spill_cache->slot_index_hash_table[ hash_table_index ] == -1 )
+	{
+		return;
+	}
+	next_index = hash_table_index;
+
+	while( 1 )
+	{
+		next_index = ( next_index + 1 ) & ( spill_cache->slot_index_hash_table_size - 1 );
+
+		if( spill_cache->slot_index_hash_table[ next_index ] == -1 )
+		{
+			break;
+		}
+		home_index = libluksde_spill_cache_get_hash_table_index(
+		              spill_cache,
+		              spill_cache->slot_chunk_numbers[ spill_cache->slot_index_hash_table[ next_index ] ] );
+
+		/* Move the entry back if its home index does not lie cyclically between the removed and the next index
+		 */
+		if( ( ( hash_table_index <= next_index )
+		  &&  ( ( home_index <= hash_table_index ) || ( home_index > next_index ) ) )
+		 || ( ( hash_table_index > next_index )
+		  &&  ( home_index <= hash_table_index ) && ( home_index > next_index ) ) )
+		{
+			spill_cache->slot_index_hash_table[ hash_table_index ] = spill_cache->slot_index_hash_table[ next_index ];
+
+			hash_table_index = next_index;
+		}
+	}
+	spill_cache->slot_index_hash_table[ hash_table_index ] = -1;
+}
+
+/* Removes a slot from the least recently used list
+ */
+void libluksde_spill_cache_remove_slot_from_list(
+      libluksde_spill_cache_t *spill_cache,
+      int slot_index )
+{
+	int next_slot_index     = 0;
+	int previous_slot_index = 0;
+
+	previous_slot_index = spill_cache->previous_slots[ slot_index ];
+	next_slot_index     = spill_cache->next_slots[ slot_index ];
+
+	if( previous_slot_index != -1 )
+	{
+		spill_cache->next_slots[ previous_slot_index ] = next_slot_index;
+	}
+	if( next_slot_index != -1 )
+	{
+		spill_cache->previous_slots[ next_slot_index ] = previous_slot_index;
+	}
+	if( spill_cache->most_recently_used_slot == slot_index )
+	{
+		spill_cache->most_recently_used_slot = next_slot_index;
+	}
+	if( spill_cache->least_recently_used_slot == slot_index )
+	{
+		spill_cache->least_recently_used_slot = previous_slot_index;
+	}
+	spill_cache->previous_slots[ slot_index ] = -1;
+	spill_cache->next_slots[ slot_index ]     = -1;
+}
+
+/* Moves a slot to the front of the least recently used list
+ */
+void libluksde_spill_cache_move_slot_to_front(
+      libluksde_spill_cache_t *spill_cache,
+      int slot_index )
+{
+	int next_slot_index     = 0;
+	int previous_slot_index = 0;
+
+	if( spill_cache->most_recently_used_slot == slot_index )
+	{
+		return;
+	}
+	previous_slot_index = spill_cache->previous_slots[ slot_index ];
+	next_slot_index     = spill_cache->next_slots[ slot_index ];
+
+	if( previous_slot_index != -1 )
+	{
+		spill_cache->next_slots[ previous_slot_index ] = next_slot_index;
+	}
+	if( next_slot_index != -1 )
+	{
+		spill_cache->previous_slots[ next_slot_index ] = previous_slot_index;
+	}
+	if( spill_cache->least_recently_used_slot == slot_index )
+	{
+		spill_cache->least_recently_used_slot = previous_slot_index;
+	}
+	spill_cache->previous_slots[ slot_index ] = -1;
+	spill_cache->next_slots[ slot_index ]     = spill_cache->most_recently_used_slot;
+
+	if( spill_cache->most_recently_used_slot != -1 )
+	{
+		spill_cache->previous_slots[ spill_cache->most_recently_used_slot ] = slot_index;
+	}
+	spill_cache->most_recently_used_slot = slot_index;
+
+	if( spill_cache->least_recently_used_slot == -1 )
+	{
+		spill_cache->least_recently_used_slot = slot_index;
+	}
+}
+
+/* Reads data of a chunk from the spill file
+ * Returns 1 if successful, 0 if the chunk is not stored in the spill file or -1 on error
+ */
+int libluksde_spill_cache_read_chunk_data(
+     libluksde_spill_cache_t *spill_cache,
+     uint64_t chunk_number,
+     size_t chunk_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_spill_cache_read_chunk_data";
+	ssize_t read_count    = 0;
+	off64_t file_offset   = 0;
+	int result            = 0;
+	int slot_index        = 0;
+
+	if( spill_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid spill cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset >= spill_cache->chunk_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > ( spill_cache->chunk_size - chunk_data_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libluksde_spill_cache_get_slot_by_chunk_number(
+	          spill_cache,
+	          chunk_number,
+	          &slot_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve slot of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_number );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	file_offset = ( (off64_t) slot_index * spill_cache->chunk_size ) + chunk_data_offset;
+
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              spill_cache->file_io_handle,
+	              buffer,
+	              buffer_size,
+	              file_offset,
+	              error );
+
+	if( read_count != (ssize_t) buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data from spill file at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 chunk_number,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	libluksde_spill_cache_move_slot_to_front(
+	 spill_cache,
+	 slot_index );
+
+	return( 1 );
+}
+
+/* Writes the data of a chunk to the spill file
+ * The least recently used chunk is evicted if the spill file is full
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_spill_cache_write_chunk_data(
+     libluksde_spill_cache_t *spill_cache,
+     uint64_t chunk_number,
+     const uint8_t *chunk_data,
+     size_t chunk_data_size,
+     libcerror_error_t **error )
+{
+	static char *function         = "libluksde_spill_cache_write_chunk_data";
+	uint64_t evicted_chunk_number = 0;
+	ssize_t write_count           = 0;
+	off64_t file_offset           = 0;
+	int hash_table_index          = 0;
+	int result                    = 0;
+	int slot_index                = 0;
+	int slot_is_new               = 0;
+
+	if( spill_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid spill cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size != spill_cache->chunk_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libluksde_spill_cache_get_slot_by_chunk_number(
+	          spill_cache,
+	          chunk_number,
+	          &slot_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve slot of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_number );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		if( spill_cache->free_slot != -1 )
+		{
+			/* Reuse a slot that was released after a failed write
+			 */
+			slot_index             = spill_cache->free_slot;
+			spill_cache->free_slot = spill_cache->next_slots[ slot_index ];
+
+			spill_cache->next_slots[ slot_index ] = -1;
+		}
+		else if( spill_cache->number_of_slots < spill_cache->maximum_number_of_slots )
+		{
+			slot_index  = spill_cache->number_of_slots;
+			slot_is_new = 1;
+
+			spill_cache->number_of_slots += 1;
+		}
+		else
+		{
+			/* Evict the least recently used chunk and reuse its slot
+			 */
+			slot_index           = spill_cache->least_recently_used_slot;
+			evicted_chunk_number = spill_cache->slot_chunk_numbers[ slot_index ];
+
+			libluksde_spill_cache_remove_slot_index(
+			 spill_cache,
+			 evicted_chunk_number );
+
+			spill_cache->chunk_bitmap[ evicted_chunk_number / 8 ] &= (uint8_t) ~( 1 << ( evicted_chunk_number % 8 ) );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: evicted chunk: %" PRIu64 " from slot: %d.\n",
+				 function,
+				 evicted_chunk_number,
+				 slot_index );
+			}
+#endif
+		}
+		spill_cache->slot_chunk_numbers[ slot_index ] = chunk_number;
+
+		hash_table_index = libluksde_spill_cache_get_hash_table_index(
+		                    spill_cache,
+		                    chunk_number );
+
+		while( spill_cache->slot_index_hash_table[ hash_table_index ] != -1 )
+		{
+			hash_table_index = ( hash_table_index + 1 ) & ( spill_cache->slot_index_hash_table_size - 1 );
+		}
+		spill_cache->slot_index_hash_table[ hash_table_index ] = slot_index;
+	}
+	/* The chunk is not marked as stored until its data was written
+	 */
+	spill_cache->chunk_bitmap[ chunk_number / 8 ] &= (uint8_t) ~( 1 << ( chunk_number % 8 ) );
+
+	libluksde_spill_cache_move_slot_to_front(
+	 spill_cache,
+	 slot_index );
+
+	file_offset = (off64_t) slot_index * spill_cache->chunk_size;
+
+	write_count = libbfio_handle_write_buffer_at_offset(
+	               spill_cache->file_io_handle,
+	               chunk_data,
+	               chunk_data_size,
+	               file_offset,
+	               error );
+
+	if( write_count != (ssize_t) chunk_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk: %" PRIu64 " data to spill file at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 chunk_number,
+		 file_offset,
+		 file_offset );
+
+		goto on_error;
+	}
+	spill_cache->chunk_bitmap[ chunk_number / 8 ] |= (uint8_t) ( 1 << ( chunk_number % 8 ) );
+
+	return( 1 );
+
+on_error:
+	/* Release the slot so that the slot index hash table does not retain
+	 * an entry of a chunk that is not stored in the spill file
+	 */
+	libluksde_spill_cache_remove_slot_index(
+	 spill_cache,
+	 chunk_number );
+
+	libluksde_spill_cache_remove_slot_from_list(
+	 spill_cache,
+	 slot_index );
+
+	if( slot_is_new != 0 )
+	{
+		spill_cache->number_of_slots -= 1;
+	}
+	else
+	{
+		spill_cache->next_slots[ slot_index ] = spill_cache->free_slot;
+		spill_cache->free_slot                = slot_index;
+	}
+	return( -1 );
+}
+
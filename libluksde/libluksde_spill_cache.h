@@ -0,0 +1,203 @@
+/*
+ * Spill cache functions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBLUKSDE_SPILL_CACHE_H )
+#define _LIBLUKSDE_SPILL_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libluksde_libbfio.h"
+#include "libluksde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libluksde_spill_cache libluksde_spill_cache_t;
+
+struct libluksde_spill_cache
+{
+	/* The file IO handle of the spill file
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The maximum size of the spill file
+	 */
+	size64_t maximum_size;
+
+	/* The chunk size
+	 */
+	size_t chunk_size;
+
+	/* The number of chunks
+	 */
+	uint64_t number_of_chunks;
+
+	/* The chunk bitmap
+	 * Contains a bit per chunk that is set if the chunk is stored in the spill file
+	 */
+	uint8_t *chunk_bitmap;
+
+	/* The chunk data
+	 * Used to decrypt a chunk before it is stored in the spill file
+	 */
+	uint8_t *chunk_data;
+
+	/* The number of slots in the spill file
+	 */
+	int number_of_slots;
+
+	/* The maximum number of slots in the spill file
+	 */
+	int maximum_number_of_slots;
+
+	/* The chunk number stored in each slot
+	 */
+	uint64_t *slot_chunk_numbers;
+
+	/* The previous more recently used slot of each slot
+	 */
+	int *previous_slots;
+
+	/* The next less recently used slot of each slot
+	 */
+	int *next_slots;
+
+	/* The most recently used slot
+	 */
+	int most_recently_used_slot;
+
+	/* The least recently used slot
+	 */
+	int least_recently_used_slot;
+
+	/* The first free slot
+	 * Free slots were released after a failed write and are linked using the next slots
+	 */
+	int free_slot;
+
+	/* The slot index hash table
+	 * Maps a chunk number to its slot using linear probing
+	 */
+	int *slot_index_hash_table;
+
+	/* The number of entries in the slot index hash table
+	 * Contains a power of 2
+	 */
+	int slot_index_hash_table_size;
+
+	/* Value to indicate the spill cache is open
+	 */
+	uint8_t is_open;
+};
+
+int libluksde_spill_cache_initialize(
+     libluksde_spill_cache_t **spill_cache,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+int libluksde_spill_cache_free(
+     libluksde_spill_cache_t **spill_cache,
+     libcerror_error_t **error );
+
+int libluksde_spill_cache_set_name(
+     libluksde_spill_cache_t *spill_cache,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+int libluksde_spill_cache_set_name_wide(
+     libluksde_spill_cache_t *spill_cache,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libluksde_spill_cache_get_name(
+     libluksde_spill_cache_t *spill_cache,
+     char **filename,
+     libcerror_error_t **error );
+
+int libluksde_spill_cache_create_file(
+     libluksde_spill_cache_t *spill_cache,
+     libcerror_error_t **error );
+
+int libluksde_spill_cache_remove_file(
+     libluksde_spill_cache_t *spill_cache,
+     libcerror_error_t **error );
+
+int libluksde_spill_cache_open(
+     libluksde_spill_cache_t *spill_cache,
+     size_t chunk_size,
+     size64_t data_size,
+     libcerror_error_t **error );
+
+int libluksde_spill_cache_close(
+     libluksde_spill_cache_t *spill_cache,
+     libcerror_error_t **error );
+
+int libluksde_spill_cache_get_hash_table_index(
+     libluksde_spill_cache_t *spill_cache,
+     uint64_t chunk_number );
+
+void libluksde_spill_cache_remove_slot_index(
+      libluksde_spill_cache_t *spill_cache,
+      uint64_t chunk_number );
+
+void libluksde_spill_cache_remove_slot_from_list(
+      libluksde_spill_cache_t *spill_cache,
+      int slot_index );
+
+void libluksde_spill_cache_move_slot_to_front(
+      libluksde_spill_cache_t *spill_cache,
+      int slot_index );
+
+int libluksde_spill_cache_get_slot_by_chunk_number(
+     libluksde_spill_cache_t *spill_cache,
+     uint64_t chunk_number,
+     int *slot_index,
+     libcerror_error_t **error );
+
+int libluksde_spill_cache_read_chunk_data(
+     libluksde_spill_cache_t *spill_cache,
+     uint64_t chunk_number,
+     size_t chunk_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libluksde_spill_cache_write_chunk_data(
+     libluksde_spill_cache_t *spill_cache,
+     uint64_t chunk_number,
+     const uint8_t *chunk_data,
+     size_t chunk_data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBLUKSDE_SPILL_CACHE_H ) */
+
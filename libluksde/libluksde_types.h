@@ -41,6 +41,52 @@ typedef intptr_t libluksde_volume_t;
 
 #endif /* defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI ) */
 
+/* The I/O vector used by libluksde_volume_read_vectors
+ */
+typedef struct libluksde_iovec libluksde_iovec_t;
+
+struct libluksde_iovec
+{
+	/* The buffer
+	 */
+	void *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The (volume) offset
+	 */
+	off64_t offset;
+};
+
+/* The I/O callbacks used by libluksde_volume_open_io_callbacks
+ */
+typedef struct libluksde_io_callbacks libluksde_io_callbacks_t;
+
+struct libluksde_io_callbacks
+{
+	/* The function that reads data at a specific offset, like pread
+	 * Returns the number of bytes read, 0 at the end of the data or -1 on error
+	 */
+	ssize_t (*read_at_offset)(
+	           void *user_data,
+	           uint8_t *buffer,
+	           size_t size,
+	           off64_t offset );
+
+	/* The function that retrieves the size of the data
+	 * Returns 1 if successful or -1 on error
+	 */
+	int (*get_size)(
+	       void *user_data,
+	       size64_t *size );
+
+	/* The user data that is passed to the functions
+	 */
+	void *user_data;
+};
+
 #endif /* defined( HAVE_LOCAL_LIBLUKSDE ) */
 
 #endif /* !defined( _LIBLUKSDE_INTERNAL_TYPES_H ) */
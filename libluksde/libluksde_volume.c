@@ -25,10 +25,19 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "libluksde_argon2.h"
+#include "libluksde_allocation_map.h"
+#include "libluksde_block_device.h"
+#include "libluksde_callbacks_io_handle.h"
 #include "libluksde_codepage.h"
+#include "libluksde_data_signature.h"
 #include "libluksde_debug.h"
 #include "libluksde_definitions.h"
 #include "libluksde_diffuser.h"
+#include "libluksde_digest.h"
+#include "libluksde_direct_io_handle.h"
+#include "libluksde_file_io_handle_pool.h"
+#include "libluksde_file_mapping.h"
 #include "libluksde_io_handle.h"
 #include "libluksde_key_slot.h"
 #include "libluksde_libbfio.h"
@@ -37,9 +46,14 @@
 #include "libluksde_libcthreads.h"
 #include "libluksde_libhmac.h"
 #include "libluksde_libuna.h"
+#include "libluksde_master_key_cache.h"
 #include "libluksde_password.h"
+#include "libluksde_read_queue.h"
+#include "libluksde_read_request.h"
 #include "libluksde_sector_data.h"
 #include "libluksde_sector_data_vector.h"
+#include "libluksde_segment_map.h"
+#include "libluksde_spill_cache.h"
 #include "libluksde_volume.h"
 #include "libluksde_volume_header.h"
 
@@ -135,7 +149,8 @@ int libluksde_volume_initialize(
 		goto on_error;
 	}
 #endif
-	internal_volume->is_locked = 1;
+	internal_volume->is_locked        = 1;
+	internal_volume->token_identifier = -1;
 
 	*volume = (libluksde_volume_t *) internal_volume;
 
@@ -228,6 +243,22 @@ int libluksde_volume_free(
 
 			result = -1;
 		}
+		if( internal_volume->master_key_cache != NULL )
+		{
+			if( libluksde_master_key_cache_free(
+			     &( internal_volume->master_key_cache ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free master key cache.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( internal_volume->user_password != NULL )
 		{
 			if( memory_set(
@@ -247,6 +278,38 @@ int libluksde_volume_free(
 			memory_free(
 			 internal_volume->user_password );
 		}
+		if( internal_volume->keyfile != NULL )
+		{
+			if( libluksde_keyfile_free(
+			     &( internal_volume->keyfile ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free keyfile.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( internal_volume->spill_cache != NULL )
+		{
+			if( libluksde_spill_cache_free(
+			     &( internal_volume->spill_cache ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free spill cache.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 internal_volume );
 	}
@@ -302,9 +365,17 @@ int libluksde_volume_open(
      libcerror_error_t **error )
 {
 	libbfio_handle_t *file_io_handle             = NULL;
+	libluksde_file_mapping_t *file_mapping       = NULL;
 	libluksde_internal_volume_t *internal_volume = NULL;
+	libluksde_io_uring_t *io_uring               = NULL;
 	static char *function                        = "libluksde_volume_open";
+	size64_t device_size                         = 0;
 	size_t filename_length                       = 0;
+	uint32_t logical_block_size                  = 0;
+	uint32_t minimum_io_size                     = 0;
+	uint32_t optimal_io_size                     = 0;
+	int is_block_device                          = 0;
+	int result                                   = 0;
 
 	if( volume == NULL )
 	{
@@ -367,18 +438,78 @@ int libluksde_volume_open(
 
 		goto on_error;
 	}
-	if( libbfio_file_initialize(
-	     &file_io_handle,
-	     error ) != 1 )
+	if( ( ( access_flags & LIBLUKSDE_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	 && ( ( access_flags & LIBLUKSDE_ACCESS_FLAG_MEMORY_MAPPED ) != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: direct I/O cannot be combined with memory mapped access.",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+	if( ( ( access_flags & LIBLUKSDE_ACCESS_FLAG_IO_URING ) != 0 )
+	 && ( ( access_flags & ( LIBLUKSDE_ACCESS_FLAG_MEMORY_MAPPED | LIBLUKSDE_ACCESS_FLAG_DIRECT_IO ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: io_uring cannot be combined with memory mapped or direct I/O access.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		if( libluksde_direct_file_initialize(
+		     &file_io_handle,
+		     filename,
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create direct I/O file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( libbfio_file_initialize(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_file_set_name(
+		     file_io_handle,
+		     filename,
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set filename in file IO handle.",
+			 function );
+
+			goto on_error;
+		}
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libbfio_handle_set_track_offsets_read(
@@ -396,25 +527,144 @@ int libluksde_volume_open(
 		goto on_error;
 	}
 #endif
-	if( libbfio_file_set_name(
-	     file_io_handle,
-	     filename,
-	     filename_length,
-	     error ) != 1 )
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_MEMORY_MAPPED ) != 0 )
 	{
-                libcerror_error_set(
-                 error,
-                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-                 "%s: unable to set filename in file IO handle.",
-                 function );
+		if( libluksde_file_mapping_initialize(
+		     &file_mapping,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file mapping.",
+			 function );
+
+			goto on_error;
+		}
+		if( libluksde_file_mapping_open(
+		     file_mapping,
+		     filename,
+		     access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file mapping: %s.",
+			 function,
+			 filename );
+
+			goto on_error;
+		}
+	}
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_IO_URING ) != 0 )
+	{
+		if( libluksde_io_uring_initialize(
+		     &io_uring,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create io_uring.",
+			 function );
+
+			goto on_error;
+		}
+		result = libluksde_io_uring_open(
+		          io_uring,
+		          filename,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open io_uring: %s.",
+			 function,
+			 filename );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			/* Fall back to reading the volume data with the file IO handle
+			 * if the kernel does not support io_uring
+			 */
+			if( libluksde_io_uring_free(
+			     &io_uring,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free io_uring.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	is_block_device = libluksde_block_device_get_io_values_by_name(
+	                   filename,
+	                   &device_size,
+	                   &logical_block_size,
+	                   &minimum_io_size,
+	                   &optimal_io_size,
+	                   error );
+
+	if( is_block_device == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if file: %s is a block device.",
+		 function,
+		 filename );
 
 		goto on_error;
 	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( ( is_block_device != 0 )
+	 && ( libcnotify_verbose != 0 ) )
+	{
+		libcnotify_printf(
+		 "%s: block device size\t\t\t: %" PRIu64 "\n",
+		 function,
+		 device_size );
+
+		libcnotify_printf(
+		 "%s: block device logical block size\t: %" PRIu32 "\n",
+		 function,
+		 logical_block_size );
+
+		libcnotify_printf(
+		 "%s: block device minimum I/O size\t: %" PRIu32 "\n",
+		 function,
+		 minimum_io_size );
+
+		libcnotify_printf(
+		 "%s: block device optimal I/O size\t: %" PRIu32 "\n",
+		 function,
+		 optimal_io_size );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	/* The memory mapped, direct I/O, sparse and io_uring access is handled here and not by the file IO handle
+	 */
 	if( libluksde_volume_open_file_io_handle(
 	     volume,
 	     file_io_handle,
-	     access_flags,
+	     access_flags & ~( LIBLUKSDE_ACCESS_FLAG_MEMORY_MAPPED | LIBLUKSDE_ACCESS_FLAG_RANDOM_ACCESS | LIBLUKSDE_ACCESS_FLAG_DIRECT_IO | LIBLUKSDE_ACCESS_FLAG_SKIP_UNALLOCATED | LIBLUKSDE_ACCESS_FLAG_IO_URING ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -443,7 +693,56 @@ int libluksde_volume_open(
 	}
 #endif
 	internal_volume->file_io_handle_created_in_library = 1;
+	internal_volume->file_mapping                      = file_mapping;
+	internal_volume->io_uring                          = io_uring;
+
+	/* Align the reads of consecutive sectors to the I/O size of the block device
+	 */
+	if( is_block_device != 0 )
+	{
+		if( libluksde_io_handle_set_device_io_values(
+		     internal_volume->io_handle,
+		     minimum_io_size,
+		     optimal_io_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set device I/O values in IO handle.",
+			 function );
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+			libcthreads_read_write_lock_release_for_write(
+			 internal_volume->read_write_lock,
+			 NULL );
+#endif
+			return( -1 );
+		}
+	}
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_SKIP_UNALLOCATED ) != 0 )
+	{
+		if( libluksde_internal_volume_read_allocation_map(
+		     internal_volume,
+		     filename,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read allocation map.",
+			 function );
 
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+			libcthreads_read_write_lock_release_for_write(
+			 internal_volume->read_write_lock,
+			 NULL );
+#endif
+			return( -1 );
+		}
+	}
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -462,6 +761,18 @@ int libluksde_volume_open(
 	return( 1 );
 
 on_error:
+	if( io_uring != NULL )
+	{
+		libluksde_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	if( file_mapping != NULL )
+	{
+		libluksde_file_mapping_free(
+		 &file_mapping,
+		 NULL );
+	}
 	if( file_io_handle != NULL )
 	{
 		libbfio_handle_free(
@@ -534,6 +845,50 @@ int libluksde_volume_open_wide(
 
 		return( -1 );
 	}
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_MEMORY_MAPPED ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: memory mapped access currently not supported.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: direct I/O access currently not supported.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_SKIP_UNALLOCATED ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: skipping unallocated regions currently not supported.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_IO_URING ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: io_uring access currently not supported.",
+		 function );
+
+		return( -1 );
+	}
 	filename_length = wide_string_length(
 	                   filename );
 
@@ -728,6 +1083,50 @@ int libluksde_volume_open_file_io_handle(
 
 		return( -1 );
 	}
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_MEMORY_MAPPED ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: memory mapped access currently not supported.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: direct I/O access currently not supported.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_SKIP_UNALLOCATED ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: skipping unallocated regions currently not supported.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_IO_URING ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: io_uring access currently not supported.",
+		 function );
+
+		return( -1 );
+	}
 	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_READ ) != 0 )
 	{
 		bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
@@ -780,9 +1179,14 @@ int libluksde_volume_open_file_io_handle(
 		return( -1 );
 	}
 #endif
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_METADATA_ONLY ) != 0 )
+	{
+		internal_volume->metadata_only = 1;
+	}
 	if( libluksde_internal_volume_open_read(
 	     internal_volume,
 	     file_io_handle,
+	     file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -792,6 +1196,8 @@ int libluksde_volume_open_file_io_handle(
 		 "%s: unable to read from volume handle.",
 		 function );
 
+		internal_volume->metadata_only = 0;
+
 		result = -1;
 	}
 	else
@@ -830,16 +1236,26 @@ on_error:
 	return( -1 );
 }
 
-/* Closes a volume
- * Returns 0 if successful or -1 on error
+/* Opens a volume with a detached header using Basic File IO (bfio) handles
+ * The header file IO handle contains the LUKS header and key material
+ * The data file IO handle contains the encrypted volume data, where the offsets
+ * of the segments are relative to the start of the data file IO handle
+ * Returns 1 if successful or -1 on error
  */
-int libluksde_volume_close(
+int libluksde_volume_open_file_io_handles(
      libluksde_volume_t *volume,
+     libbfio_handle_t *header_file_io_handle,
+     libbfio_handle_t *data_file_io_handle,
+     int access_flags,
      libcerror_error_t **error )
 {
-	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_close";
-	int result                                   = 0;
+	libluksde_internal_volume_t *internal_volume    = NULL;
+	static char *function                           = "libluksde_volume_open_file_io_handles";
+	uint8_t data_file_io_handle_opened_in_library   = 0;
+	uint8_t header_file_io_handle_opened_in_library = 0;
+	int bfio_access_flags                           = 0;
+	int file_io_handle_is_open                      = 0;
+	int result                                      = 1;
 
 	if( volume == NULL )
 	{
@@ -854,412 +1270,294 @@ int libluksde_volume_close(
 	}
 	internal_volume = (libluksde_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
+	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->file_io_handle == NULL )
+	if( internal_volume->header_file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing file IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - header file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( header_file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid header file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		if( internal_volume->file_io_handle_created_in_library != 0 )
-		{
-			if( libluksde_debug_print_read_offsets(
-			     internal_volume->file_io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print the read offsets.",
-				 function );
-			}
-		}
-	}
-#endif
-	if( internal_volume->file_io_handle_opened_in_library != 0 )
-	{
-		if( libbfio_handle_close(
-		     internal_volume->file_io_handle,
-		     error ) != 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close file IO handle.",
-			 function );
-
-			result = -1;
-		}
-		internal_volume->file_io_handle_opened_in_library = 0;
-	}
-	if( internal_volume->file_io_handle_created_in_library != 0 )
-	{
-		if( libbfio_handle_free(
-		     &( internal_volume->file_io_handle ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file IO handle.",
-			 function );
-
-			result = -1;
-		}
-		internal_volume->file_io_handle_created_in_library = 0;
-	}
-	internal_volume->file_io_handle = NULL;
-	internal_volume->current_offset = 0;
-	internal_volume->is_locked      = 1;
-
-	if( libluksde_io_handle_clear(
-	     internal_volume->io_handle,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear IO handle.",
-		 function );
-
-		result = -1;
-	}
-	if( libluksde_volume_header_free(
-	     &( internal_volume->volume_header ),
-	     error ) != 1 )
+	if( data_file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free volume header.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data file IO handle.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( memory_set(
-	     internal_volume->master_key,
-	     0,
-	     32 ) == NULL )
+	if( header_file_io_handle == data_file_io_handle )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear master key.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid header file IO handle value same as data file IO handle.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( libluksde_sector_data_vector_free(
-	     &( internal_volume->sector_data_vector ),
-	     error ) != 1 )
+	if( ( ( access_flags & LIBLUKSDE_ACCESS_FLAG_READ ) == 0 )
+	 && ( ( access_flags & LIBLUKSDE_ACCESS_FLAG_WRITE ) == 0 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free sector data vector.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
 		 function );
 
-		result = -1;
-	}
-	if( internal_volume->encryption_context != NULL )
-	{
-		if( libluksde_encryption_context_free(
-		     &( internal_volume->encryption_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free encryption context.",
-			 function );
-
-			result = -1;
-		}
+		return( -1 );
 	}
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_WRITE ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( result );
-}
-
-/* Opens a volume for reading
- * Returns 1 if successful or -1 on error
- */
-int libluksde_internal_volume_open_read(
-     libluksde_internal_volume_t *internal_volume,
-     libbfio_handle_t *file_io_handle,
-     libcerror_error_t **error )
-{
-	static char *function = "libluksde_internal_volume_open_read";
-	int result            = 0;
-
-	if( internal_volume == NULL )
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_MEMORY_MAPPED ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: memory mapped access currently not supported.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->io_handle == NULL )
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_DIRECT_IO ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: direct I/O access currently not supported.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->io_handle->bytes_per_sector == 0 )
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_SKIP_UNALLOCATED ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - invalid IO handle - missing bytes per sector.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: skipping unallocated regions currently not supported.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->volume_header != NULL )
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_IO_URING ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid volume - volume header value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: io_uring access currently not supported.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->sector_data_vector != NULL )
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_READ ) != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid volume - sector data vector value already set.",
-		 function );
-
-		return( -1 );
+		bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
 	}
-	if( libbfio_handle_get_size(
-	     file_io_handle,
-	     &( internal_volume->io_handle->volume_size ),
-	     error ) == -1 )
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          header_file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to determine volume size.",
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to determine if header file IO handle is open.",
 		 function );
 
 		goto on_error;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	else if( file_io_handle_is_open == 0 )
 	{
-		libcnotify_printf(
-		 "Reading LUKS volume header:\n" );
-	}
-#endif
-	if( libluksde_volume_header_initialize(
-	     &( internal_volume->volume_header ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create volume header.",
-		 function );
+		if( libbfio_handle_open(
+		     header_file_io_handle,
+		     bfio_access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open header file IO handle.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
+		header_file_io_handle_opened_in_library = 1;
 	}
-	if( libluksde_volume_header_read_file_io_handle(
-	     internal_volume->volume_header,
-	     file_io_handle,
-	     0,
-	     error ) != 1 )
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          data_file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read volume header.",
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to determine if data file IO handle is open.",
 		 function );
 
 		goto on_error;
 	}
-	if( ( internal_volume->volume_header->master_key_size == 0 )
-	 || ( internal_volume->volume_header->master_key_size > 64 ) )
+	else if( file_io_handle_is_open == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid master key size value out of bounds.",
-		 function );
+		if( libbfio_handle_open(
+		     data_file_io_handle,
+		     bfio_access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open data file IO handle.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
+		data_file_io_handle_opened_in_library = 1;
 	}
-	internal_volume->master_key_size = internal_volume->volume_header->master_key_size;
-
-	if( internal_volume->volume_header->encrypted_volume_start_sector >= ( internal_volume->io_handle->volume_size / internal_volume->io_handle->bytes_per_sector ) )
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid encrypted volume start sector value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		goto on_error;
 	}
-	internal_volume->io_handle->encrypted_volume_offset = internal_volume->volume_header->encrypted_volume_start_sector
-	                                                    * internal_volume->io_handle->bytes_per_sector;
-
-	internal_volume->io_handle->encrypted_volume_size = internal_volume->io_handle->volume_size
-	                                                  - internal_volume->io_handle->encrypted_volume_offset;
-
-	result = libluksde_internal_volume_unlock(
-	          internal_volume,
-	          file_io_handle,
-	          error );
-
-	if( result == -1 )
+#endif
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_METADATA_ONLY ) != 0 )
+	{
+		internal_volume->metadata_only = 1;
+	}
+	if( libluksde_internal_volume_open_read(
+	     internal_volume,
+	     header_file_io_handle,
+	     data_file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to unlock volume.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from volume handles.",
 		 function );
 
-		goto on_error;
+		internal_volume->metadata_only = 0;
+
+		result = -1;
 	}
-	if( libluksde_sector_data_vector_initialize(
-	     &( internal_volume->sector_data_vector ),
-	     (size64_t) internal_volume->io_handle->bytes_per_sector,
-	     internal_volume->io_handle->encrypted_volume_offset,
-	     internal_volume->io_handle->volume_size,
+	else
+	{
+		internal_volume->header_file_io_handle                   = header_file_io_handle;
+		internal_volume->header_file_io_handle_opened_in_library = header_file_io_handle_opened_in_library;
+		internal_volume->file_io_handle                          = data_file_io_handle;
+		internal_volume->file_io_handle_opened_in_library        = data_file_io_handle_opened_in_library;
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sectors vector.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
+		return( -1 );
+	}
+#endif
+	if( result == -1 )
+	{
 		goto on_error;
 	}
 	return( 1 );
 
 on_error:
-	if( internal_volume->sector_data_vector != NULL )
-	{
-		libluksde_sector_data_vector_free(
-		 &( internal_volume->sector_data_vector ),
-		 NULL );
-	}
-	if( internal_volume->encryption_context != NULL )
+	if( data_file_io_handle_opened_in_library != 0 )
 	{
-		libluksde_encryption_context_free(
-		 &( internal_volume->encryption_context ),
+		libbfio_handle_close(
+		 data_file_io_handle,
 		 NULL );
 	}
-	if( internal_volume->volume_header != NULL )
+	if( header_file_io_handle_opened_in_library != 0 )
 	{
-		libluksde_volume_header_free(
-		 &( internal_volume->volume_header ),
+		libbfio_handle_close(
+		 header_file_io_handle,
 		 NULL );
 	}
 	return( -1 );
 }
 
-/* Reads the keys from when unlocking the volume
- * Returns 1 if successful, 0 if not or -1 on error
+/* Opens a volume using I/O callbacks
+ * The volume data is read using the I/O callbacks directly instead of a Basic File IO (bfio) handle
+ * Returns 1 if successful or -1 on error
  */
-int libluksde_internal_volume_open_read_keys(
-     libluksde_internal_volume_t *internal_volume,
-     libbfio_handle_t *file_io_handle,
+int libluksde_volume_open_io_callbacks(
+     libluksde_volume_t *volume,
+     const libluksde_io_callbacks_t *io_callbacks,
+     int access_flags,
      libcerror_error_t **error )
 {
-	uint8_t master_key_validation_hash[ 20 ];
-	uint8_t user_key[ 32 ];
-
-	libluksde_encryption_context_t *user_key_encryption_context = NULL;
-	libluksde_key_slot_t *key_slot                              = NULL;
-	uint8_t *key_material_data                                  = NULL;
-	uint8_t *split_master_key_data                              = NULL;
-	static char *function                                       = "libluksde_internal_volume_open_read_keys";
-	size_t key_material_data_offset                             = 0;
-	size_t key_material_size                                    = 0;
-	ssize_t read_count                                          = 0;
-	uint64_t key_material_block_key                             = 0;
-	int key_slot_index                                          = 0;
+	libbfio_handle_t *file_io_handle             = NULL;
+	libluksde_internal_volume_t *internal_volume = NULL;
+	libluksde_io_callbacks_t *safe_io_callbacks  = NULL;
+	static char *function                        = "libluksde_volume_open_io_callbacks";
 
-	if( internal_volume == NULL )
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1270,550 +1568,6599 @@ int libluksde_internal_volume_open_read_keys(
 
 		return( -1 );
 	}
-	if( internal_volume->io_handle == NULL )
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( io_callbacks == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid I/O callbacks.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->io_handle->bytes_per_sector == 0 )
+	if( ( io_callbacks->read_at_offset == NULL )
+	 || ( io_callbacks->get_size == NULL ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - invalid IO handle - missing bytes per sector.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid I/O callbacks - missing function.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->volume_header == NULL )
+	if( ( ( access_flags & LIBLUKSDE_ACCESS_FLAG_READ ) == 0 )
+	 && ( ( access_flags & LIBLUKSDE_ACCESS_FLAG_WRITE ) == 0 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing volume header.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->volume_master_key_is_set != 0 )
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_WRITE ) != 0 )
 	{
-		if( libluksde_password_pbkdf2(
-		     internal_volume->master_key,
-		     internal_volume->master_key_size,
-		     internal_volume->volume_header->hashing_method,
-		     internal_volume->volume_header->master_key_salt,
-		     32,
-		     internal_volume->volume_header->master_key_number_of_iterations,
-		     master_key_validation_hash,
-		     20,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine master key validation hash.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported.",
+		 function );
 
-			goto on_error;
-		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: master key validation hash data:\n",
-			 function );
-			libcnotify_print_data(
-			 master_key_validation_hash,
-			 20,
-			 0 );
-		}
-#endif
-		if( memory_compare(
-		     master_key_validation_hash,
-		     internal_volume->volume_header->master_key_validation_hash,
-		     20 ) == 0 )
-		{
-			internal_volume->volume_master_key_is_set = 1;
-		}
-		else
-		{
-			internal_volume->volume_master_key_is_set = 0;
-		}
+		return( -1 );
 	}
-	if( ( internal_volume->volume_master_key_is_set == 0 )
-	 && ( internal_volume->user_password_is_set != 0 ) )
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_MEMORY_MAPPED ) != 0 )
 	{
-		for( key_slot_index = 0;
-		     key_slot_index < 8;
-		     key_slot_index++ )
-		{
-			if( libcdata_array_get_entry_by_index(
-			     internal_volume->volume_header->key_slots_array,
-			     key_slot_index,
-			     (intptr_t **) &key_slot,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve key slot: %d.",
-				 function,
-				 key_slot_index );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: memory mapped access currently not supported.",
+		 function );
 
-				goto on_error;
-			}
-			if( key_slot == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing key slot: %d.",
-				 function,
-				 key_slot_index );
+		return( -1 );
+	}
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: direct I/O access currently not supported.",
+		 function );
 
-				goto on_error;
-			}
-			if( key_slot->state != 0x00ac71f3 )
-			{
-				continue;
-			}
-			if( internal_volume->user_password_is_set != 0 )
-			{
-				if( libluksde_password_pbkdf2(
-				     internal_volume->user_password,
-				     internal_volume->user_password_size - 1,
-				     internal_volume->volume_header->hashing_method,
-				     key_slot->salt,
-				     32,
-				     key_slot->number_of_iterations,
-				     user_key,
-				     internal_volume->master_key_size,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to determine user key.",
-					 function );
+		return( -1 );
+	}
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_SKIP_UNALLOCATED ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: skipping unallocated regions currently not supported.",
+		 function );
 
-					goto on_error;
-				}
-				key_slot->key_material_offset *= internal_volume->io_handle->bytes_per_sector;
+		return( -1 );
+	}
+	if( ( access_flags & LIBLUKSDE_ACCESS_FLAG_IO_URING ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: io_uring access currently not supported.",
+		 function );
 
-				if( key_slot->number_of_stripes == 0 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-					 "%s: invalid key slot - number of stripes value out of bounds.",
-					 function );
-
-					goto on_error;
-				}
-				if( ( internal_volume->master_key_size == 0 )
-				 || ( internal_volume->master_key_size > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / key_slot->number_of_stripes ) ) )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-					 "%s: invalid volume - master key size value out of bounds.",
-					 function );
+		return( -1 );
+	}
+	safe_io_callbacks = memory_allocate_structure(
+	                     libluksde_io_callbacks_t );
 
-					goto on_error;
-				}
-				key_material_size = (size_t) internal_volume->master_key_size * key_slot->number_of_stripes;
+	if( safe_io_callbacks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create I/O callbacks.",
+		 function );
 
-				key_material_data = (uint8_t *) memory_allocate(
-				                                 sizeof( uint8_t ) * key_material_size );
+		goto on_error;
+	}
+	safe_io_callbacks->read_at_offset = io_callbacks->read_at_offset;
+	safe_io_callbacks->get_size       = io_callbacks->get_size;
+	safe_io_callbacks->user_data      = io_callbacks->user_data;
 
-				if( key_material_data == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-					 "%s: unable to create key material data.",
-					 function );
+	/* The volume header and metadata are read using a file IO handle
+	 * that wraps the I/O callbacks
+	 */
+	if( libluksde_callbacks_file_initialize(
+	     &file_io_handle,
+	     io_callbacks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
 
-					goto on_error;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: reading key material at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-					 function,
-					 key_slot->key_material_offset,
-					 key_slot->key_material_offset );
-				}
-#endif
-				read_count = libbfio_handle_read_buffer_at_offset(
-					      file_io_handle,
-					      key_material_data,
-					      key_material_size,
-					      key_slot->key_material_offset,
-					      error );
+		goto on_error;
+	}
+	if( libluksde_volume_open_file_io_handle(
+	     volume,
+	     file_io_handle,
+	     access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume.",
+		 function );
 
-				if( read_count != (ssize_t) key_material_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read key material data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-					 function,
-					 key_slot->key_material_offset,
-					 key_slot->key_material_offset );
+		goto on_error;
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-					goto on_error;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: key material data:\n",
-					 function );
-					libcnotify_print_data(
-					 key_material_data,
-					 key_material_size,
-					 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
-				}
+		return( -1 );
+	}
 #endif
-				split_master_key_data = (uint8_t *) memory_allocate(
-				                                     sizeof( uint8_t ) * key_material_size );
+	internal_volume->file_io_handle_created_in_library = 1;
+	internal_volume->io_callbacks                      = safe_io_callbacks;
 
-				if( split_master_key_data == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-					 "%s: unable to create split master key data.",
-					 function );
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-					goto on_error;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: user key:\n",
-					 function );
-					libcnotify_print_data(
-					 user_key,
-					 32,
-					 0 );
-				}
+		return( -1 );
+	}
 #endif
-				if( libluksde_encryption_context_initialize(
-				     &user_key_encryption_context,
-				     internal_volume->volume_header->encryption_method,
-				     internal_volume->volume_header->encryption_chaining_mode,
-				     internal_volume->volume_header->initialization_vector_mode,
-				     internal_volume->volume_header->essiv_hashing_method,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to create user key encryption context.",
-					 function );
+	return( 1 );
 
-					goto on_error;
-				}
-				if( libluksde_encryption_context_set_key(
-				     user_key_encryption_context,
-				     user_key,
-				     internal_volume->master_key_size,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-					 "%s: unable to set key in user key encryption context.",
-					 function );
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( safe_io_callbacks != NULL )
+	{
+		memory_free(
+		 safe_io_callbacks );
+	}
+	return( -1 );
+}
 
-					goto on_error;
-				}
-				if( memory_set(
-				     user_key,
-				     0,
-				     32  ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to clear user key.",
-					 function );
+/* Closes a volume
+ * Returns 0 if successful or -1 on error
+ */
+int libluksde_volume_close(
+     libluksde_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_close";
+	int result                                   = 0;
 
-					goto on_error;
-				}
-				key_material_block_key = 0;
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
 
-				while( key_material_data_offset < key_material_size )
-				{
-					/* The data needs to be decrypted sector-by-sector
-					 */
-					if( libluksde_encryption_context_crypt(
-					     user_key_encryption_context,
-					     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
-					     &( key_material_data[ key_material_data_offset ] ),
-					     internal_volume->io_handle->bytes_per_sector,
-					     &( split_master_key_data[ key_material_data_offset ] ),
-					     internal_volume->io_handle->bytes_per_sector,
-					     key_material_block_key,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-						 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-						 "%s: unable to decrypt key material data.",
-						 function );
-
-						goto on_error;
-					}
-					key_material_data_offset += internal_volume->io_handle->bytes_per_sector;
-					key_material_block_key   += 1;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: split master key data:\n",
-					 function );
-					libcnotify_print_data(
-					 split_master_key_data,
-					 key_material_size,
-					 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
-				}
-#endif
-				memory_free(
-				 key_material_data );
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
 
-				key_material_data = NULL;
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
 
-				if( libluksde_encryption_context_free(
-				     &user_key_encryption_context,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-					 "%s: unable to free user key encryption context.",
-					 function );
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
 
-					goto on_error;
-				}
-				if( libluksde_diffuser_merge(
-				     split_master_key_data,
-				     key_material_size,
-				     internal_volume->master_key,
-				     internal_volume->master_key_size,
-				     key_slot->number_of_stripes,
-				     internal_volume->volume_header->hashing_method,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GENERIC,
-					 "%s: unable to merge split master key.",
-					 function );
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	/* The read queue is freed before grabbing the read/write lock
+	 * since processing the queued read requests requires the lock
+	 */
+	if( internal_volume->read_queue != NULL )
+	{
+		if( libluksde_read_queue_free(
+		     &( internal_volume->read_queue ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read queue.",
+			 function );
 
-					goto on_error;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: master key data:\n",
-					 function );
-					libcnotify_print_data(
-					 internal_volume->master_key,
-					 internal_volume->master_key_size,
-					 0 );
-				}
-#endif
-				if( memory_set(
-				     split_master_key_data,
-				     0,
-				     key_material_size  ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to clear split master key data.",
-					 function );
+			result = -1;
+		}
+	}
+	if( internal_volume->file_io_handle_pool != NULL )
+	{
+		if( libluksde_file_io_handle_pool_free(
+		     &( internal_volume->file_io_handle_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle pool.",
+			 function );
 
-					goto on_error;
-				}
-				memory_free(
-				 split_master_key_data );
-
-				split_master_key_data = NULL;
-
-				if( libluksde_password_pbkdf2(
-				     internal_volume->master_key,
-				     internal_volume->master_key_size,
-				     internal_volume->volume_header->hashing_method,
-				     internal_volume->volume_header->master_key_salt,
-				     32,
-				     internal_volume->volume_header->master_key_number_of_iterations,
-				     master_key_validation_hash,
-				     20,
-				     error ) == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to determine master key validation hash.",
-					 function );
+			result = -1;
+		}
+	}
+#endif
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-					goto on_error;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: master key validation hash data:\n",
-					 function );
-					libcnotify_print_data(
-					 master_key_validation_hash,
-					 20,
-					 0 );
-				}
+		return( -1 );
+	}
 #endif
 #if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: check:\n",
-					 function );
-					libcnotify_print_data(
-					 internal_volume->volume_header->master_key_validation_hash,
-					 20,
-					 0 );
-				}
+	if( libcnotify_verbose != 0 )
+	{
+		if( internal_volume->file_io_handle_created_in_library != 0 )
+		{
+			if( libluksde_debug_print_read_offsets(
+			     internal_volume->file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print the read offsets.",
+				 function );
+			}
+		}
+	}
 #endif
-				if( memory_compare(
-				     master_key_validation_hash,
-				     internal_volume->volume_header->master_key_validation_hash,
-				     20 ) == 0 )
-				{
-					internal_volume->volume_master_key_is_set = 1;
+	if( internal_volume->file_io_handle_opened_in_library != 0 )
+	{
+		if( libbfio_handle_close(
+		     internal_volume->file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
 
-					break;
-				}
-			}
+			result = -1;
 		}
+		internal_volume->file_io_handle_opened_in_library = 0;
 	}
-	if( ( internal_volume->volume_master_key_is_set != 0 )
-	 && ( internal_volume->encryption_context == NULL ) )
+	if( internal_volume->file_io_handle_created_in_library != 0 )
 	{
-		if( libluksde_encryption_context_initialize(
-		     &( internal_volume->encryption_context ),
-		     internal_volume->volume_header->encryption_method,
-		     internal_volume->volume_header->encryption_chaining_mode,
-		     internal_volume->volume_header->initialization_vector_mode,
-		     internal_volume->volume_header->essiv_hashing_method,
+		if( libbfio_handle_free(
+		     &( internal_volume->file_io_handle ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create encryption context.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libluksde_encryption_context_set_key(
-		     internal_volume->encryption_context,
-		     internal_volume->master_key,
-		     internal_volume->master_key_size,
+		internal_volume->file_io_handle_created_in_library = 0;
+	}
+	if( internal_volume->header_file_io_handle_opened_in_library != 0 )
+	{
+		if( libbfio_handle_close(
+		     internal_volume->header_file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close header file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		internal_volume->header_file_io_handle_opened_in_library = 0;
+	}
+	if( internal_volume->file_mapping != NULL )
+	{
+		if( libluksde_file_mapping_free(
+		     &( internal_volume->file_mapping ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set key in encryption context.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file mapping.",
 			 function );
 
-			libluksde_encryption_context_free(
-			 &( internal_volume->encryption_context ),
-			 NULL );
+			result = -1;
+		}
+	}
+	if( internal_volume->io_uring != NULL )
+	{
+		if( libluksde_io_uring_free(
+		     &( internal_volume->io_uring ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free io_uring.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->allocation_map != NULL )
+	{
+		if( libluksde_allocation_map_free(
+		     &( internal_volume->allocation_map ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free allocation map.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->spill_cache != NULL )
+	{
+		if( internal_volume->spill_cache->is_open != 0 )
+		{
+			if( libluksde_spill_cache_close(
+			     internal_volume->spill_cache,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close spill cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+	if( internal_volume->io_callbacks != NULL )
+	{
+		memory_free(
+		 internal_volume->io_callbacks );
+
+		internal_volume->io_callbacks = NULL;
+	}
+	internal_volume->header_file_io_handle = NULL;
+	internal_volume->file_io_handle        = NULL;
+	internal_volume->current_offset        = 0;
+	internal_volume->is_locked             = 1;
+	internal_volume->metadata_only         = 0;
+	internal_volume->metadata_is_read      = 0;
+
+	if( libluksde_io_handle_clear(
+	     internal_volume->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
+
+		result = -1;
+	}
+	if( libluksde_volume_header_free(
+	     &( internal_volume->volume_header ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free volume header.",
+		 function );
+
+		result = -1;
+	}
+	if( memory_set(
+	     internal_volume->master_key,
+	     0,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear master key.",
+		 function );
+
+		result = -1;
+	}
+	if( memory_set(
+	     internal_volume->secondary_master_key,
+	     0,
+	     64 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear secondary master key.",
+		 function );
+
+		result = -1;
+	}
+	internal_volume->secondary_master_key_size   = 0;
+	internal_volume->secondary_master_key_is_set = 0;
+
+	if( libluksde_segment_map_free(
+	     &( internal_volume->segment_map ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free segment map.",
+		 function );
+
+		result = -1;
+	}
+	if( internal_volume->encryption_context != NULL )
+	{
+		if( libluksde_encryption_context_free(
+		     &( internal_volume->encryption_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free encryption context.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Opens a volume for reading
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_internal_volume_open_read(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *header_file_io_handle,
+     libbfio_handle_t *data_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_internal_volume_open_read";
+	int result            = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_header != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - volume header value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     data_file_io_handle,
+	     &( internal_volume->io_handle->volume_size ),
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to determine volume size.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Reading LUKS volume header:\n" );
+	}
+#endif
+	if( libluksde_volume_header_initialize(
+	     &( internal_volume->volume_header ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create volume header.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_volume->metadata_only != 0 )
+	{
+		if( libluksde_volume_header_read_binary_header_file_io_handle(
+		     internal_volume->volume_header,
+		     header_file_io_handle,
+		     0,
+		     error ) != 1 )
+		{
+			/* The binary header of the primary LUKS2 header copy could be damaged
+			 * hence fall back to reading all the metadata
+			 */
+			libcerror_error_free(
+			 error );
+
+			if( libluksde_volume_header_free(
+			     &( internal_volume->volume_header ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free volume header.",
+				 function );
+
+				goto on_error;
+			}
+			if( libluksde_volume_header_initialize(
+			     &( internal_volume->volume_header ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create volume header.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else if( internal_volume->volume_header->format_version == 2 )
+		{
+			return( 1 );
+		}
+	}
+	if( libluksde_internal_volume_read_metadata(
+	     internal_volume,
+	     header_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read metadata.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_volume->metadata_only == 0 )
+	{
+		result = libluksde_internal_volume_unlock(
+		          internal_volume,
+		          header_file_io_handle,
+		          data_file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to unlock volume.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( internal_volume->segment_map != NULL )
+	{
+		libluksde_segment_map_free(
+		 &( internal_volume->segment_map ),
+		 NULL );
+	}
+	if( internal_volume->encryption_context != NULL )
+	{
+		libluksde_encryption_context_free(
+		 &( internal_volume->encryption_context ),
+		 NULL );
+	}
+	if( internal_volume->volume_header != NULL )
+	{
+		libluksde_volume_header_free(
+		 &( internal_volume->volume_header ),
+		 NULL );
+	}
+	internal_volume->metadata_is_read = 0;
+
+	return( -1 );
+}
+
+/* Reads the metadata
+ * The LUKS1 volume header is completely contained in the binary header and
+ * is not read again if it was already read
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_internal_volume_read_metadata(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_internal_volume_read_metadata";
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - invalid IO handle - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->segment_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - segment map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_header->format_version != 1 )
+	{
+		if( libluksde_volume_header_read_file_io_handle(
+		     internal_volume->volume_header,
+		     file_io_handle,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read volume header.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( internal_volume->volume_header->master_key_size == 0 )
+	 || ( internal_volume->volume_header->master_key_size > 64 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid master key size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->master_key_size = internal_volume->volume_header->master_key_size;
+
+	if( internal_volume->volume_header->secondary_master_key_digest != NULL )
+	{
+		if( ( internal_volume->volume_header->secondary_master_key_size == 0 )
+		 || ( internal_volume->volume_header->secondary_master_key_size > 64 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid secondary master key size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		internal_volume->secondary_master_key_size = internal_volume->volume_header->secondary_master_key_size;
+	}
+
+	if( ( internal_volume->volume_header->sector_size < 512 )
+	 || ( internal_volume->volume_header->sector_size > 4096 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sector size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->io_handle->sector_size = internal_volume->volume_header->sector_size;
+
+	if( internal_volume->volume_header->encrypted_volume_start_sector >= ( internal_volume->io_handle->volume_size / internal_volume->io_handle->bytes_per_sector ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid encrypted volume start sector value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->io_handle->encrypted_volume_offset = internal_volume->volume_header->encrypted_volume_start_sector
+	                                                    * internal_volume->io_handle->bytes_per_sector;
+
+	if( libluksde_segment_map_initialize(
+	     &( internal_volume->segment_map ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment map.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_segment_map_read_volume_header(
+	     internal_volume->segment_map,
+	     internal_volume->volume_header,
+	     internal_volume->io_handle->volume_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment map.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->io_handle->encrypted_volume_size = internal_volume->segment_map->size;
+
+	internal_volume->metadata_is_read = 1;
+
+	return( 1 );
+
+on_error:
+	if( internal_volume->segment_map != NULL )
+	{
+		libluksde_segment_map_free(
+		 &( internal_volume->segment_map ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the metadata if reading it was deferred on open
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_internal_volume_read_deferred_metadata(
+     libluksde_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *header_file_io_handle = NULL;
+	static char *function                   = "libluksde_internal_volume_read_deferred_metadata";
+	int result                              = 1;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	header_file_io_handle = internal_volume->header_file_io_handle;
+
+	if( header_file_io_handle == NULL )
+	{
+		header_file_io_handle = internal_volume->file_io_handle;
+	}
+	if( ( header_file_io_handle != NULL )
+	 && ( internal_volume->metadata_is_read == 0 ) )
+	{
+		if( libluksde_internal_volume_read_metadata(
+		     internal_volume,
+		     header_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read metadata.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads the key material of a key slot and merges it into the (master) key
+ * The key material is read, decrypted and merged in chunks of a fixed size
+ * so that the memory needed does not depend on the number of stripes
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_internal_volume_read_key_material(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libluksde_key_slot_t *key_slot,
+     libluksde_encryption_context_t *user_key_encryption_context,
+     uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	uint8_t encrypted_data[ LIBLUKSDE_KEY_MATERIAL_CHUNK_SIZE ];
+	uint8_t split_master_key_data[ LIBLUKSDE_KEY_MATERIAL_CHUNK_SIZE + 64 ];
+
+	static char *function                = "libluksde_internal_volume_read_key_material";
+	size_t chunk_size                    = 0;
+	size_t encrypted_data_offset         = 0;
+	size_t read_size                     = 0;
+	size_t split_master_key_data_size    = 0;
+	ssize_t read_count                   = 0;
+	uint64_t key_material_size           = 0;
+	uint64_t remaining_key_material_size = 0;
+	uint64_t sector_number               = 0;
+	off64_t key_material_offset          = 0;
+	uint32_t number_of_stripes           = 0;
+	uint32_t stripe_index                = 0;
+	uint16_t bytes_per_sector            = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	bytes_per_sector = internal_volume->io_handle->bytes_per_sector;
+
+	if( ( bytes_per_sector == 0 )
+	 || ( bytes_per_sector > LIBLUKSDE_KEY_MATERIAL_CHUNK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - invalid IO handle - bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_size == 0 )
+	 || ( key_size > 64 )
+	 || ( key_size > (size_t) bytes_per_sector ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_slot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key slot.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_slot->number_of_stripes == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key slot - number of stripes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_slot->key_material_offset < 0 )
+	 || ( key_slot->key_material_offset > ( (off64_t) INT64_MAX / bytes_per_sector ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key slot - key material offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The key material offset of the key slot is stored in number of sectors
+	 */
+	key_material_offset = key_slot->key_material_offset * bytes_per_sector;
+	key_material_size   = (uint64_t) key_size * key_slot->number_of_stripes;
+
+	if( ( key_slot->key_material_size != 0 )
+	 && ( key_material_size > key_slot->key_material_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key slot - key material size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+
+	/* The key material is encrypted per sector hence it is read in whole sectors
+	 */
+	remaining_key_material_size = key_material_size;
+
+	if( ( remaining_key_material_size % bytes_per_sector ) != 0 )
+	{
+		remaining_key_material_size += bytes_per_sector - ( remaining_key_material_size % bytes_per_sector );
+	}
+	chunk_size = ( LIBLUKSDE_KEY_MATERIAL_CHUNK_SIZE / bytes_per_sector ) * bytes_per_sector;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading key material at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIu64 "\n",
+		 function,
+		 key_material_offset,
+		 key_material_offset,
+		 key_material_size );
+	}
+#endif
+	while( stripe_index < key_slot->number_of_stripes )
+	{
+		if( remaining_key_material_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid remaining key material size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		read_size = chunk_size;
+
+		if( (uint64_t) read_size > remaining_key_material_size )
+		{
+			read_size = (size_t) remaining_key_material_size;
+		}
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              encrypted_data,
+		              read_size,
+		              key_material_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read key material data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 key_material_offset,
+			 key_material_offset );
+
+			goto on_error;
+		}
+		/* The data needs to be decrypted sector-by-sector and is appended
+		 * to the part of a stripe that remained from the previous chunk
+		 */
+		for( encrypted_data_offset = 0;
+		     encrypted_data_offset < read_size;
+		     encrypted_data_offset += bytes_per_sector )
+		{
+			if( libluksde_encryption_context_crypt(
+			     user_key_encryption_context,
+			     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+			     &( encrypted_data[ encrypted_data_offset ] ),
+			     bytes_per_sector,
+			     &( split_master_key_data[ split_master_key_data_size ] ),
+			     bytes_per_sector,
+			     sector_number,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to decrypt key material data.",
+				 function );
+
+				goto on_error;
+			}
+			split_master_key_data_size += bytes_per_sector;
+			sector_number              += 1;
+		}
+		key_material_offset         += read_size;
+		remaining_key_material_size -= read_size;
+
+		number_of_stripes = (uint32_t) ( split_master_key_data_size / key_size );
+
+		if( number_of_stripes > ( key_slot->number_of_stripes - stripe_index ) )
+		{
+			number_of_stripes = key_slot->number_of_stripes - stripe_index;
+		}
+		if( libluksde_diffuser_merge_stripes(
+		     split_master_key_data,
+		     split_master_key_data_size,
+		     key,
+		     key_size,
+		     stripe_index,
+		     number_of_stripes,
+		     key_slot->diffuser_hashing_method,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to merge split master key stripes: %" PRIu32 " - %" PRIu32 ".",
+			 function,
+			 stripe_index,
+			 stripe_index + number_of_stripes - 1 );
+
+			goto on_error;
+		}
+		stripe_index += number_of_stripes;
+
+		/* Move the part of a stripe that remains to the start of the buffer,
+		 * this part is smaller than a stripe hence the data does not overlap
+		 */
+		split_master_key_data_size -= (size_t) number_of_stripes * key_size;
+
+		if( ( stripe_index < key_slot->number_of_stripes )
+		 && ( split_master_key_data_size > 0 ) )
+		{
+			if( memory_copy(
+			     split_master_key_data,
+			     &( split_master_key_data[ (size_t) number_of_stripes * key_size ] ),
+			     split_master_key_data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy remainder of split master key data.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: key data:\n",
+		 function );
+		libcnotify_print_data(
+		 key,
+		 key_size,
+		 0 );
+	}
+#endif
+	memory_set(
+	 split_master_key_data,
+	 0,
+	 LIBLUKSDE_KEY_MATERIAL_CHUNK_SIZE + 64 );
+
+	return( 1 );
+
+on_error:
+	memory_set(
+	 split_master_key_data,
+	 0,
+	 LIBLUKSDE_KEY_MATERIAL_CHUNK_SIZE + 64 );
+
+	return( -1 );
+}
+
+/* Checks if the first data of the encrypted volume, decrypted with the master key, contains a known signature
+ * Returns 1 if a signature was found, 0 if not or -1 on error
+ */
+int libluksde_internal_volume_check_master_key_signature(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t data[ LIBLUKSDE_DATA_SIGNATURE_DATA_SIZE ];
+	uint8_t encrypted_data[ LIBLUKSDE_DATA_SIGNATURE_DATA_SIZE ];
+
+	libluksde_encryption_context_t *encryption_context = NULL;
+	static char *function                              = "libluksde_internal_volume_check_master_key_signature";
+	size_t data_offset                                 = 0;
+	size_t read_size                                   = LIBLUKSDE_DATA_SIGNATURE_DATA_SIZE;
+	ssize_t read_count                                 = 0;
+	uint64_t sector_number                             = 0;
+	int result                                         = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_volume->io_handle->sector_size < 512 )
+	 || ( internal_volume->io_handle->sector_size > LIBLUKSDE_DATA_SIGNATURE_DATA_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - invalid IO handle - sector size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) read_size > internal_volume->io_handle->encrypted_volume_size )
+	{
+		read_size = (size_t) internal_volume->io_handle->encrypted_volume_size;
+	}
+	if( (size64_t) read_size > ( internal_volume->io_handle->volume_size - internal_volume->io_handle->encrypted_volume_offset ) )
+	{
+		read_size = (size_t) ( internal_volume->io_handle->volume_size - internal_volume->io_handle->encrypted_volume_offset );
+	}
+	read_size -= read_size % internal_volume->io_handle->sector_size;
+
+	if( read_size == 0 )
+	{
+		return( 0 );
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              encrypted_data,
+	              read_size,
+	              internal_volume->io_handle->encrypted_volume_offset,
+	              error );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read encrypted data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_volume->io_handle->encrypted_volume_offset,
+		 internal_volume->io_handle->encrypted_volume_offset );
+
+		goto on_error;
+	}
+	if( libluksde_encryption_context_initialize(
+	     &encryption_context,
+	     internal_volume->volume_header->encryption_method,
+	     internal_volume->volume_header->encryption_chaining_mode,
+	     internal_volume->volume_header->initialization_vector_mode,
+	     internal_volume->volume_header->essiv_hashing_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_encryption_context_set_key(
+	     encryption_context,
+	     internal_volume->master_key,
+	     internal_volume->master_key_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key in encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	for( data_offset = 0;
+	     data_offset < read_size;
+	     data_offset += internal_volume->io_handle->sector_size )
+	{
+		/* The sector number of the initialization vector is in 512-byte units
+		 */
+		sector_number = (uint64_t) data_offset / 512;
+
+		if( libluksde_encryption_context_crypt(
+		     encryption_context,
+		     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		     &( encrypted_data[ data_offset ] ),
+		     internal_volume->io_handle->sector_size,
+		     &( data[ data_offset ] ),
+		     internal_volume->io_handle->sector_size,
+		     sector_number,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+			 "%s: unable to decrypt sector: %" PRIu64 ".",
+			 function,
+			 sector_number );
+
+			goto on_error;
+		}
+	}
+	if( libluksde_encryption_context_free(
+	     &encryption_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	result = libluksde_data_signature_check(
+	          data,
+	          read_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to check data signature.",
+		 function );
+
+		goto on_error;
+	}
+	memory_set(
+	 data,
+	 0,
+	 LIBLUKSDE_DATA_SIGNATURE_DATA_SIZE );
+
+	return( result );
+
+on_error:
+	if( encryption_context != NULL )
+	{
+		libluksde_encryption_context_free(
+		 &encryption_context,
+		 NULL );
+	}
+	memory_set(
+	 data,
+	 0,
+	 LIBLUKSDE_DATA_SIGNATURE_DATA_SIZE );
+
+	return( -1 );
+}
+
+/* Checks if the master key is valid
+ * If the file system signature check flag is set, candidates that do not decrypt to
+ * a known signature are rejected before the (expensive) master key validation hash
+ * is calculated. A found signature does not replace the validation hash.
+ * Returns 1 if valid, 0 if not or -1 on error
+ */
+int libluksde_internal_volume_check_master_key(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t master_key_validation_hash[ 64 ];
+
+	static char *function = "libluksde_internal_volume_check_master_key";
+	int result            = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_volume->volume_header->master_key_validation_hash_size == 0 )
+	 || ( internal_volume->volume_header->master_key_validation_hash_size > 64 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - invalid volume header - master key validation hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_volume->master_key_check_flags & LIBLUKSDE_MASTER_KEY_CHECK_FLAG_FILE_SYSTEM_SIGNATURE ) != 0 )
+	{
+		result = libluksde_internal_volume_check_master_key_signature(
+		          internal_volume,
+		          file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to check master key signature.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: no known signature found in decrypted data.\n",
+				 function );
+			}
+#endif
+			return( 0 );
+		}
+	}
+	if( libluksde_password_pbkdf2(
+	     internal_volume->master_key,
+	     internal_volume->master_key_size,
+	     internal_volume->volume_header->hashing_method,
+	     internal_volume->volume_header->master_key_salt,
+	     internal_volume->volume_header->master_key_salt_size,
+	     internal_volume->volume_header->master_key_number_of_iterations,
+	     master_key_validation_hash,
+	     internal_volume->volume_header->master_key_validation_hash_size,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine master key validation hash.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: master key validation hash data:\n",
+		 function );
+		libcnotify_print_data(
+		 master_key_validation_hash,
+		 internal_volume->volume_header->master_key_validation_hash_size,
+		 0 );
+
+		libcnotify_printf(
+		 "%s: check:\n",
+		 function );
+		libcnotify_print_data(
+		 internal_volume->volume_header->master_key_validation_hash,
+		 internal_volume->volume_header->master_key_validation_hash_size,
+		 0 );
+	}
+#endif
+	if( memory_compare(
+	     master_key_validation_hash,
+	     internal_volume->volume_header->master_key_validation_hash,
+	     internal_volume->volume_header->master_key_validation_hash_size ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Reads a (master) key from a key slot using the keyfile or the user password
+ * The keyfile takes precedence over the user password
+ * Returns 1 if the key was read, 0 if the key slot is not supported or -1 on error
+ */
+int libluksde_internal_volume_read_key_from_key_slot(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libluksde_key_slot_t *key_slot,
+     uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	uint8_t keyfile_key[ 128 ];
+	uint8_t user_key[ 64 ];
+
+	libluksde_encryption_context_t *user_key_encryption_context = NULL;
+	static char *function                                       = "libluksde_internal_volume_read_key_from_key_slot";
+	size_t keyfile_key_length                                   = 0;
+	int result                                                  = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_volume->keyfile == NULL )
+	 && ( internal_volume->user_password_is_set == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing keyfile and user password.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_slot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key slot.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_slot->key_derivation_function == LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_UNKNOWN )
+	 || ( (size_t) key_slot->key_size != key_size )
+	 || ( key_slot->encryption_key_size == 0 )
+	 || ( key_slot->encryption_key_size > 64 ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: skipping unsupported key slot: %d.\n",
+			 function,
+			 key_slot->identifier );
+		}
+#endif
+		return( 0 );
+	}
+	if( ( key_slot->key_derivation_function == LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_PBKDF2 )
+	 && ( internal_volume->keyfile != NULL ) )
+	{
+		/* The key data is passed as the HMAC key, if the key data is larger than
+		 * the hash block size its hash is used instead, as HMAC would do
+		 */
+		result = libluksde_keyfile_get_hmac_key(
+		          internal_volume->keyfile,
+		          key_slot->hashing_method,
+		          keyfile_key,
+		          128,
+		          &keyfile_key_length,
+		          error );
+
+		if( result == 1 )
+		{
+			result = libluksde_password_pbkdf2(
+			          keyfile_key,
+			          keyfile_key_length,
+			          key_slot->hashing_method,
+			          key_slot->salt,
+			          key_slot->salt_size,
+			          key_slot->number_of_iterations,
+			          user_key,
+			          key_slot->encryption_key_size,
+			          error );
+		}
+		if( memory_set(
+		     keyfile_key,
+		     0,
+		     128 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear keyfile key.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else if( key_slot->key_derivation_function == LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_PBKDF2 )
+	{
+		result = libluksde_password_pbkdf2(
+		          internal_volume->user_password,
+		          internal_volume->user_password_size - 1,
+		          key_slot->hashing_method,
+		          key_slot->salt,
+		          key_slot->salt_size,
+		          key_slot->number_of_iterations,
+		          user_key,
+		          key_slot->encryption_key_size,
+		          error );
+	}
+	else if( internal_volume->keyfile != NULL )
+	{
+		result = libluksde_argon2_derive_key(
+		          key_slot->key_derivation_function,
+		          NULL,
+		          0,
+		          internal_volume->keyfile,
+		          key_slot->salt,
+		          key_slot->salt_size,
+		          NULL,
+		          0,
+		          NULL,
+		          0,
+		          key_slot->time_cost,
+		          key_slot->memory_cost,
+		          key_slot->parallelism,
+		          user_key,
+		          key_slot->encryption_key_size,
+		          error );
+	}
+	else
+	{
+		result = libluksde_argon2_derive_key(
+		          key_slot->key_derivation_function,
+		          internal_volume->user_password,
+		          internal_volume->user_password_size - 1,
+		          NULL,
+		          key_slot->salt,
+		          key_slot->salt_size,
+		          NULL,
+		          0,
+		          NULL,
+		          0,
+		          key_slot->time_cost,
+		          key_slot->memory_cost,
+		          key_slot->parallelism,
+		          user_key,
+		          key_slot->encryption_key_size,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine user key.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: user key:\n",
+		 function );
+		libcnotify_print_data(
+		 user_key,
+		 key_slot->encryption_key_size,
+		 0 );
+	}
+#endif
+	if( libluksde_encryption_context_initialize(
+	     &user_key_encryption_context,
+	     key_slot->encryption_method,
+	     key_slot->encryption_chaining_mode,
+	     key_slot->initialization_vector_mode,
+	     key_slot->essiv_hashing_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create user key encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_encryption_context_set_key(
+	     user_key_encryption_context,
+	     user_key,
+	     key_slot->encryption_key_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key in user key encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     user_key,
+	     0,
+	     64 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear user key.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_internal_volume_read_key_material(
+	     internal_volume,
+	     file_io_handle,
+	     key_slot,
+	     user_key_encryption_context,
+	     key,
+	     key_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read key material of key slot: %d.",
+		 function,
+		 key_slot->identifier );
+
+		goto on_error;
+	}
+	if( libluksde_encryption_context_free(
+	     &user_key_encryption_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free user key encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( user_key_encryption_context != NULL )
+	{
+		libluksde_encryption_context_free(
+		 &user_key_encryption_context,
+		 NULL );
+	}
+	memory_set(
+	 keyfile_key,
+	 0,
+	 128 );
+	memory_set(
+	 user_key,
+	 0,
+	 64 );
+
+	return( -1 );
+}
+
+/* Reads the master key from a key slot using the keyfile or the user password
+ * Returns 1 if the master key was read, 0 if not or -1 on error
+ */
+int libluksde_internal_volume_read_master_key_from_key_slot(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *header_file_io_handle,
+     libbfio_handle_t *data_file_io_handle,
+     libluksde_key_slot_t *key_slot,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_internal_volume_read_master_key_from_key_slot";
+	int result            = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_slot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key slot.",
+		 function );
+
+		return( -1 );
+	}
+	result = libluksde_internal_volume_read_key_from_key_slot(
+	          internal_volume,
+	          header_file_io_handle,
+	          key_slot,
+	          internal_volume->master_key,
+	          (size_t) internal_volume->master_key_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to read master key from key slot: %d.",
+		 function,
+		 key_slot->identifier );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		result = libluksde_internal_volume_check_master_key(
+		          internal_volume,
+		          data_file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to check master key of key slot: %d.",
+			 function,
+			 key_slot->identifier );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Reads the secondary master key from the key slots bound to the secondary master key digest
+ * The secondary master key is needed to read the data segments of a volume that is being
+ * reencrypted, which are not encrypted with the master key
+ * Returns 1 if the secondary master key was read, 0 if not or -1 on error
+ */
+int libluksde_internal_volume_read_secondary_master_key(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *header_file_io_handle,
+     libcerror_error_t **error )
+{
+	libluksde_digest_t *digest     = NULL;
+	libluksde_key_slot_t *key_slot = NULL;
+	static char *function          = "libluksde_internal_volume_read_secondary_master_key";
+	int key_slot_index             = 0;
+	int key_slot_priority          = 0;
+	int number_of_key_slots        = 0;
+	int result                     = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	digest = internal_volume->volume_header->secondary_master_key_digest;
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - invalid volume header - missing secondary master key digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_volume->secondary_master_key_size == 0 )
+	 || ( internal_volume->secondary_master_key_size > 64 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - secondary master key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_volume->keyfile == NULL )
+	 && ( internal_volume->user_password_is_set == 0 ) )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->volume_header->key_slots_array,
+	     &number_of_key_slots,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of key slots.",
+		 function );
+
+		goto on_error;
+	}
+	for( key_slot_priority = LIBLUKSDE_KEY_SLOT_PRIORITY_PREFER;
+	     key_slot_priority > LIBLUKSDE_KEY_SLOT_PRIORITY_IGNORE;
+	     key_slot_priority-- )
+	{
+		for( key_slot_index = 0;
+		     key_slot_index < number_of_key_slots;
+		     key_slot_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_volume->volume_header->key_slots_array,
+			     key_slot_index,
+			     (intptr_t **) &key_slot,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve key slot: %d.",
+				 function,
+				 key_slot_index );
+
+				goto on_error;
+			}
+			if( key_slot == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing key slot: %d.",
+				 function,
+				 key_slot_index );
+
+				goto on_error;
+			}
+			if( ( key_slot->state != LIBLUKSDE_KEY_SLOT_STATE_ACTIVE )
+			 || ( key_slot->priority != key_slot_priority )
+			 || ( key_slot->identifier < 0 )
+			 || ( key_slot->identifier >= 32 )
+			 || ( ( digest->key_slots_bitmap & ( (uint32_t) 1 << key_slot->identifier ) ) == 0 ) )
+			{
+				continue;
+			}
+			result = libluksde_internal_volume_read_key_from_key_slot(
+			          internal_volume,
+			          header_file_io_handle,
+			          key_slot,
+			          internal_volume->secondary_master_key,
+			          (size_t) internal_volume->secondary_master_key_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read secondary master key from key slot: %d.",
+				 function,
+				 key_slot->identifier );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				continue;
+			}
+			result = libluksde_digest_check_key(
+			          digest,
+			          internal_volume->secondary_master_key,
+			          (size_t) internal_volume->secondary_master_key_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to check secondary master key of key slot: %d.",
+				 function,
+				 key_slot->identifier );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				return( 1 );
+			}
+		}
+	}
+	memory_set(
+	 internal_volume->secondary_master_key,
+	 0,
+	 64 );
+
+	return( 0 );
+
+on_error:
+	memory_set(
+	 internal_volume->secondary_master_key,
+	 0,
+	 64 );
+
+	return( -1 );
+}
+
+/* Reads the keys from when unlocking the volume
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libluksde_internal_volume_open_read_keys(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *header_file_io_handle,
+     libbfio_handle_t *data_file_io_handle,
+     libcerror_error_t **error )
+{
+	libluksde_key_slot_t *key_slot = NULL;
+	static char *function          = "libluksde_internal_volume_open_read_keys";
+	uint32_t key_slots_bitmap      = 0;
+	uint8_t master_key_is_cached   = 0;
+	int key_slot_index             = 0;
+	int key_slot_priority          = 0;
+	int number_of_key_slots        = 0;
+	int result                     = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - invalid IO handle - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_volume->volume_master_key_is_set == 0 )
+	 && ( internal_volume->master_key_cache != NULL ) )
+	{
+		/* The header digest covers the master key validation hash and the key slots
+		 * hence a matching cache does not need to be validated again
+		 */
+		if( ( internal_volume->master_key_cache->master_key_size == internal_volume->master_key_size )
+		 && ( memory_compare(
+		       internal_volume->master_key_cache->volume_identifier,
+		       internal_volume->volume_header->volume_identifier,
+		       16 ) == 0 )
+		 && ( memory_compare(
+		       internal_volume->master_key_cache->header_digest,
+		       internal_volume->volume_header->header_digest,
+		       32 ) == 0 ) )
+		{
+			if( memory_copy(
+			     internal_volume->master_key,
+			     internal_volume->master_key_cache->master_key,
+			     64 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy master key.",
+				 function );
+
+				goto on_error;
+			}
+			internal_volume->volume_master_key_is_set = 1;
+
+			master_key_is_cached = 1;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		else if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: master key cache does not match volume header.\n",
+			 function );
+		}
+#endif
+	}
+	if( ( internal_volume->volume_master_key_is_set != 0 )
+	 && ( master_key_is_cached == 0 ) )
+	{
+		result = libluksde_internal_volume_check_master_key(
+		          internal_volume,
+		          data_file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to check master key.",
+			 function );
+
+			goto on_error;
+		}
+		internal_volume->volume_master_key_is_set = (uint8_t) result;
+	}
+	if( ( internal_volume->volume_master_key_is_set == 0 )
+	 && ( ( internal_volume->keyfile != NULL )
+	  || ( internal_volume->user_password_is_set != 0 ) ) )
+	{
+		key_slots_bitmap = internal_volume->volume_header->master_key_key_slots_bitmap;
+
+		if( internal_volume->token_identifier >= 0 )
+		{
+			/* Only the key slots referenced by the token are tried
+			 */
+			if( ( internal_volume->volume_header->tokens_bitmap & ( (uint32_t) 1 << internal_volume->token_identifier ) ) != 0 )
+			{
+				key_slots_bitmap &= internal_volume->volume_header->token_key_slots_bitmaps[ internal_volume->token_identifier ];
+			}
+			else
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: missing token: %d.\n",
+					 function,
+					 internal_volume->token_identifier );
+				}
+#endif
+				key_slots_bitmap = 0;
+			}
+		}
+		if( libcdata_array_get_number_of_entries(
+		     internal_volume->volume_header->key_slots_array,
+		     &number_of_key_slots,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of key slots.",
+			 function );
+
+			goto on_error;
+		}
+		/* Only key slots that are bound to the digest of the master key can contain
+		 * the master key, key slots with a "prefer" priority are tried first and
+		 * key slots with an "ignore" priority are not tried
+		 */
+		for( key_slot_priority = LIBLUKSDE_KEY_SLOT_PRIORITY_PREFER;
+		     key_slot_priority > LIBLUKSDE_KEY_SLOT_PRIORITY_IGNORE;
+		     key_slot_priority-- )
+		{
+			for( key_slot_index = 0;
+			     key_slot_index < number_of_key_slots;
+			     key_slot_index++ )
+			{
+				if( libcdata_array_get_entry_by_index(
+				     internal_volume->volume_header->key_slots_array,
+				     key_slot_index,
+				     (intptr_t **) &key_slot,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve key slot: %d.",
+					 function,
+					 key_slot_index );
+
+					goto on_error;
+				}
+				if( key_slot == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing key slot: %d.",
+					 function,
+					 key_slot_index );
+
+					goto on_error;
+				}
+				if( ( key_slot->state != LIBLUKSDE_KEY_SLOT_STATE_ACTIVE )
+				 || ( key_slot->priority != key_slot_priority )
+				 || ( key_slot->identifier < 0 )
+				 || ( key_slot->identifier >= 32 )
+				 || ( ( key_slots_bitmap & ( (uint32_t) 1 << key_slot->identifier ) ) == 0 ) )
+				{
+					continue;
+				}
+				result = libluksde_internal_volume_read_master_key_from_key_slot(
+				          internal_volume,
+				          header_file_io_handle,
+				          data_file_io_handle,
+				          key_slot,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to read master key from key slot: %d.",
+					 function,
+					 key_slot->identifier );
+
+					goto on_error;
+				}
+				else if( result != 0 )
+				{
+					internal_volume->volume_master_key_is_set = 1;
+
+					break;
+				}
+			}
+			if( internal_volume->volume_master_key_is_set != 0 )
+			{
+				break;
+			}
+		}
+	}
+	if( ( internal_volume->volume_master_key_is_set != 0 )
+	 && ( internal_volume->secondary_master_key_is_set == 0 )
+	 && ( internal_volume->volume_header->secondary_master_key_digest != NULL ) )
+	{
+		/* A volume that is being reencrypted can only be read when the keys
+		 * of both the old and the new data segments are known
+		 */
+		result = libluksde_internal_volume_read_secondary_master_key(
+		          internal_volume,
+		          header_file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read secondary master key.",
+			 function );
+
+			goto on_error;
+		}
+		internal_volume->secondary_master_key_is_set = (uint8_t) result;
+
+		if( internal_volume->secondary_master_key_is_set == 0 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to determine secondary master key.\n",
+				 function );
+			}
+#endif
+			return( 0 );
+		}
+	}
+	if( ( internal_volume->volume_master_key_is_set != 0 )
+	 && ( internal_volume->encryption_context == NULL ) )
+	{
+		if( libluksde_encryption_context_initialize(
+		     &( internal_volume->encryption_context ),
+		     internal_volume->volume_header->encryption_method,
+		     internal_volume->volume_header->encryption_chaining_mode,
+		     internal_volume->volume_header->initialization_vector_mode,
+		     internal_volume->volume_header->essiv_hashing_method,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create encryption context.",
+			 function );
+
+			goto on_error;
+		}
+		if( libluksde_encryption_context_set_key(
+		     internal_volume->encryption_context,
+		     internal_volume->master_key,
+		     internal_volume->master_key_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set key in encryption context.",
+			 function );
+
+			libluksde_encryption_context_free(
+			 &( internal_volume->encryption_context ),
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	if( internal_volume->encryption_context != NULL )
+	{
+		return( 1 );
+	}
+	return( 0 );
+
+on_error:
+	return( -1 );
+}
+
+/* Reads the allocation map of the volume data
+ * The allocated ranges of the volume file are mapped onto (decrypted) volume offsets,
+ * a sector that is partially allocated is considered allocated
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int libluksde_internal_volume_read_allocation_map(
+     libluksde_internal_volume_t *internal_volume,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libluksde_allocation_map_t *allocation_map       = NULL;
+	libluksde_allocation_map_t *file_allocation_map  = NULL;
+	libluksde_segment_map_entry_t *segment_map_entry = NULL;
+	static char *function                            = "libluksde_internal_volume_read_allocation_map";
+	size64_t extent_size                             = 0;
+	off64_t file_end_offset                          = 0;
+	off64_t file_offset                              = 0;
+	off64_t range_end_offset                         = 0;
+	off64_t range_offset                             = 0;
+	off64_t volume_offset                            = 0;
+	int result                                       = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->allocation_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - allocation map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	/* The segment map is not available when reading the metadata was deferred
+	 */
+	if( internal_volume->segment_map == NULL )
+	{
+		return( 0 );
+	}
+	if( libluksde_allocation_map_initialize(
+	     &file_allocation_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file allocation map.",
+		 function );
+
+		goto on_error;
+	}
+	result = libluksde_allocation_map_read_file_by_name(
+	          file_allocation_map,
+	          filename,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file allocation map.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libluksde_allocation_map_free(
+		     &file_allocation_map,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file allocation map.",
+			 function );
+
+			goto on_error;
+		}
+		return( 0 );
+	}
+	if( libluksde_allocation_map_initialize(
+	     &allocation_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create allocation map.",
+		 function );
+
+		goto on_error;
+	}
+	allocation_map->size = internal_volume->segment_map->size;
+
+	while( (size64_t) volume_offset < internal_volume->segment_map->size )
+	{
+		if( libluksde_segment_map_get_entry_at_offset(
+		     internal_volume->segment_map,
+		     volume_offset,
+		     &segment_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment map entry at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 volume_offset,
+			 volume_offset );
+
+			goto on_error;
+		}
+		if( segment_map_entry->sector_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment map entry - sector size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		file_offset     = segment_map_entry->file_offset;
+		file_end_offset = segment_map_entry->file_offset + (off64_t) segment_map_entry->size;
+
+		while( file_offset < file_end_offset )
+		{
+			result = libluksde_allocation_map_get_extent_at_offset(
+			          file_allocation_map,
+			          file_offset,
+			          &extent_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve file extent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 file_offset,
+				 file_offset );
+
+				goto on_error;
+			}
+			if( extent_size > (size64_t) ( file_end_offset - file_offset ) )
+			{
+				extent_size = (size64_t) ( file_end_offset - file_offset );
+			}
+			if( result != 0 )
+			{
+				/* Extend the allocated extent to the sectors it is part of
+				 */
+				range_offset = file_offset - segment_map_entry->file_offset;
+				range_offset = ( range_offset / segment_map_entry->sector_size ) * segment_map_entry->sector_size;
+
+				range_end_offset = file_offset + (off64_t) extent_size - segment_map_entry->file_offset;
+				range_end_offset = ( ( range_end_offset + segment_map_entry->sector_size - 1 ) / segment_map_entry->sector_size ) * segment_map_entry->sector_size;
+
+				if( (size64_t) range_end_offset > segment_map_entry->size )
+				{
+					range_end_offset = (off64_t) segment_map_entry->size;
+				}
+				if( libluksde_allocation_map_append_range(
+				     allocation_map,
+				     segment_map_entry->volume_offset + range_offset,
+				     (size64_t) ( range_end_offset - range_offset ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append allocated range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 segment_map_entry->volume_offset + range_offset,
+					 segment_map_entry->volume_offset + range_offset );
+
+					goto on_error;
+				}
+			}
+			file_offset += (off64_t) extent_size;
+		}
+		volume_offset = segment_map_entry->volume_offset + (off64_t) segment_map_entry->size;
+	}
+	if( libluksde_allocation_map_free(
+	     &file_allocation_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file allocation map.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->allocation_map = allocation_map;
+
+	return( 1 );
+
+on_error:
+	if( allocation_map != NULL )
+	{
+		libluksde_allocation_map_free(
+		 &allocation_map,
+		 NULL );
+	}
+	if( file_allocation_map != NULL )
+	{
+		libluksde_allocation_map_free(
+		 &file_allocation_map,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Determines if the volume is locked
+ * Returns 1 if locked, 0 if not or -1 on error
+ */
+int libluksde_volume_is_locked(
+     libluksde_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_is_locked";
+	uint8_t is_locked                            = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	is_locked = internal_volume->is_locked;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( is_locked );
+}
+
+/* Unlocks the volume
+ * Returns 1 if the volume is unlocked, 0 if not or -1 on error
+ */
+int libluksde_internal_volume_unlock(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *header_file_io_handle,
+     libbfio_handle_t *data_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libluksde_internal_volume_unlock";
+	int result            = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	result = libluksde_internal_volume_open_read_keys(
+	          internal_volume,
+	          header_file_io_handle,
+	          data_file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read keys.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( internal_volume->segment_map != NULL )
+		{
+			if( libluksde_segment_map_set_key(
+			     internal_volume->segment_map,
+			     internal_volume->master_key,
+			     (size_t) internal_volume->master_key_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set key in segment map.",
+				 function );
+
+				return( -1 );
+			}
+			/* During reencryption the data segments bound to the secondary master key digest
+			 * are encrypted with the secondary master key
+			 */
+			if( internal_volume->secondary_master_key_is_set != 0 )
+			{
+				if( libluksde_segment_map_set_segments_key(
+				     internal_volume->segment_map,
+				     internal_volume->volume_header->secondary_master_key_digest->segments_bitmap,
+				     internal_volume->secondary_master_key,
+				     (size_t) internal_volume->secondary_master_key_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set secondary master key in segment map.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		internal_volume->is_locked = 0;
+	}
+	return( result );
+}
+
+/* Unlocks the volume
+ * Returns 1 if the volume is unlocked, 0 if not or -1 on error
+ */
+int libluksde_volume_unlock(
+     libluksde_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	libbfio_handle_t *header_file_io_handle      = NULL;
+	static char *function                        = "libluksde_volume_unlock";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->is_locked != 0 )
+	{
+		header_file_io_handle = internal_volume->header_file_io_handle;
+
+		if( header_file_io_handle == NULL )
+		{
+			header_file_io_handle = internal_volume->file_io_handle;
+		}
+		if( internal_volume->metadata_is_read == 0 )
+		{
+			if( libluksde_internal_volume_read_metadata(
+			     internal_volume,
+			     header_file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read metadata.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( result != -1 )
+		{
+			result = libluksde_internal_volume_unlock(
+			          internal_volume,
+			          header_file_io_handle,
+			          internal_volume->file_io_handle,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to unlock volume.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads segment data from the file mapping into a buffer
+ * The encrypted sectors are decrypted directly from the mapped data into the buffer,
+ * only a partially read sector is decrypted into an intermediate sector buffer
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libluksde_internal_volume_read_segment_data_from_file_mapping(
+         libluksde_internal_volume_t *internal_volume,
+         libluksde_segment_map_entry_t *segment_map_entry,
+         off64_t segment_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	uint8_t sector_data[ 4096 ];
+
+	const uint8_t *mapped_data = NULL;
+	static char *function      = "libluksde_internal_volume_read_segment_data_from_file_mapping";
+	size_t buffer_offset       = 0;
+	size_t read_size           = 0;
+	size_t sector_data_offset  = 0;
+	off64_t sector_offset      = 0;
+	uint64_t sector_number     = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment map entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_map_entry->sector_size == 0 )
+	 || ( segment_map_entry->sector_size > 4096 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment map entry - sector size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_offset < 0 )
+	 || ( (size64_t) segment_offset >= segment_map_entry->size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) buffer_size > ( segment_map_entry->size - segment_offset ) )
+	{
+		buffer_size = (size_t) ( segment_map_entry->size - segment_offset );
+	}
+	if( segment_map_entry->encryption_context == NULL )
+	{
+		if( libluksde_file_mapping_get_data_at_offset(
+		     internal_volume->file_mapping,
+		     segment_map_entry->file_offset + segment_offset,
+		     buffer_size,
+		     &mapped_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve mapped data at segment offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 segment_offset,
+			 segment_offset );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     buffer,
+		     mapped_data,
+		     buffer_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy mapped data to buffer.",
+			 function );
+
+			return( -1 );
+		}
+		return( (ssize_t) buffer_size );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		sector_offset      = ( segment_offset / segment_map_entry->sector_size ) * segment_map_entry->sector_size;
+		sector_data_offset = (size_t) ( segment_offset - sector_offset );
+		sector_number      = segment_map_entry->initialization_vector_tweak + ( (uint64_t) sector_offset / 512 );
+
+		read_size = segment_map_entry->sector_size - sector_data_offset;
+
+		if( read_size > ( buffer_size - buffer_offset ) )
+		{
+			read_size = buffer_size - buffer_offset;
+		}
+		if( libluksde_file_mapping_get_data_at_offset(
+		     internal_volume->file_mapping,
+		     segment_map_entry->file_offset + sector_offset,
+		     segment_map_entry->sector_size,
+		     &mapped_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve mapped data of sector: %" PRIu64 ".",
+			 function,
+			 sector_number );
+
+			return( -1 );
+		}
+		if( read_size == segment_map_entry->sector_size )
+		{
+			if( libluksde_encryption_context_crypt(
+			     segment_map_entry->encryption_context,
+			     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+			     mapped_data,
+			     segment_map_entry->sector_size,
+			     &( buffer[ buffer_offset ] ),
+			     segment_map_entry->sector_size,
+			     sector_number,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to decrypt sector: %" PRIu64 " data.",
+				 function,
+				 sector_number );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			if( libluksde_encryption_context_crypt(
+			     segment_map_entry->encryption_context,
+			     LIBLUKSDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+			     mapped_data,
+			     segment_map_entry->sector_size,
+			     sector_data,
+			     segment_map_entry->sector_size,
+			     sector_number,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to decrypt sector: %" PRIu64 " data.",
+				 function,
+				 sector_number );
+
+				return( -1 );
+			}
+			if( memory_copy(
+			     &( buffer[ buffer_offset ] ),
+			     &( sector_data[ sector_data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy sector data to buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		buffer_offset  += read_size;
+		segment_offset += (off64_t) read_size;
+
+		if( internal_volume->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Reads segment data from the spill cache into a buffer
+ * A chunk that is not stored in the spill file is read, decrypted and written to the spill file
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read, 0 if the data cannot be cached or -1 on error
+ */
+ssize_t libluksde_internal_volume_read_segment_data_from_spill_cache(
+         libluksde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         libluksde_segment_map_entry_t *segment_map_entry,
+         off64_t segment_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libluksde_spill_cache_t *spill_cache = NULL;
+	static char *function                = "libluksde_internal_volume_read_segment_data_from_spill_cache";
+	size_t chunk_data_offset             = 0;
+	ssize_t read_count                   = 0;
+	off64_t chunk_segment_offset         = 0;
+	off64_t chunk_volume_offset          = 0;
+	uint64_t chunk_number                = 0;
+	int result                           = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->spill_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing spill cache.",
+		 function );
+
+		return( -1 );
+	}
+	spill_cache = internal_volume->spill_cache;
+
+	if( segment_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment map entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_map_entry->sector_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment map entry - sector size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_offset < 0 )
+	 || ( (size64_t) segment_offset >= segment_map_entry->size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( spill_cache->is_open == 0 )
+	{
+		if( libluksde_spill_cache_open(
+		     spill_cache,
+		     LIBLUKSDE_SPILL_CACHE_CHUNK_SIZE,
+		     internal_volume->io_handle->encrypted_volume_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open spill cache.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	chunk_number        = (uint64_t) ( segment_map_entry->volume_offset + segment_offset ) / spill_cache->chunk_size;
+	chunk_volume_offset = (off64_t) ( chunk_number * spill_cache->chunk_size );
+
+	/* Only chunks that fully fit within a segment and start on a sector boundary are cached
+	 */
+	if( ( chunk_number >= spill_cache->number_of_chunks )
+	 || ( chunk_volume_offset < segment_map_entry->volume_offset ) )
+	{
+		return( 0 );
+	}
+	chunk_segment_offset = chunk_volume_offset - segment_map_entry->volume_offset;
+
+	if( ( ( (size64_t) chunk_segment_offset + spill_cache->chunk_size ) > segment_map_entry->size )
+	 || ( ( chunk_segment_offset % segment_map_entry->sector_size ) != 0 ) )
+	{
+		return( 0 );
+	}
+	chunk_data_offset = (size_t) ( segment_offset - chunk_segment_offset );
+
+	if( buffer_size > ( spill_cache->chunk_size - chunk_data_offset ) )
+	{
+		buffer_size = spill_cache->chunk_size - chunk_data_offset;
+	}
+	result = libluksde_spill_cache_read_chunk_data(
+	          spill_cache,
+	          chunk_number,
+	          chunk_data_offset,
+	          buffer,
+	          buffer_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data from spill cache.",
+		 function,
+		 chunk_number );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( (ssize_t) buffer_size );
+	}
+	read_count = libluksde_sector_data_vector_read_sectors_at_offset(
+	              segment_map_entry->sector_data_vector,
+	              file_io_handle,
+	              internal_volume->io_callbacks,
+	              internal_volume->io_uring,
+	              segment_map_entry->encryption_context,
+	              chunk_segment_offset,
+	              spill_cache->chunk_data,
+	              spill_cache->chunk_size,
+	              error );
+
+	if( read_count != (ssize_t) spill_cache->chunk_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " sectors.",
+		 function,
+		 chunk_number );
+
+		return( -1 );
+	}
+	if( libluksde_spill_cache_write_chunk_data(
+	     spill_cache,
+	     chunk_number,
+	     spill_cache->chunk_data,
+	     spill_cache->chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk: %" PRIu64 " data to spill cache.",
+		 function,
+		 chunk_number );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     buffer,
+	     &( ( spill_cache->chunk_data )[ chunk_data_offset ] ),
+	     buffer_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy chunk data to buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( (ssize_t) buffer_size );
+}
+
+/* Reads (volume) data from the last current into a buffer using a Basic File IO (bfio) handle
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libluksde_internal_volume_read_buffer_from_file_io_handle(
+         libluksde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libluksde_sector_data_t *sector_data             = NULL;
+	libluksde_segment_map_entry_t *segment_map_entry = NULL;
+	static char *function                            = "libluksde_internal_volume_read_buffer_from_file_io_handle";
+	size64_t extent_size                             = 0;
+	size_t buffer_offset                             = 0;
+	size_t maximum_read_size                         = 0;
+	size_t read_size                                 = 0;
+	size_t remaining_buffer_size                     = 0;
+	size_t sector_data_offset                        = 0;
+	off64_t sector_offset                            = 0;
+	off64_t segment_offset                           = 0;
+	off64_t volume_offset                            = 0;
+	ssize_t read_count                               = 0;
+	int is_allocated                                 = 0;
+	int result                                       = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->is_locked != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - volume is locked.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->segment_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing segment map.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume->io_handle->abort = 0;
+
+	if( (size64_t) internal_volume->current_offset >= internal_volume->io_handle->encrypted_volume_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) buffer_size > ( internal_volume->io_handle->encrypted_volume_size - internal_volume->current_offset ) )
+	{
+		buffer_size = (size_t) ( internal_volume->io_handle->encrypted_volume_size - internal_volume->current_offset );
+	}
+	remaining_buffer_size = buffer_size;
+	volume_offset         = internal_volume->current_offset;
+
+	while( remaining_buffer_size > 0 )
+	{
+		/* The sectors do not span segments, hence a read that crosses a segment boundary
+		 * continues with the first sector of the next segment
+		 */
+		result = libluksde_segment_map_get_entry_at_offset(
+		          internal_volume->segment_map,
+		          volume_offset,
+		          &segment_map_entry,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment map entry at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 volume_offset,
+			 volume_offset );
+
+			return( -1 );
+		}
+		segment_offset     = volume_offset - segment_map_entry->volume_offset;
+		sector_offset      = ( segment_offset / segment_map_entry->sector_size ) * segment_map_entry->sector_size;
+		sector_data_offset = (size_t) ( segment_offset - sector_offset );
+
+		maximum_read_size = remaining_buffer_size;
+		is_allocated      = 1;
+
+		if( internal_volume->allocation_map != NULL )
+		{
+			/* The allocated ranges start and end on a sector boundary
+			 */
+			is_allocated = libluksde_allocation_map_get_extent_at_offset(
+			                internal_volume->allocation_map,
+			                volume_offset,
+			                &extent_size,
+			                error );
+
+			if( is_allocated == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve allocation extent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 volume_offset,
+				 volume_offset );
+
+				return( -1 );
+			}
+			if( (size64_t) maximum_read_size > extent_size )
+			{
+				maximum_read_size = (size_t) extent_size;
+			}
+		}
+		read_count = 0;
+
+		if( ( is_allocated != 0 )
+		 && ( internal_volume->file_mapping == NULL )
+		 && ( internal_volume->spill_cache != NULL ) )
+		{
+			read_count = libluksde_internal_volume_read_segment_data_from_spill_cache(
+			              internal_volume,
+			              file_io_handle,
+			              segment_map_entry,
+			              segment_offset,
+			              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			              maximum_read_size,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read segment data at offset: %" PRIi64 " (0x%08" PRIx64 ") from spill cache.",
+				 function,
+				 volume_offset,
+				 volume_offset );
+
+				return( -1 );
+			}
+		}
+		if( is_allocated == 0 )
+		{
+			/* The unallocated sectors are not read and decrypted
+			 */
+			read_size = maximum_read_size;
+
+			if( memory_set(
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     0,
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( read_count > 0 )
+		{
+			read_size = (size_t) read_count;
+		}
+		else if( internal_volume->file_mapping != NULL )
+		{
+			read_count = libluksde_internal_volume_read_segment_data_from_file_mapping(
+			              internal_volume,
+			              segment_map_entry,
+			              segment_offset,
+			              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			              maximum_read_size,
+			              error );
+
+			if( read_count <= 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read segment data at offset: %" PRIi64 " (0x%08" PRIx64 ") from file mapping.",
+				 function,
+				 volume_offset,
+				 volume_offset );
+
+				return( -1 );
+			}
+			read_size = (size_t) read_count;
+		}
+		else if( ( sector_data_offset == 0 )
+		      && ( maximum_read_size >= ( 2 * (size_t) segment_map_entry->sector_size ) ) )
+		{
+			/* Read consecutive sectors at once instead of one sector at a time
+			 */
+			read_size = maximum_read_size - ( maximum_read_size % segment_map_entry->sector_size );
+
+			if( (size64_t) read_size > ( segment_map_entry->size - sector_offset ) )
+			{
+				read_size = (size_t) ( segment_map_entry->size - sector_offset );
+			}
+			if( libluksde_io_handle_get_sectors_read_size(
+			     internal_volume->io_handle,
+			     segment_map_entry->file_offset + sector_offset,
+			     segment_map_entry->sector_size,
+			     &read_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine sectors read size.",
+				 function );
+
+				return( -1 );
+			}
+			read_count = libluksde_sector_data_vector_read_sectors_at_offset(
+			              segment_map_entry->sector_data_vector,
+			              file_io_handle,
+			              internal_volume->io_callbacks,
+			              internal_volume->io_uring,
+			              segment_map_entry->encryption_context,
+			              sector_offset,
+			              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			              read_size,
+			              error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read sectors at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 volume_offset,
+				 volume_offset );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			read_size = segment_map_entry->sector_size - sector_data_offset;
+
+			if( read_size > maximum_read_size )
+			{
+				read_size = maximum_read_size;
+			}
+			if( libluksde_sector_data_vector_get_sector_data_at_offset(
+			     segment_map_entry->sector_data_vector,
+			     file_io_handle,
+			     internal_volume->io_callbacks,
+			     segment_map_entry->encryption_context,
+			     sector_offset,
+			     &sector_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve sector data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 volume_offset,
+				 volume_offset );
+
+				return( -1 );
+			}
+			if( sector_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing sector data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 volume_offset,
+				 volume_offset );
+
+				return( -1 );
+			}
+			if( memory_copy(
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     &( ( sector_data->data )[ sector_data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy sector data to buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+                buffer_offset         += read_size;
+                remaining_buffer_size -= read_size;
+		volume_offset         += (off64_t) read_size;
+
+		if( internal_volume->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	internal_volume->current_offset += (off64_t) buffer_offset;
+
+	return( (ssize_t) buffer_offset );
+}
+
+/* Reads data at the current offset into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libluksde_volume_read_buffer(
+         libluksde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_read_buffer";
+	ssize_t read_count                           = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libluksde_internal_volume_read_buffer_from_file_io_handle(
+		      internal_volume,
+		      internal_volume->file_io_handle,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (volume) data at a specific offset
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libluksde_volume_read_buffer_at_offset(
+         libluksde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_read_buffer_at_offset";
+	ssize_t read_count                           = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libluksde_internal_volume_seek_offset(
+	     internal_volume,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libluksde_internal_volume_read_buffer_from_file_io_handle(
+		      internal_volume,
+		      internal_volume->file_io_handle,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+
+on_error:
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Compares the offsets of two I/O vectors
+ * Callback function to sort the I/O vectors
+ * Returns -1 if the first offset is smaller than the second, 0 if equal or 1 if larger
+ */
+int libluksde_internal_volume_compare_vectors(
+     const void *first_vector,
+     const void *second_vector )
+{
+	const libluksde_iovec_t *first_iovec  = NULL;
+	const libluksde_iovec_t *second_iovec = NULL;
+
+	first_iovec  = *( (const libluksde_iovec_t **) first_vector );
+	second_iovec = *( (const libluksde_iovec_t **) second_vector );
+
+	if( first_iovec->offset < second_iovec->offset )
+	{
+		return( -1 );
+	}
+	else if( first_iovec->offset > second_iovec->offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Reads (volume) data into multiple buffers at specific offsets using a Basic File IO (bfio) handle
+ * The vectors are sorted by offset and vectors that start in or directly after the sectors
+ * of the preceding vectors are combined into a single read of consecutive sectors, that is
+ * decrypted once and copied into the buffers of the vectors
+ * The current offset is not changed
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libluksde_internal_volume_read_vectors_from_file_io_handle(
+         libluksde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         const libluksde_iovec_t *vectors,
+         int number_of_vectors,
+         libcerror_error_t **error )
+{
+	const libluksde_iovec_t **sorted_vectors         = NULL;
+	const libluksde_iovec_t *vector                  = NULL;
+	libluksde_segment_map_entry_t *segment_map_entry = NULL;
+	uint8_t *sectors_data                            = NULL;
+	void *reallocation                               = NULL;
+	static char *function                            = "libluksde_internal_volume_read_vectors_from_file_io_handle";
+	size64_t extent_size                             = 0;
+	size64_t volume_size                             = 0;
+	size_t copy_size                                 = 0;
+	size_t read_size                                 = 0;
+	size_t sectors_data_size                         = 0;
+	size_t total_size                                = 0;
+	ssize_t read_count                               = 0;
+	ssize_t total_read_count                         = 0;
+	off64_t copy_offset                              = 0;
+	off64_t current_offset                           = 0;
+	off64_t range_end_offset                         = 0;
+	off64_t range_sectors_end_offset                 = 0;
+	off64_t read_end_offset                          = 0;
+	off64_t read_offset                              = 0;
+	off64_t sector_offset                            = 0;
+	off64_t segment_end_offset                       = 0;
+	off64_t vector_end_offset                        = 0;
+	int first_vector_index                           = 0;
+	int is_allocated                                 = 0;
+	int last_vector_index                            = 0;
+	int result                                       = 0;
+	int vector_index                                 = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->is_locked != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - volume is locked.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->segment_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing segment map.",
+		 function );
+
+		return( -1 );
+	}
+	if( vectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid vectors.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_vectors < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of vectors value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	for( vector_index = 0;
+	     vector_index < number_of_vectors;
+	     vector_index++ )
+	{
+		vector = &( vectors[ vector_index ] );
+
+		if( vector->buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid vector: %d - missing buffer.",
+			 function,
+			 vector_index );
+
+			return( -1 );
+		}
+		if( vector->buffer_size > ( (size_t) SSIZE_MAX - total_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid vector: %d - buffer size value exceeds maximum.",
+			 function,
+			 vector_index );
+
+			return( -1 );
+		}
+		if( vector->offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+			 "%s: invalid vector: %d - offset value less than zero.",
+			 function,
+			 vector_index );
+
+			return( -1 );
+		}
+		total_size += vector->buffer_size;
+	}
+	internal_volume->io_handle->abort = 0;
+
+	if( number_of_vectors == 0 )
+	{
+		return( 0 );
+	}
+	if( internal_volume->file_mapping != NULL )
+	{
+		/* The mapped data is decrypted directly into the buffers hence there are no
+		 * reads to combine
+		 */
+		current_offset = internal_volume->current_offset;
+
+		for( vector_index = 0;
+		     vector_index < number_of_vectors;
+		     vector_index++ )
+		{
+			vector = &( vectors[ vector_index ] );
+
+			internal_volume->current_offset = vector->offset;
+
+			read_count = libluksde_internal_volume_read_buffer_from_file_io_handle(
+			              internal_volume,
+			              file_io_handle,
+			              vector->buffer,
+			              vector->buffer_size,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read vector: %d.",
+				 function,
+				 vector_index );
+
+				internal_volume->current_offset = current_offset;
+
+				return( -1 );
+			}
+			total_read_count += read_count;
+
+			if( internal_volume->io_handle->abort != 0 )
+			{
+				break;
+			}
+		}
+		internal_volume->current_offset = current_offset;
+
+		return( total_read_count );
+	}
+	sorted_vectors = (const libluksde_iovec_t **) memory_allocate(
+	                                               sizeof( libluksde_iovec_t * ) * number_of_vectors );
+
+	if( sorted_vectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sorted vectors.",
+		 function );
+
+		goto on_error;
+	}
+	for( vector_index = 0;
+	     vector_index < number_of_vectors;
+	     vector_index++ )
+	{
+		sorted_vectors[ vector_index ] = &( vectors[ vector_index ] );
+	}
+	qsort(
+	 (void *) sorted_vectors,
+	 (size_t) number_of_vectors,
+	 sizeof( libluksde_iovec_t * ),
+	 &libluksde_internal_volume_compare_vectors );
+
+	volume_size  = internal_volume->io_handle->encrypted_volume_size;
+	vector_index = 0;
+
+	while( vector_index < number_of_vectors )
+	{
+		vector = sorted_vectors[ vector_index ];
+
+		if( (size64_t) vector->offset >= volume_size )
+		{
+			/* The vectors are sorted hence the remaining vectors are beyond the end of the volume as well
+			 */
+			break;
+		}
+		if( vector->buffer_size == 0 )
+		{
+			vector_index++;
+
+			continue;
+		}
+		first_vector_index = vector_index;
+		read_offset        = vector->offset;
+		range_end_offset   = vector->offset + (off64_t) vector->buffer_size;
+
+		if( (size64_t) range_end_offset > volume_size )
+		{
+			range_end_offset = (off64_t) volume_size;
+		}
+		range_sectors_end_offset = 0;
+
+		for( vector_index = vector_index + 1;
+		     vector_index < number_of_vectors;
+		     vector_index++ )
+		{
+			vector = sorted_vectors[ vector_index ];
+
+			if( (size64_t) vector->offset >= volume_size )
+			{
+				break;
+			}
+			if( range_sectors_end_offset < range_end_offset )
+			{
+				/* Determine the end of the last sector of the range
+				 */
+				result = libluksde_segment_map_get_entry_at_offset(
+				          internal_volume->segment_map,
+				          range_end_offset - 1,
+				          &segment_map_entry,
+				          error );
+
+				if( result != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve segment map entry at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 range_end_offset - 1,
+					 range_end_offset - 1 );
+
+					goto on_error;
+				}
+				sector_offset = range_end_offset - 1 - segment_map_entry->volume_offset;
+				sector_offset = ( sector_offset / segment_map_entry->sector_size ) * segment_map_entry->sector_size;
+
+				range_sectors_end_offset = segment_map_entry->volume_offset + sector_offset + segment_map_entry->sector_size;
+			}
+			/* A vector that starts beyond the sector directly after the range is read separately
+			 */
+			if( vector->offset > range_sectors_end_offset )
+			{
+				break;
+			}
+			vector_end_offset = vector->offset + (off64_t) vector->buffer_size;
+
+			if( (size64_t) vector_end_offset > volume_size )
+			{
+				vector_end_offset = (off64_t) volume_size;
+			}
+			if( vector_end_offset > range_end_offset )
+			{
+				range_end_offset = vector_end_offset;
+			}
+		}
+		last_vector_index = vector_index - 1;
+
+		while( read_offset < range_end_offset )
+		{
+			result = libluksde_segment_map_get_entry_at_offset(
+			          internal_volume->segment_map,
+			          read_offset,
+			          &segment_map_entry,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment map entry at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 read_offset,
+				 read_offset );
+
+				goto on_error;
+			}
+			/* The sectors do not span segments, hence a range that crosses a segment boundary
+			 * continues with the first sector of the next segment
+			 */
+			sector_offset = read_offset - segment_map_entry->volume_offset;
+			sector_offset = ( sector_offset / segment_map_entry->sector_size ) * segment_map_entry->sector_size;
+
+			segment_end_offset = range_end_offset - segment_map_entry->volume_offset;
+
+			if( (size64_t) segment_end_offset > segment_map_entry->size )
+			{
+				segment_end_offset = (off64_t) segment_map_entry->size;
+			}
+			segment_end_offset = ( ( segment_end_offset + segment_map_entry->sector_size - 1 ) / segment_map_entry->sector_size ) * segment_map_entry->sector_size;
+
+			if( (size64_t) segment_end_offset > segment_map_entry->size )
+			{
+				segment_end_offset = (off64_t) segment_map_entry->size;
+			}
+			read_size = (size_t) ( segment_end_offset - sector_offset );
+
+			if( libluksde_io_handle_get_sectors_read_size(
+			     internal_volume->io_handle,
+			     segment_map_entry->file_offset + sector_offset,
+			     segment_map_entry->sector_size,
+			     &read_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine sectors read size.",
+				 function );
+
+				goto on_error;
+			}
+			is_allocated = 1;
+
+			if( internal_volume->allocation_map != NULL )
+			{
+				is_allocated = libluksde_allocation_map_get_extent_at_offset(
+				                internal_volume->allocation_map,
+				                segment_map_entry->volume_offset + sector_offset,
+				                &extent_size,
+				                error );
+
+				if( is_allocated == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve allocation extent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 read_offset,
+					 read_offset );
+
+					goto on_error;
+				}
+				if( (size64_t) read_size > extent_size )
+				{
+					read_size = (size_t) extent_size;
+				}
+			}
+			if( read_size > sectors_data_size )
+			{
+				reallocation = memory_reallocate(
+				                sectors_data,
+				                sizeof( uint8_t ) * read_size );
+
+				if( reallocation == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to resize sectors data.",
+					 function );
+
+					goto on_error;
+				}
+				sectors_data      = (uint8_t *) reallocation;
+				sectors_data_size = read_size;
+			}
+			if( is_allocated == 0 )
+			{
+				/* The unallocated sectors are not read and decrypted
+				 */
+				if( memory_set(
+				     sectors_data,
+				     0,
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear sectors data.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			else
+			{
+				read_count = libluksde_sector_data_vector_read_sectors_at_offset(
+				              segment_map_entry->sector_data_vector,
+				              file_io_handle,
+				              internal_volume->io_callbacks,
+				              internal_volume->io_uring,
+				              segment_map_entry->encryption_context,
+				              sector_offset,
+				              sectors_data,
+				              read_size,
+				              error );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read sectors at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 read_offset,
+					 read_offset );
+
+					goto on_error;
+				}
+			}
+			read_offset     = segment_map_entry->volume_offset + sector_offset;
+			read_end_offset = read_offset + (off64_t) read_size;
+
+			/* Copy the sectors data into the buffers of the vectors that overlap with the sectors
+			 */
+			for( vector_index = first_vector_index;
+			     vector_index <= last_vector_index;
+			     vector_index++ )
+			{
+				vector = sorted_vectors[ vector_index ];
+
+				if( vector->offset >= read_end_offset )
+				{
+					break;
+				}
+				vector_end_offset = vector->offset + (off64_t) vector->buffer_size;
+
+				if( (size64_t) vector_end_offset > volume_size )
+				{
+					vector_end_offset = (off64_t) volume_size;
+				}
+				if( vector_end_offset <= read_offset )
+				{
+					continue;
+				}
+				copy_offset = vector->offset;
+
+				if( copy_offset < read_offset )
+				{
+					copy_offset = read_offset;
+				}
+				if( vector_end_offset > read_end_offset )
+				{
+					vector_end_offset = read_end_offset;
+				}
+				copy_size = (size_t) ( vector_end_offset - copy_offset );
+
+				if( memory_copy(
+				     &( ( (uint8_t *) vector->buffer )[ copy_offset - vector->offset ] ),
+				     &( sectors_data[ copy_offset - read_offset ] ),
+				     copy_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy sectors data to buffer of vector.",
+					 function );
+
+					goto on_error;
+				}
+				total_read_count += (ssize_t) copy_size;
+			}
+			read_offset = read_end_offset;
+
+			if( internal_volume->io_handle->abort != 0 )
+			{
+				break;
+			}
+		}
+		if( internal_volume->io_handle->abort != 0 )
+		{
+			break;
+		}
+		vector_index = last_vector_index + 1;
+	}
+	if( sectors_data != NULL )
+	{
+		memory_free(
+		 sectors_data );
+	}
+	memory_free(
+	 sorted_vectors );
+
+	return( total_read_count );
+
+on_error:
+	if( sectors_data != NULL )
+	{
+		memory_free(
+		 sectors_data );
+	}
+	if( sorted_vectors != NULL )
+	{
+		memory_free(
+		 sorted_vectors );
+	}
+	return( -1 );
+}
+
+/* Reads (volume) data into multiple buffers at specific offsets
+ * The vectors are read under a single acquisition of the volume lock
+ * The current offset is not changed
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libluksde_volume_read_vectors(
+         libluksde_volume_t *volume,
+         const libluksde_iovec_t *vectors,
+         int number_of_vectors,
+         libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_read_vectors";
+	ssize_t read_count                           = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libluksde_internal_volume_read_vectors_from_file_io_handle(
+		      internal_volume,
+		      internal_volume->file_io_handle,
+		      vectors,
+		      number_of_vectors,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read vectors.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+
+/* Reads the data of a read request using a file IO handle from the file IO handle pool
+ * or the I/O callbacks
+ * The encrypted data is read with the volume locked for reading, so that multiple threads
+ * can read from their own file IO handle or the pread-style I/O callbacks concurrently,
+ * and decrypted with the volume locked for writing, since the encryption context is shared.
+ * The cache is not used.
+ * Returns 1 if successful, 0 if the read request cannot be read this way or -1 on error
+ */
+int libluksde_internal_volume_read_request_with_file_io_handle_pool(
+     libluksde_internal_volume_t *internal_volume,
+     libluksde_read_request_t *read_request,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle                 = NULL;
+	libluksde_segment_map_entry_t *segment_map_entry = NULL;
+	uint8_t *encrypted_data                          = NULL;
+	uint8_t *sectors_data                            = NULL;
+	static char *function                            = "libluksde_internal_volume_read_request_with_file_io_handle_pool";
+	size64_t extent_size                             = 0;
+	size_t buffer_offset                             = 0;
+	size_t buffer_size                               = 0;
+	size_t encrypted_data_size                       = 0;
+	size_t read_size                                 = 0;
+	size_t sector_data_offset                        = 0;
+	ssize_t read_count                               = 0;
+	off64_t sector_offset                            = 0;
+	off64_t segment_offset                           = 0;
+	int is_allocated                                 = 0;
+	int result                                       = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	/* The read request is left to the regular read path, which also reports
+	 * an invalid volume state or offset
+	 */
+	if( ( ( internal_volume->file_io_handle_pool == NULL )
+	  &&  ( internal_volume->io_callbacks == NULL ) )
+	 || ( internal_volume->file_mapping != NULL )
+	 || ( internal_volume->spill_cache != NULL )
+	 || ( internal_volume->is_locked != 0 )
+	 || ( internal_volume->io_handle == NULL )
+	 || ( internal_volume->segment_map == NULL )
+	 || ( read_request->offset < 0 )
+	 || ( read_request->buffer == NULL )
+	 || ( read_request->buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		goto on_fallback;
+	}
+	if( (size64_t) read_request->offset >= internal_volume->io_handle->encrypted_volume_size )
+	{
+		read_request->read_count = 0;
+
+		result = 1;
+
+		goto on_fallback;
+	}
+	buffer_size = read_request->buffer_size;
+
+	if( (size64_t) buffer_size > ( internal_volume->io_handle->encrypted_volume_size - read_request->offset ) )
+	{
+		buffer_size = (size_t) ( internal_volume->io_handle->encrypted_volume_size - read_request->offset );
+	}
+	if( buffer_size == 0 )
+	{
+		read_request->read_count = 0;
+
+		result = 1;
+
+		goto on_fallback;
+	}
+	if( libluksde_segment_map_get_entry_at_offset(
+	     internal_volume->segment_map,
+	     read_request->offset,
+	     &segment_map_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment map entry at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 read_request->offset,
+		 read_request->offset );
+
+		goto on_error_read_lock;
+	}
+	segment_offset     = read_request->offset - segment_map_entry->volume_offset;
+	sector_offset      = ( segment_offset / segment_map_entry->sector_size ) * segment_map_entry->sector_size;
+	sector_data_offset = (size_t) ( segment_offset - sector_offset );
+
+	/* Read requests that cross a segment boundary are left to the regular read path
+	 */
+	if( (size64_t) buffer_size > ( segment_map_entry->size - segment_offset ) )
+	{
+		goto on_fallback;
+	}
+	encrypted_data_size = sector_data_offset + buffer_size;
+
+	if( ( encrypted_data_size % segment_map_entry->sector_size ) != 0 )
+	{
+		encrypted_data_size += segment_map_entry->sector_size - ( encrypted_data_size % segment_map_entry->sector_size );
+	}
+	if( ( encrypted_data_size > (size_t) LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE )
+	 || ( (size64_t) encrypted_data_size > ( segment_map_entry->size - sector_offset ) ) )
+	{
+		goto on_fallback;
+	}
+	/* The I/O callbacks read at an explicit offset and need no file IO handle of their own
+	 */
+	if( internal_volume->io_callbacks == NULL )
+	{
+		result = libluksde_file_io_handle_pool_grab_file_io_handle(
+		          internal_volume->file_io_handle_pool,
+		          &file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab file IO handle from pool.",
+			 function );
+
+			goto on_error_read_lock;
+		}
+		else if( result == 0 )
+		{
+			goto on_fallback;
+		}
+	}
+	encrypted_data = (uint8_t *) memory_allocate(
+	                              sizeof( uint8_t ) * encrypted_data_size );
+
+	if( encrypted_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create encrypted data.",
+		 function );
+
+		goto on_error_read_lock;
+	}
+	read_count = libluksde_sector_data_vector_read_encrypted_sectors_at_offset(
+	              segment_map_entry->sector_data_vector,
+	              file_io_handle,
+	              internal_volume->io_callbacks,
+	              sector_offset,
+	              encrypted_data,
+	              encrypted_data_size,
+	              error );
+
+	if( read_count != (ssize_t) encrypted_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read encrypted sectors at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 read_request->offset,
+		 read_request->offset );
+
+		goto on_error_read_lock;
+	}
+	if( file_io_handle != NULL )
+	{
+		result = libluksde_file_io_handle_pool_release_file_io_handle(
+		          internal_volume->file_io_handle_pool,
+		          file_io_handle,
+		          error );
+
+		file_io_handle = NULL;
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release file IO handle to pool.",
+			 function );
+
+			goto on_error_read_lock;
+		}
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+	/* Decrypt directly into the buffer if the read request consists of whole sectors
+	 */
+	if( encrypted_data_size == buffer_size )
+	{
+		sectors_data = (uint8_t *) read_request->buffer;
+	}
+	else
+	{
+		sectors_data = (uint8_t *) memory_allocate(
+		                            sizeof( uint8_t ) * encrypted_data_size );
+
+		if( sectors_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create sectors data.",
+			 function );
+
+			goto on_error_write_lock;
+		}
+	}
+	if( libluksde_sector_data_vector_decrypt_sectors_at_offset(
+	     segment_map_entry->sector_data_vector,
+	     segment_map_entry->encryption_context,
+	     sector_offset,
+	     encrypted_data,
+	     encrypted_data_size,
+	     sectors_data,
+	     encrypted_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to decrypt sectors at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 read_request->offset,
+		 read_request->offset );
+
+		goto on_error_write_lock;
+	}
+	if( sectors_data != read_request->buffer )
+	{
+		if( memory_copy(
+		     read_request->buffer,
+		     &( sectors_data[ sector_data_offset ] ),
+		     buffer_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy sectors data to buffer.",
+			 function );
+
+			goto on_error_write_lock;
+		}
+		memory_free(
+		 sectors_data );
+
+		sectors_data = NULL;
+	}
+	/* The unallocated sectors were read and decrypted but are returned as zero bytes
+	 * as in the regular read path
+	 */
+	while( ( internal_volume->allocation_map != NULL )
+	    && ( buffer_offset < buffer_size ) )
+	{
+		is_allocated = libluksde_allocation_map_get_extent_at_offset(
+		                internal_volume->allocation_map,
+		                read_request->offset + (off64_t) buffer_offset,
+		                &extent_size,
+		                error );
+
+		if( is_allocated == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve allocation extent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_request->offset + (off64_t) buffer_offset,
+			 read_request->offset + (off64_t) buffer_offset );
+
+			goto on_error_write_lock;
+		}
+		read_size = buffer_size - buffer_offset;
+
+		if( (size64_t) read_size > extent_size )
+		{
+			read_size = (size_t) extent_size;
+		}
+		if( is_allocated == 0 )
+		{
+			if( memory_set(
+			     &( ( (uint8_t *) read_request->buffer )[ buffer_offset ] ),
+			     0,
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear buffer.",
+				 function );
+
+				goto on_error_write_lock;
+			}
+		}
+		buffer_offset += read_size;
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 encrypted_data );
+
+	read_request->read_count = (ssize_t) buffer_size;
+
+	return( 1 );
+
+on_fallback:
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error_write_lock:
+	if( ( sectors_data != NULL )
+	 && ( sectors_data != read_request->buffer ) )
+	{
+		memory_free(
+		 sectors_data );
+	}
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+
+	goto on_error;
+
+on_error_read_lock:
+	if( file_io_handle != NULL )
+	{
+		libluksde_file_io_handle_pool_release_file_io_handle(
+		 internal_volume->file_io_handle_pool,
+		 file_io_handle,
+		 NULL );
+	}
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->read_write_lock,
+	 NULL );
+
+on_error:
+	if( encrypted_data != NULL )
+	{
+		memory_free(
+		 encrypted_data );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+
+/* Reads the data of a read request
+ * Callback function for the read queue, the current offset of the volume is not changed
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_internal_volume_read_request(
+     libluksde_volume_t *volume,
+     libluksde_read_request_t *read_request,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_internal_volume_read_request";
+	off64_t current_offset                       = 0;
+	ssize_t read_count                           = 0;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	int result                                   = 0;
+#endif
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	read_request->read_count = -1;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	result = libluksde_internal_volume_read_request_with_file_io_handle_pool(
+	          internal_volume,
+	          read_request,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer using file IO handle pool.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 1 );
+	}
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	current_offset = internal_volume->current_offset;
+
+	if( libluksde_internal_volume_seek_offset(
+	     internal_volume,
+	     read_request->offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libluksde_internal_volume_read_buffer_from_file_io_handle(
+		      internal_volume,
+		      internal_volume->file_io_handle,
+		      read_request->buffer,
+		      read_request->buffer_size,
+		      error );
+
+	internal_volume->current_offset = current_offset;
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_request->read_count = read_count;
+
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads (volume) data at a specific offset asynchronously
+ * The callback function is called with the number of bytes read, or -1 on error,
+ * when the read has completed. The callback functions are called from a worker
+ * thread but never concurrently. The current offset of the volume is not changed.
+ * Without multi-threading support the read is completed before this function returns
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_read_buffer_at_offset_async(
+     libluksde_volume_t *volume,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+            libluksde_volume_t *volume,
+            void *buffer,
+            ssize_t read_count,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	libluksde_read_request_t *read_request       = NULL;
+	static char *function                        = "libluksde_volume_read_buffer_at_offset_async";
+
+#if !defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	libcerror_error_t *read_error                = NULL;
+#endif
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_read_request_initialize(
+	     &read_request,
+	     buffer,
+	     buffer_size,
+	     offset,
+	     callback_function,
+	     user_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read request.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_volume->read_queue == NULL )
+	{
+		/* The volume data read with the I/O callbacks is read concurrently
+		 * without a file IO handle pool, the volume data read with the file
+		 * mapping does not use the file IO handle and the volume data read
+		 * with the spill cache is read by the regular read path
+		 */
+		if( ( internal_volume->file_io_handle_pool == NULL )
+		 && ( internal_volume->file_mapping == NULL )
+		 && ( internal_volume->io_callbacks == NULL )
+		 && ( internal_volume->spill_cache == NULL ) )
+		{
+			if( libluksde_file_io_handle_pool_initialize(
+			     &( internal_volume->file_io_handle_pool ),
+			     internal_volume->file_io_handle,
+			     LIBLUKSDE_READ_QUEUE_NUMBER_OF_THREADS,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create file IO handle pool.",
+				 function );
+
+				libcthreads_read_write_lock_release_for_write(
+				 internal_volume->read_write_lock,
+				 NULL );
+
+				goto on_error;
+			}
+		}
+		if( libluksde_read_queue_initialize(
+		     &( internal_volume->read_queue ),
+		     volume,
+		     &libluksde_internal_volume_read_request,
+		     LIBLUKSDE_READ_QUEUE_NUMBER_OF_THREADS,
+		     LIBLUKSDE_READ_QUEUE_MAXIMUM_NUMBER_OF_READ_REQUESTS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read queue.",
+			 function );
+
+			libcthreads_read_write_lock_release_for_write(
+			 internal_volume->read_write_lock,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+	/* The lock is not held while pushing since the worker threads need it to process the queued read requests
+	 */
+	if( libluksde_read_queue_push_read_request(
+	     internal_volume->read_queue,
+	     read_request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push read request onto read queue.",
+		 function );
+
+		goto on_error;
+	}
+#else
+	if( libluksde_internal_volume_read_request(
+	     volume,
+	     read_request,
+	     &read_error ) != 1 )
+	{
+		libcerror_error_free(
+		 &read_error );
+	}
+	read_request->callback_function(
+	 volume,
+	 read_request->buffer,
+	 read_request->read_count,
+	 read_request->user_data );
+
+	if( libluksde_read_request_free(
+	     &read_request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read request.",
+		 function );
+
+		goto on_error;
+	}
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+
+	return( 1 );
+
+on_error:
+	if( read_request != NULL )
+	{
+		libluksde_read_request_free(
+		 &read_request,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Waits until the callback functions of all asynchronous reads have been called
+ * This function must not be called from a callback function
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_wait_for_async_reads(
+     libluksde_volume_t *volume,
+     libcerror_error_t **error )
+{
+	static char *function                        = "libluksde_volume_wait_for_async_reads";
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	libluksde_internal_volume_t *internal_volume = NULL;
+	libluksde_read_queue_t *read_queue           = NULL;
+#endif
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	read_queue = internal_volume->read_queue;
+
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	/* The lock is not held while waiting since the worker threads need it to process the queued read requests
+	 */
+	if( read_queue != NULL )
+	{
+		if( libluksde_read_queue_wait(
+		     read_queue,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for read queue.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+
+	return( 1 );
+}
+
+/* Seeks a certain offset of the (volume) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libluksde_internal_volume_seek_offset(
+         libluksde_internal_volume_t *internal_volume,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libluksde_internal_volume_seek_offset";
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->is_locked != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - volume is locked.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{	
+		offset += internal_volume->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{	
+		offset += (off64_t) internal_volume->io_handle->encrypted_volume_size;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: seeking volume data offset: %" PRIi64 ".\n",
+		 function,
+		 offset );
+	}
+#endif
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libluksde_volume_seek_offset(
+         libluksde_volume_t *volume,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_seek_offset";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libluksde_internal_volume_seek_offset(
+	          internal_volume,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		offset = -1;
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (volume) data
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_get_offset(
+     libluksde_volume_t *volume,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_get_offset";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_volume->current_offset;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the size
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_get_size(
+     libluksde_volume_t *volume,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_get_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_internal_volume_read_deferred_metadata(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred metadata.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*size = internal_volume->io_handle->encrypted_volume_size;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the number of allocated ranges
+ * The allocated ranges are only determined when the volume was opened to skip
+ * the unallocated regions, otherwise the entire volume is a single allocated range
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_get_number_of_allocated_ranges(
+     libluksde_volume_t *volume,
+     int *number_of_ranges,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_get_number_of_allocated_ranges";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_internal_volume_read_deferred_metadata(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred metadata.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->allocation_map != NULL )
+	{
+		if( libluksde_allocation_map_get_number_of_ranges(
+		     internal_volume->allocation_map,
+		     number_of_ranges,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of ranges from allocation map.",
+			 function );
+
+			result = -1;
+		}
+	}
+	else if( internal_volume->io_handle->encrypted_volume_size > 0 )
+	{
+		*number_of_ranges = 1;
+	}
+	else
+	{
+		*number_of_ranges = 0;
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a specific allocated range
+ * The offset is relative to the start of the (decrypted) volume data
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_get_allocated_range_by_index(
+     libluksde_volume_t *volume,
+     int range_index,
+     off64_t *offset,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_get_allocated_range_by_index";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_internal_volume_read_deferred_metadata(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred metadata.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->allocation_map != NULL )
+	{
+		if( libluksde_allocation_map_get_range_by_index(
+		     internal_volume->allocation_map,
+		     range_index,
+		     offset,
+		     size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range: %d from allocation map.",
+			 function,
+			 range_index );
+
+			result = -1;
+		}
+	}
+	else if( ( range_index != 0 )
+	      || ( internal_volume->io_handle->encrypted_volume_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range index value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		*offset = 0;
+		*size   = internal_volume->io_handle->encrypted_volume_size;
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the encryption method
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_get_encryption_method(
+     libluksde_volume_t *volume,
+     int *encryption_method,
+     int *encryption_chaining_mode,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_get_encryption_method";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( encryption_method == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encryption method.",
+		 function );
+
+		return( -1 );
+	}
+	if( encryption_chaining_mode == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encryption chaining mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_internal_volume_read_deferred_metadata(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred metadata.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*encryption_method        = internal_volume->volume_header->encryption_method;
+	*encryption_chaining_mode = internal_volume->volume_header->encryption_chaining_mode;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the hashing method
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_get_hashing_method(
+     libluksde_volume_t *volume,
+     int *hashing_method,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_get_hashing_method";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( hashing_method == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hashing method.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_internal_volume_read_deferred_metadata(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred metadata.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*hashing_method = internal_volume->volume_header->hashing_method;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the master key size
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_get_master_key_size(
+     libluksde_volume_t *volume,
+     size_t *master_key_size,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_get_master_key_size";
 
-			goto on_error;
-		}
-	}
-	if( internal_volume->encryption_context != NULL )
+	if( volume == NULL )
 	{
-		return( 1 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
 	}
-	return( 0 );
+	internal_volume = (libluksde_internal_volume_t *) volume;
 
-on_error:
-	if( user_key_encryption_context != NULL )
+	if( internal_volume->volume_header == NULL )
 	{
-		libluksde_encryption_context_free(
-		 &user_key_encryption_context,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
 	}
-	if( split_master_key_data != NULL )
+	if( master_key_size == NULL )
 	{
-		memory_set(
-		 split_master_key_data,
-		 0,
-		 key_material_size );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid master key size.",
+		 function );
 
-		memory_free(
-		 split_master_key_data );
+		return( -1 );
 	}
-	if( key_material_data != NULL )
+	if( libluksde_internal_volume_read_deferred_metadata(
+	     internal_volume,
+	     error ) != 1 )
 	{
-		memory_free(
-		 key_material_data );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred metadata.",
+		 function );
+
+		return( -1 );
 	}
-	memory_set(
-	 user_key,
-	 0,
-	 32 );
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
-	return( -1 );
+		return( -1 );
+	}
+#endif
+	*master_key_size = (size_t) internal_volume->volume_header->master_key_size;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
 }
 
-/* Determines if the volume is locked
- * Returns 1 if locked, 0 if not or -1 on error
+/* Retrieves the number of iterations used to calculate the master key validation hash
+ * Returns 1 if successful or -1 on error
  */
-int libluksde_volume_is_locked(
+int libluksde_volume_get_master_key_number_of_iterations(
      libluksde_volume_t *volume,
+     uint32_t *number_of_iterations,
      libcerror_error_t **error )
 {
 	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_is_locked";
-	uint8_t is_locked                            = 0;
+	static char *function                        = "libluksde_volume_get_master_key_number_of_iterations";
 
 	if( volume == NULL )
 	{
@@ -1828,7 +8175,42 @@ int libluksde_volume_is_locked(
 	}
 	internal_volume = (libluksde_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_iterations == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of iterations.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_internal_volume_read_deferred_metadata(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred metadata.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
@@ -1843,9 +8225,9 @@ int libluksde_volume_is_locked(
 		return( -1 );
 	}
 #endif
-	is_locked = internal_volume->is_locked;
+	*number_of_iterations = internal_volume->volume_header->master_key_number_of_iterations;
 
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
@@ -1860,21 +8242,22 @@ int libluksde_volume_is_locked(
 		return( -1 );
 	}
 #endif
-	return( is_locked );
+	return( 1 );
 }
 
-/* Unlocks the volume
- * Returns 1 if the volume is unlocked, 0 if not or -1 on error
+/* Retrieves the number of key slots
+ * Returns 1 if successful or -1 on error
  */
-int libluksde_internal_volume_unlock(
-     libluksde_internal_volume_t *internal_volume,
-     libbfio_handle_t *file_io_handle,
+int libluksde_volume_get_number_of_key_slots(
+     libluksde_volume_t *volume,
+     int *number_of_key_slots,
      libcerror_error_t **error )
 {
-	static char *function = "libluksde_internal_volume_unlock";
-	int result            = 0;
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_get_number_of_key_slots";
+	int result                                   = 1;
 
-	if( internal_volume == NULL )
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1885,38 +8268,94 @@ int libluksde_internal_volume_unlock(
 
 		return( -1 );
 	}
-	result = libluksde_internal_volume_open_read_keys(
-	          internal_volume,
-	          file_io_handle,
-	          error );
+	internal_volume = (libluksde_internal_volume_t *) volume;
 
-	if( result == -1 )
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_internal_volume_read_deferred_metadata(
+	     internal_volume,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read keys.",
+		 "%s: unable to read deferred metadata.",
 		 function );
 
 		return( -1 );
 	}
-	else if( result != 0 )
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
-		internal_volume->is_locked = 0;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->volume_header->key_slots_array,
+	     number_of_key_slots,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of key slots.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
 	}
+#endif
 	return( result );
 }
 
-/* Unlocks the volume
- * Returns 1 if the volume is unlocked, 0 if not or -1 on error
+/* Retrieves the values of a specific key slot
+ * A key slot is active if it contains key material that can be unlocked with a password
+ * Returns 1 if successful or -1 on error
  */
-int libluksde_volume_unlock(
+int libluksde_volume_get_key_slot_values(
      libluksde_volume_t *volume,
+     int key_slot_index,
+     uint8_t *is_active,
+     uint32_t *number_of_iterations,
+     uint32_t *number_of_stripes,
      libcerror_error_t **error )
 {
 	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_unlock";
+	libluksde_key_slot_t *key_slot               = NULL;
+	static char *function                        = "libluksde_volume_get_key_slot_values";
 	int result                                   = 1;
 
 	if( volume == NULL )
@@ -1930,10 +8369,67 @@ int libluksde_volume_unlock(
 
 		return( -1 );
 	}
-	internal_volume = (libluksde_internal_volume_t *) volume;
-
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_active == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid is active.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_iterations == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of iterations.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_stripes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of stripes.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_internal_volume_read_deferred_metadata(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred metadata.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1941,33 +8437,48 @@ int libluksde_volume_unlock(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( internal_volume->is_locked != 0 )
+	if( libcdata_array_get_entry_by_index(
+	     internal_volume->volume_header->key_slots_array,
+	     key_slot_index,
+	     (intptr_t **) &key_slot,
+	     error ) != 1 )
 	{
-		result = libluksde_internal_volume_unlock(
-		          internal_volume,
-		          internal_volume->file_io_handle,
-		          error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve key slot: %d.",
+		 function,
+		 key_slot_index );
 
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to unlock volume.",
-			 function );
+		result = -1;
+	}
+	else if( key_slot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing key slot: %d.",
+		 function,
+		 key_slot_index );
 
-			result = -1;
-		}
+		result = -1;
+	}
+	else
+	{
+		*is_active            = (uint8_t) ( key_slot->state == LIBLUKSDE_KEY_SLOT_STATE_ACTIVE );
+		*number_of_iterations = key_slot->number_of_iterations;
+		*number_of_stripes    = key_slot->number_of_stripes;
 	}
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1975,7 +8486,7 @@ int libluksde_volume_unlock(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
@@ -1984,26 +8495,28 @@ int libluksde_volume_unlock(
 	return( result );
 }
 
-/* Reads (volume) data from the last current into a buffer using a Basic File IO (bfio) handle
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read or -1 on error
+/* Retrieves the key derivation values of a specific key slot
+ * The hashing method is used by PBKDF2 and the time cost, memory cost and parallelism by Argon2
+ * The diffuser hashing method is used to merge the anti-forensic split key material
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libluksde_internal_volume_read_buffer_from_file_io_handle(
-         libluksde_internal_volume_t *internal_volume,
-         libbfio_handle_t *file_io_handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libluksde_volume_get_key_slot_key_derivation_values(
+     libluksde_volume_t *volume,
+     int key_slot_index,
+     int *key_derivation_function,
+     int *hashing_method,
+     int *diffuser_hashing_method,
+     uint32_t *time_cost,
+     uint32_t *memory_cost,
+     uint32_t *parallelism,
+     libcerror_error_t **error )
 {
-	libluksde_sector_data_t *sector_data = NULL;
-	static char *function                = "libluksde_internal_volume_read_buffer_from_file_io_handle";
-	size_t buffer_offset                 = 0;
-	size_t read_size                     = 0;
-	size_t remaining_buffer_size         = 0;
-	size_t sector_data_offset            = 0;
-	off64_t sector_file_offset           = 0;
+	libluksde_internal_volume_t *internal_volume = NULL;
+	libluksde_key_slot_t *key_slot               = NULL;
+	static char *function                        = "libluksde_volume_get_key_slot_key_derivation_values";
+	int result                                   = 1;
 
-	if( internal_volume == NULL )
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2014,172 +8527,181 @@ ssize_t libluksde_internal_volume_read_buffer_from_file_io_handle(
 
 		return( -1 );
 	}
-	if( internal_volume->is_locked != 0 )
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( internal_volume->volume_header == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - volume is locked.",
+		 "%s: invalid volume - missing volume header.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->io_handle == NULL )
+	if( key_derivation_function == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key derivation function.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->sector_data_vector == NULL )
+	if( hashing_method == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing sector data vector.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hashing method.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->current_offset < 0 )
+	if( diffuser_hashing_method == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid volume - current offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diffuser hashing method.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( time_cost == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid time cost.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( memory_cost == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory cost.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume->io_handle->abort = 0;
-
-	if( (size64_t) internal_volume->current_offset >= internal_volume->io_handle->encrypted_volume_size )
+	if( parallelism == NULL )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parallelism.",
+		 function );
+
+		return( -1 );
 	}
-	if( (size64_t) buffer_size > ( internal_volume->io_handle->encrypted_volume_size - internal_volume->current_offset ) )
+	if( libluksde_internal_volume_read_deferred_metadata(
+	     internal_volume,
+	     error ) != 1 )
 	{
-		buffer_size = (size_t) ( internal_volume->io_handle->encrypted_volume_size - internal_volume->current_offset );
-	}
-	remaining_buffer_size = buffer_size;
-
-	sector_file_offset = ( internal_volume->current_offset / internal_volume->io_handle->bytes_per_sector ) * internal_volume->io_handle->bytes_per_sector;
-	sector_data_offset = (size_t) ( internal_volume->current_offset - sector_file_offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred metadata.",
+		 function );
 
-	while( remaining_buffer_size > 0 )
+		return( -1 );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
-		read_size = internal_volume->io_handle->bytes_per_sector - sector_data_offset;
-
-		if( read_size > remaining_buffer_size )
-		{
-			read_size = remaining_buffer_size;
-		}
-		if( read_size == 0 )
-		{
-			break;
-		}
-		if( libluksde_sector_data_vector_get_sector_data_at_offset(
-		     internal_volume->sector_data_vector,
-		     file_io_handle,
-		     internal_volume->encryption_context,
-		     sector_file_offset,
-		     &sector_data,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve sector data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 sector_file_offset,
-			 sector_file_offset );
-
-			return( -1 );
-		}
-		if( sector_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing sector data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 sector_file_offset,
-			 sector_file_offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
-			return( -1 );
-		}
-		if( memory_copy(
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     &( ( sector_data->data )[ sector_data_offset ] ),
-		     read_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy sector data to buffer.",
-			 function );
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_entry_by_index(
+	     internal_volume->volume_header->key_slots_array,
+	     key_slot_index,
+	     (intptr_t **) &key_slot,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve key slot: %d.",
+		 function,
+		 key_slot_index );
 
-			return( -1 );
-		}
-                buffer_offset         += read_size;
-                remaining_buffer_size -= read_size;
-		sector_file_offset    += read_size;
-		sector_data_offset     = 0;
+		result = -1;
+	}
+	else if( key_slot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing key slot: %d.",
+		 function,
+		 key_slot_index );
 
-		if( internal_volume->io_handle->abort != 0 )
-		{
-			break;
-		}
+		result = -1;
 	}
-	internal_volume->current_offset += (off64_t) buffer_offset;
+	else
+	{
+		*key_derivation_function = key_slot->key_derivation_function;
+		*hashing_method          = key_slot->hashing_method;
+		*diffuser_hashing_method = key_slot->diffuser_hashing_method;
+		*time_cost               = key_slot->time_cost;
+		*memory_cost             = key_slot->memory_cost;
+		*parallelism             = key_slot->parallelism;
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-	return( (ssize_t) buffer_offset );
+		return( -1 );
+	}
+#endif
+	return( result );
 }
 
-/* Reads data at the current offset into a buffer
- * Returns the number of bytes read or -1 on error
+/* Retrieves the volume identifier
+ * The identifier is an UUID and is 16 bytes of size
+ * Returns 1 if successful, 0 if not or or -1 on error
  */
-ssize_t libluksde_volume_read_buffer(
-         libluksde_volume_t *volume,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libluksde_volume_get_volume_identifier(
+     libluksde_volume_t *volume,
+     uint8_t *uuid_data,
+     size_t uuid_data_size,
+     libcerror_error_t **error )
 {
 	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_read_buffer";
-	ssize_t read_count                           = 0;
+	static char *function                        = "libluksde_volume_get_volume_identifier";
+	int result                                   = 0;
 
 	if( volume == NULL )
 	{
@@ -2194,19 +8716,8 @@ ssize_t libluksde_volume_read_buffer(
 	}
 	internal_volume = (libluksde_internal_volume_t *) volume;
 
-	if( internal_volume->file_io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing file IO handle.",
-		 function );
-
-		return( -1 );
-	}
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2214,32 +8725,34 @@ ssize_t libluksde_volume_read_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	read_count = libluksde_internal_volume_read_buffer_from_file_io_handle(
-		      internal_volume,
-		      internal_volume->file_io_handle,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
+	if( internal_volume->volume_header != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
+		result = libluksde_volume_header_get_volume_identifier(
+		          internal_volume->volume_header,
+		          uuid_data,
+		          uuid_data_size,
+		          error );
 
-		read_count = -1;
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve volume identifier.",
+			 function );
+
+			result = -1;
+		}
 	}
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2247,28 +8760,27 @@ ssize_t libluksde_volume_read_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( result );
 }
 
-/* Reads (volume) data at a specific offset
- * Returns the number of bytes read or -1 on error
+/* Sets the key
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libluksde_volume_read_buffer_at_offset(
-         libluksde_volume_t *volume,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libluksde_volume_set_key(
+     libluksde_volume_t *volume,
+     const uint8_t *master_key,
+     size_t master_key_size,
+     libcerror_error_t **error )
 {
 	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_read_buffer_at_offset";
-	ssize_t read_count                           = 0;
+	static char *function                        = "libluksde_volume_set_key";
 
 	if( volume == NULL )
 	{
@@ -2283,13 +8795,26 @@ ssize_t libluksde_volume_read_buffer_at_offset(
 	}
 	internal_volume = (libluksde_internal_volume_t *) volume;
 
-	if( internal_volume->file_io_handle == NULL )
+	if( master_key == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing file IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid master key.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( master_key_size != 16 )
+	 && ( master_key_size != 32 )
+	 && ( master_key_size != 64 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported master key size.",
 		 function );
 
 		return( -1 );
@@ -2309,39 +8834,38 @@ ssize_t libluksde_volume_read_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	if( libluksde_internal_volume_seek_offset(
-	     internal_volume,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( memory_set(
+	     internal_volume->master_key,
+	     0,
+	     64  ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear master key.",
 		 function );
 
 		goto on_error;
 	}
-	read_count = libluksde_internal_volume_read_buffer_from_file_io_handle(
-		      internal_volume,
-		      internal_volume->file_io_handle,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
+	if( memory_copy(
+	     internal_volume->master_key,
+	     master_key,
+	     master_key_size ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy master key.",
 		 function );
 
 		goto on_error;
 	}
+	internal_volume->master_key_size = (uint32_t) master_key_size;
+
+	internal_volume->volume_master_key_is_set = 1;
+
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -2357,9 +8881,14 @@ ssize_t libluksde_volume_read_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( 1 );
 
 on_error:
+	memory_set(
+	 internal_volume->master_key,
+	 0,
+	 32 );
+
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
 	libcthreads_read_write_lock_release_for_write(
 	 internal_volume->read_write_lock,
@@ -2368,19 +8897,20 @@ on_error:
 	return( -1 );
 }
 
-/* Seeks a certain offset of the (volume) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+/* Sets the keys
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
  */
-off64_t libluksde_internal_volume_seek_offset(
-         libluksde_internal_volume_t *internal_volume,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libluksde_volume_set_keys(
+     libluksde_volume_t *volume,
+     const uint8_t *master_key,
+     size_t master_key_size,
+     libcerror_error_t **error )
 {
-	static char *function = "libluksde_internal_volume_seek_offset";
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_set_keys";
 
-	if( internal_volume == NULL )
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2391,85 +8921,127 @@ off64_t libluksde_internal_volume_seek_offset(
 
 		return( -1 );
 	}
-	if( internal_volume->is_locked != 0 )
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( master_key == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - volume is locked.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid master key.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->io_handle == NULL )
+	if( ( master_key_size != 16 )
+	 && ( master_key_size != 32 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported master key size.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
-	{	
-		offset += internal_volume->current_offset;
-	}
-	else if( whence == SEEK_END )
-	{	
-		offset += (off64_t) internal_volume->io_handle->encrypted_volume_size;
+#endif
+	if( master_key_size < 32 )
+	{
+		if( memory_set(
+		     internal_volume->master_key,
+		     0,
+		     32  ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear master key.",
+			 function );
+
+			goto on_error;
+		}
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( memory_copy(
+	     internal_volume->master_key,
+	     master_key,
+	     master_key_size ) == NULL )
 	{
-		libcnotify_printf(
-		 "%s: seeking volume data offset: %" PRIi64 ".\n",
-		 function,
-		 offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy master key.",
+		 function );
+
+		goto on_error;
 	}
-#endif
-	if( offset < 0 )
+	internal_volume->master_key_size = (uint32_t) master_key_size;
+
+	internal_volume->volume_master_key_is_set = 1;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume->current_offset = offset;
+#endif
+	return( 1 );
 
-	return( offset );
+on_error:
+	memory_set(
+	 internal_volume->master_key,
+	 0,
+	 32 );
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Seeks a certain offset of the data
- * Returns the offset if seek is successful or -1 on error
+/* Retrieves the master key cache
+ * The master key cache contains the master key of an unlocked volume in plain text
+ * and should be stored in a location protected by the caller
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-off64_t libluksde_volume_seek_offset(
-         libluksde_volume_t *volume,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libluksde_volume_get_master_key_cache(
+     libluksde_volume_t *volume,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
 {
-	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_seek_offset";
+	libluksde_internal_volume_t *internal_volume   = NULL;
+	libluksde_master_key_cache_t *master_key_cache = NULL;
+	static char *function                          = "libluksde_volume_get_master_key_cache";
+	int result                                     = 0;
 
 	if( volume == NULL )
 	{
@@ -2482,21 +9054,33 @@ off64_t libluksde_volume_seek_offset(
 
 		return( -1 );
 	}
-	internal_volume = (libluksde_internal_volume_t *) volume;
-
-	if( internal_volume->file_io_handle == NULL )
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < (size_t) LIBLUKSDE_MASTER_KEY_CACHE_SIZE )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing file IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2504,31 +9088,104 @@ off64_t libluksde_volume_seek_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	offset = libluksde_internal_volume_seek_offset(
-	          internal_volume,
-	          offset,
-	          whence,
-	          error );
-
-	if( offset == -1 )
+	if( ( internal_volume->volume_header != NULL )
+	 && ( internal_volume->encryption_context != NULL ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+		if( libluksde_master_key_cache_initialize(
+		     &master_key_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create master key cache.",
+			 function );
 
-		offset = -1;
+			goto on_error;
+		}
+		if( memory_copy(
+		     master_key_cache->volume_identifier,
+		     internal_volume->volume_header->volume_identifier,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy volume identifier.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     master_key_cache->header_digest,
+		     internal_volume->volume_header->header_digest,
+		     32 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy header digest.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     master_key_cache->master_key,
+		     internal_volume->master_key,
+		     64 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy master key.",
+			 function );
+
+			goto on_error;
+		}
+		master_key_cache->master_key_size = internal_volume->master_key_size;
+
+		if( libluksde_master_key_cache_write_data(
+		     master_key_cache,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write master key cache.",
+			 function );
+
+			goto on_error;
+		}
+		if( libluksde_master_key_cache_free(
+		     &master_key_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free master key cache.",
+			 function );
+
+			goto on_error;
+		}
+		result = 1;
 	}
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2536,25 +9193,44 @@ off64_t libluksde_volume_seek_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( offset );
+	return( result );
+
+on_error:
+	if( master_key_cache != NULL )
+	{
+		libluksde_master_key_cache_free(
+		 &master_key_cache,
+		 NULL );
+	}
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the current offset of the (volume) data
+/* Sets the master key cache
+ * The master key in the cache is only used if the volume identifier and header digest
+ * match those of the volume, in which case no key derivation is performed
+ * This function needs to be used before one of the open functions
  * Returns 1 if successful or -1 on error
  */
-int libluksde_volume_get_offset(
+int libluksde_volume_set_master_key_cache(
      libluksde_volume_t *volume,
-     off64_t *offset,
+     const uint8_t *data,
+     size_t data_size,
      libcerror_error_t **error )
 {
-	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_get_offset";
+	libluksde_internal_volume_t *internal_volume   = NULL;
+	libluksde_master_key_cache_t *master_key_cache = NULL;
+	static char *function                          = "libluksde_volume_set_master_key_cache";
 
 	if( volume == NULL )
 	{
@@ -2569,19 +9245,36 @@ int libluksde_volume_get_offset(
 	}
 	internal_volume = (libluksde_internal_volume_t *) volume;
 
-	if( offset == NULL )
+	if( libluksde_master_key_cache_initialize(
+	     &master_key_cache,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create master key cache.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	if( libluksde_master_key_cache_read_data(
+	     master_key_cache,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read master key cache.",
+		 function );
+
+		goto on_error;
 	}
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2589,16 +9282,37 @@ int libluksde_volume_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	*offset = internal_volume->current_offset;
+	if( internal_volume->master_key_cache != NULL )
+	{
+		if( libluksde_master_key_cache_free(
+		     &( internal_volume->master_key_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free master key cache.",
+			 function );
 
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+			libcthreads_read_write_lock_release_for_write(
+			 internal_volume->read_write_lock,
+			 NULL );
+#endif
+			goto on_error;
+		}
+	}
+	internal_volume->master_key_cache = master_key_cache;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2606,25 +9320,39 @@ int libluksde_volume_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
 	return( 1 );
+
+on_error:
+	if( master_key_cache != NULL )
+	{
+		libluksde_master_key_cache_free(
+		 &master_key_cache,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Retrieves the size
+/* Sets the master key check flags
+ * The file system signature check flag rejects master key candidates for which the
+ * first decrypted data does not contain a known file system, volume system or partition
+ * table signature, before the master key validation hash is calculated. Volumes that
+ * contain unknown or no data yet can therefore not be unlocked when this flag is set.
+ * This function needs to be used before one of the open functions
  * Returns 1 if successful or -1 on error
  */
-int libluksde_volume_get_size(
+int libluksde_volume_set_master_key_check_flags(
      libluksde_volume_t *volume,
-     size64_t *size,
+     uint8_t master_key_check_flags,
      libcerror_error_t **error )
 {
 	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_get_size";
+	static char *function                        = "libluksde_volume_set_master_key_check_flags";
 
 	if( volume == NULL )
 	{
@@ -2639,30 +9367,20 @@ int libluksde_volume_get_size(
 	}
 	internal_volume = (libluksde_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( size == NULL )
+	if( ( master_key_check_flags & ~( LIBLUKSDE_MASTER_KEY_CHECK_FLAG_FILE_SYSTEM_SIGNATURE ) ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid size.",
-		 function );
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported master key check flags: 0x%02" PRIx8 ".",
+		 function,
+		 master_key_check_flags );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2670,16 +9388,16 @@ int libluksde_volume_get_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	*size = internal_volume->io_handle->encrypted_volume_size;
+	internal_volume->master_key_check_flags = master_key_check_flags;
 
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2687,7 +9405,7 @@ int libluksde_volume_get_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -2696,17 +9414,18 @@ int libluksde_volume_get_size(
 	return( 1 );
 }
 
-/* Retrieves the encryption method
- * Returns 1 if successful or -1 on error
+/* Sets an UTF-8 formatted password
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful, 0 if password is invalid or -1 on error
  */
-int libluksde_volume_get_encryption_method(
+int libluksde_volume_set_utf8_password(
      libluksde_volume_t *volume,
-     int *encryption_method,
-     int *encryption_chaining_mode,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
      libcerror_error_t **error )
 {
 	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_get_encryption_method";
+	static char *function                        = "libluksde_volume_set_utf8_password";
 
 	if( volume == NULL )
 	{
@@ -2721,59 +9440,123 @@ int libluksde_volume_get_encryption_method(
 	}
 	internal_volume = (libluksde_internal_volume_t *) volume;
 
-	if( internal_volume->volume_header == NULL )
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing volume header.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( encryption_method == NULL )
+#endif
+	if( internal_volume->user_password != NULL )
+	{
+		if( memory_set(
+		     internal_volume->user_password,
+		     0,
+		     internal_volume->user_password_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to user password.",
+			 function );
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+			libcthreads_read_write_lock_release_for_write(
+			 internal_volume->read_write_lock,
+			 NULL );
+#endif
+			return( -1 );
+		}
+		memory_free(
+		 internal_volume->user_password );
+
+		internal_volume->user_password      = NULL;
+		internal_volume->user_password_size = 0;
+	}
+	if( libuna_byte_stream_size_from_utf8(
+	     utf8_string,
+	     utf8_string_length,
+	     LIBLUKSDE_CODEPAGE_US_ASCII,
+	     &( internal_volume->user_password_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set password size.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->user_password_size += 1;
+
+	if( internal_volume->user_password_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid encryption method.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid volume - user password size value exceeds maximum allocation size.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( encryption_chaining_mode == NULL )
+	internal_volume->user_password = (uint8_t *) memory_allocate(
+	                                              sizeof( uint8_t ) * internal_volume->user_password_size );
+
+	if( internal_volume->user_password == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid encryption chaining mode.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to create user password.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
+	if( libuna_byte_stream_copy_from_utf8(
+	     internal_volume->user_password,
+	     internal_volume->user_password_size,
+	     LIBLUKSDE_CODEPAGE_US_ASCII,
+	     utf8_string,
+	     utf8_string_length,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to copy user password.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	*encryption_method        = internal_volume->volume_header->encryption_method;
-	*encryption_chaining_mode = internal_volume->volume_header->encryption_chaining_mode;
+	internal_volume->user_password[ internal_volume->user_password_size - 1 ] = 0;
+
+	internal_volume->user_password_is_set = 1;
 
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: user password: %s\n",
+		 function,
+		 internal_volume->user_password );
+	}
+#endif
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2781,28 +9564,48 @@ int libluksde_volume_get_encryption_method(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
 	return( 1 );
+
+on_error:
+	if( internal_volume->user_password != NULL )
+	{
+		memory_set(
+		 internal_volume->user_password,
+		 0,
+		 internal_volume->user_password_size );
+		memory_free(
+		 internal_volume->user_password );
+
+		internal_volume->user_password = NULL;
+	}
+	internal_volume->user_password_size = 0;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the volume identifier
- * The identifier is an UUID and is 16 bytes of size
- * Returns 1 if successful, 0 if not or or -1 on error
+/* Sets an UTF-16 formatted password
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful, 0 if password is invalid or -1 on error
  */
-int libluksde_volume_get_volume_identifier(
+int libluksde_volume_set_utf16_password(
      libluksde_volume_t *volume,
-     uint8_t *uuid_data,
-     size_t uuid_data_size,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
      libcerror_error_t **error )
 {
 	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_get_volume_identifier";
-	int result                                   = 0;
+	static char *function                        = "libluksde_volume_set_utf16_password";
 
 	if( volume == NULL )
 	{
@@ -2817,8 +9620,8 @@ int libluksde_volume_get_volume_identifier(
 	}
 	internal_volume = (libluksde_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2826,146 +9629,247 @@ int libluksde_volume_get_volume_identifier(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( internal_volume->volume_header != NULL )
+	if( internal_volume->user_password != NULL )
 	{
-		result = libluksde_volume_header_get_volume_identifier(
-		          internal_volume->volume_header,
-		          uuid_data,
-		          uuid_data_size,
-		          error );
-
-		if( result != 1 )
+		if( memory_set(
+		     internal_volume->user_password,
+		     0,
+		     internal_volume->user_password_size ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve volume identifier.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to user password.",
 			 function );
 
-			result = -1;
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+			libcthreads_read_write_lock_release_for_write(
+			 internal_volume->read_write_lock,
+			 NULL );
+#endif
+			return( -1 );
 		}
+		memory_free(
+		 internal_volume->user_password );
+
+		internal_volume->user_password      = NULL;
+		internal_volume->user_password_size = 0;
 	}
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
+	if( libuna_byte_stream_size_from_utf16(
+	     utf16_string,
+	     utf16_string_length,
+	     LIBLUKSDE_CODEPAGE_US_ASCII,
+	     &( internal_volume->user_password_size ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to set password length.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( result );
-}
+	internal_volume->user_password_size += 1;
 
-/* Sets the key
- * This function needs to be used before one of the open functions
- * Returns 1 if successful or -1 on error
- */
-int libluksde_volume_set_key(
-     libluksde_volume_t *volume,
-     const uint8_t *master_key,
-     size_t master_key_size,
-     libcerror_error_t **error )
-{
-	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_set_key";
+	if( internal_volume->user_password_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid volume - user password size value exceeds maximum allocation size.",
+		 function );
 
-	if( volume == NULL )
+		goto on_error;
+	}
+	internal_volume->user_password = (uint8_t *) memory_allocate(
+	                                              sizeof( uint8_t ) * internal_volume->user_password_size );
+
+	if( internal_volume->user_password == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to create user password.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_volume = (libluksde_internal_volume_t *) volume;
+	if( libuna_byte_stream_copy_from_utf16(
+	     internal_volume->user_password,
+	     internal_volume->user_password_size,
+	     LIBLUKSDE_CODEPAGE_US_ASCII,
+	     utf16_string,
+	     utf16_string_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to copy user password.",
+		 function );
 
-	if( master_key == NULL )
+		goto on_error;
+	}
+	internal_volume->user_password[ internal_volume->user_password_size - 1 ] = 0;
+
+	internal_volume->user_password_is_set = 1;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: user password: %s\n",
+		 function,
+		 internal_volume->user_password );
+	}
+#endif
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid master key.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( master_key_size != 16 )
-	 && ( master_key_size != 32 )
-	 && ( master_key_size != 64 ) )
+#endif
+	return( 1 );
+
+on_error:
+	if( internal_volume->user_password != NULL )
+	{
+		memory_set(
+		 internal_volume->user_password,
+		 0,
+		 internal_volume->user_password_size );
+		memory_free(
+		 internal_volume->user_password );
+
+		internal_volume->user_password = NULL;
+	}
+	internal_volume->user_password_size = 0;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Sets a keyfile
+ * The key data is read from the keyfile when the volume is unlocked
+ * A size of 0 represents the remainder of the file after the offset
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_set_keyfile(
+     libluksde_volume_t *volume,
+     const char *filename,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	libluksde_keyfile_t *keyfile                 = NULL;
+	static char *function                        = "libluksde_volume_set_keyfile";
+
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported master key size.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
+	internal_volume = (libluksde_internal_volume_t *) volume;
+
+	if( libluksde_keyfile_initialize(
+	     &keyfile,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create keyfile.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	if( memory_set(
-	     internal_volume->master_key,
-	     0,
-	     64  ) == NULL )
+	if( libluksde_keyfile_open(
+	     keyfile,
+	     filename,
+	     offset,
+	     size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear master key.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open keyfile.",
 		 function );
 
 		goto on_error;
 	}
-	if( memory_copy(
-	     internal_volume->master_key,
-	     master_key,
-	     master_key_size ) == NULL )
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy master key.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		goto on_error;
 	}
-	internal_volume->master_key_size = (uint32_t) master_key_size;
+#endif
+	if( internal_volume->keyfile != NULL )
+	{
+		if( libluksde_keyfile_free(
+		     &( internal_volume->keyfile ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free keyfile.",
+			 function );
 
-	internal_volume->volume_master_key_is_set = 1;
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+			libcthreads_read_write_lock_release_for_write(
+			 internal_volume->read_write_lock,
+			 NULL );
+#endif
+			goto on_error;
+		}
+	}
+	internal_volume->keyfile = keyfile;
 
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -2985,31 +9889,33 @@ int libluksde_volume_set_key(
 	return( 1 );
 
 on_error:
-	memory_set(
-	 internal_volume->master_key,
-	 0,
-	 32 );
-
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_volume->read_write_lock,
-	 NULL );
-#endif
+	if( keyfile != NULL )
+	{
+		libluksde_keyfile_free(
+		 &keyfile,
+		 NULL );
+	}
 	return( -1 );
 }
 
-/* Sets the keys
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets a keyfile
+ * The key data is read from the keyfile when the volume is unlocked
+ * A size of 0 represents the remainder of the file after the offset
  * This function needs to be used before one of the open functions
  * Returns 1 if successful or -1 on error
  */
-int libluksde_volume_set_keys(
+int libluksde_volume_set_keyfile_wide(
      libluksde_volume_t *volume,
-     const uint8_t *master_key,
-     size_t master_key_size,
+     const wchar_t *filename,
+     off64_t offset,
+     size64_t size,
      libcerror_error_t **error )
 {
 	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_set_keys";
+	libluksde_keyfile_t *keyfile                 = NULL;
+	static char *function                        = "libluksde_volume_set_keyfile_wide";
 
 	if( volume == NULL )
 	{
@@ -3024,28 +9930,34 @@ int libluksde_volume_set_keys(
 	}
 	internal_volume = (libluksde_internal_volume_t *) volume;
 
-	if( master_key == NULL )
+	if( libluksde_keyfile_initialize(
+	     &keyfile,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid master key.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create keyfile.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( ( master_key_size != 16 )
-	 && ( master_key_size != 32 ) )
+	if( libluksde_keyfile_open_wide(
+	     keyfile,
+	     filename,
+	     offset,
+	     size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported master key size.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open keyfile.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
@@ -3059,43 +9971,31 @@ int libluksde_volume_set_keys(
 		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	if( master_key_size < 32 )
+	if( internal_volume->keyfile != NULL )
 	{
-		if( memory_set(
-		     internal_volume->master_key,
-		     0,
-		     32  ) == NULL )
+		if( libluksde_keyfile_free(
+		     &( internal_volume->keyfile ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to clear master key.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free keyfile.",
 			 function );
 
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+			libcthreads_read_write_lock_release_for_write(
+			 internal_volume->read_write_lock,
+			 NULL );
+#endif
 			goto on_error;
 		}
 	}
-	if( memory_copy(
-	     internal_volume->master_key,
-	     master_key,
-	     master_key_size ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy master key.",
-		 function );
-
-		goto on_error;
-	}
-	internal_volume->master_key_size = (uint32_t) master_key_size;
-
-	internal_volume->volume_master_key_is_set = 1;
+	internal_volume->keyfile = keyfile;
 
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -3115,31 +10015,37 @@ int libluksde_volume_set_keys(
 	return( 1 );
 
 on_error:
-	memory_set(
-	 internal_volume->master_key,
-	 0,
-	 32 );
-
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_volume->read_write_lock,
-	 NULL );
-#endif
+	if( keyfile != NULL )
+	{
+		libluksde_keyfile_free(
+		 &keyfile,
+		 NULL );
+	}
 	return( -1 );
 }
 
-/* Sets an UTF-8 formatted password
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Sets a spill file
+ * The spill file is used to cache decrypted chunks of the volume data
+ * that no longer fit in the in-memory cache
+ * The spill file is created when the volume data is first read and removed
+ * Since the spill file contains decrypted data, on POSIX platforms it is created
+ * only accessible by the owner, it must not exist and it is removed directly after
+ * it was created. On other platforms it is removed when the volume is closed
  * This function needs to be used before one of the open functions
- * Returns 1 if successful, 0 if password is invalid or -1 on error
+ * Returns 1 if successful or -1 on error
  */
-int libluksde_volume_set_utf8_password(
+int libluksde_volume_set_spill_cache_file(
      libluksde_volume_t *volume,
-     const uint8_t *utf8_string,
-     size_t utf8_string_length,
+     const char *filename,
+     size64_t maximum_size,
      libcerror_error_t **error )
 {
 	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_set_utf8_password";
+	libluksde_spill_cache_t *spill_cache         = NULL;
+	static char *function                        = "libluksde_volume_set_spill_cache_file";
+	size_t filename_length                       = 0;
 
 	if( volume == NULL )
 	{
@@ -3154,121 +10060,125 @@ int libluksde_volume_set_utf8_password(
 	}
 	internal_volume = (libluksde_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_volume->user_password != NULL )
+	if( maximum_size < (size64_t) LIBLUKSDE_SPILL_CACHE_CHUNK_SIZE )
 	{
-		if( memory_set(
-		     internal_volume->user_password,
-		     0,
-		     internal_volume->user_password_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to user password.",
-			 function );
-
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-			libcthreads_read_write_lock_release_for_write(
-			 internal_volume->read_write_lock,
-			 NULL );
-#endif
-			return( -1 );
-		}
-		memory_free(
-		 internal_volume->user_password );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid maximum size value too small.",
+		 function );
 
-		internal_volume->user_password      = NULL;
-		internal_volume->user_password_size = 0;
+		return( -1 );
 	}
-	if( libuna_byte_stream_size_from_utf8(
-	     utf8_string,
-	     utf8_string_length,
-	     LIBLUKSDE_CODEPAGE_US_ASCII,
-	     &( internal_volume->user_password_size ),
-	     error ) != 1 )
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set password size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	internal_volume->user_password_size += 1;
-
-	if( internal_volume->user_password_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	if( libluksde_spill_cache_initialize(
+	     &spill_cache,
+	     maximum_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid volume - user password size value exceeds maximum allocation size.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create spill cache.",
 		 function );
 
 		goto on_error;
 	}
-	internal_volume->user_password = (uint8_t *) memory_allocate(
-	                                              sizeof( uint8_t ) * internal_volume->user_password_size );
-
-	if( internal_volume->user_password == NULL )
+	if( libluksde_spill_cache_set_name(
+	     spill_cache,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to create user password.",
+		 "%s: unable to set spill cache filename.",
 		 function );
 
 		goto on_error;
 	}
-	if( libuna_byte_stream_copy_from_utf8(
-	     internal_volume->user_password,
-	     internal_volume->user_password_size,
-	     LIBLUKSDE_CODEPAGE_US_ASCII,
-	     utf8_string,
-	     utf8_string_length,
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to copy user password.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+		libcthreads_read_write_lock_release_for_write(
+		 internal_volume->read_write_lock,
+		 NULL );
+#endif
 		goto on_error;
 	}
-	internal_volume->user_password[ internal_volume->user_password_size - 1 ] = 0;
-
-	internal_volume->user_password_is_set = 1;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( internal_volume->spill_cache != NULL )
 	{
-		libcnotify_printf(
-		 "%s: user password: %s\n",
-		 function,
-		 internal_volume->user_password );
-	}
+		if( libluksde_spill_cache_free(
+		     &( internal_volume->spill_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free spill cache.",
+			 function );
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+			libcthreads_read_write_lock_release_for_write(
+			 internal_volume->read_write_lock,
+			 NULL );
 #endif
+			goto on_error;
+		}
+	}
+	internal_volume->spill_cache = spill_cache;
+
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -3287,39 +10197,37 @@ int libluksde_volume_set_utf8_password(
 	return( 1 );
 
 on_error:
-	if( internal_volume->user_password != NULL )
+	if( spill_cache != NULL )
 	{
-		memory_set(
-		 internal_volume->user_password,
-		 0,
-		 internal_volume->user_password_size );
-		memory_free(
-		 internal_volume->user_password );
-
-		internal_volume->user_password = NULL;
+		libluksde_spill_cache_free(
+		 &spill_cache,
+		 NULL );
 	}
-	internal_volume->user_password_size = 0;
-
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_volume->read_write_lock,
-	 NULL );
-#endif
 	return( -1 );
 }
 
-/* Sets an UTF-16 formatted password
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets a spill file
+ * The spill file is used to cache decrypted chunks of the volume data
+ * that no longer fit in the in-memory cache
+ * The spill file is created when the volume data is first read and removed
+ * Since the spill file contains decrypted data, on POSIX platforms it is created
+ * only accessible by the owner, it must not exist and it is removed directly after
+ * it was created. On other platforms it is removed when the volume is closed
  * This function needs to be used before one of the open functions
- * Returns 1 if successful, 0 if password is invalid or -1 on error
+ * Returns 1 if successful or -1 on error
  */
-int libluksde_volume_set_utf16_password(
+int libluksde_volume_set_spill_cache_file_wide(
      libluksde_volume_t *volume,
-     const uint16_t *utf16_string,
-     size_t utf16_string_length,
+     const wchar_t *filename,
+     size64_t maximum_size,
      libcerror_error_t **error )
 {
 	libluksde_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libluksde_volume_set_utf16_password";
+	libluksde_spill_cache_t *spill_cache         = NULL;
+	static char *function                        = "libluksde_volume_set_spill_cache_file_wide";
+	size_t filename_length                       = 0;
 
 	if( volume == NULL )
 	{
@@ -3334,6 +10242,71 @@ int libluksde_volume_set_utf16_password(
 	}
 	internal_volume = (libluksde_internal_volume_t *) volume;
 
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_size < (size64_t) LIBLUKSDE_SPILL_CACHE_CHUNK_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid maximum size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = wide_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_spill_cache_initialize(
+	     &spill_cache,
+	     maximum_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create spill cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_spill_cache_set_name_wide(
+	     spill_cache,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set spill cache filename.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
@@ -3346,21 +10319,36 @@ int libluksde_volume_set_utf16_password(
 		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	if( internal_volume->user_password != NULL )
+	if( internal_volume->file_io_handle != NULL )
 	{
-		if( memory_set(
-		     internal_volume->user_password,
-		     0,
-		     internal_volume->user_password_size ) == NULL )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+		libcthreads_read_write_lock_release_for_write(
+		 internal_volume->read_write_lock,
+		 NULL );
+#endif
+		goto on_error;
+	}
+	if( internal_volume->spill_cache != NULL )
+	{
+		if( libluksde_spill_cache_free(
+		     &( internal_volume->spill_cache ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to user password.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free spill cache.",
 			 function );
 
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
@@ -3368,87 +10356,96 @@ int libluksde_volume_set_utf16_password(
 			 internal_volume->read_write_lock,
 			 NULL );
 #endif
-			return( -1 );
+			goto on_error;
 		}
-		memory_free(
-		 internal_volume->user_password );
-
-		internal_volume->user_password      = NULL;
-		internal_volume->user_password_size = 0;
 	}
-	if( libuna_byte_stream_size_from_utf16(
-	     utf16_string,
-	     utf16_string_length,
-	     LIBLUKSDE_CODEPAGE_US_ASCII,
-	     &( internal_volume->user_password_size ),
+	internal_volume->spill_cache = spill_cache;
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set password length.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	internal_volume->user_password_size += 1;
+#endif
+	return( 1 );
 
-	if( internal_volume->user_password_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+on_error:
+	if( spill_cache != NULL )
+	{
+		libluksde_spill_cache_free(
+		 &spill_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Sets the token identifier
+ * Only the key slots referenced by the token are used to unlock the volume
+ * A value of -1 removes the restriction
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_set_token_identifier(
+     libluksde_volume_t *volume,
+     int token_identifier,
+     libcerror_error_t **error )
+{
+	libluksde_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libluksde_volume_set_token_identifier";
+
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid volume - user password size value exceeds maximum allocation size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	internal_volume->user_password = (uint8_t *) memory_allocate(
-	                                              sizeof( uint8_t ) * internal_volume->user_password_size );
+	internal_volume = (libluksde_internal_volume_t *) volume;
 
-	if( internal_volume->user_password == NULL )
+	if( ( token_identifier < -1 )
+	 || ( token_identifier >= 32 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to create user password.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid token identifier value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libuna_byte_stream_copy_from_utf16(
-	     internal_volume->user_password,
-	     internal_volume->user_password_size,
-	     LIBLUKSDE_CODEPAGE_US_ASCII,
-	     utf16_string,
-	     utf16_string_length,
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to copy user password.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		goto on_error;
-	}
-	internal_volume->user_password[ internal_volume->user_password_size - 1 ] = 0;
-
-	internal_volume->user_password_is_set = 1;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: user password: %s\n",
-		 function,
-		 internal_volume->user_password );
+		return( -1 );
 	}
 #endif
+	internal_volume->token_identifier = token_identifier;
+
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -3465,26 +10462,5 @@ int libluksde_volume_set_utf16_password(
 	}
 #endif
 	return( 1 );
-
-on_error:
-	if( internal_volume->user_password != NULL )
-	{
-		memory_set(
-		 internal_volume->user_password,
-		 0,
-		 internal_volume->user_password_size );
-		memory_free(
-		 internal_volume->user_password );
-
-		internal_volume->user_password = NULL;
-	}
-	internal_volume->user_password_size = 0;
-
-#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_volume->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
 }
 
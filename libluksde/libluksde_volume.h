@@ -25,14 +25,24 @@
 #include <common.h>
 #include <types.h>
 
+#include "libluksde_allocation_map.h"
 #include "libluksde_encryption_context.h"
 #include "libluksde_extern.h"
+#include "libluksde_file_io_handle_pool.h"
+#include "libluksde_file_mapping.h"
 #include "libluksde_io_handle.h"
+#include "libluksde_io_uring.h"
+#include "libluksde_key_slot.h"
+#include "libluksde_keyfile.h"
 #include "libluksde_libbfio.h"
 #include "libluksde_libcerror.h"
 #include "libluksde_libcthreads.h"
+#include "libluksde_master_key_cache.h"
+#include "libluksde_read_queue.h"
+#include "libluksde_read_request.h"
 #include "libluksde_types.h"
-#include "libluksde_sector_data_vector.h"
+#include "libluksde_segment_map.h"
+#include "libluksde_spill_cache.h"
 #include "libluksde_volume_header.h"
 
 #if defined( __cplusplus )
@@ -59,6 +69,27 @@ struct libluksde_internal_volume
 	 */
 	uint8_t volume_master_key_is_set;
 
+	/* The secondary master key
+	 * Used during reencryption for the data segments that are not encrypted with the master key
+	 */
+	uint8_t secondary_master_key[ 64 ];
+
+	/* The secondary master key size
+	 */
+	uint32_t secondary_master_key_size;
+
+	/* Value to indicate the secondary master key is set
+	 */
+	uint8_t secondary_master_key_is_set;
+
+	/* The master key cache
+	 */
+	libluksde_master_key_cache_t *master_key_cache;
+
+	/* The master key check flags
+	 */
+	uint8_t master_key_check_flags;
+
 	/* The user password
 	 */
 	uint8_t *user_password;
@@ -71,6 +102,15 @@ struct libluksde_internal_volume
 	 */
 	uint8_t user_password_is_set;
 
+	/* The keyfile
+	 */
+	libluksde_keyfile_t *keyfile;
+
+	/* The identifier of the token used to restrict the key slots
+	 * A value of -1 represents no restriction
+	 */
+	int token_identifier;
+
 	/* The encryption context
 	 */
 	libluksde_encryption_context_t *encryption_context;
@@ -79,9 +119,9 @@ struct libluksde_internal_volume
 	 */
 	off64_t current_offset;
 
-	/* The sector data vector
+	/* The segment map
 	 */
-	libluksde_sector_data_vector_t *sector_data_vector;
+	libluksde_segment_map_t *segment_map;
 
 	/* The file IO handle
 	 */
@@ -99,11 +139,66 @@ struct libluksde_internal_volume
 	 */
 	uint8_t file_io_handle_opened_in_library;
 
+	/* The detached header file IO handle
+	 * Contains NULL if the header is stored in the same file IO handle as the volume data
+	 */
+	libbfio_handle_t *header_file_io_handle;
+
+	/* Value to indicate if the detached header file IO handle was opened inside the library
+	 */
+	uint8_t header_file_io_handle_opened_in_library;
+
+	/* The file mapping of the volume data
+	 * Contains NULL if the volume was not opened with memory mapped access
+	 */
+	libluksde_file_mapping_t *file_mapping;
+
+	/* The io_uring used to read the volume data
+	 * Contains NULL if the volume was not opened with io_uring access
+	 * or if io_uring is not supported
+	 */
+	libluksde_io_uring_t *io_uring;
+
+	/* The allocation map of the volume data
+	 * Contains the allocated ranges in (decrypted) volume offsets or NULL
+	 * if the volume was not opened to skip the unallocated regions
+	 */
+	libluksde_allocation_map_t *allocation_map;
+
+	/* The I/O callbacks used to read the volume data
+	 * Contains NULL if the volume was not opened using I/O callbacks
+	 */
+	libluksde_io_callbacks_t *io_callbacks;
+
+	/* The spill cache of the decrypted volume data
+	 * Contains NULL if no spill file was set
+	 */
+	libluksde_spill_cache_t *spill_cache;
+
 	/* Value to indicate if the volume is locked
 	 */
 	uint8_t is_locked;
 
+	/* Value to indicate the volume was opened to read the metadata only
+	 */
+	uint8_t metadata_only;
+
+	/* Value to indicate the metadata was read
+	 * Reading the LUKS2 JSON metadata is deferred when the volume was opened to read the metadata only
+	 */
+	uint8_t metadata_is_read;
+
 #if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+	/* The read queue
+	 * Contains NULL if no asynchronous read was requested
+	 */
+	libluksde_read_queue_t *read_queue;
+
+	/* The pool of cloned file IO handles used by the asynchronous reads
+	 * Contains NULL if the volume data is not read with the file IO handle
+	 */
+	libluksde_file_io_handle_pool_t *file_io_handle_pool;
+
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
@@ -150,21 +245,91 @@ int libluksde_volume_open_file_io_handle(
      int access_flags,
      libcerror_error_t **error );
 
+LIBLUKSDE_EXTERN \
+int libluksde_volume_open_file_io_handles(
+     libluksde_volume_t *volume,
+     libbfio_handle_t *header_file_io_handle,
+     libbfio_handle_t *data_file_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_open_io_callbacks(
+     libluksde_volume_t *volume,
+     const libluksde_io_callbacks_t *io_callbacks,
+     int access_flags,
+     libcerror_error_t **error );
+
 LIBLUKSDE_EXTERN \
 int libluksde_volume_close(
      libluksde_volume_t *volume,
      libcerror_error_t **error );
 
 int libluksde_internal_volume_open_read(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *header_file_io_handle,
+     libbfio_handle_t *data_file_io_handle,
+     libcerror_error_t **error );
+
+int libluksde_internal_volume_read_metadata(
      libluksde_internal_volume_t *internal_volume,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
-int libluksde_internal_volume_open_read_keys(
+int libluksde_internal_volume_read_deferred_metadata(
+     libluksde_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+int libluksde_internal_volume_read_key_material(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libluksde_key_slot_t *key_slot,
+     libluksde_encryption_context_t *user_key_encryption_context,
+     uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error );
+
+int libluksde_internal_volume_check_master_key_signature(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libluksde_internal_volume_check_master_key(
      libluksde_internal_volume_t *internal_volume,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libluksde_internal_volume_read_key_from_key_slot(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libluksde_key_slot_t *key_slot,
+     uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error );
+
+int libluksde_internal_volume_read_master_key_from_key_slot(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *header_file_io_handle,
+     libbfio_handle_t *data_file_io_handle,
+     libluksde_key_slot_t *key_slot,
+     libcerror_error_t **error );
+
+int libluksde_internal_volume_read_secondary_master_key(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *header_file_io_handle,
+     libcerror_error_t **error );
+
+int libluksde_internal_volume_open_read_keys(
+     libluksde_internal_volume_t *internal_volume,
+     libbfio_handle_t *header_file_io_handle,
+     libbfio_handle_t *data_file_io_handle,
+     libcerror_error_t **error );
+
+int libluksde_internal_volume_read_allocation_map(
+     libluksde_internal_volume_t *internal_volume,
+     const char *filename,
+     libcerror_error_t **error );
+
 LIBLUKSDE_EXTERN \
 int libluksde_volume_is_locked(
      libluksde_volume_t *volume,
@@ -172,7 +337,8 @@ int libluksde_volume_is_locked(
 
 int libluksde_internal_volume_unlock(
      libluksde_internal_volume_t *internal_volume,
-     libbfio_handle_t *file_io_handle,
+     libbfio_handle_t *header_file_io_handle,
+     libbfio_handle_t *data_file_io_handle,
      libcerror_error_t **error );
 
 LIBLUKSDE_EXTERN \
@@ -180,6 +346,23 @@ int libluksde_volume_unlock(
      libluksde_volume_t *volume,
      libcerror_error_t **error );
 
+ssize_t libluksde_internal_volume_read_segment_data_from_file_mapping(
+         libluksde_internal_volume_t *internal_volume,
+         libluksde_segment_map_entry_t *segment_map_entry,
+         off64_t segment_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+ssize_t libluksde_internal_volume_read_segment_data_from_spill_cache(
+         libluksde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         libluksde_segment_map_entry_t *segment_map_entry,
+         off64_t segment_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
 ssize_t libluksde_internal_volume_read_buffer_from_file_io_handle(
          libluksde_internal_volume_t *internal_volume,
          libbfio_handle_t *file_io_handle,
@@ -202,6 +385,57 @@ ssize_t libluksde_volume_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+int libluksde_internal_volume_compare_vectors(
+     const void *first_vector,
+     const void *second_vector );
+
+ssize_t libluksde_internal_volume_read_vectors_from_file_io_handle(
+         libluksde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         const libluksde_iovec_t *vectors,
+         int number_of_vectors,
+         libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+ssize_t libluksde_volume_read_vectors(
+         libluksde_volume_t *volume,
+         const libluksde_iovec_t *vectors,
+         int number_of_vectors,
+         libcerror_error_t **error );
+
+#if defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+
+int libluksde_internal_volume_read_request_with_file_io_handle_pool(
+     libluksde_internal_volume_t *internal_volume,
+     libluksde_read_request_t *read_request,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+
+int libluksde_internal_volume_read_request(
+     libluksde_volume_t *volume,
+     libluksde_read_request_t *read_request,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_read_buffer_at_offset_async(
+     libluksde_volume_t *volume,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback_function)(
+            libluksde_volume_t *volume,
+            void *buffer,
+            ssize_t read_count,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_wait_for_async_reads(
+     libluksde_volume_t *volume,
+     libcerror_error_t **error );
+
 off64_t libluksde_internal_volume_seek_offset(
          libluksde_internal_volume_t *internal_volume,
          off64_t offset,
@@ -227,6 +461,20 @@ int libluksde_volume_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+LIBLUKSDE_EXTERN \
+int libluksde_volume_get_number_of_allocated_ranges(
+     libluksde_volume_t *volume,
+     int *number_of_ranges,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_get_allocated_range_by_index(
+     libluksde_volume_t *volume,
+     int range_index,
+     off64_t *offset,
+     size64_t *size,
+     libcerror_error_t **error );
+
 LIBLUKSDE_EXTERN \
 int libluksde_volume_get_encryption_method(
      libluksde_volume_t *volume,
@@ -234,6 +482,51 @@ int libluksde_volume_get_encryption_method(
      int *encryption_chaining_mode,
      libcerror_error_t **error );
 
+LIBLUKSDE_EXTERN \
+int libluksde_volume_get_hashing_method(
+     libluksde_volume_t *volume,
+     int *hashing_method,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_get_master_key_size(
+     libluksde_volume_t *volume,
+     size_t *master_key_size,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_get_master_key_number_of_iterations(
+     libluksde_volume_t *volume,
+     uint32_t *number_of_iterations,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_get_number_of_key_slots(
+     libluksde_volume_t *volume,
+     int *number_of_key_slots,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_get_key_slot_values(
+     libluksde_volume_t *volume,
+     int key_slot_index,
+     uint8_t *is_active,
+     uint32_t *number_of_iterations,
+     uint32_t *number_of_stripes,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_get_key_slot_key_derivation_values(
+     libluksde_volume_t *volume,
+     int key_slot_index,
+     int *key_derivation_function,
+     int *hashing_method,
+     int *diffuser_hashing_method,
+     uint32_t *time_cost,
+     uint32_t *memory_cost,
+     uint32_t *parallelism,
+     libcerror_error_t **error );
+
 LIBLUKSDE_EXTERN \
 int libluksde_volume_get_volume_identifier(
      libluksde_volume_t *volume,
@@ -256,6 +549,26 @@ int libluksde_volume_set_keys(
      size_t master_key_size,
      libcerror_error_t **error );
 
+LIBLUKSDE_EXTERN \
+int libluksde_volume_get_master_key_cache(
+     libluksde_volume_t *volume,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_set_master_key_cache(
+     libluksde_volume_t *volume,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_set_master_key_check_flags(
+     libluksde_volume_t *volume,
+     uint8_t master_key_check_flags,
+     libcerror_error_t **error );
+
 LIBLUKSDE_EXTERN \
 int libluksde_volume_set_utf8_password(
      libluksde_volume_t *volume,
@@ -270,6 +583,50 @@ int libluksde_volume_set_utf16_password(
      size_t utf16_string_length,
      libcerror_error_t **error );
 
+LIBLUKSDE_EXTERN \
+int libluksde_volume_set_keyfile(
+     libluksde_volume_t *volume,
+     const char *filename,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_set_keyfile_wide(
+     libluksde_volume_t *volume,
+     const wchar_t *filename,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_set_spill_cache_file(
+     libluksde_volume_t *volume,
+     const char *filename,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_set_spill_cache_file_wide(
+     libluksde_volume_t *volume,
+     const wchar_t *filename,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBLUKSDE_EXTERN \
+int libluksde_volume_set_token_identifier(
+     libluksde_volume_t *volume,
+     int token_identifier,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
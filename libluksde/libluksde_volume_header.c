@@ -26,14 +26,19 @@
 
 #include "libluksde_debug.h"
 #include "libluksde_definitions.h"
+#include "libluksde_diffuser.h"
+#include "libluksde_digest.h"
 #include "libluksde_io_handle.h"
+#include "libluksde_json_tokenizer.h"
 #include "libluksde_key_slot.h"
 #include "libluksde_libbfio.h"
 #include "libluksde_libcdata.h"
 #include "libluksde_libcerror.h"
 #include "libluksde_libcnotify.h"
 #include "libluksde_libfguid.h"
+#include "libluksde_libhmac.h"
 #include "libluksde_libuna.h"
+#include "libluksde_segment.h"
 #include "libluksde_volume_header.h"
 
 #include "luksde_keyslot.h"
@@ -41,6 +46,11 @@
 
 const uint8_t luksde_backup_volume_header_signature[ 6 ] = { 'S', 'K', 'U', 'L', 0xba, 0xbe };
 
+/* The known offsets of the secondary LUKS2 header copy
+ */
+const off64_t libluksde_volume_header_secondary_offsets[ 9 ] = {
+	0x00004000, 0x00008000, 0x00010000, 0x00020000, 0x00040000, 0x00080000, 0x00100000, 0x00200000, 0x00400000 };
+
 /* Creates a volume header
  * Make sure the value volume_header is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -120,11 +130,53 @@ int libluksde_volume_header_initialize(
 
 		goto on_error;
 	}
+	if( libcdata_array_initialize(
+	     &( ( *volume_header )->segments_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segments array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *volume_header )->digests_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create digests array.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
 	if( *volume_header != NULL )
 	{
+		if( ( *volume_header )->segments_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *volume_header )->segments_array ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *volume_header )->key_slots_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *volume_header )->key_slots_array ),
+			 NULL,
+			 NULL );
+		}
 		memory_free(
 		 *volume_header );
 
@@ -170,6 +222,34 @@ int libluksde_volume_header_free(
 
 			result = -1;
 		}
+		if( libcdata_array_free(
+		     &( ( *volume_header )->segments_array ),
+		     (int(*)(intptr_t **, libcerror_error_t **)) &libluksde_segment_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segments array.",
+			 function );
+
+			result = -1;
+		}
+		if( libcdata_array_free(
+		     &( ( *volume_header )->digests_array ),
+		     (int(*)(intptr_t **, libcerror_error_t **)) &libluksde_digest_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digests array.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *volume_header );
 
@@ -182,19 +262,19 @@ int libluksde_volume_header_free(
  * Returns 1 if successful or -1 on error
  */
 int libluksde_volume_parse_encryption_method(
-     libluksde_volume_header_t *volume_header,
-     const uint8_t *encryption_method,
+     const uint8_t *encryption_method_string,
+     int *encryption_method,
      libcerror_error_t **error )
 {
 	static char *function = "libluksde_volume_parse_encryption_method";
 
-	if( volume_header == NULL )
+	if( encryption_method_string == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume header.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid encryption method string.",
 		 function );
 
 		return( -1 );
@@ -203,115 +283,115 @@ int libluksde_volume_parse_encryption_method(
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
 		 "%s: invalid encryption method.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( encryption_method[ 0 ] == 'a' )
-	 || ( encryption_method[ 0 ] == 'A' ) )
-	{
-		if( ( ( encryption_method[ 1 ] == 'e' )
-		  ||  ( encryption_method[ 1 ] == 'E' ) )
-		 && ( ( encryption_method[ 2 ] == 's' )
-		  ||  ( encryption_method[ 2 ] == 'S' ) )
-		 &&   ( encryption_method[ 3 ] == 0 ) )
-		{
-			volume_header->encryption_method = LIBLUKSDE_ENCRYPTION_METHOD_AES;
-		}
-		else if( ( ( encryption_method[ 1 ] == 'r' )
-		       ||  ( encryption_method[ 1 ] == 'R' ) )
-		      && ( ( encryption_method[ 2 ] == 'c' )
-		       ||  ( encryption_method[ 2 ] == 'C' ) )
-		      &&   ( encryption_method[ 3 ] == '4' )
-		      &&   ( encryption_method[ 4 ] == 0 ) )
-		{
-			volume_header->encryption_method = LIBLUKSDE_ENCRYPTION_METHOD_ARC4;
-		}
-	}
-	else if( ( encryption_method[ 0 ] == 'b' )
-	      || ( encryption_method[ 0 ] == 'B' ) )
-	{
-		if( ( ( encryption_method[ 1 ] == 'l' )
-		  ||  ( encryption_method[ 1 ] == 'L' ) )
-		 && ( ( encryption_method[ 2 ] == 'o' )
-		  ||  ( encryption_method[ 2 ] == 'O' ) )
-		 && ( ( encryption_method[ 3 ] == 'w' )
-		  ||  ( encryption_method[ 3 ] == 'W' ) )
-		 && ( ( encryption_method[ 4 ] == 'f' )
-		  ||  ( encryption_method[ 4 ] == 'F' ) )
-		 && ( ( encryption_method[ 5 ] == 'i' )
-		  ||  ( encryption_method[ 5 ] == 'I' ) )
-		 && ( ( encryption_method[ 6 ] == 's' )
-		  ||  ( encryption_method[ 6 ] == 'S' ) )
-		 && ( ( encryption_method[ 7 ] == 'h' )
-		  ||  ( encryption_method[ 7 ] == 'H' ) )
-		 &&   ( encryption_method[ 8 ] == 0 ) )
-		{
-			volume_header->encryption_method = LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH;
-		}
-	}
-	else if( ( encryption_method[ 0 ] == 'c' )
-	      || ( encryption_method[ 0 ] == 'C' ) )
-	{
-		if( ( ( encryption_method[ 1 ] == 'a' )
-		  ||  ( encryption_method[ 1 ] == 'A' ) )
-		 && ( ( encryption_method[ 2 ] == 's' )
-		  ||  ( encryption_method[ 2 ] == 'S' ) )
-		 && ( ( encryption_method[ 3 ] == 't' )
-		  ||  ( encryption_method[ 3 ] == 'T' ) )
-		 &&   ( encryption_method[ 5 ] == 0 ) )
-		{
-			if( encryption_method[ 4 ] == '5' )
+	if( ( encryption_method_string[ 0 ] == 'a' )
+	 || ( encryption_method_string[ 0 ] == 'A' ) )
+	{
+		if( ( ( encryption_method_string[ 1 ] == 'e' )
+		  ||  ( encryption_method_string[ 1 ] == 'E' ) )
+		 && ( ( encryption_method_string[ 2 ] == 's' )
+		  ||  ( encryption_method_string[ 2 ] == 'S' ) )
+		 &&   ( encryption_method_string[ 3 ] == 0 ) )
+		{
+			*encryption_method = LIBLUKSDE_ENCRYPTION_METHOD_AES;
+		}
+		else if( ( ( encryption_method_string[ 1 ] == 'r' )
+		       ||  ( encryption_method_string[ 1 ] == 'R' ) )
+		      && ( ( encryption_method_string[ 2 ] == 'c' )
+		       ||  ( encryption_method_string[ 2 ] == 'C' ) )
+		      &&   ( encryption_method_string[ 3 ] == '4' )
+		      &&   ( encryption_method_string[ 4 ] == 0 ) )
+		{
+			*encryption_method = LIBLUKSDE_ENCRYPTION_METHOD_ARC4;
+		}
+	}
+	else if( ( encryption_method_string[ 0 ] == 'b' )
+	      || ( encryption_method_string[ 0 ] == 'B' ) )
+	{
+		if( ( ( encryption_method_string[ 1 ] == 'l' )
+		  ||  ( encryption_method_string[ 1 ] == 'L' ) )
+		 && ( ( encryption_method_string[ 2 ] == 'o' )
+		  ||  ( encryption_method_string[ 2 ] == 'O' ) )
+		 && ( ( encryption_method_string[ 3 ] == 'w' )
+		  ||  ( encryption_method_string[ 3 ] == 'W' ) )
+		 && ( ( encryption_method_string[ 4 ] == 'f' )
+		  ||  ( encryption_method_string[ 4 ] == 'F' ) )
+		 && ( ( encryption_method_string[ 5 ] == 'i' )
+		  ||  ( encryption_method_string[ 5 ] == 'I' ) )
+		 && ( ( encryption_method_string[ 6 ] == 's' )
+		  ||  ( encryption_method_string[ 6 ] == 'S' ) )
+		 && ( ( encryption_method_string[ 7 ] == 'h' )
+		  ||  ( encryption_method_string[ 7 ] == 'H' ) )
+		 &&   ( encryption_method_string[ 8 ] == 0 ) )
+		{
+			*encryption_method = LIBLUKSDE_ENCRYPTION_METHOD_BLOWFISH;
+		}
+	}
+	else if( ( encryption_method_string[ 0 ] == 'c' )
+	      || ( encryption_method_string[ 0 ] == 'C' ) )
+	{
+		if( ( ( encryption_method_string[ 1 ] == 'a' )
+		  ||  ( encryption_method_string[ 1 ] == 'A' ) )
+		 && ( ( encryption_method_string[ 2 ] == 's' )
+		  ||  ( encryption_method_string[ 2 ] == 'S' ) )
+		 && ( ( encryption_method_string[ 3 ] == 't' )
+		  ||  ( encryption_method_string[ 3 ] == 'T' ) )
+		 &&   ( encryption_method_string[ 5 ] == 0 ) )
+		{
+			if( encryption_method_string[ 4 ] == '5' )
 			{
-				volume_header->encryption_method = LIBLUKSDE_ENCRYPTION_METHOD_CAST5;
+				*encryption_method = LIBLUKSDE_ENCRYPTION_METHOD_CAST5;
 			}
-			else if( encryption_method[ 4 ] == '6' )
+			else if( encryption_method_string[ 4 ] == '6' )
 			{
-				volume_header->encryption_method = LIBLUKSDE_ENCRYPTION_METHOD_CAST6;
+				*encryption_method = LIBLUKSDE_ENCRYPTION_METHOD_CAST6;
 			}
 		}
 	}
-	else if( ( encryption_method[ 0 ] == 's' )
-	      || ( encryption_method[ 0 ] == 'S' ) )
+	else if( ( encryption_method_string[ 0 ] == 's' )
+	      || ( encryption_method_string[ 0 ] == 'S' ) )
 	{
-		if( ( ( encryption_method[ 1 ] == 'e' )
-		  ||  ( encryption_method[ 1 ] == 'E' ) )
-		 && ( ( encryption_method[ 2 ] == 'r' )
-		  ||  ( encryption_method[ 2 ] == 'R' ) )
-		 && ( ( encryption_method[ 3 ] == 'p' )
-		  ||  ( encryption_method[ 3 ] == 'P' ) )
-		 && ( ( encryption_method[ 4 ] == 'e' )
-		  ||  ( encryption_method[ 4 ] == 'E' ) )
-		 && ( ( encryption_method[ 5 ] == 'n' )
-		  ||  ( encryption_method[ 5 ] == 'N' ) )
-		 && ( ( encryption_method[ 6 ] == 't' )
-		  ||  ( encryption_method[ 6 ] == 'T' ) )
-		 &&   ( encryption_method[ 7 ] == 0 ) )
+		if( ( ( encryption_method_string[ 1 ] == 'e' )
+		  ||  ( encryption_method_string[ 1 ] == 'E' ) )
+		 && ( ( encryption_method_string[ 2 ] == 'r' )
+		  ||  ( encryption_method_string[ 2 ] == 'R' ) )
+		 && ( ( encryption_method_string[ 3 ] == 'p' )
+		  ||  ( encryption_method_string[ 3 ] == 'P' ) )
+		 && ( ( encryption_method_string[ 4 ] == 'e' )
+		  ||  ( encryption_method_string[ 4 ] == 'E' ) )
+		 && ( ( encryption_method_string[ 5 ] == 'n' )
+		  ||  ( encryption_method_string[ 5 ] == 'N' ) )
+		 && ( ( encryption_method_string[ 6 ] == 't' )
+		  ||  ( encryption_method_string[ 6 ] == 'T' ) )
+		 &&   ( encryption_method_string[ 7 ] == 0 ) )
 		{
-			volume_header->encryption_method = LIBLUKSDE_ENCRYPTION_METHOD_SERPENT;
+			*encryption_method = LIBLUKSDE_ENCRYPTION_METHOD_SERPENT;
 		}
 	}
-	else if( ( encryption_method[ 0 ] == 't' )
-	      || ( encryption_method[ 0 ] == 'T' ) )
+	else if( ( encryption_method_string[ 0 ] == 't' )
+	      || ( encryption_method_string[ 0 ] == 'T' ) )
 	{
-		if( ( ( encryption_method[ 1 ] == 'w' )
-		  ||  ( encryption_method[ 1 ] == 'W' ) )
-		 && ( ( encryption_method[ 2 ] == 'o' )
-		  ||  ( encryption_method[ 2 ] == 'O' ) )
-		 && ( ( encryption_method[ 3 ] == 'f' )
-		  ||  ( encryption_method[ 3 ] == 'F' ) )
-		 && ( ( encryption_method[ 4 ] == 'i' )
-		  ||  ( encryption_method[ 4 ] == 'I' ) )
-		 && ( ( encryption_method[ 5 ] == 's' )
-		  ||  ( encryption_method[ 5 ] == 'S' ) )
-		 && ( ( encryption_method[ 6 ] == 'h' )
-		  ||  ( encryption_method[ 6 ] == 'H' ) )
-		 &&   ( encryption_method[ 7 ] == 0 ) )
+		if( ( ( encryption_method_string[ 1 ] == 'w' )
+		  ||  ( encryption_method_string[ 1 ] == 'W' ) )
+		 && ( ( encryption_method_string[ 2 ] == 'o' )
+		  ||  ( encryption_method_string[ 2 ] == 'O' ) )
+		 && ( ( encryption_method_string[ 3 ] == 'f' )
+		  ||  ( encryption_method_string[ 3 ] == 'F' ) )
+		 && ( ( encryption_method_string[ 4 ] == 'i' )
+		  ||  ( encryption_method_string[ 4 ] == 'I' ) )
+		 && ( ( encryption_method_string[ 5 ] == 's' )
+		  ||  ( encryption_method_string[ 5 ] == 'S' ) )
+		 && ( ( encryption_method_string[ 6 ] == 'h' )
+		  ||  ( encryption_method_string[ 6 ] == 'H' ) )
+		 &&   ( encryption_method_string[ 7 ] == 0 ) )
 		{
-			volume_header->encryption_method = LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH;
+			*encryption_method = LIBLUKSDE_ENCRYPTION_METHOD_TWOFISH;
 		}
 	}
 	return( 1 );
@@ -321,73 +401,97 @@ int libluksde_volume_parse_encryption_method(
  * Returns 1 if successful or -1 on error
  */
 int libluksde_volume_parse_encryption_mode(
-     libluksde_volume_header_t *volume_header,
-     const uint8_t *encryption_mode,
+     const uint8_t *encryption_mode_string,
+     int *encryption_chaining_mode,
+     int *initialization_vector_mode,
+     int *essiv_hashing_method,
      libcerror_error_t **error )
 {
 	static char *function = "libluksde_volume_parse_encryption_mode";
 	int separator_index   = 0;
 
-	if( volume_header == NULL )
+	if( encryption_mode_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid encryption mode string.",
+		 function );
+
+		return( -1 );
+	}
+	if( encryption_chaining_mode == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume header.",
+		 "%s: invalid encryption chaining mode.",
 		 function );
 
 		return( -1 );
 	}
-	if( encryption_mode == NULL )
+	if( initialization_vector_mode == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid encryption mode.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid initialization vector mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( essiv_hashing_method == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ESSIV hashing method.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( encryption_mode[ 0 ] == 'c' )
-	 || ( encryption_mode[ 0 ] == 'C' ) )
+	if( ( encryption_mode_string[ 0 ] == 'c' )
+	 || ( encryption_mode_string[ 0 ] == 'C' ) )
 	{
-		if( ( ( encryption_mode[ 1 ] == 'b' )
-		  ||  ( encryption_mode[ 1 ] == 'B' ) )
-		 && ( ( encryption_mode[ 2 ] == 'c' )
-		  ||  ( encryption_mode[ 2 ] == 'C' ) )
-		 &&   ( encryption_mode[ 3 ] == '-' ) )
+		if( ( ( encryption_mode_string[ 1 ] == 'b' )
+		  ||  ( encryption_mode_string[ 1 ] == 'B' ) )
+		 && ( ( encryption_mode_string[ 2 ] == 'c' )
+		  ||  ( encryption_mode_string[ 2 ] == 'C' ) )
+		 &&   ( encryption_mode_string[ 3 ] == '-' ) )
 		{
-			volume_header->encryption_chaining_mode = LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC;
+			*encryption_chaining_mode = LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC;
 
 			separator_index = 3;
 		}
 	}
-	else if( ( encryption_mode[ 0 ] == 'e' )
-	      || ( encryption_mode[ 0 ] == 'E' ) )
+	else if( ( encryption_mode_string[ 0 ] == 'e' )
+	      || ( encryption_mode_string[ 0 ] == 'E' ) )
 	{
-		if( ( ( encryption_mode[ 1 ] == 'c' )
-		  ||  ( encryption_mode[ 1 ] == 'C' ) )
-		 && ( ( encryption_mode[ 2 ] == 'b' )
-		  ||  ( encryption_mode[ 2 ] == 'B' ) )
-		 &&   ( encryption_mode[ 3 ] == 0 ) )
+		if( ( ( encryption_mode_string[ 1 ] == 'c' )
+		  ||  ( encryption_mode_string[ 1 ] == 'C' ) )
+		 && ( ( encryption_mode_string[ 2 ] == 'b' )
+		  ||  ( encryption_mode_string[ 2 ] == 'B' ) )
+		 &&   ( encryption_mode_string[ 3 ] == 0 ) )
 		{
-			volume_header->encryption_chaining_mode = LIBLUKSDE_ENCRYPTION_CHAINING_MODE_ECB;
+			*encryption_chaining_mode = LIBLUKSDE_ENCRYPTION_CHAINING_MODE_ECB;
 
 			separator_index = 3;
 		}
 	}
-	else if( ( encryption_mode[ 0 ] == 'x' )
-	      || ( encryption_mode[ 0 ] == 'X' ) )
+	else if( ( encryption_mode_string[ 0 ] == 'x' )
+	      || ( encryption_mode_string[ 0 ] == 'X' ) )
 	{
-		if( ( ( encryption_mode[ 1 ] == 't' )
-		  ||  ( encryption_mode[ 1 ] == 'T' ) )
-		 && ( ( encryption_mode[ 2 ] == 's' )
-		  ||  ( encryption_mode[ 2 ] == 'S' ) )
-		 &&   ( encryption_mode[ 3 ] == '-' ) )
+		if( ( ( encryption_mode_string[ 1 ] == 't' )
+		  ||  ( encryption_mode_string[ 1 ] == 'T' ) )
+		 && ( ( encryption_mode_string[ 2 ] == 's' )
+		  ||  ( encryption_mode_string[ 2 ] == 'S' ) )
+		 &&   ( encryption_mode_string[ 3 ] == '-' ) )
 		{
-			volume_header->encryption_chaining_mode = LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS;
+			*encryption_chaining_mode = LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS;
 
 			separator_index = 3;
 		}
@@ -395,109 +499,109 @@ int libluksde_volume_parse_encryption_mode(
 	if( ( separator_index > 0 )
 	 && ( separator_index < 31 ) )
 	{
-		volume_header->initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_NONE;
+		*initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_NONE;
 
-		if( ( encryption_mode[ separator_index + 1 ] == 'b' )
-		 || ( encryption_mode[ separator_index + 1 ] == 'B' ) )
+		if( ( encryption_mode_string[ separator_index + 1 ] == 'b' )
+		 || ( encryption_mode_string[ separator_index + 1 ] == 'B' ) )
 		{
-			if( ( ( encryption_mode[ separator_index + 2 ] == 'e' )
-			  ||  ( encryption_mode[ separator_index + 2 ] == 'E' ) )
-			 && ( ( encryption_mode[ separator_index + 3 ] == 'n' )
-			  ||  ( encryption_mode[ separator_index + 3 ] == 'N' ) )
-			 && ( ( encryption_mode[ separator_index + 4 ] == 'b' )
-			  ||  ( encryption_mode[ separator_index + 4 ] == 'B' ) )
-			 && ( ( encryption_mode[ separator_index + 5 ] == 'i' )
-			  ||  ( encryption_mode[ separator_index + 5 ] == 'I' ) )
-			 &&   ( encryption_mode[ separator_index + 6 ] == 0 ) )
+			if( ( ( encryption_mode_string[ separator_index + 2 ] == 'e' )
+			  ||  ( encryption_mode_string[ separator_index + 2 ] == 'E' ) )
+			 && ( ( encryption_mode_string[ separator_index + 3 ] == 'n' )
+			  ||  ( encryption_mode_string[ separator_index + 3 ] == 'N' ) )
+			 && ( ( encryption_mode_string[ separator_index + 4 ] == 'b' )
+			  ||  ( encryption_mode_string[ separator_index + 4 ] == 'B' ) )
+			 && ( ( encryption_mode_string[ separator_index + 5 ] == 'i' )
+			  ||  ( encryption_mode_string[ separator_index + 5 ] == 'I' ) )
+			 &&   ( encryption_mode_string[ separator_index + 6 ] == 0 ) )
 			{
-				volume_header->initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_BENBI;
+				*initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_BENBI;
 			}
 		}
-		else if( ( encryption_mode[ separator_index + 1 ] == 'e' )
-		      || ( encryption_mode[ separator_index + 1 ] == 'E' ) )
-		{
-			if( ( ( encryption_mode[ separator_index + 2 ] == 's' )
-			  ||  ( encryption_mode[ separator_index + 2 ] == 'S' ) )
-			 && ( ( encryption_mode[ separator_index + 3 ] == 's' )
-			  ||  ( encryption_mode[ separator_index + 3 ] == 'S' ) )
-			 && ( ( encryption_mode[ separator_index + 4 ] == 'i' )
-			  ||  ( encryption_mode[ separator_index + 4 ] == 'I' ) )
-			 && ( ( encryption_mode[ separator_index + 5 ] == 'v' )
-			  ||  ( encryption_mode[ separator_index + 5 ] == 'V' ) )
-			 &&   ( encryption_mode[ separator_index + 6 ] == ':' ) )
+		else if( ( encryption_mode_string[ separator_index + 1 ] == 'e' )
+		      || ( encryption_mode_string[ separator_index + 1 ] == 'E' ) )
+		{
+			if( ( ( encryption_mode_string[ separator_index + 2 ] == 's' )
+			  ||  ( encryption_mode_string[ separator_index + 2 ] == 'S' ) )
+			 && ( ( encryption_mode_string[ separator_index + 3 ] == 's' )
+			  ||  ( encryption_mode_string[ separator_index + 3 ] == 'S' ) )
+			 && ( ( encryption_mode_string[ separator_index + 4 ] == 'i' )
+			  ||  ( encryption_mode_string[ separator_index + 4 ] == 'I' ) )
+			 && ( ( encryption_mode_string[ separator_index + 5 ] == 'v' )
+			  ||  ( encryption_mode_string[ separator_index + 5 ] == 'V' ) )
+			 &&   ( encryption_mode_string[ separator_index + 6 ] == ':' ) )
 			{
-				if( ( ( encryption_mode[ separator_index + 7 ] == 's' )
-				  ||  ( encryption_mode[ separator_index + 7 ] == 'S' ) )
-				 && ( ( encryption_mode[ separator_index + 8 ] == 'h' )
-				  ||  ( encryption_mode[ separator_index + 8 ] == 'H' ) )
-				 && ( ( encryption_mode[ separator_index + 9 ] == 'a' )
-				  ||  ( encryption_mode[ separator_index + 9 ] == 'A' ) ) )
+				if( ( ( encryption_mode_string[ separator_index + 7 ] == 's' )
+				  ||  ( encryption_mode_string[ separator_index + 7 ] == 'S' ) )
+				 && ( ( encryption_mode_string[ separator_index + 8 ] == 'h' )
+				  ||  ( encryption_mode_string[ separator_index + 8 ] == 'H' ) )
+				 && ( ( encryption_mode_string[ separator_index + 9 ] == 'a' )
+				  ||  ( encryption_mode_string[ separator_index + 9 ] == 'A' ) ) )
 				{
-					if( ( encryption_mode[ separator_index + 10 ] == '1' )
-					 && ( encryption_mode[ separator_index + 11 ] == 0 ) )
+					if( ( encryption_mode_string[ separator_index + 10 ] == '1' )
+					 && ( encryption_mode_string[ separator_index + 11 ] == 0 ) )
 					{
-						volume_header->initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV;
-						volume_header->essiv_hashing_method       = LIBLUKSDE_HASHING_METHOD_SHA1;
+						*initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV;
+						*essiv_hashing_method       = LIBLUKSDE_HASHING_METHOD_SHA1;
 					}
-					else if( ( encryption_mode[ separator_index + 10 ] == '2' )
-					      && ( encryption_mode[ separator_index + 11 ] == '5' )
-					      && ( encryption_mode[ separator_index + 12 ] == '6' )
-					      && ( encryption_mode[ separator_index + 13 ] == 0 ) )
+					else if( ( encryption_mode_string[ separator_index + 10 ] == '2' )
+					      && ( encryption_mode_string[ separator_index + 11 ] == '5' )
+					      && ( encryption_mode_string[ separator_index + 12 ] == '6' )
+					      && ( encryption_mode_string[ separator_index + 13 ] == 0 ) )
 					{
-						volume_header->initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV;
-						volume_header->essiv_hashing_method       = LIBLUKSDE_HASHING_METHOD_SHA256;
+						*initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV;
+						*essiv_hashing_method       = LIBLUKSDE_HASHING_METHOD_SHA256;
 					}
 				}
 /* TODO IV options */
 			}
 		}
-		else if( ( encryption_mode[ separator_index + 1 ] == 'l' )
-		      || ( encryption_mode[ separator_index + 1 ] == 'L' ) )
+		else if( ( encryption_mode_string[ separator_index + 1 ] == 'l' )
+		      || ( encryption_mode_string[ separator_index + 1 ] == 'L' ) )
 		{
-			if( ( ( encryption_mode[ separator_index + 2 ] == 'm' )
-			  ||  ( encryption_mode[ separator_index + 2 ] == 'M' ) )
-			 && ( ( encryption_mode[ separator_index + 3 ] == 'k' )
-			  ||  ( encryption_mode[ separator_index + 3 ] == 'K' ) )
-			 &&   ( encryption_mode[ separator_index + 4 ] == 0 ) )
+			if( ( ( encryption_mode_string[ separator_index + 2 ] == 'm' )
+			  ||  ( encryption_mode_string[ separator_index + 2 ] == 'M' ) )
+			 && ( ( encryption_mode_string[ separator_index + 3 ] == 'k' )
+			  ||  ( encryption_mode_string[ separator_index + 3 ] == 'K' ) )
+			 &&   ( encryption_mode_string[ separator_index + 4 ] == 0 ) )
 			{
-				volume_header->initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_LMK;
+				*initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_LMK;
 			}
 		}
-		else if( ( encryption_mode[ separator_index + 1 ] == 'n' )
-		      || ( encryption_mode[ separator_index + 1 ] == 'N' ) )
+		else if( ( encryption_mode_string[ separator_index + 1 ] == 'n' )
+		      || ( encryption_mode_string[ separator_index + 1 ] == 'N' ) )
 		{
-			if( ( ( encryption_mode[ separator_index + 2 ] == 'u' )
-			  ||  ( encryption_mode[ separator_index + 2 ] == 'U' ) )
-			 && ( ( encryption_mode[ separator_index + 3 ] == 'l' )
-			  ||  ( encryption_mode[ separator_index + 3 ] == 'L' ) )
-			 && ( ( encryption_mode[ separator_index + 4 ] == 'l' )
-			  ||  ( encryption_mode[ separator_index + 4 ] == 'L' ) )
-			 &&   ( encryption_mode[ separator_index + 5 ] == 0 ) )
+			if( ( ( encryption_mode_string[ separator_index + 2 ] == 'u' )
+			  ||  ( encryption_mode_string[ separator_index + 2 ] == 'U' ) )
+			 && ( ( encryption_mode_string[ separator_index + 3 ] == 'l' )
+			  ||  ( encryption_mode_string[ separator_index + 3 ] == 'L' ) )
+			 && ( ( encryption_mode_string[ separator_index + 4 ] == 'l' )
+			  ||  ( encryption_mode_string[ separator_index + 4 ] == 'L' ) )
+			 &&   ( encryption_mode_string[ separator_index + 5 ] == 0 ) )
 			{
-				volume_header->initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_NULL;
+				*initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_NULL;
 			}
 		}
-		else if( ( encryption_mode[ separator_index + 1 ] == 'p' )
-		      || ( encryption_mode[ separator_index + 1 ] == 'P' ) )
-		{
-			if( ( ( encryption_mode[ separator_index + 2 ] == 'l' )
-			  ||  ( encryption_mode[ separator_index + 2 ] == 'L' ) )
-			 && ( ( encryption_mode[ separator_index + 3 ] == 'a' )
-			  ||  ( encryption_mode[ separator_index + 3 ] == 'A' ) )
-			 && ( ( encryption_mode[ separator_index + 4 ] == 'i' )
-			  ||  ( encryption_mode[ separator_index + 4 ] == 'I' ) )
-			 && ( ( encryption_mode[ separator_index + 5 ] == 'n' )
-			  ||  ( encryption_mode[ separator_index + 5 ] == 'N' ) ) )
+		else if( ( encryption_mode_string[ separator_index + 1 ] == 'p' )
+		      || ( encryption_mode_string[ separator_index + 1 ] == 'P' ) )
+		{
+			if( ( ( encryption_mode_string[ separator_index + 2 ] == 'l' )
+			  ||  ( encryption_mode_string[ separator_index + 2 ] == 'L' ) )
+			 && ( ( encryption_mode_string[ separator_index + 3 ] == 'a' )
+			  ||  ( encryption_mode_string[ separator_index + 3 ] == 'A' ) )
+			 && ( ( encryption_mode_string[ separator_index + 4 ] == 'i' )
+			  ||  ( encryption_mode_string[ separator_index + 4 ] == 'I' ) )
+			 && ( ( encryption_mode_string[ separator_index + 5 ] == 'n' )
+			  ||  ( encryption_mode_string[ separator_index + 5 ] == 'N' ) ) )
 			{
-				if( encryption_mode[ separator_index + 6 ] == 0 )
+				if( encryption_mode_string[ separator_index + 6 ] == 0 )
 				{
-					volume_header->initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN32;
+					*initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN32;
 				}
-				else if( ( encryption_mode[ separator_index + 6 ] == '6' )
-				      && ( encryption_mode[ separator_index + 7 ] == '4' )
-				      && ( encryption_mode[ separator_index + 8 ] == 0 ) )
+				else if( ( encryption_mode_string[ separator_index + 6 ] == '6' )
+				      && ( encryption_mode_string[ separator_index + 7 ] == '4' )
+				      && ( encryption_mode_string[ separator_index + 8 ] == 0 ) )
 				{
-					volume_header->initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64;
+					*initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64;
 				}
 			}
 		}
@@ -509,19 +613,19 @@ int libluksde_volume_parse_encryption_mode(
  * Returns 1 if successful or -1 on error
  */
 int libluksde_volume_parse_hashing_method(
-     libluksde_volume_header_t *volume_header,
-     const uint8_t *hashing_method,
+     const uint8_t *hashing_method_string,
+     int *hashing_method,
      libcerror_error_t **error )
 {
 	static char *function = "libluksde_volume_parse_hashing_method";
 
-	if( volume_header == NULL )
+	if( hashing_method_string == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume header.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid hashing method string.",
 		 function );
 
 		return( -1 );
@@ -530,73 +634,219 @@ int libluksde_volume_parse_hashing_method(
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
 		 "%s: invalid hashing method.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( hashing_method[ 0 ] == 'r' )
-	 || ( hashing_method[ 0 ] == 'R' ) )
-	{
-		if( ( ( hashing_method[ 1 ] == 'i' )
-		  ||  ( hashing_method[ 1 ] == 'I' ) )
-		 && ( ( hashing_method[ 2 ] == 'p' )
-		  ||  ( hashing_method[ 2 ] == 'P' ) )
-		 && ( ( hashing_method[ 3 ] == 'e' )
-		  ||  ( hashing_method[ 3 ] == 'E' ) )
-		 && ( ( hashing_method[ 4 ] == 'm' )
-		  ||  ( hashing_method[ 4 ] == 'M' ) )
-		 && ( ( hashing_method[ 5 ] == 'd' )
-		  ||  ( hashing_method[ 5 ] == 'D' ) )
-		 &&   ( hashing_method[ 6 ] == '1' )
-		 &&   ( hashing_method[ 7 ] == '6' )
-		 &&   ( hashing_method[ 8 ] == '0' )
-		 &&   ( hashing_method[ 9 ] == 0 ) )
-		{
-			volume_header->hashing_method = LIBLUKSDE_HASHING_METHOD_RIPEMD160;
-		}
-	}
-	else if( ( hashing_method[ 0 ] == 's' )
-	      || ( hashing_method[ 0 ] == 'S' ) )
-	{
-		if( ( ( hashing_method[ 1 ] == 'h' )
-		  ||  ( hashing_method[ 1 ] == 'H' ) )
-		 && ( ( hashing_method[ 2 ] == 'a' )
-		  ||  ( hashing_method[ 2 ] == 'A' ) ) )
-		{
-			if( ( hashing_method[ 3 ] == '1' )
-			 && ( hashing_method[ 4 ] == 0 ) )
+	if( ( hashing_method_string[ 0 ] == 'r' )
+	 || ( hashing_method_string[ 0 ] == 'R' ) )
+	{
+		if( ( ( hashing_method_string[ 1 ] == 'i' )
+		  ||  ( hashing_method_string[ 1 ] == 'I' ) )
+		 && ( ( hashing_method_string[ 2 ] == 'p' )
+		  ||  ( hashing_method_string[ 2 ] == 'P' ) )
+		 && ( ( hashing_method_string[ 3 ] == 'e' )
+		  ||  ( hashing_method_string[ 3 ] == 'E' ) )
+		 && ( ( hashing_method_string[ 4 ] == 'm' )
+		  ||  ( hashing_method_string[ 4 ] == 'M' ) )
+		 && ( ( hashing_method_string[ 5 ] == 'd' )
+		  ||  ( hashing_method_string[ 5 ] == 'D' ) )
+		 &&   ( hashing_method_string[ 6 ] == '1' )
+		 &&   ( hashing_method_string[ 7 ] == '6' )
+		 &&   ( hashing_method_string[ 8 ] == '0' )
+		 &&   ( hashing_method_string[ 9 ] == 0 ) )
+		{
+			*hashing_method = LIBLUKSDE_HASHING_METHOD_RIPEMD160;
+		}
+	}
+	else if( ( hashing_method_string[ 0 ] == 's' )
+	      || ( hashing_method_string[ 0 ] == 'S' ) )
+	{
+		if( ( ( hashing_method_string[ 1 ] == 'h' )
+		  ||  ( hashing_method_string[ 1 ] == 'H' ) )
+		 && ( ( hashing_method_string[ 2 ] == 'a' )
+		  ||  ( hashing_method_string[ 2 ] == 'A' ) ) )
+		{
+			if( ( hashing_method_string[ 3 ] == '1' )
+			 && ( hashing_method_string[ 4 ] == 0 ) )
 			{
-				volume_header->hashing_method = LIBLUKSDE_HASHING_METHOD_SHA1;
+				*hashing_method = LIBLUKSDE_HASHING_METHOD_SHA1;
 			}
-			else if( ( hashing_method[ 3 ] == '2' )
-			      && ( hashing_method[ 4 ] == '2' )
-			      && ( hashing_method[ 5 ] == '4' )
-			      && ( hashing_method[ 6 ] == 0 ) )
+			else if( ( hashing_method_string[ 3 ] == '2' )
+			      && ( hashing_method_string[ 4 ] == '2' )
+			      && ( hashing_method_string[ 5 ] == '4' )
+			      && ( hashing_method_string[ 6 ] == 0 ) )
 			{
-				volume_header->hashing_method = LIBLUKSDE_HASHING_METHOD_SHA224;
+				*hashing_method = LIBLUKSDE_HASHING_METHOD_SHA224;
 			}
-			else if( ( hashing_method[ 3 ] == '2' )
-			      && ( hashing_method[ 4 ] == '5' )
-			      && ( hashing_method[ 5 ] == '6' )
-			      && ( hashing_method[ 6 ] == 0 ) )
+			else if( ( hashing_method_string[ 3 ] == '2' )
+			      && ( hashing_method_string[ 4 ] == '5' )
+			      && ( hashing_method_string[ 5 ] == '6' )
+			      && ( hashing_method_string[ 6 ] == 0 ) )
 			{
-				volume_header->hashing_method = LIBLUKSDE_HASHING_METHOD_SHA256;
+				*hashing_method = LIBLUKSDE_HASHING_METHOD_SHA256;
 			}
-			else if( ( hashing_method[ 3 ] == '5' )
-			      && ( hashing_method[ 4 ] == '1' )
-			      && ( hashing_method[ 5 ] == '2' )
-			      && ( hashing_method[ 6 ] == 0 ) )
+			else if( ( hashing_method_string[ 3 ] == '5' )
+			      && ( hashing_method_string[ 4 ] == '1' )
+			      && ( hashing_method_string[ 5 ] == '2' )
+			      && ( hashing_method_string[ 6 ] == 0 ) )
 			{
-				volume_header->hashing_method = LIBLUKSDE_HASHING_METHOD_SHA512;
+				*hashing_method = LIBLUKSDE_HASHING_METHOD_SHA512;
 			}
 		}
 	}
 	return( 1 );
 }
 
+/* Parses a LUKS2 encryption specification such as "aes-xts-plain64"
+ * The specification consists of the encryption method and the encryption mode separated by a '-'
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_parse_encryption_specification(
+     const uint8_t *encryption_specification,
+     size_t encryption_specification_length,
+     int *encryption_method,
+     int *encryption_chaining_mode,
+     int *initialization_vector_mode,
+     int *essiv_hashing_method,
+     libcerror_error_t **error )
+{
+	uint8_t encryption_method_string[ 32 ];
+	uint8_t encryption_mode_string[ 32 ];
+
+	static char *function       = "libluksde_volume_parse_encryption_specification";
+	size_t encryption_mode_size = 0;
+	size_t separator_index      = 0;
+
+	if( encryption_specification == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encryption specification.",
+		 function );
+
+		return( -1 );
+	}
+	for( separator_index = 0;
+	     separator_index < encryption_specification_length;
+	     separator_index++ )
+	{
+		if( encryption_specification[ separator_index ] == (uint8_t) '-' )
+		{
+			break;
+		}
+	}
+	if( ( separator_index >= 32 )
+	 || ( ( encryption_specification_length - separator_index ) > 32 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid encryption specification length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     encryption_method_string,
+	     0,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear encryption method string.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     encryption_mode_string,
+	     0,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear encryption mode string.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     encryption_method_string,
+	     encryption_specification,
+	     separator_index ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy encryption method string.",
+		 function );
+
+		return( -1 );
+	}
+	if( separator_index < encryption_specification_length )
+	{
+		encryption_mode_size = encryption_specification_length - ( separator_index + 1 );
+
+		if( memory_copy(
+		     encryption_mode_string,
+		     &( encryption_specification[ separator_index + 1 ] ),
+		     encryption_mode_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy encryption mode string.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libluksde_volume_parse_encryption_method(
+	     encryption_method_string,
+	     encryption_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to parse encryption method.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_volume_parse_encryption_mode(
+	     encryption_mode_string,
+	     encryption_chaining_mode,
+	     initialization_vector_mode,
+	     essiv_hashing_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to parse encryption mode.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Reads the volume header
  * Returns 1 if successful or -1 on error
  */
@@ -610,6 +860,7 @@ int libluksde_volume_header_read_data(
 	libluksde_key_slot_t *key_slot = NULL;
 	static char *function          = "libluksde_volume_header_read_data";
 	size_t data_offset             = 0;
+	size_t header_data_size        = 0;
 	int entry_index                = 0;
 	int key_slot_index             = 0;
 	int result                     = 0;
@@ -703,19 +954,40 @@ int libluksde_volume_header_read_data(
 
 		goto on_error;
 	}
-	if( volume_header->format_version == 2 )
+	if( volume_header->format_version == 1 )
 	{
-		if( data_size < sizeof( luksde_volume_header_v2_t ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid data size value out of bounds.",
-			 function );
+		header_data_size = sizeof( luksde_volume_header_v1_t ) + ( 8 * sizeof( luksde_volume_keyslot_t ) );
+	}
+	else
+	{
+		header_data_size = sizeof( luksde_volume_header_v2_t );
+	}
+	if( data_size < header_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
 
-			goto on_error;
-		}
+		goto on_error;
+	}
+	if( libhmac_sha256_calculate(
+	     data,
+	     header_data_size,
+	     volume_header->header_digest,
+	     32,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate header digest.",
+		 function );
+
+		goto on_error;
 	}
 	if( volume_header->format_version == 1 )
 	{
@@ -723,6 +995,8 @@ int libluksde_volume_header_read_data(
 		 ( (luksde_volume_header_v1_t *) data )->encrypted_volume_start_sector,
 		 volume_header->encrypted_volume_start_sector );
 
+		volume_header->sector_size = 512;
+
 		byte_stream_copy_to_uint32_big_endian(
 		 ( (luksde_volume_header_v1_t *) data )->master_key_size,
 		 volume_header->master_key_size );
@@ -741,6 +1015,7 @@ int libluksde_volume_header_read_data(
 
 			goto on_error;
 		}
+		volume_header->master_key_validation_hash_size = 20;
 		if( memory_copy(
 		     volume_header->master_key_salt,
 		     ( (luksde_volume_header_v1_t *) data )->master_key_salt,
@@ -755,9 +1030,25 @@ int libluksde_volume_header_read_data(
 
 			goto on_error;
 		}
+		volume_header->master_key_salt_size = 32;
+
 		byte_stream_copy_to_uint32_big_endian(
 		 ( (luksde_volume_header_v1_t *) data )->master_key_number_of_iterations,
 		 volume_header->master_key_number_of_iterations );
+
+		/* In LUKS1 all 8 key slots contain the master key
+		 */
+		volume_header->master_key_key_slots_bitmap = 0x000000ffUL;
+	}
+	else
+	{
+		byte_stream_copy_to_uint64_big_endian(
+		 ( (luksde_volume_header_v2_t *) data )->metadata_area_size,
+		 volume_header->metadata_area_size );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 ( (luksde_volume_header_v2_t *) data )->sequence_identifier,
+		 volume_header->sequence_identifier );
 	}
 	if( libfguid_identifier_initialize(
 	     &guid,
@@ -916,7 +1207,7 @@ int libluksde_volume_header_read_data(
 			 function );
 			libcnotify_print_data(
 			 volume_header->master_key_validation_hash,
-			 20,
+			 volume_header->master_key_validation_hash_size,
 			 0 );
 
 			libcnotify_printf(
@@ -924,7 +1215,7 @@ int libluksde_volume_header_read_data(
 			 function );
 			libcnotify_print_data(
 			 volume_header->master_key_salt,
-			 32,
+			 volume_header->master_key_salt_size,
 			 0 );
 
 			libcnotify_printf(
@@ -952,21 +1243,15 @@ int libluksde_volume_header_read_data(
 		}
 		else if( volume_header->format_version == 2 )
 		{
-			byte_stream_copy_to_uint64_big_endian(
-			 ( (luksde_volume_header_v2_t *) data )->metadata_area_size,
-			 value_64bit );
 			libcnotify_printf(
 			 "%s: metadata area size\t\t\t: %" PRIu64 "\n",
 			 function,
-			 value_64bit );
+			 volume_header->metadata_area_size );
 
-			byte_stream_copy_to_uint64_big_endian(
-			 ( (luksde_volume_header_v2_t *) data )->sequence_identifier,
-			 value_64bit );
 			libcnotify_printf(
 			 "%s: sequence identifier\t\t\t: %" PRIu64 "\n",
 			 function,
-			 value_64bit );
+			 volume_header->sequence_identifier );
 
 			if( libluksde_debug_print_string_value(
 			     function,
@@ -1084,8 +1369,8 @@ int libluksde_volume_header_read_data(
 	if( volume_header->format_version == 1 )
 	{
 		if( libluksde_volume_parse_encryption_method(
-		     volume_header,
 		     ( (luksde_volume_header_v1_t *) data )->encryption_method,
+		     &( volume_header->encryption_method ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1098,8 +1383,10 @@ int libluksde_volume_header_read_data(
 			goto on_error;
 		}
 		if( libluksde_volume_parse_encryption_mode(
-		     volume_header,
 		     ( (luksde_volume_header_v1_t *) data )->encryption_mode,
+		     &( volume_header->encryption_chaining_mode ),
+		     &( volume_header->initialization_vector_mode ),
+		     &( volume_header->essiv_hashing_method ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1112,8 +1399,8 @@ int libluksde_volume_header_read_data(
 			goto on_error;
 		}
 		if( libluksde_volume_parse_hashing_method(
-		     volume_header,
 		     ( (luksde_volume_header_v1_t *) data )->hashing_method,
+		     &( volume_header->hashing_method ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1159,6 +1446,18 @@ int libluksde_volume_header_read_data(
 
 				goto on_error;
 			}
+			/* In LUKS1 the key material is encrypted with the volume encryption
+			 * and the key derivation and diffuser use the volume hashing method
+			 */
+			key_slot->identifier                 = key_slot_index;
+			key_slot->key_size                   = volume_header->master_key_size;
+			key_slot->hashing_method             = volume_header->hashing_method;
+			key_slot->diffuser_hashing_method    = volume_header->hashing_method;
+			key_slot->encryption_method          = volume_header->encryption_method;
+			key_slot->encryption_chaining_mode   = volume_header->encryption_chaining_mode;
+			key_slot->initialization_vector_mode = volume_header->initialization_vector_mode;
+			key_slot->essiv_hashing_method       = volume_header->essiv_hashing_method;
+			key_slot->encryption_key_size        = volume_header->master_key_size;
 			if( libcdata_array_append_entry(
 			     volume_header->key_slots_array,
 			     &entry_index,
@@ -1202,19 +1501,23 @@ on_error:
 	return( -1 );
 }
 
-/* Reads the volume header
+/* Reads the key slots JSON object
+ * The tokenizer must be positioned after the start of the object
  * Returns 1 if successful or -1 on error
  */
-int libluksde_volume_header_read_file_io_handle(
+int libluksde_volume_header_read_json_key_slots_object(
      libluksde_volume_header_t *volume_header,
-     libbfio_handle_t *file_io_handle,
-     off64_t file_offset,
+     libluksde_json_tokenizer_t *tokenizer,
      libcerror_error_t **error )
 {
-	uint8_t volume_header_data[ 4096 ];
+	libluksde_json_token_t key_token;
+	libluksde_json_token_t value_token;
 
-	static char *function = "libluksde_volume_header_read_file_io_handle";
-	ssize_t read_count    = 0;
+	libluksde_key_slot_t *key_slot = NULL;
+	static char *function          = "libluksde_volume_header_read_json_key_slots_object";
+	uint64_t identifier            = 0;
+	int entry_index                = 0;
+	int result                     = 0;
 
 	if( volume_header == NULL )
 	{
@@ -1227,52 +1530,1998 @@ int libluksde_volume_header_read_file_io_handle(
 
 		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	do
 	{
-		libcnotify_printf(
-		 "%s: reading volume header at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-		 function,
-		 file_offset,
-		 file_offset );
+		result = libluksde_json_tokenizer_get_next_member(
+		          tokenizer,
+		          &key_token,
+		          &value_token,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve key slot member.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libluksde_json_token_get_integer_value(
+		     &key_token,
+		     &identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve key slot identifier.",
+			 function );
+
+			goto on_error;
+		}
+		if( identifier >= 32 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid key slot identifier value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( value_token.type != LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_START )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported key slot: %" PRIu64 " value type.",
+			 function,
+			 identifier );
+
+			goto on_error;
+		}
+		if( libluksde_key_slot_initialize(
+		     &key_slot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create key slot.",
+			 function );
+
+			goto on_error;
+		}
+		key_slot->identifier = (int) identifier;
+
+		if( libluksde_key_slot_read_json_object(
+		     key_slot,
+		     tokenizer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read key slot: %" PRIu64 ".",
+			 function,
+			 identifier );
+
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     volume_header->key_slots_array,
+		     &entry_index,
+		     (intptr_t *) key_slot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append key slot to key slots array.",
+			 function );
+
+			goto on_error;
+		}
+		key_slot = NULL;
 	}
-#endif
-	read_count = libbfio_handle_read_buffer_at_offset(
-	              file_io_handle,
-	              volume_header_data,
-	              4096,
-	              file_offset,
-	              error );
+	while( result != 0 );
 
-	if( read_count != (ssize_t) 4096 )
+	return( 1 );
+
+on_error:
+	if( key_slot != NULL )
+	{
+		libluksde_key_slot_free(
+		 &key_slot,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the segments JSON object
+ * The tokenizer must be positioned after the start of the object
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_header_read_json_segments_object(
+     libluksde_volume_header_t *volume_header,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error )
+{
+	libluksde_json_token_t key_token;
+	libluksde_json_token_t value_token;
+
+	libluksde_segment_t *segment = NULL;
+	static char *function        = "libluksde_volume_header_read_json_segments_object";
+	uint64_t identifier          = 0;
+	int entry_index              = 0;
+	int result                   = 0;
+
+	if( volume_header == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read volume header data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 file_offset,
-		 file_offset );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume header.",
+		 function );
 
 		return( -1 );
 	}
-	if( libluksde_volume_header_read_data(
-	     volume_header,
-	     volume_header_data,
-	     4096,
-	     error ) != 1 )
+	do
+	{
+		result = libluksde_json_tokenizer_get_next_member(
+		          tokenizer,
+		          &key_token,
+		          &value_token,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment member.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libluksde_json_token_get_integer_value(
+		     &key_token,
+		     &identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment identifier.",
+			 function );
+
+			goto on_error;
+		}
+		if( identifier >= 32 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment identifier value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( value_token.type != LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_START )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported segment: %" PRIu64 " value type.",
+			 function,
+			 identifier );
+
+			goto on_error;
+		}
+		if( libluksde_segment_initialize(
+		     &segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment.",
+			 function );
+
+			goto on_error;
+		}
+		segment->identifier = (int) identifier;
+
+		if( libluksde_segment_read_json_object(
+		     segment,
+		     tokenizer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment: %" PRIu64 ".",
+			 function,
+			 identifier );
+
+			goto on_error;
+		}
+		/* The segments are stored in order of their identifier since
+		 * the volume data is mapped in that order
+		 */
+		result = libcdata_array_insert_entry(
+		          volume_header->segments_array,
+		          &entry_index,
+		          (intptr_t *) segment,
+		          (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libluksde_segment_compare_by_identifier,
+		          LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert segment into segments array.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: segment: %" PRIu64 " already set.",
+			 function,
+			 identifier );
+
+			goto on_error;
+		}
+		segment = NULL;
+		result  = 1;
+	}
+	while( result != 0 );
+
+	return( 1 );
+
+on_error:
+	if( segment != NULL )
+	{
+		libluksde_segment_free(
+		 &segment,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the digests JSON object
+ * The tokenizer must be positioned after the start of the object
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_header_read_json_digests_object(
+     libluksde_volume_header_t *volume_header,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error )
+{
+	libluksde_json_token_t key_token;
+	libluksde_json_token_t value_token;
+
+	libluksde_digest_t *digest = NULL;
+	static char *function      = "libluksde_volume_header_read_json_digests_object";
+	uint64_t identifier        = 0;
+	int entry_index            = 0;
+	int result                 = 0;
+
+	if( volume_header == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read volume header.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume header.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
+	do
+	{
+		result = libluksde_json_tokenizer_get_next_member(
+		          tokenizer,
+		          &key_token,
+		          &value_token,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve digest member.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libluksde_json_token_get_integer_value(
+		     &key_token,
+		     &identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve digest identifier.",
+			 function );
+
+			goto on_error;
+		}
+		if( identifier >= 32 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid digest identifier value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( value_token.type != LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_START )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported digest: %" PRIu64 " value type.",
+			 function,
+			 identifier );
+
+			goto on_error;
+		}
+		if( libluksde_digest_initialize(
+		     &digest,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest.",
+			 function );
+
+			goto on_error;
+		}
+		digest->identifier = (int) identifier;
+
+		if( libluksde_digest_read_json_object(
+		     digest,
+		     tokenizer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read digest: %" PRIu64 ".",
+			 function,
+			 identifier );
+
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     volume_header->digests_array,
+		     &entry_index,
+		     (intptr_t *) digest,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append digest to digests array.",
+			 function );
+
+			goto on_error;
+		}
+		digest = NULL;
+	}
+	while( result != 0 );
+
+	return( 1 );
+
+on_error:
+	if( digest != NULL )
+	{
+		libluksde_digest_free(
+		 &digest,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the LUKS2 JSON tokens object
+ * Only the key slots referenced by the tokens are retained
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_header_read_json_tokens_object(
+     libluksde_volume_header_t *volume_header,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error )
+{
+	libluksde_json_token_t key_token;
+	libluksde_json_token_t member_key_token;
+	libluksde_json_token_t member_value_token;
+	libluksde_json_token_t value_token;
+
+	static char *function = "libluksde_volume_header_read_json_tokens_object";
+	uint64_t identifier   = 0;
+	int result            = 0;
+
+	if( volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume header.",
+		 function );
+
+		return( -1 );
+	}
+	volume_header->tokens_bitmap = 0;
+
+	do
+	{
+		result = libluksde_json_tokenizer_get_next_member(
+		          tokenizer,
+		          &key_token,
+		          &value_token,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve token member.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libluksde_json_token_get_integer_value(
+		     &key_token,
+		     &identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve token identifier.",
+			 function );
+
+			return( -1 );
+		}
+		if( identifier >= 32 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid token identifier value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( value_token.type != LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_START )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported token: %" PRIu64 " value type.",
+			 function,
+			 identifier );
+
+			return( -1 );
+		}
+		volume_header->token_key_slots_bitmaps[ identifier ] = 0;
+
+		do
+		{
+			result = libluksde_json_tokenizer_get_next_member(
+			          tokenizer,
+			          &member_key_token,
+			          &member_value_token,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve token: %" PRIu64 " member.",
+				 function,
+				 identifier );
+
+				return( -1 );
+			}
+			else if( result == 0 )
+			{
+				break;
+			}
+			if( ( member_value_token.type == LIBLUKSDE_JSON_TOKEN_TYPE_ARRAY_START )
+			 && ( libluksde_json_token_compare_string(
+			       &member_key_token,
+			       "keyslots",
+			       8,
+			       error ) == 1 ) )
+			{
+				result = libluksde_digest_read_json_identifiers_array(
+				          tokenizer,
+				          &( volume_header->token_key_slots_bitmaps[ identifier ] ),
+				          error );
+			}
+			else
+			{
+				/* Other token members, such as the type, are specific to the token handler
+				 */
+				result = libluksde_json_tokenizer_skip_value(
+				          tokenizer,
+				          &member_value_token,
+				          error );
+			}
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read token: %" PRIu64 " member.",
+				 function,
+				 identifier );
+
+				return( -1 );
+			}
+		}
+		while( result != 0 );
+
+		volume_header->tokens_bitmap |= (uint32_t) 1 << identifier;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: token: %" PRIu64 " key slots bitmap\t: 0x%08" PRIx32 "\n",
+			 function,
+			 identifier,
+			 volume_header->token_key_slots_bitmaps[ identifier ] );
+		}
+#endif
+		/* Make sure the loop over the tokens continues
+		 */
+		result = 1;
+	}
+	while( result != 0 );
+
+	return( 1 );
+}
+
+/* Retrieves the digest of a specific LUKS2 segment
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libluksde_volume_header_get_digest_by_segment_identifier(
+     libluksde_volume_header_t *volume_header,
+     int segment_identifier,
+     libluksde_digest_t **digest,
+     libcerror_error_t **error )
+{
+	libluksde_digest_t *safe_digest = NULL;
+	static char *function           = "libluksde_volume_header_get_digest_by_segment_identifier";
+	int entry_index                 = 0;
+	int number_of_entries           = 0;
+
+	if( volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_identifier < 0 )
+	 || ( segment_identifier >= 32 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment identifier value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     volume_header->digests_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of digests.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     volume_header->digests_array,
+		     entry_index,
+		     (intptr_t **) &safe_digest,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve digest: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( ( safe_digest != NULL )
+		 && ( ( safe_digest->segments_bitmap & ( (uint32_t) 1 << segment_identifier ) ) != 0 ) )
+		{
+			*digest = safe_digest;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Reads the LUKS2 JSON metadata
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_header_read_json_data(
+     libluksde_volume_header_t *volume_header,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libluksde_json_token_t key_token;
+	libluksde_json_token_t value_token;
+	libluksde_json_tokenizer_t tokenizer;
+
+	libluksde_digest_t *digest           = NULL;
+	libluksde_digest_t *secondary_digest = NULL;
+	libluksde_key_slot_t *key_slot       = NULL;
+	libluksde_segment_t *segment         = NULL;
+	libluksde_segment_t *data_segment    = NULL;
+	static char *function                = "libluksde_volume_header_read_json_data";
+	int entry_index                      = 0;
+	int number_of_entries                = 0;
+	int result                           = 0;
+
+	if( volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_json_tokenizer_set_data(
+	     &tokenizer,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set tokenizer data.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading JSON metadata of size: %" PRIzd "\n\n",
+		 function,
+		 data_size );
+	}
+#endif
+	if( libluksde_json_tokenizer_get_next_token(
+	     &tokenizer,
+	     &value_token,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first token.",
+		 function );
+
+		goto on_error;
+	}
+	if( value_token.type != LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_START )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported JSON metadata - not an object.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		result = libluksde_json_tokenizer_get_next_member(
+		          &tokenizer,
+		          &key_token,
+		          &value_token,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve JSON metadata member.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( value_token.type != LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_START )
+		{
+			result = libluksde_json_tokenizer_skip_value(
+			          &tokenizer,
+			          &value_token,
+			          error );
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "keyslots",
+		          8,
+		          error ) == 1 )
+		{
+			result = libluksde_volume_header_read_json_key_slots_object(
+			          volume_header,
+			          &tokenizer,
+			          error );
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "segments",
+		          8,
+		          error ) == 1 )
+		{
+			result = libluksde_volume_header_read_json_segments_object(
+			          volume_header,
+			          &tokenizer,
+			          error );
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "digests",
+		          7,
+		          error ) == 1 )
+		{
+			result = libluksde_volume_header_read_json_digests_object(
+			          volume_header,
+			          &tokenizer,
+			          error );
+		}
+		else if( libluksde_json_token_compare_string(
+		          &key_token,
+		          "tokens",
+		          6,
+		          error ) == 1 )
+		{
+			result = libluksde_volume_header_read_json_tokens_object(
+			          volume_header,
+			          &tokenizer,
+			          error );
+		}
+		else
+		{
+			/* The config object is not needed to unlock the volume
+			 */
+			result = libluksde_json_tokenizer_skip_value(
+			          &tokenizer,
+			          &value_token,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read JSON metadata member.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( result != 0 );
+
+	/* Determine the volume values from the first crypt segment
+	 */
+	if( libcdata_array_get_number_of_entries(
+	     volume_header->segments_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     volume_header->segments_array,
+		     entry_index,
+		     (intptr_t **) &segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		if( ( segment != NULL )
+		 && ( segment->type == LIBLUKSDE_SEGMENT_TYPE_CRYPT )
+		 && ( segment->is_backup == 0 ) )
+		{
+			break;
+		}
+		segment = NULL;
+	}
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing crypt segment.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( segment->offset % segment->sector_size ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment offset value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	volume_header->encrypted_volume_start_sector = segment->offset / 512;
+	volume_header->sector_size                   = segment->sector_size;
+	volume_header->encryption_method             = segment->encryption_method;
+	volume_header->encryption_chaining_mode      = segment->encryption_chaining_mode;
+	volume_header->initialization_vector_mode    = segment->initialization_vector_mode;
+	volume_header->essiv_hashing_method          = segment->essiv_hashing_method;
+
+	/* Determine the master key validation values from the digest of the segment
+	 */
+	result = libluksde_volume_header_get_digest_by_segment_identifier(
+	          volume_header,
+	          segment->identifier,
+	          &digest,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve digest of segment: %d.",
+		 function,
+		 segment->identifier );
+
+		goto on_error;
+	}
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing digest of segment: %d.",
+		 function,
+		 segment->identifier );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     volume_header->master_key_validation_hash,
+	     digest->digest,
+	     digest->digest_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy master key validation hash.",
+		 function );
+
+		goto on_error;
+	}
+	volume_header->master_key_validation_hash_size = digest->digest_size;
+
+	if( memory_copy(
+	     volume_header->master_key_salt,
+	     digest->salt,
+	     digest->salt_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy master key salt.",
+		 function );
+
+		goto on_error;
+	}
+	volume_header->master_key_salt_size            = digest->salt_size;
+	volume_header->master_key_number_of_iterations = digest->number_of_iterations;
+	volume_header->master_key_key_slots_bitmap     = digest->key_slots_bitmap;
+	volume_header->hashing_method                  = digest->hashing_method;
+
+	/* During reencryption the data segments are bound to 2 different digests,
+	 * the master key of the other data segments is the secondary master key
+	 */
+	volume_header->secondary_master_key_digest = NULL;
+	volume_header->secondary_master_key_size   = 0;
+
+	if( libcdata_array_get_number_of_entries(
+	     volume_header->segments_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     volume_header->segments_array,
+		     entry_index,
+		     (intptr_t **) &data_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		if( ( data_segment == NULL )
+		 || ( data_segment->type != LIBLUKSDE_SEGMENT_TYPE_CRYPT )
+		 || ( data_segment->is_backup != 0 )
+		 || ( data_segment->identifier == segment->identifier ) )
+		{
+			continue;
+		}
+		result = libluksde_volume_header_get_digest_by_segment_identifier(
+		          volume_header,
+		          data_segment->identifier,
+		          &secondary_digest,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve digest of segment: %d.",
+			 function,
+			 data_segment->identifier );
+
+			goto on_error;
+		}
+		/* A crypt segment without a digest is assumed to use the master key
+		 */
+		if( ( result == 0 )
+		 || ( secondary_digest == digest ) )
+		{
+			continue;
+		}
+		if( ( volume_header->secondary_master_key_digest != NULL )
+		 && ( volume_header->secondary_master_key_digest != secondary_digest ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported segment: %d bound to a third digest.",
+			 function,
+			 data_segment->identifier );
+
+			goto on_error;
+		}
+		volume_header->secondary_master_key_digest = secondary_digest;
+	}
+	volume_header->master_key_size        = 0;
+	volume_header->reencryption_mode      = LIBLUKSDE_REENCRYPTION_MODE_UNKNOWN;
+	volume_header->reencryption_direction = LIBLUKSDE_REENCRYPTION_DIRECTION_UNKNOWN;
+
+	/* Determine the master key size from the key slots that contain the master key of the segment
+	 */
+	if( libcdata_array_get_number_of_entries(
+	     volume_header->key_slots_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of key slots.",
+		 function );
+
+		goto on_error;
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     volume_header->key_slots_array,
+		     entry_index,
+		     (intptr_t **) &key_slot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve key slot: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		if( key_slot == NULL )
+		{
+			continue;
+		}
+		if( key_slot->type == LIBLUKSDE_KEY_SLOT_TYPE_REENCRYPT )
+		{
+			volume_header->reencryption_mode      = key_slot->reencryption_mode;
+			volume_header->reencryption_direction = key_slot->reencryption_direction;
+		}
+		if( ( key_slot->state != LIBLUKSDE_KEY_SLOT_STATE_ACTIVE )
+		 || ( key_slot->identifier < 0 )
+		 || ( key_slot->identifier >= 32 ) )
+		{
+			continue;
+		}
+		if( ( volume_header->master_key_size == 0 )
+		 && ( ( digest->key_slots_bitmap & ( (uint32_t) 1 << key_slot->identifier ) ) != 0 ) )
+		{
+			volume_header->master_key_size = key_slot->key_size;
+		}
+		if( ( volume_header->secondary_master_key_digest != NULL )
+		 && ( volume_header->secondary_master_key_size == 0 )
+		 && ( ( volume_header->secondary_master_key_digest->key_slots_bitmap & ( (uint32_t) 1 << key_slot->identifier ) ) != 0 ) )
+		{
+			volume_header->secondary_master_key_size = key_slot->key_size;
+		}
+	}
+	if( ( volume_header->secondary_master_key_digest != NULL )
+	 && ( volume_header->reencryption_mode == LIBLUKSDE_REENCRYPTION_MODE_UNKNOWN ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing reencrypt key slot.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( volume_header->reencryption_mode != LIBLUKSDE_REENCRYPTION_MODE_UNKNOWN )
+		{
+			libcnotify_printf(
+			 "%s: reencryption mode\t\t\t: %d\n",
+			 function,
+			 volume_header->reencryption_mode );
+
+			libcnotify_printf(
+			 "%s: reencryption direction\t\t: %d\n",
+			 function,
+			 volume_header->reencryption_direction );
+		}
+		if( volume_header->secondary_master_key_digest != NULL )
+		{
+			libcnotify_printf(
+			 "%s: secondary master key digest\t\t: %d\n",
+			 function,
+			 volume_header->secondary_master_key_digest->identifier );
+
+			libcnotify_printf(
+			 "%s: secondary master key size\t\t: %" PRIu32 "\n",
+			 function,
+			 volume_header->secondary_master_key_size );
+		}
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	volume_header->secondary_master_key_digest = NULL;
+
+	libcdata_array_empty(
+	 volume_header->digests_array,
+	 (int(*)(intptr_t **, libcerror_error_t **)) &libluksde_digest_free,
+	 NULL );
+	libcdata_array_empty(
+	 volume_header->segments_array,
+	 (int(*)(intptr_t **, libcerror_error_t **)) &libluksde_segment_free,
+	 NULL );
+	libcdata_array_empty(
+	 volume_header->key_slots_array,
+	 (int(*)(intptr_t **, libcerror_error_t **)) &libluksde_key_slot_free,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Checks the checksum of a LUKS2 metadata area
+ * The checksum is calculated over the binary header and the JSON area with the checksum value set to 0
+ * Returns 1 if the checksum matches, 0 if not or -1 on error
+ */
+int libluksde_volume_header_check_metadata_area_checksum(
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t calculated_checksum[ 64 ];
+	uint8_t checksum_method_string[ 33 ];
+	uint8_t stored_checksum[ 64 ];
+
+	libluksde_diffuser_hash_function_t hash_function = NULL;
+	uint8_t *checksum_data                           = NULL;
+	static char *function                            = "libluksde_volume_header_check_metadata_area_checksum";
+	size_t hash_size                                 = 0;
+	int checksum_method                              = LIBLUKSDE_HASHING_METHOD_UNKNOWN;
+	int result                                       = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( luksde_volume_header_v2_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     checksum_method_string,
+	     ( (luksde_volume_header_v2_t *) data )->checksum_method,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy checksum method.",
+		 function );
+
+		return( -1 );
+	}
+	checksum_method_string[ 32 ] = 0;
+
+	if( libluksde_volume_parse_hashing_method(
+	     checksum_method_string,
+	     &checksum_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to parse checksum method.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( checksum_method == LIBLUKSDE_HASHING_METHOD_UNKNOWN )
+	 || ( checksum_method == LIBLUKSDE_HASHING_METHOD_RIPEMD160 ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unsupported checksum method: %s.\n",
+			 function,
+			 checksum_method_string );
+		}
+#endif
+		return( 0 );
+	}
+	if( libluksde_diffuser_get_hash_function(
+	     checksum_method,
+	     &hash_function,
+	     &hash_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve checksum hash function.",
+		 function );
+
+		return( -1 );
+	}
+	checksum_data = ( (luksde_volume_header_v2_t *) data )->checksum;
+
+	if( memory_copy(
+	     stored_checksum,
+	     checksum_data,
+	     64 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy stored checksum.",
+		 function );
+
+		return( -1 );
+	}
+	/* The checksum is calculated in place to prevent copying the whole metadata area
+	 */
+	if( memory_set(
+	     checksum_data,
+	     0,
+	     64 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( hash_function(
+	     data,
+	     data_size,
+	     calculated_checksum,
+	     hash_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     checksum_data,
+	     stored_checksum,
+	     64 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to restore checksum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: calculated checksum:\n",
+		 function );
+		libcnotify_print_data(
+		 calculated_checksum,
+		 hash_size,
+		 0 );
+	}
+#endif
+	result = memory_compare(
+	          stored_checksum,
+	          calculated_checksum,
+	          hash_size );
+
+	if( result != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	memory_copy(
+	 checksum_data,
+	 stored_checksum,
+	 64 );
+
+	return( -1 );
+}
+
+/* Reads a LUKS2 metadata area
+ * The metadata area consists of the binary header followed by the JSON area
+ * Returns 1 if successful, 0 if no metadata area with a valid checksum was found or -1 on error
+ */
+int libluksde_volume_header_read_metadata_area_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     uint8_t **metadata_area_data,
+     size_t *metadata_area_size,
+     libcerror_error_t **error )
+{
+	uint8_t header_data[ 16 ];
+
+	static char *function   = "libluksde_volume_header_read_metadata_area_file_io_handle";
+	uint8_t *data           = NULL;
+	size64_t data_size      = 0;
+	ssize_t read_count      = 0;
+	uint16_t format_version = 0;
+	int result              = 0;
+
+	if( metadata_area_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata area data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *metadata_area_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid metadata area data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_area_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata area size.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              header_data,
+	              16,
+	              file_offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read metadata area header data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		goto on_error;
+	}
+	else if( read_count != (ssize_t) 16 )
+	{
+		return( 0 );
+	}
+	if( ( memory_compare(
+	       ( (luksde_volume_header_v2_t *) header_data )->signature,
+	       luksde_signature,
+	       6 ) != 0 )
+	 && ( memory_compare(
+	       ( (luksde_volume_header_v2_t *) header_data )->signature,
+	       luksde_backup_volume_header_signature,
+	       6 ) != 0 ) )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint16_big_endian(
+	 ( (luksde_volume_header_v2_t *) header_data )->format_version,
+	 format_version );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 ( (luksde_volume_header_v2_t *) header_data )->metadata_area_size,
+	 data_size );
+
+	if( format_version != 2 )
+	{
+		return( 0 );
+	}
+	if( ( data_size < 16384 )
+	 || ( data_size > LIBLUKSDE_MAXIMUM_METADATA_AREA_SIZE )
+	 || ( ( data_size % 4096 ) != 0 ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: invalid metadata area size value out of bounds.\n",
+			 function );
+		}
+#endif
+		return( 0 );
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * (size_t) data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create metadata area data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              data,
+	              (size_t) data_size,
+	              file_offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read metadata area data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		goto on_error;
+	}
+	else if( read_count == (ssize_t) data_size )
+	{
+		result = libluksde_volume_header_check_metadata_area_checksum(
+		          data,
+		          (size_t) data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to check metadata area checksum.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( result == 0 )
+		{
+			libcnotify_printf(
+			 "%s: invalid metadata area at offset: %" PRIi64 " (0x%08" PRIx64 ").\n",
+			 function,
+			 file_offset,
+			 file_offset );
+		}
+	}
+#endif
+	if( result == 0 )
+	{
+		memory_free(
+		 data );
+
+		return( 0 );
+	}
+	*metadata_area_data = data;
+	*metadata_area_size = (size_t) data_size;
+
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
+/* Reads the binary volume header
+ * For LUKS2 the JSON metadata is not read and the checksum is not verified
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_header_read_binary_header_file_io_handle(
+     libluksde_volume_header_t *volume_header,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     libcerror_error_t **error )
+{
+	uint8_t volume_header_data[ 4096 ];
+
+	static char *function = "libluksde_volume_header_read_binary_header_file_io_handle";
+	ssize_t read_count    = 0;
+
+	if( volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume header.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading binary volume header at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 file_offset,
+		 file_offset );
+	}
+#endif
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              volume_header_data,
+	              4096,
+	              file_offset,
+	              error );
+
+	if( read_count != (ssize_t) 4096 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read volume header data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	if( libluksde_volume_header_read_data(
+	     volume_header,
+	     volume_header_data,
+	     4096,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read volume header.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the volume header
+ * For LUKS2 both the primary and secondary header copy are read and the copy with
+ * a valid checksum and the highest sequence identifier is used
+ * Returns 1 if successful or -1 on error
+ */
+int libluksde_volume_header_read_file_io_handle(
+     libluksde_volume_header_t *volume_header,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     libcerror_error_t **error )
+{
+	uint8_t volume_header_data[ 4096 ];
+
+	uint8_t *metadata_area_data            = NULL;
+	uint8_t *primary_metadata_area_data    = NULL;
+	uint8_t *secondary_metadata_area_data  = NULL;
+	static char *function                  = "libluksde_volume_header_read_file_io_handle";
+	size_t metadata_area_size              = 0;
+	size_t primary_metadata_area_size      = 0;
+	size_t secondary_metadata_area_size    = 0;
+	ssize_t read_count                     = 0;
+	uint64_t primary_sequence_identifier   = 0;
+	uint64_t secondary_sequence_identifier = 0;
+	uint16_t format_version                = 0;
+	int offset_index                       = 0;
+	int result                             = 0;
+
+	if( volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume header.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading volume header at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 file_offset,
+		 file_offset );
+	}
+#endif
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              volume_header_data,
+	              4096,
+	              file_offset,
+	              error );
+
+	if( read_count != (ssize_t) 4096 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read volume header data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint16_big_endian(
+	 ( (luksde_volume_header_v1_t *) volume_header_data )->format_version,
+	 format_version );
+
+	if( ( format_version == 1 )
+	 && ( memory_compare(
+	       ( (luksde_volume_header_v1_t *) volume_header_data )->signature,
+	       luksde_signature,
+	       6 ) == 0 ) )
+	{
+		if( libluksde_volume_header_read_data(
+		     volume_header,
+		     volume_header_data,
+		     4096,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read volume header.",
+			 function );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
+	/* A LUKS2 volume contains a primary and a secondary copy of the metadata area
+	 * The secondary copy is stored directly after the primary copy
+	 */
+	result = libluksde_volume_header_read_metadata_area_file_io_handle(
+	          file_io_handle,
+	          file_offset,
+	          &primary_metadata_area_data,
+	          &primary_metadata_area_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read primary metadata area.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		result = libluksde_volume_header_read_metadata_area_file_io_handle(
+		          file_io_handle,
+		          file_offset + (off64_t) primary_metadata_area_size,
+		          &secondary_metadata_area_data,
+		          &secondary_metadata_area_size,
+		          error );
+	}
+	else
+	{
+		/* The primary copy is damaged hence its metadata area size cannot be trusted
+		 * and the known offsets of the secondary copy are probed instead
+		 */
+		for( offset_index = 0;
+		     offset_index < 9;
+		     offset_index++ )
+		{
+			result = libluksde_volume_header_read_metadata_area_file_io_handle(
+			          file_io_handle,
+			          file_offset + libluksde_volume_header_secondary_offsets[ offset_index ],
+			          &secondary_metadata_area_data,
+			          &secondary_metadata_area_size,
+			          error );
+
+			if( result != 0 )
+			{
+				break;
+			}
+		}
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read secondary metadata area.",
+		 function );
+
+		goto on_error;
+	}
+	if( primary_metadata_area_data != NULL )
+	{
+		byte_stream_copy_to_uint64_big_endian(
+		 ( (luksde_volume_header_v2_t *) primary_metadata_area_data )->sequence_identifier,
+		 primary_sequence_identifier );
+	}
+	if( secondary_metadata_area_data != NULL )
+	{
+		byte_stream_copy_to_uint64_big_endian(
+		 ( (luksde_volume_header_v2_t *) secondary_metadata_area_data )->sequence_identifier,
+		 secondary_sequence_identifier );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( primary_metadata_area_data == NULL )
+		{
+			libcnotify_printf(
+			 "%s: primary metadata area is invalid.\n",
+			 function );
+		}
+		if( secondary_metadata_area_data == NULL )
+		{
+			libcnotify_printf(
+			 "%s: secondary metadata area is invalid.\n",
+			 function );
+		}
+	}
+#endif
+	/* Prefer the primary copy unless the secondary copy is more recent
+	 */
+	if( ( primary_metadata_area_data != NULL )
+	 && ( ( secondary_metadata_area_data == NULL )
+	  ||  ( primary_sequence_identifier >= secondary_sequence_identifier ) ) )
+	{
+		metadata_area_data = primary_metadata_area_data;
+		metadata_area_size = primary_metadata_area_size;
+	}
+	else if( secondary_metadata_area_data != NULL )
+	{
+		metadata_area_data = secondary_metadata_area_data;
+		metadata_area_size = secondary_metadata_area_size;
+	}
+	if( metadata_area_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: unable to find volume header with a valid checksum.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: using %s metadata area.\n",
+		 function,
+		 ( metadata_area_data == primary_metadata_area_data ) ? "primary" : "secondary" );
+	}
+#endif
+	if( libluksde_volume_header_read_data(
+	     volume_header,
+	     metadata_area_data,
+	     4096,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read volume header.",
+		 function );
+
+		goto on_error;
+	}
+	if( libluksde_volume_header_read_json_data(
+	     volume_header,
+	     &( metadata_area_data[ 4096 ] ),
+	     metadata_area_size - 4096,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read JSON metadata.",
+		 function );
+
+		goto on_error;
+	}
+	if( secondary_metadata_area_data != NULL )
+	{
+		memory_free(
+		 secondary_metadata_area_data );
+	}
+	if( primary_metadata_area_data != NULL )
+	{
+		memory_free(
+		 primary_metadata_area_data );
+	}
+	return( 1 );
+
+on_error:
+	if( secondary_metadata_area_data != NULL )
+	{
+		memory_free(
+		 secondary_metadata_area_data );
+	}
+	if( primary_metadata_area_data != NULL )
+	{
+		memory_free(
+		 primary_metadata_area_data );
+	}
+	return( -1 );
 }
 
 /* Retrieves the format version
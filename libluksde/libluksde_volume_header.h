@@ -25,6 +25,8 @@
 #include <common.h>
 #include <types.h>
 
+#include "libluksde_digest.h"
+#include "libluksde_json_tokenizer.h"
 #include "libluksde_libbfio.h"
 #include "libluksde_libcdata.h"
 #include "libluksde_libcerror.h"
@@ -41,26 +43,73 @@ struct libluksde_volume_header
 	 */
 	uint16_t format_version;
 
+	/* The metadata area size
+	 * Contains the size of the binary header and the JSON area of a LUKS2 header
+	 */
+	uint64_t metadata_area_size;
+
+	/* The sequence identifier
+	 */
+	uint64_t sequence_identifier;
+
 	/* The encrypted volume start sector
 	 */
 	uint64_t encrypted_volume_start_sector;
 
+	/* The encrypted sector size
+	 * Contains the size of the data that is encrypted with a single initialization vector
+	 */
+	uint32_t sector_size;
+
 	/* The master key size
 	 */
 	uint32_t master_key_size;
 
 	/* The master key validation hash
 	 */
-	uint8_t master_key_validation_hash[ 20 ];
+	uint8_t master_key_validation_hash[ 64 ];
+
+	/* The master key validation hash size
+	 */
+	size_t master_key_validation_hash_size;
 
 	/* The master key salt
 	 */
-	uint8_t master_key_salt[ 32 ];
+	uint8_t master_key_salt[ 64 ];
+
+	/* The master key salt size
+	 */
+	size_t master_key_salt_size;
 
 	/* The master key number of iterations
 	 */
 	uint32_t master_key_number_of_iterations;
 
+	/* The master key key slots bitmap
+	 * Contains a bit for each key slot that is bound to the master key digest
+	 */
+	uint32_t master_key_key_slots_bitmap;
+
+	/* The secondary master key digest
+	 * Contains the digest of the data segments that are not bound to the master key digest
+	 * Only used by LUKS2 during reencryption, when the data segments use 2 different master keys
+	 */
+	libluksde_digest_t *secondary_master_key_digest;
+
+	/* The secondary master key size
+	 */
+	uint32_t secondary_master_key_size;
+
+	/* The reencryption mode
+	 * Only used by LUKS2, contains LIBLUKSDE_REENCRYPTION_MODE_UNKNOWN if the volume is not being reencrypted
+	 */
+	int reencryption_mode;
+
+	/* The reencryption direction
+	 * Only used by LUKS2
+	 */
+	int reencryption_direction;
+
 	/* Encryption method
 	 */
 	int encryption_method;
@@ -85,9 +134,34 @@ struct libluksde_volume_header
 	 */
 	uint8_t volume_identifier[ 16 ];
 
+	/* The header digest
+	 * Contains a SHA-256 of the header data including the key slots
+	 */
+	uint8_t header_digest[ 32 ];
+
 	/* The key slots array
 	 */
 	libcdata_array_t *key_slots_array;
+
+	/* The segments array
+	 * Only used by LUKS2
+	 */
+	libcdata_array_t *segments_array;
+
+	/* The digests array
+	 * Only used by LUKS2
+	 */
+	libcdata_array_t *digests_array;
+
+	/* The key slots bitmaps of the tokens
+	 * Only used by LUKS2
+	 */
+	uint32_t token_key_slots_bitmaps[ 32 ];
+
+	/* The bitmap of the identifiers of the tokens
+	 * Only used by LUKS2
+	 */
+	uint32_t tokens_bitmap;
 };
 
 int libluksde_volume_header_initialize(
@@ -99,18 +173,29 @@ int libluksde_volume_header_free(
      libcerror_error_t **error );
 
 int libluksde_volume_parse_encryption_method(
-     libluksde_volume_header_t *volume_header,
-     const uint8_t *encryption_method,
+     const uint8_t *encryption_method_string,
+     int *encryption_method,
      libcerror_error_t **error );
 
 int libluksde_volume_parse_encryption_mode(
-     libluksde_volume_header_t *volume_header,
-     const uint8_t *encryption_mode,
+     const uint8_t *encryption_mode_string,
+     int *encryption_chaining_mode,
+     int *initialization_vector_mode,
+     int *essiv_hashing_method,
      libcerror_error_t **error );
 
 int libluksde_volume_parse_hashing_method(
-     libluksde_volume_header_t *volume_header,
-     const uint8_t *hashing_method,
+     const uint8_t *hashing_method_string,
+     int *hashing_method,
+     libcerror_error_t **error );
+
+int libluksde_volume_parse_encryption_specification(
+     const uint8_t *encryption_specification,
+     size_t encryption_specification_length,
+     int *encryption_method,
+     int *encryption_chaining_mode,
+     int *initialization_vector_mode,
+     int *essiv_hashing_method,
      libcerror_error_t **error );
 
 int libluksde_volume_header_read_data(
@@ -119,6 +204,56 @@ int libluksde_volume_header_read_data(
      size_t data_size,
      libcerror_error_t **error );
 
+int libluksde_volume_header_read_json_key_slots_object(
+     libluksde_volume_header_t *volume_header,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error );
+
+int libluksde_volume_header_read_json_segments_object(
+     libluksde_volume_header_t *volume_header,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error );
+
+int libluksde_volume_header_read_json_digests_object(
+     libluksde_volume_header_t *volume_header,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error );
+
+int libluksde_volume_header_read_json_tokens_object(
+     libluksde_volume_header_t *volume_header,
+     libluksde_json_tokenizer_t *tokenizer,
+     libcerror_error_t **error );
+
+int libluksde_volume_header_get_digest_by_segment_identifier(
+     libluksde_volume_header_t *volume_header,
+     int segment_identifier,
+     libluksde_digest_t **digest,
+     libcerror_error_t **error );
+
+int libluksde_volume_header_read_json_data(
+     libluksde_volume_header_t *volume_header,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libluksde_volume_header_check_metadata_area_checksum(
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libluksde_volume_header_read_metadata_area_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     uint8_t **metadata_area_data,
+     size_t *metadata_area_size,
+     libcerror_error_t **error );
+
+int libluksde_volume_header_read_binary_header_file_io_handle(
+     libluksde_volume_header_t *volume_header,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     libcerror_error_t **error );
+
 int libluksde_volume_header_read_file_io_handle(
      libluksde_volume_header_t *volume_header,
      libbfio_handle_t *file_io_handle,
@@ -0,0 +1,80 @@
+/*
+ * The master key cache definitions
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LUKSDE_MASTER_KEY_CACHE_H )
+#define _LUKSDE_MASTER_KEY_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct luksde_master_key_cache luksde_master_key_cache_t;
+
+struct luksde_master_key_cache
+{
+	/* The signature
+	 * Consists of 8 bytes
+	 * Contains: LUKSDEMK
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * Consists of 4 bytes
+	 * Contains: 1
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The master key size
+	 * Consists of 4 bytes
+	 */
+	uint8_t master_key_size[ 4 ];
+
+	/* The volume identifier
+	 * Consists of 16 bytes
+	 */
+	uint8_t volume_identifier[ 16 ];
+
+	/* The header digest
+	 * Consists of 32 bytes
+	 * Contains: a SHA-256 of the volume header data
+	 */
+	uint8_t header_digest[ 32 ];
+
+	/* The master key
+	 * Consists of 64 bytes
+	 */
+	uint8_t master_key[ 64 ];
+
+	/* The checksum
+	 * Consists of 32 bytes
+	 * Contains: a SHA-256 of the preceding data
+	 */
+	uint8_t checksum[ 32 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LUKSDE_MASTER_KEY_CACHE_H ) */
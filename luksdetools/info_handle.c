@@ -28,6 +28,8 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include <time.h>
+
 #include "luksdetools_input.h"
 #include "luksdetools_libbfio.h"
 #include "luksdetools_libcerror.h"
@@ -50,6 +52,22 @@ int libluksde_volume_open_file_io_handle(
 
 #define INFO_HANDLE_NOTIFY_STREAM		stdout
 
+/* The minimum duration of a benchmark measurement in clock ticks
+ */
+#define INFO_HANDLE_BENCHMARK_MINIMUM_CLOCKS	( CLOCKS_PER_SEC / 4 )
+
+/* The size of the data used to benchmark decryption
+ */
+#define INFO_HANDLE_BENCHMARK_DECRYPT_DATA_SIZE	( 1024 * 1024 )
+
+/* The minimum duration of an Argon2 benchmark measurement in microseconds
+ */
+#define INFO_HANDLE_BENCHMARK_MINIMUM_TIME	250000
+
+/* The memory cost in KiB the Argon2 benchmark starts with
+ */
+#define INFO_HANDLE_BENCHMARK_ARGON2_MEMORY_COST	1024
+
 /* Copies a string of a decimal value to a 64-bit value
  * Returns 1 if successful or -1 on error
  */
@@ -226,8 +244,9 @@ int info_handle_initialize(
 
 		return( -1 );
 	}
-	( *info_handle )->notify_stream   = INFO_HANDLE_NOTIFY_STREAM;
-	( *info_handle )->unattended_mode = unattended_mode;
+	( *info_handle )->token_identifier = -1;
+	( *info_handle )->notify_stream    = INFO_HANDLE_NOTIFY_STREAM;
+	( *info_handle )->unattended_mode  = unattended_mode;
 
 	return( 1 );
 
@@ -482,6 +501,240 @@ int info_handle_set_password(
 	return( 1 );
 }
 
+/* Sets the detached header
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_set_header(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_set_header";
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	info_handle->header_filename = string;
+
+	return( 1 );
+}
+
+/* Sets the keyfile
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_set_keyfile(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_set_keyfile";
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	info_handle->keyfile_filename = string;
+
+	return( 1 );
+}
+
+/* Sets the keyfile offset
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_set_keyfile_offset(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_set_keyfile_offset";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( luksdetools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid keyfile offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	info_handle->keyfile_offset = (off64_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the keyfile size
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_set_keyfile_size(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_set_keyfile_size";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( luksdetools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	info_handle->keyfile_size = (size64_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the token identifier
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_set_token_identifier(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_set_token_identifier";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( luksdetools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit >= 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid token identifier value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	info_handle->token_identifier = (int) value_64bit;
+
+	return( 1 );
+}
+
 /* Sets the volume offset
  * Returns 1 if successful or -1 on error
  */
@@ -630,6 +883,48 @@ int info_handle_open(
 
 		goto on_error;
 	}
+	if( info_handle->header_filename != NULL )
+	{
+		if( libbfio_file_initialize(
+		     &( info_handle->header_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize header file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		filename_length = system_string_length(
+		                   info_handle->header_filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libbfio_file_set_name_wide(
+		     info_handle->header_file_io_handle,
+		     info_handle->header_filename,
+		     filename_length,
+		     error ) != 1 )
+#else
+		if( libbfio_file_set_name(
+		     info_handle->header_file_io_handle,
+		     info_handle->header_filename,
+		     filename_length,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open set header file name.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libluksde_volume_initialize(
 	     &( info_handle->volume ),
 	     error ) != 1 )
@@ -687,24 +982,82 @@ int info_handle_open(
 			goto on_error;
 		}
 	}
-	if( libluksde_volume_open_file_io_handle(
-	     info_handle->volume,
-	     info_handle->file_io_handle,
-	     LIBLUKSDE_OPEN_READ,
-	     error ) != 1 )
+	if( info_handle->keyfile_filename != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open volume.",
-		 function );
-
-		goto on_error;
-	}
-	result = libluksde_volume_is_locked(
-	          info_handle->volume,
-	          error );
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libluksde_volume_set_keyfile_wide(
+		     info_handle->volume,
+		     info_handle->keyfile_filename,
+		     info_handle->keyfile_offset,
+		     info_handle->keyfile_size,
+		     error ) != 1 )
+#else
+		if( libluksde_volume_set_keyfile(
+		     info_handle->volume,
+		     info_handle->keyfile_filename,
+		     info_handle->keyfile_offset,
+		     info_handle->keyfile_size,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set keyfile.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( info_handle->token_identifier >= 0 )
+	{
+		if( libluksde_volume_set_token_identifier(
+		     info_handle->volume,
+		     info_handle->token_identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set token identifier.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( info_handle->header_file_io_handle != NULL )
+	{
+		result = libluksde_volume_open_file_io_handles(
+		          info_handle->volume,
+		          info_handle->header_file_io_handle,
+		          info_handle->file_io_handle,
+		          LIBLUKSDE_OPEN_READ,
+		          error );
+	}
+	else
+	{
+		result = libluksde_volume_open_file_io_handle(
+		          info_handle->volume,
+		          info_handle->file_io_handle,
+		          LIBLUKSDE_OPEN_READ,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume.",
+		 function );
+
+		goto on_error;
+	}
+	result = libluksde_volume_is_locked(
+	          info_handle->volume,
+	          error );
 
 	if( result == -1 )
 	{
@@ -805,6 +1158,12 @@ on_error:
 		 &( info_handle->volume ),
 		 NULL );
 	}
+	if( info_handle->header_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &( info_handle->header_file_io_handle ),
+		 NULL );
+	}
 	if( info_handle->file_io_handle != NULL )
 	{
 		libbfio_handle_free(
@@ -879,6 +1238,22 @@ int info_handle_close(
 
 		result = -1;
 	}
+	if( info_handle->header_file_io_handle != NULL )
+	{
+		if( libbfio_handle_free(
+		     &( info_handle->header_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free header file IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
 	return( result );
 }
 
@@ -1197,3 +1572,1015 @@ int info_handle_volume_fprint(
 	return( 1 );
 }
 
+/* Determines the number of PBKDF2 iterations per second
+ * The number of iterations is doubled until a measurement takes long enough to be significant
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_benchmark_pbkdf2(
+     info_handle_t *info_handle,
+     int hashing_method,
+     size_t key_size,
+     uint64_t *iterations_per_second,
+     libcerror_error_t **error )
+{
+	static char *function         = "info_handle_benchmark_pbkdf2";
+	clock_t elapsed_clocks        = 0;
+	clock_t start_clock           = 0;
+	uint32_t number_of_iterations = 1000;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( iterations_per_second == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid iterations per second.",
+		 function );
+
+		return( -1 );
+	}
+	while( info_handle->abort == 0 )
+	{
+		start_clock = clock();
+
+		if( libluksde_benchmark_pbkdf2(
+		     hashing_method,
+		     number_of_iterations,
+		     key_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to benchmark PBKDF2.",
+			 function );
+
+			return( -1 );
+		}
+		elapsed_clocks = clock() - start_clock;
+
+		if( ( elapsed_clocks >= INFO_HANDLE_BENCHMARK_MINIMUM_CLOCKS )
+		 || ( number_of_iterations >= 0x40000000UL ) )
+		{
+			break;
+		}
+		number_of_iterations *= 2;
+	}
+	if( elapsed_clocks <= 0 )
+	{
+		elapsed_clocks = 1;
+	}
+	*iterations_per_second = ( (uint64_t) number_of_iterations * CLOCKS_PER_SEC ) / (uint64_t) elapsed_clocks;
+
+	return( 1 );
+}
+
+/* Retrieves the current benchmark time in microseconds
+ * A monotonic clock is used if available since Argon2 can use multiple threads,
+ * otherwise the processor time is used
+ * Returns the benchmark time
+ */
+uint64_t info_handle_get_benchmark_time(
+          void )
+{
+#if defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_structure;
+
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) == 0 )
+	{
+		return( ( (uint64_t) time_structure.tv_sec * 1000000 ) + ( (uint64_t) time_structure.tv_nsec / 1000 ) );
+	}
+#endif
+	return( ( (uint64_t) clock() * 1000000 ) / CLOCKS_PER_SEC );
+}
+
+/* Determines the duration of a single Argon2 pass over the memory in microseconds
+ * The memory cost is doubled, up to that of the key slot, until a measurement
+ * takes long enough to be significant. The duration is then scaled to the
+ * memory cost of the key slot
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_benchmark_argon2(
+     info_handle_t *info_handle,
+     int key_derivation_function,
+     uint32_t memory_cost,
+     uint32_t parallelism,
+     size_t key_size,
+     uint64_t *pass_time,
+     libcerror_error_t **error )
+{
+	static char *function          = "info_handle_benchmark_argon2";
+	uint64_t elapsed_time          = 0;
+	uint64_t start_time            = 0;
+	uint32_t benchmark_memory_cost = INFO_HANDLE_BENCHMARK_ARGON2_MEMORY_COST;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( parallelism == 0 )
+	 || ( parallelism > 0x00ffffffUL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid parallelism value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( pass_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pass time.",
+		 function );
+
+		return( -1 );
+	}
+	/* Argon2 requires at least 8 KiB of memory per lane
+	 */
+	if( benchmark_memory_cost < ( 8 * parallelism ) )
+	{
+		benchmark_memory_cost = 8 * parallelism;
+	}
+	if( benchmark_memory_cost > memory_cost )
+	{
+		benchmark_memory_cost = memory_cost;
+	}
+	while( info_handle->abort == 0 )
+	{
+		start_time = info_handle_get_benchmark_time();
+
+		if( libluksde_benchmark_argon2(
+		     key_derivation_function,
+		     1,
+		     benchmark_memory_cost,
+		     parallelism,
+		     key_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to benchmark Argon2.",
+			 function );
+
+			return( -1 );
+		}
+		elapsed_time = info_handle_get_benchmark_time() - start_time;
+
+		if( ( elapsed_time >= INFO_HANDLE_BENCHMARK_MINIMUM_TIME )
+		 || ( benchmark_memory_cost >= memory_cost ) )
+		{
+			break;
+		}
+		if( benchmark_memory_cost > ( memory_cost / 2 ) )
+		{
+			benchmark_memory_cost = memory_cost;
+		}
+		else
+		{
+			benchmark_memory_cost *= 2;
+		}
+	}
+	if( benchmark_memory_cost == 0 )
+	{
+		benchmark_memory_cost = 1;
+	}
+	*pass_time = ( elapsed_time * memory_cost ) / benchmark_memory_cost;
+
+	return( 1 );
+}
+
+/* Determines the duration of an anti-forensic merge in microseconds
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_benchmark_diffuser_merge(
+     info_handle_t *info_handle,
+     int hashing_method,
+     uint32_t number_of_stripes,
+     size_t key_size,
+     uint64_t *merge_time,
+     libcerror_error_t **error )
+{
+	static char *function   = "info_handle_benchmark_diffuser_merge";
+	clock_t elapsed_clocks  = 0;
+	clock_t start_clock     = 0;
+	uint32_t number_of_runs = 1;
+	uint32_t run_index      = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( merge_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid merge time.",
+		 function );
+
+		return( -1 );
+	}
+	while( info_handle->abort == 0 )
+	{
+		start_clock = clock();
+
+		for( run_index = 0;
+		     run_index < number_of_runs;
+		     run_index++ )
+		{
+			if( libluksde_benchmark_diffuser_merge(
+			     hashing_method,
+			     number_of_stripes,
+			     key_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to benchmark anti-forensic merge.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		elapsed_clocks = clock() - start_clock;
+
+		if( ( elapsed_clocks >= INFO_HANDLE_BENCHMARK_MINIMUM_CLOCKS )
+		 || ( number_of_runs >= 0x00100000UL ) )
+		{
+			break;
+		}
+		number_of_runs *= 2;
+	}
+	*merge_time = ( (uint64_t) elapsed_clocks * 1000000 ) / ( (uint64_t) CLOCKS_PER_SEC * number_of_runs );
+
+	return( 1 );
+}
+
+/* Determines the number of bytes per second that can be decrypted
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_benchmark_decrypt(
+     info_handle_t *info_handle,
+     int encryption_method,
+     int encryption_chaining_mode,
+     int initialization_vector_mode,
+     size_t key_size,
+     uint64_t *bytes_per_second,
+     libcerror_error_t **error )
+{
+	static char *function   = "info_handle_benchmark_decrypt";
+	clock_t elapsed_clocks  = 0;
+	clock_t start_clock     = 0;
+	uint32_t number_of_runs = 1;
+	uint32_t run_index      = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bytes_per_second == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bytes per second.",
+		 function );
+
+		return( -1 );
+	}
+	while( info_handle->abort == 0 )
+	{
+		start_clock = clock();
+
+		for( run_index = 0;
+		     run_index < number_of_runs;
+		     run_index++ )
+		{
+			if( libluksde_benchmark_decrypt(
+			     encryption_method,
+			     encryption_chaining_mode,
+			     initialization_vector_mode,
+			     key_size,
+			     INFO_HANDLE_BENCHMARK_DECRYPT_DATA_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to benchmark decryption.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		elapsed_clocks = clock() - start_clock;
+
+		if( ( elapsed_clocks >= INFO_HANDLE_BENCHMARK_MINIMUM_CLOCKS )
+		 || ( number_of_runs >= 0x00010000UL ) )
+		{
+			break;
+		}
+		number_of_runs *= 2;
+	}
+	if( elapsed_clocks <= 0 )
+	{
+		elapsed_clocks = 1;
+	}
+	*bytes_per_second = ( (uint64_t) number_of_runs * INFO_HANDLE_BENCHMARK_DECRYPT_DATA_SIZE * CLOCKS_PER_SEC ) / (uint64_t) elapsed_clocks;
+
+	return( 1 );
+}
+
+/* Retrieves the name of a hashing method
+ * Returns a string
+ */
+const char *info_handle_get_hashing_method_name(
+             int hashing_method )
+{
+	switch( hashing_method )
+	{
+		case LIBLUKSDE_HASHING_METHOD_RIPEMD160:
+			return( "RIPEMD160" );
+
+		case LIBLUKSDE_HASHING_METHOD_SHA1:
+			return( "SHA1" );
+
+		case LIBLUKSDE_HASHING_METHOD_SHA224:
+			return( "SHA224" );
+
+		case LIBLUKSDE_HASHING_METHOD_SHA256:
+			return( "SHA256" );
+
+		case LIBLUKSDE_HASHING_METHOD_SHA512:
+			return( "SHA512" );
+
+		default:
+			break;
+	}
+	return( "Unknown" );
+}
+
+/* Retrieves the name of a key derivation function
+ * Returns a string
+ */
+const char *info_handle_get_key_derivation_function_name(
+             int key_derivation_function )
+{
+	switch( key_derivation_function )
+	{
+		case LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2I:
+			return( "Argon2i" );
+
+		case LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID:
+			return( "Argon2id" );
+
+		case LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_PBKDF2:
+			return( "PBKDF2" );
+
+		default:
+			break;
+	}
+	return( "Unknown" );
+}
+
+/* Prints the key derivation and decryption benchmark of the current host
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_benchmark_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	int hashing_methods[ 4 ] = {
+		LIBLUKSDE_HASHING_METHOD_SHA1,
+		LIBLUKSDE_HASHING_METHOD_SHA224,
+		LIBLUKSDE_HASHING_METHOD_SHA256,
+		LIBLUKSDE_HASHING_METHOD_SHA512 };
+
+	int chaining_modes[ 3 ] = {
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC,
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+		LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS };
+
+	int initialization_vector_modes[ 3 ] = {
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV,
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+		LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64 };
+
+	const char *cipher_names[ 3 ] = {
+		"AES-CBC-ESSIV",
+		"AES-XTS-PLAIN64",
+		"AES-XTS-PLAIN64" };
+
+	size_t key_sizes[ 3 ] = {
+		32,
+		32,
+		64 };
+
+	static char *function          = "info_handle_benchmark_fprint";
+	uint64_t bytes_per_second      = 0;
+	uint64_t iterations_per_second = 0;
+	uint64_t merge_time            = 0;
+	int method_index               = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "Key derivation and decryption benchmark:\n" );
+
+	for( method_index = 0;
+	     method_index < 4;
+	     method_index++ )
+	{
+		if( info_handle_benchmark_pbkdf2(
+		     info_handle,
+		     hashing_methods[ method_index ],
+		     32,
+		     &iterations_per_second,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to benchmark PBKDF2-%s.",
+			 function,
+			 info_handle_get_hashing_method_name(
+			  hashing_methods[ method_index ] ) );
+
+			return( -1 );
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tPBKDF2-%s\t\t\t: %" PRIu64 " iterations per second for 256-bit key\n",
+		 info_handle_get_hashing_method_name(
+		  hashing_methods[ method_index ] ),
+		 iterations_per_second );
+	}
+	for( method_index = 0;
+	     method_index < 4;
+	     method_index++ )
+	{
+		if( info_handle_benchmark_diffuser_merge(
+		     info_handle,
+		     hashing_methods[ method_index ],
+		     4000,
+		     32,
+		     &merge_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to benchmark anti-forensic merge with %s.",
+			 function,
+			 info_handle_get_hashing_method_name(
+			  hashing_methods[ method_index ] ) );
+
+			return( -1 );
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tAF merge-%s\t\t\t: %" PRIu64 " microseconds for 4000 stripes of 256-bit key\n",
+		 info_handle_get_hashing_method_name(
+		  hashing_methods[ method_index ] ),
+		 merge_time );
+	}
+	for( method_index = 0;
+	     method_index < 3;
+	     method_index++ )
+	{
+		if( info_handle_benchmark_decrypt(
+		     info_handle,
+		     LIBLUKSDE_ENCRYPTION_METHOD_AES,
+		     chaining_modes[ method_index ],
+		     initialization_vector_modes[ method_index ],
+		     key_sizes[ method_index ],
+		     &bytes_per_second,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to benchmark %s decryption.",
+			 function,
+			 cipher_names[ method_index ] );
+
+			return( -1 );
+		}
+		bytes_per_second = ( bytes_per_second * 10 ) / ( 1024 * 1024 );
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "\t%s %" PRIzd "-bit\t\t: %" PRIu64 ".%" PRIu64 " MiB/s decryption\n",
+		 cipher_names[ method_index ],
+		 key_sizes[ method_index ] * 8,
+		 bytes_per_second / 10,
+		 bytes_per_second % 10 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
+/* Prints the key slots and their estimated unlock time on the current host
+ * The estimated unlock time of a key slot includes the time needed to try
+ * the active key slots that precede it
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_key_slots_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	static char *function                    = "info_handle_key_slots_fprint";
+	size_t master_key_size                   = 0;
+	uint64_t bytes_per_second                = 0;
+	uint64_t digest_iterations_per_second    = 0;
+	uint64_t iterations_per_second           = 0;
+	uint64_t key_slot_time                   = 0;
+	uint64_t merge_time                      = 0;
+	uint64_t pass_time                       = 0;
+	uint64_t unlock_time                     = 0;
+	uint32_t benchmarked_memory_cost         = 0;
+	uint32_t benchmarked_parallelism         = 0;
+	uint32_t master_key_number_of_iterations = 0;
+	uint32_t memory_cost                     = 0;
+	uint32_t merged_number_of_stripes        = 0;
+	uint32_t number_of_iterations            = 0;
+	uint32_t number_of_stripes               = 0;
+	uint32_t parallelism                     = 0;
+	uint32_t time_cost                       = 0;
+	uint8_t is_active                        = 0;
+	int benchmarked_hashing_method           = LIBLUKSDE_HASHING_METHOD_UNKNOWN;
+	int benchmarked_key_derivation_function  = LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_UNKNOWN;
+	int diffuser_hashing_method              = 0;
+	int encryption_chaining_mode             = 0;
+	int encryption_method                    = 0;
+	int hashing_method                       = 0;
+	int initialization_vector_mode           = 0;
+	int key_derivation_function              = 0;
+	int key_slot_hashing_method              = 0;
+	int key_slot_index                       = 0;
+	int merged_hashing_method                = LIBLUKSDE_HASHING_METHOD_UNKNOWN;
+	int number_of_key_slots                  = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_volume_get_hashing_method(
+	     info_handle->volume,
+	     &hashing_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve hashing method.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_volume_get_master_key_size(
+	     info_handle->volume,
+	     &master_key_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve master key size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_volume_get_master_key_number_of_iterations(
+	     info_handle->volume,
+	     &master_key_number_of_iterations,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve master key number of iterations.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_volume_get_encryption_method(
+	     info_handle->volume,
+	     &encryption_method,
+	     &encryption_chaining_mode,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve encryption method.",
+		 function );
+
+		return( -1 );
+	}
+	if( libluksde_volume_get_number_of_key_slots(
+	     info_handle->volume,
+	     &number_of_key_slots,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of key slots.",
+		 function );
+
+		return( -1 );
+	}
+	switch( encryption_chaining_mode )
+	{
+		case LIBLUKSDE_ENCRYPTION_CHAINING_MODE_CBC:
+			initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_ESSIV;
+			break;
+
+		case LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS:
+			initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64;
+			break;
+
+		default:
+			initialization_vector_mode = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_NONE;
+			break;
+	}
+	/* The master key validation hash is 20 bytes of size
+	 */
+	if( info_handle_benchmark_pbkdf2(
+	     info_handle,
+	     hashing_method,
+	     20,
+	     &digest_iterations_per_second,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to benchmark master key validation hash derivation.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle_benchmark_decrypt(
+	     info_handle,
+	     encryption_method,
+	     encryption_chaining_mode,
+	     initialization_vector_mode,
+	     master_key_size,
+	     &bytes_per_second,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to benchmark key material decryption.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( digest_iterations_per_second == 0 )
+	 || ( bytes_per_second == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid benchmark result value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "Key slots:\n" );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tHashing method\t\t\t: %s\n",
+	 info_handle_get_hashing_method_name(
+	  hashing_method ) );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tMaster key size\t\t\t: %" PRIzd " bits\n",
+	 master_key_size * 8 );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tMaster key iterations\t\t: %" PRIu32 "\n",
+	 master_key_number_of_iterations );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	for( key_slot_index = 0;
+	     key_slot_index < number_of_key_slots;
+	     key_slot_index++ )
+	{
+		if( libluksde_volume_get_key_slot_values(
+		     info_handle->volume,
+		     key_slot_index,
+		     &is_active,
+		     &number_of_iterations,
+		     &number_of_stripes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve key slot: %d values.",
+			 function,
+			 key_slot_index );
+
+			return( -1 );
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "Key slot: %d\n",
+		 key_slot_index );
+
+		if( is_active == 0 )
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 "\tIs active\t\t\t: no\n"
+			 "\n" );
+
+			continue;
+		}
+		if( libluksde_volume_get_key_slot_key_derivation_values(
+		     info_handle->volume,
+		     key_slot_index,
+		     &key_derivation_function,
+		     &key_slot_hashing_method,
+		     &diffuser_hashing_method,
+		     &time_cost,
+		     &memory_cost,
+		     &parallelism,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve key slot: %d key derivation values.",
+			 function,
+			 key_slot_index );
+
+			return( -1 );
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tIs active\t\t\t: yes\n" );
+
+		if( key_derivation_function == LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_PBKDF2 )
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 "\tKey derivation function\t\t: PBKDF2-%s\n",
+			 info_handle_get_hashing_method_name(
+			  key_slot_hashing_method ) );
+
+			fprintf(
+			 info_handle->notify_stream,
+			 "\tNumber of iterations\t\t: %" PRIu32 "\n",
+			 number_of_iterations );
+		}
+		else
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 "\tKey derivation function\t\t: %s\n",
+			 info_handle_get_key_derivation_function_name(
+			  key_derivation_function ) );
+		}
+		if( ( key_derivation_function == LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2I )
+		 || ( key_derivation_function == LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID ) )
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 "\tTime cost\t\t\t: %" PRIu32 "\n",
+			 time_cost );
+
+			fprintf(
+			 info_handle->notify_stream,
+			 "\tMemory cost\t\t\t: %" PRIu32 " KiB\n",
+			 memory_cost );
+
+			fprintf(
+			 info_handle->notify_stream,
+			 "\tParallelism\t\t\t: %" PRIu32 "\n",
+			 parallelism );
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tNumber of stripes\t\t: %" PRIu32 "\n",
+		 number_of_stripes );
+
+		/* The time needed to try a key slot in microseconds
+		 */
+		key_slot_time = 0;
+
+		if( key_derivation_function == LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_PBKDF2 )
+		{
+			if( key_slot_hashing_method != LIBLUKSDE_HASHING_METHOD_UNKNOWN )
+			{
+				if( key_slot_hashing_method != benchmarked_hashing_method )
+				{
+					if( info_handle_benchmark_pbkdf2(
+					     info_handle,
+					     key_slot_hashing_method,
+					     master_key_size,
+					     &iterations_per_second,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GENERIC,
+						 "%s: unable to benchmark key derivation of key slot: %d.",
+						 function,
+						 key_slot_index );
+
+						return( -1 );
+					}
+					benchmarked_hashing_method = key_slot_hashing_method;
+				}
+				if( iterations_per_second != 0 )
+				{
+					key_slot_time = ( (uint64_t) number_of_iterations * 1000000 ) / iterations_per_second;
+				}
+			}
+		}
+		else if( ( key_derivation_function == LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2I )
+		      || ( key_derivation_function == LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID ) )
+		{
+			if( ( key_derivation_function != benchmarked_key_derivation_function )
+			 || ( memory_cost != benchmarked_memory_cost )
+			 || ( parallelism != benchmarked_parallelism ) )
+			{
+				if( info_handle_benchmark_argon2(
+				     info_handle,
+				     key_derivation_function,
+				     memory_cost,
+				     parallelism,
+				     master_key_size,
+				     &pass_time,
+				     error ) != 1 )
+				{
+					/* The Argon2 parameters of the key slot are not supported, for example
+					 * if the memory cost exceeds the maximum
+					 */
+					libcerror_error_free(
+					 error );
+
+					pass_time = 0;
+				}
+				else if( pass_time == 0 )
+				{
+					/* A pass time of 0 means the measurement was too short to be significant
+					 */
+					pass_time = 1;
+				}
+				benchmarked_key_derivation_function = key_derivation_function;
+				benchmarked_memory_cost             = memory_cost;
+				benchmarked_parallelism             = parallelism;
+			}
+			key_slot_time = (uint64_t) time_cost * pass_time;
+		}
+		if( ( key_slot_time == 0 )
+		 || ( diffuser_hashing_method == LIBLUKSDE_HASHING_METHOD_UNKNOWN ) )
+		{
+			/* Key slots with an unsupported key derivation are skipped when unlocking
+			 */
+			fprintf(
+			 info_handle->notify_stream,
+			 "\tEstimated unlock time\t\t: not supported\n"
+			 "\n" );
+
+			continue;
+		}
+		if( ( merged_number_of_stripes == 0 )
+		 || ( number_of_stripes != merged_number_of_stripes )
+		 || ( diffuser_hashing_method != merged_hashing_method ) )
+		{
+			if( info_handle_benchmark_diffuser_merge(
+			     info_handle,
+			     diffuser_hashing_method,
+			     number_of_stripes,
+			     master_key_size,
+			     &merge_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to benchmark anti-forensic merge of key slot: %d.",
+				 function,
+				 key_slot_index );
+
+				return( -1 );
+			}
+			merged_number_of_stripes = number_of_stripes;
+			merged_hashing_method    = diffuser_hashing_method;
+		}
+		key_slot_time += merge_time;
+		key_slot_time += ( (uint64_t) master_key_size * number_of_stripes * 1000000 ) / bytes_per_second;
+		key_slot_time += ( (uint64_t) master_key_number_of_iterations * 1000000 ) / digest_iterations_per_second;
+
+		unlock_time += key_slot_time;
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tEstimated unlock time\t\t: %" PRIu64 " ms\n",
+		 unlock_time / 1000 );
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "\n" );
+	}
+	return( 1 );
+}
+
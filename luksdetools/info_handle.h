@@ -58,10 +58,34 @@ struct info_handle
 	 */
 	size_t user_password_length;
 
+	/* The keyfile filename
+	 */
+	const system_character_t *keyfile_filename;
+
+	/* The keyfile offset
+	 */
+	off64_t keyfile_offset;
+
+	/* The keyfile size
+	 */
+	size64_t keyfile_size;
+
+	/* The token identifier
+	 */
+	int token_identifier;
+
+	/* The detached header filename
+	 */
+	const system_character_t *header_filename;
+
 	/* The libbfio file IO handle
 	 */
 	libbfio_handle_t *file_io_handle;
 
+	/* The libbfio detached header file IO handle
+	 */
+	libbfio_handle_t *header_file_io_handle;
+
 	/* The libluksde volume
 	 */
 	libluksde_volume_t *volume;
@@ -108,6 +132,31 @@ int info_handle_set_password(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int info_handle_set_header(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int info_handle_set_keyfile(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int info_handle_set_keyfile_offset(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int info_handle_set_keyfile_size(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int info_handle_set_token_identifier(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int info_handle_set_volume_offset(
      info_handle_t *info_handle,
      const system_character_t *string,
@@ -126,6 +175,56 @@ int info_handle_volume_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error );
 
+int info_handle_benchmark_pbkdf2(
+     info_handle_t *info_handle,
+     int hashing_method,
+     size_t key_size,
+     uint64_t *iterations_per_second,
+     libcerror_error_t **error );
+
+uint64_t info_handle_get_benchmark_time(
+          void );
+
+int info_handle_benchmark_argon2(
+     info_handle_t *info_handle,
+     int key_derivation_function,
+     uint32_t memory_cost,
+     uint32_t parallelism,
+     size_t key_size,
+     uint64_t *pass_time,
+     libcerror_error_t **error );
+
+int info_handle_benchmark_diffuser_merge(
+     info_handle_t *info_handle,
+     int hashing_method,
+     uint32_t number_of_stripes,
+     size_t key_size,
+     uint64_t *merge_time,
+     libcerror_error_t **error );
+
+int info_handle_benchmark_decrypt(
+     info_handle_t *info_handle,
+     int encryption_method,
+     int encryption_chaining_mode,
+     int initialization_vector_mode,
+     size_t key_size,
+     uint64_t *bytes_per_second,
+     libcerror_error_t **error );
+
+const char *info_handle_get_hashing_method_name(
+             int hashing_method );
+
+const char *info_handle_get_key_derivation_function_name(
+             int key_derivation_function );
+
+int info_handle_benchmark_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
+int info_handle_key_slots_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -64,15 +64,29 @@ void usage_fprint(
 	fprintf( stream, "Use luksdeinfo to determine information about a Linux Unified\n"
 	                 "Key Setup (LUKS) volume\n\n" );
 
-	fprintf( stream, "Usage: luksdeinfo [ -k key ] [ -o offset ] [ -p password ]\n"
-	                 "                  [ -huvV ] source\n\n" );
+	fprintf( stream, "Usage: luksdeinfo [ -d keyfile ] [ -H header ] [ -k key ]\n"
+	                 "                  [ -l keyfile_size ] [ -o offset ] [ -p password ]\n"
+	                 "                  [ -s keyfile_offset ] [ -t token ] [ -bhuvV ] source\n\n" );
 
-	fprintf( stream, "\tsource: the source file or device\n\n" );
+	fprintf( stream, "\tsource: the source file or device, optional in benchmark mode\n\n" );
 
+	fprintf( stream, "\t-b:     benchmark key derivation and key material decryption on\n"
+	                 "\t        this host and, if a source is specified, estimate the\n"
+	                 "\t        unlock time of its key slots\n" );
+	fprintf( stream, "\t-d:     specify the keyfile, which is used instead of the\n"
+	                 "\t        password/passphrase\n" );
 	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-H:     specify the detached header file, the source then only\n"
+	                 "\t        contains the encrypted volume data\n" );
 	fprintf( stream, "\t-k:     specify the volume master key formatted in base16\n" );
+	fprintf( stream, "\t-l:     specify the number of bytes to read from the keyfile,\n"
+	                 "\t        by default the remainder of the keyfile is read\n" );
 	fprintf( stream, "\t-o:     specify the volume offset\n" );
 	fprintf( stream, "\t-p:     specify the password/passphrase\n" );
+	fprintf( stream, "\t-s:     specify the number of bytes to skip at the start of the\n"
+	                 "\t        keyfile\n" );
+	fprintf( stream, "\t-t:     specify the LUKS2 token identifier, only the key slots\n"
+	                 "\t        referenced by the token are used to unlock the volume\n" );
 	fprintf( stream, "\t-u:     unattended mode (disables user interaction)\n" );
 	fprintf( stream, "\t-v:     verbose output to stderr\n" );
 	fprintf( stream, "\t-V:     print version\n" );
@@ -130,15 +144,21 @@ int wmain( int argc, wchar_t * const argv[] )
 int main( int argc, char * const argv[] )
 #endif
 {
-	libluksde_error_t *error                 = NULL;
-	system_character_t *option_key           = NULL;
-	system_character_t *option_password      = NULL;
-	system_character_t *option_volume_offset = NULL;
-	system_character_t *source               = NULL;
-	char *program                            = "luksdeinfo";
-	system_integer_t option                  = 0;
-	int unattended_mode                      = 0;
-	int verbose                              = 0;
+	libluksde_error_t *error                    = NULL;
+	system_character_t *option_header           = NULL;
+	system_character_t *option_key              = NULL;
+	system_character_t *option_keyfile          = NULL;
+	system_character_t *option_keyfile_offset   = NULL;
+	system_character_t *option_keyfile_size     = NULL;
+	system_character_t *option_password         = NULL;
+	system_character_t *option_token_identifier = NULL;
+	system_character_t *option_volume_offset    = NULL;
+	system_character_t *source                  = NULL;
+	char *program                               = "luksdeinfo";
+	system_integer_t option                     = 0;
+	int option_benchmark                        = 0;
+	int unattended_mode                         = 0;
+	int verbose                                 = 0;
 
 	libcnotify_stream_set(
 	 stderr,
@@ -173,7 +193,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = luksdetools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "hk:o:p:uvV" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "bd:hH:k:l:o:p:s:t:uvV" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -189,17 +209,37 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_FAILURE );
 
+			case (system_integer_t) 'b':
+				option_benchmark = 1;
+
+				break;
+
+			case (system_integer_t) 'd':
+				option_keyfile = optarg;
+
+				break;
+
 			case (system_integer_t) 'h':
 				usage_fprint(
 				 stdout );
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'H':
+				option_header = optarg;
+
+				break;
+
 			case (system_integer_t) 'k':
 				option_key = optarg;
 
 				break;
 
+			case (system_integer_t) 'l':
+				option_keyfile_size = optarg;
+
+				break;
+
 			case (system_integer_t) 'o':
 				option_volume_offset = optarg;
 
@@ -210,6 +250,16 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 's':
+				option_keyfile_offset = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_token_identifier = optarg;
+
+				break;
+
 			case (system_integer_t) 'u':
 				unattended_mode = 1;
 
@@ -227,7 +277,8 @@ int main( int argc, char * const argv[] )
 				return( EXIT_SUCCESS );
 		}
 	}
-	if( optind == argc )
+	if( ( optind == argc )
+	 && ( option_benchmark == 0 ) )
 	{
 		fprintf(
 		 stderr,
@@ -238,7 +289,10 @@ int main( int argc, char * const argv[] )
 
 		return( EXIT_FAILURE );
 	}
-	source = argv[ optind ];
+	if( optind < argc )
+	{
+		source = argv[ optind ];
+	}
 
 	libcnotify_verbose_set(
 	 verbose );
@@ -287,6 +341,76 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_header != NULL )
+	{
+		if( info_handle_set_header(
+		     luksdeinfo_info_handle,
+		     option_header,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set header.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_keyfile != NULL )
+	{
+		if( info_handle_set_keyfile(
+		     luksdeinfo_info_handle,
+		     option_keyfile,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set keyfile.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_keyfile_offset != NULL )
+	{
+		if( info_handle_set_keyfile_offset(
+		     luksdeinfo_info_handle,
+		     option_keyfile_offset,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set keyfile offset.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_keyfile_size != NULL )
+	{
+		if( info_handle_set_keyfile_size(
+		     luksdeinfo_info_handle,
+		     option_keyfile_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set keyfile size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_token_identifier != NULL )
+	{
+		if( info_handle_set_token_identifier(
+		     luksdeinfo_info_handle,
+		     option_token_identifier,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set token identifier.\n" );
+
+			goto on_error;
+		}
+	}
 	if( option_volume_offset != NULL )
 	{
 		if( info_handle_set_volume_offset(
@@ -301,37 +425,66 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
-	if( info_handle_open(
-	     luksdeinfo_info_handle,
-	     source,
-	     &error ) != 1 )
+	if( option_benchmark != 0 )
 	{
-		fprintf(
-		 stderr,
-		 "Unable to open: %" PRIs_SYSTEM ".\n",
-		 source );
+		if( info_handle_benchmark_fprint(
+		     luksdeinfo_info_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to print benchmark.\n" );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
-	if( info_handle_volume_fprint(
-	     luksdeinfo_info_handle,
-	     &error ) != 1 )
+	if( source != NULL )
 	{
-		fprintf(
-		 stderr,
-		 "Unable to print volume information.\n" );
+		if( info_handle_open(
+		     luksdeinfo_info_handle,
+		     source,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open: %" PRIs_SYSTEM ".\n",
+			 source );
 
-		goto on_error;
-	}
-	if( info_handle_close(
-	     luksdeinfo_info_handle,
-	     &error ) != 0 )
-	{
-		fprintf(
-		 stderr,
-		 "Unable to close info handle.\n" );
+			goto on_error;
+		}
+		if( info_handle_volume_fprint(
+		     luksdeinfo_info_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to print volume information.\n" );
 
-		goto on_error;
+			goto on_error;
+		}
+		if( option_benchmark != 0 )
+		{
+			if( info_handle_key_slots_fprint(
+			     luksdeinfo_info_handle,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to print key slots.\n" );
+
+				goto on_error;
+			}
+		}
+		if( info_handle_close(
+		     luksdeinfo_info_handle,
+		     &error ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to close info handle.\n" );
+
+			goto on_error;
+		}
 	}
 	if( info_handle_free(
 	     &luksdeinfo_info_handle,
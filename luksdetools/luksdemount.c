@@ -66,16 +66,34 @@ void usage_fprint(
 	}
 	fprintf( stream, "Use luksdemount to mount a Linux Unified Key Setup (LUKS) Disk Encrypted volume\n\n" );
 
-	fprintf( stream, "Usage: luksdemount [ -k key ] [ -o offset ] [ -p password ]\n"
-	                 "                   [ -X extended_options ] [ -huvV ] volume mount_point\n\n" );
+	fprintf( stream, "Usage: luksdemount [ -d keyfile ] [ -H header ] [ -k key ]\n"
+	                 "                   [ -l keyfile_size ] [ -o offset ] [ -p password ]\n"
+	                 "                   [ -s keyfile_offset ] [ -t token ]\n"
+	                 "                   [ -X extended_options ] [ -huvV ]\n"
+	                 "                   volume mount_point\n\n" );
 
 	fprintf( stream, "\tvolume:      a Linux Unified Key Setup (LUKS) Disk Encrypted volume\n\n" );
 	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
 
+	fprintf( stream, "\t-d:          specify the keyfile, which is used instead of the\n"
+	                 "\t             password/passphrase\n" );
 	fprintf( stream, "\t-h:          shows this help\n" );
-	fprintf( stream, "\t-k:          specify the volume master key formatted in base16\n" );
+	fprintf( stream, "\t-H:          specify the detached header file, the volume then only\n"
+	                 "\t             contains the encrypted volume data\n" );
+	fprintf( stream, "\t-k:          specify the volume master key formatted in base16 or\n"
+	                 "\t             @file to use a master key cache file, which is created\n"
+	                 "\t             after the volume was unlocked if it does not exist or\n"
+	                 "\t             is not valid. Note that the cache file contains the\n"
+	                 "\t             master key unencrypted, it is created readable by the\n"
+	                 "\t             owner only and ignored if readable by others\n" );
+	fprintf( stream, "\t-l:          specify the number of bytes to read from the keyfile,\n"
+	                 "\t             by default the remainder of the keyfile is read\n" );
 	fprintf( stream, "\t-o:          specify the volume offset in bytes\n" );
 	fprintf( stream, "\t-p:          specify the password/passphrase\n" );
+	fprintf( stream, "\t-s:          specify the number of bytes to skip at the start of the\n"
+	                 "\t             keyfile\n" );
+	fprintf( stream, "\t-t:          specify the LUKS2 token identifier, only the key slots\n"
+	                 "\t             referenced by the token are used to unlock the volume\n" );
 	fprintf( stream, "\t-v:          verbose output to stderr, while luksdemount will remain running in the\n"
 	                 "\t             foreground\n" );
 	fprintf( stream, "\t-u:          unattended mode (disables user interaction)\n" );
@@ -138,9 +156,14 @@ int main( int argc, char * const argv[] )
 	libluksde_error_t *error                    = NULL;
 	system_character_t *mount_point             = NULL;
 	system_character_t *option_extended_options = NULL;
+	system_character_t *option_header           = NULL;
 	system_character_t *option_key              = NULL;
+	system_character_t *option_keyfile          = NULL;
+	system_character_t *option_keyfile_offset   = NULL;
+	system_character_t *option_keyfile_size     = NULL;
 	system_character_t *option_offset           = NULL;
 	system_character_t *option_password         = NULL;
+	system_character_t *option_token_identifier = NULL;
 	const system_character_t *path_prefix       = NULL;
 	system_character_t *source                  = NULL;
 	char *program                               = "luksdemount";
@@ -203,7 +226,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = luksdetools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "hk:o:p:uvVX:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "d:hH:k:l:o:p:s:t:uvVX:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -219,17 +242,32 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_FAILURE );
 
+			case (system_integer_t) 'd':
+				option_keyfile = optarg;
+
+				break;
+
 			case (system_integer_t) 'h':
 				usage_fprint(
 				 stdout );
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'H':
+				option_header = optarg;
+
+				break;
+
 			case (system_integer_t) 'k':
 				option_key = optarg;
 
 				break;
 
+			case (system_integer_t) 'l':
+				option_keyfile_size = optarg;
+
+				break;
+
 			case (system_integer_t) 'o':
 				option_offset = optarg;
 
@@ -240,6 +278,16 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 's':
+				option_keyfile_offset = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_token_identifier = optarg;
+
+				break;
+
 			case (system_integer_t) 'u':
 				unattended_mode = 1;
 
@@ -321,6 +369,76 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_header != NULL )
+	{
+		if( mount_handle_set_header(
+		     luksdemount_mount_handle,
+		     option_header,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set header.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_keyfile != NULL )
+	{
+		if( mount_handle_set_keyfile(
+		     luksdemount_mount_handle,
+		     option_keyfile,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set keyfile.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_keyfile_offset != NULL )
+	{
+		if( mount_handle_set_keyfile_offset(
+		     luksdemount_mount_handle,
+		     option_keyfile_offset,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set keyfile offset.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_keyfile_size != NULL )
+	{
+		if( mount_handle_set_keyfile_size(
+		     luksdemount_mount_handle,
+		     option_keyfile_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set keyfile size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_token_identifier != NULL )
+	{
+		if( mount_handle_set_token_identifier(
+		     luksdemount_mount_handle,
+		     option_token_identifier,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set token identifier.\n" );
+
+			goto on_error;
+		}
+	}
 	if( option_offset != NULL )
 	{
 		if( mount_handle_set_offset(
@@ -26,6 +26,18 @@
 #include <types.h>
 #include <wide_string.h>
 
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
 #include "luksdetools_input.h"
 #include "luksdetools_libbfio.h"
 #include "luksdetools_libcerror.h"
@@ -45,10 +57,22 @@ int libluksde_volume_open_file_io_handle(
      int access_flags,
      libluksde_error_t **error );
 
+extern \
+int libluksde_volume_open_file_io_handles(
+     libluksde_volume_t *volume,
+     libbfio_handle_t *header_file_io_handle,
+     libbfio_handle_t *data_file_io_handle,
+     int access_flags,
+     libluksde_error_t **error );
+
 #endif /* !defined( LIBLUKSDE_HAVE_BFIO ) */
 
 #define MOUNT_HANDLE_NOTIFY_STREAM		stdout
 
+#if defined( HAVE_FCNTL_H ) && defined( HAVE_SYS_STAT_H ) && defined( HAVE_UNISTD_H ) && defined( HAVE_FCHMOD ) && defined( HAVE_FSTAT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define MOUNT_HANDLE_HAVE_POSIX_FILE_MODE
+#endif
+
 /* Copies a string of a decimal value to a 64-bit value
  * Returns 1 if successful or -1 on error
  */
@@ -233,8 +257,9 @@ int mount_handle_initialize(
 
 		goto on_error;
 	}
-	( *mount_handle )->notify_stream   = MOUNT_HANDLE_NOTIFY_STREAM;
-	( *mount_handle )->unattended_mode = unattended_mode;
+	( *mount_handle )->token_identifier = -1;
+	( *mount_handle )->notify_stream    = MOUNT_HANDLE_NOTIFY_STREAM;
+	( *mount_handle )->unattended_mode  = unattended_mode;
 
 	return( 1 );
 
@@ -313,24 +338,852 @@ int mount_handle_free(
 			 "%s: unable to clear key data.",
 			 function );
 
-			result = -1;
-		}
-		memory_free(
-		 *mount_handle );
+			result = -1;
+		}
+		memory_free(
+		 *mount_handle );
+
+		*mount_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the mount handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_signal_abort(
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_signal_abort";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_file_system_signal_abort(
+	     mount_handle->file_system,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to signal file system to abort.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the key
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_key(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function   = "mount_handle_set_key";
+	size_t string_length    = 0;
+	uint32_t base16_variant = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string[ 0 ] == (system_character_t) '@' )
+	{
+		if( string_length < 2 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: missing master key cache filename.",
+			 function );
+
+			return( -1 );
+		}
+		mount_handle->master_key_cache_filename        = &( string[ 1 ] );
+		mount_handle->master_key_cache_filename_length = string_length - 1;
+
+		return( 1 );
+	}
+	if( memory_set(
+	     mount_handle->key_data,
+	     0,
+	     64 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key data.",
+		 function );
+
+		goto on_error;
+	}
+	base16_variant = LIBUNA_BASE16_VARIANT_RFC4648;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( _BYTE_STREAM_HOST_IS_ENDIAN_BIG )
+	{
+		base16_variant |= LIBUNA_BASE16_VARIANT_ENCODING_UTF16_BIG_ENDIAN;
+	}
+	else
+	{
+		base16_variant |= LIBUNA_BASE16_VARIANT_ENCODING_UTF16_LITTLE_ENDIAN;
+	}
+#endif
+	if( ( string_length != 32 )
+	 && ( string_length != 64 )
+	 && ( string_length != 128 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported string length.",
+		 function );
+
+		goto on_error;
+	}
+	if( libuna_base16_stream_copy_to_byte_stream(
+	     (uint8_t *) string,
+	     string_length,
+	     mount_handle->key_data,
+	     string_length / 2,
+	     base16_variant,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy key data.",
+		 function );
+
+		goto on_error;
+	}
+	mount_handle->key_data_size = string_length / 2;
+
+	return( 1 );
+
+on_error:
+	memory_set(
+	 mount_handle->key_data,
+	 0,
+	 64 );
+
+	mount_handle->key_data_size = 0;
+
+	return( -1 );
+}
+
+/* Reads the master key cache data from file
+ * On POSIX platforms a file that is accessible by group or others is ignored
+ * Returns 1 if successful, 0 if the file does not exist or cannot be read or -1 on error
+ */
+int mount_handle_read_master_key_cache_file(
+     mount_handle_t *mount_handle,
+     uint8_t *master_key_cache_data,
+     size_t master_key_cache_data_size,
+     libcerror_error_t **error )
+{
+#if defined( MOUNT_HANDLE_HAVE_POSIX_FILE_MODE )
+	struct stat file_statistics;
+
+	int file_descriptor              = -1;
+#else
+	libbfio_handle_t *file_io_handle = NULL;
+#endif
+	static char *function            = "mount_handle_read_master_key_cache_file";
+	ssize_t read_count               = 0;
+	int result                       = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle->master_key_cache_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid mount handle - missing master key cache filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( master_key_cache_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid master key cache data.",
+		 function );
+
+		return( -1 );
+	}
+	if( master_key_cache_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid master key cache data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( MOUNT_HANDLE_HAVE_POSIX_FILE_MODE )
+	file_descriptor = open(
+	                   mount_handle->master_key_cache_filename,
+	                   O_RDONLY );
+
+	if( file_descriptor == -1 )
+	{
+		/* A master key cache file that does not exist or cannot be opened
+		 * is handled as a master key cache that does not match the volume
+		 */
+		return( 0 );
+	}
+	if( fstat(
+	     file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to retrieve master key cache file statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( !S_ISREG( file_statistics.st_mode ) )
+	{
+		fprintf(
+		 mount_handle->notify_stream,
+		 "Master key cache is not a regular file and is ignored.\n" );
+	}
+	else if( ( file_statistics.st_mode & ( S_IRWXG | S_IRWXO ) ) != 0 )
+	{
+		fprintf(
+		 mount_handle->notify_stream,
+		 "Master key cache file is accessible by group or others and is ignored.\n" );
+	}
+	else
+	{
+		read_count = read(
+		              file_descriptor,
+		              master_key_cache_data,
+		              master_key_cache_data_size );
+
+		if( read_count == (ssize_t) master_key_cache_data_size )
+		{
+			result = 1;
+		}
+	}
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		file_descriptor = -1;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close master key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	return( -1 );
+#else
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     mount_handle->master_key_cache_filename,
+	     mount_handle->master_key_cache_filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     mount_handle->master_key_cache_filename,
+	     mount_handle->master_key_cache_filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		goto on_error;
+	}
+	/* A master key cache file that does not exist or cannot be read
+	 * is handled as a master key cache that does not match the volume
+	 */
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     NULL ) == 1 )
+	{
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              master_key_cache_data,
+		              master_key_cache_data_size,
+		              NULL );
+
+		if( read_count == (ssize_t) master_key_cache_data_size )
+		{
+			result = 1;
+		}
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close master key cache file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+#endif /* defined( MOUNT_HANDLE_HAVE_POSIX_FILE_MODE ) */
+}
+
+/* Reads the master key cache from file into the volume
+ * A master key cache that cannot be read or is not valid is ignored
+ * Returns 1 if successful, 0 if the master key cache was not read or -1 on error
+ */
+int mount_handle_read_master_key_cache(
+     mount_handle_t *mount_handle,
+     libluksde_volume_t *luksde_volume,
+     libcerror_error_t **error )
+{
+	uint8_t master_key_cache_data[ LIBLUKSDE_MASTER_KEY_CACHE_SIZE ];
+
+	static char *function = "mount_handle_read_master_key_cache";
+	int result            = 0;
+
+	result = mount_handle_read_master_key_cache_file(
+	          mount_handle,
+	          master_key_cache_data,
+	          LIBLUKSDE_MASTER_KEY_CACHE_SIZE,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read master key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		/* A master key cache with a checksum or signature mismatch
+		 * is handled as a master key cache that does not match the volume
+		 */
+		if( libluksde_volume_set_master_key_cache(
+		     luksde_volume,
+		     master_key_cache_data,
+		     LIBLUKSDE_MASTER_KEY_CACHE_SIZE,
+		     NULL ) != 1 )
+		{
+			result = 0;
+		}
+	}
+	memory_set(
+	 master_key_cache_data,
+	 0,
+	 LIBLUKSDE_MASTER_KEY_CACHE_SIZE );
+
+	return( result );
+
+on_error:
+	memory_set(
+	 master_key_cache_data,
+	 0,
+	 LIBLUKSDE_MASTER_KEY_CACHE_SIZE );
+
+	return( -1 );
+}
+
+/* Writes the master key cache data to file
+ * On POSIX platforms the file is only accessible by the owner
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_write_master_key_cache_file(
+     mount_handle_t *mount_handle,
+     const uint8_t *master_key_cache_data,
+     size_t master_key_cache_data_size,
+     libcerror_error_t **error )
+{
+#if defined( MOUNT_HANDLE_HAVE_POSIX_FILE_MODE )
+	int file_descriptor              = -1;
+	int open_flags                   = 0;
+#else
+	libbfio_handle_t *file_io_handle = NULL;
+#endif
+	static char *function            = "mount_handle_write_master_key_cache_file";
+	ssize_t write_count              = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle->master_key_cache_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid mount handle - missing master key cache filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( master_key_cache_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid master key cache data.",
+		 function );
+
+		return( -1 );
+	}
+	if( master_key_cache_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid master key cache data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( MOUNT_HANDLE_HAVE_POSIX_FILE_MODE )
+	open_flags = O_WRONLY | O_CREAT | O_TRUNC;
+
+#if defined( O_NOFOLLOW )
+	open_flags |= O_NOFOLLOW;
+#endif
+	/* The master key cache contains the master key hence the file is created
+	 * only accessible by the owner and the mode of an existing file is changed
+	 * before the master key is written
+	 */
+	file_descriptor = open(
+	                   mount_handle->master_key_cache_filename,
+	                   open_flags,
+	                   S_IRUSR | S_IWUSR );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open master key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	if( fchmod(
+	     file_descriptor,
+	     S_IRUSR | S_IWUSR ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to change master key cache file mode.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = write(
+	               file_descriptor,
+	               master_key_cache_data,
+	               master_key_cache_data_size );
+
+	if( write_count != (ssize_t) master_key_cache_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write master key cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		file_descriptor = -1;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close master key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	return( -1 );
+#else
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     mount_handle->master_key_cache_filename,
+	     mount_handle->master_key_cache_filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     mount_handle->master_key_cache_filename,
+	     mount_handle->master_key_cache_filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open master key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               master_key_cache_data,
+	               master_key_cache_data_size,
+	               error );
+
+	if( write_count != (ssize_t) master_key_cache_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write master key cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close master key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+#endif /* defined( MOUNT_HANDLE_HAVE_POSIX_FILE_MODE ) */
+}
+
+/* Writes the master key cache of an unlocked volume to file
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_write_master_key_cache(
+     mount_handle_t *mount_handle,
+     libluksde_volume_t *luksde_volume,
+     libcerror_error_t **error )
+{
+	uint8_t master_key_cache_data[ LIBLUKSDE_MASTER_KEY_CACHE_SIZE ];
+
+	static char *function = "mount_handle_write_master_key_cache";
+
+	if( libluksde_volume_get_master_key_cache(
+	     luksde_volume,
+	     master_key_cache_data,
+	     LIBLUKSDE_MASTER_KEY_CACHE_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve master key cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( mount_handle_write_master_key_cache_file(
+	     mount_handle,
+	     master_key_cache_data,
+	     LIBLUKSDE_MASTER_KEY_CACHE_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write master key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	memory_set(
+	 master_key_cache_data,
+	 0,
+	 LIBLUKSDE_MASTER_KEY_CACHE_SIZE );
+
+	return( 1 );
+
+on_error:
+	memory_set(
+	 master_key_cache_data,
+	 0,
+	 LIBLUKSDE_MASTER_KEY_CACHE_SIZE );
+
+	return( -1 );
+}
+
+/* Sets the detached header
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_header(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_header";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	mount_handle->header_filename = string;
+
+	return( 1 );
+}
+
+/* Sets the keyfile
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_keyfile(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_keyfile";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
 
-		*mount_handle = NULL;
+		return( -1 );
 	}
-	return( result );
+	mount_handle->keyfile_filename = string;
+
+	return( 1 );
 }
 
-/* Signals the mount handle to abort
+/* Sets the keyfile offset
  * Returns 1 if successful or -1 on error
  */
-int mount_handle_signal_abort(
+int mount_handle_set_keyfile_offset(
      mount_handle_t *mount_handle,
+     const system_character_t *string,
      libcerror_error_t **error )
 {
-	static char *function = "mount_handle_signal_abort";
+	static char *function = "mount_handle_set_keyfile_offset";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
 
 	if( mount_handle == NULL )
 	{
@@ -343,33 +1196,51 @@ int mount_handle_signal_abort(
 
 		return( -1 );
 	}
-	if( mount_file_system_signal_abort(
-	     mount_handle->file_system,
+	string_length = system_string_length(
+	                 string );
+
+	if( mount_handle_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to signal file system to abort.",
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid keyfile offset value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
+	mount_handle->keyfile_offset = (off64_t) value_64bit;
+
 	return( 1 );
 }
 
-/* Sets the key
+/* Sets the keyfile size
  * Returns 1 if successful or -1 on error
  */
-int mount_handle_set_key(
+int mount_handle_set_keyfile_size(
      mount_handle_t *mount_handle,
      const system_character_t *string,
      libcerror_error_t **error )
 {
-	static char *function   = "mount_handle_set_key";
-	size_t string_length    = 0;
-	uint32_t base16_variant = 0;
+	static char *function = "mount_handle_set_keyfile_size";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
 
 	if( mount_handle == NULL )
 	{
@@ -385,76 +1256,81 @@ int mount_handle_set_key(
 	string_length = system_string_length(
 	                 string );
 
-	if( memory_set(
-	     mount_handle->key_data,
-	     0,
-	     64 ) == NULL )
+	if( mount_handle_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear key data.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	base16_variant = LIBUNA_BASE16_VARIANT_RFC4648;
+	mount_handle->keyfile_size = (size64_t) value_64bit;
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( _BYTE_STREAM_HOST_IS_ENDIAN_BIG )
-	{
-		base16_variant |= LIBUNA_BASE16_VARIANT_ENCODING_UTF16_BIG_ENDIAN;
-	}
-	else
-	{
-		base16_variant |= LIBUNA_BASE16_VARIANT_ENCODING_UTF16_LITTLE_ENDIAN;
-	}
-#endif
-	if( ( string_length != 32 )
-	 && ( string_length != 64 )
-	 && ( string_length != 128 ) )
+	return( 1 );
+}
+
+/* Sets the token identifier
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_token_identifier(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_token_identifier";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( mount_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported string length.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libuna_base16_stream_copy_to_byte_stream(
-	     (uint8_t *) string,
-	     string_length,
-	     mount_handle->key_data,
-	     string_length / 2,
-	     base16_variant,
-	     0,
+	string_length = system_string_length(
+	                 string );
+
+	if( mount_handle_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
-		 "%s: unable to copy key data.",
+		 "%s: unable to copy string to 64-bit decimal.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	mount_handle->key_data_size = string_length / 2;
-
-	return( 1 );
-
-on_error:
-	memory_set(
-	 mount_handle->key_data,
-	 0,
-	 64 );
+	if( value_64bit >= 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid token identifier value out of bounds.",
+		 function );
 
-	mount_handle->key_data_size = 0;
+		return( -1 );
+	}
+	mount_handle->token_identifier = (int) value_64bit;
 
-	return( -1 );
+	return( 1 );
 }
 
 /* Sets the volume offset
@@ -595,12 +1471,14 @@ int mount_handle_open(
 {
 	system_character_t password[ 64 ];
 
-	libbfio_handle_t *file_io_handle  = NULL;
-	libluksde_volume_t *luksde_volume = NULL;
-	static char *function             = "mount_handle_open";
-	size_t filename_length            = 0;
-	size_t password_length            = 0;
-	int result                        = 0;
+	libbfio_handle_t *file_io_handle        = NULL;
+	libbfio_handle_t *header_file_io_handle = NULL;
+	libluksde_volume_t *luksde_volume       = NULL;
+	static char *function                   = "mount_handle_open";
+	size_t filename_length                  = 0;
+	size_t password_length                  = 0;
+	int master_key_cache_was_read           = 0;
+	int result                              = 0;
 
 	if( mount_handle == NULL )
 	{
@@ -678,6 +1556,48 @@ int mount_handle_open(
 
 		goto on_error;
 	}
+	if( mount_handle->header_filename != NULL )
+	{
+		if( libbfio_file_initialize(
+		     &header_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize header file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		filename_length = system_string_length(
+		                   mount_handle->header_filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libbfio_file_set_name_wide(
+		     header_file_io_handle,
+		     mount_handle->header_filename,
+		     filename_length,
+		     error ) != 1 )
+#else
+		if( libbfio_file_set_name(
+		     header_file_io_handle,
+		     mount_handle->header_filename,
+		     filename_length,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to set header file name.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libluksde_volume_initialize(
 	     &luksde_volume,
 	     error ) != 1 )
@@ -735,11 +1655,88 @@ int mount_handle_open(
 			goto on_error;
 		}
 	}
-	if( libluksde_volume_open_file_io_handle(
-	     luksde_volume,
-	     file_io_handle,
-	     LIBLUKSDE_OPEN_READ,
-	     error ) != 1 )
+	if( mount_handle->keyfile_filename != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libluksde_volume_set_keyfile_wide(
+		     luksde_volume,
+		     mount_handle->keyfile_filename,
+		     mount_handle->keyfile_offset,
+		     mount_handle->keyfile_size,
+		     error ) != 1 )
+#else
+		if( libluksde_volume_set_keyfile(
+		     luksde_volume,
+		     mount_handle->keyfile_filename,
+		     mount_handle->keyfile_offset,
+		     mount_handle->keyfile_size,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set keyfile.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( mount_handle->token_identifier >= 0 )
+	{
+		if( libluksde_volume_set_token_identifier(
+		     luksde_volume,
+		     mount_handle->token_identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set token identifier.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( mount_handle->master_key_cache_filename != NULL )
+	{
+		master_key_cache_was_read = mount_handle_read_master_key_cache(
+		                             mount_handle,
+		                             luksde_volume,
+		                             error );
+
+		if( master_key_cache_was_read == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read master key cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( header_file_io_handle != NULL )
+	{
+		result = libluksde_volume_open_file_io_handles(
+		          luksde_volume,
+		          header_file_io_handle,
+		          file_io_handle,
+		          LIBLUKSDE_OPEN_READ,
+		          error );
+	}
+	else
+	{
+		result = libluksde_volume_open_file_io_handle(
+		          luksde_volume,
+		          file_io_handle,
+		          LIBLUKSDE_OPEN_READ,
+		          error );
+	}
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -765,8 +1762,14 @@ int mount_handle_open(
 
 		goto on_error;
 	}
-	else if( ( result != 0 )
-	      && ( mount_handle->unattended_mode == 0 ) )
+	else if( result != 0 )
+	{
+		/* The master key cache does not match the volume
+		 */
+		master_key_cache_was_read = 0;
+	}
+	if( ( result != 0 )
+	 && ( mount_handle->unattended_mode == 0 ) )
 	{
 		fprintf(
 		 stdout,
@@ -856,6 +1859,24 @@ int mount_handle_open(
 
 		goto on_error;
 	}
+	if( ( mount_handle->master_key_cache_filename != NULL )
+	 && ( master_key_cache_was_read == 0 ) )
+	{
+		if( mount_handle_write_master_key_cache(
+		     mount_handle,
+		     luksde_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write master key cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( mount_file_system_append_volume(
 	     mount_handle->file_system,
 	     luksde_volume,
@@ -870,7 +1891,8 @@ int mount_handle_open(
 
 		goto on_error;
 	}
-	mount_handle->file_io_handle = file_io_handle;
+	mount_handle->file_io_handle        = file_io_handle;
+	mount_handle->header_file_io_handle = header_file_io_handle;
 
 	return( 1 );
 
@@ -881,6 +1903,12 @@ on_error:
 		 &luksde_volume,
 		 NULL );
 	}
+	if( header_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &header_file_io_handle,
+		 NULL );
+	}
 	if( file_io_handle != NULL )
 	{
 		libbfio_handle_free(
@@ -1009,6 +2037,22 @@ int mount_handle_close(
 
 		goto on_error;
 	}
+	if( mount_handle->header_file_io_handle != NULL )
+	{
+		if( libbfio_handle_free(
+		     &( mount_handle->header_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free header file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 0 );
 
 on_error:
@@ -52,6 +52,14 @@ struct mount_handle
 	 */
 	uint8_t key_data_size;
 
+	/* The master key cache filename
+	 */
+	const system_character_t *master_key_cache_filename;
+
+	/* The master key cache filename length
+	 */
+	size_t master_key_cache_filename_length;
+
 	/* The volume offset
 	 */
 	off64_t volume_offset;
@@ -64,10 +72,34 @@ struct mount_handle
 	 */
 	size_t password_length;
 
+	/* The keyfile filename
+	 */
+	const system_character_t *keyfile_filename;
+
+	/* The keyfile offset
+	 */
+	off64_t keyfile_offset;
+
+	/* The keyfile size
+	 */
+	size64_t keyfile_size;
+
+	/* The token identifier
+	 */
+	int token_identifier;
+
+	/* The detached header filename
+	 */
+	const system_character_t *header_filename;
+
 	/* The libbfio file IO handle
 	 */
 	libbfio_handle_t *file_io_handle;
 
+	/* The libbfio detached header file IO handle
+	 */
+	libbfio_handle_t *header_file_io_handle;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -101,6 +133,53 @@ int mount_handle_set_key(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int mount_handle_read_master_key_cache_file(
+     mount_handle_t *mount_handle,
+     uint8_t *master_key_cache_data,
+     size_t master_key_cache_data_size,
+     libcerror_error_t **error );
+
+int mount_handle_read_master_key_cache(
+     mount_handle_t *mount_handle,
+     libluksde_volume_t *luksde_volume,
+     libcerror_error_t **error );
+
+int mount_handle_write_master_key_cache_file(
+     mount_handle_t *mount_handle,
+     const uint8_t *master_key_cache_data,
+     size_t master_key_cache_data_size,
+     libcerror_error_t **error );
+
+int mount_handle_write_master_key_cache(
+     mount_handle_t *mount_handle,
+     libluksde_volume_t *luksde_volume,
+     libcerror_error_t **error );
+
+int mount_handle_set_header(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int mount_handle_set_keyfile(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int mount_handle_set_keyfile_offset(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int mount_handle_set_keyfile_size(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int mount_handle_set_token_identifier(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int mount_handle_set_offset(
      mount_handle_t *mount_handle,
      const system_character_t *string,
@@ -0,0 +1,1680 @@
+/*
+ * Library allocation_map type test program
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_memory.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_allocation_map.h"
+
+/* SEEK_DATA and SEEK_HOLE are expected to be supported on Linux
+ */
+#if defined( __linux__ ) && defined( HAVE_FCNTL_H ) && defined( HAVE_UNISTD_H )
+#define LUKSDE_TEST_ALLOCATION_MAP_HAVE_SPARSE_FILE	1
+#endif
+
+#define LUKSDE_TEST_ALLOCATION_MAP_SPARSE_FILE		"luksde_test_allocation_map.bin"
+
+#define LUKSDE_TEST_ALLOCATION_MAP_DATA_SIZE		65536
+#define LUKSDE_TEST_ALLOCATION_MAP_HOLE_END_OFFSET	1048576
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+#if defined( LUKSDE_TEST_ALLOCATION_MAP_HAVE_SPARSE_FILE )
+
+/* Creates a sparse test file
+ * The file contains data, followed by a hole created by extending the file
+ * and data again
+ * Returns a file descriptor if successful or -1 on error
+ */
+int luksde_test_allocation_map_create_sparse_file(
+     const char *filename )
+{
+	uint8_t data[ 4096 ];
+
+	size_t data_offset  = 0;
+	int file_descriptor = -1;
+
+	if( memory_set(
+	     data,
+	     0x5a,
+	     4096 ) == NULL )
+	{
+		return( -1 );
+	}
+
+	unlink(
+	 filename );
+
+	file_descriptor = open(
+	                   filename,
+	                   O_RDWR | O_CREAT | O_TRUNC,
+	                   0600 );
+
+	if( file_descriptor == -1 )
+	{
+		return( -1 );
+	}
+	for( data_offset = 0;
+	     data_offset < LUKSDE_TEST_ALLOCATION_MAP_DATA_SIZE;
+	     data_offset += 4096 )
+	{
+		if( write(
+		     file_descriptor,
+		     data,
+		     4096 ) != 4096 )
+		{
+			goto on_error;
+		}
+	}
+	if( ftruncate(
+	     file_descriptor,
+	     (off_t) LUKSDE_TEST_ALLOCATION_MAP_HOLE_END_OFFSET ) != 0 )
+	{
+		goto on_error;
+	}
+	if( lseek(
+	     file_descriptor,
+	     (off_t) LUKSDE_TEST_ALLOCATION_MAP_HOLE_END_OFFSET,
+	     SEEK_SET ) != (off_t) LUKSDE_TEST_ALLOCATION_MAP_HOLE_END_OFFSET )
+	{
+		goto on_error;
+	}
+	for( data_offset = 0;
+	     data_offset < LUKSDE_TEST_ALLOCATION_MAP_DATA_SIZE;
+	     data_offset += 4096 )
+	{
+		if( write(
+		     file_descriptor,
+		     data,
+		     4096 ) != 4096 )
+		{
+			goto on_error;
+		}
+	}
+	return( file_descriptor );
+
+on_error:
+	close(
+	 file_descriptor );
+
+	unlink(
+	 filename );
+
+	return( -1 );
+}
+
+#endif /* defined( LUKSDE_TEST_ALLOCATION_MAP_HAVE_SPARSE_FILE ) */
+
+/* Tests the libluksde_allocation_map_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_allocation_map_initialize(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libluksde_allocation_map_t *allocation_map = NULL;
+	int result                                 = 0;
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests            = 2;
+	int number_of_memset_fail_tests            = 1;
+	int test_number                            = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libluksde_allocation_map_initialize(
+	          &allocation_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_map",
+	 allocation_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_allocation_map_free(
+	          &allocation_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "allocation_map",
+	 allocation_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_allocation_map_initialize(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	allocation_map = (libluksde_allocation_map_t *) 0x12345678UL;
+
+	result = libluksde_allocation_map_initialize(
+	          &allocation_map,
+	          &error );
+
+	allocation_map = NULL;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_allocation_map_initialize with malloc failing
+		 */
+		luksde_test_malloc_attempts_before_fail = test_number;
+
+		result = libluksde_allocation_map_initialize(
+		          &allocation_map,
+		          &error );
+
+		if( luksde_test_malloc_attempts_before_fail != -1 )
+		{
+			luksde_test_malloc_attempts_before_fail = -1;
+
+			if( allocation_map != NULL )
+			{
+				libluksde_allocation_map_free(
+				 &allocation_map,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "allocation_map",
+			 allocation_map );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_allocation_map_initialize with memset failing
+		 */
+		luksde_test_memset_attempts_before_fail = test_number;
+
+		result = libluksde_allocation_map_initialize(
+		          &allocation_map,
+		          &error );
+
+		if( luksde_test_memset_attempts_before_fail != -1 )
+		{
+			luksde_test_memset_attempts_before_fail = -1;
+
+			if( allocation_map != NULL )
+			{
+				libluksde_allocation_map_free(
+				 &allocation_map,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "allocation_map",
+			 allocation_map );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_LUKSDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_map != NULL )
+	{
+		libluksde_allocation_map_free(
+		 &allocation_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_allocation_map_free function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_allocation_map_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libluksde_allocation_map_free(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_allocation_map_append_range function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_allocation_map_append_range(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libluksde_allocation_map_t *allocation_map = NULL;
+	size64_t size                              = 0;
+	off64_t offset                             = 0;
+	int number_of_ranges                       = 0;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_allocation_map_initialize(
+	          &allocation_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_map",
+	 allocation_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_allocation_map_append_range(
+	          allocation_map,
+	          4096,
+	          8192,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a range that directly follows the last range
+	 */
+	result = libluksde_allocation_map_append_range(
+	          allocation_map,
+	          12288,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a range that overlaps with the last range
+	 */
+	result = libluksde_allocation_map_append_range(
+	          allocation_map,
+	          15872,
+	          1024,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test an empty range
+	 */
+	result = libluksde_allocation_map_append_range(
+	          allocation_map,
+	          65536,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_allocation_map_append_range(
+	          allocation_map,
+	          65536,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_allocation_map_get_number_of_ranges(
+	          allocation_map,
+	          &number_of_ranges,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_ranges",
+	 number_of_ranges,
+	 2 );
+
+	result = libluksde_allocation_map_get_range_by_index(
+	          allocation_map,
+	          0,
+	          &offset,
+	          &size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 4096 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 (uint64_t) size,
+	 (uint64_t) 12800 );
+
+	/* Test error cases
+	 */
+	result = libluksde_allocation_map_append_range(
+	          NULL,
+	          131072,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_allocation_map_append_range(
+	          allocation_map,
+	          -1,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a range that starts before the last range
+	 */
+	result = libluksde_allocation_map_append_range(
+	          allocation_map,
+	          32768,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_allocation_map_free(
+	          &allocation_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "allocation_map",
+	 allocation_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_map != NULL )
+	{
+		libluksde_allocation_map_free(
+		 &allocation_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_allocation_map_read_file_descriptor function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_allocation_map_read_file_descriptor(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libluksde_allocation_map_t *allocation_map = NULL;
+	int result                                 = 0;
+
+#if defined( LUKSDE_TEST_ALLOCATION_MAP_HAVE_SPARSE_FILE )
+	size64_t data_size                         = 0;
+	size64_t size                              = 0;
+	off64_t data_offset                        = 0;
+	off64_t offset                             = 0;
+	int file_descriptor                        = -1;
+	int number_of_ranges                       = 0;
+#endif
+
+	/* Initialize test
+	 */
+	result = libluksde_allocation_map_initialize(
+	          &allocation_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_map",
+	 allocation_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( LUKSDE_TEST_ALLOCATION_MAP_HAVE_SPARSE_FILE )
+
+	file_descriptor = luksde_test_allocation_map_create_sparse_file(
+	                   LUKSDE_TEST_ALLOCATION_MAP_SPARSE_FILE );
+
+	LUKSDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "file_descriptor",
+	 file_descriptor,
+	 -1 );
+
+	/* Test regular cases
+	 */
+	result = libluksde_allocation_map_read_file_descriptor(
+	          allocation_map,
+	          file_descriptor,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_allocation_map_get_number_of_ranges(
+	          allocation_map,
+	          &number_of_ranges,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_ranges",
+	 number_of_ranges,
+	 2 );
+
+	result = libluksde_allocation_map_get_range_by_index(
+	          allocation_map,
+	          0,
+	          &data_offset,
+	          &data_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "data_offset",
+	 (int64_t) data_offset,
+	 (int64_t) 0 );
+
+	result = libluksde_allocation_map_get_range_by_index(
+	          allocation_map,
+	          1,
+	          &offset,
+	          &size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The file system can allocate more than the data that was written
+	 * but the range that was extended must be a hole
+	 */
+	LUKSDE_TEST_ASSERT_LESS_THAN_UINT64(
+	 "hole_offset",
+	 (uint64_t) ( data_offset + data_size ),
+	 (uint64_t) offset );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "end_offset",
+	 (uint64_t) ( offset + size ),
+	 (uint64_t) ( LUKSDE_TEST_ALLOCATION_MAP_HOLE_END_OFFSET + LUKSDE_TEST_ALLOCATION_MAP_DATA_SIZE ) );
+
+	/* Test error cases
+	 */
+	result = libluksde_allocation_map_read_file_descriptor(
+	          allocation_map,
+	          file_descriptor,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	close(
+	 file_descriptor );
+
+	file_descriptor = -1;
+
+	unlink(
+	 LUKSDE_TEST_ALLOCATION_MAP_SPARSE_FILE );
+
+#endif /* defined( LUKSDE_TEST_ALLOCATION_MAP_HAVE_SPARSE_FILE ) */
+
+	/* Test error cases
+	 */
+	result = libluksde_allocation_map_read_file_descriptor(
+	          NULL,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_allocation_map_read_file_descriptor(
+	          allocation_map,
+	          -1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_allocation_map_free(
+	          &allocation_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "allocation_map",
+	 allocation_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+#if defined( LUKSDE_TEST_ALLOCATION_MAP_HAVE_SPARSE_FILE )
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+
+		unlink(
+		 LUKSDE_TEST_ALLOCATION_MAP_SPARSE_FILE );
+	}
+#endif
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_map != NULL )
+	{
+		libluksde_allocation_map_free(
+		 &allocation_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_allocation_map_read_file_by_name function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_allocation_map_read_file_by_name(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libluksde_allocation_map_t *allocation_map = NULL;
+	int result                                 = 0;
+
+#if defined( LUKSDE_TEST_ALLOCATION_MAP_HAVE_SPARSE_FILE )
+	int file_descriptor                        = -1;
+	int number_of_ranges                       = 0;
+#endif
+
+	/* Initialize test
+	 */
+	result = libluksde_allocation_map_initialize(
+	          &allocation_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_map",
+	 allocation_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( LUKSDE_TEST_ALLOCATION_MAP_HAVE_SPARSE_FILE )
+
+	/* Test regular cases
+	 */
+	file_descriptor = luksde_test_allocation_map_create_sparse_file(
+	                   LUKSDE_TEST_ALLOCATION_MAP_SPARSE_FILE );
+
+	LUKSDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "file_descriptor",
+	 file_descriptor,
+	 -1 );
+
+	close(
+	 file_descriptor );
+
+	file_descriptor = -1;
+
+	result = libluksde_allocation_map_read_file_by_name(
+	          allocation_map,
+	          LUKSDE_TEST_ALLOCATION_MAP_SPARSE_FILE,
+	          &error );
+
+	unlink(
+	 LUKSDE_TEST_ALLOCATION_MAP_SPARSE_FILE );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_allocation_map_get_number_of_ranges(
+	          allocation_map,
+	          &number_of_ranges,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_ranges",
+	 number_of_ranges,
+	 2 );
+
+#endif /* defined( LUKSDE_TEST_ALLOCATION_MAP_HAVE_SPARSE_FILE ) */
+
+	/* Test error cases
+	 */
+	result = libluksde_allocation_map_read_file_by_name(
+	          NULL,
+	          ".",
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_allocation_map_read_file_by_name(
+	          allocation_map,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_allocation_map_free(
+	          &allocation_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "allocation_map",
+	 allocation_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_map != NULL )
+	{
+		libluksde_allocation_map_free(
+		 &allocation_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_allocation_map_get_number_of_ranges function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_allocation_map_get_number_of_ranges(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libluksde_allocation_map_t *allocation_map = NULL;
+	int number_of_ranges                       = 0;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_allocation_map_initialize(
+	          &allocation_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_map",
+	 allocation_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_allocation_map_get_number_of_ranges(
+	          allocation_map,
+	          &number_of_ranges,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_ranges",
+	 number_of_ranges,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libluksde_allocation_map_get_number_of_ranges(
+	          NULL,
+	          &number_of_ranges,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_allocation_map_free(
+	          &allocation_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "allocation_map",
+	 allocation_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_map != NULL )
+	{
+		libluksde_allocation_map_free(
+		 &allocation_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_allocation_map_get_range_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_allocation_map_get_range_by_index(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libluksde_allocation_map_t *allocation_map = NULL;
+	size64_t size                              = 0;
+	off64_t offset                             = 0;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_allocation_map_initialize(
+	          &allocation_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_map",
+	 allocation_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_allocation_map_append_range(
+	          allocation_map,
+	          4096,
+	          8192,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_allocation_map_append_range(
+	          allocation_map,
+	          65536,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_allocation_map_get_range_by_index(
+	          allocation_map,
+	          1,
+	          &offset,
+	          &size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 65536 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 (uint64_t) size,
+	 (uint64_t) 4096 );
+
+	/* Test error cases
+	 */
+	result = libluksde_allocation_map_get_range_by_index(
+	          NULL,
+	          0,
+	          &offset,
+	          &size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_allocation_map_get_range_by_index(
+	          allocation_map,
+	          2,
+	          &offset,
+	          &size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_allocation_map_get_range_by_index(
+	          allocation_map,
+	          0,
+	          NULL,
+	          &size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_allocation_map_get_range_by_index(
+	          allocation_map,
+	          0,
+	          &offset,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_allocation_map_free(
+	          &allocation_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "allocation_map",
+	 allocation_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_map != NULL )
+	{
+		libluksde_allocation_map_free(
+		 &allocation_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_allocation_map_get_extent_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_allocation_map_get_extent_at_offset(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libluksde_allocation_map_t *allocation_map = NULL;
+	size64_t extent_size                       = 0;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_allocation_map_initialize(
+	          &allocation_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_map",
+	 allocation_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_allocation_map_append_range(
+	          allocation_map,
+	          4096,
+	          8192,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_allocation_map_append_range(
+	          allocation_map,
+	          65536,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_allocation_map_get_extent_at_offset(
+	          allocation_map,
+	          0,
+	          &extent_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 (uint64_t) extent_size,
+	 (uint64_t) 4096 );
+
+	result = libluksde_allocation_map_get_extent_at_offset(
+	          allocation_map,
+	          4096,
+	          &extent_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 (uint64_t) extent_size,
+	 (uint64_t) 8192 );
+
+	result = libluksde_allocation_map_get_extent_at_offset(
+	          allocation_map,
+	          8192,
+	          &extent_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 (uint64_t) extent_size,
+	 (uint64_t) 4096 );
+
+	result = libluksde_allocation_map_get_extent_at_offset(
+	          allocation_map,
+	          12288,
+	          &extent_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 (uint64_t) extent_size,
+	 (uint64_t) 53248 );
+
+	result = libluksde_allocation_map_get_extent_at_offset(
+	          allocation_map,
+	          69631,
+	          &extent_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_size",
+	 (uint64_t) extent_size,
+	 (uint64_t) 1 );
+
+	/* Test an offset after the last range
+	 */
+	result = libluksde_allocation_map_get_extent_at_offset(
+	          allocation_map,
+	          69632,
+	          &extent_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_allocation_map_get_extent_at_offset(
+	          NULL,
+	          0,
+	          &extent_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_allocation_map_get_extent_at_offset(
+	          allocation_map,
+	          -1,
+	          &extent_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_allocation_map_get_extent_at_offset(
+	          allocation_map,
+	          0,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_allocation_map_free(
+	          &allocation_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "allocation_map",
+	 allocation_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_map != NULL )
+	{
+		libluksde_allocation_map_free(
+		 &allocation_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_allocation_map_initialize",
+	 luksde_test_allocation_map_initialize );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_allocation_map_free",
+	 luksde_test_allocation_map_free );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_allocation_map_append_range",
+	 luksde_test_allocation_map_append_range );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_allocation_map_read_file_descriptor",
+	 luksde_test_allocation_map_read_file_descriptor );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_allocation_map_read_file_by_name",
+	 luksde_test_allocation_map_read_file_by_name );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_allocation_map_get_number_of_ranges",
+	 luksde_test_allocation_map_get_number_of_ranges );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_allocation_map_get_range_by_index",
+	 luksde_test_allocation_map_get_range_by_index );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_allocation_map_get_extent_at_offset",
+	 luksde_test_allocation_map_get_extent_at_offset );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+}
+
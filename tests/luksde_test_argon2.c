@@ -0,0 +1,682 @@
+/*
+ * Library Argon2 functions test program
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_libcerror.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_argon2.h"
+#include "../libluksde/libluksde_definitions.h"
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* Tests the libluksde_argon2_calculate_variable_length_hash function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_argon2_calculate_variable_length_hash(
+     void )
+{
+	uint8_t hash[ 80 ];
+
+	/* H' of "abc" with a hash size of 80, which is larger than a single BLAKE2b hash
+	 */
+	uint8_t expected_hash[ 80 ] = {
+		0x5d, 0x68, 0xeb, 0x82, 0xd6, 0x54, 0x07, 0x9a, 0xcb, 0x31, 0x9d, 0x90, 0x2b, 0x8d, 0x61, 0x71,
+		0xde, 0xea, 0x7b, 0x9b, 0x50, 0x70, 0xc8, 0xec, 0x78, 0x69, 0x6e, 0x85, 0xcd, 0x53, 0x74, 0x4e,
+		0x3a, 0x0e, 0x09, 0x42, 0x00, 0x76, 0x73, 0x07, 0x47, 0x42, 0x75, 0xff, 0x18, 0x70, 0xfc, 0xd6,
+		0xd8, 0xdc, 0xa4, 0xf6, 0x8a, 0xbe, 0x1f, 0x0b, 0xe2, 0x70, 0xe8, 0x86, 0x18, 0xb3, 0xe0, 0xfe,
+		0xf8, 0x72, 0x1f, 0xf6, 0xb0, 0xea, 0x05, 0xaa, 0x77, 0x69, 0x57, 0x6e, 0xb6, 0xec, 0xcf, 0xc1 };
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libluksde_argon2_calculate_variable_length_hash(
+	          (uint8_t *) "abc",
+	          3,
+	          hash,
+	          80,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          hash,
+	          expected_hash,
+	          80 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libluksde_argon2_calculate_variable_length_hash(
+	          NULL,
+	          3,
+	          hash,
+	          80,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_argon2_calculate_variable_length_hash(
+	          (uint8_t *) "abc",
+	          3,
+	          NULL,
+	          80,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_argon2_calculate_variable_length_hash(
+	          (uint8_t *) "abc",
+	          3,
+	          hash,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_argon2_derive_key function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_argon2_derive_key(
+     void )
+{
+	uint8_t associated_data[ 12 ];
+	uint8_t output_data[ 32 ];
+	uint8_t password[ 32 ];
+	uint8_t salt[ 16 ];
+	uint8_t secret[ 8 ];
+
+	/* RFC 9106 section 5.1 Argon2i test vector
+	 */
+	uint8_t expected_argon2i_output_data[ 32 ] = {
+		0xc8, 0x14, 0xd9, 0xd1, 0xdc, 0x7f, 0x37, 0xaa, 0x13, 0xf0, 0xd7, 0x7f, 0x24, 0x94, 0xbd, 0xa1,
+		0xc8, 0xde, 0x6b, 0x01, 0x6d, 0xd3, 0x88, 0xd2, 0x99, 0x52, 0xa4, 0xc4, 0x67, 0x2b, 0x6c, 0xe8 };
+
+	/* RFC 9106 section 5.3 Argon2id test vector
+	 */
+	uint8_t expected_argon2id_output_data[ 32 ] = {
+		0x0d, 0x64, 0x0d, 0xf5, 0x8d, 0x78, 0x76, 0x6c, 0x08, 0xc0, 0x37, 0xa3, 0x4a, 0x8b, 0x53, 0xc9,
+		0xd0, 0x1e, 0xf0, 0x45, 0x2d, 0x75, 0xb6, 0x5e, 0xb5, 0x25, 0x20, 0xe9, 0x6b, 0x01, 0xe6, 0x59 };
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	result = memory_set(
+	          password,
+	          0x01,
+	          32 ) != NULL;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = memory_set(
+	          salt,
+	          0x02,
+	          16 ) != NULL;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = memory_set(
+	          secret,
+	          0x03,
+	          8 ) != NULL;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = memory_set(
+	          associated_data,
+	          0x04,
+	          12 ) != NULL;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = libluksde_argon2_derive_key(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2I,
+	          password,
+	          32,
+	          NULL,
+	          salt,
+	          16,
+	          secret,
+	          8,
+	          associated_data,
+	          12,
+	          3,
+	          32,
+	          4,
+	          output_data,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          output_data,
+	          expected_argon2i_output_data,
+	          32 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libluksde_argon2_derive_key(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID,
+	          password,
+	          32,
+	          NULL,
+	          salt,
+	          16,
+	          secret,
+	          8,
+	          associated_data,
+	          12,
+	          3,
+	          32,
+	          4,
+	          output_data,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          output_data,
+	          expected_argon2id_output_data,
+	          32 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libluksde_argon2_derive_key(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_PBKDF2,
+	          password,
+	          32,
+	          NULL,
+	          salt,
+	          16,
+	          secret,
+	          8,
+	          associated_data,
+	          12,
+	          3,
+	          32,
+	          4,
+	          output_data,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_argon2_derive_key(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID,
+	          NULL,
+	          32,
+	          NULL,
+	          salt,
+	          16,
+	          secret,
+	          8,
+	          associated_data,
+	          12,
+	          3,
+	          32,
+	          4,
+	          output_data,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_argon2_derive_key(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID,
+	          password,
+	          32,
+	          NULL,
+	          NULL,
+	          16,
+	          secret,
+	          8,
+	          associated_data,
+	          12,
+	          3,
+	          32,
+	          4,
+	          output_data,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_argon2_derive_key(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID,
+	          password,
+	          32,
+	          NULL,
+	          salt,
+	          16,
+	          NULL,
+	          8,
+	          associated_data,
+	          12,
+	          3,
+	          32,
+	          4,
+	          output_data,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_argon2_derive_key(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID,
+	          password,
+	          32,
+	          NULL,
+	          salt,
+	          16,
+	          secret,
+	          8,
+	          NULL,
+	          12,
+	          3,
+	          32,
+	          4,
+	          output_data,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_argon2_derive_key(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID,
+	          password,
+	          32,
+	          NULL,
+	          salt,
+	          16,
+	          secret,
+	          8,
+	          associated_data,
+	          12,
+	          0,
+	          32,
+	          4,
+	          output_data,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_argon2_derive_key(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID,
+	          password,
+	          32,
+	          NULL,
+	          salt,
+	          16,
+	          secret,
+	          8,
+	          associated_data,
+	          12,
+	          3,
+	          32,
+	          0,
+	          output_data,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_argon2_derive_key(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID,
+	          password,
+	          32,
+	          NULL,
+	          salt,
+	          16,
+	          secret,
+	          8,
+	          associated_data,
+	          12,
+	          3,
+	          31,
+	          4,
+	          output_data,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_argon2_derive_key(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID,
+	          password,
+	          32,
+	          NULL,
+	          salt,
+	          16,
+	          secret,
+	          8,
+	          associated_data,
+	          12,
+	          3,
+	          LIBLUKSDE_ARGON2_MAXIMUM_MEMORY_COST + 1,
+	          4,
+	          output_data,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_argon2_derive_key(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID,
+	          password,
+	          32,
+	          NULL,
+	          salt,
+	          16,
+	          secret,
+	          8,
+	          associated_data,
+	          12,
+	          3,
+	          32,
+	          4,
+	          NULL,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_argon2_derive_key(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID,
+	          password,
+	          32,
+	          NULL,
+	          salt,
+	          16,
+	          secret,
+	          8,
+	          associated_data,
+	          12,
+	          3,
+	          32,
+	          4,
+	          output_data,
+	          3,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_argon2_calculate_variable_length_hash",
+	 luksde_test_argon2_calculate_variable_length_hash );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_argon2_derive_key",
+	 luksde_test_argon2_derive_key );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+}
+
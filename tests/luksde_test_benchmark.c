@@ -0,0 +1,554 @@
+/*
+ * Library benchmark functions test program
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_unused.h"
+
+/* Tests the libluksde_benchmark_pbkdf2 function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_benchmark_pbkdf2(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libluksde_benchmark_pbkdf2(
+	          LIBLUKSDE_HASHING_METHOD_SHA256,
+	          1000,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_benchmark_pbkdf2(
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          1000,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_benchmark_pbkdf2(
+	          LIBLUKSDE_HASHING_METHOD_SHA256,
+	          0,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_benchmark_pbkdf2(
+	          LIBLUKSDE_HASHING_METHOD_SHA256,
+	          1000,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_benchmark_pbkdf2(
+	          LIBLUKSDE_HASHING_METHOD_SHA256,
+	          1000,
+	          65,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_benchmark_argon2 function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_benchmark_argon2(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libluksde_benchmark_argon2(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID,
+	          1,
+	          64,
+	          1,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_benchmark_argon2(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2I,
+	          1,
+	          64,
+	          1,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_benchmark_argon2(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_PBKDF2,
+	          1,
+	          64,
+	          1,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_benchmark_argon2(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID,
+	          0,
+	          64,
+	          1,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_benchmark_argon2(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID,
+	          1,
+	          4,
+	          1,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_benchmark_argon2(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID,
+	          1,
+	          64,
+	          1,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_benchmark_argon2(
+	          LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_ARGON2ID,
+	          1,
+	          64,
+	          1,
+	          65,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_benchmark_diffuser_merge function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_benchmark_diffuser_merge(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libluksde_benchmark_diffuser_merge(
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          4000,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_benchmark_diffuser_merge(
+	          LIBLUKSDE_HASHING_METHOD_UNKNOWN,
+	          4000,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_benchmark_diffuser_merge(
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          0,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_benchmark_diffuser_merge(
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          4000,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_benchmark_decrypt function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_benchmark_decrypt(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libluksde_benchmark_decrypt(
+	          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          64,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_benchmark_decrypt(
+	          LIBLUKSDE_ENCRYPTION_METHOD_UNKNOWN,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          64,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_benchmark_decrypt(
+	          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          0,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_benchmark_decrypt(
+	          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          64,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_benchmark_decrypt(
+	          LIBLUKSDE_ENCRYPTION_METHOD_AES,
+	          LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS,
+	          LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64,
+	          64,
+	          1000,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_benchmark_pbkdf2",
+	 luksde_test_benchmark_pbkdf2 );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_benchmark_argon2",
+	 luksde_test_benchmark_argon2 );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_benchmark_diffuser_merge",
+	 luksde_test_benchmark_diffuser_merge );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_benchmark_decrypt",
+	 luksde_test_benchmark_decrypt );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
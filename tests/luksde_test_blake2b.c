@@ -0,0 +1,520 @@
+/*
+ * Library BLAKE2b functions test program
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_libcerror.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_blake2b.h"
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* Tests the libluksde_blake2b_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_blake2b_initialize(
+     void )
+{
+	libluksde_blake2b_context_t context;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libluksde_blake2b_initialize(
+	          &context,
+	          64,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_blake2b_initialize(
+	          NULL,
+	          64,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_blake2b_initialize(
+	          &context,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_blake2b_initialize(
+	          &context,
+	          65,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_blake2b_update and libluksde_blake2b_finalize functions
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_blake2b_update(
+     void )
+{
+	uint8_t data[ 300 ];
+	uint8_t hash[ 32 ];
+
+	/* BLAKE2b-256 of the bytes 0 - 255 followed by 0 - 43
+	 */
+	uint8_t expected_hash[ 32 ] = {
+		0x3a, 0x48, 0x6e, 0x3f, 0xe3, 0xee, 0x41, 0x48, 0x53, 0x00, 0x02, 0x69, 0xac, 0x02, 0x00, 0x30,
+		0xae, 0xef, 0x74, 0x8c, 0xb0, 0x5c, 0xd6, 0x2b, 0xa8, 0x59, 0x39, 0xec, 0x29, 0x8e, 0xf2, 0x5c };
+
+	libluksde_blake2b_context_t context;
+
+	libcerror_error_t *error = NULL;
+	size_t data_index        = 0;
+	int result               = 0;
+
+	for( data_index = 0;
+	     data_index < 300;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) ( data_index % 256 );
+	}
+	/* Test regular cases
+	 */
+	result = libluksde_blake2b_initialize(
+	          &context,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Update with sizes that do not align with the block size
+	 */
+	result = libluksde_blake2b_update(
+	          &context,
+	          data,
+	          100,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_blake2b_update(
+	          &context,
+	          &( data[ 100 ] ),
+	          156,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_blake2b_update(
+	          &context,
+	          &( data[ 256 ] ),
+	          44,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_blake2b_finalize(
+	          &context,
+	          hash,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          hash,
+	          expected_hash,
+	          32 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libluksde_blake2b_initialize(
+	          &context,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_blake2b_update(
+	          NULL,
+	          data,
+	          300,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_blake2b_update(
+	          &context,
+	          NULL,
+	          300,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_blake2b_update(
+	          &context,
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_blake2b_finalize(
+	          NULL,
+	          hash,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_blake2b_finalize(
+	          &context,
+	          NULL,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_blake2b_finalize(
+	          &context,
+	          hash,
+	          64,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_blake2b_calculate function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_blake2b_calculate(
+     void )
+{
+	uint8_t hash[ 64 ];
+
+	/* RFC 7693 appendix A BLAKE2b-512 of "abc"
+	 */
+	uint8_t expected_hash[ 64 ] = {
+		0xba, 0x80, 0xa5, 0x3f, 0x98, 0x1c, 0x4d, 0x0d, 0x6a, 0x27, 0x97, 0xb6, 0x9f, 0x12, 0xf6, 0xe9,
+		0x4c, 0x21, 0x2f, 0x14, 0x68, 0x5a, 0xc4, 0xb7, 0x4b, 0x12, 0xbb, 0x6f, 0xdb, 0xff, 0xa2, 0xd1,
+		0x7d, 0x87, 0xc5, 0x39, 0x2a, 0xab, 0x79, 0x2d, 0xc2, 0x52, 0xd5, 0xde, 0x45, 0x33, 0xcc, 0x95,
+		0x18, 0xd3, 0x8a, 0xa8, 0xdb, 0xf1, 0x92, 0x5a, 0xb9, 0x23, 0x86, 0xed, 0xd4, 0x00, 0x99, 0x23 };
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libluksde_blake2b_calculate(
+	          (uint8_t *) "abc",
+	          3,
+	          hash,
+	          64,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          hash,
+	          expected_hash,
+	          64 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libluksde_blake2b_calculate(
+	          (uint8_t *) "abc",
+	          3,
+	          NULL,
+	          64,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_blake2b_calculate(
+	          (uint8_t *) "abc",
+	          3,
+	          hash,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_blake2b_initialize",
+	 luksde_test_blake2b_initialize );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_blake2b_update",
+	 luksde_test_blake2b_update );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_blake2b_calculate",
+	 luksde_test_blake2b_calculate );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,458 @@
+/*
+ * Library block_device functions test program
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_getopt.h"
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_block_device.h"
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* Tests the libluksde_block_device_get_io_values function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_block_device_get_io_values(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	size64_t size               = 0;
+	uint32_t logical_block_size = 0;
+	uint32_t minimum_io_size    = 0;
+	uint32_t optimal_io_size    = 0;
+	int result                  = 0;
+
+	/* Test error cases
+	 */
+	result = libluksde_block_device_get_io_values(
+	          -1,
+	          &size,
+	          &logical_block_size,
+	          &minimum_io_size,
+	          &optimal_io_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_block_device_get_io_values(
+	          0,
+	          NULL,
+	          &logical_block_size,
+	          &minimum_io_size,
+	          &optimal_io_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_block_device_get_io_values(
+	          0,
+	          &size,
+	          NULL,
+	          &minimum_io_size,
+	          &optimal_io_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_block_device_get_io_values(
+	          0,
+	          &size,
+	          &logical_block_size,
+	          NULL,
+	          &optimal_io_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_block_device_get_io_values(
+	          0,
+	          &size,
+	          &logical_block_size,
+	          &minimum_io_size,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_block_device_get_io_values_by_name function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_block_device_get_io_values_by_name(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	size64_t size               = 0;
+	uint32_t logical_block_size = 0;
+	uint32_t minimum_io_size    = 0;
+	uint32_t optimal_io_size    = 0;
+	int result                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libluksde_block_device_get_io_values_by_name(
+	          ".",
+	          &size,
+	          &logical_block_size,
+	          &minimum_io_size,
+	          &optimal_io_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_block_device_get_io_values_by_name(
+	          NULL,
+	          &size,
+	          &logical_block_size,
+	          &minimum_io_size,
+	          &optimal_io_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_block_device_get_io_values_by_name(
+	          ".",
+	          NULL,
+	          &logical_block_size,
+	          &minimum_io_size,
+	          &optimal_io_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+
+/* Tests the libluksde_block_device_get_io_values_by_name function on a block device
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_block_device_get_io_values_by_name_with_device(
+     const char *source,
+     size64_t expected_size,
+     uint32_t expected_logical_block_size,
+     uint32_t expected_minimum_io_size,
+     uint32_t expected_optimal_io_size )
+{
+	libcerror_error_t *error    = NULL;
+	size64_t size               = 0;
+	uint32_t logical_block_size = 0;
+	uint32_t minimum_io_size    = 0;
+	uint32_t optimal_io_size    = 0;
+	int result                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libluksde_block_device_get_io_values_by_name(
+	          source,
+	          &size,
+	          &logical_block_size,
+	          &minimum_io_size,
+	          &optimal_io_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 (uint64_t) size,
+	 (uint64_t) expected_size );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+	 "logical_block_size",
+	 logical_block_size,
+	 expected_logical_block_size );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+	 "minimum_io_size",
+	 minimum_io_size,
+	 expected_minimum_io_size );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+	 "optimal_io_size",
+	 optimal_io_size,
+	 expected_optimal_io_size );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	system_character_t *option_logical_block_size = NULL;
+	system_character_t *option_minimum_io_size    = NULL;
+	system_character_t *option_optimal_io_size    = NULL;
+	system_character_t *option_size               = NULL;
+	system_character_t *source                    = NULL;
+	system_integer_t option                       = 0;
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	size64_t expected_size                        = 0;
+	uint32_t expected_logical_block_size          = 512;
+	uint32_t expected_minimum_io_size             = 0;
+	uint32_t expected_optimal_io_size             = 0;
+#endif
+
+	while( ( option = luksde_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "l:m:o:s:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'l':
+				option_logical_block_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'm':
+				option_minimum_io_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'o':
+				option_optimal_io_size = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_size = optarg;
+
+				break;
+		}
+	}
+	if( optind < argc )
+	{
+		source = argv[ optind ];
+	}
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_block_device_get_io_values",
+	 luksde_test_block_device_get_io_values );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_block_device_get_io_values_by_name",
+	 luksde_test_block_device_get_io_values_by_name );
+
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( source != NULL )
+	{
+		/* The source is expected to be a block device, such as a loop device,
+		 * with its size and I/O values provided as options
+		 */
+		if( option_size != NULL )
+		{
+			expected_size = (size64_t) strtoull(
+			                            option_size,
+			                            NULL,
+			                            10 );
+		}
+		if( option_logical_block_size != NULL )
+		{
+			expected_logical_block_size = (uint32_t) strtoul(
+			                                          option_logical_block_size,
+			                                          NULL,
+			                                          10 );
+		}
+		if( option_minimum_io_size != NULL )
+		{
+			expected_minimum_io_size = (uint32_t) strtoul(
+			                                       option_minimum_io_size,
+			                                       NULL,
+			                                       10 );
+		}
+		if( option_optimal_io_size != NULL )
+		{
+			expected_optimal_io_size = (uint32_t) strtoul(
+			                                       option_optimal_io_size,
+			                                       NULL,
+			                                       10 );
+		}
+		LUKSDE_TEST_RUN_WITH_ARGS(
+		 "libluksde_block_device_get_io_values_by_name",
+		 luksde_test_block_device_get_io_values_by_name_with_device,
+		 source,
+		 expected_size,
+		 expected_logical_block_size,
+		 expected_minimum_io_size,
+		 expected_optimal_io_size );
+	}
+#endif /* !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+}
+
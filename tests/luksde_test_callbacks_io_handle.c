@@ -0,0 +1,640 @@
+/*
+ * Library callbacks_io_handle type test program
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_libbfio.h"
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_memory.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_callbacks_io_handle.h"
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+#define LUKSDE_TEST_CALLBACKS_IO_HANDLE_DATA_SIZE	1024
+
+/* Reads test data at a specific offset
+ */
+ssize_t luksde_test_callbacks_io_handle_data_read_at_offset(
+         void *user_data,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset )
+{
+	size_t data_offset = 0;
+
+	if( ( user_data == NULL )
+	 || ( buffer == NULL )
+	 || ( offset < 0 ) )
+	{
+		return( -1 );
+	}
+	if( offset >= LUKSDE_TEST_CALLBACKS_IO_HANDLE_DATA_SIZE )
+	{
+		return( 0 );
+	}
+	if( size > (size_t) ( LUKSDE_TEST_CALLBACKS_IO_HANDLE_DATA_SIZE - offset ) )
+	{
+		size = (size_t) ( LUKSDE_TEST_CALLBACKS_IO_HANDLE_DATA_SIZE - offset );
+	}
+	for( data_offset = 0;
+	     data_offset < size;
+	     data_offset++ )
+	{
+		buffer[ data_offset ] = (uint8_t) ( offset + data_offset );
+	}
+	return( (ssize_t) size );
+}
+
+/* Retrieves the size of the test data
+ */
+int luksde_test_callbacks_io_handle_data_get_size(
+     void *user_data,
+     size64_t *size )
+{
+	if( ( user_data == NULL )
+	 || ( size == NULL ) )
+	{
+		return( -1 );
+	}
+	*size = LUKSDE_TEST_CALLBACKS_IO_HANDLE_DATA_SIZE;
+
+	return( 1 );
+}
+
+/* Tests the libluksde_callbacks_io_handle_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_callbacks_io_handle_initialize(
+     void )
+{
+	libluksde_io_callbacks_t io_callbacks;
+
+	libcerror_error_t *error                             = NULL;
+	libluksde_callbacks_io_handle_t *callbacks_io_handle = NULL;
+	int result                                           = 0;
+	int user_data                                        = 0;
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests                      = 1;
+	int number_of_memset_fail_tests                      = 1;
+	int test_number                                      = 0;
+#endif
+
+	io_callbacks.read_at_offset = &luksde_test_callbacks_io_handle_data_read_at_offset;
+	io_callbacks.get_size       = &luksde_test_callbacks_io_handle_data_get_size;
+	io_callbacks.user_data      = &user_data;
+
+	/* Test regular cases
+	 */
+	result = libluksde_callbacks_io_handle_initialize(
+	          &callbacks_io_handle,
+	          &io_callbacks,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "callbacks_io_handle",
+	 callbacks_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_callbacks_io_handle_free(
+	          &callbacks_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "callbacks_io_handle",
+	 callbacks_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_callbacks_io_handle_initialize(
+	          NULL,
+	          &io_callbacks,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	callbacks_io_handle = (libluksde_callbacks_io_handle_t *) 0x12345678UL;
+
+	result = libluksde_callbacks_io_handle_initialize(
+	          &callbacks_io_handle,
+	          &io_callbacks,
+	          &error );
+
+	callbacks_io_handle = NULL;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_callbacks_io_handle_initialize(
+	          &callbacks_io_handle,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	io_callbacks.get_size = NULL;
+
+	result = libluksde_callbacks_io_handle_initialize(
+	          &callbacks_io_handle,
+	          &io_callbacks,
+	          &error );
+
+	io_callbacks.get_size = &luksde_test_callbacks_io_handle_data_get_size;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_callbacks_io_handle_initialize with malloc failing
+		 */
+		luksde_test_malloc_attempts_before_fail = test_number;
+
+		result = libluksde_callbacks_io_handle_initialize(
+		          &callbacks_io_handle,
+		          &io_callbacks,
+		          &error );
+
+		if( luksde_test_malloc_attempts_before_fail != -1 )
+		{
+			luksde_test_malloc_attempts_before_fail = -1;
+
+			if( callbacks_io_handle != NULL )
+			{
+				libluksde_callbacks_io_handle_free(
+				 &callbacks_io_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "callbacks_io_handle",
+			 callbacks_io_handle );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_callbacks_io_handle_initialize with memset failing
+		 */
+		luksde_test_memset_attempts_before_fail = test_number;
+
+		result = libluksde_callbacks_io_handle_initialize(
+		          &callbacks_io_handle,
+		          &io_callbacks,
+		          &error );
+
+		if( luksde_test_memset_attempts_before_fail != -1 )
+		{
+			luksde_test_memset_attempts_before_fail = -1;
+
+			if( callbacks_io_handle != NULL )
+			{
+				libluksde_callbacks_io_handle_free(
+				 &callbacks_io_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "callbacks_io_handle",
+			 callbacks_io_handle );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_LUKSDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( callbacks_io_handle != NULL )
+	{
+		libluksde_callbacks_io_handle_free(
+		 &callbacks_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_callbacks_io_handle_free function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_callbacks_io_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libluksde_callbacks_io_handle_free(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_callbacks_io_handle_read function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_callbacks_io_handle_read(
+     void )
+{
+	uint8_t buffer[ 512 ];
+
+	libluksde_io_callbacks_t io_callbacks;
+
+	libcerror_error_t *error                             = NULL;
+	libluksde_callbacks_io_handle_t *callbacks_io_handle = NULL;
+	off64_t offset                                       = 0;
+	ssize_t read_count                                   = 0;
+	int result                                           = 0;
+	int user_data                                        = 0;
+
+	io_callbacks.read_at_offset = &luksde_test_callbacks_io_handle_data_read_at_offset;
+	io_callbacks.get_size       = &luksde_test_callbacks_io_handle_data_get_size;
+	io_callbacks.user_data      = &user_data;
+
+	/* Initialize test
+	 */
+	result = libluksde_callbacks_io_handle_initialize(
+	          &callbacks_io_handle,
+	          &io_callbacks,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "callbacks_io_handle",
+	 callbacks_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with a callbacks I/O handle that was not opened
+	 */
+	read_count = libluksde_callbacks_io_handle_read(
+	              callbacks_io_handle,
+	              buffer,
+	              512,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_callbacks_io_handle_open(
+	          callbacks_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	offset = libluksde_callbacks_io_handle_seek_offset(
+	          callbacks_io_handle,
+	          768,
+	          SEEK_SET,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 768 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libluksde_callbacks_io_handle_read(
+	              callbacks_io_handle,
+	              buffer,
+	              512,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 256 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 (uint8_t) 0 );
+
+	read_count = libluksde_callbacks_io_handle_read(
+	              callbacks_io_handle,
+	              buffer,
+	              512,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libluksde_callbacks_io_handle_read(
+	              NULL,
+	              buffer,
+	              512,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libluksde_callbacks_io_handle_seek_offset(
+	          callbacks_io_handle,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_callbacks_io_handle_close(
+	          callbacks_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_callbacks_io_handle_free(
+	          &callbacks_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "callbacks_io_handle",
+	 callbacks_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( callbacks_io_handle != NULL )
+	{
+		libluksde_callbacks_io_handle_free(
+		 &callbacks_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_callbacks_io_handle_initialize",
+	 luksde_test_callbacks_io_handle_initialize );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_callbacks_io_handle_free",
+	 luksde_test_callbacks_io_handle_free );
+
+	/* TODO: add tests for libluksde_callbacks_io_handle_clone */
+
+	/* TODO: add tests for libluksde_callbacks_io_handle_open */
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_callbacks_io_handle_read",
+	 luksde_test_callbacks_io_handle_read );
+
+	/* TODO: add tests for libluksde_callbacks_io_handle_write */
+
+	/* TODO: add tests for libluksde_callbacks_io_handle_get_size */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+}
+
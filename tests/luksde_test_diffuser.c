@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -30,6 +31,7 @@
 #include "luksde_test_libcerror.h"
 #include "luksde_test_libluksde.h"
 #include "luksde_test_macros.h"
+#include "luksde_test_memory.h"
 #include "luksde_test_unused.h"
 
 #include "../libluksde/libluksde_definitions.h"
@@ -69,6 +71,10 @@ uint8_t luksde_test_diffuser_split_data1[ 512 ] = {
 	0x28, 0x7d, 0xde, 0x6e, 0x81, 0xf2, 0x89, 0x1d, 0x50, 0xf5, 0x0e, 0xcd, 0x1b, 0x69, 0xf9, 0xc0,
 	0xad, 0x69, 0x10, 0x06, 0xe6, 0x21, 0x02, 0xee, 0xde, 0x6b, 0x1f, 0xf8, 0xd2, 0x0d, 0x5a, 0xc5 };
 
+uint8_t luksde_test_diffuser_data1[ 32 ] = {
+	0x1b, 0x82, 0x61, 0xc3, 0x65, 0x0e, 0xcf, 0x17, 0x62, 0x9f, 0x1b, 0x62, 0xd6, 0x3e, 0x68, 0x9a,
+	0xc7, 0x31, 0xd4, 0x40, 0x90, 0x4d, 0x8a, 0x57, 0x25, 0xe7, 0x45, 0xe1, 0x4c, 0xa9, 0xc8, 0x93 };
+
 #if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
 
 /* Tests the libluksde_diffuser_diffuse function
@@ -261,6 +267,16 @@ int luksde_test_diffuser_merge(
 	 "error",
 	 error );
 
+	result = memory_compare(
+	          data,
+	          luksde_test_diffuser_data1,
+	          32 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
 	/* Test error cases
 	 */
 	result = libluksde_diffuser_merge(
@@ -454,9 +470,9 @@ int luksde_test_diffuser_merge(
 
 #if defined( HAVE_LUKSDE_TEST_MEMORY ) && defined( OPTIMIZATION_DISABLED )
 
-	/* Test libluksde_diffuser_merge with memset failing
+	/* Test libluksde_diffuser_merge with memcpy failing
 	 */
-	luksde_test_memset_attempts_before_fail = 1;
+	luksde_test_memcpy_attempts_before_fail = 0;
 
 	result = libluksde_diffuser_merge(
 	          luksde_test_diffuser_split_data1,
@@ -467,9 +483,9 @@ int luksde_test_diffuser_merge(
 	          LIBLUKSDE_HASHING_METHOD_SHA1,
 	          &error );
 
-	if( luksde_test_memset_attempts_before_fail != -1 )
+	if( luksde_test_memcpy_attempts_before_fail != -1 )
 	{
-		luksde_test_memset_attempts_before_fail = -1;
+		luksde_test_memcpy_attempts_before_fail = -1;
 	}
 	else
 	{
@@ -498,6 +514,146 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libluksde_diffuser_merge_stripes function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_diffuser_merge_stripes(
+     void )
+{
+	uint8_t data[ 32 ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libluksde_diffuser_merge_stripes(
+	          luksde_test_diffuser_split_data1,
+	          224,
+	          data,
+	          32,
+	          0,
+	          7,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_diffuser_merge_stripes(
+	          &( luksde_test_diffuser_split_data1[ 224 ] ),
+	          288,
+	          data,
+	          32,
+	          7,
+	          9,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          luksde_test_diffuser_data1,
+	          32 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libluksde_diffuser_merge_stripes(
+	          NULL,
+	          512,
+	          data,
+	          32,
+	          0,
+	          16,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_diffuser_merge_stripes(
+	          luksde_test_diffuser_split_data1,
+	          512,
+	          data,
+	          32,
+	          0,
+	          17,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_diffuser_merge_stripes(
+	          luksde_test_diffuser_split_data1,
+	          512,
+	          data,
+	          32,
+	          0xffffffffUL,
+	          16,
+	          LIBLUKSDE_HASHING_METHOD_SHA1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
 
 /* The main program
@@ -525,6 +681,10 @@ int main(
 	 "libluksde_diffuser_merge",
 	 luksde_test_diffuser_merge );
 
+	LUKSDE_TEST_RUN(
+	 "libluksde_diffuser_merge_stripes",
+	 luksde_test_diffuser_merge_stripes );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
@@ -0,0 +1,799 @@
+/*
+ * Library digest type test program
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_memory.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_definitions.h"
+#include "../libluksde/libluksde_digest.h"
+#include "../libluksde/libluksde_json_tokenizer.h"
+
+uint8_t luksde_test_digest_json_data1[ 200 ] =
+	"{\"type\":\"pbkdf2\",\"keyslots\":[\"0\",\"1\"],\"segments\":[\"0\"],\"hash\":\"sha256\",\"iterations\":1000,\"salt\":\"AAECAwQFBgcICQoLDA0ODxAREhMUFRYXGBkaGxwdHh8=\",\"digest\":\"ICEiIyQlJicoKSorLC0uLzAxMjM0NTY3ODk6Ozw9Pj8=\"}";
+
+uint8_t luksde_test_digest_json_data2[ 47 ] =
+	"{\"type\":\"argon2i\",\"keyslots\":[],\"segments\":[]}";
+
+uint8_t luksde_test_digest_key[ 32 ] = {
+	0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f,
+	0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x5b, 0x5c, 0x5d, 0x5e, 0x5f };
+
+uint8_t luksde_test_digest_key_digest[ 32 ] = {
+	0xf9, 0x98, 0xa3, 0x16, 0x79, 0x87, 0xee, 0xbd, 0x2d, 0xe5, 0x13, 0xc7, 0x7c, 0x80, 0x4a, 0x72,
+	0xe2, 0x90, 0x95, 0xc2, 0x45, 0x0d, 0xbc, 0x76, 0x59, 0xa6, 0xab, 0x28, 0x4b, 0x64, 0x5b, 0x43 };
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* Tests the libluksde_digest_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_digest_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libluksde_digest_t *digest      = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libluksde_digest_initialize(
+	          &digest,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "digest",
+	 digest );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_digest_free(
+	          &digest,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "digest",
+	 digest );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_digest_initialize(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	digest = (libluksde_digest_t *) 0x12345678UL;
+
+	result = libluksde_digest_initialize(
+	          &digest,
+	          &error );
+
+	digest = NULL;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_digest_initialize with malloc failing
+		 */
+		luksde_test_malloc_attempts_before_fail = test_number;
+
+		result = libluksde_digest_initialize(
+		          &digest,
+		          &error );
+
+		if( luksde_test_malloc_attempts_before_fail != -1 )
+		{
+			luksde_test_malloc_attempts_before_fail = -1;
+
+			if( digest != NULL )
+			{
+				libluksde_digest_free(
+				 &digest,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "digest",
+			 digest );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_digest_initialize with memset failing
+		 */
+		luksde_test_memset_attempts_before_fail = test_number;
+
+		result = libluksde_digest_initialize(
+		          &digest,
+		          &error );
+
+		if( luksde_test_memset_attempts_before_fail != -1 )
+		{
+			luksde_test_memset_attempts_before_fail = -1;
+
+			if( digest != NULL )
+			{
+				libluksde_digest_free(
+				 &digest,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "digest",
+			 digest );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_LUKSDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest != NULL )
+	{
+		libluksde_digest_free(
+		 &digest,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_digest_free function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_digest_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libluksde_digest_free(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_digest_read_json_object function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_digest_read_json_object(
+     void )
+{
+	libluksde_json_token_t token;
+	libluksde_json_tokenizer_t tokenizer;
+
+	libcerror_error_t *error   = NULL;
+	libluksde_digest_t *digest = NULL;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_digest_initialize(
+	          &digest,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "digest",
+	 digest );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_set_data(
+	          &tokenizer,
+	          luksde_test_digest_json_data1,
+	          200,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_digest_read_json_object(
+	          digest,
+	          &tokenizer,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+	 "digest->key_slots_bitmap",
+	 digest->key_slots_bitmap,
+	 0x00000003 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+	 "digest->segments_bitmap",
+	 digest->segments_bitmap,
+	 0x00000001 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "digest->hashing_method",
+	 digest->hashing_method,
+	 LIBLUKSDE_HASHING_METHOD_SHA256 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+	 "digest->number_of_iterations",
+	 digest->number_of_iterations,
+	 1000 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "digest->salt_size",
+	 digest->salt_size,
+	 (size_t) 32 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "digest->digest_size",
+	 digest->digest_size,
+	 (size_t) 32 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "digest->digest[ 31 ]",
+	 digest->digest[ 31 ],
+	 0x3f );
+
+	/* Test error cases
+	 */
+	result = libluksde_digest_read_json_object(
+	          NULL,
+	          &tokenizer,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the digest type is not supported
+	 */
+	result = libluksde_json_tokenizer_set_data(
+	          &tokenizer,
+	          luksde_test_digest_json_data2,
+	          47,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_digest_read_json_object(
+	          digest,
+	          &tokenizer,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_digest_free(
+	          &digest,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "digest",
+	 digest );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest != NULL )
+	{
+		libluksde_digest_free(
+		 &digest,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_digest_check_key function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_digest_check_key(
+     void )
+{
+	libluksde_json_token_t token;
+	libluksde_json_tokenizer_t tokenizer;
+
+	uint8_t key[ 32 ];
+
+	libcerror_error_t *error   = NULL;
+	libluksde_digest_t *digest = NULL;
+	void *memset_result        = NULL;
+	void *memcpy_result        = NULL;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_digest_initialize(
+	          &digest,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "digest",
+	 digest );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_set_data(
+	          &tokenizer,
+	          luksde_test_digest_json_data1,
+	          200,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_digest_read_json_object(
+	          digest,
+	          &tokenizer,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memcpy_result = memory_copy(
+	                 digest->digest,
+	                 luksde_test_digest_key_digest,
+	                 32 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "memcpy_result",
+	 memcpy_result );
+
+	memcpy_result = memory_copy(
+	                 key,
+	                 luksde_test_digest_key,
+	                 32 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "memcpy_result",
+	 memcpy_result );
+
+	/* Test regular cases
+	 */
+	result = libluksde_digest_check_key(
+	          digest,
+	          key,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memset_result = memory_set(
+	                 key,
+	                 0,
+	                 32 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
+	result = libluksde_digest_check_key(
+	          digest,
+	          key,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_digest_check_key(
+	          NULL,
+	          key,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_digest_check_key(
+	          digest,
+	          NULL,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_digest_check_key(
+	          digest,
+	          key,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_digest_check_key(
+	          digest,
+	          key,
+	          65,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_digest_free(
+	          &digest,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "digest",
+	 digest );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest != NULL )
+	{
+		libluksde_digest_free(
+		 &digest,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_digest_initialize",
+	 luksde_test_digest_initialize );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_digest_free",
+	 luksde_test_digest_free );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_digest_read_json_object",
+	 luksde_test_digest_read_json_object );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_digest_check_key",
+	 luksde_test_digest_check_key );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+}
+
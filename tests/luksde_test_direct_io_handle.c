@@ -0,0 +1,870 @@
+/*
+ * Library direct_io_handle type test program
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_libbfio.h"
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_memory.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_definitions.h"
+#include "../libluksde/libluksde_direct_io_handle.h"
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* Tests the libluksde_direct_io_handle_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_direct_io_handle_initialize(
+     void )
+{
+	libcerror_error_t *error                       = NULL;
+	libluksde_direct_io_handle_t *direct_io_handle = NULL;
+	int result                                     = 0;
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests                = 2;
+	int number_of_memset_fail_tests                = 1;
+	int test_number                                = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libluksde_direct_io_handle_initialize(
+	          &direct_io_handle,
+	          "test",
+	          4,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "direct_io_handle",
+	 direct_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_direct_io_handle_free(
+	          &direct_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "direct_io_handle",
+	 direct_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_direct_io_handle_initialize(
+	          NULL,
+	          "test",
+	          4,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	direct_io_handle = (libluksde_direct_io_handle_t *) 0x12345678UL;
+
+	result = libluksde_direct_io_handle_initialize(
+	          &direct_io_handle,
+	          "test",
+	          4,
+	          &error );
+
+	direct_io_handle = NULL;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_direct_io_handle_initialize(
+	          &direct_io_handle,
+	          NULL,
+	          4,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_direct_io_handle_initialize(
+	          &direct_io_handle,
+	          "test",
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_direct_io_handle_initialize with malloc failing
+		 */
+		luksde_test_malloc_attempts_before_fail = test_number;
+
+		result = libluksde_direct_io_handle_initialize(
+		          &direct_io_handle,
+		          "test",
+		          4,
+		          &error );
+
+		if( luksde_test_malloc_attempts_before_fail != -1 )
+		{
+			luksde_test_malloc_attempts_before_fail = -1;
+
+			if( direct_io_handle != NULL )
+			{
+				libluksde_direct_io_handle_free(
+				 &direct_io_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "direct_io_handle",
+			 direct_io_handle );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_direct_io_handle_initialize with memset failing
+		 */
+		luksde_test_memset_attempts_before_fail = test_number;
+
+		result = libluksde_direct_io_handle_initialize(
+		          &direct_io_handle,
+		          "test",
+		          4,
+		          &error );
+
+		if( luksde_test_memset_attempts_before_fail != -1 )
+		{
+			luksde_test_memset_attempts_before_fail = -1;
+
+			if( direct_io_handle != NULL )
+			{
+				libluksde_direct_io_handle_free(
+				 &direct_io_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "direct_io_handle",
+			 direct_io_handle );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_LUKSDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( direct_io_handle != NULL )
+	{
+		libluksde_direct_io_handle_free(
+		 &direct_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_direct_io_handle_free function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_direct_io_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libluksde_direct_io_handle_free(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_direct_io_handle_open function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_direct_io_handle_open(
+     void )
+{
+	libcerror_error_t *error                       = NULL;
+	libluksde_direct_io_handle_t *direct_io_handle = NULL;
+	int result                                     = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_direct_io_handle_initialize(
+	          &direct_io_handle,
+	          "luksde_test_direct_io_handle_does_not_exist",
+	          43,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "direct_io_handle",
+	 direct_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_direct_io_handle_open(
+	          NULL,
+	          LIBBFIO_ACCESS_FLAG_READ,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_direct_io_handle_open(
+	          direct_io_handle,
+	          LIBBFIO_ACCESS_FLAG_READ | LIBBFIO_ACCESS_FLAG_WRITE,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a file that does not exist
+	 */
+	result = libluksde_direct_io_handle_open(
+	          direct_io_handle,
+	          LIBBFIO_ACCESS_FLAG_READ,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_direct_io_handle_free(
+	          &direct_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "direct_io_handle",
+	 direct_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( direct_io_handle != NULL )
+	{
+		libluksde_direct_io_handle_free(
+		 &direct_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_direct_io_handle_read function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_direct_io_handle_read(
+     void )
+{
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error                       = NULL;
+	libluksde_direct_io_handle_t *direct_io_handle = NULL;
+	ssize_t read_count                             = 0;
+	int result                                     = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_direct_io_handle_initialize(
+	          &direct_io_handle,
+	          "luksde_test_direct_io_handle_does_not_exist",
+	          43,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "direct_io_handle",
+	 direct_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libluksde_direct_io_handle_read(
+	              NULL,
+	              buffer,
+	              512,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a direct I/O handle that was not opened
+	 */
+	read_count = libluksde_direct_io_handle_read(
+	              direct_io_handle,
+	              buffer,
+	              512,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_direct_io_handle_free(
+	          &direct_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "direct_io_handle",
+	 direct_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( direct_io_handle != NULL )
+	{
+		libluksde_direct_io_handle_free(
+		 &direct_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_direct_io_handle_seek_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_direct_io_handle_seek_offset(
+     void )
+{
+	libcerror_error_t *error                       = NULL;
+	libluksde_direct_io_handle_t *direct_io_handle = NULL;
+	off64_t offset                                 = 0;
+	int result                                     = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_direct_io_handle_initialize(
+	          &direct_io_handle,
+	          "luksde_test_direct_io_handle_does_not_exist",
+	          43,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "direct_io_handle",
+	 direct_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	offset = libluksde_direct_io_handle_seek_offset(
+	          direct_io_handle,
+	          1024,
+	          SEEK_SET,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 1024 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libluksde_direct_io_handle_seek_offset(
+	          direct_io_handle,
+	          512,
+	          SEEK_CUR,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 1536 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	offset = libluksde_direct_io_handle_seek_offset(
+	          NULL,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libluksde_direct_io_handle_seek_offset(
+	          direct_io_handle,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libluksde_direct_io_handle_seek_offset(
+	          direct_io_handle,
+	          0,
+	          -1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_direct_io_handle_free(
+	          &direct_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "direct_io_handle",
+	 direct_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( direct_io_handle != NULL )
+	{
+		libluksde_direct_io_handle_free(
+		 &direct_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_direct_io_handle_is_open function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_direct_io_handle_is_open(
+     void )
+{
+	libcerror_error_t *error                       = NULL;
+	libluksde_direct_io_handle_t *direct_io_handle = NULL;
+	int result                                     = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_direct_io_handle_initialize(
+	          &direct_io_handle,
+	          "luksde_test_direct_io_handle_does_not_exist",
+	          43,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "direct_io_handle",
+	 direct_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_direct_io_handle_is_open(
+	          direct_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_direct_io_handle_is_open(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_direct_io_handle_free(
+	          &direct_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "direct_io_handle",
+	 direct_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( direct_io_handle != NULL )
+	{
+		libluksde_direct_io_handle_free(
+		 &direct_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_direct_io_handle_initialize",
+	 luksde_test_direct_io_handle_initialize );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_direct_io_handle_free",
+	 luksde_test_direct_io_handle_free );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_direct_io_handle_open",
+	 luksde_test_direct_io_handle_open );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_direct_io_handle_read",
+	 luksde_test_direct_io_handle_read );
+
+	/* TODO: add tests for libluksde_direct_io_handle_write */
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_direct_io_handle_seek_offset",
+	 luksde_test_direct_io_handle_seek_offset );
+
+	/* TODO: add tests for libluksde_direct_io_handle_exists */
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_direct_io_handle_is_open",
+	 luksde_test_direct_io_handle_is_open );
+
+	/* TODO: add tests for libluksde_direct_io_handle_get_size */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,729 @@
+/*
+ * Library file_io_handle_pool type test program
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_functions.h"
+#include "luksde_test_libbfio.h"
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_memory.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_file_io_handle_pool.h"
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) && defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+
+/* Tests the libluksde_file_io_handle_pool_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_file_io_handle_pool_initialize(
+     void )
+{
+	uint8_t data[ 512 ];
+
+	libbfio_handle_t *source_file_io_handle              = NULL;
+	libcerror_error_t *error                             = NULL;
+	libluksde_file_io_handle_pool_t *file_io_handle_pool = NULL;
+	int result                                           = 0;
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests                      = 2;
+	int test_number                                      = 0;
+#endif
+
+	/* Initialize test
+	 */
+	result = luksde_test_open_file_io_handle(
+	          &source_file_io_handle,
+	          data,
+	          512,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "source_file_io_handle",
+	 source_file_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_file_io_handle_pool_initialize(
+	          &file_io_handle_pool,
+	          source_file_io_handle,
+	          2,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle_pool",
+	 file_io_handle_pool );
+
+	result = libluksde_file_io_handle_pool_free(
+	          &file_io_handle_pool,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "file_io_handle_pool",
+	 file_io_handle_pool );
+
+	/* Test error cases
+	 */
+	result = libluksde_file_io_handle_pool_initialize(
+	          NULL,
+	          source_file_io_handle,
+	          2,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	file_io_handle_pool = (libluksde_file_io_handle_pool_t *) 0x12345678UL;
+
+	result = libluksde_file_io_handle_pool_initialize(
+	          &file_io_handle_pool,
+	          source_file_io_handle,
+	          2,
+	          &error );
+
+	file_io_handle_pool = NULL;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_file_io_handle_pool_initialize(
+	          &file_io_handle_pool,
+	          NULL,
+	          2,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_file_io_handle_pool_initialize(
+	          &file_io_handle_pool,
+	          source_file_io_handle,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_file_io_handle_pool_initialize with malloc failing
+		 */
+		luksde_test_malloc_attempts_before_fail = test_number;
+
+		result = libluksde_file_io_handle_pool_initialize(
+		          &file_io_handle_pool,
+		          source_file_io_handle,
+		          2,
+		          &error );
+
+		if( luksde_test_malloc_attempts_before_fail != -1 )
+		{
+			luksde_test_malloc_attempts_before_fail = -1;
+
+			if( file_io_handle_pool != NULL )
+			{
+				libluksde_file_io_handle_pool_free(
+				 &file_io_handle_pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "file_io_handle_pool",
+			 file_io_handle_pool );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_LUKSDE_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
+	result = luksde_test_close_file_io_handle(
+	          &source_file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle_pool != NULL )
+	{
+		libluksde_file_io_handle_pool_free(
+		 &file_io_handle_pool,
+		 NULL );
+	}
+	if( source_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &source_file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_file_io_handle_pool_free function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_file_io_handle_pool_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libluksde_file_io_handle_pool_free(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_file_io_handle_pool_grab_file_io_handle and
+ * libluksde_file_io_handle_pool_release_file_io_handle functions
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_file_io_handle_pool_grab_file_io_handle(
+     void )
+{
+	uint8_t buffer[ 16 ];
+	uint8_t data[ 512 ];
+
+	libbfio_handle_t *first_file_io_handle               = NULL;
+	libbfio_handle_t *second_file_io_handle              = NULL;
+	libbfio_handle_t *source_file_io_handle              = NULL;
+	libbfio_handle_t *third_file_io_handle               = NULL;
+	libcerror_error_t *error                             = NULL;
+	libluksde_file_io_handle_pool_t *file_io_handle_pool = NULL;
+	size_t data_offset                                   = 0;
+	ssize_t read_count                                   = 0;
+	int result                                           = 0;
+
+	for( data_offset = 0;
+	     data_offset < 512;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) data_offset;
+	}
+	/* Initialize test
+	 */
+	result = luksde_test_open_file_io_handle(
+	          &source_file_io_handle,
+	          data,
+	          512,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "source_file_io_handle",
+	 source_file_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_file_io_handle_pool_initialize(
+	          &file_io_handle_pool,
+	          source_file_io_handle,
+	          2,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle_pool",
+	 file_io_handle_pool );
+
+	/* Test regular cases
+	 */
+	result = libluksde_file_io_handle_pool_grab_file_io_handle(
+	          file_io_handle_pool,
+	          &first_file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "first_file_io_handle",
+	 first_file_io_handle );
+
+	LUKSDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "first_file_io_handle",
+	 (int) ( first_file_io_handle == source_file_io_handle ),
+	 1 );
+
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              first_file_io_handle,
+	              buffer,
+	              16,
+	              256,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( data[ 256 ] ),
+	          16 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libluksde_file_io_handle_pool_grab_file_io_handle(
+	          file_io_handle_pool,
+	          &second_file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "second_file_io_handle",
+	 second_file_io_handle );
+
+	/* Test that no file IO handle is available when the maximum number of file IO handles are in use
+	 */
+	result = libluksde_file_io_handle_pool_grab_file_io_handle(
+	          file_io_handle_pool,
+	          &third_file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "third_file_io_handle",
+	 third_file_io_handle );
+
+	result = libluksde_file_io_handle_pool_release_file_io_handle(
+	          file_io_handle_pool,
+	          second_file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a released file IO handle is reused
+	 */
+	result = libluksde_file_io_handle_pool_grab_file_io_handle(
+	          file_io_handle_pool,
+	          &third_file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "third_file_io_handle",
+	 (int) ( third_file_io_handle == second_file_io_handle ),
+	 1 );
+
+	result = libluksde_file_io_handle_pool_release_file_io_handle(
+	          file_io_handle_pool,
+	          third_file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	third_file_io_handle  = NULL;
+	second_file_io_handle = NULL;
+
+	result = libluksde_file_io_handle_pool_release_file_io_handle(
+	          file_io_handle_pool,
+	          first_file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_file_io_handle_pool_release_file_io_handle(
+	          file_io_handle_pool,
+	          first_file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	first_file_io_handle = NULL;
+
+	result = libluksde_file_io_handle_pool_grab_file_io_handle(
+	          NULL,
+	          &first_file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_file_io_handle_pool_grab_file_io_handle(
+	          file_io_handle_pool,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_file_io_handle_pool_release_file_io_handle(
+	          NULL,
+	          source_file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_file_io_handle_pool_release_file_io_handle(
+	          file_io_handle_pool,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_file_io_handle_pool_free(
+	          &file_io_handle_pool,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "file_io_handle_pool",
+	 file_io_handle_pool );
+
+	result = luksde_test_close_file_io_handle(
+	          &source_file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle_pool != NULL )
+	{
+		libluksde_file_io_handle_pool_free(
+		 &file_io_handle_pool,
+		 NULL );
+	}
+	if( source_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &source_file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) && defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) && defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_file_io_handle_pool_initialize",
+	 luksde_test_file_io_handle_pool_initialize );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_file_io_handle_pool_free",
+	 luksde_test_file_io_handle_pool_free );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_file_io_handle_pool_grab_file_io_handle",
+	 luksde_test_file_io_handle_pool_grab_file_io_handle );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) && defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) && defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) && defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+}
+
@@ -0,0 +1,479 @@
+/*
+ * Library io_callbacks functions test program
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_memory.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_io_callbacks.h"
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+#define LUKSDE_TEST_IO_CALLBACKS_DATA_SIZE	1024
+
+/* Reads test data at a specific offset
+ * Returns at most 100 bytes per call to test short reads
+ */
+ssize_t luksde_test_io_callbacks_data_read_at_offset(
+         void *user_data,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset )
+{
+	size_t data_offset = 0;
+
+	if( ( user_data == NULL )
+	 || ( buffer == NULL )
+	 || ( offset < 0 ) )
+	{
+		return( -1 );
+	}
+	if( offset >= LUKSDE_TEST_IO_CALLBACKS_DATA_SIZE )
+	{
+		return( 0 );
+	}
+	if( size > (size_t) ( LUKSDE_TEST_IO_CALLBACKS_DATA_SIZE - offset ) )
+	{
+		size = (size_t) ( LUKSDE_TEST_IO_CALLBACKS_DATA_SIZE - offset );
+	}
+	if( size > 100 )
+	{
+		size = 100;
+	}
+	for( data_offset = 0;
+	     data_offset < size;
+	     data_offset++ )
+	{
+		buffer[ data_offset ] = (uint8_t) ( offset + data_offset );
+	}
+	return( (ssize_t) size );
+}
+
+/* Reads test data at a specific offset
+ * Always fails
+ */
+ssize_t luksde_test_io_callbacks_data_read_at_offset_fail(
+         void *user_data LUKSDE_TEST_ATTRIBUTE_UNUSED,
+         uint8_t *buffer LUKSDE_TEST_ATTRIBUTE_UNUSED,
+         size_t size LUKSDE_TEST_ATTRIBUTE_UNUSED,
+         off64_t offset LUKSDE_TEST_ATTRIBUTE_UNUSED )
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( user_data )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( buffer )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( size )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( offset )
+
+	return( -1 );
+}
+
+/* Retrieves the size of the test data
+ */
+int luksde_test_io_callbacks_data_get_size(
+     void *user_data,
+     size64_t *size )
+{
+	if( ( user_data == NULL )
+	 || ( size == NULL ) )
+	{
+		return( -1 );
+	}
+	*size = LUKSDE_TEST_IO_CALLBACKS_DATA_SIZE;
+
+	return( 1 );
+}
+
+/* Tests the libluksde_io_callbacks_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_io_callbacks_read_buffer_at_offset(
+     void )
+{
+	uint8_t buffer[ 512 ];
+
+	libluksde_io_callbacks_t io_callbacks;
+
+	libcerror_error_t *error = NULL;
+	ssize_t read_count       = 0;
+	int user_data            = 0;
+
+	io_callbacks.read_at_offset = &luksde_test_io_callbacks_data_read_at_offset;
+	io_callbacks.get_size       = &luksde_test_io_callbacks_data_get_size;
+	io_callbacks.user_data      = &user_data;
+
+	/* Test regular cases
+	 */
+	read_count = libluksde_io_callbacks_read_buffer_at_offset(
+	              &io_callbacks,
+	              buffer,
+	              512,
+	              256,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 (uint8_t) 0 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 511 ]",
+	 buffer[ 511 ],
+	 (uint8_t) 255 );
+
+	/* Test reading beyond the end of the data
+	 */
+	read_count = libluksde_io_callbacks_read_buffer_at_offset(
+	              &io_callbacks,
+	              buffer,
+	              512,
+	              768,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 256 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libluksde_io_callbacks_read_buffer_at_offset(
+	              &io_callbacks,
+	              buffer,
+	              512,
+	              LUKSDE_TEST_IO_CALLBACKS_DATA_SIZE,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libluksde_io_callbacks_read_buffer_at_offset(
+	              NULL,
+	              buffer,
+	              512,
+	              0,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_io_callbacks_read_buffer_at_offset(
+	              &io_callbacks,
+	              NULL,
+	              512,
+	              0,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_io_callbacks_read_buffer_at_offset(
+	              &io_callbacks,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_io_callbacks_read_buffer_at_offset(
+	              &io_callbacks,
+	              buffer,
+	              512,
+	              -1,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a read at offset function that fails
+	 */
+	io_callbacks.read_at_offset = &luksde_test_io_callbacks_data_read_at_offset_fail;
+
+	read_count = libluksde_io_callbacks_read_buffer_at_offset(
+	              &io_callbacks,
+	              buffer,
+	              512,
+	              0,
+	              &error );
+
+	io_callbacks.read_at_offset = &luksde_test_io_callbacks_data_read_at_offset;
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a missing read at offset function
+	 */
+	io_callbacks.read_at_offset = NULL;
+
+	read_count = libluksde_io_callbacks_read_buffer_at_offset(
+	              &io_callbacks,
+	              buffer,
+	              512,
+	              0,
+	              &error );
+
+	io_callbacks.read_at_offset = &luksde_test_io_callbacks_data_read_at_offset;
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_io_callbacks_get_size function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_io_callbacks_get_size(
+     void )
+{
+	libluksde_io_callbacks_t io_callbacks;
+
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	int result               = 0;
+	int user_data            = 0;
+
+	io_callbacks.read_at_offset = &luksde_test_io_callbacks_data_read_at_offset;
+	io_callbacks.get_size       = &luksde_test_io_callbacks_data_get_size;
+	io_callbacks.user_data      = &user_data;
+
+	/* Test regular cases
+	 */
+	result = libluksde_io_callbacks_get_size(
+	          &io_callbacks,
+	          &size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 size,
+	 (uint64_t) LUKSDE_TEST_IO_CALLBACKS_DATA_SIZE );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_io_callbacks_get_size(
+	          NULL,
+	          &size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_io_callbacks_get_size(
+	          &io_callbacks,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with user data the get size function fails on
+	 */
+	io_callbacks.user_data = NULL;
+
+	result = libluksde_io_callbacks_get_size(
+	          &io_callbacks,
+	          &size,
+	          &error );
+
+	io_callbacks.user_data = &user_data;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_io_callbacks_read_buffer_at_offset",
+	 luksde_test_io_callbacks_read_buffer_at_offset );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_io_callbacks_get_size",
+	 luksde_test_io_callbacks_get_size );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+}
+
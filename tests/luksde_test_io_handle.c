@@ -33,6 +33,7 @@
 #include "luksde_test_memory.h"
 #include "luksde_test_unused.h"
 
+#include "../libluksde/libluksde_definitions.h"
 #include "../libluksde/libluksde_io_handle.h"
 
 #if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
@@ -398,6 +399,426 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libluksde_io_handle_set_device_io_values function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_io_handle_set_device_io_values(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libluksde_io_handle_t *io_handle = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_io_handle_set_device_io_values(
+	          io_handle,
+	          4096,
+	          65536,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+	 "io_handle->read_alignment_size",
+	 io_handle->read_alignment_size,
+	 (uint32_t) 65536 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "io_handle->maximum_sectors_read_size",
+	 io_handle->maximum_sectors_read_size,
+	 (size_t) LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE );
+
+	/* Test an optimal I/O size that is not a divisor of the maximum sectors read size
+	 */
+	result = libluksde_io_handle_set_device_io_values(
+	          io_handle,
+	          4096,
+	          786432,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+	 "io_handle->read_alignment_size",
+	 io_handle->read_alignment_size,
+	 (uint32_t) 786432 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "io_handle->maximum_sectors_read_size",
+	 io_handle->maximum_sectors_read_size,
+	 (size_t) 786432 );
+
+	/* Test a device without an optimal I/O size
+	 */
+	result = libluksde_io_handle_set_device_io_values(
+	          io_handle,
+	          4096,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+	 "io_handle->read_alignment_size",
+	 io_handle->read_alignment_size,
+	 (uint32_t) 4096 );
+
+	/* Test a device without I/O sizes
+	 */
+	result = libluksde_io_handle_set_device_io_values(
+	          io_handle,
+	          0,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+	 "io_handle->read_alignment_size",
+	 io_handle->read_alignment_size,
+	 (uint32_t) 0 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "io_handle->maximum_sectors_read_size",
+	 io_handle->maximum_sectors_read_size,
+	 (size_t) LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE );
+
+	/* Test error cases
+	 */
+	result = libluksde_io_handle_set_device_io_values(
+	          NULL,
+	          4096,
+	          65536,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libluksde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_io_handle_get_sectors_read_size function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_io_handle_get_sectors_read_size(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libluksde_io_handle_t *io_handle = NULL;
+	size_t read_size                 = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_size = 8192;
+
+	result = libluksde_io_handle_get_sectors_read_size(
+	          io_handle,
+	          4096,
+	          512,
+	          &read_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "read_size",
+	 read_size,
+	 (size_t) 8192 );
+
+	read_size = 2 * LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE;
+
+	result = libluksde_io_handle_get_sectors_read_size(
+	          io_handle,
+	          4096,
+	          512,
+	          &read_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "read_size",
+	 read_size,
+	 (size_t) LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE );
+
+	/* Test a split read that ends aligned to the optimal I/O size
+	 */
+	result = libluksde_io_handle_set_device_io_values(
+	          io_handle,
+	          4096,
+	          65536,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_size = 2 * LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE;
+
+	result = libluksde_io_handle_get_sectors_read_size(
+	          io_handle,
+	          4096,
+	          512,
+	          &read_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "read_size",
+	 read_size,
+	 (size_t) LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE - 4096 );
+
+	/* Test error cases
+	 */
+	result = libluksde_io_handle_get_sectors_read_size(
+	          NULL,
+	          4096,
+	          512,
+	          &read_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_io_handle_get_sectors_read_size(
+	          io_handle,
+	          -1,
+	          512,
+	          &read_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_io_handle_get_sectors_read_size(
+	          io_handle,
+	          4096,
+	          0,
+	          &read_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_io_handle_get_sectors_read_size(
+	          io_handle,
+	          4096,
+	          512,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libluksde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
 
 /* The main program
@@ -429,6 +850,14 @@ int main(
 	 "libluksde_io_handle_clear",
 	 luksde_test_io_handle_clear );
 
+	LUKSDE_TEST_RUN(
+	 "libluksde_io_handle_set_device_io_values",
+	 luksde_test_io_handle_set_device_io_values );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_io_handle_get_sectors_read_size",
+	 luksde_test_io_handle_get_sectors_read_size );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
@@ -0,0 +1,1051 @@
+/*
+ * Library io_uring type test program
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_memory.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_definitions.h"
+#include "../libluksde/libluksde_encryption_context.h"
+#include "../libluksde/libluksde_io_uring.h"
+#include "../libluksde/libluksde_sector_data_vector.h"
+
+#define LUKSDE_TEST_IO_URING_FILE	"luksde_test_io_uring.bin"
+
+/* The test data spans more chunks than there are fixed buffers
+ */
+#define LUKSDE_TEST_IO_URING_DATA_SIZE	( 1024 * 1024 )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* Creates the test data file
+ * Returns 1 if successful or -1 on error
+ */
+int luksde_test_io_uring_create_file(
+     const char *filename,
+     uint8_t *data,
+     size_t data_size )
+{
+	FILE *file_stream = NULL;
+	size_t data_index = 0;
+	int result        = 1;
+
+	for( data_index = 0;
+	     data_index < data_size;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) ( data_index / 512 ) + (uint8_t) data_index;
+	}
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_WRITE );
+
+	if( file_stream == NULL )
+	{
+		return( -1 );
+	}
+	if( file_stream_write(
+	     file_stream,
+	     data,
+	     data_size ) != data_size )
+	{
+		result = -1;
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		result = -1;
+	}
+	return( result );
+}
+
+/* Tests the libluksde_io_uring_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_io_uring_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libluksde_io_uring_t *io_uring  = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libluksde_io_uring_initialize(
+	          &io_uring,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "io_uring",
+	 io_uring );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_io_uring_free(
+	          &io_uring,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "io_uring",
+	 io_uring );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_io_uring_initialize(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	io_uring = (libluksde_io_uring_t *) 0x12345678UL;
+
+	result = libluksde_io_uring_initialize(
+	          &io_uring,
+	          &error );
+
+	io_uring = NULL;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_io_uring_initialize with malloc failing
+		 */
+		luksde_test_malloc_attempts_before_fail = test_number;
+
+		result = libluksde_io_uring_initialize(
+		          &io_uring,
+		          &error );
+
+		if( luksde_test_malloc_attempts_before_fail != -1 )
+		{
+			luksde_test_malloc_attempts_before_fail = -1;
+
+			if( io_uring != NULL )
+			{
+				libluksde_io_uring_free(
+				 &io_uring,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "io_uring",
+			 io_uring );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_io_uring_initialize with memset failing
+		 */
+		luksde_test_memset_attempts_before_fail = test_number;
+
+		result = libluksde_io_uring_initialize(
+		          &io_uring,
+		          &error );
+
+		if( luksde_test_memset_attempts_before_fail != -1 )
+		{
+			luksde_test_memset_attempts_before_fail = -1;
+
+			if( io_uring != NULL )
+			{
+				libluksde_io_uring_free(
+				 &io_uring,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "io_uring",
+			 io_uring );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_LUKSDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_uring != NULL )
+	{
+		libluksde_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_io_uring_free function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_io_uring_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libluksde_io_uring_free(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_io_uring_open function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_io_uring_open(
+     void )
+{
+	libcerror_error_t *error       = NULL;
+	libluksde_io_uring_t *io_uring = NULL;
+	int result                     = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_io_uring_initialize(
+	          &io_uring,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "io_uring",
+	 io_uring );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_io_uring_open(
+	          NULL,
+	          LUKSDE_TEST_IO_URING_FILE,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_io_uring_open(
+	          io_uring,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a file that does not exist, which is not an error
+	 * if io_uring is not supported
+	 */
+	result = libluksde_io_uring_open(
+	          io_uring,
+	          "luksde_test_io_uring_does_not_exist",
+	          &error );
+
+	LUKSDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	if( result == -1 )
+	{
+		LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Clean up
+	 */
+	result = libluksde_io_uring_free(
+	          &io_uring,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "io_uring",
+	 io_uring );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_uring != NULL )
+	{
+		libluksde_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_io_uring_queue_read, libluksde_io_uring_submit and libluksde_io_uring_get_completion functions
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_io_uring_read(
+     uint8_t *data )
+{
+	libcerror_error_t *error       = NULL;
+	libluksde_io_uring_t *io_uring = NULL;
+	uint8_t *buffer                = NULL;
+	size_t buffer_size             = 0;
+	ssize_t read_count             = 0;
+	int buffer_index               = 0;
+	int result                     = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_io_uring_initialize(
+	          &io_uring,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "io_uring",
+	 io_uring );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_io_uring_open(
+	          io_uring,
+	          LUKSDE_TEST_IO_URING_FILE,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result != 0 )
+	{
+		/* Test regular cases
+		 */
+		result = libluksde_io_uring_queue_read(
+		          io_uring,
+		          1,
+		          512,
+		          4096,
+		          1024,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libluksde_io_uring_submit(
+		          io_uring,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libluksde_io_uring_get_completion(
+		          io_uring,
+		          &buffer_index,
+		          &read_count,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "buffer_index",
+		 buffer_index,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 1024 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libluksde_io_uring_get_buffer(
+		          io_uring,
+		          buffer_index,
+		          &buffer,
+		          &buffer_size,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+		 "buffer_size",
+		 buffer_size,
+		 (size_t) LIBLUKSDE_IO_URING_BUFFER_SIZE );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          &( buffer[ 512 ] ),
+		          &( data[ 4096 ] ),
+		          1024 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* Test that the reads that are still outstanding are waited for
+		 */
+		for( buffer_index = 0;
+		     buffer_index < LIBLUKSDE_IO_URING_NUMBER_OF_BUFFERS;
+		     buffer_index++ )
+		{
+			result = libluksde_io_uring_queue_read(
+			          io_uring,
+			          buffer_index,
+			          0,
+			          (off64_t) buffer_index * LIBLUKSDE_IO_URING_BUFFER_SIZE,
+			          LIBLUKSDE_IO_URING_BUFFER_SIZE,
+			          &error );
+
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		result = libluksde_io_uring_wait_for_pending_reads(
+		          io_uring,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "io_uring->number_of_pending_reads",
+		 io_uring->number_of_pending_reads,
+		 0 );
+
+		/* Test error cases
+		 */
+		result = libluksde_io_uring_queue_read(
+		          NULL,
+		          0,
+		          0,
+		          0,
+		          512,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libluksde_io_uring_queue_read(
+		          io_uring,
+		          LIBLUKSDE_IO_URING_NUMBER_OF_BUFFERS,
+		          0,
+		          0,
+		          512,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libluksde_io_uring_queue_read(
+		          io_uring,
+		          0,
+		          512,
+		          0,
+		          LIBLUKSDE_IO_URING_BUFFER_SIZE,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libluksde_io_uring_get_completion(
+		          io_uring,
+		          &buffer_index,
+		          &read_count,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Clean up
+	 */
+	result = libluksde_io_uring_free(
+	          &io_uring,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "io_uring",
+	 io_uring );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_uring != NULL )
+	{
+		libluksde_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_sector_data_vector_read_sectors_with_io_uring function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_io_uring_read_sectors(
+     uint8_t *data )
+{
+	uint8_t *buffer                                    = NULL;
+	libcerror_error_t *error                           = NULL;
+	libluksde_io_uring_t *io_uring                     = NULL;
+	libluksde_sector_data_vector_t *sector_data_vector = NULL;
+	ssize_t read_count                                 = 0;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	buffer = (uint8_t *) memory_allocate(
+	                      LIBLUKSDE_MAXIMUM_SECTORS_READ_SIZE );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	result = libluksde_io_uring_initialize(
+	          &io_uring,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_io_uring_open(
+	          io_uring,
+	          LUKSDE_TEST_IO_URING_FILE,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result == 0 )
+	{
+		goto on_not_supported;
+	}
+	result = libluksde_sector_data_vector_initialize(
+	          &sector_data_vector,
+	          512,
+	          512,
+	          LUKSDE_TEST_IO_URING_DATA_SIZE - 512,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The read of the last chunk is shorter than the fixed buffers
+	 */
+	read_count = libluksde_sector_data_vector_read_sectors_with_io_uring(
+	              sector_data_vector,
+	              io_uring,
+	              NULL,
+	              1024,
+	              buffer,
+	              LUKSDE_TEST_IO_URING_DATA_SIZE - 2048,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) ( LUKSDE_TEST_IO_URING_DATA_SIZE - 2048 ) );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( data[ 512 + 1024 ] ),
+	          LUKSDE_TEST_IO_URING_DATA_SIZE - 2048 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	read_count = libluksde_sector_data_vector_read_sectors_with_io_uring(
+	              sector_data_vector,
+	              NULL,
+	              NULL,
+	              1024,
+	              buffer,
+	              2048,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_sector_data_vector_read_sectors_with_io_uring(
+	              sector_data_vector,
+	              io_uring,
+	              NULL,
+	              1000,
+	              buffer,
+	              2048,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_sector_data_vector_read_sectors_with_io_uring(
+	              sector_data_vector,
+	              io_uring,
+	              NULL,
+	              1024,
+	              buffer,
+	              LUKSDE_TEST_IO_URING_DATA_SIZE,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_sector_data_vector_free(
+	          &sector_data_vector,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+on_not_supported:
+	result = libluksde_io_uring_free(
+	          &io_uring,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_data_vector != NULL )
+	{
+		libluksde_sector_data_vector_free(
+		 &sector_data_vector,
+		 NULL );
+	}
+	if( io_uring != NULL )
+	{
+		libluksde_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+	uint8_t *data = NULL;
+#endif
+
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_io_uring_initialize",
+	 luksde_test_io_uring_initialize );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_io_uring_free",
+	 luksde_test_io_uring_free );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_io_uring_open",
+	 luksde_test_io_uring_open );
+
+	data = (uint8_t *) memory_allocate(
+	                    LUKSDE_TEST_IO_URING_DATA_SIZE );
+
+	if( data == NULL )
+	{
+		goto on_error;
+	}
+	if( luksde_test_io_uring_create_file(
+	     LUKSDE_TEST_IO_URING_FILE,
+	     data,
+	     LUKSDE_TEST_IO_URING_DATA_SIZE ) != 1 )
+	{
+		goto on_error;
+	}
+	LUKSDE_TEST_RUN_WITH_ARGS(
+	 "libluksde_io_uring_read",
+	 luksde_test_io_uring_read,
+	 data );
+
+	LUKSDE_TEST_RUN_WITH_ARGS(
+	 "libluksde_sector_data_vector_read_sectors_with_io_uring",
+	 luksde_test_io_uring_read_sectors,
+	 data );
+
+	remove(
+	 LUKSDE_TEST_IO_URING_FILE );
+
+	memory_free(
+	 data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+on_error:
+	remove(
+	 LUKSDE_TEST_IO_URING_FILE );
+
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,1486 @@
+/*
+ * Library json_tokenizer type test program
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_definitions.h"
+#include "../libluksde/libluksde_json_tokenizer.h"
+
+uint8_t luksde_test_json_tokenizer_data1[ 64 ] =
+	"{\"a\":[1,true,null],\"b\":{\"c\":\"x\\/y\"},\"d\":\"18446744073709551615\"}";
+
+uint8_t luksde_test_json_tokenizer_data2[ 17 ] =
+	"{\"a\":[1,],\"b\":2}";
+
+uint8_t luksde_test_json_tokenizer_data3[ 10 ] =
+	"{\"a\" \"b\"}";
+
+uint8_t luksde_test_json_tokenizer_data4[ 25 ] =
+	"{\"s\":\"AAECAwQFBgcICQ==\"}";
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* Tests the libluksde_json_tokenizer_set_data function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_json_tokenizer_set_data(
+     void )
+{
+	libluksde_json_tokenizer_t tokenizer;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libluksde_json_tokenizer_set_data(
+	          &tokenizer,
+	          luksde_test_json_tokenizer_data1,
+	          64,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_json_tokenizer_set_data(
+	          NULL,
+	          luksde_test_json_tokenizer_data1,
+	          64,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_json_tokenizer_set_data(
+	          &tokenizer,
+	          NULL,
+	          63,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_json_tokenizer_set_data(
+	          &tokenizer,
+	          luksde_test_json_tokenizer_data1,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_json_tokenizer_get_next_token function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_json_tokenizer_get_next_token(
+     void )
+{
+	libluksde_json_token_t token;
+	libluksde_json_tokenizer_t tokenizer;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_json_tokenizer_set_data(
+	          &tokenizer,
+	          luksde_test_json_tokenizer_data1,
+	          64,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "token.type",
+	 token.type,
+	 LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_START );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "token.type",
+	 token.type,
+	 LIBLUKSDE_JSON_TOKEN_TYPE_STRING );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "token.is_key",
+	 token.is_key,
+	 1 );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "token.type",
+	 token.type,
+	 LIBLUKSDE_JSON_TOKEN_TYPE_ARRAY_START );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "token.type",
+	 token.type,
+	 LIBLUKSDE_JSON_TOKEN_TYPE_NUMBER );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "token.type",
+	 token.type,
+	 LIBLUKSDE_JSON_TOKEN_TYPE_TRUE );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "token.type",
+	 token.type,
+	 LIBLUKSDE_JSON_TOKEN_TYPE_NULL );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "token.type",
+	 token.type,
+	 LIBLUKSDE_JSON_TOKEN_TYPE_ARRAY_END );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "token.type",
+	 token.type,
+	 LIBLUKSDE_JSON_TOKEN_TYPE_STRING );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "token.type",
+	 token.type,
+	 LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_START );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "token.type",
+	 token.type,
+	 LIBLUKSDE_JSON_TOKEN_TYPE_STRING );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "token.type",
+	 token.type,
+	 LIBLUKSDE_JSON_TOKEN_TYPE_STRING );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "token.type",
+	 token.type,
+	 LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_END );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "token.type",
+	 token.type,
+	 LIBLUKSDE_JSON_TOKEN_TYPE_STRING );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "token.type",
+	 token.type,
+	 LIBLUKSDE_JSON_TOKEN_TYPE_STRING );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "token.type",
+	 token.type,
+	 LIBLUKSDE_JSON_TOKEN_TYPE_OBJECT_END );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_json_tokenizer_get_next_token(
+	          NULL,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where a value is missing
+	 */
+	result = libluksde_json_tokenizer_set_data(
+	          &tokenizer,
+	          luksde_test_json_tokenizer_data2,
+	          17,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where a name separator is missing
+	 */
+	result = libluksde_json_tokenizer_set_data(
+	          &tokenizer,
+	          luksde_test_json_tokenizer_data3,
+	          10,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_json_tokenizer_get_next_member function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_json_tokenizer_get_next_member(
+     void )
+{
+	libluksde_json_token_t key_token;
+	libluksde_json_token_t value_token;
+	libluksde_json_tokenizer_t tokenizer;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_json_tokenizer_set_data(
+	          &tokenizer,
+	          luksde_test_json_tokenizer_data1,
+	          64,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &key_token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_json_tokenizer_get_next_member(
+	          &tokenizer,
+	          &key_token,
+	          &value_token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "value_token.type",
+	 value_token.type,
+	 LIBLUKSDE_JSON_TOKEN_TYPE_ARRAY_START );
+
+	result = libluksde_json_tokenizer_skip_value(
+	          &tokenizer,
+	          &value_token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_member(
+	          &tokenizer,
+	          &key_token,
+	          &value_token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_skip_value(
+	          &tokenizer,
+	          &value_token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_member(
+	          &tokenizer,
+	          &key_token,
+	          &value_token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "value_token.type",
+	 value_token.type,
+	 LIBLUKSDE_JSON_TOKEN_TYPE_STRING );
+
+	result = libluksde_json_tokenizer_get_next_member(
+	          &tokenizer,
+	          &key_token,
+	          &value_token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_json_tokenizer_skip_value(
+	          &tokenizer,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_json_token_compare_string, libluksde_json_token_copy_string and libluksde_json_token_get_integer_value functions
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_json_token_values(
+     void )
+{
+	uint8_t string[ 16 ];
+
+	libluksde_json_token_t token;
+	libluksde_json_tokenizer_t tokenizer;
+
+	libcerror_error_t *error = NULL;
+	uint64_t integer_value   = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_json_tokenizer_set_data(
+	          &tokenizer,
+	          luksde_test_json_tokenizer_data1,
+	          64,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_json_token_compare_string(
+	          &token,
+	          "c",
+	          1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_token_compare_string(
+	          &token,
+	          "d",
+	          1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_token_copy_string(
+	          &token,
+	          string,
+	          16,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          string,
+	          "x/y",
+	          4 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libluksde_json_token_copy_string(
+	          &token,
+	          string,
+	          3,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_json_token_get_integer_value(
+	          &token,
+	          &integer_value,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_json_token_get_integer_value(
+	          &token,
+	          &integer_value,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "integer_value",
+	 integer_value,
+	 (uint64_t) 0xffffffffffffffffULL );
+
+	/* Test error cases
+	 */
+	result = libluksde_json_token_get_integer_value(
+	          NULL,
+	          &integer_value,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_json_token_get_integer_value(
+	          &token,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_json_token_compare_string(
+	          NULL,
+	          "d",
+	          1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_json_token_get_base64_value function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_json_token_get_base64_value(
+     void )
+{
+	uint8_t data[ 16 ];
+
+	libluksde_json_token_t token;
+	libluksde_json_tokenizer_t tokenizer;
+
+	libcerror_error_t *error = NULL;
+	size_t data_size         = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_json_tokenizer_set_data(
+	          &tokenizer,
+	          luksde_test_json_tokenizer_data4,
+	          25,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_json_token_get_base64_value(
+	          &token,
+	          data,
+	          16,
+	          &data_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) 10 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+	 "data[ 9 ]",
+	 data[ 9 ],
+	 0x09 );
+
+	/* Test error cases
+	 */
+	result = libluksde_json_token_get_base64_value(
+	          &token,
+	          NULL,
+	          16,
+	          &data_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_json_token_get_base64_value(
+	          &token,
+	          data,
+	          8,
+	          &data_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_json_token_get_base64_value(
+	          &token,
+	          data,
+	          16,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_json_tokenizer_set_data",
+	 luksde_test_json_tokenizer_set_data );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_json_tokenizer_get_next_token",
+	 luksde_test_json_tokenizer_get_next_token );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_json_tokenizer_get_next_member",
+	 luksde_test_json_tokenizer_get_next_member );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_json_token_values",
+	 luksde_test_json_token_values );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_json_token_get_base64_value",
+	 luksde_test_json_token_get_base64_value );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+}
+
@@ -33,6 +33,8 @@
 #include "luksde_test_memory.h"
 #include "luksde_test_unused.h"
 
+#include "../libluksde/libluksde_definitions.h"
+#include "../libluksde/libluksde_json_tokenizer.h"
 #include "../libluksde/libluksde_key_slot.h"
 
 uint8_t luksde_test_key_slot_data1[ 48 ] = {
@@ -40,6 +42,15 @@ uint8_t luksde_test_key_slot_data1[ 48 ] = {
 	0x98, 0x84, 0x3b, 0x6e, 0x6b, 0x1c, 0x45, 0x2e, 0xab, 0x91, 0x2b, 0xd9, 0xa3, 0xc6, 0x84, 0x9d,
 	0xb1, 0xa0, 0x1c, 0xb1, 0x30, 0x69, 0xeb, 0x5a, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x0f, 0xa0 };
 
+uint8_t luksde_test_key_slot_json_data1[ 309 ] =
+	"{\"type\":\"luks2\",\"key_size\":64,\"priority\":2,\"af\":{\"type\":\"luks1\",\"stripes\":4000,\"hash\":\"sha256\"},\"area\":{\"type\":\"raw\",\"offset\":\"32768\",\"size\":\"258048\",\"encryption\":\"aes-xts-plain64\",\"key_size\":64},\"kdf\":{\"type\":\"pbkdf2\",\"hash\":\"sha256\",\"iterations\":1000,\"salt\":\"AAECAwQFBgcICQoLDA0ODxAREhMUFRYXGBkaGxwdHh8=\"}}";
+
+uint8_t luksde_test_key_slot_json_data2[ 47 ] =
+	"{\"type\":\"reencrypt\",\"key_size\":1,\"priority\":3}";
+
+uint8_t luksde_test_key_slot_json_data3[ 75 ] =
+	"{\"type\":\"reencrypt\",\"key_size\":1,\"mode\":\"reencrypt\",\"direction\":\"backward\"}";
+
 #if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
 
 /* Tests the libluksde_key_slot_initialize function
@@ -77,6 +88,11 @@ int luksde_test_key_slot_initialize(
 	 "error",
 	 error );
 
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "key_slot->priority",
+	 key_slot->priority,
+	 LIBLUKSDE_KEY_SLOT_PRIORITY_NORMAL );
+
 	result = libluksde_key_slot_free(
 	          &key_slot,
 	          &error );
@@ -431,6 +447,276 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libluksde_key_slot_read_json_object function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_key_slot_read_json_object(
+     void )
+{
+	libluksde_json_token_t token;
+	libluksde_json_tokenizer_t tokenizer;
+
+	libcerror_error_t *error       = NULL;
+	libluksde_key_slot_t *key_slot = NULL;
+	int result                     = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_key_slot_initialize(
+	          &key_slot,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "key_slot",
+	 key_slot );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_set_data(
+	          &tokenizer,
+	          luksde_test_key_slot_json_data1,
+	          309,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_key_slot_read_json_object(
+	          key_slot,
+	          &tokenizer,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "key_slot->type",
+	 key_slot->type,
+	 LIBLUKSDE_KEY_SLOT_TYPE_LUKS2 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+	 "key_slot->state",
+	 key_slot->state,
+	 (uint32_t) LIBLUKSDE_KEY_SLOT_STATE_ACTIVE );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "key_slot->priority",
+	 key_slot->priority,
+	 LIBLUKSDE_KEY_SLOT_PRIORITY_PREFER );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+	 "key_slot->key_size",
+	 key_slot->key_size,
+	 64 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "key_slot->key_derivation_function",
+	 key_slot->key_derivation_function,
+	 LIBLUKSDE_KEY_DERIVATION_FUNCTION_TYPE_PBKDF2 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+	 "key_slot->number_of_stripes",
+	 key_slot->number_of_stripes,
+	 4000 );
+
+	/* Test error cases
+	 */
+	result = libluksde_key_slot_read_json_object(
+	          NULL,
+	          &tokenizer,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the priority is not supported
+	 */
+	result = libluksde_json_tokenizer_set_data(
+	          &tokenizer,
+	          luksde_test_key_slot_json_data2,
+	          47,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_key_slot_read_json_object(
+	          key_slot,
+	          &tokenizer,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test reencrypt key slot
+	 */
+	result = libluksde_json_tokenizer_set_data(
+	          &tokenizer,
+	          luksde_test_key_slot_json_data3,
+	          75,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_json_tokenizer_get_next_token(
+	          &tokenizer,
+	          &token,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_key_slot_read_json_object(
+	          key_slot,
+	          &tokenizer,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "key_slot->type",
+	 key_slot->type,
+	 LIBLUKSDE_KEY_SLOT_TYPE_REENCRYPT );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "key_slot->reencryption_mode",
+	 key_slot->reencryption_mode,
+	 LIBLUKSDE_REENCRYPTION_MODE_REENCRYPT );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "key_slot->reencryption_direction",
+	 key_slot->reencryption_direction,
+	 LIBLUKSDE_REENCRYPTION_DIRECTION_BACKWARD );
+
+	/* Clean up
+	 */
+	result = libluksde_key_slot_free(
+	          &key_slot,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "key_slot",
+	 key_slot );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( key_slot != NULL )
+	{
+		libluksde_key_slot_free(
+		 &key_slot,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
 
 /* The main program
@@ -462,6 +748,10 @@ int main(
 	 "libluksde_key_slot_read_data",
 	 luksde_test_key_slot_read_data );
 
+	LUKSDE_TEST_RUN(
+	 "libluksde_key_slot_read_json_object",
+	 luksde_test_key_slot_read_json_object );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
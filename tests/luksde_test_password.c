@@ -35,6 +35,7 @@
 
 #include "../libluksde/libluksde_definitions.h"
 #include "../libluksde/libluksde_password.h"
+#include "../libluksde/libluksde_sha.h"
 
 typedef struct luksde_test_password_pbkdf2_test_vector luksde_test_password_pbkdf2_test_vector_t;
 
@@ -79,6 +80,261 @@ struct luksde_test_password_pbkdf2_test_vector
 
 #if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
 
+/* Tests the libluksde_password_calculate_hmac function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_password_calculate_hmac(
+     void )
+{
+	uint8_t hmac[ 32 ];
+	uint8_t inner_padded_key_block[ 64 ];
+	uint8_t outer_padded_key_block[ 64 ];
+
+	/* RFC 4231 test case 2 HMAC-SHA-256
+	 */
+	uint8_t expected_hmac[ 32 ] = {
+		0x5b, 0xdc, 0xc1, 0x46, 0xbf, 0x60, 0x75, 0x4e, 0x6a, 0x04, 0x24, 0x26, 0x08, 0x95, 0x75, 0xc7,
+		0x5a, 0x00, 0x3f, 0x08, 0x9d, 0x27, 0x39, 0x83, 0x9d, 0xec, 0x58, 0xb9, 0x64, 0xec, 0x38, 0x43 };
+
+	libluksde_sha_context_t inner_context;
+	libluksde_sha_context_t outer_context;
+
+	libcerror_error_t *error = NULL;
+	const char *key          = "Jefe";
+	const char *message      = "what do ya want for nothing?";
+	size_t byte_index        = 0;
+	int result               = 0;
+
+	for( byte_index = 0;
+	     byte_index < 64;
+	     byte_index++ )
+	{
+		if( byte_index < 4 )
+		{
+			inner_padded_key_block[ byte_index ] = (uint8_t) key[ byte_index ] ^ 0x36;
+			outer_padded_key_block[ byte_index ] = (uint8_t) key[ byte_index ] ^ 0x5c;
+		}
+		else
+		{
+			inner_padded_key_block[ byte_index ] = 0x36;
+			outer_padded_key_block[ byte_index ] = 0x5c;
+		}
+	}
+	result = libluksde_sha_initialize(
+	          &inner_context,
+	          LIBLUKSDE_HASHING_METHOD_SHA256,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_sha_update(
+	          &inner_context,
+	          inner_padded_key_block,
+	          64,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_sha_initialize(
+	          &outer_context,
+	          LIBLUKSDE_HASHING_METHOD_SHA256,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_sha_update(
+	          &outer_context,
+	          outer_padded_key_block,
+	          64,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_password_calculate_hmac(
+	          &inner_context,
+	          &outer_context,
+	          (uint8_t *) message,
+	          28,
+	          hmac,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          hmac,
+	          expected_hmac,
+	          32 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* The contexts are not modified hence the HMAC can be calculated again
+	 */
+	result = libluksde_password_calculate_hmac(
+	          &inner_context,
+	          &outer_context,
+	          (uint8_t *) message,
+	          28,
+	          hmac,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          hmac,
+	          expected_hmac,
+	          32 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libluksde_password_calculate_hmac(
+	          NULL,
+	          &outer_context,
+	          (uint8_t *) message,
+	          28,
+	          hmac,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_calculate_hmac(
+	          &inner_context,
+	          NULL,
+	          (uint8_t *) message,
+	          28,
+	          hmac,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_calculate_hmac(
+	          &inner_context,
+	          &outer_context,
+	          (uint8_t *) message,
+	          28,
+	          NULL,
+	          32,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_password_calculate_hmac(
+	          &inner_context,
+	          &outer_context,
+	          (uint8_t *) message,
+	          28,
+	          hmac,
+	          16,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libluksde_password_pbkdf2 function
  * Returns 1 if successful or 0 if not
  */
@@ -479,6 +735,10 @@ int main(
 
 #if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
 
+	LUKSDE_TEST_RUN(
+	 "libluksde_password_calculate_hmac",
+	 luksde_test_password_calculate_hmac );
+
 	LUKSDE_TEST_RUN(
 	 "libluksde_password_pbkdf2",
 	 luksde_test_password_pbkdf2 );
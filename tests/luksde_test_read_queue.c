@@ -0,0 +1,536 @@
+/*
+ * Library read_queue type test program
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_memory.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_read_queue.h"
+#include "../libluksde/libluksde_read_request.h"
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) && defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+
+#define LUKSDE_TEST_READ_QUEUE_NUMBER_OF_READ_REQUESTS	64
+
+/* Read function for the read queue tests
+ * Fills the buffer with the lower byte of the offset
+ * Returns 1 if successful or -1 on error
+ */
+int luksde_test_read_queue_read_function(
+     libluksde_volume_t *volume LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     libluksde_read_request_t *read_request,
+     libcerror_error_t **error LUKSDE_TEST_ATTRIBUTE_UNUSED )
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( volume )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( memory_set(
+	     read_request->buffer,
+	     (int) ( read_request->offset & 0xff ),
+	     read_request->buffer_size ) == NULL )
+	{
+		return( -1 );
+	}
+	read_request->read_count = (ssize_t) read_request->buffer_size;
+
+	return( 1 );
+}
+
+/* Callback function for the read queue tests
+ * The callback functions are not called concurrently hence no locking is needed
+ */
+void luksde_test_read_queue_callback(
+     libluksde_volume_t *volume LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     void *buffer LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     ssize_t read_count,
+     void *user_data )
+{
+	int *number_of_bytes_read = (int *) user_data;
+
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( volume )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( buffer )
+
+	*number_of_bytes_read += (int) read_count;
+}
+
+/* Tests the libluksde_read_queue_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_read_queue_initialize(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libluksde_read_queue_t *read_queue = NULL;
+	int result                         = 0;
+
+	/* Test regular cases
+	 */
+	result = libluksde_read_queue_initialize(
+	          &read_queue,
+	          NULL,
+	          &luksde_test_read_queue_read_function,
+	          2,
+	          4,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "read_queue",
+	 read_queue );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_read_queue_free(
+	          &read_queue,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "read_queue",
+	 read_queue );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_read_queue_initialize(
+	          NULL,
+	          NULL,
+	          &luksde_test_read_queue_read_function,
+	          2,
+	          4,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_queue = (libluksde_read_queue_t *) 0x12345678UL;
+
+	result = libluksde_read_queue_initialize(
+	          &read_queue,
+	          NULL,
+	          &luksde_test_read_queue_read_function,
+	          2,
+	          4,
+	          &error );
+
+	read_queue = NULL;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_read_queue_initialize(
+	          &read_queue,
+	          NULL,
+	          NULL,
+	          2,
+	          4,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_read_queue_initialize(
+	          &read_queue,
+	          NULL,
+	          &luksde_test_read_queue_read_function,
+	          0,
+	          4,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_read_queue_initialize(
+	          &read_queue,
+	          NULL,
+	          &luksde_test_read_queue_read_function,
+	          2,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_queue != NULL )
+	{
+		libluksde_read_queue_free(
+		 &read_queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_read_queue_free function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_read_queue_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libluksde_read_queue_free(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_read_queue_push_read_request function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_read_queue_push_read_request(
+     void )
+{
+	uint8_t buffer[ LUKSDE_TEST_READ_QUEUE_NUMBER_OF_READ_REQUESTS * 16 ];
+
+	libcerror_error_t *error               = NULL;
+	libluksde_read_queue_t *read_queue     = NULL;
+	libluksde_read_request_t *read_request = NULL;
+	size_t buffer_offset                   = 0;
+	int number_of_bytes_read               = 0;
+	int read_request_index                 = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_read_queue_initialize(
+	          &read_queue,
+	          NULL,
+	          &luksde_test_read_queue_read_function,
+	          2,
+	          4,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "read_queue",
+	 read_queue );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( read_request_index = 0;
+	     read_request_index < LUKSDE_TEST_READ_QUEUE_NUMBER_OF_READ_REQUESTS;
+	     read_request_index++ )
+	{
+		result = libluksde_read_request_initialize(
+		          &read_request,
+		          &( buffer[ read_request_index * 16 ] ),
+		          16,
+		          (off64_t) read_request_index,
+		          &luksde_test_read_queue_callback,
+		          (void *) &number_of_bytes_read,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libluksde_read_queue_push_read_request(
+		          read_queue,
+		          read_request,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_request = NULL;
+	}
+	result = libluksde_read_queue_wait(
+	          read_queue,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_bytes_read",
+	 number_of_bytes_read,
+	 LUKSDE_TEST_READ_QUEUE_NUMBER_OF_READ_REQUESTS * 16 );
+
+	for( buffer_offset = 0;
+	     buffer_offset < LUKSDE_TEST_READ_QUEUE_NUMBER_OF_READ_REQUESTS * 16;
+	     buffer_offset++ )
+	{
+		LUKSDE_TEST_ASSERT_EQUAL_UINT8(
+		 "buffer[ buffer_offset ]",
+		 buffer[ buffer_offset ],
+		 (uint8_t) ( buffer_offset / 16 ) );
+	}
+	/* Test error cases
+	 */
+	result = libluksde_read_queue_push_read_request(
+	          NULL,
+	          read_request,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_read_queue_push_read_request(
+	          read_queue,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_read_queue_wait(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_read_queue_free(
+	          &read_queue,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "read_queue",
+	 read_queue );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_queue != NULL )
+	{
+		libluksde_read_queue_free(
+		 &read_queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) && defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) && defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_read_queue_initialize",
+	 luksde_test_read_queue_initialize );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_read_queue_free",
+	 luksde_test_read_queue_free );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_read_queue_push_read_request",
+	 luksde_test_read_queue_push_read_request );
+
+	/* TODO: add tests for libluksde_read_queue_process_read_request */
+
+	/* TODO: add tests for libluksde_read_queue_complete_read_request */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) && defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) && defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) && defined( HAVE_LIBLUKSDE_MULTI_THREAD_SUPPORT ) */
+}
+
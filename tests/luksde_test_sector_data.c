@@ -452,6 +452,7 @@ int luksde_test_sector_data_read_file_io_handle(
 	result = libluksde_sector_data_read_file_io_handle(
 	          sector_data,
 	          file_io_handle,
+	          NULL,
 	          0,
 	          encryption_context,
 	          0,
@@ -466,41 +467,37 @@ int luksde_test_sector_data_read_file_io_handle(
 	 "error",
 	 error );
 
-	/* Test error cases
+	/* Test unencrypted data without encryption context
 	 */
 	result = libluksde_sector_data_read_file_io_handle(
-	          NULL,
+	          sector_data,
 	          file_io_handle,
+	          NULL,
 	          0,
-	          encryption_context,
+	          NULL,
 	          0,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	LUKSDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	data              = sector_data->data;
-	sector_data->data = NULL;
-
+	/* Test error cases
+	 */
 	result = libluksde_sector_data_read_file_io_handle(
-	          sector_data,
+	          NULL,
 	          file_io_handle,
+	          NULL,
 	          0,
 	          encryption_context,
 	          0,
 	          &error );
 
-	sector_data->data = data;
-
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
@@ -513,14 +510,20 @@ int luksde_test_sector_data_read_file_io_handle(
 	libcerror_error_free(
 	 &error );
 
+	data              = sector_data->data;
+	sector_data->data = NULL;
+
 	result = libluksde_sector_data_read_file_io_handle(
 	          sector_data,
+	          file_io_handle,
 	          NULL,
 	          0,
 	          encryption_context,
 	          0,
 	          &error );
 
+	sector_data->data = data;
+
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
@@ -535,8 +538,9 @@ int luksde_test_sector_data_read_file_io_handle(
 
 	result = libluksde_sector_data_read_file_io_handle(
 	          sector_data,
-	          file_io_handle,
-	          -1,
+	          NULL,
+	          NULL,
+	          0,
 	          encryption_context,
 	          0,
 	          &error );
@@ -556,8 +560,9 @@ int luksde_test_sector_data_read_file_io_handle(
 	result = libluksde_sector_data_read_file_io_handle(
 	          sector_data,
 	          file_io_handle,
-	          0,
 	          NULL,
+	          -1,
+	          encryption_context,
 	          0,
 	          &error );
 
@@ -582,6 +587,7 @@ int luksde_test_sector_data_read_file_io_handle(
 	result = libluksde_sector_data_read_file_io_handle(
 	          sector_data,
 	          file_io_handle,
+	          NULL,
 	          0,
 	          encryption_context,
 	          0,
@@ -646,6 +652,7 @@ int luksde_test_sector_data_read_file_io_handle(
 	result = libluksde_sector_data_read_file_io_handle(
 	          sector_data,
 	          file_io_handle,
+	          NULL,
 	          0,
 	          encryption_context,
 	          0,
@@ -22,6 +22,7 @@
 #include <common.h>
 #include <byte_stream.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -64,6 +65,45 @@ int luksde_test_sector_data_vector_initialize(
 	          512,
 	          0,
 	          4096,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_data_vector",
+	 sector_data_vector );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_sector_data_vector_free(
+	          &sector_data_vector,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "sector_data_vector",
+	 sector_data_vector );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_sector_data_vector_initialize(
+	          &sector_data_vector,
+	          4096,
+	          0,
+	          8192,
+	          2048,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
@@ -79,6 +119,16 @@ int luksde_test_sector_data_vector_initialize(
 	 "error",
 	 error );
 
+	LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+	 "sector_data_vector->bytes_per_sector",
+	 sector_data_vector->bytes_per_sector,
+	 (uint32_t) 4096 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "sector_data_vector->initialization_vector_tweak",
+	 sector_data_vector->initialization_vector_tweak,
+	 (uint64_t) 2048 );
+
 	result = libluksde_sector_data_vector_free(
 	          &sector_data_vector,
 	          &error );
@@ -103,6 +153,7 @@ int luksde_test_sector_data_vector_initialize(
 	          512,
 	          0,
 	          4096,
+	          0,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
@@ -124,6 +175,7 @@ int luksde_test_sector_data_vector_initialize(
 	          512,
 	          0,
 	          4096,
+	          0,
 	          &error );
 
 	sector_data_vector = NULL;
@@ -140,6 +192,46 @@ int luksde_test_sector_data_vector_initialize(
 	libcerror_error_free(
 	 &error );
 
+	result = libluksde_sector_data_vector_initialize(
+	          &sector_data_vector,
+	          1000,
+	          0,
+	          4096,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_sector_data_vector_initialize(
+	          &sector_data_vector,
+	          8192,
+	          0,
+	          4096,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
 #if defined( HAVE_LUKSDE_TEST_MEMORY )
 
 	for( test_number = 0;
@@ -155,6 +247,7 @@ int luksde_test_sector_data_vector_initialize(
 		          512,
 		          0,
 		          4096,
+		          0,
 		          &error );
 
 		if( luksde_test_malloc_attempts_before_fail != -1 )
@@ -200,6 +293,7 @@ int luksde_test_sector_data_vector_initialize(
 		          512,
 		          0,
 		          4096,
+		          0,
 		          &error );
 
 		if( luksde_test_memset_attempts_before_fail != -1 )
@@ -289,34 +383,814 @@ on_error:
 	return( 0 );
 }
 
-#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
-
-/* The main program
+/* Tests the libluksde_sector_data_vector_read_sectors_at_offset function
+ * Returns 1 if successful or 0 if not
  */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-int wmain(
-     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
-     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
-#else
-int main(
-     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
-     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
-#endif
+int luksde_test_sector_data_vector_read_sectors_at_offset(
+     void )
 {
-	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
-	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+	uint8_t buffer[ 2048 ];
+	uint8_t data[ 4096 ];
 
-#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+	libbfio_handle_t *file_io_handle                   = NULL;
+	libcerror_error_t *error                           = NULL;
+	libluksde_sector_data_vector_t *sector_data_vector = NULL;
+	size_t data_offset                                 = 0;
+	ssize_t read_count                                 = 0;
+	int result                                         = 0;
 
-	LUKSDE_TEST_RUN(
-	 "libluksde_sector_data_vector_initialize",
-	 luksde_test_sector_data_vector_initialize );
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 4096;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( data_offset / 512 ) + (uint8_t) data_offset;
+	}
+	result = luksde_test_open_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          4096,
+	          &error );
 
-	LUKSDE_TEST_RUN(
-	 "libluksde_sector_data_vector_free",
-	 luksde_test_sector_data_vector_free );
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	/* TODO add tests for libluksde_sector_data_vector_get_sector_data_at_offset */
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_sector_data_vector_initialize(
+	          &sector_data_vector,
+	          512,
+	          0,
+	          4096,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_data_vector",
+	 sector_data_vector );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_count = libluksde_sector_data_vector_read_sectors_at_offset(
+	              sector_data_vector,
+	              file_io_handle,
+	              NULL,
+	              NULL,
+	              NULL,
+	              1024,
+	              buffer,
+	              2048,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 2048 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( data[ 1024 ] ),
+	          2048 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	read_count = libluksde_sector_data_vector_read_sectors_at_offset(
+	              NULL,
+	              file_io_handle,
+	              NULL,
+	              NULL,
+	              NULL,
+	              1024,
+	              buffer,
+	              2048,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_sector_data_vector_read_sectors_at_offset(
+	              sector_data_vector,
+	              file_io_handle,
+	              NULL,
+	              NULL,
+	              NULL,
+	              1000,
+	              buffer,
+	              2048,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_sector_data_vector_read_sectors_at_offset(
+	              sector_data_vector,
+	              file_io_handle,
+	              NULL,
+	              NULL,
+	              NULL,
+	              1024,
+	              NULL,
+	              2048,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_sector_data_vector_read_sectors_at_offset(
+	              sector_data_vector,
+	              file_io_handle,
+	              NULL,
+	              NULL,
+	              NULL,
+	              1024,
+	              buffer,
+	              1000,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_sector_data_vector_read_sectors_at_offset(
+	              sector_data_vector,
+	              file_io_handle,
+	              NULL,
+	              NULL,
+	              NULL,
+	              3072,
+	              buffer,
+	              2048,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_sector_data_vector_free(
+	          &sector_data_vector,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "sector_data_vector",
+	 sector_data_vector );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = luksde_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_data_vector != NULL )
+	{
+		libluksde_sector_data_vector_free(
+		 &sector_data_vector,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_sector_data_vector_read_encrypted_sectors_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_sector_data_vector_read_encrypted_sectors_at_offset(
+     void )
+{
+	uint8_t buffer[ 2048 ];
+	uint8_t data[ 4096 ];
+
+	libbfio_handle_t *file_io_handle                   = NULL;
+	libcerror_error_t *error                           = NULL;
+	libluksde_sector_data_vector_t *sector_data_vector = NULL;
+	size_t data_offset                                 = 0;
+	ssize_t read_count                                 = 0;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 4096;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( data_offset / 512 ) + (uint8_t) data_offset;
+	}
+	result = luksde_test_open_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_sector_data_vector_initialize(
+	          &sector_data_vector,
+	          512,
+	          0,
+	          4096,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_data_vector",
+	 sector_data_vector );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_count = libluksde_sector_data_vector_read_encrypted_sectors_at_offset(
+	              sector_data_vector,
+	              file_io_handle,
+	              NULL,
+	              1024,
+	              buffer,
+	              2048,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 2048 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( data[ 1024 ] ),
+	          2048 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	read_count = libluksde_sector_data_vector_read_encrypted_sectors_at_offset(
+	              NULL,
+	              file_io_handle,
+	              NULL,
+	              1024,
+	              buffer,
+	              2048,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_sector_data_vector_read_encrypted_sectors_at_offset(
+	              sector_data_vector,
+	              file_io_handle,
+	              NULL,
+	              1000,
+	              buffer,
+	              2048,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_sector_data_vector_read_encrypted_sectors_at_offset(
+	              sector_data_vector,
+	              file_io_handle,
+	              NULL,
+	              1024,
+	              NULL,
+	              2048,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_sector_data_vector_read_encrypted_sectors_at_offset(
+	              sector_data_vector,
+	              file_io_handle,
+	              NULL,
+	              1024,
+	              buffer,
+	              1000,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_sector_data_vector_read_encrypted_sectors_at_offset(
+	              sector_data_vector,
+	              file_io_handle,
+	              NULL,
+	              3072,
+	              buffer,
+	              2048,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_sector_data_vector_free(
+	          &sector_data_vector,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "sector_data_vector",
+	 sector_data_vector );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = luksde_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_data_vector != NULL )
+	{
+		libluksde_sector_data_vector_free(
+		 &sector_data_vector,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_sector_data_vector_decrypt_sectors_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_sector_data_vector_decrypt_sectors_at_offset(
+     void )
+{
+	uint8_t buffer[ 2048 ];
+	uint8_t data[ 2048 ];
+
+	libcerror_error_t *error                           = NULL;
+	libluksde_sector_data_vector_t *sector_data_vector = NULL;
+	size_t data_offset                                 = 0;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 2048;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( data_offset / 512 ) + (uint8_t) data_offset;
+	}
+	result = libluksde_sector_data_vector_initialize(
+	          &sector_data_vector,
+	          512,
+	          0,
+	          4096,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_data_vector",
+	 sector_data_vector );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_sector_data_vector_decrypt_sectors_at_offset(
+	          sector_data_vector,
+	          NULL,
+	          1024,
+	          data,
+	          2048,
+	          buffer,
+	          2048,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          data,
+	          2048 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libluksde_sector_data_vector_decrypt_sectors_at_offset(
+	          NULL,
+	          NULL,
+	          1024,
+	          data,
+	          2048,
+	          buffer,
+	          2048,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_sector_data_vector_decrypt_sectors_at_offset(
+	          sector_data_vector,
+	          NULL,
+	          1000,
+	          data,
+	          2048,
+	          buffer,
+	          2048,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_sector_data_vector_decrypt_sectors_at_offset(
+	          sector_data_vector,
+	          NULL,
+	          1024,
+	          NULL,
+	          2048,
+	          buffer,
+	          2048,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_sector_data_vector_decrypt_sectors_at_offset(
+	          sector_data_vector,
+	          NULL,
+	          1024,
+	          data,
+	          1000,
+	          buffer,
+	          2048,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_sector_data_vector_decrypt_sectors_at_offset(
+	          sector_data_vector,
+	          NULL,
+	          1024,
+	          data,
+	          2048,
+	          NULL,
+	          2048,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_sector_data_vector_decrypt_sectors_at_offset(
+	          sector_data_vector,
+	          NULL,
+	          1024,
+	          data,
+	          2048,
+	          buffer,
+	          1024,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_sector_data_vector_free(
+	          &sector_data_vector,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "sector_data_vector",
+	 sector_data_vector );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_data_vector != NULL )
+	{
+		libluksde_sector_data_vector_free(
+		 &sector_data_vector,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_sector_data_vector_initialize",
+	 luksde_test_sector_data_vector_initialize );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_sector_data_vector_free",
+	 luksde_test_sector_data_vector_free );
+
+	/* TODO add tests for libluksde_sector_data_vector_get_sector_data_at_offset */
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_sector_data_vector_read_sectors_at_offset",
+	 luksde_test_sector_data_vector_read_sectors_at_offset );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_sector_data_vector_read_encrypted_sectors_at_offset",
+	 luksde_test_sector_data_vector_read_encrypted_sectors_at_offset );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_sector_data_vector_decrypt_sectors_at_offset",
+	 luksde_test_sector_data_vector_decrypt_sectors_at_offset );
 
 #endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
 
@@ -0,0 +1,1076 @@
+/*
+ * Library segment_map type test program
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_memory.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_definitions.h"
+#include "../libluksde/libluksde_segment_map.h"
+#include "../libluksde/libluksde_volume_header.h"
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* Tests the libluksde_segment_map_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_segment_map_initialize(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libluksde_segment_map_t *segment_map = NULL;
+	int result                           = 0;
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests      = 2;
+	int number_of_memset_fail_tests      = 1;
+	int test_number                      = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libluksde_segment_map_initialize(
+	          &segment_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_map",
+	 segment_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_segment_map_free(
+	          &segment_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "segment_map",
+	 segment_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_segment_map_initialize(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	segment_map = (libluksde_segment_map_t *) 0x12345678UL;
+
+	result = libluksde_segment_map_initialize(
+	          &segment_map,
+	          &error );
+
+	segment_map = NULL;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_segment_map_initialize with malloc failing
+		 */
+		luksde_test_malloc_attempts_before_fail = test_number;
+
+		result = libluksde_segment_map_initialize(
+		          &segment_map,
+		          &error );
+
+		if( luksde_test_malloc_attempts_before_fail != -1 )
+		{
+			luksde_test_malloc_attempts_before_fail = -1;
+
+			if( segment_map != NULL )
+			{
+				libluksde_segment_map_free(
+				 &segment_map,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "segment_map",
+			 segment_map );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_segment_map_initialize with memset failing
+		 */
+		luksde_test_memset_attempts_before_fail = test_number;
+
+		result = libluksde_segment_map_initialize(
+		          &segment_map,
+		          &error );
+
+		if( luksde_test_memset_attempts_before_fail != -1 )
+		{
+			luksde_test_memset_attempts_before_fail = -1;
+
+			if( segment_map != NULL )
+			{
+				libluksde_segment_map_free(
+				 &segment_map,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "segment_map",
+			 segment_map );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_LUKSDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_map != NULL )
+	{
+		libluksde_segment_map_free(
+		 &segment_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_segment_map_free function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_segment_map_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libluksde_segment_map_free(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Appends an entry to a segment map
+ * Returns 1 if successful or -1 on error
+ */
+int luksde_test_segment_map_append_test_entry(
+     libluksde_segment_map_t *segment_map,
+     int type,
+     off64_t file_offset,
+     size64_t size,
+     uint32_t sector_size,
+     libcerror_error_t **error )
+{
+	libluksde_segment_map_entry_t *segment_map_entry = NULL;
+
+	if( libluksde_segment_map_entry_initialize(
+	     &segment_map_entry,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	segment_map_entry->type        = type;
+	segment_map_entry->file_offset = file_offset;
+	segment_map_entry->size        = size;
+	segment_map_entry->sector_size = sector_size;
+
+	if( libluksde_segment_map_append_entry(
+	     segment_map,
+	     segment_map_entry,
+	     error ) != 1 )
+	{
+		libluksde_segment_map_entry_free(
+		 &segment_map_entry,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libluksde_segment_map_append_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_segment_map_append_entry(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libluksde_segment_map_t *segment_map = NULL;
+	int number_of_entries                = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_segment_map_initialize(
+	          &segment_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_map",
+	 segment_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = luksde_test_segment_map_append_test_entry(
+	          segment_map,
+	          LIBLUKSDE_SEGMENT_TYPE_CRYPT,
+	          16777216,
+	          8192,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = luksde_test_segment_map_append_test_entry(
+	          segment_map,
+	          LIBLUKSDE_SEGMENT_TYPE_LINEAR,
+	          32768,
+	          1536,
+	          512,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "segment_map->size",
+	 segment_map->size,
+	 (uint64_t) 9728 );
+
+	result = libluksde_segment_map_get_number_of_entries(
+	          segment_map,
+	          &number_of_entries,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 2 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_segment_map_append_entry(
+	          NULL,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_segment_map_append_entry(
+	          segment_map,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the size is not a multiple of the sector size
+	 */
+	result = luksde_test_segment_map_append_test_entry(
+	          segment_map,
+	          LIBLUKSDE_SEGMENT_TYPE_CRYPT,
+	          65536,
+	          6144,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the sector size is not supported
+	 */
+	result = luksde_test_segment_map_append_test_entry(
+	          segment_map,
+	          LIBLUKSDE_SEGMENT_TYPE_CRYPT,
+	          65536,
+	          8192,
+	          8192,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_segment_map_free(
+	          &segment_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "segment_map",
+	 segment_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_map != NULL )
+	{
+		libluksde_segment_map_free(
+		 &segment_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_segment_map_read_volume_header function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_segment_map_read_volume_header(
+     void )
+{
+	libcerror_error_t *error                         = NULL;
+	libluksde_segment_map_t *segment_map             = NULL;
+	libluksde_segment_map_entry_t *segment_map_entry = NULL;
+	libluksde_volume_header_t *volume_header         = NULL;
+	int result                                       = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_volume_header_initialize(
+	          &volume_header,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume_header",
+	 volume_header );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	volume_header->format_version                = 1;
+	volume_header->encrypted_volume_start_sector = 4096;
+	volume_header->encryption_method             = LIBLUKSDE_ENCRYPTION_METHOD_AES;
+	volume_header->encryption_chaining_mode      = LIBLUKSDE_ENCRYPTION_CHAINING_MODE_XTS;
+	volume_header->initialization_vector_mode    = LIBLUKSDE_INITIALIZATION_VECTOR_MODE_PLAIN64;
+
+	result = libluksde_segment_map_initialize(
+	          &segment_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_map",
+	 segment_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_segment_map_read_volume_header(
+	          segment_map,
+	          volume_header,
+	          2097152 + 4608 + 100,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "segment_map->size",
+	 segment_map->size,
+	 (uint64_t) 4608 );
+
+	result = libluksde_segment_map_get_entry_at_offset(
+	          segment_map,
+	          4607,
+	          &segment_map_entry,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_map_entry",
+	 segment_map_entry );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "segment_map_entry->file_offset",
+	 (int64_t) segment_map_entry->file_offset,
+	 (int64_t) 2097152 );
+
+	/* Test error cases
+	 */
+	result = libluksde_segment_map_read_volume_header(
+	          NULL,
+	          volume_header,
+	          2097152 + 4608,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_segment_map_read_volume_header(
+	          segment_map,
+	          NULL,
+	          2097152 + 4608,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the segment map was already read
+	 */
+	result = libluksde_segment_map_read_volume_header(
+	          segment_map,
+	          volume_header,
+	          2097152 + 4608,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the encrypted volume starts beyond the end of the file
+	 */
+	result = libluksde_segment_map_free(
+	          &segment_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_segment_map_initialize(
+	          &segment_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_segment_map_read_volume_header(
+	          segment_map,
+	          volume_header,
+	          2097152,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_segment_map_free(
+	          &segment_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "segment_map",
+	 segment_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_header_free(
+	          &volume_header,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "volume_header",
+	 volume_header );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_map != NULL )
+	{
+		libluksde_segment_map_free(
+		 &segment_map,
+		 NULL );
+	}
+	if( volume_header != NULL )
+	{
+		libluksde_volume_header_free(
+		 &volume_header,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_segment_map_get_entry_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_segment_map_get_entry_at_offset(
+     void )
+{
+	libcerror_error_t *error                         = NULL;
+	libluksde_segment_map_t *segment_map             = NULL;
+	libluksde_segment_map_entry_t *segment_map_entry = NULL;
+	int result                                       = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_segment_map_initialize(
+	          &segment_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_map",
+	 segment_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = luksde_test_segment_map_append_test_entry(
+	          segment_map,
+	          LIBLUKSDE_SEGMENT_TYPE_CRYPT,
+	          16777216,
+	          8192,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = luksde_test_segment_map_append_test_entry(
+	          segment_map,
+	          LIBLUKSDE_SEGMENT_TYPE_LINEAR,
+	          32768,
+	          1536,
+	          512,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = luksde_test_segment_map_append_test_entry(
+	          segment_map,
+	          LIBLUKSDE_SEGMENT_TYPE_CRYPT,
+	          25165824,
+	          4096,
+	          512,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_segment_map_get_entry_at_offset(
+	          segment_map,
+	          0,
+	          &segment_map_entry,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_map_entry",
+	 segment_map_entry );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "segment_map_entry->file_offset",
+	 (int64_t) segment_map_entry->file_offset,
+	 (int64_t) 16777216 );
+
+	result = libluksde_segment_map_get_entry_at_offset(
+	          segment_map,
+	          8192,
+	          &segment_map_entry,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "segment_map_entry->volume_offset",
+	 (int64_t) segment_map_entry->volume_offset,
+	 (int64_t) 8192 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "segment_map_entry->type",
+	 segment_map_entry->type,
+	 LIBLUKSDE_SEGMENT_TYPE_LINEAR );
+
+	result = libluksde_segment_map_get_entry_at_offset(
+	          segment_map,
+	          13823,
+	          &segment_map_entry,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "segment_map_entry->file_offset",
+	 (int64_t) segment_map_entry->file_offset,
+	 (int64_t) 25165824 );
+
+	result = libluksde_segment_map_get_entry_at_offset(
+	          segment_map,
+	          13824,
+	          &segment_map_entry,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_segment_map_get_entry_at_offset(
+	          NULL,
+	          0,
+	          &segment_map_entry,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_segment_map_get_entry_at_offset(
+	          segment_map,
+	          0,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_segment_map_free(
+	          &segment_map,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "segment_map",
+	 segment_map );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_map != NULL )
+	{
+		libluksde_segment_map_free(
+		 &segment_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_segment_map_initialize",
+	 luksde_test_segment_map_initialize );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_segment_map_free",
+	 luksde_test_segment_map_free );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_segment_map_append_entry",
+	 luksde_test_segment_map_append_entry );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_segment_map_read_volume_header",
+	 luksde_test_segment_map_read_volume_header );
+
+	/* TODO add tests for libluksde_segment_map_set_key */
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_segment_map_get_entry_at_offset",
+	 luksde_test_segment_map_get_entry_at_offset );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+}
+
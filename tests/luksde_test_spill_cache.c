@@ -0,0 +1,1082 @@
+/*
+ * Library spill_cache type test program
+ *
+ * Copyright (C) 2013-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "luksde_test_libbfio.h"
+#include "luksde_test_libcerror.h"
+#include "luksde_test_libluksde.h"
+#include "luksde_test_macros.h"
+#include "luksde_test_memory.h"
+#include "luksde_test_unused.h"
+
+#include "../libluksde/libluksde_spill_cache.h"
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+/* Tests the libluksde_spill_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_spill_cache_initialize(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libluksde_spill_cache_t *spill_cache = NULL;
+	int result                           = 0;
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests      = 1;
+	int number_of_memset_fail_tests      = 1;
+	int test_number                      = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libluksde_spill_cache_initialize(
+	          &spill_cache,
+	          1024 * 1024,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "spill_cache",
+	 spill_cache );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_spill_cache_free(
+	          &spill_cache,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "spill_cache",
+	 spill_cache );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_spill_cache_initialize(
+	          NULL,
+	          1024 * 1024,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	spill_cache = (libluksde_spill_cache_t *) 0x12345678UL;
+
+	result = libluksde_spill_cache_initialize(
+	          &spill_cache,
+	          1024 * 1024,
+	          &error );
+
+	spill_cache = NULL;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_spill_cache_initialize(
+	          &spill_cache,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_LUKSDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_spill_cache_initialize with malloc failing
+		 */
+		luksde_test_malloc_attempts_before_fail = test_number;
+
+		result = libluksde_spill_cache_initialize(
+		          &spill_cache,
+		          1024 * 1024,
+		          &error );
+
+		if( luksde_test_malloc_attempts_before_fail != -1 )
+		{
+			luksde_test_malloc_attempts_before_fail = -1;
+
+			if( spill_cache != NULL )
+			{
+				libluksde_spill_cache_free(
+				 &spill_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "spill_cache",
+			 spill_cache );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libluksde_spill_cache_initialize with memset failing
+		 */
+		luksde_test_memset_attempts_before_fail = test_number;
+
+		result = libluksde_spill_cache_initialize(
+		          &spill_cache,
+		          1024 * 1024,
+		          &error );
+
+		if( luksde_test_memset_attempts_before_fail != -1 )
+		{
+			luksde_test_memset_attempts_before_fail = -1;
+
+			if( spill_cache != NULL )
+			{
+				libluksde_spill_cache_free(
+				 &spill_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			LUKSDE_TEST_ASSERT_IS_NULL(
+			 "spill_cache",
+			 spill_cache );
+
+			LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_LUKSDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( spill_cache != NULL )
+	{
+		libluksde_spill_cache_free(
+		 &spill_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_spill_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_spill_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libluksde_spill_cache_free(
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_spill_cache_open function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_spill_cache_open(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libluksde_spill_cache_t *spill_cache = NULL;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_spill_cache_initialize(
+	          &spill_cache,
+	          1024,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "spill_cache",
+	 spill_cache );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_spill_cache_open(
+	          NULL,
+	          512,
+	          8192,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libluksde_spill_cache_open without a spill file name
+	 */
+	result = libluksde_spill_cache_open(
+	          spill_cache,
+	          512,
+	          8192,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_spill_cache_set_name(
+	          spill_cache,
+	          "spill",
+	          5,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_spill_cache_open(
+	          spill_cache,
+	          0,
+	          8192,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libluksde_spill_cache_open with a maximum size smaller than the chunk size
+	 */
+	result = libluksde_spill_cache_open(
+	          spill_cache,
+	          2048,
+	          8192,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_spill_cache_free(
+	          &spill_cache,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "spill_cache",
+	 spill_cache );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( spill_cache != NULL )
+	{
+		libluksde_spill_cache_free(
+		 &spill_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_spill_cache_move_slot_to_front, libluksde_spill_cache_remove_slot_index
+ * and libluksde_spill_cache_get_slot_by_chunk_number functions
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_spill_cache_get_slot_by_chunk_number(
+     void )
+{
+	libluksde_spill_cache_t spill_cache;
+
+	uint64_t slot_chunk_numbers[ 4 ];
+	uint8_t chunk_bitmap[ 8 ];
+	int previous_slots[ 4 ];
+	int next_slots[ 4 ];
+	int slot_index_hash_table[ 8 ];
+
+	libcerror_error_t *error = NULL;
+	uint64_t chunk_number    = 0;
+	int hash_table_index     = 0;
+	int result               = 0;
+	int slot_index           = 0;
+
+	/* Initialize test
+	 * Chunks 3, 11, 19 and 27 are stored in slots 0 to 3
+	 */
+	result = 0;
+
+	if( memory_set(
+	     &spill_cache,
+	     0,
+	     sizeof( libluksde_spill_cache_t ) ) != NULL )
+	{
+		result = 1;
+	}
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = 0;
+
+	if( memory_set(
+	     chunk_bitmap,
+	     0,
+	     sizeof( uint8_t ) * 8 ) != NULL )
+	{
+		result = 1;
+	}
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	for( hash_table_index = 0;
+	     hash_table_index < 8;
+	     hash_table_index++ )
+	{
+		slot_index_hash_table[ hash_table_index ] = -1;
+	}
+	spill_cache.chunk_size                 = 512;
+	spill_cache.number_of_chunks           = 64;
+	spill_cache.chunk_bitmap               = chunk_bitmap;
+	spill_cache.maximum_number_of_slots    = 4;
+	spill_cache.slot_chunk_numbers         = slot_chunk_numbers;
+	spill_cache.previous_slots             = previous_slots;
+	spill_cache.next_slots                 = next_slots;
+	spill_cache.most_recently_used_slot    = -1;
+	spill_cache.least_recently_used_slot   = -1;
+	spill_cache.free_slot                  = -1;
+	spill_cache.slot_index_hash_table      = slot_index_hash_table;
+	spill_cache.slot_index_hash_table_size = 8;
+	spill_cache.is_open                    = 1;
+
+	for( slot_index = 0;
+	     slot_index < 4;
+	     slot_index++ )
+	{
+		chunk_number = 3 + ( (uint64_t) slot_index * 8 );
+
+		slot_chunk_numbers[ slot_index ] = chunk_number;
+		previous_slots[ slot_index ]     = -1;
+		next_slots[ slot_index ]         = -1;
+
+		hash_table_index = libluksde_spill_cache_get_hash_table_index(
+		                    &spill_cache,
+		                    chunk_number );
+
+		LUKSDE_TEST_ASSERT_GREATER_THAN_INT(
+		 "hash_table_index",
+		 hash_table_index,
+		 -1 );
+
+		LUKSDE_TEST_ASSERT_LESS_THAN_INT(
+		 "hash_table_index",
+		 hash_table_index,
+		 8 );
+
+		while( slot_index_hash_table[ hash_table_index ] != -1 )
+		{
+			hash_table_index = ( hash_table_index + 1 ) & 7;
+		}
+		slot_index_hash_table[ hash_table_index ] = slot_index;
+
+		chunk_bitmap[ chunk_number / 8 ] |= (uint8_t) ( 1 << ( chunk_number % 8 ) );
+
+		libluksde_spill_cache_move_slot_to_front(
+		 &spill_cache,
+		 slot_index );
+
+		spill_cache.number_of_slots += 1;
+	}
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "spill_cache.most_recently_used_slot",
+	 spill_cache.most_recently_used_slot,
+	 3 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "spill_cache.least_recently_used_slot",
+	 spill_cache.least_recently_used_slot,
+	 0 );
+
+	/* Test regular cases
+	 */
+	for( slot_index = 0;
+	     slot_index < 4;
+	     slot_index++ )
+	{
+		result = libluksde_spill_cache_get_slot_by_chunk_number(
+		          &spill_cache,
+		          slot_chunk_numbers[ slot_index ],
+		          &hash_table_index,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "hash_table_index",
+		 hash_table_index,
+		 slot_index );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libluksde_spill_cache_get_slot_by_chunk_number(
+	          &spill_cache,
+	          4,
+	          &slot_index,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test moving the least recently used slot to the front
+	 */
+	libluksde_spill_cache_move_slot_to_front(
+	 &spill_cache,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "spill_cache.most_recently_used_slot",
+	 spill_cache.most_recently_used_slot,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "spill_cache.least_recently_used_slot",
+	 spill_cache.least_recently_used_slot,
+	 1 );
+
+	/* Test removing a slot from the hash table, the other slots must remain reachable
+	 */
+	libluksde_spill_cache_remove_slot_index(
+	 &spill_cache,
+	 slot_chunk_numbers[ 1 ] );
+
+	chunk_bitmap[ slot_chunk_numbers[ 1 ] / 8 ] &= (uint8_t) ~( 1 << ( slot_chunk_numbers[ 1 ] % 8 ) );
+
+	result = libluksde_spill_cache_get_slot_by_chunk_number(
+	          &spill_cache,
+	          slot_chunk_numbers[ 1 ],
+	          &slot_index,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( slot_index = 0;
+	     slot_index < 4;
+	     slot_index++ )
+	{
+		if( slot_index == 1 )
+		{
+			continue;
+		}
+		result = libluksde_spill_cache_get_slot_by_chunk_number(
+		          &spill_cache,
+		          slot_chunk_numbers[ slot_index ],
+		          &hash_table_index,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "hash_table_index",
+		 hash_table_index,
+		 slot_index );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libluksde_spill_cache_get_slot_by_chunk_number(
+	          NULL,
+	          3,
+	          &slot_index,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_spill_cache_get_slot_by_chunk_number(
+	          &spill_cache,
+	          64,
+	          &slot_index,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_spill_cache_get_slot_by_chunk_number(
+	          &spill_cache,
+	          3,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_spill_cache_write_chunk_data and libluksde_spill_cache_read_chunk_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_spill_cache_write_chunk_data(
+     void )
+{
+	uint8_t chunk_data[ 3 ][ 512 ];
+	uint8_t read_data[ 512 ];
+
+	libcerror_error_t *error             = NULL;
+	libluksde_spill_cache_t *spill_cache = NULL;
+	uint64_t chunk_number                = 0;
+	int result                           = 0;
+	int slot_index                       = 0;
+
+	for( chunk_number = 0;
+	     chunk_number < 3;
+	     chunk_number++ )
+	{
+		result = 0;
+
+		if( memory_set(
+		     chunk_data[ chunk_number ],
+		     (int) ( 'a' + chunk_number ),
+		     512 ) != NULL )
+		{
+			result = 1;
+		}
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		chunk_data[ chunk_number ][ 0 ] = (uint8_t) chunk_number;
+	}
+	/* Remove a spill file left behind by a previous test run
+	 */
+	remove(
+	 "luksde_test_spill_cache.bin" );
+
+	/* Initialize test
+	 */
+	result = libluksde_spill_cache_initialize(
+	          &spill_cache,
+	          2 * 512,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "spill_cache",
+	 spill_cache );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_spill_cache_set_name(
+	          spill_cache,
+	          "luksde_test_spill_cache.bin",
+	          27,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_spill_cache_open(
+	          spill_cache,
+	          512,
+	          4 * 512,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "spill_cache->maximum_number_of_slots",
+	 spill_cache->maximum_number_of_slots,
+	 2 );
+
+	/* Test regular cases
+	 */
+	for( chunk_number = 0;
+	     chunk_number < 3;
+	     chunk_number++ )
+	{
+		result = libluksde_spill_cache_write_chunk_data(
+		          spill_cache,
+		          chunk_number,
+		          chunk_data[ chunk_number ],
+		          512,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* The least recently used chunk 0 was evicted by chunk 2
+	 */
+	result = libluksde_spill_cache_get_slot_by_chunk_number(
+	          spill_cache,
+	          0,
+	          &slot_index,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_spill_cache_read_chunk_data(
+	          spill_cache,
+	          0,
+	          0,
+	          read_data,
+	          512,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( chunk_number = 1;
+	     chunk_number < 3;
+	     chunk_number++ )
+	{
+		result = libluksde_spill_cache_read_chunk_data(
+		          spill_cache,
+		          chunk_number,
+		          0,
+		          read_data,
+		          512,
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          read_data,
+		          chunk_data[ chunk_number ],
+		          512 );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test reading part of a chunk
+	 */
+	result = libluksde_spill_cache_read_chunk_data(
+	          spill_cache,
+	          1,
+	          256,
+	          read_data,
+	          256,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          read_data,
+	          &( chunk_data[ 1 ][ 256 ] ),
+	          256 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libluksde_spill_cache_write_chunk_data(
+	          spill_cache,
+	          3,
+	          chunk_data[ 0 ],
+	          256,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_spill_cache_close(
+	          spill_cache,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_spill_cache_free(
+	          &spill_cache,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "spill_cache",
+	 spill_cache );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( spill_cache != NULL )
+	{
+		libluksde_spill_cache_free(
+		 &spill_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] LUKSDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argc )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_spill_cache_initialize",
+	 luksde_test_spill_cache_initialize );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_spill_cache_free",
+	 luksde_test_spill_cache_free );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_spill_cache_open",
+	 luksde_test_spill_cache_open );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_spill_cache_get_slot_by_chunk_number",
+	 luksde_test_spill_cache_get_slot_by_chunk_number );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_spill_cache_write_chunk_data",
+	 luksde_test_spill_cache_write_chunk_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT ) */
+}
+
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -43,6 +44,7 @@
 #include "luksde_test_libluksde.h"
 #include "luksde_test_macros.h"
 #include "luksde_test_memory.h"
+#include "luksde_test_unused.h"
 
 #include "../libluksde/libluksde_volume.h"
 
@@ -56,6 +58,10 @@
 
 #define LUKSDE_TEST_VOLUME_READ_BUFFER_SIZE	4096
 
+#define LUKSDE_TEST_VOLUME_NUMBER_OF_ASYNC_READS	16
+
+#define LUKSDE_TEST_VOLUME_NUMBER_OF_VECTORS		8
+
 #if !defined( LIBLUKSDE_HAVE_BFIO )
 
 LIBLUKSDE_EXTERN \
@@ -70,6 +76,14 @@ int libluksde_volume_open_file_io_handle(
      int access_flags,
      libluksde_error_t **error );
 
+LIBLUKSDE_EXTERN \
+int libluksde_volume_open_file_io_handles(
+     libluksde_volume_t *volume,
+     libbfio_handle_t *header_file_io_handle,
+     libbfio_handle_t *data_file_io_handle,
+     int access_flags,
+     libluksde_error_t **error );
+
 #endif /* !defined( LIBLUKSDE_HAVE_BFIO ) */
 
 /* Creates and opens a source volume
@@ -1127,58 +1141,106 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libluksde_volume_close function
+/* Tests the libluksde_volume_open_file_io_handles function
  * Returns 1 if successful or 0 if not
  */
-int luksde_test_volume_close(
-     void )
+int luksde_test_volume_open_file_io_handles(
+     const system_character_t *source,
+     const system_character_t *password )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	libbfio_handle_t *data_file_io_handle   = NULL;
+	libbfio_handle_t *header_file_io_handle = NULL;
+	libcerror_error_t *error                = NULL;
+	libluksde_volume_t *volume              = NULL;
+	size_t string_length                    = 0;
+	int result                              = 0;
 
-	/* Test error cases
+	/* Initialize test
 	 */
-	result = libluksde_volume_close(
-	          NULL,
+	result = libbfio_file_initialize(
+	          &header_file_io_handle,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "header_file_io_handle",
+	 header_file_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	result = libbfio_file_initialize(
+	          &data_file_io_handle,
+	          &error );
 
-	return( 1 );
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "data_file_io_handle",
+	 data_file_io_handle );
 
-/* Tests the libluksde_volume_open and libluksde_volume_close functions
- * Returns 1 if successful or 0 if not
- */
-int luksde_test_volume_open_close(
-     const system_character_t *source,
-     const system_character_t *password )
-{
-	libcerror_error_t *error   = NULL;
-	libluksde_volume_t *volume = NULL;
-	size_t string_length       = 0;
-	int result                 = 0;
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* Initialize test
+	string_length = system_string_length(
+	                 source );
+
+	/* The source contains both the header and the data hence it is used
+	 * for both file IO handles
 	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_set_name_wide(
+	          header_file_io_handle,
+	          source,
+	          string_length,
+	          &error );
+#else
+	result = libbfio_file_set_name(
+	          header_file_io_handle,
+	          source,
+	          string_length,
+	          &error );
+#endif
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_set_name_wide(
+	          data_file_io_handle,
+	          source,
+	          string_length,
+	          &error );
+#else
+	result = libbfio_file_set_name(
+	          data_file_io_handle,
+	          source,
+	          string_length,
+	          &error );
+#endif
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libluksde_volume_initialize(
 	          &volume,
 	          &error );
@@ -1219,63 +1281,115 @@ int luksde_test_volume_open_close(
 		 result,
 		 1 );
 
-	        LUKSDE_TEST_ASSERT_IS_NULL(
-	         "error",
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
 		 error );
 	}
-	/* Test open and close
+	/* Test error cases
 	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libluksde_volume_open_wide(
-	          volume,
-	          source,
+	result = libluksde_volume_open_file_io_handles(
+	          NULL,
+	          header_file_io_handle,
+	          data_file_io_handle,
 	          LIBLUKSDE_OPEN_READ,
 	          &error );
-#else
-	result = libluksde_volume_open(
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_open_file_io_handles(
 	          volume,
-	          source,
+	          NULL,
+	          data_file_io_handle,
 	          LIBLUKSDE_OPEN_READ,
 	          &error );
-#endif
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	LUKSDE_TEST_ASSERT_IS_NULL(
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	result = libluksde_volume_close(
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_open_file_io_handles(
 	          volume,
+	          header_file_io_handle,
+	          NULL,
+	          LIBLUKSDE_OPEN_READ,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
+	 -1 );
 
-	LUKSDE_TEST_ASSERT_IS_NULL(
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Test open and close a second time to validate clean up on close
-	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libluksde_volume_open_wide(
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_open_file_io_handles(
 	          volume,
-	          source,
+	          header_file_io_handle,
+	          header_file_io_handle,
 	          LIBLUKSDE_OPEN_READ,
 	          &error );
-#else
-	result = libluksde_volume_open(
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_open_file_io_handles(
 	          volume,
-	          source,
+	          header_file_io_handle,
+	          data_file_io_handle,
+	          -1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test open
+	 */
+	result = libluksde_volume_open_file_io_handles(
+	          volume,
+	          header_file_io_handle,
+	          data_file_io_handle,
 	          LIBLUKSDE_OPEN_READ,
 	          &error );
-#endif
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
@@ -1286,6 +1400,29 @@ int luksde_test_volume_open_close(
 	 "error",
 	 error );
 
+	/* Test open when already opened
+	 */
+	result = libluksde_volume_open_file_io_handles(
+	          volume,
+	          header_file_io_handle,
+	          data_file_io_handle,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test close
+	 */
 	result = libluksde_volume_close(
 	          volume,
 	          &error );
@@ -1318,6 +1455,40 @@ int luksde_test_volume_open_close(
 	 "error",
 	 error );
 
+	result = libbfio_handle_free(
+	          &data_file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "data_file_io_handle",
+	 data_file_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &header_file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "header_file_io_handle",
+	 header_file_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	return( 1 );
 
 on_error:
@@ -1332,30 +1503,690 @@ on_error:
 		 &volume,
 		 NULL );
 	}
+	if( data_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &data_file_io_handle,
+		 NULL );
+	}
+	if( header_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &header_file_io_handle,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* Tests the libluksde_volume_signal_abort function
+/* Tests the libluksde_volume_close function
  * Returns 1 if successful or 0 if not
  */
-int luksde_test_volume_signal_abort(
-     libluksde_volume_t *volume )
+int luksde_test_volume_close(
+     void )
 {
 	libcerror_error_t *error = NULL;
 	int result               = 0;
 
-	/* Test regular cases
+	/* Test error cases
 	 */
-	result = libluksde_volume_signal_abort(
-	          volume,
+	result = libluksde_volume_close(
+	          NULL,
 	          &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	LUKSDE_TEST_ASSERT_IS_NULL(
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Reads data at a specific offset from the file IO handle in the user data
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t luksde_test_volume_io_callbacks_read_at_offset(
+         void *user_data,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset )
+{
+	return( libbfio_handle_read_buffer_at_offset(
+	         (libbfio_handle_t *) user_data,
+	         buffer,
+	         size,
+	         offset,
+	         NULL ) );
+}
+
+/* Retrieves the size of the file IO handle in the user data
+ * Returns 1 if successful or -1 on error
+ */
+int luksde_test_volume_io_callbacks_get_size(
+     void *user_data,
+     size64_t *size )
+{
+	return( libbfio_handle_get_size(
+	         (libbfio_handle_t *) user_data,
+	         size,
+	         NULL ) );
+}
+
+/* Tests the libluksde_volume_open_io_callbacks function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_open_io_callbacks(
+     const system_character_t *source,
+     const system_character_t *password )
+{
+	uint8_t buffer[ LUKSDE_TEST_VOLUME_READ_BUFFER_SIZE ];
+
+	libluksde_io_callbacks_t io_callbacks;
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libluksde_volume_t *volume       = NULL;
+	size_t string_length             = 0;
+	ssize_t read_count               = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libbfio_file_initialize(
+	          &file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	string_length = system_string_length(
+	                 source );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_set_name_wide(
+	          file_io_handle,
+	          source,
+	          string_length,
+	          &error );
+#else
+	result = libbfio_file_set_name(
+	          file_io_handle,
+	          source,
+	          string_length,
+	          &error );
+#endif
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_callbacks.read_at_offset = &luksde_test_volume_io_callbacks_read_at_offset;
+	io_callbacks.get_size       = &luksde_test_volume_io_callbacks_get_size;
+	io_callbacks.user_data      = (void *) file_io_handle;
+
+	result = libluksde_volume_initialize(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( password != NULL )
+	{
+		string_length = system_string_length(
+		                 password );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libluksde_volume_set_utf16_password(
+		          volume,
+		          (uint16_t *) password,
+		          string_length,
+		          &error );
+#else
+		result = libluksde_volume_set_utf8_password(
+		          volume,
+		          (uint8_t *) password,
+		          string_length,
+		          &error );
+#endif
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        LUKSDE_TEST_ASSERT_IS_NULL(
+	         "error",
+		 error );
+	}
+	/* Test open
+	 */
+	result = libluksde_volume_open_io_callbacks(
+	          volume,
+	          &io_callbacks,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_is_locked(
+	          volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result == 0 )
+	{
+		/* Test read using the I/O callbacks
+		 */
+		read_count = libluksde_volume_read_buffer_at_offset(
+		              volume,
+		              buffer,
+		              LUKSDE_TEST_VOLUME_READ_BUFFER_SIZE,
+		              0,
+		              &error );
+
+		LUKSDE_TEST_ASSERT_NOT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libluksde_volume_open_io_callbacks(
+	          NULL,
+	          &io_callbacks,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_open_io_callbacks(
+	          volume,
+	          NULL,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	io_callbacks.get_size = NULL;
+
+	result = libluksde_volume_open_io_callbacks(
+	          volume,
+	          &io_callbacks,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+
+	io_callbacks.get_size = &luksde_test_volume_io_callbacks_get_size;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_open_io_callbacks(
+	          volume,
+	          &io_callbacks,
+	          LIBLUKSDE_OPEN_READ_MEMORY_MAPPED,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test open when already opened
+	 */
+	result = libluksde_volume_open_io_callbacks(
+	          volume,
+	          &io_callbacks,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_volume_free(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libluksde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_volume_open and libluksde_volume_close functions
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_open_close(
+     const system_character_t *source,
+     const system_character_t *password )
+{
+	libcerror_error_t *error   = NULL;
+	libluksde_volume_t *volume = NULL;
+	size64_t size              = 0;
+	size_t string_length       = 0;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_volume_initialize(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( password != NULL )
+	{
+		string_length = system_string_length(
+		                 password );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libluksde_volume_set_utf16_password(
+		          volume,
+		          (uint16_t *) password,
+		          string_length,
+		          &error );
+#else
+		result = libluksde_volume_set_utf8_password(
+		          volume,
+		          (uint8_t *) password,
+		          string_length,
+		          &error );
+#endif
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        LUKSDE_TEST_ASSERT_IS_NULL(
+	         "error",
+		 error );
+	}
+	/* Test open and close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libluksde_volume_open_wide(
+	          volume,
+	          source,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+#else
+	result = libluksde_volume_open(
+	          volume,
+	          source,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+#endif
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_close(
+	          volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open and close a second time to validate clean up on close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libluksde_volume_open_wide(
+	          volume,
+	          source,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+#else
+	result = libluksde_volume_open(
+	          volume,
+	          source,
+	          LIBLUKSDE_OPEN_READ,
+	          &error );
+#endif
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_close(
+	          volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open with metadata only and close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libluksde_volume_open_wide(
+	          volume,
+	          source,
+	          LIBLUKSDE_OPEN_METADATA_ONLY,
+	          &error );
+#else
+	result = libluksde_volume_open(
+	          volume,
+	          source,
+	          LIBLUKSDE_OPEN_METADATA_ONLY,
+	          &error );
+#endif
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_is_locked(
+	          volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_get_size(
+	          volume,
+	          &size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_close(
+	          volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libluksde_volume_free(
+	          &volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libluksde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_volume_signal_abort function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_signal_abort(
+     libluksde_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libluksde_volume_signal_abort(
+	          volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
@@ -2326,22 +3157,333 @@ int luksde_test_volume_read_buffer_at_offset(
 		 result,
 		 1 );
 
-		LUKSDE_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 offset,
-		 read_offset );
+		LUKSDE_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 read_offset );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	read_count = libluksde_volume_read_buffer_at_offset(
+	              NULL,
+	              buffer,
+	              LUKSDE_TEST_VOLUME_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_volume_read_buffer_at_offset(
+	              volume,
+	              NULL,
+	              LUKSDE_TEST_VOLUME_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_volume_read_buffer_at_offset(
+	              volume,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libluksde_volume_read_buffer_at_offset(
+	              volume,
+	              buffer,
+	              LUKSDE_TEST_VOLUME_READ_BUFFER_SIZE,
+	              -1,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_LUKSDE_TEST_RWLOCK )
+
+	/* Test libluksde_volume_read_buffer_at_offset with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
+	 */
+	luksde_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
+
+	read_count = libluksde_volume_read_buffer_at_offset(
+	              volume,
+	              buffer,
+	              LUKSDE_TEST_VOLUME_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	if( luksde_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
+	{
+		luksde_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Test libluksde_volume_read_buffer_at_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
+	 */
+	luksde_test_pthread_rwlock_unlock_attempts_before_fail = 0;
+
+	read_count = libluksde_volume_read_buffer_at_offset(
+	              volume,
+	              buffer,
+	              LUKSDE_TEST_VOLUME_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	if( luksde_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
+	{
+		luksde_test_pthread_rwlock_unlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+#endif /* defined( HAVE_LUKSDE_TEST_RWLOCK ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_volume_read_vectors function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_read_vectors(
+     libluksde_volume_t *volume )
+{
+	libluksde_iovec_t vectors[ LUKSDE_TEST_VOLUME_NUMBER_OF_VECTORS ];
+
+	uint8_t buffers[ LUKSDE_TEST_VOLUME_NUMBER_OF_VECTORS ][ 1024 ];
+	uint8_t expected_buffer[ 1024 ];
+
+	/* Out of order, adjacent, overlapping and sparse offsets
+	 */
+	off64_t vector_offsets[ LUKSDE_TEST_VOLUME_NUMBER_OF_VECTORS ] = {
+		8192, 0, 1024, 100, 2048, 3000, 65536, 4095 };
+
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	ssize_t expected_count   = 0;
+	ssize_t read_count       = 0;
+	off64_t offset           = 0;
+	int result               = 0;
+	int vector_index         = 0;
+
+	/* Determine size
+	 */
+	result = libluksde_volume_get_size(
+	          volume,
+	          &size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libluksde_volume_seek_offset(
+	          volume,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( vector_index = 0;
+	     vector_index < LUKSDE_TEST_VOLUME_NUMBER_OF_VECTORS;
+	     vector_index++ )
+	{
+		vectors[ vector_index ].buffer      = buffers[ vector_index ];
+		vectors[ vector_index ].buffer_size = 1024;
+		vectors[ vector_index ].offset      = vector_offsets[ vector_index ];
+
+		if( (size64_t) vector_offsets[ vector_index ] < size )
+		{
+			if( (size64_t) 1024 > ( size - vector_offsets[ vector_index ] ) )
+			{
+				expected_count += (ssize_t) ( size - vector_offsets[ vector_index ] );
+			}
+			else
+			{
+				expected_count += 1024;
+			}
+		}
+	}
+	read_count = libluksde_volume_read_vectors(
+	              volume,
+	              vectors,
+	              LUKSDE_TEST_VOLUME_NUMBER_OF_VECTORS,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 expected_count );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The vectored read does not change the current offset
+	 */
+	result = libluksde_volume_get_offset(
+	          volume,
+	          &offset,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( vector_index = 0;
+	     vector_index < LUKSDE_TEST_VOLUME_NUMBER_OF_VECTORS;
+	     vector_index++ )
+	{
+		read_count = libluksde_volume_read_buffer_at_offset(
+		              volume,
+		              expected_buffer,
+		              1024,
+		              vector_offsets[ vector_index ],
+		              &error );
+
+		LUKSDE_TEST_ASSERT_NOT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
 
 		LUKSDE_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
+
+		if( read_count > 0 )
+		{
+			result = memory_compare(
+			          buffers[ vector_index ],
+			          expected_buffer,
+			          (size_t) read_count );
+
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
 	}
+	read_count = libluksde_volume_read_vectors(
+	              volume,
+	              vectors,
+	              0,
+	              &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	/* Test error cases
 	 */
-	read_count = libluksde_volume_read_buffer_at_offset(
+	read_count = libluksde_volume_read_vectors(
 	              NULL,
-	              buffer,
-	              LUKSDE_TEST_VOLUME_READ_BUFFER_SIZE,
-	              0,
+	              vectors,
+	              LUKSDE_TEST_VOLUME_NUMBER_OF_VECTORS,
 	              &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
@@ -2356,11 +3498,10 @@ int luksde_test_volume_read_buffer_at_offset(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libluksde_volume_read_buffer_at_offset(
+	read_count = libluksde_volume_read_vectors(
 	              volume,
 	              NULL,
-	              LUKSDE_TEST_VOLUME_READ_BUFFER_SIZE,
-	              0,
+	              LUKSDE_TEST_VOLUME_NUMBER_OF_VECTORS,
 	              &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
@@ -2375,11 +3516,10 @@ int luksde_test_volume_read_buffer_at_offset(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libluksde_volume_read_buffer_at_offset(
+	read_count = libluksde_volume_read_vectors(
 	              volume,
-	              buffer,
-	              (size_t) SSIZE_MAX + 1,
-	              0,
+	              vectors,
+	              -1,
 	              &error );
 
 	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
@@ -2394,13 +3534,16 @@ int luksde_test_volume_read_buffer_at_offset(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libluksde_volume_read_buffer_at_offset(
+	vectors[ 0 ].offset = -1;
+
+	read_count = libluksde_volume_read_vectors(
 	              volume,
-	              buffer,
-	              LUKSDE_TEST_VOLUME_READ_BUFFER_SIZE,
-	              -1,
+	              vectors,
+	              LUKSDE_TEST_VOLUME_NUMBER_OF_VECTORS,
 	              &error );
 
+	vectors[ 0 ].offset = vector_offsets[ 0 ];
+
 	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
 	 "read_count",
 	 read_count,
@@ -2413,67 +3556,302 @@ int luksde_test_volume_read_buffer_at_offset(
 	libcerror_error_free(
 	 &error );
 
-#if defined( HAVE_LUKSDE_TEST_RWLOCK )
-
-	/* Test libluksde_volume_read_buffer_at_offset with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
-	 */
-	luksde_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
+	vectors[ 0 ].buffer = NULL;
 
-	read_count = libluksde_volume_read_buffer_at_offset(
+	read_count = libluksde_volume_read_vectors(
 	              volume,
-	              buffer,
-	              LUKSDE_TEST_VOLUME_READ_BUFFER_SIZE,
-	              0,
+	              vectors,
+	              LUKSDE_TEST_VOLUME_NUMBER_OF_VECTORS,
 	              &error );
 
-	if( luksde_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
+	vectors[ 0 ].buffer = buffers[ 0 ];
+
+	LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
 	{
-		luksde_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
+		libcerror_error_free(
+		 &error );
 	}
-	else
+	return( 0 );
+}
+
+/* Callback function for the asynchronous read tests
+ */
+void luksde_test_volume_read_buffer_at_offset_async_callback(
+     libluksde_volume_t *volume LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     void *buffer LUKSDE_TEST_ATTRIBUTE_UNUSED,
+     ssize_t read_count,
+     void *user_data )
+{
+	ssize_t *read_counts = (ssize_t *) user_data;
+
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( volume )
+	LUKSDE_TEST_UNREFERENCED_PARAMETER( buffer )
+
+	*read_counts = read_count;
+}
+
+/* Tests the libluksde_volume_read_buffer_at_offset_async function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_read_buffer_at_offset_async(
+     libluksde_volume_t *volume )
+{
+	uint8_t buffers[ LUKSDE_TEST_VOLUME_NUMBER_OF_ASYNC_READS ][ 512 ];
+	uint8_t expected_buffer[ 512 ];
+	ssize_t read_counts[ LUKSDE_TEST_VOLUME_NUMBER_OF_ASYNC_READS ];
+
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	ssize_t read_count       = 0;
+	off64_t offset           = 0;
+	int read_index           = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libluksde_volume_get_size(
+	          volume,
+	          &size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libluksde_volume_seek_offset(
+	          volume,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( read_index = 0;
+	     read_index < LUKSDE_TEST_VOLUME_NUMBER_OF_ASYNC_READS;
+	     read_index++ )
 	{
-		LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+		read_counts[ read_index ] = 0;
+
+		result = libluksde_volume_read_buffer_at_offset_async(
+		          volume,
+		          buffers[ read_index ],
+		          512,
+		          (off64_t) read_index * 512,
+		          &luksde_test_volume_read_buffer_at_offset_async_callback,
+		          (void *) &( read_counts[ read_index ] ),
+		          &error );
+
+		LUKSDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		LUKSDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libluksde_volume_wait_for_async_reads(
+	          volume,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The asynchronous reads do not change the current offset
+	 */
+	result = libluksde_volume_get_offset(
+	          volume,
+	          &offset,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( read_index = 0;
+	     read_index < LUKSDE_TEST_VOLUME_NUMBER_OF_ASYNC_READS;
+	     read_index++ )
+	{
+		read_count = libluksde_volume_read_buffer_at_offset(
+		              volume,
+		              expected_buffer,
+		              512,
+		              (off64_t) read_index * 512,
+		              &error );
+
+		LUKSDE_TEST_ASSERT_NOT_EQUAL_SSIZE(
 		 "read_count",
 		 read_count,
 		 (ssize_t) -1 );
 
-		LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+		LUKSDE_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
 
-		libcerror_error_free(
-		 &error );
-	}
-	/* Test libluksde_volume_read_buffer_at_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
-	 */
-	luksde_test_pthread_rwlock_unlock_attempts_before_fail = 0;
+		LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_counts[ read_index ]",
+		 read_counts[ read_index ],
+		 read_count );
+
+		if( read_count > 0 )
+		{
+			result = memory_compare(
+			          buffers[ read_index ],
+			          expected_buffer,
+			          (size_t) read_count );
+
+			LUKSDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+	}
+	/* Test error cases
+	 */
+	result = libluksde_volume_read_buffer_at_offset_async(
+	          NULL,
+	          buffers[ 0 ],
+	          512,
+	          0,
+	          &luksde_test_volume_read_buffer_at_offset_async_callback,
+	          (void *) &( read_counts[ 0 ] ),
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_read_buffer_at_offset_async(
+	          volume,
+	          NULL,
+	          512,
+	          0,
+	          &luksde_test_volume_read_buffer_at_offset_async_callback,
+	          (void *) &( read_counts[ 0 ] ),
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_read_buffer_at_offset_async(
+	          volume,
+	          buffers[ 0 ],
+	          512,
+	          -1,
+	          &luksde_test_volume_read_buffer_at_offset_async_callback,
+	          (void *) &( read_counts[ 0 ] ),
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_read_buffer_at_offset_async(
+	          volume,
+	          buffers[ 0 ],
+	          512,
+	          0,
+	          NULL,
+	          (void *) &( read_counts[ 0 ] ),
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-	read_count = libluksde_volume_read_buffer_at_offset(
-	              volume,
-	              buffer,
-	              LUKSDE_TEST_VOLUME_READ_BUFFER_SIZE,
-	              0,
-	              &error );
+	libcerror_error_free(
+	 &error );
 
-	if( luksde_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
-	{
-		luksde_test_pthread_rwlock_unlock_attempts_before_fail = -1;
-	}
-	else
-	{
-		LUKSDE_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) -1 );
+	result = libluksde_volume_wait_for_async_reads(
+	          NULL,
+	          &error );
 
-		LUKSDE_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		libcerror_error_free(
-		 &error );
-	}
-#endif /* defined( HAVE_LUKSDE_TEST_RWLOCK ) */
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
 
 	return( 1 );
 
@@ -2865,6 +4243,231 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libluksde_volume_get_number_of_allocated_ranges function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_get_number_of_allocated_ranges(
+     libluksde_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_ranges     = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libluksde_volume_get_number_of_allocated_ranges(
+	          volume,
+	          &number_of_ranges,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The volume was not opened to skip the unallocated regions
+	 */
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_ranges",
+	 number_of_ranges,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libluksde_volume_get_number_of_allocated_ranges(
+	          NULL,
+	          &number_of_ranges,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_get_number_of_allocated_ranges(
+	          volume,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_volume_get_allocated_range_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_get_allocated_range_by_index(
+     libluksde_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	size64_t range_size      = 0;
+	size64_t size            = 0;
+	off64_t range_offset     = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_volume_get_size(
+	          volume,
+	          &size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_volume_get_allocated_range_by_index(
+	          volume,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 0 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) size );
+
+	/* Test error cases
+	 */
+	result = libluksde_volume_get_allocated_range_by_index(
+	          NULL,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_get_allocated_range_by_index(
+	          volume,
+	          1,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_get_allocated_range_by_index(
+	          volume,
+	          0,
+	          NULL,
+	          &range_size,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_get_allocated_range_by_index(
+	          volume,
+	          0,
+	          &range_offset,
+	          NULL,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -3010,6 +4613,18 @@ int main(
 		 source,
 		 option_password );
 
+		LUKSDE_TEST_RUN_WITH_ARGS(
+		 "libluksde_volume_open_file_io_handles",
+		 luksde_test_volume_open_file_io_handles,
+		 source,
+		 option_password );
+
+		LUKSDE_TEST_RUN_WITH_ARGS(
+		 "libluksde_volume_open_io_callbacks",
+		 luksde_test_volume_open_io_callbacks,
+		 source,
+		 option_password );
+
 		LUKSDE_TEST_RUN(
 		 "libluksde_volume_close",
 		 luksde_test_volume_close );
@@ -3076,6 +4691,16 @@ int main(
 		 luksde_test_volume_read_buffer_at_offset,
 		 volume );
 
+		LUKSDE_TEST_RUN_WITH_ARGS(
+		 "libluksde_volume_read_vectors",
+		 luksde_test_volume_read_vectors,
+		 volume );
+
+		LUKSDE_TEST_RUN_WITH_ARGS(
+		 "libluksde_volume_read_buffer_at_offset_async",
+		 luksde_test_volume_read_buffer_at_offset_async,
+		 volume );
+
 		/* TODO: add tests for libluksde_volume_write_buffer */
 
 		/* TODO: add tests for libluksde_volume_write_buffer_at_offset */
@@ -3101,6 +4726,16 @@ int main(
 		 luksde_test_volume_get_size,
 		 volume );
 
+		LUKSDE_TEST_RUN_WITH_ARGS(
+		 "libluksde_volume_get_number_of_allocated_ranges",
+		 luksde_test_volume_get_number_of_allocated_ranges,
+		 volume );
+
+		LUKSDE_TEST_RUN_WITH_ARGS(
+		 "libluksde_volume_get_allocated_range_by_index",
+		 luksde_test_volume_get_allocated_range_by_index,
+		 volume );
+
 		/* TODO: add tests for libluksde_volume_get_encryption_method */
 
 		/* TODO: add tests for libluksde_volume_get_volume_identifier */
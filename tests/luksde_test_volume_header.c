@@ -22,6 +22,7 @@
 #include <common.h>
 #include <byte_stream.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -296,8 +297,146 @@ uint8_t luksde_test_volume_header_data1[ 4096 ] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
 
+uint8_t luksde_test_volume_header_json_data1[ 732 ] = {
+	0x7b, 0x22, 0x6b, 0x65, 0x79, 0x73, 0x6c, 0x6f, 0x74, 0x73, 0x22, 0x3a, 0x7b, 0x22, 0x30, 0x22,
+	0x3a, 0x7b, 0x22, 0x74, 0x79, 0x70, 0x65, 0x22, 0x3a, 0x22, 0x6c, 0x75, 0x6b, 0x73, 0x32, 0x22,
+	0x2c, 0x22, 0x6b, 0x65, 0x79, 0x5f, 0x73, 0x69, 0x7a, 0x65, 0x22, 0x3a, 0x36, 0x34, 0x2c, 0x22,
+	0x61, 0x66, 0x22, 0x3a, 0x7b, 0x22, 0x74, 0x79, 0x70, 0x65, 0x22, 0x3a, 0x22, 0x6c, 0x75, 0x6b,
+	0x73, 0x31, 0x22, 0x2c, 0x22, 0x73, 0x74, 0x72, 0x69, 0x70, 0x65, 0x73, 0x22, 0x3a, 0x34, 0x30,
+	0x30, 0x30, 0x2c, 0x22, 0x68, 0x61, 0x73, 0x68, 0x22, 0x3a, 0x22, 0x73, 0x68, 0x61, 0x32, 0x35,
+	0x36, 0x22, 0x7d, 0x2c, 0x22, 0x61, 0x72, 0x65, 0x61, 0x22, 0x3a, 0x7b, 0x22, 0x74, 0x79, 0x70,
+	0x65, 0x22, 0x3a, 0x22, 0x72, 0x61, 0x77, 0x22, 0x2c, 0x22, 0x6f, 0x66, 0x66, 0x73, 0x65, 0x74,
+	0x22, 0x3a, 0x22, 0x33, 0x32, 0x37, 0x36, 0x38, 0x22, 0x2c, 0x22, 0x73, 0x69, 0x7a, 0x65, 0x22,
+	0x3a, 0x22, 0x32, 0x35, 0x38, 0x30, 0x34, 0x38, 0x22, 0x2c, 0x22, 0x65, 0x6e, 0x63, 0x72, 0x79,
+	0x70, 0x74, 0x69, 0x6f, 0x6e, 0x22, 0x3a, 0x22, 0x61, 0x65, 0x73, 0x2d, 0x78, 0x74, 0x73, 0x2d,
+	0x70, 0x6c, 0x61, 0x69, 0x6e, 0x36, 0x34, 0x22, 0x2c, 0x22, 0x6b, 0x65, 0x79, 0x5f, 0x73, 0x69,
+	0x7a, 0x65, 0x22, 0x3a, 0x36, 0x34, 0x7d, 0x2c, 0x22, 0x6b, 0x64, 0x66, 0x22, 0x3a, 0x7b, 0x22,
+	0x74, 0x79, 0x70, 0x65, 0x22, 0x3a, 0x22, 0x70, 0x62, 0x6b, 0x64, 0x66, 0x32, 0x22, 0x2c, 0x22,
+	0x68, 0x61, 0x73, 0x68, 0x22, 0x3a, 0x22, 0x73, 0x68, 0x61, 0x32, 0x35, 0x36, 0x22, 0x2c, 0x22,
+	0x69, 0x74, 0x65, 0x72, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x22, 0x3a, 0x31, 0x30, 0x30, 0x30,
+	0x2c, 0x22, 0x73, 0x61, 0x6c, 0x74, 0x22, 0x3a, 0x22, 0x41, 0x41, 0x45, 0x43, 0x41, 0x77, 0x51,
+	0x46, 0x42, 0x67, 0x63, 0x49, 0x43, 0x51, 0x6f, 0x4c, 0x44, 0x41, 0x30, 0x4f, 0x44, 0x78, 0x41,
+	0x52, 0x45, 0x68, 0x4d, 0x55, 0x46, 0x52, 0x59, 0x58, 0x47, 0x42, 0x6b, 0x61, 0x47, 0x78, 0x77,
+	0x64, 0x48, 0x68, 0x38, 0x3d, 0x22, 0x7d, 0x7d, 0x7d, 0x2c, 0x22, 0x74, 0x6f, 0x6b, 0x65, 0x6e,
+	0x73, 0x22, 0x3a, 0x7b, 0x7d, 0x2c, 0x22, 0x73, 0x65, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x73, 0x22,
+	0x3a, 0x7b, 0x22, 0x30, 0x22, 0x3a, 0x7b, 0x22, 0x74, 0x79, 0x70, 0x65, 0x22, 0x3a, 0x22, 0x63,
+	0x72, 0x79, 0x70, 0x74, 0x22, 0x2c, 0x22, 0x6f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x22, 0x3a, 0x22,
+	0x31, 0x36, 0x37, 0x37, 0x37, 0x32, 0x31, 0x36, 0x22, 0x2c, 0x22, 0x73, 0x69, 0x7a, 0x65, 0x22,
+	0x3a, 0x22, 0x64, 0x79, 0x6e, 0x61, 0x6d, 0x69, 0x63, 0x22, 0x2c, 0x22, 0x69, 0x76, 0x5f, 0x74,
+	0x77, 0x65, 0x61, 0x6b, 0x22, 0x3a, 0x22, 0x30, 0x22, 0x2c, 0x22, 0x65, 0x6e, 0x63, 0x72, 0x79,
+	0x70, 0x74, 0x69, 0x6f, 0x6e, 0x22, 0x3a, 0x22, 0x61, 0x65, 0x73, 0x2d, 0x78, 0x74, 0x73, 0x2d,
+	0x70, 0x6c, 0x61, 0x69, 0x6e, 0x36, 0x34, 0x22, 0x2c, 0x22, 0x73, 0x65, 0x63, 0x74, 0x6f, 0x72,
+	0x5f, 0x73, 0x69, 0x7a, 0x65, 0x22, 0x3a, 0x35, 0x31, 0x32, 0x7d, 0x7d, 0x2c, 0x22, 0x64, 0x69,
+	0x67, 0x65, 0x73, 0x74, 0x73, 0x22, 0x3a, 0x7b, 0x22, 0x30, 0x22, 0x3a, 0x7b, 0x22, 0x74, 0x79,
+	0x70, 0x65, 0x22, 0x3a, 0x22, 0x70, 0x62, 0x6b, 0x64, 0x66, 0x32, 0x22, 0x2c, 0x22, 0x6b, 0x65,
+	0x79, 0x73, 0x6c, 0x6f, 0x74, 0x73, 0x22, 0x3a, 0x5b, 0x22, 0x30, 0x22, 0x5d, 0x2c, 0x22, 0x73,
+	0x65, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x73, 0x22, 0x3a, 0x5b, 0x22, 0x30, 0x22, 0x5d, 0x2c, 0x22,
+	0x68, 0x61, 0x73, 0x68, 0x22, 0x3a, 0x22, 0x73, 0x68, 0x61, 0x32, 0x35, 0x36, 0x22, 0x2c, 0x22,
+	0x69, 0x74, 0x65, 0x72, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x22, 0x3a, 0x31, 0x30, 0x30, 0x30,
+	0x2c, 0x22, 0x73, 0x61, 0x6c, 0x74, 0x22, 0x3a, 0x22, 0x41, 0x41, 0x45, 0x43, 0x41, 0x77, 0x51,
+	0x46, 0x42, 0x67, 0x63, 0x49, 0x43, 0x51, 0x6f, 0x4c, 0x44, 0x41, 0x30, 0x4f, 0x44, 0x78, 0x41,
+	0x52, 0x45, 0x68, 0x4d, 0x55, 0x46, 0x52, 0x59, 0x58, 0x47, 0x42, 0x6b, 0x61, 0x47, 0x78, 0x77,
+	0x64, 0x48, 0x68, 0x38, 0x3d, 0x22, 0x2c, 0x22, 0x64, 0x69, 0x67, 0x65, 0x73, 0x74, 0x22, 0x3a,
+	0x22, 0x49, 0x43, 0x45, 0x69, 0x49, 0x79, 0x51, 0x6c, 0x4a, 0x69, 0x63, 0x6f, 0x4b, 0x53, 0x6f,
+	0x72, 0x4c, 0x43, 0x30, 0x75, 0x4c, 0x7a, 0x41, 0x78, 0x4d, 0x6a, 0x4d, 0x30, 0x4e, 0x54, 0x59,
+	0x33, 0x4f, 0x44, 0x6b, 0x36, 0x4f, 0x7a, 0x77, 0x39, 0x50, 0x6a, 0x38, 0x3d, 0x22, 0x7d, 0x7d,
+	0x2c, 0x22, 0x63, 0x6f, 0x6e, 0x66, 0x69, 0x67, 0x22, 0x3a, 0x7b, 0x22, 0x6a, 0x73, 0x6f, 0x6e,
+	0x5f, 0x73, 0x69, 0x7a, 0x65, 0x22, 0x3a, 0x22, 0x31, 0x32, 0x32, 0x38, 0x38, 0x22, 0x2c, 0x22,
+	0x6b, 0x65, 0x79, 0x73, 0x6c, 0x6f, 0x74, 0x73, 0x5f, 0x73, 0x69, 0x7a, 0x65, 0x22, 0x3a, 0x22,
+	0x31, 0x36, 0x37, 0x34, 0x34, 0x34, 0x34, 0x38, 0x22, 0x7d, 0x7d, 0x00 };
+
+uint8_t luksde_test_volume_header_data2[ 512 ] = {
+	0x4c, 0x55, 0x4b, 0x53, 0xba, 0xbe, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0x68, 0x61, 0x32, 0x35, 0x36, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61, 0x36, 0x61, 0x65, 0x38, 0x64, 0x66, 0x64,
+	0x2d, 0x32, 0x66, 0x32, 0x61, 0x2d, 0x34, 0x66, 0x35, 0x61, 0x2d, 0x39, 0x64, 0x32, 0x63, 0x2d,
+	0x31, 0x63, 0x32, 0x65, 0x37, 0x62, 0x39, 0x63, 0x33, 0x66, 0x34, 0x31, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x38, 0x4e, 0xf4, 0x24, 0x62, 0xf0, 0xe2, 0xeb, 0x6a, 0x17, 0xe7, 0xa5, 0x1b, 0xc7, 0xfc, 0xfa,
+	0x55, 0xb1, 0xc3, 0x9b, 0x39, 0xea, 0xbd, 0xc3, 0xa1, 0x75, 0x66, 0xa7, 0xba, 0x63, 0x53, 0xfb,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+uint8_t luksde_test_volume_header_data3[ 512 ] = {
+	0x53, 0x4b, 0x55, 0x4c, 0xba, 0xbe, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0x68, 0x61, 0x32, 0x35, 0x36, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61, 0x36, 0x61, 0x65, 0x38, 0x64, 0x66, 0x64,
+	0x2d, 0x32, 0x66, 0x32, 0x61, 0x2d, 0x34, 0x66, 0x35, 0x61, 0x2d, 0x39, 0x64, 0x32, 0x63, 0x2d,
+	0x31, 0x63, 0x32, 0x65, 0x37, 0x62, 0x39, 0x63, 0x33, 0x66, 0x34, 0x31, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x78, 0x6c, 0x9a, 0x5d, 0xe7, 0xf7, 0x09, 0xd2, 0x52, 0x5c, 0x3a, 0x04, 0x5f, 0xa6, 0x5b, 0x3f,
+	0xbf, 0xf1, 0x62, 0x1a, 0x68, 0x90, 0xf6, 0xf4, 0xad, 0x75, 0xc2, 0x20, 0xde, 0x23, 0x60, 0xe8,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
 #if defined( __GNUC__ ) && !defined( LIBLUKSDE_DLL_IMPORT )
 
+/* Sets the LUKS2 test metadata area data
+ */
+void luksde_test_volume_header_set_metadata_area_data(
+      uint8_t *data,
+      const uint8_t *header_data )
+{
+	memory_set(
+	 data,
+	 0,
+	 16384 );
+
+	memory_copy(
+	 data,
+	 header_data,
+	 512 );
+
+	memory_copy(
+	 &( data[ 4096 ] ),
+	 luksde_test_volume_header_json_data1,
+	 732 );
+}
+
 /* Tests the libluksde_volume_header_initialize function
  * Returns 1 if successful or 0 if not
  */
@@ -715,12 +854,344 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libluksde_volume_header_read_json_data function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_header_read_json_data(
+     void )
+{
+	libcerror_error_t *error                 = NULL;
+	libluksde_volume_header_t *volume_header = NULL;
+	int result                               = 0;
+
+	/* Initialize test
+	 */
+	result = libluksde_volume_header_initialize(
+	          &volume_header,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume_header",
+	 volume_header );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libluksde_volume_header_read_json_data(
+	          volume_header,
+	          luksde_test_volume_header_json_data1,
+	          732,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+	 "volume_header->master_key_size",
+	 volume_header->master_key_size,
+	 64 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT64(
+	 "volume_header->encrypted_volume_start_sector",
+	 volume_header->encrypted_volume_start_sector,
+	 (uint64_t) 32768 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+	 "volume_header->sector_size",
+	 volume_header->sector_size,
+	 512 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT32(
+	 "volume_header->master_key_number_of_iterations",
+	 volume_header->master_key_number_of_iterations,
+	 1000 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_SIZE(
+	 "volume_header->master_key_validation_hash_size",
+	 volume_header->master_key_validation_hash_size,
+	 (size_t) 32 );
+
+	/* Test error cases
+	 */
+	result = libluksde_volume_header_read_json_data(
+	          NULL,
+	          luksde_test_volume_header_json_data1,
+	          732,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_header_read_json_data(
+	          volume_header,
+	          NULL,
+	          4096,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_header_read_json_data(
+	          volume_header,
+	          luksde_test_volume_header_json_data1,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_header_read_json_data(
+	          volume_header,
+	          luksde_test_volume_header_json_data1,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libluksde_volume_header_free(
+	          &volume_header,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "volume_header",
+	 volume_header );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume_header != NULL )
+	{
+		libluksde_volume_header_free(
+		 &volume_header,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libluksde_volume_header_check_metadata_area_checksum function
+ * Returns 1 if successful or 0 if not
+ */
+int luksde_test_volume_header_check_metadata_area_checksum(
+     void )
+{
+	uint8_t metadata_area_data[ 16384 ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	luksde_test_volume_header_set_metadata_area_data(
+	 metadata_area_data,
+	 luksde_test_volume_header_data2 );
+
+	/* Test regular cases
+	 */
+	result = libluksde_volume_header_check_metadata_area_checksum(
+	          metadata_area_data,
+	          16384,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the checksum is restored
+	 */
+	result = memory_compare(
+	          metadata_area_data,
+	          luksde_test_volume_header_data2,
+	          512 );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test checksum mismatch
+	 */
+	metadata_area_data[ 8192 ] = 0xff;
+
+	result = libluksde_volume_header_check_metadata_area_checksum(
+	          metadata_area_data,
+	          16384,
+	          &error );
+
+	metadata_area_data[ 8192 ] = 0x00;
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test unsupported checksum method
+	 */
+	metadata_area_data[ 72 ] = 'x';
+
+	result = libluksde_volume_header_check_metadata_area_checksum(
+	          metadata_area_data,
+	          16384,
+	          &error );
+
+	metadata_area_data[ 72 ] = 's';
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libluksde_volume_header_check_metadata_area_checksum(
+	          NULL,
+	          16384,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_header_check_metadata_area_checksum(
+	          metadata_area_data,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_header_check_metadata_area_checksum(
+	          metadata_area_data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libluksde_volume_header_read_file_io_handle function
  * Returns 1 if successful or 0 if not
  */
 int luksde_test_volume_header_read_file_io_handle(
      void )
 {
+	uint8_t metadata_area_data[ 32768 ];
+
 	libbfio_handle_t *file_io_handle         = NULL;
 	libcerror_error_t *error                 = NULL;
 	libluksde_volume_header_t *volume_header = NULL;
@@ -985,6 +1456,152 @@ int luksde_test_volume_header_read_file_io_handle(
 	 "error",
 	 error );
 
+	/* Test LUKS2 with a damaged primary metadata area
+	 */
+	luksde_test_volume_header_set_metadata_area_data(
+	 metadata_area_data,
+	 luksde_test_volume_header_data2 );
+
+	luksde_test_volume_header_set_metadata_area_data(
+	 &( metadata_area_data[ 16384 ] ),
+	 luksde_test_volume_header_data3 );
+
+	metadata_area_data[ 8192 ] = 0xff;
+
+	result = luksde_test_open_file_io_handle(
+	          &file_io_handle,
+	          metadata_area_data,
+	          32768,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_header_initialize(
+	          &volume_header,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume_header",
+	 volume_header );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_header_read_file_io_handle(
+	          volume_header,
+	          file_io_handle,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_UINT16(
+	 "volume_header->format_version",
+	 volume_header->format_version,
+	 2 );
+
+	result = libluksde_volume_header_free(
+	          &volume_header,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test LUKS2 with a damaged primary and secondary metadata area
+	 */
+	metadata_area_data[ 16384 + 8192 ] = 0xff;
+
+	result = libluksde_volume_header_initialize(
+	          &volume_header,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume_header",
+	 volume_header );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libluksde_volume_header_read_file_io_handle(
+	          volume_header,
+	          file_io_handle,
+	          0,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	LUKSDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libluksde_volume_header_free(
+	          &volume_header,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = luksde_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	LUKSDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	LUKSDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	return( 1 );
 
 on_error:
@@ -1120,6 +1737,16 @@ int main(
 	 "libluksde_volume_header_read_data",
 	 luksde_test_volume_header_read_data );
 
+	LUKSDE_TEST_RUN(
+	 "libluksde_volume_header_read_json_data",
+	 luksde_test_volume_header_read_json_data );
+
+	LUKSDE_TEST_RUN(
+	 "libluksde_volume_header_check_metadata_area_checksum",
+	 luksde_test_volume_header_check_metadata_area_checksum );
+
+	/* TODO add tests for libluksde_volume_header_read_metadata_area_file_io_handle */
+
 	LUKSDE_TEST_RUN(
 	 "libluksde_volume_header_read_file_io_handle",
 	 luksde_test_volume_header_read_file_io_handle );
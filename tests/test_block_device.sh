@@ -0,0 +1,144 @@
+#!/usr/bin/env bash
+# Tests block device functions with a loop device.
+#
+# Version: 20240413
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+SECTOR_SIZES="512 4096";
+
+IMAGE_SIZE=8388608;
+
+cleanup()
+{
+	if test -n "${LOOP_DEVICE}";
+	then
+		losetup -d "${LOOP_DEVICE}" > /dev/null 2>&1;
+	fi
+	if test -n "${TEST_TMPDIR}" && test -d "${TEST_TMPDIR}";
+	then
+		rm -rf "${TEST_TMPDIR}";
+	fi
+}
+
+run_test_with_sector_size()
+{
+	local SECTOR_SIZE=$1;
+
+	local TEST_DESCRIPTION="Testing: block_device with sector size: ${SECTOR_SIZE}";
+
+	LOOP_DEVICE=`losetup --find --show --sector-size ${SECTOR_SIZE} "${IMAGE_FILE}" 2> /dev/null`;
+
+	if test -z "${LOOP_DEVICE}";
+	then
+		echo "Unable to attach loop device with sector size: ${SECTOR_SIZE}";
+
+		return ${EXIT_IGNORE};
+	fi
+	local SIZE=`blockdev --getsize64 ${LOOP_DEVICE}`;
+	local LOGICAL_BLOCK_SIZE=`blockdev --getss ${LOOP_DEVICE}`;
+	local MINIMUM_IO_SIZE=`blockdev --getiomin ${LOOP_DEVICE}`;
+	local OPTIMAL_IO_SIZE=`blockdev --getioopt ${LOOP_DEVICE}`;
+
+	run_test_with_arguments "${TEST_DESCRIPTION}" "${TEST_EXECUTABLE}" -s ${SIZE} -l ${LOGICAL_BLOCK_SIZE} -m ${MINIMUM_IO_SIZE} -o ${OPTIMAL_IO_SIZE} ${LOOP_DEVICE};
+	local RESULT=$?;
+
+	losetup -d "${LOOP_DEVICE}" > /dev/null 2>&1;
+
+	LOOP_DEVICE="";
+
+	return ${RESULT};
+}
+
+if test -n "${SKIP_LIBRARY_TESTS}";
+then
+	exit ${EXIT_IGNORE};
+fi
+
+if test `uname -s` != "Linux";
+then
+	exit ${EXIT_IGNORE};
+fi
+
+if test `id -u` -ne 0;
+then
+	echo "Loop device tests require root privileges.";
+
+	exit ${EXIT_IGNORE};
+fi
+
+for COMMAND in losetup blockdev;
+do
+	if ! command -v ${COMMAND} > /dev/null 2>&1;
+	then
+		echo "Missing command: ${COMMAND}";
+
+		exit ${EXIT_IGNORE};
+	fi
+done
+
+TEST_EXECUTABLE="./luksde_test_block_device";
+
+if ! test -x "${TEST_EXECUTABLE}";
+then
+	echo "Missing test executable: ${TEST_EXECUTABLE}";
+
+	exit ${EXIT_IGNORE};
+fi
+
+TEST_DIRECTORY=`dirname $0`;
+
+TEST_RUNNER="${TEST_DIRECTORY}/test_runner.sh";
+
+if ! test -f "${TEST_RUNNER}";
+then
+	echo "Missing test runner: ${TEST_RUNNER}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+source ${TEST_RUNNER};
+
+TEST_TMPDIR=`mktemp -d "${TMPDIR:-/tmp}/luksde_test_block_device.XXXXXX"`;
+
+if test -z "${TEST_TMPDIR}";
+then
+	echo "Unable to create temporary directory.";
+
+	exit ${EXIT_FAILURE};
+fi
+
+trap cleanup EXIT;
+
+IMAGE_FILE="${TEST_TMPDIR}/block_device.raw";
+
+if ! dd if=/dev/zero of="${IMAGE_FILE}" bs=${IMAGE_SIZE} count=1 > /dev/null 2>&1;
+then
+	echo "Unable to create image file: ${IMAGE_FILE}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+RESULT=${EXIT_IGNORE};
+
+for SECTOR_SIZE in ${SECTOR_SIZES};
+do
+	run_test_with_sector_size "${SECTOR_SIZE}";
+	TEST_RESULT=$?;
+
+	# Older versions of losetup do not support setting the sector size
+	if test ${TEST_RESULT} -eq ${EXIT_IGNORE};
+	then
+		continue;
+	fi
+	RESULT=${TEST_RESULT};
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		break;
+	fi
+done
+
+exit ${RESULT};
@@ -6,7 +6,7 @@ $ExitSuccess = 0
 $ExitFailure = 1
 $ExitIgnore = 77
 
-$LibraryTests = "diffuser encryption_context error io_handle key_slot notify password sector_data sector_data_vector volume_header"
+$LibraryTests = "allocation_map argon2 benchmark blake2b block_device callbacks_io_handle data_signature diffuser digest direct_io_handle encryption_context error file_io_handle_pool file_mapping io_callbacks io_handle io_uring json_tokenizer key_slot keyfile master_key_cache notify password read_queue read_request sector_data sector_data_vector segment segment_map sha spill_cache volume_header"
 $LibraryTestsWithInput = "support volume"
 $OptionSets = "password"
 
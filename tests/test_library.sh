@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-LIBRARY_TESTS="diffuser encryption_context error io_handle key_slot notify password sector_data sector_data_vector volume_header";
+LIBRARY_TESTS="allocation_map argon2 benchmark blake2b block_device callbacks_io_handle data_signature diffuser digest direct_io_handle encryption_context error file_io_handle_pool file_mapping io_callbacks io_handle io_uring json_tokenizer key_slot keyfile master_key_cache notify password read_queue read_request sector_data sector_data_vector segment segment_map sha spill_cache volume_header";
 LIBRARY_TESTS_WITH_INPUT="support volume";
 OPTION_SETS=("password");
 